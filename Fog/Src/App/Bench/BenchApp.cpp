@@ -6,6 +6,10 @@
 // [Dependencies]
 #include "BenchApp.h"
 #include "BenchFog.h"
+#include "BenchFused.h"
+#include "BenchLock.h"
+#include "BenchSvg.h"
+#include "BenchVerify.h"
 
 #if defined(FOG_BENCH_CAIRO)
 #include "BenchCairo.h"
@@ -19,6 +23,9 @@
 #include "BenchQt4.h"
 #endif // FOG_BENCH_QT4
 
+// [Dependencies - Raster]
+#include <Fog/G2d/Painting/RasterApi_p.h>
+
 // [Dependencies - Resources]
 #include "../Sample/Resources.h"
 
@@ -58,6 +65,7 @@ bool BenchApp::hasBenchSource(uint32_t benchType)
     case BENCH_TYPE_FILL_ROUND:
     case BENCH_TYPE_FILL_POLYGON:
     case BENCH_TYPE_FILL_COMPLEX:
+    case BENCH_TYPE_FILL_GLYPH:
       return true;
 
     default:
@@ -122,6 +130,8 @@ void BenchApp::runModule(BenchModule* module)
           s.justify(22, Fog::CharW(' '), Fog::TEXT_JUSTIFY_LEFT);
           s.append(Fog::CharW('|'));
 
+          Fog::StringW statistics;
+
           if (type != BENCH_TYPE_CREATE_DESTROY)
           {
             sizeIndex = 0;
@@ -139,6 +149,7 @@ void BenchApp::runModule(BenchModule* module)
             module->bench(output, params);
 
             s.appendFormat("%7qu|", (uint64_t)output.time.getMilliseconds());
+            statistics.append(output.statistics);
 
             if (sizeIndex != Fog::INVALID_INDEX)
               module->sizeTime.getDataX()[sizeIndex] += output.time;
@@ -152,6 +163,7 @@ void BenchApp::runModule(BenchModule* module)
           }
 
           s.append(Fog::CharW('\n'));
+          s.append(statistics);
           logs(s);
 
           if (params.op >= BENCH_OPERATOR_COUNT - 1)
@@ -252,11 +264,23 @@ void BenchApp::makeRand()
     exit(1);
   }
 
+  // Don't use rand(), the sequence differs between C libraries and the golden
+  // images used by BenchVerify must be the same on all platforms.
+  uint32_t seed = 1;
+
   for (uint32_t i = 0; i < randomSize; i++)
   {
-    randomData[i] = ((rand() & 0xFFFF)      ) ^
-                    ((rand() & 0xFFFF) <<  8) ^
-                    ((rand() & 0xFFFF) << 16) ;
+    uint32_t r[3];
+
+    for (uint32_t j = 0; j < 3; j++)
+    {
+      seed = seed * 1103515245U + 12345U;
+      r[j] = (seed >> 16) & 0xFFFF;
+    }
+
+    randomData[i] = (r[0]      ) ^
+                    (r[1] <<  8) ^
+                    (r[2] << 16) ;
   }
 }
 
@@ -274,6 +298,7 @@ Fog::StringW BenchApp::getBenchString(uint32_t bench) const
     "FillRound",
     "FillPolygon",
     "FillComplex",
+    "FillGlyph",
     "BlitImageI",
     "BlitImageF",
     "BlitImageRot"
@@ -324,6 +349,21 @@ Fog::StringW BenchApp::getOperatorString(uint32_t op) const
     return Fog::StringW();
 }
 
+Fog::StringW BenchApp::getTierString(uint32_t tier) const
+{
+  static const char* data[] = {
+    "c",
+    "sse2",
+    "ssse3",
+    "avx2"
+  };
+
+  if (tier < BENCH_TIER_COUNT)
+    return Fog::StringW::fromAscii8(data[tier]);
+  else
+    return Fog::StringW();
+}
+
 Fog::StringW BenchApp::getTestString(const BenchParams& params) const
 {
   Fog::StringW s = getBenchString(params.type);
@@ -367,8 +407,9 @@ void BenchApp::logInfo()
     yesno[Fog::Cpu::get()->hasFeature(Fog::CPU_FEATURE_SSSE3)],
     yesno[Fog::Cpu::get()->hasFeature(Fog::CPU_FEATURE_SSE4_1)],
     yesno[Fog::Cpu::get()->hasFeature(Fog::CPU_FEATURE_SSE4_2)]);
-  logf("Features3: AVX=%s\n",
-    yesno[Fog::Cpu::get()->hasFeature(Fog::CPU_FEATURE_AVX)]);
+  logf("Features3: AVX=%s, AVX2=%s\n",
+    yesno[Fog::Cpu::get()->hasFeature(Fog::CPU_FEATURE_AVX)],
+    yesno[Fog::Cpu::get()->hasFeature(Fog::CPU_FEATURE_AVX2)]);
   logf("CPU Count: %u\n", Fog::Cpu::get()->getNumberOfProcessors());
   logf("\n");
 }
@@ -549,9 +590,89 @@ int main(int argc, char* argv[])
   // Testing...
   app.saveImages = false;
 
+  // Regression mode - FogBench --verify <dir> [--update] [--tolerance <n>].
+  Fog::StringW verifyDir;
+  bool verifyUpdate = false;
+  uint32_t verifyTolerance = 0;
+
+  // Raster tier - FogBench --tier c|sse2|ssse3|avx2 (all tiers if verifying).
+  uint32_t tier = BENCH_TIER_ALL;
+
+  // Lock microbenchmarks - FogBench --lock.
+  bool lockBench = false;
+
+  // Fused fetch+composite kernels (disabled vs. enabled) - FogBench --fused.
+  bool fusedBench = false;
+
+  // SVG load benchmark (XML vs. snapshot) - FogBench --svg <file>.
+  Fog::StringW svgFile;
+
+  for (int i = 1; i < argc; i++)
+  {
+    Fog::StringA arg(argv[i]);
+
+    if (arg == Fog::Ascii8("--verify") && i + 1 < argc)
+      verifyDir = Fog::StringW::fromLocal8(argv[++i]);
+    else if (arg == Fog::Ascii8("--update"))
+      verifyUpdate = true;
+    else if (arg == Fog::Ascii8("--tolerance") && i + 1 < argc)
+      Fog::StringA(argv[++i]).parseU32(&verifyTolerance);
+    else if (arg == Fog::Ascii8("--tier") && i + 1 < argc)
+    {
+      Fog::StringW name = Fog::StringW::fromLocal8(argv[++i]);
+
+      for (tier = 0; tier < BENCH_TIER_COUNT; tier++)
+      {
+        if (name == app.getTierString(tier))
+          break;
+      }
+
+      if (tier == BENCH_TIER_COUNT)
+      {
+        app.logf("Unknown tier '%S', use c, sse2, ssse3 or avx2.\n", name.getData());
+        return 1;
+      }
+    }
+    else if (arg == Fog::Ascii8("--lock"))
+      lockBench = true;
+    else if (arg == Fog::Ascii8("--fused"))
+      fusedBench = true;
+    else if (arg == Fog::Ascii8("--svg") && i + 1 < argc)
+      svgFile = Fog::StringW::fromLocal8(argv[++i]);
+  }
+
   // Show FogBench info.
   app.logInfo();
 
+  // BenchVerify selects the tiers itself.
+  if (tier != BENCH_TIER_ALL && verifyDir.isEmpty() && Fog::RasterOps_setTier(tier) != Fog::ERR_OK)
+  {
+    app.logf("Tier '%S' is not supported.\n", app.getTierString(tier).getData());
+    return 1;
+  }
+
+  if (lockBench)
+  {
+    BenchLock bench(app);
+    bench.run();
+    return 0;
+  }
+
+  if (fusedBench)
+  {
+    app.makeRand();
+
+    BenchFused bench(app);
+    bench.run();
+    return 0;
+  }
+
+  if (!svgFile.isEmpty())
+  {
+    BenchSvg bench(app, svgFile);
+    return bench.run();
+  }
+
   // Load data.
   app.loadData();
   app.makeRand();
@@ -562,6 +683,18 @@ int main(int argc, char* argv[])
   app.sizeList.append(32);
   app.sizeList.append(64);
   app.sizeList.append(128);
+  app.sizeList.append(256);
+
+  if (!verifyDir.isEmpty())
+  {
+    BenchVerify verify(app, verifyDir);
+    verify.update = verifyUpdate;
+    verify.tolerance = verifyTolerance;
+    verify.tier = tier;
+
+    BenchFog module(app);
+    return verify.run(&module) == 0 ? 0 : 1;
+  }
 
   // Add modules.
   app.addModule(new BenchFog(app));
@@ -59,6 +59,22 @@ enum BENCH_SOURCE
   BENCH_SOURCE_NONE = 0xFFFFFFFFU
 };
 
+// ============================================================================
+// [BENCH_TIER]
+// ============================================================================
+
+// Raster CPU tiers, the same values as Fog::RASTER_TIER.
+enum BENCH_TIER
+{
+  BENCH_TIER_C = 0,
+  BENCH_TIER_SSE2 = 1,
+  BENCH_TIER_SSSE3 = 2,
+  BENCH_TIER_AVX2 = 3,
+
+  BENCH_TIER_COUNT = 4,
+  BENCH_TIER_ALL = 0xFFFFFFFFU
+};
+
 // ============================================================================
 // [BENCH_TYPE]
 // ============================================================================
@@ -72,10 +88,11 @@ enum BENCH_TYPE
   BENCH_TYPE_FILL_ROUND = 4,
   BENCH_TYPE_FILL_POLYGON = 5,
   BENCH_TYPE_FILL_COMPLEX = 6,
-  BENCH_TYPE_BLIT_IMAGE_I = 7,
-  BENCH_TYPE_BLIT_IMAGE_F = 8,
-  BENCH_TYPE_BLIT_IMAGE_ROTATE = 9,
-  BENCH_TYPE_COUNT = 10
+  BENCH_TYPE_FILL_GLYPH = 7,
+  BENCH_TYPE_BLIT_IMAGE_I = 8,
+  BENCH_TYPE_BLIT_IMAGE_F = 9,
+  BENCH_TYPE_BLIT_IMAGE_ROTATE = 10,
+  BENCH_TYPE_COUNT = 11
 };
 
 // ============================================================================
@@ -123,6 +140,7 @@ struct BenchApp
   Fog::StringW getFormatString(uint32_t format) const;
   Fog::StringW getSourceString(uint32_t sourceType) const;
   Fog::StringW getOperatorString(uint32_t op) const;
+  Fog::StringW getTierString(uint32_t tier) const;
 
   Fog::StringW getTestString(const BenchParams& params) const;
 
@@ -163,6 +181,9 @@ struct BenchApp
 struct BenchOutput
 {
   Fog::TimeDelta time;
+
+  // Module specific statistics, printed after the timings if not empty.
+  Fog::StringW statistics;
 };
 
 // ============================================================================
@@ -212,6 +233,7 @@ struct BenchModule
   virtual void runFillRectRotate(BenchOutput& output, const BenchParams& params) = 0;
   virtual void runFillRound(BenchOutput& output, const BenchParams& params) = 0;
   virtual void runFillPolygon(BenchOutput& output, const BenchParams& params, uint32_t complexity) = 0;
+  virtual void runFillGlyph(BenchOutput& output, const BenchParams& params) = 0;
   virtual void runBlitImageI(BenchOutput& output, const BenchParams& params) = 0;
   virtual void runBlitImageF(BenchOutput& output, const BenchParams& params) = 0;
   virtual void runBlitImageRotate(BenchOutput& output, const BenchParams& params) = 0;
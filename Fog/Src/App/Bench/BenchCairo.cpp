@@ -111,6 +111,10 @@ void BenchCairo::bench(BenchOutput& output, const BenchParams& params)
       runFillPolygon(output, params, 100);
       break;
 
+    case BENCH_TYPE_FILL_GLYPH:
+      runFillGlyph(output, params);
+      break;
+
     case BENCH_TYPE_BLIT_IMAGE_I:
       runBlitImageI(output, params);
       break;
@@ -513,6 +517,63 @@ void BenchCairo::runFillPolygon(BenchOutput& output, const BenchParams& params,
   cairo_destroy(cr);
 }
 
+void BenchCairo::runFillGlyph(BenchOutput& output, const BenchParams& params)
+{
+  cairo_t* cr = cairo_create(screenCairo);
+  configureContext(cr, params);
+  cairo_set_fill_rule(cr, CAIRO_FILL_RULE_EVEN_ODD);
+
+  BenchRandom rRect(app);
+  BenchRandom rArgb(app);
+
+  uint32_t i, quantity = params.quantity;
+  for (i = 0; i < quantity; i++)
+  {
+    Fog::RectF r(rRect.getRectF(params.screenSize, params.shapeSize, params.shapeSize));
+
+    // Glyph-like shape - ring made of two ellipses ("O").
+    double cx = r.x + r.w * 0.5;
+    double cy = r.y + r.h * 0.5;
+
+    cairo_save(cr);
+    cairo_translate(cr, cx, cy);
+    cairo_scale(cr, r.w * 0.40, r.h * 0.50);
+    cairo_arc(cr, 0.0, 0.0, 1.0, 0.0, Fog::MATH_TWO_PI);
+    cairo_restore(cr);
+
+    cairo_new_sub_path(cr);
+
+    cairo_save(cr);
+    cairo_translate(cr, cx, cy);
+    cairo_scale(cr, r.w * 0.25, r.h * 0.35);
+    cairo_arc(cr, 0.0, 0.0, 1.0, 0.0, Fog::MATH_TWO_PI);
+    cairo_restore(cr);
+
+    if (params.source == BENCH_SOURCE_SOLID)
+    {
+      Fog::Argb32 c0(rArgb.getArgb32());
+      cairo_set_source_rgba(cr, double(c0.r) * sc, double(c0.g) * sc, double(c0.b) * sc, double(c0.a) * sc);
+
+      cairo_fill(cr);
+    }
+    else
+    {
+      Fog::Argb32 c0(rArgb.getArgb32());
+      Fog::Argb32 c1(rArgb.getArgb32());
+      Fog::Argb32 c2(rArgb.getArgb32());
+
+      cairo_pattern_t* pattern = createLinearGradient(r.x, r.y, r.x + r.w, r.y + r.h, c0, c1, c2);
+      cairo_set_source(cr, pattern);
+
+      cairo_fill(cr);
+
+      cairo_pattern_destroy(pattern);
+    }
+  }
+
+  cairo_destroy(cr);
+}
+
 void BenchCairo::runBlitImageI(BenchOutput& output, const BenchParams& params)
 {
   cairo_t* cr = cairo_create(screenCairo);
@@ -6,6 +6,9 @@
 // [Dependencies]
 #include "BenchFog.h"
 
+// The raster tier is internal, it's selected by FogBench --tier.
+#include <Fog/G2d/Painting/RasterApi_p.h>
+
 // ============================================================================
 // [BenchFog - Construction / Destruction]
 // ============================================================================
@@ -27,9 +30,10 @@ BenchFog::~BenchFog()
 Fog::StringW BenchFog::getModuleName() const
 {
   Fog::StringW module;
-  module.format("Fog (%s-%s)",
+  module.format("Fog (%s-%s-%S)",
     mt ? "mt" : "st",
-    _fog_build_info()->isReleaseVersion() ? "rel" : "dbg");
+    _fog_build_info()->isReleaseVersion() ? "rel" : "dbg",
+    app.getTierString(Fog::RasterOps_getTier()).getData());
   return module;
 }
 
@@ -89,6 +93,10 @@ void BenchFog::bench(BenchOutput& output, const BenchParams& params)
       runFillPolygon(output, params, 100);
       break;
 
+    case BENCH_TYPE_FILL_GLYPH:
+      runFillGlyph(output, params);
+      break;
+
     case BENCH_TYPE_BLIT_IMAGE_I:
       runBlitImageI(output, params);
       break;
@@ -117,6 +125,106 @@ void BenchFog::configurePainter(Fog::Painter& p, const BenchParams& params)
   p.setGradientQuality(Fog::GRADIENT_QUALITY_NORMAL);
 }
 
+// Names of PAINT_STATISTICS_CMD commands.
+static const char* const BenchFog_cmdName[] =
+{
+  "fillAll",
+  "fillBoxI",
+  "fillBoxF",
+  "fillBoxD",
+  "fillPathF",
+  "fillPathD",
+  "fillCachedPathF",
+  "fillCachedPathD",
+  "blitImageD",
+  "blitImageA",
+  "blitNormalizedImageI",
+  "blitNormalizedImageD",
+  "filterBoxI",
+  "filterBoxF",
+  "filterBoxD",
+  "filterPathF",
+  "filterPathD",
+  "switchToMask",
+  "discardMask",
+  "saveMask",
+  "restoreMask",
+  "maskBoxI",
+  "maskBoxF",
+  "maskBoxD",
+  "maskPathF",
+  "maskPathD"
+};
+
+// Names of PATTERN_TYPE sources.
+static const char* const BenchFog_sourceName[] =
+{
+  "null",
+  "color",
+  "texture",
+  "gradient"
+};
+
+// Names of PAINT_STATISTICS_TIME operations.
+static const char* const BenchFog_timeName[] =
+{
+  "stroke",
+  "fill",
+  "blit",
+  "filter"
+};
+
+void BenchFog::collectStatistics(BenchOutput& output, const BenchParams& params, Fog::Painter& p)
+{
+  // Statistics are only available if Fog was built with them.
+  Fog::PaintStatistics statistics;
+  if (p.getStatistics(statistics) != Fog::ERR_OK)
+    return;
+
+  Fog::StringW& s = output.statistics;
+  uint i;
+
+  s.appendFormat("  %ux%u: pixels=%llu spans=%llu cells=%llu clip(box/region/mask)=%llu/%llu/%llu\n",
+    params.shapeSize, params.shapeSize,
+    statistics.pixelCount,
+    statistics.spanCount,
+    statistics.cellCount,
+    statistics.clipCount[Fog::PAINT_STATISTICS_CLIP_BOX],
+    statistics.clipCount[Fog::PAINT_STATISTICS_CLIP_REGION],
+    statistics.clipCount[Fog::PAINT_STATISTICS_CLIP_MASK]);
+
+  s.append(Fog::Ascii8("    cmd:"));
+  for (i = 0; i < Fog::PAINT_STATISTICS_CMD_COUNT; i++)
+  {
+    if (statistics.cmdCount[i] != 0)
+      s.appendFormat(" %s=%llu", BenchFog_cmdName[i], statistics.cmdCount[i]);
+  }
+
+  s.append(Fog::Ascii8(" op:"));
+  for (i = 0; i < Fog::COMPOSITE_COUNT; i++)
+  {
+    if (statistics.opCount[i] != 0)
+      s.appendFormat(" %u=%llu", i, statistics.opCount[i]);
+  }
+
+  s.append(Fog::Ascii8(" source:"));
+  for (i = 0; i < Fog::PAINT_STATISTICS_SOURCE_COUNT; i++)
+  {
+    if (statistics.sourceCount[i] != 0)
+      s.appendFormat(" %s=%llu", BenchFog_sourceName[i], statistics.sourceCount[i]);
+  }
+  s.append(Fog::CharW('\n'));
+
+  s.append(Fog::Ascii8("    cycles:"));
+  for (i = 0; i < Fog::PAINT_STATISTICS_TIME_COUNT; i++)
+  {
+    if (statistics.timeCount[i] != 0)
+      s.appendFormat(" %s=%llu (%llu per op)", BenchFog_timeName[i],
+        statistics.timeCycles[i], statistics.timeCycles[i] / statistics.timeCount[i]);
+  }
+  s.append(Fog::CharW('\n'));
+}
+
 void BenchFog::configureGradient(Fog::LinearGradientF& gradient,
   const Fog::RectI& r, const Fog::Argb32& c0, const Fog::Argb32& c1, const Fog::Argb32& c2)
 {
@@ -190,6 +298,8 @@ void BenchFog::runFillRectI(BenchOutput& output, const BenchParams& params)
       p.setSource();
     }
   }
+
+  collectStatistics(output, params, p);
 }
 
 void BenchFog::runFillRectF(BenchOutput& output, const BenchParams& params)
@@ -231,6 +341,8 @@ void BenchFog::runFillRectF(BenchOutput& output, const BenchParams& params)
       p.setSource();
     }
   }
+
+  collectStatistics(output, params, p);
 }
 
 void BenchFog::runFillRectRotate(BenchOutput& output, const BenchParams& params)
@@ -288,6 +400,8 @@ void BenchFog::runFillRectRotate(BenchOutput& output, const BenchParams& params)
       p.setSource();
     }
   }
+
+  collectStatistics(output, params, p);
 }
 
 void BenchFog::runFillRound(BenchOutput& output, const BenchParams& params)
@@ -334,6 +448,8 @@ void BenchFog::runFillRound(BenchOutput& output, const BenchParams& params)
       p.setSource();
     }
   }
+
+  collectStatistics(output, params, p);
 }
 
 void BenchFog::runFillPolygon(BenchOutput& output, const BenchParams& params, uint32_t complexity)
@@ -398,6 +514,58 @@ void BenchFog::runFillPolygon(BenchOutput& output, const BenchParams& params, ui
       p.setSource();
     }
   }
+
+  collectStatistics(output, params, p);
+}
+
+void BenchFog::runFillGlyph(BenchOutput& output, const BenchParams& params)
+{
+  Fog::Painter p(screen, Fog::NO_FLAGS);
+  configurePainter(p, params);
+  p.setFillRule(Fog::FILL_RULE_EVEN_ODD);
+
+  BenchRandom rRect(app);
+  BenchRandom rArgb(app);
+
+  Fog::PathF path;
+
+  uint32_t i, quantity = params.quantity;
+  for (i = 0; i < quantity; i++)
+  {
+    Fog::RectF r(rRect.getRectF(params.screenSize, params.shapeSize, params.shapeSize));
+
+    // Glyph-like shape - ring made of two ellipses ("O").
+    float cx = r.x + r.w * 0.5f;
+    float cy = r.y + r.h * 0.5f;
+
+    path.clear();
+    path.ellipse(cx, cy, r.w * 0.40f, r.h * 0.50f);
+    path.ellipse(cx, cy, r.w * 0.25f, r.h * 0.35f);
+
+    if (params.source == BENCH_SOURCE_SOLID)
+    {
+      Fog::Argb32 c0(rArgb.getArgb32());
+
+      p.setSource(c0);
+      p.fillPath(path);
+    }
+    else
+    {
+      Fog::LinearGradientF gradient;
+      gradient.setGradientSpread(Fog::GRADIENT_SPREAD_PAD);
+
+      Fog::Argb32 c0(rArgb.getArgb32());
+      Fog::Argb32 c1(rArgb.getArgb32());
+      Fog::Argb32 c2(rArgb.getArgb32());
+
+      configureGradient(gradient, r, c0, c1, c2);
+      p.setSource(gradient);
+      p.fillPath(path);
+      p.setSource();
+    }
+  }
+
+  collectStatistics(output, params, p);
 }
 
 void BenchFog::runBlitImageI(BenchOutput& output, const BenchParams& params)
@@ -423,6 +591,8 @@ void BenchFog::runBlitImageI(BenchOutput& output, const BenchParams& params)
     if (++spriteIndex >= spritesLength)
       spriteIndex = 0;
   }
+
+  collectStatistics(output, params, p);
 }
 
 void BenchFog::runBlitImageF(BenchOutput& output, const BenchParams& params)
@@ -448,6 +618,8 @@ void BenchFog::runBlitImageF(BenchOutput& output, const BenchParams& params)
     if (++spriteIndex >= spritesLength)
       spriteIndex = 0;
   }
+
+  collectStatistics(output, params, p);
 }
 void BenchFog::runBlitImageRotate(BenchOutput& output, const BenchParams& params)
 {
@@ -484,4 +656,6 @@ void BenchFog::runBlitImageRotate(BenchOutput& output, const BenchParams& params
     if (++spriteIndex >= spritesLength)
       spriteIndex = 0;
   }
+
+  collectStatistics(output, params, p);
 }
@@ -33,6 +33,7 @@ struct BenchFog : public BenchModule
   // --------------------------------------------------------------------------
 
   void configurePainter(Fog::Painter& p, const BenchParams& params);
+  void collectStatistics(BenchOutput& output, const BenchParams& params, Fog::Painter& p);
 
   void configureGradient(Fog::LinearGradientF& gradient, const Fog::RectI& r,
     const Fog::Argb32& c0, const Fog::Argb32& c1, const Fog::Argb32& c2);
@@ -49,6 +50,7 @@ struct BenchFog : public BenchModule
   virtual void runFillRectRotate(BenchOutput& output, const BenchParams& params);
   virtual void runFillRound(BenchOutput& output, const BenchParams& params);
   virtual void runFillPolygon(BenchOutput& output, const BenchParams& params, uint32_t complexity);
+  virtual void runFillGlyph(BenchOutput& output, const BenchParams& params);
   virtual void runBlitImageI(BenchOutput& output, const BenchParams& params);
   virtual void runBlitImageF(BenchOutput& output, const BenchParams& params);
   virtual void runBlitImageRotate(BenchOutput& output, const BenchParams& params);
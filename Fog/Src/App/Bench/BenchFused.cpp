@@ -0,0 +1,159 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchFused.h"
+
+// The fused kernels are internal, they are disabled by clearing the table.
+#include <Fog/G2d/Painting/RasterApi_p.h>
+
+// ============================================================================
+// [BenchFused - Construction / Destruction]
+// ============================================================================
+
+BenchFused::BenchFused(BenchApp& app) :
+  app(app),
+  quantity(20000),
+  shapeSize(128)
+{
+  screen.create(app.screenSize, Fog::IMAGE_FORMAT_PRGB32);
+  texture.create(Fog::SizeI(64, 64), Fog::IMAGE_FORMAT_PRGB32);
+
+  // Semi-transparent texture, so the SRC_OVER operator has to blend.
+  Fog::Painter p(texture, Fog::NO_FLAGS);
+  Fog::LinearGradientF gradient;
+
+  gradient.setStart(Fog::PointF(0.0f, 0.0f));
+  gradient.setEnd(Fog::PointF(64.0f, 64.0f));
+  gradient.addStop(0.0f, Fog::Argb32(0xFFFF0000));
+  gradient.addStop(0.5f, Fog::Argb32(0x8000FF00));
+  gradient.addStop(1.0f, Fog::Argb32(0x000000FF));
+
+  p.setCompositingOperator(Fog::COMPOSITE_SRC);
+  p.setSource(gradient);
+  p.fillAll();
+}
+
+BenchFused::~BenchFused()
+{
+}
+
+// ============================================================================
+// [BenchFused - Run]
+// ============================================================================
+
+void BenchFused::run()
+{
+  app.logf("Fused    : %u rounds %ux%u per test\n", quantity, shapeSize, shapeSize);
+  app.logf("\n");
+
+  // StringW::format() doesn't support width and precision of floats, rows
+  // are formatted by the C library.
+  char line[256];
+
+  snprintf(line, FOG_ARRAY_SIZE(line), "%-16s| %-8s | %11s | %10s | %7s |\n",
+    "Source", "Operator", "Unfused[ms]", "Fused[ms]", "Speedup");
+  app.logf("%s", line);
+
+  for (uint32_t op = 0; op < 2; op++)
+  {
+    uint32_t compositingOperator = (op == 0) ? Fog::COMPOSITE_SRC : Fog::COMPOSITE_SRC_OVER;
+
+    for (uint32_t source = 0; source < BENCH_FUSED_SOURCE_COUNT; source++)
+    {
+      uint64_t unfused = runTest(compositingOperator, source, false);
+      uint64_t fused = runTest(compositingOperator, source, true);
+
+      snprintf(line, FOG_ARRAY_SIZE(line), "%-16s| %-8s | %11.3f | %10.3f | %6.2fx |\n",
+        getSourceString(source),
+        op == 0 ? "Src" : "SrcOver",
+        double(unfused) / 1000.0,
+        double(fused) / 1000.0,
+        fused ? double(unfused) / double(fused) : 0.0);
+      app.logf("%s", line);
+    }
+  }
+
+  app.logf("\n");
+}
+
+uint64_t BenchFused::runTest(uint32_t op, uint32_t source, bool fused)
+{
+  Fog::RasterFusedFuncs saved = Fog::_api_raster.fused;
+  if (!fused)
+    Fog::_api_raster.fused.reset();
+
+  screen.clear(Fog::Argb32(0x00000000));
+
+  Fog::Painter p(screen, Fog::NO_FLAGS);
+  p.setCompositingOperator(op);
+  p.setImageQuality(Fog::IMAGE_QUALITY_NEAREST);
+
+  BenchRandom rRect(app);
+  BenchRandom rArgb(app);
+  BenchRandom rRadius(app);
+
+  Fog::LinearGradientF gradient;
+  gradient.setGradientSpread(source == BENCH_FUSED_SOURCE_LINEAR_PAD
+    ? Fog::GRADIENT_SPREAD_PAD
+    : Fog::GRADIENT_SPREAD_REPEAT);
+
+  Fog::Texture pattern(texture, (source == BENCH_FUSED_SOURCE_TEXTURE_REPEAT)
+    ? Fog::TEXTURE_TILE_REPEAT
+    : Fog::TEXTURE_TILE_PAD);
+
+  if (source == BENCH_FUSED_SOURCE_TEXTURE_PAD || source == BENCH_FUSED_SOURCE_TEXTURE_REPEAT)
+    p.setSource(pattern);
+  else if (source == BENCH_FUSED_SOURCE_TEXTURE_SCALE)
+    p.setSource(pattern, Fog::TransformF::fromScaling(2.5f, 2.5f));
+
+  Fog::TimeTicks startTime = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+
+  for (uint32_t i = 0; i < quantity; i++)
+  {
+    Fog::RectF r(rRect.getRectF(app.screenSize, shapeSize, shapeSize));
+    float rad = rRadius.getFloat(4.0f, 40.0f);
+
+    if (source == BENCH_FUSED_SOURCE_LINEAR_PAD || source == BENCH_FUSED_SOURCE_LINEAR_REPEAT)
+    {
+      // Half of the shape is covered by the gradient, the rest is padded or
+      // repeated.
+      gradient.setStart(Fog::PointF(r.x + r.w * 0.25f, r.y));
+      gradient.setEnd(Fog::PointF(r.x + r.w * 0.75f, r.y + r.h * 0.5f));
+
+      gradient.clearStops();
+      gradient.addStop(0.0f, rArgb.getArgb32());
+      gradient.addStop(1.0f, rArgb.getArgb32());
+
+      p.setSource(gradient);
+    }
+
+    p.fillRound(Fog::RoundF(r, rad));
+  }
+
+  p.flush(Fog::PAINTER_FLUSH_SYNC);
+  Fog::TimeDelta time = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - startTime;
+
+  Fog::_api_raster.fused = saved;
+  return (uint64_t)time.getDelta();
+}
+
+// ============================================================================
+// [BenchFused - Helpers]
+// ============================================================================
+
+const char* BenchFused::getSourceString(uint32_t source)
+{
+  switch (source)
+  {
+    case BENCH_FUSED_SOURCE_LINEAR_PAD     : return "Linear-Pad";
+    case BENCH_FUSED_SOURCE_LINEAR_REPEAT  : return "Linear-Repeat";
+    case BENCH_FUSED_SOURCE_TEXTURE_PAD    : return "Texture-Pad";
+    case BENCH_FUSED_SOURCE_TEXTURE_REPEAT : return "Texture-Repeat";
+    case BENCH_FUSED_SOURCE_TEXTURE_SCALE  : return "Texture-Scale";
+    default:
+      return "Unknown";
+  }
+}
@@ -0,0 +1,79 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHFUSED_H
+#define _FOG_BENCHFUSED_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BENCH_FUSED_SOURCE]
+// ============================================================================
+
+enum BENCH_FUSED_SOURCE
+{
+  BENCH_FUSED_SOURCE_LINEAR_PAD = 0,
+  BENCH_FUSED_SOURCE_LINEAR_REPEAT = 1,
+  BENCH_FUSED_SOURCE_TEXTURE_PAD = 2,
+  BENCH_FUSED_SOURCE_TEXTURE_REPEAT = 3,
+  BENCH_FUSED_SOURCE_TEXTURE_SCALE = 4,
+
+  BENCH_FUSED_SOURCE_COUNT = 5
+};
+
+// ============================================================================
+// [BenchFused]
+// ============================================================================
+
+//! @brief Fused fetch+composite benchmark.
+//!
+//! Fills antialiased rounded rectangles by the pattern sources which have a
+//! fused kernel and compares the time spent with the kernels disabled (the
+//! pattern is fetched into the span buffer and composited) and enabled.
+struct BenchFused
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  BenchFused(BenchApp& app);
+  ~BenchFused();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  void run();
+
+  //! @brief Fill @c quantity shapes, returns the time in microseconds.
+  uint64_t runTest(uint32_t op, uint32_t source, bool fused);
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  static const char* getSourceString(uint32_t source);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Target image.
+  Fog::Image screen;
+  //! @brief Texture used by texture sources.
+  Fog::Image texture;
+
+  //! @brief Count of filled shapes per test.
+  uint32_t quantity;
+  //! @brief Size of filled shapes.
+  uint32_t shapeSize;
+};
+
+// [Guard]
+#endif // _FOG_BENCHFUSED_H
@@ -125,6 +125,10 @@ void BenchGdiPlus::bench(BenchOutput& output, const BenchParams& params)
       runFillPolygon(output, params, 100);
       break;
 
+    case BENCH_TYPE_FILL_GLYPH:
+      runFillGlyph(output, params);
+      break;
+
     case BENCH_TYPE_BLIT_IMAGE_I:
       runBlitImageI(output, params);
       break;
@@ -510,6 +514,52 @@ void BenchGdiPlus::runFillPolygon(BenchOutput& output, const BenchParams& params
   }
 }
 
+void BenchGdiPlus::runFillGlyph(BenchOutput& output, const BenchParams& params)
+{
+  Gdiplus::Graphics gr(screenGdi);
+  configureGraphics(gr, params);
+
+  BenchRandom rRect(app);
+  BenchRandom rArgb(app);
+
+  uint32_t i, quantity = params.quantity;
+  for (i = 0; i < quantity; i++)
+  {
+    Fog::RectF r(rRect.getRectF(params.screenSize, params.shapeSize, params.shapeSize));
+
+    // Glyph-like shape - ring made of two ellipses ("O").
+    float cx = r.x + r.w * 0.5f;
+    float cy = r.y + r.h * 0.5f;
+
+    Gdiplus::GraphicsPath path(Gdiplus::FillModeAlternate);
+    path.AddEllipse(cx - r.w * 0.40f, cy - r.h * 0.50f, r.w * 0.80f, r.h * 1.00f);
+    path.AddEllipse(cx - r.w * 0.25f, cy - r.h * 0.35f, r.w * 0.50f, r.h * 0.70f);
+
+    if (params.source == BENCH_SOURCE_SOLID)
+    {
+      Gdiplus::Color color(rArgb.getArgb32().getPacked32());
+      Gdiplus::SolidBrush brush(color);
+      gr.FillPath((Gdiplus::Brush*)&brush, &path);
+    }
+    else
+    {
+      Gdiplus::Color colors[3];
+      colors[0] = Gdiplus::Color(rArgb.getArgb32().getPacked32());
+      colors[1] = Gdiplus::Color(rArgb.getArgb32().getPacked32());
+      colors[2] = Gdiplus::Color(rArgb.getArgb32().getPacked32());
+
+      Gdiplus::LinearGradientBrush brush(
+        Gdiplus::PointF(r.x, r.y),
+        Gdiplus::PointF(r.x + r.w, r.y + r.h),
+        colors[0],
+        colors[2]);
+      brush.SetInterpolationColors(colors, gradientStopCache, 3);
+
+      gr.FillPath((Gdiplus::Brush*)&brush, &path);
+    }
+  }
+}
+
 void BenchGdiPlus::runBlitImageI(BenchOutput& output, const BenchParams& params)
 {
   Gdiplus::Graphics gr(screenGdi);
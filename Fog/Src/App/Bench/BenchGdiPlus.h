@@ -59,6 +59,7 @@ struct BenchGdiPlus : public BenchModule
   virtual void runFillRectRotate(BenchOutput& output, const BenchParams& params);
   virtual void runFillRound(BenchOutput& output, const BenchParams& params);
   virtual void runFillPolygon(BenchOutput& output, const BenchParams& params, uint32_t complexity);
+  virtual void runFillGlyph(BenchOutput& output, const BenchParams& params);
   virtual void runBlitImageI(BenchOutput& output, const BenchParams& params);
   virtual void runBlitImageF(BenchOutput& output, const BenchParams& params);
   virtual void runBlitImageRotate(BenchOutput& output, const BenchParams& params);
@@ -0,0 +1,307 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchLock.h"
+
+// ============================================================================
+// [BenchLockShared]
+// ============================================================================
+
+BenchLockShared::BenchLockShared()
+{
+  adaptiveLock.setName("BenchLock::adaptiveLock");
+  readWriteLock.setName("BenchLock::readWriteLock");
+
+  reset(BENCH_LOCK_TYPE_LOCK, BENCH_LOCK_WORKLOAD_EXCLUSIVE, 0);
+}
+
+void BenchLockShared::reset(uint32_t lockType, uint32_t workload, uint32_t iterations)
+{
+  this->lockType = lockType;
+  this->workload = workload;
+  this->iterations = iterations;
+
+  pending.init(0);
+  Fog::MemOps::zero(table, sizeof(table));
+}
+
+// ============================================================================
+// [BenchLockThread]
+// ============================================================================
+
+struct BenchLockThread : public Fog::Thread
+{
+  BenchLockThread(BenchLockShared* shared);
+  virtual void main();
+
+  void runExclusive();
+  void runReadMostly();
+
+  BenchLockShared* shared;
+  uint32_t result;
+};
+
+BenchLockThread::BenchLockThread(BenchLockShared* shared) :
+  shared(shared),
+  result(0)
+{
+}
+
+void BenchLockThread::main()
+{
+  // Startup without an event loop.
+  Fog::Thread::main();
+
+  // Wait for the other threads.
+  shared->pending.dec();
+  while (shared->pending.get() != 0)
+    Fog::Thread::yield();
+
+  if (shared->workload == BENCH_LOCK_WORKLOAD_EXCLUSIVE)
+    runExclusive();
+  else
+    runReadMostly();
+}
+
+void BenchLockThread::runExclusive()
+{
+  uint32_t i, iterations = shared->iterations;
+  uint32_t* table = shared->table;
+
+  switch (shared->lockType)
+  {
+    case BENCH_LOCK_TYPE_LOCK:
+      for (i = 0; i < iterations; i++)
+      {
+        shared->lock.lock();
+        table[i % BENCH_LOCK_TABLE_SIZE]++;
+        shared->lock.unlock();
+      }
+      break;
+
+    case BENCH_LOCK_TYPE_ADAPTIVE:
+      for (i = 0; i < iterations; i++)
+      {
+        shared->adaptiveLock.lock();
+        table[i % BENCH_LOCK_TABLE_SIZE]++;
+        shared->adaptiveLock.unlock();
+      }
+      break;
+
+    case BENCH_LOCK_TYPE_READ_WRITE:
+      for (i = 0; i < iterations; i++)
+      {
+        shared->readWriteLock.lockWrite();
+        table[i % BENCH_LOCK_TABLE_SIZE]++;
+        shared->readWriteLock.unlockWrite();
+      }
+      break;
+  }
+}
+
+void BenchLockThread::runReadMostly()
+{
+  uint32_t i, iterations = shared->iterations;
+  uint32_t* table = shared->table;
+  uint32_t sum = 0;
+
+  switch (shared->lockType)
+  {
+    case BENCH_LOCK_TYPE_LOCK:
+      for (i = 0; i < iterations; i++)
+      {
+        shared->lock.lock();
+        if ((i % BENCH_LOCK_WRITE_RATIO) == 0)
+          table[i % BENCH_LOCK_TABLE_SIZE]++;
+        else
+          sum += table[i % BENCH_LOCK_TABLE_SIZE];
+        shared->lock.unlock();
+      }
+      break;
+
+    case BENCH_LOCK_TYPE_ADAPTIVE:
+      for (i = 0; i < iterations; i++)
+      {
+        shared->adaptiveLock.lock();
+        if ((i % BENCH_LOCK_WRITE_RATIO) == 0)
+          table[i % BENCH_LOCK_TABLE_SIZE]++;
+        else
+          sum += table[i % BENCH_LOCK_TABLE_SIZE];
+        shared->adaptiveLock.unlock();
+      }
+      break;
+
+    case BENCH_LOCK_TYPE_READ_WRITE:
+      for (i = 0; i < iterations; i++)
+      {
+        if ((i % BENCH_LOCK_WRITE_RATIO) == 0)
+        {
+          shared->readWriteLock.lockWrite();
+          table[i % BENCH_LOCK_TABLE_SIZE]++;
+          shared->readWriteLock.unlockWrite();
+        }
+        else
+        {
+          shared->readWriteLock.lockRead();
+          sum += table[i % BENCH_LOCK_TABLE_SIZE];
+          shared->readWriteLock.unlockRead();
+        }
+      }
+      break;
+  }
+
+  // Don't let the compiler optimize the reads out.
+  result = sum;
+}
+
+// ============================================================================
+// [BenchLock - Construction / Destruction]
+// ============================================================================
+
+BenchLock::BenchLock(BenchApp& app) :
+  app(app),
+  iterations(1000000),
+  maxThreads(8)
+{
+}
+
+BenchLock::~BenchLock()
+{
+}
+
+// ============================================================================
+// [BenchLock - Run]
+// ============================================================================
+
+void BenchLock::run()
+{
+  app.logf("Locks    : %u operations per thread, up to %u threads\n", iterations, maxThreads);
+  app.logf("\n");
+
+  for (uint32_t workload = 0; workload < BENCH_LOCK_WORKLOAD_COUNT; workload++)
+  {
+    app.logf("%-16s|", getWorkloadString(workload));
+    for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+      app.logf(" %2u thr[ms] |", threadCount);
+    app.logf("\n");
+
+    for (uint32_t lockType = 0; lockType < BENCH_LOCK_TYPE_COUNT; lockType++)
+    {
+      app.logf("%-16s|", getLockTypeString(lockType));
+
+      for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+        app.logf(" %10u |", runTest(lockType, workload, threadCount));
+
+      app.logf("\n");
+    }
+
+    app.logf("\n");
+  }
+
+  logProfiles();
+}
+
+uint32_t BenchLock::runTest(uint32_t lockType, uint32_t workload, uint32_t threadCount)
+{
+  BenchLockThread* threads[32];
+
+  uint32_t i;
+  FOG_ASSERT(threadCount <= FOG_ARRAY_SIZE(threads));
+
+  // The benchmark starts when all threads and this thread are ready.
+  shared.reset(lockType, workload, iterations);
+  shared.pending.init(threadCount + 1);
+
+  for (i = 0; i < threadCount; i++)
+  {
+    threads[i] = new BenchLockThread(&shared);
+    threads[i]->start(Fog::StringW());
+  }
+
+  Fog::TimeTicks startTime = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+  shared.pending.dec();
+
+  for (i = 0; i < threadCount; i++)
+  {
+    threads[i]->stop();
+    delete threads[i];
+  }
+
+  Fog::TimeDelta time = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - startTime;
+
+  // Verify that the lock really excluded the writers.
+  uint32_t expected = threadCount * iterations;
+  if (workload == BENCH_LOCK_WORKLOAD_READ_MOSTLY)
+    expected = threadCount * ((iterations + BENCH_LOCK_WRITE_RATIO - 1) / BENCH_LOCK_WRITE_RATIO);
+
+  uint32_t sum = 0;
+  for (i = 0; i < BENCH_LOCK_TABLE_SIZE; i++)
+    sum += shared.table[i];
+
+  if (sum != expected)
+  {
+    app.logf("\n%s/%s failed - %u writes, expected %u.\n",
+      getLockTypeString(lockType), getWorkloadString(workload), sum, expected);
+  }
+
+  return (uint32_t)(time.getDelta() / 1000);
+}
+
+// ============================================================================
+// [BenchLock - Helpers]
+// ============================================================================
+
+const char* BenchLock::getLockTypeString(uint32_t lockType)
+{
+  switch (lockType)
+  {
+    case BENCH_LOCK_TYPE_LOCK      : return "Lock";
+    case BENCH_LOCK_TYPE_ADAPTIVE  : return "AdaptiveLock";
+    case BENCH_LOCK_TYPE_READ_WRITE: return "ReadWriteLock";
+    default:
+      return "Unknown";
+  }
+}
+
+const char* BenchLock::getWorkloadString(uint32_t workload)
+{
+  switch (workload)
+  {
+    case BENCH_LOCK_WORKLOAD_EXCLUSIVE  : return "Exclusive";
+    case BENCH_LOCK_WORKLOAD_READ_MOSTLY: return "Read-mostly";
+    default:
+      return "Unknown";
+  }
+}
+
+void BenchLock::logProfiles()
+{
+  Fog::LockProfile profiles[64];
+  size_t count = Fog::LockProfile::getList(profiles, FOG_ARRAY_SIZE(profiles));
+
+  if (count == 0)
+    return;
+
+  if (count > FOG_ARRAY_SIZE(profiles))
+    count = FOG_ARRAY_SIZE(profiles);
+
+  app.logf("Lock contention (wait time in microseconds):\n");
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const Fog::LockProfile& profile = profiles[i];
+
+    app.logf("  %-28s acquired=%llu contended=%llu parked=%llu wait=%llu max=%llu\n",
+      profile.name != NULL ? profile.name : "<unnamed>",
+      profile.acquireCount,
+      profile.contendedCount,
+      profile.parkCount,
+      profile.waitTime,
+      profile.waitTimeMax);
+  }
+
+  app.logf("\n");
+}
@@ -0,0 +1,127 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHLOCK_H
+#define _FOG_BENCHLOCK_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BENCH_LOCK_TYPE]
+// ============================================================================
+
+enum BENCH_LOCK_TYPE
+{
+  BENCH_LOCK_TYPE_LOCK = 0,
+  BENCH_LOCK_TYPE_ADAPTIVE = 1,
+  BENCH_LOCK_TYPE_READ_WRITE = 2,
+  BENCH_LOCK_TYPE_COUNT = 3
+};
+
+// ============================================================================
+// [BENCH_LOCK_WORKLOAD]
+// ============================================================================
+
+enum BENCH_LOCK_WORKLOAD
+{
+  //! @brief Every operation modifies a counter (exclusive lock).
+  BENCH_LOCK_WORKLOAD_EXCLUSIVE = 0,
+  //! @brief One of @c BENCH_LOCK_WRITE_RATIO operations modifies a table, the
+  //! rest only reads it.
+  BENCH_LOCK_WORKLOAD_READ_MOSTLY = 1,
+  BENCH_LOCK_WORKLOAD_COUNT = 2
+};
+
+enum
+{
+  BENCH_LOCK_TABLE_SIZE = 64,
+  BENCH_LOCK_WRITE_RATIO = 64
+};
+
+// ============================================================================
+// [BenchLockShared]
+// ============================================================================
+
+//! @brief Data shared by all threads of a lock benchmark.
+//!
+//! The same locks are used by all benchmarks, so their contention profiles
+//! are accumulated.
+struct BenchLockShared
+{
+  BenchLockShared();
+
+  //! @brief Prepare a benchmark.
+  void reset(uint32_t lockType, uint32_t workload, uint32_t iterations);
+
+  uint32_t lockType;
+  uint32_t workload;
+  uint32_t iterations;
+
+  //! @brief Count of threads waiting to start, the threads start together.
+  Fog::Atomic<uint32_t> pending;
+
+  Fog::Lock lock;
+  Fog::AdaptiveLock adaptiveLock;
+  Fog::ReadWriteLock readWriteLock;
+
+  //! @brief Data protected by the lock.
+  uint32_t table[BENCH_LOCK_TABLE_SIZE];
+};
+
+// ============================================================================
+// [BenchLock]
+// ============================================================================
+
+//! @brief Lock microbenchmarks.
+//!
+//! Measures throughput of @c Fog::Lock, @c Fog::AdaptiveLock and
+//! @c Fog::ReadWriteLock with an increasing count of threads using short
+//! critical sections. If Fog was built with @c FOG_BUILD_LOCK_PROFILING the
+//! contention of each lock is printed as well.
+struct BenchLock
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  BenchLock(BenchApp& app);
+  ~BenchLock();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  void run();
+
+  //! @brief Run a single benchmark, returns the time in milliseconds.
+  uint32_t runTest(uint32_t lockType, uint32_t workload, uint32_t threadCount);
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  static const char* getLockTypeString(uint32_t lockType);
+  static const char* getWorkloadString(uint32_t workload);
+
+  void logProfiles();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Count of operations done by each thread.
+  uint32_t iterations;
+  //! @brief Maximum count of threads.
+  uint32_t maxThreads;
+
+  BenchLockShared shared;
+};
+
+// [Guard]
+#endif // _FOG_BENCHLOCK_H
@@ -112,6 +112,10 @@ void BenchQt4::bench(BenchOutput& output, const BenchParams& params)
       runFillPolygon(output, params, 100);
       break;
 
+    case BENCH_TYPE_FILL_GLYPH:
+      runFillGlyph(output, params);
+      break;
+
     case BENCH_TYPE_BLIT_IMAGE_I:
       runBlitImageI(output, params);
       break;
@@ -443,6 +447,48 @@ void BenchQt4::runFillPolygon(BenchOutput& output, const BenchParams& params, ui
   }
 }
 
+void BenchQt4::runFillGlyph(BenchOutput& output, const BenchParams& params)
+{
+  QPainter p(screenQt);
+  configurePainter(p, params);
+
+  p.setPen(QPen(Qt::NoPen));
+
+  BenchRandom rRect(app);
+  BenchRandom rArgb(app);
+
+  uint32_t i, quantity = params.quantity;
+  for (i = 0; i < quantity; i++)
+  {
+    Fog::RectF r(rRect.getRectF(params.screenSize, params.shapeSize, params.shapeSize));
+
+    // Glyph-like shape - ring made of two ellipses ("O").
+    QPointF center(r.x + r.w * 0.5f, r.y + r.h * 0.5f);
+
+    QPainterPath path;
+    path.setFillRule(Qt::OddEvenFill);
+    path.addEllipse(center, r.w * 0.40f, r.h * 0.50f);
+    path.addEllipse(center, r.w * 0.25f, r.h * 0.35f);
+
+    if (params.source == BENCH_SOURCE_SOLID)
+    {
+      Fog::Argb32 c0(rArgb.getArgb32());
+
+      p.setBrush(QBrush(QColor(c0.getRed(), c0.getGreen(), c0.getBlue(), c0.getAlpha())));
+      p.drawPath(path);
+    }
+    else
+    {
+      Fog::Argb32 c0(rArgb.getArgb32());
+      Fog::Argb32 c1(rArgb.getArgb32());
+      Fog::Argb32 c2(rArgb.getArgb32());
+
+      p.setBrush(createLinearGradient(Fog::PointF(r.x, r.y), Fog::PointF(r.x + r.w, r.y + r.h), c0, c1, c2));
+      p.drawPath(path);
+    }
+  }
+}
+
 void BenchQt4::runBlitImageI(BenchOutput& output, const BenchParams& params)
 {
   QPainter p(screenQt);
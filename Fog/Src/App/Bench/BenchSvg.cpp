@@ -0,0 +1,122 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchSvg.h"
+
+// ============================================================================
+// [BenchSvg - Construction / Destruction]
+// ============================================================================
+
+BenchSvg::BenchSvg(BenchApp& app, const Fog::StringW& fileName) :
+  app(app),
+  fileName(fileName),
+  iterations(10)
+{
+}
+
+BenchSvg::~BenchSvg()
+{
+}
+
+// ============================================================================
+// [BenchSvg - Run]
+// ============================================================================
+
+int BenchSvg::run()
+{
+  Fog::StringA xml;
+  Fog::StringA snapshot;
+
+  {
+    Fog::Stream stream;
+    if (stream.openFile(fileName, Fog::STREAM_OPEN_READ) != Fog::ERR_OK || stream.readAll(xml) == 0)
+    {
+      app.logf("Svg      : Can't read %S.\n", fileName.getData());
+      return 1;
+    }
+  }
+
+  {
+    Fog::SvgDocument doc;
+    Fog::Stream stream;
+
+    err_t err = doc.readFromMemory(xml.getData(), xml.getLength());
+    if (err == Fog::ERR_OK)
+      err = stream.openBuffer();
+    if (err == Fog::ERR_OK)
+      err = doc.writeSnapshot(stream);
+
+    if (err != Fog::ERR_OK)
+    {
+      app.logf("Svg      : Can't create snapshot of %S (error %u).\n", fileName.getData(), err);
+      return 1;
+    }
+
+    snapshot = stream.getBuffer();
+  }
+
+  app.logf("Svg      : %S, best of %u loads\n", fileName.getData(), iterations);
+  app.logf("\n");
+
+  // StringW::format() doesn't support width and precision of floats, rows
+  // are formatted by the C library.
+  char line[256];
+
+  snprintf(line, FOG_ARRAY_SIZE(line), "%-16s| %12s | %10s |\n", "Format", "Size[bytes]", "Time[ms]");
+  app.logf("%s", line);
+
+  for (uint32_t i = 0; i < 2; i++)
+  {
+    bool isSnapshot = (i == 1);
+    const Fog::StringA& data = isSnapshot ? snapshot : xml;
+
+    err_t err;
+    uint64_t time = runTest(isSnapshot, data, err);
+
+    if (err != Fog::ERR_OK)
+    {
+      app.logf("%-16s| failed (error %u)\n", isSnapshot ? "Snapshot" : "XML", err);
+      return 1;
+    }
+
+    snprintf(line, FOG_ARRAY_SIZE(line), "%-16s| %12llu | %10.3f |\n",
+      isSnapshot ? "Snapshot" : "XML",
+      (unsigned long long)data.getLength(),
+      (double)time / 1000.0);
+    app.logf("%s", line);
+  }
+
+  app.logf("\n");
+  return 0;
+}
+
+uint64_t BenchSvg::runTest(bool snapshot, const Fog::StringA& data, err_t& err)
+{
+  uint64_t best = 0;
+  err = Fog::ERR_OK;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    Fog::SvgDocument doc;
+    Fog::TimeTicks startTime = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+
+    if (snapshot)
+      err = doc.readSnapshotFromMemory(data.getData(), data.getLength());
+    else
+      err = doc.readFromMemory(data.getData(), data.getLength());
+
+    Fog::TimeDelta time = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - startTime;
+
+    if (err != Fog::ERR_OK)
+      return 0;
+
+    uint64_t t = (uint64_t)time.getDelta();
+    if (i == 0 || t < best)
+      best = t;
+  }
+
+  return best;
+}
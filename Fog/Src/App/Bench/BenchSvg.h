@@ -0,0 +1,55 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHSVG_H
+#define _FOG_BENCHSVG_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BenchSvg]
+// ============================================================================
+
+//! @brief SVG load benchmark.
+//!
+//! Compares loading of a SVG document from XML and from a binary snapshot
+//! (see @c Fog::DomDocument::writeSnapshot()). Both documents are read from
+//! memory, so the file system is not measured.
+struct BenchSvg
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  BenchSvg(BenchApp& app, const Fog::StringW& fileName);
+  ~BenchSvg();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  //! @brief Run the benchmark, returns zero on success.
+  int run();
+
+  //! @brief Load the document @c iterations times, returns the best time in
+  //! microseconds.
+  uint64_t runTest(bool snapshot, const Fog::StringA& data, err_t& err);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief SVG file.
+  Fog::StringW fileName;
+  //! @brief Count of loads, the best time is reported.
+  uint32_t iterations;
+};
+
+// [Guard]
+#endif // _FOG_BENCHSVG_H
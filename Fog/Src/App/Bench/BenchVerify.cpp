@@ -0,0 +1,287 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchVerify.h"
+
+// The raster tier is internal, all tiers are compared against the C tier.
+#include <Fog/G2d/Painting/RasterApi_p.h>
+
+// ============================================================================
+// [BenchVerify - Construction / Destruction]
+// ============================================================================
+
+BenchVerify::BenchVerify(BenchApp& app, const Fog::StringW& dir) :
+  app(app),
+  dir(dir),
+  update(false),
+  tier(BENCH_TIER_ALL),
+  tolerance(0),
+  simdTolerance(6),
+  screenSize(128, 128),
+  quantity(50),
+  shapeSize(48)
+{
+}
+
+BenchVerify::~BenchVerify()
+{
+}
+
+// ============================================================================
+// [BenchVerify - Run]
+// ============================================================================
+
+uint32_t BenchVerify::run(BenchModule* module)
+{
+  uint32_t savedTier = Fog::RasterOps_getTier();
+  uint32_t failures = 0;
+  uint32_t i;
+
+  // The golden images are always rendered by the C tier (reference).
+  if (update)
+  {
+    Fog::RasterOps_setTier(Fog::RASTER_TIER_C);
+    failures += runTier(module, true);
+  }
+
+  for (i = 0; i < BENCH_TIER_COUNT; i++)
+  {
+    if (tier != BENCH_TIER_ALL && tier != i)
+      continue;
+
+    // The golden images were just written by the C tier.
+    if (update && i == BENCH_TIER_C)
+      continue;
+
+    if (Fog::RasterOps_setTier(i) != Fog::ERR_OK)
+    {
+      app.logf("Tier     : %S (not supported, skipped)\n", app.getTierString(i).getData());
+      app.logf("\n");
+
+      // The selected tier must be verified.
+      if (tier != BENCH_TIER_ALL)
+        failures++;
+      continue;
+    }
+
+    failures += runTier(module, false);
+  }
+
+  Fog::RasterOps_setTier(savedTier);
+  return failures;
+}
+
+uint32_t BenchVerify::runTier(BenchModule* module, bool write)
+{
+  size_t formatIndex;
+  uint32_t type;
+  uint32_t failures = 0;
+
+  BenchParams params;
+  params.screenSize = screenSize;
+  params.quantity = quantity;
+  params.shapeSize = shapeSize;
+
+  Fog::List<uint32_t> formats = module->getSupportedPixelFormats();
+
+  uint32_t tierTolerance = tolerance;
+  if (Fog::RasterOps_getTier() != Fog::RASTER_TIER_C && !write)
+    tierTolerance = Fog::Math::max<uint32_t>(tolerance, simdTolerance);
+
+  if (write && !Fog::FileUtil::isDirectory(dir) && Fog::FileUtil::createDirectory(dir) != Fog::ERR_OK)
+  {
+    app.logf("Can't create directory '%S'.\n", dir.getData());
+    return 1;
+  }
+
+  app.logf("Tier     : %S\n", app.getTierString(Fog::RasterOps_getTier()).getData());
+  app.logf("Verify   : %S (%s, tolerance %u)\n",
+    dir.getData(), write ? "update" : "compare", tierTolerance);
+  app.logf("\n");
+
+  for (formatIndex = 0; formatIndex < formats.getLength(); formatIndex++)
+  {
+    params.format = formats[formatIndex];
+
+    for (type = 0; type < BENCH_TYPE_COUNT; type++)
+    {
+      if (type == BENCH_TYPE_CREATE_DESTROY)
+        continue;
+
+      if (app.sprites.isEmpty() && (
+          type == BENCH_TYPE_BLIT_IMAGE_I ||
+          type == BENCH_TYPE_BLIT_IMAGE_F ||
+          type == BENCH_TYPE_BLIT_IMAGE_ROTATE))
+      {
+        continue;
+      }
+
+      params.type = type;
+      params.source = app.hasBenchSource(type) ? 0 : BENCH_SOURCE_NONE;
+
+      for (;;)
+      {
+        params.op = 0;
+
+        for (;;)
+        {
+          BenchOutput output;
+          module->bench(output, params);
+
+          if (!verifyTest(module, params, output, write, tierTolerance))
+            failures++;
+
+          if (params.op >= BENCH_OPERATOR_COUNT - 1)
+            break;
+          params.op++;
+        }
+
+        if (params.source == BENCH_SOURCE_NONE || params.source >= BENCH_SOURCE_COUNT - 1)
+          break;
+        params.source++;
+      }
+    }
+  }
+
+  app.logf("\n");
+  app.logf("%S: %u failure(s)\n", module->getModuleName().getData(), failures);
+
+  return failures;
+}
+
+bool BenchVerify::verifyTest(BenchModule* module, const BenchParams& params, const BenchOutput& output, bool write, uint32_t tierTolerance)
+{
+  Fog::StringW s;
+  Fog::StringW fileName = getGoldenName(params);
+
+  s.append(module->getModuleName());
+  s.append(Fog::CharW(' '));
+  s.append(app.getFormatString(params.format));
+  s.append(Fog::CharW(' '));
+  s.append(app.getTestString(params));
+  s.justify(48, Fog::CharW(' '), Fog::TEXT_JUSTIFY_LEFT);
+  s.appendFormat("|%8qu us| ", (uint64_t)output.time.getMicroseconds());
+
+  bool result = false;
+  Fog::StringA buffer;
+
+  if (encodeImage(buffer, module->screen) != Fog::ERR_OK)
+  {
+    s.append(Fog::Ascii8("ERROR (can't encode)"));
+  }
+  else if (write)
+  {
+    if (module->screen.writeToFile(fileName) == Fog::ERR_OK)
+    {
+      s.append(Fog::Ascii8("UPDATED"));
+      result = true;
+    }
+    else
+    {
+      s.append(Fog::Ascii8("ERROR (can't write golden)"));
+    }
+  }
+  else
+  {
+    Fog::Image actual;
+    Fog::Image golden;
+
+    if (golden.readFromFile(fileName) != Fog::ERR_OK)
+    {
+      s.append(Fog::Ascii8("MISSING"));
+    }
+    else if (actual.readFromBuffer(buffer, Fog::StringW::fromAscii8("png")) != Fog::ERR_OK)
+    {
+      s.append(Fog::Ascii8("ERROR (can't decode)"));
+    }
+    else
+    {
+      uint32_t maxDiff = 0;
+      uint32_t count = compareImages(actual, golden, tierTolerance, maxDiff);
+
+      if (count == 0)
+      {
+        s.append(Fog::Ascii8("OK"));
+        result = true;
+      }
+      else if (count == 0xFFFFFFFFU)
+      {
+        s.append(Fog::Ascii8("FAIL (size or format mismatch)"));
+      }
+      else
+      {
+        s.appendFormat("FAIL (%u pixels, max diff %u)", count, maxDiff);
+      }
+    }
+  }
+
+  s.append(Fog::CharW('\n'));
+  app.logs(s);
+
+  return result;
+}
+
+// ============================================================================
+// [BenchVerify - Helpers]
+// ============================================================================
+
+Fog::StringW BenchVerify::getGoldenName(const BenchParams& params) const
+{
+  Fog::StringW fileName(dir);
+
+  if (!fileName.isEmpty() && !fileName.endsWith(Fog::CharW('/')))
+    fileName.append(Fog::CharW('/'));
+
+  fileName.append(app.getFormatString(params.format));
+  fileName.append(Fog::CharW('-'));
+  fileName.append(app.getTestString(params));
+  fileName.append(Fog::Ascii8(".png"));
+
+  return fileName;
+}
+
+err_t BenchVerify::encodeImage(Fog::StringA& dst, const Fog::Image& src)
+{
+  return src.writeToBuffer(dst, Fog::CONTAINER_OP_REPLACE, Fog::StringW::fromAscii8("png"));
+}
+
+uint32_t BenchVerify::compareImages(const Fog::Image& a, const Fog::Image& b, uint32_t tolerance, uint32_t& maxDiff)
+{
+  if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight() || a.getFormat() != b.getFormat())
+    return 0xFFFFFFFFU;
+
+  int w = a.getWidth();
+  int h = a.getHeight();
+  uint32_t bpp = a.getDepth() >> 3;
+
+  const uint8_t* aLine = a.getFirst();
+  const uint8_t* bLine = b.getFirst();
+
+  uint32_t count = 0;
+  maxDiff = 0;
+
+  for (int y = 0; y < h; y++, aLine += a.getStride(), bLine += b.getStride())
+  {
+    const uint8_t* aPix = aLine;
+    const uint8_t* bPix = bLine;
+
+    for (int x = 0; x < w; x++, aPix += bpp, bPix += bpp)
+    {
+      uint32_t pixelDiff = 0;
+
+      for (uint32_t i = 0; i < bpp; i++)
+      {
+        uint32_t d = aPix[i] > bPix[i] ? aPix[i] - bPix[i] : bPix[i] - aPix[i];
+        if (d > pixelDiff) pixelDiff = d;
+      }
+
+      if (pixelDiff > maxDiff) maxDiff = pixelDiff;
+      if (pixelDiff > tolerance) count++;
+    }
+  }
+
+  return count;
+}
@@ -0,0 +1,92 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHVERIFY_H
+#define _FOG_BENCHVERIFY_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BenchVerify]
+// ============================================================================
+
+//! @brief Pixel-exact rendering regression suite.
+//!
+//! Runs every test of a module once using a small deterministic workload and
+//! compares the rendered screen with a golden PNG image stored in @c dir. The
+//! golden images are rendered by the C tier, all raster tiers supported by the
+//! CPU (C, SSE2, SSSE3, AVX2) are verified against them, or only @c tier if
+//! selected by FogBench --tier. The C tier must match the golden images
+//! exactly (unless @c tolerance is given), the SIMD tiers may differ up to
+//! @c simdTolerance. The golden images are stored in Src/App/Bench/Golden.
+//!
+//! Both images are passed through the PNG codec before comparing so the
+//! result doesn't depend on whether the golden was just written or read
+//! back from the disk.
+struct BenchVerify
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  BenchVerify(BenchApp& app, const Fog::StringW& dir);
+  ~BenchVerify();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  //! @brief Verify all tests of @a module using all selected tiers, returns
+  //! the count of failures.
+  uint32_t run(BenchModule* module);
+
+  //! @brief Verify all tests of @a module using the current tier, or write the
+  //! golden images if @a write is true. Returns the count of failures.
+  uint32_t runTier(BenchModule* module, bool write);
+
+  //! @brief Verify a single test rendered into @c module->screen.
+  bool verifyTest(BenchModule* module, const BenchParams& params, const BenchOutput& output, bool write, uint32_t tierTolerance);
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  Fog::StringW getGoldenName(const BenchParams& params) const;
+
+  static err_t encodeImage(Fog::StringA& dst, const Fog::Image& src);
+  static uint32_t compareImages(const Fog::Image& a, const Fog::Image& b, uint32_t tolerance, uint32_t& maxDiff);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Directory containing the golden images.
+  Fog::StringW dir;
+
+  //! @brief Whether to (re)write golden images (using the C tier) before
+  //! comparing.
+  bool update;
+  //! @brief Tier to verify, or @c BENCH_TIER_ALL.
+  uint32_t tier;
+  //! @brief Maximum allowed per-channel difference.
+  uint32_t tolerance;
+  //! @brief Maximum allowed per-channel difference of SIMD tiers (used if
+  //! greater than @c tolerance).
+  //!
+  //! SIMD compositors round intermediate results differently than the C tier
+  //! and the error accumulates where shapes overlap, currently up to 5.
+  uint32_t simdTolerance;
+
+  Fog::SizeI screenSize;
+  uint32_t quantity;
+  uint32_t shapeSize;
+};
+
+// [Guard]
+#endif // _FOG_BENCHVERIFY_H
@@ -106,6 +106,7 @@
 //! - @ref FOG_HARDCODE_SSE2 (hardcode for SSE2).
 //! - @ref FOG_HARDCODE_SSE3 (hardcode for SSE3).
 //! - @ref FOG_HARDCODE_SSSE3 (hardcode for SSSE3).
+//! - @ref FOG_HARDCODE_AVX2 (hardcode for AVX2).
 //!
 //! List of ARM hardcode definitions:
 //!
@@ -441,6 +442,7 @@
 //!
 //! Threads, thread pools, synchronization primitives, and atomic operations.
 
+#include <Fog/Core/Threading/AdaptiveLock.h>
 #include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Threading/AtomicPadding.h>
 #include <Fog/Core/Threading/Lock.h>
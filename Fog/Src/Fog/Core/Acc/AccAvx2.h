@@ -0,0 +1,305 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_ACC_ACCAVX2_H
+#define _FOG_CORE_ACC_ACCAVX2_H
+
+// [Dependencies]
+#include <Fog/Core/C++/Base.h>
+#include <Fog/Core/C++/IntrinAvx2.h>
+
+#include <Fog/Core/Acc/AccSse.h>
+#include <Fog/Core/Acc/AccSse2.h>
+#include <Fog/Core/Acc/AccSse3.h>
+#include <Fog/Core/Acc/AccSsse3.h>
+
+namespace Fog {
+namespace Acc {
+
+//! @addtogroup Fog_Core_Acc_Avx2
+//! @{
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Zero / Fill]
+// ============================================================================
+
+static FOG_INLINE void m256iZero(__m256i& dst0)
+{
+  dst0 = _mm256_setzero_si256();
+}
+
+static FOG_INLINE void m256iFill(__m256i& dst0)
+{
+  dst0 = _mm256_set1_epi32(-1);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Load / Store]
+// ============================================================================
+
+template<typename SrcT>
+static FOG_INLINE void m256iLoad32u(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(srcp));
+}
+
+template<typename DstT>
+static FOG_INLINE void m256iStore32u(DstT* dstp, const __m256i& x0)
+{
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstp), x0);
+}
+
+//! @brief Load only the 32-bit elements selected by @a msk0, the other ones
+//! are zeroed and never touched in memory.
+template<typename SrcT>
+static FOG_INLINE void m256iLoadMaskPI32(__m256i& dst0, const SrcT* srcp, const __m256i& msk0)
+{
+  dst0 = _mm256_maskload_epi32(reinterpret_cast<const int*>(srcp), msk0);
+}
+
+//! @brief Store only the 32-bit elements selected by @a msk0.
+template<typename DstT>
+static FOG_INLINE void m256iStoreMaskPI32(DstT* dstp, const __m256i& x0, const __m256i& msk0)
+{
+  _mm256_maskstore_epi32(reinterpret_cast<int*>(dstp), msk0, x0);
+}
+
+//! @brief Load 8 bytes and zero-extend them to eight 32-bit integers.
+template<typename SrcT>
+static FOG_INLINE void m256iLoad8ExtendPI32FromPU8(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcp)));
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Masks]
+// ============================================================================
+
+//! @brief Create a mask where the first @a n 32-bit elements are set (n <= 8).
+static FOG_INLINE void m256iHeadMaskPI32(__m256i& dst0, int n)
+{
+  dst0 = _mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Extend]
+// ============================================================================
+
+static FOG_INLINE void m256iExtendPI32FromSI32(__m256i& dst0, uint32_t x0)
+{
+  dst0 = _mm256_set1_epi32((int)x0);
+}
+
+static FOG_INLINE void m256iExtendPI16FromSI16(__m256i& dst0, uint32_t x0)
+{
+  dst0 = _mm256_set1_epi16((short)x0);
+}
+
+//! @brief Create eight 32-bit integers [x0, x0 + y0, ..., x0 + 7 * y0].
+static FOG_INLINE void m256iSeqPI32(__m256i& dst0, int x0, int y0)
+{
+  dst0 = _mm256_add_epi32(_mm256_set1_epi32(x0),
+    _mm256_mullo_epi32(_mm256_set1_epi32(y0), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Logical]
+// ============================================================================
+
+static FOG_INLINE void m256iOr(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_or_si256(x0, y0);
+}
+
+static FOG_INLINE void m256iXor(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_xor_si256(x0, y0);
+}
+
+static FOG_INLINE void m256iAnd(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_and_si256(x0, y0);
+}
+
+static FOG_INLINE void m256iAndNot(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_andnot_si256(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Arithmetic]
+// ============================================================================
+
+static FOG_INLINE void m256iAddPI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_add_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iAddPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_add_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iSubPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_sub_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iMulLoPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mullo_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iMulHiPU16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mulhi_epu16(x0, y0);
+}
+
+//! @brief Calculate (x0 * y0) / 255 of 16-bit integers (same rounding as
+//! @c m128iMulDiv255PI16()).
+static FOG_INLINE void m256iMulDiv255PI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mullo_epi16(x0, y0);
+  dst0 = _mm256_adds_epu16(dst0, _mm256_set1_epi16(0x0080));
+  dst0 = _mm256_mulhi_epu16(dst0, _mm256_set1_epi16(0x0101));
+}
+
+static FOG_INLINE void m256iNegate255PI16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_xor_si256(x0, _mm256_set1_epi16(0x00FF));
+}
+
+static FOG_INLINE void m256iMinPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_min_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iMaxPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_max_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iCmpGtPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_cmpgt_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Shift]
+// ============================================================================
+
+template<int N>
+static FOG_INLINE void m256iRShiftPI32(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_srai_epi32(x0, N);
+}
+
+template<int N>
+static FOG_INLINE void m256iLShiftPU16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_slli_epi16(x0, N);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Unpack / Pack]
+// ============================================================================
+
+//! @brief Zero-extend the low 8 bytes of each 128-bit lane to 16-bit integers.
+static FOG_INLINE void m256iUnpackPI16FromPI8Lo(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_unpacklo_epi8(x0, _mm256_setzero_si256());
+}
+
+//! @brief Zero-extend the high 8 bytes of each 128-bit lane to 16-bit integers.
+static FOG_INLINE void m256iUnpackPI16FromPI8Hi(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_unpackhi_epi8(x0, _mm256_setzero_si256());
+}
+
+//! @brief Pack 16-bit integers to bytes with unsigned saturation (per 128-bit
+//! lane, the inverse of @c m256iUnpackPI16FromPI8Lo/Hi()).
+static FOG_INLINE void m256iPackPU8FromPU16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_packus_epi16(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Shuffle]
+// ============================================================================
+
+static FOG_INLINE void m256iShufflePI8(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_shuffle_epi8(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Gather]
+// ============================================================================
+
+//! @brief Gather eight 32-bit integers from @a base indexed by @a idx0.
+template<typename SrcT>
+static FOG_INLINE void m256iGatherPI32(__m256i& dst0, const SrcT* base, const __m256i& idx0)
+{
+  dst0 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), idx0, 4);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Double]
+// ============================================================================
+
+static FOG_INLINE void m256dSet4(__m256d& dst0, double x0, double x1, double x2, double x3)
+{
+  dst0 = _mm256_setr_pd(x0, x1, x2, x3);
+}
+
+static FOG_INLINE void m256dExtendPD(__m256d& dst0, double x0)
+{
+  dst0 = _mm256_set1_pd(x0);
+}
+
+static FOG_INLINE void m256dAddPD(__m256d& dst0, const __m256d& x0, const __m256d& y0)
+{
+  dst0 = _mm256_add_pd(x0, y0);
+}
+
+static FOG_INLINE void m256dMulPD(__m256d& dst0, const __m256d& x0, const __m256d& y0)
+{
+  dst0 = _mm256_mul_pd(x0, y0);
+}
+
+static FOG_INLINE void m256dMinPD(__m256d& dst0, const __m256d& x0, const __m256d& y0)
+{
+  dst0 = _mm256_min_pd(x0, y0);
+}
+
+static FOG_INLINE void m256dMaxPD(__m256d& dst0, const __m256d& x0, const __m256d& y0)
+{
+  dst0 = _mm256_max_pd(x0, y0);
+}
+
+static FOG_INLINE void m256dSqrtPD(__m256d& dst0, const __m256d& x0)
+{
+  dst0 = _mm256_sqrt_pd(x0);
+}
+
+static FOG_INLINE void m256dAbsPD(__m256d& dst0, const __m256d& x0)
+{
+  dst0 = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x0);
+}
+
+//! @brief Truncate four doubles to 32-bit integers (like C cast).
+static FOG_INLINE void m128iTruncPI32FromPD(__m128i& dst0, const __m256d& x0)
+{
+  dst0 = _mm256_cvttpd_epi32(x0);
+}
+
+//! @}
+
+} // Acc namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_ACC_ACCAVX2_H
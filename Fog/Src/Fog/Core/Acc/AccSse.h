@@ -28,7 +28,10 @@ FOG_XMM_DECLARE_CONST_PI32_VAR(m128f_sn_sn_p0_p0    , 0x80000000, 0x80000000, 0x
 FOG_XMM_DECLARE_CONST_PI32_VAR(m128f_nm_nm_nm_nm    , 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF);
 
 FOG_XMM_DECLARE_CONST_PS_VAR  (m128f_p0_p0_p0_p1    , 0.0f, 0.0f, 0.0f, 1.0f);
+FOG_XMM_DECLARE_CONST_PS_VAR  (m128f_p0_p1_p1_p1    , 0.0f, 1.0f, 1.0f, 1.0f);
+FOG_XMM_DECLARE_CONST_PS_VAR  (m128f_p255_p0_p0_p0  , 255.0f, 0.0f, 0.0f, 0.0f);
 
+FOG_XMM_DECLARE_CONST_PS_SET  (m128f_4x_0_5         , 0.5f);
 FOG_XMM_DECLARE_CONST_PS_SET  (m128f_p1_p1_p1_p1    , 1.0f);
 FOG_XMM_DECLARE_CONST_PS_SET  (m128f_eps_eps_eps_eps, Fog::MATH_EPSILON_F);
 
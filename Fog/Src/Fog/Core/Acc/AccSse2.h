@@ -523,6 +523,11 @@ static FOG_INLINE void m128iUnpackSI128FromPI64Hi(__m128i& dst0, const __m128i&
   dst0 = _mm_unpackhi_epi64(x0, _mm_setzero_si128());
 }
 
+static FOG_INLINE void m128iUnpackSI128FromPI64Hi(__m128i& dst0, const __m128i& x0, const __m128i& y0)
+{
+  dst0 = _mm_unpackhi_epi64(x0, y0);
+}
+
 static FOG_INLINE void m128dUnpackLoPD(__m128d& dst0, const __m128d& x0, const __m128d& y0)
 {
   dst0 = _mm_unpacklo_pd(x0, y0);
@@ -1596,6 +1601,16 @@ static FOG_INLINE void m128iRShiftPI32(__m128i& dst0, const __m128i& x0)
   dst0 = _mm_srai_epi32(x0, COUNT_BITS);
 }
 
+static FOG_INLINE void m128iLShiftPU32(__m128i& dst0, const __m128i& x0, const __m128i& count)
+{
+  dst0 = _mm_sll_epi32(x0, count);
+}
+
+static FOG_INLINE void m128iRShiftPU32(__m128i& dst0, const __m128i& x0, const __m128i& count)
+{
+  dst0 = _mm_srl_epi32(x0, count);
+}
+
 // ============================================================================
 // [Fog::Acc - SSE2 - Negate255/256]
 // ============================================================================
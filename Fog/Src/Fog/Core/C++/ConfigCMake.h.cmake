@@ -23,6 +23,12 @@
 //! @brief Whether to build Fog/UI-X11 module.
 #cmakedefine FOG_BUILD_UI_X11_MODULE
 
+//! @brief Whether to collect paint-engine statistics (Fog::PaintStatistics).
+#cmakedefine FOG_BUILD_PAINT_STATISTICS
+
+//! @brief Whether to record contention of locks (Fog::LockProfile).
+#cmakedefine FOG_BUILD_LOCK_PROFILING
+
 // ============================================================================
 // [FOG_DEBUG]
 // ============================================================================
@@ -70,6 +76,9 @@
 //! @brief Enable support for x86/x64 SSSE3 instructions.
 #cmakedefine FOG_OPTIMIZE_SSSE3
 
+//! @brief Enable support for x86/x64 AVX2 instructions.
+#cmakedefine FOG_OPTIMIZE_AVX2
+
 //! @brief Enable support for ARM Neon instructions.
 #cmakedefine FOG_OPTIMIZE_NEON
 
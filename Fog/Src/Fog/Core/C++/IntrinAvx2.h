@@ -0,0 +1,29 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_CPP_INTRINAVX2_H
+#define _FOG_CORE_CPP_INTRINAVX2_H
+
+// [Dependencies]
+#include <Fog/Core/C++/Base.h>
+#include <Fog/Core/C++/IntrinSsse3.h>
+
+#include <immintrin.h>
+
+//! @addtogroup Fog_Core_Cpp_Intrin
+//! @{
+
+// ============================================================================
+// [__m256f]
+// ============================================================================
+
+//! @brief 256-bit AVX float register (matches @c __m256i and @c __m256d).
+typedef __m256 __m256f;
+
+//! @}
+
+// [Guard]
+#endif // _FOG_CORE_CPP_INTRINAVX2_H
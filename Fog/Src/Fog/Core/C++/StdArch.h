@@ -51,6 +51,14 @@
 //! @brief If defined, SSE3 assembly will be hardcoded into binaries and no 
 //! lower optimizations are allowed.
 
+//! @def FOG_HARDCODE_SSSE3
+//! @brief If defined, SSSE3 assembly will be hardcoded into binaries and no
+//! lower optimizations are allowed.
+
+//! @def FOG_HARDCODE_AVX2
+//! @brief If defined, AVX2 assembly will be hardcoded into binaries and no
+//! lower optimizations are allowed.
+
 //! @def FOG_HARDCODE_NEON
 //! @brief If defined, NEON assembly will be hardcoded into binaries and no 
 //! lower optimizations are allowed.
@@ -221,6 +229,10 @@
 // [Fog::Core::C++ - CPU Architecture hardcoding]
 // ============================================================================
 
+#if defined(FOG_HARDCODE_AVX2) && !defined(FOG_HARDCODE_SSSE3)
+# define FOG_HARDCODE_SSSE3
+#endif 
+
 #if defined(FOG_HARDCODE_SSSE3) && !defined(FOG_HARDCODE_SSE3)
 # define FOG_HARDCODE_SSE3
 #endif 
@@ -51,4 +51,8 @@
 # include <Fog/Core/C++/IntrinSsse3.h>
 #endif // FOG_HARDCODE_SSSE3
 
+#if defined(FOG_HARDCODE_AVX2)
+# include <Fog/Core/C++/IntrinAvx2.h>
+#endif // FOG_HARDCODE_AVX2
+
 #endif // _FOG_CORE_CPP_STDHEADERS_H
@@ -10,10 +10,14 @@
 
 // [Dependencies]
 #include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Dom/DomSnapshot_p.h>
+#include <Fog/Core/Dom/DomWriter_p.h>
 #include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/OS/FileMapping.h>
 #include <Fog/Core/Tools/Logger.h>
 #include <Fog/Core/Tools/InternedString.h>
+#include <Fog/Core/Tools/Stream.h>
 #include <Fog/Core/Tools/StringUtil.h>
 #include <Fog/Core/Tools/XmlIO.h>
 
@@ -2510,6 +2514,11 @@ DomText* DomDocument::_createTextNode(
   return fog_new_p(p) DomText(this, data);
 }
 
+DomSaxHandler* DomDocument::_createSaxHandler()
+{
+  return fog_new DomSaxHandler(this);
+}
+
 // ============================================================================
 // [Fog::DomDocument - CloneDocument]
 // ============================================================================
@@ -2664,42 +2673,133 @@ err_t DomDocument::setXmlVersion(const StringW& xmlVersion)
 
 err_t DomDocument::readFromFile(const StringW& fileName)
 {
-  DomSaxHandler domHandler(this);
-  XmlSaxParser parser(&domHandler);
+  DomSaxHandler* domHandler = _createSaxHandler();
+  if (FOG_IS_NULL(domHandler))
+    return ERR_RT_OUT_OF_MEMORY;
 
-  return parser.parseFile(fileName);
+  XmlSaxParser parser(domHandler);
+  err_t err = parser.parseFile(fileName);
+
+  fog_delete(domHandler);
+  return err;
 }
 
 err_t DomDocument::readFromStream(Stream& stream)
 {
-  DomSaxHandler domHandler(this);
-  XmlSaxParser parser(&domHandler);
+  DomSaxHandler* domHandler = _createSaxHandler();
+  if (FOG_IS_NULL(domHandler))
+    return ERR_RT_OUT_OF_MEMORY;
 
-  return parser.parseStream(stream);
+  XmlSaxParser parser(domHandler);
+  err_t err = parser.parseStream(stream);
+
+  fog_delete(domHandler);
+  return err;
 }
 
 err_t DomDocument::readFromMemory(const void* mem, size_t size)
 {
-  DomSaxHandler domHandler(this);
-  XmlSaxParser parser(&domHandler);
+  DomSaxHandler* domHandler = _createSaxHandler();
+  if (FOG_IS_NULL(domHandler))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  XmlSaxParser parser(domHandler);
+  err_t err = parser.parseMemory(mem, size);
 
-  return parser.parseMemory(mem, size);
+  fog_delete(domHandler);
+  return err;
 }
 
 err_t DomDocument::readFromString(const StringW& str)
 {
-  DomSaxHandler domHandler(this);
-  XmlSaxParser parser(&domHandler);
+  DomSaxHandler* domHandler = _createSaxHandler();
+  if (FOG_IS_NULL(domHandler))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  XmlSaxParser parser(domHandler);
+  err_t err = parser.parseString(str);
 
-  return parser.parseString(str);
+  fog_delete(domHandler);
+  return err;
 }
 
 err_t DomDocument::readFromString(const StubW& str)
 {
-  DomSaxHandler domHandler(this);
-  XmlSaxParser parser(&domHandler);
+  DomSaxHandler* domHandler = _createSaxHandler();
+  if (FOG_IS_NULL(domHandler))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  XmlSaxParser parser(domHandler);
+  err_t err = parser.parseString(str);
+
+  fog_delete(domHandler);
+  return err;
+}
+
+err_t DomDocument::writeToStream(Stream& stream) const
+{
+  DomXmlWriter writer(this, stream);
+  return writer.write();
+}
+
+err_t DomDocument::writeToFile(const StringW& fileName) const
+{
+  Stream stream;
+  FOG_RETURN_ON_ERROR(stream.openFile(fileName,
+    STREAM_OPEN_WRITE | STREAM_OPEN_CREATE | STREAM_OPEN_TRUNCATE));
+
+  return writeToStream(stream);
+}
 
-  return parser.parseString(str);
+bool DomDocument::_serializeValue(const DomElement* element, size_t index,
+  StringA& dst) const
+{
+  return false;
+}
+
+// ============================================================================
+// [Fog::DomDocument - Snapshot]
+// ============================================================================
+
+err_t DomDocument::writeSnapshot(Stream& stream) const
+{
+  DomSnapshotWriter writer(this);
+  return writer.write(stream);
+}
+
+err_t DomDocument::writeSnapshotToFile(const StringW& fileName) const
+{
+  Stream stream;
+  FOG_RETURN_ON_ERROR(stream.openFile(fileName,
+    STREAM_OPEN_WRITE | STREAM_OPEN_CREATE | STREAM_OPEN_TRUNCATE));
+
+  return writeSnapshot(stream);
+}
+
+err_t DomDocument::readSnapshotFromFile(const StringW& fileName)
+{
+  FileMapping mapping;
+  FOG_RETURN_ON_ERROR(mapping.open(fileName, FILE_MAPPING_FLAG_LOAD_FALLBACK));
+
+  return readSnapshotFromMemory(mapping.getData(), mapping.getLength());
+}
+
+err_t DomDocument::readSnapshotFromMemory(const void* mem, size_t size)
+{
+  DomSnapshotReader reader(this);
+  return reader.read(mem, size);
+}
+
+bool DomDocument::_encodeSnapshotValue(const DomElement* element, size_t index,
+  uint32_t& type, StringA& data) const
+{
+  return false;
+}
+
+err_t DomDocument::_decodeSnapshotValue(DomElement* element, const InternedStringW& name,
+  uint32_t type, const void* data, size_t size)
+{
+  return ERR_DOM_SNAPSHOT_INCOMPATIBLE;
 }
 
 // ============================================================================
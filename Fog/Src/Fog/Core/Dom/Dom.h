@@ -886,6 +886,12 @@ struct FOG_API DomDocument : public DomContainer
   virtual DomText* _createTextNode(
     const StringW& data);
 
+  //! @brief Create SAX handler used by @c readFromXXX() methods.
+  //!
+  //! The handler is destroyed by @c fog_delete() after the document has been
+  //! read.
+  virtual DomSaxHandler* _createSaxHandler();
+
   //! @internal
   template<typename ElementT>
   FOG_INLINE ElementT* _newElementT()
@@ -964,6 +970,58 @@ struct FOG_API DomDocument : public DomContainer
   err_t readFromString(const StringW& str);
   err_t readFromString(const StubW& str);
 
+  //! @brief Write DOM document as UTF-8 encoded XML to @a stream.
+  //!
+  //! The output is buffered and written to the stream in blocks. Properties
+  //! which weren't changed (equal to the defaults of a newly created element)
+  //! are not written.
+  err_t writeToStream(Stream& stream) const;
+  //! @brief Write DOM document as XML to file @a fileName.
+  err_t writeToFile(const StringW& fileName) const;
+
+  //! @brief Serialize attribute @a index of @a element into @a dst.
+  //!
+  //! Returns @c true if the attribute was serialized into @a dst, or @c false
+  //! if it should be written using @ref DomElement::getProperty() (the
+  //! default). The value must be ASCII which needs no escaping.
+  virtual bool _serializeValue(const DomElement* element, size_t index,
+    StringA& dst) const;
+
+  // --------------------------------------------------------------------------
+  // [Snapshot]
+  // --------------------------------------------------------------------------
+
+  //! @brief Write binary snapshot of the document to @a stream.
+  //!
+  //! Snapshot contains the document tree, names and strings are stored in
+  //! tables, and attributes which are expensive to parse are stored in
+  //! binary form (see @ref _encodeSnapshotValue()). Only attributes which
+  //! differ from the defaults of a newly created element are written.
+  //!
+  //! Snapshot uses native byte-order, it's intended to be a cache of parsed
+  //! documents, not an interchange format.
+  err_t writeSnapshot(Stream& stream) const;
+  //! @brief Write binary snapshot of the document to file @a fileName.
+  err_t writeSnapshotToFile(const StringW& fileName) const;
+
+  //! @brief Read document from binary snapshot stored in file @a fileName.
+  //!
+  //! The file is memory-mapped and nodes are created directly from it.
+  err_t readSnapshotFromFile(const StringW& fileName);
+  //! @brief Read document from binary snapshot stored in memory.
+  err_t readSnapshotFromMemory(const void* mem, size_t size);
+
+  //! @brief Encode attribute @a index of @a element into binary form.
+  //!
+  //! Returns @c true if the attribute was encoded into @a data and @a type,
+  //! or @c false if it should be stored as string (the default).
+  virtual bool _encodeSnapshotValue(const DomElement* element, size_t index,
+    uint32_t& type, StringA& data) const;
+
+  //! @brief Decode attribute encoded by @ref _encodeSnapshotValue().
+  virtual err_t _decodeSnapshotValue(DomElement* element, const InternedStringW& name,
+    uint32_t type, const void* data, size_t size);
+
   // --------------------------------------------------------------------------
   // [Resource Manager]
   // --------------------------------------------------------------------------
@@ -5,23 +5,238 @@
 
 // [Dependencies]
 #include <Fog/Core/Dom/DomResourceManager.h>
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Kernel/EventLoop.h>
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/Core/OS/FilePath.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/Cpu.h>
 #include <Fog/Core/Tools/Logger.h>
 #include <Fog/Core/Tools/Stream.h>
 #include <Fog/G2d/Imaging/Image.h>
 
 namespace Fog {
 
+// ============================================================================
+// [Fog::DomResourceLoadEntry]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Resource decoded by the loader, shared by all items which resolve
+//! to the same path.
+struct FOG_NO_EXPORT DomResourceLoadEntry
+{
+  FOG_INLINE DomResourceLoadEntry(const StringW& path) :
+    path(path),
+    error(ERR_OK)
+  {
+  }
+
+  //! @brief Resolved resource path.
+  StringW path;
+  //! @brief Names of resource items sharing the path.
+  List<StringW> names;
+
+  //! @brief Decoded data.
+  Var data;
+  //! @brief Error.
+  err_t error;
+};
+
+// ============================================================================
+// [Fog::DomResourceLoadJob]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT DomResourceLoadJob
+{
+  FOG_INLINE DomResourceLoadJob() :
+    event(true, false),
+    manager(NULL),
+    cache(NULL),
+    eventLoop(NULL),
+    numThreads(0)
+  {
+  }
+
+  FOG_INLINE ~DomResourceLoadJob()
+  {
+    size_t i, length = entries.getLength();
+    for (i = 0; i < length; i++)
+      fog_delete(entries.getAt(i));
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      fog_delete(this);
+  }
+
+  //! @brief Decode entries until there is nothing left.
+  void run();
+
+  //! @brief Reference count (the manager, each task and the finish task).
+  Atomic<size_t> reference;
+  //! @brief Index of the next entry to decode.
+  Atomic<size_t> next;
+  //! @brief Count of entries not decoded yet.
+  Atomic<size_t> remaining;
+  //! @brief Signaled when all entries are decoded.
+  ThreadEvent event;
+
+  //! @brief Resource manager which owns the job, NULL if detached.
+  //!
+  //! Accessed only by the thread which started the job.
+  DomResourceManager* manager;
+  //! @brief Decoded resource cache (can be NULL).
+  DomResourceCache* cache;
+  //! @brief Event loop where the results are published (NULL if blocking).
+  EventLoop* eventLoop;
+
+  //! @brief Entries to decode.
+  List<DomResourceLoadEntry*> entries;
+
+  //! @brief Threads taken from the thread pool.
+  Thread* threads[DOM_RESOURCE_LOADER_MAX_THREADS];
+  //! @brief Count of threads taken from the thread pool.
+  size_t numThreads;
+};
+
+//! @internal
+struct FOG_NO_EXPORT DomResourceLoadTask : public Task
+{
+  FOG_INLINE DomResourceLoadTask(DomResourceLoadJob* job) : job(job) {}
+
+  virtual void run()
+  {
+    job->run();
+    job->release();
+  }
+
+  DomResourceLoadJob* job;
+};
+
+//! @internal
+//!
+//! @brief Task posted to the owning event loop when all entries are decoded.
+struct FOG_NO_EXPORT DomResourceFinishTask : public Task
+{
+  FOG_INLINE DomResourceFinishTask(DomResourceLoadJob* job) : job(job) {}
+
+  virtual void run()
+  {
+    if (job->manager != NULL)
+      job->manager->_finishLoad(job);
+    job->release();
+  }
+
+  DomResourceLoadJob* job;
+};
+
+static err_t DomResourceManager_decode(const StringW& path, Var& data, DomResourceCache* cache)
+{
+  if (cache != NULL && cache->get(path, data))
+    return ERR_OK;
+
+  Stream stream;
+  err_t err = stream.openFile(path, STREAM_OPEN_READ);
+
+  if (FOG_IS_ERROR(err))
+  {
+    Logger::error("Fog::DomResourceManager", "_loadResourceItem",
+      "Failed to open the resource stream.");
+    return err;
+  }
+
+  Image image;
+  err = image.readFromStream(stream);
+
+  if (FOG_IS_ERROR(err))
+  {
+    Logger::error("Fog::DomResourceManager", "_loadResourceItem",
+      "Failed to load the image resource.");
+    return err;
+  }
+
+  data = Var::fromImage(image);
+
+  if (cache != NULL)
+    cache->put(path, data);
+
+  return ERR_OK;
+}
+
+void DomResourceLoadJob::run()
+{
+  size_t length = entries.getLength();
+
+  for (;;)
+  {
+    size_t i = next.addXchg(1);
+    if (i >= length)
+      break;
+
+    DomResourceLoadEntry* entry = entries.getAt(i);
+    entry->error = DomResourceManager_decode(entry->path, entry->data, cache);
+
+    if (!remaining.deref())
+      continue;
+
+    event.signal();
+    if (eventLoop == NULL)
+      continue;
+
+    DomResourceFinishTask* task = fog_new DomResourceFinishTask(this);
+    if (FOG_IS_NULL(task))
+    {
+      Logger::error("Fog::DomResourceManager", "_loadQueuedResourcesAsync",
+        "Failed to allocate memory for DomResourceFinishTask.");
+      continue;
+    }
+
+    reference.inc();
+    if (eventLoop->postTask(task) != ERR_OK)
+    {
+      Logger::error("Fog::DomResourceManager", "_loadQueuedResourcesAsync",
+        "Failed to post DomResourceFinishTask.");
+
+      reference.dec();
+      fog_delete(task);
+    }
+  }
+}
+
 // ============================================================================
 // [Fog::DomResourceManager - Construction / Destruction]
 // ============================================================================
 
-DomResourceManager::DomResourceManager()
+DomResourceManager::DomResourceManager() :
+  _resourceCache(NULL),
+  _loadJob(NULL)
 {
 }
 
 DomResourceManager::~DomResourceManager()
 {
+  DomResourceLoadJob* job = _loadJob;
+  if (job == NULL)
+    return;
+
+  // Wait for the loader threads and detach the job, the finish task which can
+  // be still queued in the event loop does nothing then.
+  job->event.wait();
+  job->manager = NULL;
+  _loadJob = NULL;
+
+  if (job->numThreads > 0)
+    ThreadPool::get()->releaseThreads(job->threads, job->numThreads);
+  job->release();
 }
 
 // ============================================================================
@@ -139,22 +354,234 @@ void DomResourceManager::_releaseResource(DomResourceItem* item)
 
 bool DomResourceManager::loadQueuedResources()
 {
+  _startLoad(false);
+  return _queue.isEmpty();
+}
+
+err_t DomResourceManager::loadQueuedResourcesAsync()
+{
+  return _startLoad(true);
+}
+
+err_t DomResourceManager::_startLoad(bool async)
+{
+  err_t err;
+
+  // Finish the previous job first, it contains items which were removed from
+  // the queue.
+  if (_loadJob != NULL)
+  {
+    _loadJob->event.wait();
+    _finishLoad(_loadJob);
+  }
+
+  if (_queue.isEmpty())
+    return ERR_OK;
+
+  DomResourceLoadJob* job = fog_new DomResourceLoadJob();
+  if (FOG_IS_NULL(job))
+  {
+    Logger::error("Fog::DomResourceManager", "_startLoad",
+      "Failed to allocate memory for DomResourceLoadJob.");
+    return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  job->reference.init(1);
+  job->manager = this;
+  job->cache = _resourceCache;
+
+  // --------------------------------------------------------------------------
+  // [Collect]
+  // --------------------------------------------------------------------------
+
+  // Items which resolve to the same path share a single entry, so each
+  // resource is decoded only once.
+  Hash<StringW, DomResourceLoadEntry*> entryMap;
   size_t i = 0;
-  
+
   while (_queue.getLength() > i)
   {
-    DomResourceItem* item =_queue.getAt(i);
+    DomResourceItem* item = _queue.getAt(i);
+    StringW path;
 
-    if (!_loadResource(item))
+    if (FOG_IS_ERROR(_resolveResource(item, path)))
+    {
       i++;
-    else
-      _queue.removeAt(i);
+      continue;
+    }
+
+    DomResourceLoadEntry* entry = entryMap.get(path, NULL);
+    if (entry == NULL)
+    {
+      entry = fog_new DomResourceLoadEntry(path);
+      if (FOG_IS_NULL(entry))
+      {
+        err = ERR_RT_OUT_OF_MEMORY;
+        goto _Fail;
+      }
+
+      if (FOG_IS_ERROR(err = job->entries.append(entry)))
+      {
+        fog_delete(entry);
+        goto _Fail;
+      }
+
+      if (FOG_IS_ERROR(err = entryMap.put(path, entry)))
+        goto _Fail;
+    }
+
+    if (FOG_IS_ERROR(err = entry->names.append(item->getName())))
+      goto _Fail;
+
+    item->_resourceFlags |= DOM_RESOURCE_FLAG_PENDING;
+    _queue.removeAt(i);
   }
 
-  return _queue.isEmpty();
+  {
+    size_t length = job->entries.getLength();
+    if (length == 0)
+    {
+      fog_delete(job);
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Threads]
+    // ------------------------------------------------------------------------
+
+    // Results of the asynchronous load are published by a task posted to the
+    // event loop of the calling thread, if there is no such event loop then
+    // the resources are loaded synchronously.
+    EventLoop* eventLoop = NULL;
+    if (async)
+    {
+      Thread* current = Thread::getCurrentThread();
+      if (current != NULL && current->getEventLoop().isCreated())
+        eventLoop = &current->getEventLoop();
+      else
+        async = false;
+    }
+
+    // Blocking load uses also the calling thread to decode resources.
+    size_t numThreads = Math::min<size_t>(
+      Cpu::get()->getNumberOfProcessors(), length, DOM_RESOURCE_LOADER_MAX_THREADS);
+
+    if (!async)
+      numThreads--;
+
+    ThreadPool* pool = ThreadPool::get();
+    while (numThreads > 0 && pool->getThreads(job->threads, numThreads) != ERR_OK)
+      numThreads >>= 1;
+
+    job->eventLoop = eventLoop;
+    job->numThreads = numThreads;
+    job->reference.init(1 + numThreads);
+    job->next.init(0);
+    job->remaining.init(length);
+
+    _loadJob = job;
+
+    for (i = 0; i < numThreads; i++)
+    {
+      DomResourceLoadTask* task = fog_new DomResourceLoadTask(job);
+      if (FOG_IS_NULL(task) || job->threads[i]->getEventLoop().postTask(task) != ERR_OK)
+      {
+        if (task != NULL)
+          fog_delete(task);
+        job->reference.dec();
+      }
+    }
+
+    // If no task was posted the calling thread decodes everything, even if
+    // the load was asynchronous.
+    if (!async || job->reference.get() == 1)
+    {
+      job->run();
+      job->event.wait();
+      _finishLoad(job);
+    }
+  }
+
+  return ERR_OK;
+
+_Fail:
+  Logger::error("Fog::DomResourceManager", "_startLoad",
+    "Failed to prepare the load job.");
+
+  // Return the items collected so far back to the queue.
+  _loadJob = job;
+  job->event.signal();
+  _finishLoad(job);
+  return err;
+}
+
+void DomResourceManager::_finishLoad(DomResourceLoadJob* job)
+{
+  if (job->manager != this)
+    return;
+
+  job->manager = NULL;
+  if (_loadJob == job)
+    _loadJob = NULL;
+
+  size_t i, length = job->entries.getLength();
+  for (i = 0; i < length; i++)
+  {
+    DomResourceLoadEntry* entry = job->entries.getAt(i);
+
+    size_t j, count = entry->names.getLength();
+    for (j = 0; j < count; j++)
+    {
+      // The item could be released while the resource was being loaded.
+      DomResourceItem* item = _externalResources.get(entry->names.getAt(j), NULL);
+      if (item == NULL || (item->_resourceFlags & DOM_RESOURCE_FLAG_PENDING) == 0)
+        continue;
+
+      item->_resourceFlags &= ~DOM_RESOURCE_FLAG_PENDING;
+
+      if (entry->error == ERR_OK && !entry->data.isNull())
+      {
+        item->_resourceFlags &= ~DOM_RESOURCE_FLAG_ERROR;
+        item->setError(ERR_OK);
+        item->setData(entry->data);
+      }
+      else
+      {
+        // Failed items stay in the queue, like when loaded by _loadResource().
+        item->_resourceFlags |= DOM_RESOURCE_FLAG_ERROR;
+        item->setError(entry->error != ERR_OK ? entry->error : (err_t)ERR_RT_INVALID_STATE);
+        _queue.append(item);
+      }
+    }
+  }
+
+  if (job->numThreads > 0)
+    ThreadPool::get()->releaseThreads(job->threads, job->numThreads);
+  job->release();
 }
 
 bool DomResourceManager::_loadResource(DomResourceItem* item)
+{
+  StringW path;
+  err_t err = _resolveResource(item, path);
+
+  if (FOG_IS_ERROR(err))
+    return false;
+
+  Var data;
+  err = DomResourceManager_decode(path, data, _resourceCache);
+
+  if (FOG_IS_ERROR(err))
+  {
+    item->setError(err);
+    return false;
+  }
+
+  item->setData(data);
+  return true;
+}
+
+err_t DomResourceManager::_resolveResource(DomResourceItem* item, StringW& path)
 {
   err_t err;
 
@@ -168,7 +595,7 @@ bool DomResourceManager::_loadResource(DomResourceItem* item)
       "Failed to extract resource extension.");
 
     item->setError(err);
-    return false;
+    return err;
   }
 
   // We use just lowercased extension for simplicity.
@@ -193,35 +620,14 @@ bool DomResourceManager::_loadResource(DomResourceItem* item)
         "Failed to join the resource root and the resource path.");
 
       item->setError(err);
-      return false;
-    }
-
-    Stream stream;
-    err = stream.openFile(fullPath, STREAM_OPEN_READ);
-
-    if (FOG_IS_ERROR(err))
-    {
-      Logger::error("Fog::DomResourceManager", "_loadResourceItem",
-        "Failed to open the resource stream.");
-
-      item->setError(err);
-      return false;
+      return err;
     }
 
-    Image image;
-    err = image.readFromStream(stream);
-
-    if (FOG_IS_ERROR(err))
-    {
-      Logger::error("Fog::DomResourceManager", "_loadResourceItem",
-        "Failed to load the image resource.");
+    // Normalize, so different names of the same file are decoded once.
+    if (FOG_IS_ERROR(FilePath::normalize(path, fullPath)))
+      path = fullPath;
 
-      item->setError(err);
-      return false;
-    }
-
-    item->setData(Var::fromImage(image));
-    return true;
+    return ERR_OK;
   }
 
   // --------------------------------------------------------------------------
@@ -232,7 +638,7 @@ bool DomResourceManager::_loadResource(DomResourceItem* item)
     "Failed to recognize the resource type.");
 
   item->setError(ERR_RT_INVALID_STATE);
-  return false;
+  return ERR_RT_INVALID_STATE;
 }
 
 // ============================================================================
@@ -274,7 +680,7 @@ void DomResourceItem::release()
 
 void DomResourceItem::reset()
 {
-  _resourceFlags &= ~(DOM_RESOURCE_FLAG_LOADED | DOM_RESOURCE_FLAG_ERROR);
+  _resourceFlags &= ~(DOM_RESOURCE_FLAG_LOADED | DOM_RESOURCE_FLAG_ERROR | DOM_RESOURCE_FLAG_PENDING);
   _error = ERR_OK;
 
   _name.reset();
@@ -287,4 +693,242 @@ void DomResourceItem::setData(const Var& data)
   _data = data;
 }
 
+// ============================================================================
+// [Fog::DomResourceCacheNode]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Cached resource, linked into the LRU list of @c DomResourceCache.
+struct FOG_NO_EXPORT DomResourceCacheNode
+{
+  FOG_INLINE DomResourceCacheNode(const StringW& path, const Var& data, size_t byteSize) :
+    path(path),
+    data(data),
+    byteSize(byteSize),
+    prev(NULL),
+    next(NULL)
+  {
+  }
+
+  //! @brief Resolved resource path.
+  StringW path;
+  //! @brief Decoded data.
+  Var data;
+  //! @brief Size of the decoded data in bytes.
+  size_t byteSize;
+
+  //! @brief Less recently used node.
+  DomResourceCacheNode* prev;
+  //! @brief More recently used node.
+  DomResourceCacheNode* next;
+};
+
+// ============================================================================
+// [Fog::DomResourceCache - Helpers]
+// ============================================================================
+
+static size_t DomResourceCache_getByteSize(const Var& data)
+{
+  Image image;
+  if (data.getImage(image) != ERR_OK)
+    return 0;
+
+  return (size_t)Math::abs(image.getStride()) * (size_t)image.getHeight();
+}
+
+static FOG_INLINE void DomResourceCache_link(DomResourceCache* self, DomResourceCacheNode* node)
+{
+  node->prev = self->_last;
+  node->next = NULL;
+
+  if (self->_last != NULL)
+    self->_last->next = node;
+  else
+    self->_first = node;
+
+  self->_last = node;
+}
+
+static FOG_INLINE void DomResourceCache_unlink(DomResourceCache* self, DomResourceCacheNode* node)
+{
+  if (node->prev != NULL)
+    node->prev->next = node->next;
+  else
+    self->_first = node->next;
+
+  if (node->next != NULL)
+    node->next->prev = node->prev;
+  else
+    self->_last = node->prev;
+
+  node->prev = NULL;
+  node->next = NULL;
+}
+
+static void DomResourceCache_destroy(DomResourceCache* self, DomResourceCacheNode* node)
+{
+  DomResourceCache_unlink(self, node);
+  self->_nodes.remove(node->path);
+  self->_byteUsage -= node->byteSize;
+
+  fog_delete(node);
+}
+
+// ============================================================================
+// [Fog::DomResourceCache - Construction / Destruction]
+// ============================================================================
+
+DomResourceCache::DomResourceCache(size_t byteBudget) :
+  _byteBudget(byteBudget),
+  _byteUsage(0),
+  _first(NULL),
+  _last(NULL)
+{
+}
+
+DomResourceCache::~DomResourceCache()
+{
+  clear();
+}
+
+// ============================================================================
+// [Fog::DomResourceCache - Accessors]
+// ============================================================================
+
+size_t DomResourceCache::getByteBudget() const
+{
+  AutoLock locked(_lock);
+  return _byteBudget;
+}
+
+void DomResourceCache::setByteBudget(size_t byteBudget)
+{
+  AutoLock locked(_lock);
+
+  _byteBudget = byteBudget;
+  _compact(byteBudget);
+}
+
+size_t DomResourceCache::getByteUsage() const
+{
+  AutoLock locked(_lock);
+  return _byteUsage;
+}
+
+// ============================================================================
+// [Fog::DomResourceCache - Cache]
+// ============================================================================
+
+bool DomResourceCache::get(const StringW& path, Var& dst)
+{
+  AutoLock locked(_lock);
+
+  DomResourceCacheNode* node = _nodes.get(path, NULL);
+  if (node == NULL)
+    return false;
+
+  dst = node->data;
+
+  // Move the node to the end of the LRU list.
+  if (node != _last)
+  {
+    DomResourceCache_unlink(this, node);
+    DomResourceCache_link(this, node);
+  }
+
+  return true;
+}
+
+err_t DomResourceCache::put(const StringW& path, const Var& data)
+{
+  size_t byteSize = DomResourceCache_getByteSize(data);
+  AutoLock locked(_lock);
+
+  // Don't thrash the cache by resources which don't fit into it.
+  if (byteSize > _byteBudget)
+    return ERR_OK;
+
+  DomResourceCacheNode* node = _nodes.get(path, NULL);
+  if (node != NULL)
+    DomResourceCache_destroy(this, node);
+
+  _compact(_byteBudget - byteSize);
+
+  node = fog_new DomResourceCacheNode(path, data, byteSize);
+  if (FOG_IS_NULL(node))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  err_t err = _nodes.put(path, node);
+  if (FOG_IS_ERROR(err))
+  {
+    fog_delete(node);
+    return err;
+  }
+
+  DomResourceCache_link(this, node);
+  _byteUsage += byteSize;
+
+  return ERR_OK;
+}
+
+void DomResourceCache::remove(const StringW& path)
+{
+  AutoLock locked(_lock);
+
+  DomResourceCacheNode* node = _nodes.get(path, NULL);
+  if (node != NULL)
+    DomResourceCache_destroy(this, node);
+}
+
+void DomResourceCache::clear()
+{
+  AutoLock locked(_lock);
+
+  DomResourceCacheNode* node = _first;
+  while (node != NULL)
+  {
+    DomResourceCacheNode* next = node->next;
+    fog_delete(node);
+    node = next;
+  }
+
+  _nodes.clear();
+  _first = NULL;
+  _last = NULL;
+  _byteUsage = 0;
+}
+
+void DomResourceCache::_compact(size_t budget)
+{
+  // Evict from the head of the LRU list, the least recently used first.
+  while (_byteUsage > budget && _first != NULL)
+    DomResourceCache_destroy(this, _first);
+}
+
+// ============================================================================
+// [Fog::DomResourceCache - Statics]
+// ============================================================================
+
+static Static<DomResourceCache> DomResourceCache_oGlobal;
+
+DomResourceCache* DomResourceCache::getGlobal()
+{
+  return DomResourceCache_oGlobal.p();
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void DomResourceCache_init(void)
+{
+  DomResourceCache_oGlobal.init();
+}
+
+FOG_NO_EXPORT void DomResourceCache_fini(void)
+{
+  DomResourceCache_oGlobal.destroy();
+}
+
 } // Fog namespace
@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/List.h>
 #include <Fog/Core/Tools/String.h>
@@ -16,6 +17,12 @@
 
 namespace Fog {
 
+// ============================================================================
+// [Forward Declarations]
+// ============================================================================
+
+struct DomResourceCacheNode;
+
 //! @addtogroup Fog_Core_Dom
 //! @{
 
@@ -85,6 +92,84 @@ private:
   FOG_NO_COPY(DomResourceItem)
 };
 
+// ============================================================================
+// [Fog::DomResourceCache]
+// ============================================================================
+
+//! @brief Cache of decoded resources shared by resource managers.
+//!
+//! The cache maps a resolved resource path to its decoded data and keeps the
+//! total size of cached images under the byte budget, evicting the least
+//! recently used resources first. The cache is thread-safe, it's accessed by
+//! the resource loader threads.
+struct FOG_API DomResourceCache
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DomResourceCache(size_t byteBudget = DOM_RESOURCE_CACHE_DEFAULT_BUDGET);
+  ~DomResourceCache();
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the byte budget.
+  size_t getByteBudget() const;
+  //! @brief Set the byte budget, evicting resources which don't fit.
+  void setByteBudget(size_t byteBudget);
+
+  //! @brief Get count of bytes used by the cached resources.
+  size_t getByteUsage() const;
+
+  // --------------------------------------------------------------------------
+  // [Cache]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the cached resource of @a path, returns false if not cached.
+  bool get(const StringW& path, Var& dst);
+  //! @brief Put the decoded resource of @a path into the cache.
+  err_t put(const StringW& path, const Var& data);
+  //! @brief Remove the resource of @a path from the cache.
+  void remove(const StringW& path);
+  //! @brief Remove all cached resources.
+  void clear();
+
+  //! @brief Evict resources until the byte usage is under @a budget, called
+  //! with @c _lock held.
+  void _compact(size_t budget);
+
+  // --------------------------------------------------------------------------
+  // [Statics]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the global resource cache.
+  static DomResourceCache* getGlobal();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Lock to protect members.
+  mutable Lock _lock;
+
+  //! @brief Byte budget.
+  size_t _byteBudget;
+  //! @brief Count of bytes used by the cached resources.
+  size_t _byteUsage;
+
+  //! @brief Cached resources (map resolved path to node).
+  Hash<StringW, DomResourceCacheNode*> _nodes;
+  //! @brief The least recently used node (head of the LRU list).
+  DomResourceCacheNode* _first;
+  //! @brief The most recently used node (tail of the LRU list).
+  DomResourceCacheNode* _last;
+
+private:
+  FOG_NO_COPY(DomResourceCache)
+};
+
 // ============================================================================
 // [Fog::DomResourceManager]
 // ============================================================================
@@ -105,6 +190,14 @@ struct FOG_API DomResourceManager
   FOG_INLINE const StringW& getResourceRoot() { return _resourceRoot; }
   FOG_INLINE void setResourceRoot(const StringW& s) { _resourceRoot = s; }
 
+  //! @brief Get the decoded resource cache (NULL if resources are not cached).
+  FOG_INLINE DomResourceCache* getResourceCache() const { return _resourceCache; }
+  //! @brief Set the decoded resource cache, see @ref DomResourceCache::getGlobal().
+  FOG_INLINE void setResourceCache(DomResourceCache* cache) { _resourceCache = cache; }
+
+  //! @brief Get whether queued resources are being loaded asynchronously.
+  FOG_INLINE bool isLoading() const { return _loadJob != NULL; }
+
   // --------------------------------------------------------------------------
   // [Management]
   // --------------------------------------------------------------------------
@@ -126,17 +219,43 @@ struct FOG_API DomResourceManager
   // --------------------------------------------------------------------------
 
   //! @brief Load all queued items.
+  //!
+  //! Resources are decoded in parallel by threads from the @ref ThreadPool,
+  //! the method returns when all resources are loaded. Returns true if the
+  //! queue is empty (no resource failed to load).
   bool loadQueuedResources();
 
+  //! @brief Start loading all queued items asynchronously.
+  //!
+  //! Resources are decoded by threads from the @ref ThreadPool and published
+  //! to the resource items by a task posted to the event loop of the calling
+  //! thread. If the calling thread has no event loop the resources are loaded
+  //! synchronously.
+  err_t loadQueuedResourcesAsync();
+
   //! @brief Load a single resource item, called internally.
   bool _loadResource(DomResourceItem* item);
 
+  //! @brief Resolve the path of resource @a item, called internally.
+  err_t _resolveResource(DomResourceItem* item, StringW& path);
+
+  //! @brief Start loading queued items, called internally.
+  err_t _startLoad(bool async);
+
+  //! @brief Publish the results of @a job to the resource items, called
+  //! internally.
+  void _finishLoad(DomResourceLoadJob* job);
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
 
   //! @brief Resource root, currently it's a file-path.
   StringW _resourceRoot;
+  //! @brief Decoded resource cache (can be NULL).
+  DomResourceCache* _resourceCache;
+  //! @brief Asynchronous load job in progress (can be NULL).
+  DomResourceLoadJob* _loadJob;
 
   //! @brief External resources (map resource name to resource item).
   Hash<StringW, DomResourceItem*> _externalResources;
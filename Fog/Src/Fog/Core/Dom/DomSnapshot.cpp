@@ -0,0 +1,575 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Dom/DomSnapshot_p.h>
+#include <Fog/Core/Kernel/Property.h>
+#include <Fog/Core/Memory/BSwap.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Tools/Stream.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::DomSnapshot - Helpers]
+// ============================================================================
+
+static FOG_INLINE size_t DomSnapshot_align(size_t size)
+{
+  return (size + 3) & ~(size_t)3;
+}
+
+// ============================================================================
+// [Fog::DomSnapshotWriter - Construction / Destruction]
+// ============================================================================
+
+DomSnapshotWriter::DomSnapshotWriter(const DomDocument* document) :
+  _document(document),
+  _defaults(document)
+{
+}
+
+DomSnapshotWriter::~DomSnapshotWriter()
+{
+}
+
+// ============================================================================
+// [Fog::DomSnapshotWriter - Write]
+// ============================================================================
+
+err_t DomSnapshotWriter::write(Stream& stream)
+{
+  DomSnapshotHeader header;
+  MemOps::zero(&header, sizeof(DomSnapshotHeader));
+
+  header.magic = DOM_SNAPSHOT_MAGIC;
+  header.version = DOM_SNAPSHOT_VERSION;
+  header.byteOrder = DOM_SNAPSHOT_BYTE_ORDER;
+  header.headerSize = sizeof(DomSnapshotHeader);
+
+  FOG_RETURN_ON_ERROR(_addString(_document->getXmlVersion(), header.xmlVersion));
+  FOG_RETURN_ON_ERROR(_addString(_document->getXmlEncoding(), header.xmlEncoding));
+  header.xmlStandalone = _document->getXmlStandalone();
+
+  FOG_RETURN_ON_ERROR(_writeNodes());
+
+  StringA tables;
+  FOG_RETURN_ON_ERROR(_writeTable(tables, _names));
+  FOG_RETURN_ON_ERROR(_writeTable(tables, _strings));
+
+  if (tables.getLength() > UINT32_MAX || _nodes.getLength() > UINT32_MAX)
+    return ERR_RT_OVERFLOW;
+
+  header.nameCount = static_cast<uint32_t>(_names.getLength());
+  header.stringCount = static_cast<uint32_t>(_strings.getLength());
+  header.tableSize = static_cast<uint32_t>(tables.getLength());
+  header.nodeSize = static_cast<uint32_t>(_nodes.getLength());
+
+  if (stream.write(&header, sizeof(DomSnapshotHeader)) != sizeof(DomSnapshotHeader) ||
+      stream.write(tables) != tables.getLength() ||
+      stream.write(_nodes) != _nodes.getLength())
+  {
+    return ERR_IO_CANT_WRITE;
+  }
+
+  return ERR_OK;
+}
+
+err_t DomSnapshotWriter::_writeNodes()
+{
+  const DomNode* node = _document->getFirstChild();
+  uint32_t index;
+
+  while (node != NULL)
+  {
+    switch (node->getNodeType())
+    {
+      case DOM_NODE_TYPE_ELEMENT:
+      {
+        const DomElement* element = static_cast<const DomElement*>(node);
+        FOG_RETURN_ON_ERROR(_writeElement(element));
+
+        if (element->getFirstChild() != NULL)
+        {
+          node = element->getFirstChild();
+          continue;
+        }
+
+        FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_END));
+        break;
+      }
+
+      case DOM_NODE_TYPE_TEXT:
+        FOG_RETURN_ON_ERROR(_addString(static_cast<const DomText*>(node)->getData(), index));
+        FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_TEXT));
+        FOG_RETURN_ON_ERROR(_emit(index));
+        break;
+
+      case DOM_NODE_TYPE_CDATA_SECTION:
+        FOG_RETURN_ON_ERROR(_addString(static_cast<const DomCDATASection*>(node)->getData(), index));
+        FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_CDATA_SECTION));
+        FOG_RETURN_ON_ERROR(_emit(index));
+        break;
+
+      case DOM_NODE_TYPE_COMMENT:
+        FOG_RETURN_ON_ERROR(_addString(static_cast<const DomComment*>(node)->getData(), index));
+        FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_COMMENT));
+        FOG_RETURN_ON_ERROR(_emit(index));
+        break;
+
+      case DOM_NODE_TYPE_PROCESSING_INSTRUCTION:
+      {
+        const DomProcessingInstruction* pi = static_cast<const DomProcessingInstruction*>(node);
+        FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_PROCESSING_INSTRUCTION));
+        FOG_RETURN_ON_ERROR(_addName(pi->getTarget(), index));
+        FOG_RETURN_ON_ERROR(_emit(index));
+        FOG_RETURN_ON_ERROR(_addString(pi->getData(), index));
+        FOG_RETURN_ON_ERROR(_emit(index));
+        break;
+      }
+
+      // Nodes not created by the XML reader are not stored.
+      default:
+        break;
+    }
+
+    // Leave all containers which have no more children.
+    while (node->getNextSibling() == NULL)
+    {
+      node = node->_parentNode;
+      if (node == _document)
+        return ERR_OK;
+
+      FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_END));
+    }
+
+    node = node->getNextSibling();
+  }
+
+  return ERR_OK;
+}
+
+err_t DomSnapshotWriter::_writeElement(const DomElement* element)
+{
+  uint32_t index;
+  FOG_RETURN_ON_ERROR(_addName(element->getTagName(), index));
+
+  const List<StringW>* defaults = _defaults.get(element->getTagName());
+  if (FOG_IS_NULL(defaults))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_NODE_ELEMENT));
+  FOG_RETURN_ON_ERROR(_emit(index));
+
+  // Count of attributes is patched when they are written.
+  size_t countPosition = _nodes.getLength();
+  FOG_RETURN_ON_ERROR(_emit(0));
+
+  size_t objectCount = element->_objectPropertyCount;
+  size_t count = objectCount + element->_getDynamicPropertyCount();
+  uint32_t written = 0;
+
+  PropertyInfo info;
+  StringW value;
+  StringA data;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    uint32_t type;
+
+    // Overlapping properties are stored through the properties they overlap.
+    if (element->_getPropertyInfo(i, info) != ERR_OK || (info.getFlags() & PROPERTY_FLAG_OVERLAPS) != 0)
+      continue;
+
+    if (_document->_encodeSnapshotValue(element, i, type, data))
+    {
+      if (data.getLength() > UINT32_MAX)
+        return ERR_RT_OVERFLOW;
+
+      FOG_RETURN_ON_ERROR(_addName(info.getName(), index));
+      FOG_RETURN_ON_ERROR(_emit(index));
+      FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_VALUE_BINARY));
+      FOG_RETURN_ON_ERROR(_emit(type));
+      FOG_RETURN_ON_ERROR(_emit(static_cast<uint32_t>(data.getLength())));
+      FOG_RETURN_ON_ERROR(_emitData(data.getData(), data.getLength()));
+    }
+    else
+    {
+      // Some properties are serialized by appending to the value.
+      value.clear();
+      if (element->getProperty(i, value) != ERR_OK)
+        continue;
+
+      // Properties which weren't changed are not stored.
+      if (i < objectCount && _defaults.isDefault(defaults, i, value))
+        continue;
+
+      FOG_RETURN_ON_ERROR(_addName(info.getName(), index));
+      FOG_RETURN_ON_ERROR(_emit(index));
+      FOG_RETURN_ON_ERROR(_emit(DOM_SNAPSHOT_VALUE_STRING));
+      FOG_RETURN_ON_ERROR(_addString(value, index));
+      FOG_RETURN_ON_ERROR(_emit(index));
+    }
+
+    written++;
+  }
+
+  reinterpret_cast<uint32_t*>(_nodes.getDataX() + countPosition)[0] = written;
+  return ERR_OK;
+}
+
+err_t DomSnapshotWriter::_addName(const StringW& name, uint32_t& index)
+{
+  const uint32_t* p = _nameHash.getPtr(name);
+  if (p != NULL)
+  {
+    index = *p;
+    return ERR_OK;
+  }
+
+  if (_names.getLength() >= UINT32_MAX)
+    return ERR_RT_OVERFLOW;
+
+  index = static_cast<uint32_t>(_names.getLength());
+  FOG_RETURN_ON_ERROR(_names.append(name));
+  return _nameHash.put(name, index);
+}
+
+err_t DomSnapshotWriter::_addString(const StringW& str, uint32_t& index)
+{
+  const uint32_t* p = _stringHash.getPtr(str);
+  if (p != NULL)
+  {
+    index = *p;
+    return ERR_OK;
+  }
+
+  if (_strings.getLength() >= UINT32_MAX)
+    return ERR_RT_OVERFLOW;
+
+  index = static_cast<uint32_t>(_strings.getLength());
+  FOG_RETURN_ON_ERROR(_strings.append(str));
+  return _stringHash.put(str, index);
+}
+
+err_t DomSnapshotWriter::_emit(uint32_t value)
+{
+  char* p = _nodes._add(sizeof(uint32_t));
+  if (FOG_IS_NULL(p))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  reinterpret_cast<uint32_t*>(p)[0] = value;
+  return ERR_OK;
+}
+
+err_t DomSnapshotWriter::_emitData(const void* data, size_t size)
+{
+  size_t aligned = DomSnapshot_align(size);
+
+  char* p = _nodes._add(aligned);
+  if (FOG_IS_NULL(p))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  MemOps::copy(p, data, size);
+  MemOps::zero(p + size, aligned - size);
+  return ERR_OK;
+}
+
+err_t DomSnapshotWriter::_writeTable(StringA& dst, const List<StringW>& table)
+{
+  size_t count = table.getLength();
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const StringW& str = table.getAt(i);
+    size_t length = str.getLength();
+
+    if (length > UINT32_MAX)
+      return ERR_RT_OVERFLOW;
+
+    size_t size = length * sizeof(CharW);
+    size_t aligned = DomSnapshot_align(size);
+
+    char* p = dst._add(sizeof(uint32_t) + aligned);
+    if (FOG_IS_NULL(p))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    reinterpret_cast<uint32_t*>(p)[0] = static_cast<uint32_t>(length);
+    p += sizeof(uint32_t);
+
+    MemOps::copy(p, str.getData(), size);
+    MemOps::zero(p + size, aligned - size);
+  }
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::DomSnapshotReader - Construction / Destruction]
+// ============================================================================
+
+DomSnapshotReader::DomSnapshotReader(DomDocument* document) :
+  _document(document)
+{
+}
+
+DomSnapshotReader::~DomSnapshotReader()
+{
+}
+
+// ============================================================================
+// [Fog::DomSnapshotReader - Read]
+// ============================================================================
+
+err_t DomSnapshotReader::read(const void* mem, size_t size)
+{
+  if (size < sizeof(DomSnapshotHeader))
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+  // Records are read as 32-bit words, unaligned data are copied first.
+  StringA aligned;
+  if (((size_t)mem & 3) != 0)
+  {
+    FOG_RETURN_ON_ERROR(aligned.set(reinterpret_cast<const char*>(mem), size));
+    mem = aligned.getData();
+  }
+
+  const DomSnapshotHeader* header = reinterpret_cast<const DomSnapshotHeader*>(mem);
+
+  if (header->magic != DOM_SNAPSHOT_MAGIC)
+  {
+    // Written on a machine with different byte-order?
+    if (header->magic == MemOps::bswap32(static_cast<uint32_t>(DOM_SNAPSHOT_MAGIC)))
+      return ERR_DOM_SNAPSHOT_INCOMPATIBLE;
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+  }
+
+  if (header->version != DOM_SNAPSHOT_VERSION || header->byteOrder != DOM_SNAPSHOT_BYTE_ORDER)
+    return ERR_DOM_SNAPSHOT_INCOMPATIBLE;
+
+  if (header->headerSize != sizeof(DomSnapshotHeader) ||
+      (header->tableSize & 3) != 0 ||
+      (header->nodeSize & 3) != 0 ||
+      (uint64_t)header->tableSize + header->nodeSize > size - sizeof(DomSnapshotHeader))
+  {
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+  }
+
+  if (_document->getDocumentElement() != NULL)
+    return ERR_RT_INVALID_STATE;
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(mem) + sizeof(DomSnapshotHeader);
+  FOG_RETURN_ON_ERROR(_readTables(data, header->tableSize, header));
+
+  if (header->xmlVersion >= _strings.getLength() || header->xmlEncoding >= _strings.getLength())
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+  FOG_RETURN_ON_ERROR(_document->setXmlVersion(_strings.getAt(header->xmlVersion)));
+  FOG_RETURN_ON_ERROR(_document->setXmlEncoding(_strings.getAt(header->xmlEncoding)));
+  FOG_RETURN_ON_ERROR(_document->setXmlStandalone(header->xmlStandalone != 0));
+
+  return _readNodes(reinterpret_cast<const uint32_t*>(data + header->tableSize), header->nodeSize / 4);
+}
+
+err_t DomSnapshotReader::_readTables(const uint8_t* data, size_t size, const DomSnapshotHeader* header)
+{
+  const uint8_t* end = data + size;
+
+  FOG_RETURN_ON_ERROR(_names.reserve(header->nameCount));
+  FOG_RETURN_ON_ERROR(_strings.reserve(header->stringCount));
+
+  size_t total = (size_t)header->nameCount + header->stringCount;
+  for (size_t i = 0; i < total; i++)
+  {
+    if ((size_t)(end - data) < sizeof(uint32_t))
+      return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+    size_t length = reinterpret_cast<const uint32_t*>(data)[0];
+    data += sizeof(uint32_t);
+
+    size_t aligned = DomSnapshot_align(length * sizeof(CharW));
+    if (length > size || (size_t)(end - data) < aligned)
+      return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+    const CharW* str = reinterpret_cast<const CharW*>(data);
+    data += aligned;
+
+    if (i < header->nameCount)
+      FOG_RETURN_ON_ERROR(_names.append(InternedStringW(StubW(str, length))));
+    else
+      FOG_RETURN_ON_ERROR(_strings.append(StringW(str, length)));
+  }
+
+  return ERR_OK;
+}
+
+err_t DomSnapshotReader::_readNodes(const uint32_t* data, size_t length)
+{
+  const uint32_t* end = data + length;
+
+  size_t nameCount = _names.getLength();
+  size_t stringCount = _strings.getLength();
+
+  DomContainer* container = _document;
+
+#define DOM_SNAPSHOT_NEED(_N_) \
+  FOG_MACRO_BEGIN \
+    if ((size_t)(end - data) < (size_t)(_N_)) \
+      return ERR_DOM_SNAPSHOT_INVALID_FORMAT; \
+  FOG_MACRO_END
+
+#define DOM_SNAPSHOT_NAME(_Index_) \
+  FOG_MACRO_BEGIN \
+    if ((_Index_) >= nameCount) \
+      return ERR_DOM_SNAPSHOT_INVALID_FORMAT; \
+  FOG_MACRO_END
+
+#define DOM_SNAPSHOT_STRING(_Index_) \
+  FOG_MACRO_BEGIN \
+    if ((_Index_) >= stringCount) \
+      return ERR_DOM_SNAPSHOT_INVALID_FORMAT; \
+  FOG_MACRO_END
+
+  while (data != end)
+  {
+    uint32_t record = *data++;
+    DomNode* node;
+
+    switch (record)
+    {
+      case DOM_SNAPSHOT_NODE_END:
+      {
+        if (container == _document)
+          return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+        container = container->_parentNode;
+        continue;
+      }
+
+      case DOM_SNAPSHOT_NODE_ELEMENT:
+      {
+        DOM_SNAPSHOT_NEED(2);
+
+        uint32_t tagName = data[0];
+        uint32_t count = data[1];
+        data += 2;
+
+        DOM_SNAPSHOT_NAME(tagName);
+
+        if (container == _document && _document->getDocumentElement() != NULL)
+          return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+        DomElement* element = _document->createElement(_names.getAt(tagName));
+        if (FOG_IS_NULL(element))
+          return ERR_RT_OUT_OF_MEMORY;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+          DOM_SNAPSHOT_NEED(3);
+
+          uint32_t name = data[0];
+          uint32_t type = data[1];
+          DOM_SNAPSHOT_NAME(name);
+
+          if (type == DOM_SNAPSHOT_VALUE_STRING)
+          {
+            uint32_t value = data[2];
+            data += 3;
+
+            DOM_SNAPSHOT_STRING(value);
+
+            // Like the XML reader, an invalid value doesn't stop reading.
+            err_t err = element->setAttribute(_names.getAt(name), _strings.getAt(value));
+            if (err == ERR_RT_OUT_OF_MEMORY)
+              return err;
+          }
+          else if (type == DOM_SNAPSHOT_VALUE_BINARY)
+          {
+            DOM_SNAPSHOT_NEED(4);
+
+            uint32_t binaryType = data[2];
+            uint32_t size = data[3];
+            data += 4;
+
+            size_t aligned = DomSnapshot_align(size);
+            DOM_SNAPSHOT_NEED(aligned / 4);
+
+            FOG_RETURN_ON_ERROR(_document->_decodeSnapshotValue(
+              element, _names.getAt(name), binaryType, data, size));
+            data += aligned / 4;
+          }
+          else
+          {
+            return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+          }
+        }
+
+        FOG_RETURN_ON_ERROR(container->appendChild(element));
+        container = element;
+        continue;
+      }
+
+      case DOM_SNAPSHOT_NODE_TEXT:
+      case DOM_SNAPSHOT_NODE_CDATA_SECTION:
+      case DOM_SNAPSHOT_NODE_COMMENT:
+      {
+        DOM_SNAPSHOT_NEED(1);
+
+        uint32_t value = *data++;
+        DOM_SNAPSHOT_STRING(value);
+
+        const StringW& str = _strings.getAt(value);
+
+        if (record == DOM_SNAPSHOT_NODE_TEXT)
+          node = _document->createTextNode(str);
+        else if (record == DOM_SNAPSHOT_NODE_CDATA_SECTION)
+          node = _document->createCDATASection(str);
+        else
+          node = _document->createComment(str);
+        break;
+      }
+
+      case DOM_SNAPSHOT_NODE_PROCESSING_INSTRUCTION:
+      {
+        DOM_SNAPSHOT_NEED(2);
+
+        uint32_t target = data[0];
+        uint32_t value = data[1];
+        data += 2;
+
+        DOM_SNAPSHOT_NAME(target);
+        DOM_SNAPSHOT_STRING(value);
+
+        node = _document->createProcessingInstruction(_names.getAt(target), _strings.getAt(value));
+        break;
+      }
+
+      default:
+        return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+    }
+
+    if (FOG_IS_NULL(node))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    FOG_RETURN_ON_ERROR(container->appendChild(node));
+  }
+
+#undef DOM_SNAPSHOT_STRING
+#undef DOM_SNAPSHOT_NAME
+#undef DOM_SNAPSHOT_NEED
+
+  if (container != _document)
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+  return ERR_OK;
+}
+
+} // Fog namespace
@@ -0,0 +1,176 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_DOM_DOMSNAPSHOT_P_H
+#define _FOG_CORE_DOM_DOMSNAPSHOT_P_H
+
+// [Dependencies]
+#include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Dom/DomWriter_p.h>
+#include <Fog/Core/Tools/Hash.h>
+#include <Fog/Core/Tools/InternedString.h>
+#include <Fog/Core/Tools/List.h>
+#include <Fog/Core/Tools/String.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_Core_Dom
+//! @{
+
+// ============================================================================
+// [Fog::DomSnapshotHeader]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Header of DOM snapshot.
+//!
+//! The header is followed by the name table, the string table and the node
+//! stream. Everything is stored in native byte-order and aligned to 4 bytes:
+//!
+//!   - Table entry is the length of the string followed by its characters
+//!     (UTF-16), padded to 4 bytes.
+//!   - Node stream is a sequence of @ref DOM_SNAPSHOT_NODE records in
+//!     document order, each element is closed by @c DOM_SNAPSHOT_NODE_END.
+//!     Element record contains index of its tag name, count of attributes and
+//!     attributes (name index, @ref DOM_SNAPSHOT_VALUE type and either string
+//!     index or binary type, size and data padded to 4 bytes).
+struct FOG_NO_EXPORT DomSnapshotHeader
+{
+  //! @brief Signature, @c DOM_SNAPSHOT_MAGIC.
+  uint32_t magic;
+  //! @brief Version, @c DOM_SNAPSHOT_VERSION.
+  uint32_t version;
+  //! @brief Byte-order mark, @c DOM_SNAPSHOT_BYTE_ORDER.
+  uint32_t byteOrder;
+  //! @brief Size of the header.
+  uint32_t headerSize;
+
+  //! @brief Count of names (interned when the snapshot is read).
+  uint32_t nameCount;
+  //! @brief Count of strings.
+  uint32_t stringCount;
+  //! @brief Size of the name and string tables (in bytes).
+  uint32_t tableSize;
+  //! @brief Size of the node stream (in bytes).
+  uint32_t nodeSize;
+
+  //! @brief XML version (string index).
+  uint32_t xmlVersion;
+  //! @brief XML encoding (string index).
+  uint32_t xmlEncoding;
+  //! @brief XML standalone.
+  uint32_t xmlStandalone;
+  //! @brief Reserved, must be zero.
+  uint32_t reserved;
+};
+
+// ============================================================================
+// [Fog::DomSnapshotWriter]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief DOM snapshot writer.
+struct FOG_NO_EXPORT DomSnapshotWriter
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DomSnapshotWriter(const DomDocument* document);
+  ~DomSnapshotWriter();
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  err_t write(Stream& stream);
+
+  err_t _writeNodes();
+  err_t _writeElement(const DomElement* element);
+
+  err_t _addName(const StringW& name, uint32_t& index);
+  err_t _addString(const StringW& str, uint32_t& index);
+
+  err_t _emit(uint32_t value);
+  err_t _emitData(const void* data, size_t size);
+
+  static err_t _writeTable(StringA& dst, const List<StringW>& table);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Document being written.
+  const DomDocument* _document;
+  //! @brief Default properties of elements.
+  DomPropertyDefaults _defaults;
+
+  //! @brief Names.
+  List<StringW> _names;
+  //! @brief Name to index.
+  Hash<StringW, uint32_t> _nameHash;
+
+  //! @brief Strings.
+  List<StringW> _strings;
+  //! @brief String to index.
+  Hash<StringW, uint32_t> _stringHash;
+
+  //! @brief Node stream.
+  StringA _nodes;
+
+private:
+  FOG_NO_COPY(DomSnapshotWriter)
+};
+
+// ============================================================================
+// [Fog::DomSnapshotReader]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief DOM snapshot reader.
+struct FOG_NO_EXPORT DomSnapshotReader
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DomSnapshotReader(DomDocument* document);
+  ~DomSnapshotReader();
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  err_t read(const void* mem, size_t size);
+
+  err_t _readTables(const uint8_t* data, size_t size, const DomSnapshotHeader* header);
+  err_t _readNodes(const uint32_t* data, size_t length);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Document being read.
+  DomDocument* _document;
+
+  //! @brief Names.
+  List<InternedStringW> _names;
+  //! @brief Strings.
+  List<StringW> _strings;
+
+private:
+  FOG_NO_COPY(DomSnapshotReader)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_DOM_DOMSNAPSHOT_P_H
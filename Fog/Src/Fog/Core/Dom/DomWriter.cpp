@@ -0,0 +1,412 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Dom/DomWriter_p.h>
+#include <Fog/Core/Kernel/Property.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Tools/Char.h>
+#include <Fog/Core/Tools/Stream.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::DomPropertyDefaults - Construction / Destruction]
+// ============================================================================
+
+DomPropertyDefaults::DomPropertyDefaults(const DomDocument* document) :
+  _document(document),
+  _scratch(NULL)
+{
+}
+
+DomPropertyDefaults::~DomPropertyDefaults()
+{
+  if (_scratch != NULL)
+    fog_delete(_scratch);
+}
+
+// ============================================================================
+// [Fog::DomPropertyDefaults - Methods]
+// ============================================================================
+
+const List<StringW>* DomPropertyDefaults::get(const InternedStringW& tagName)
+{
+  const List<StringW>* defaults = _defaults.getPtr(tagName);
+  if (defaults != NULL)
+    return defaults;
+
+  if (_scratch == NULL)
+  {
+    _scratch = const_cast<DomDocument*>(_document)->_createDocument();
+    if (FOG_IS_NULL(_scratch))
+      return NULL;
+  }
+
+  List<StringW> list;
+  DomElement* element = _scratch->createElement(tagName);
+
+  if (FOG_IS_NULL(element))
+    return NULL;
+
+  size_t count = element->_objectPropertyCount;
+  StringW value;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    value.clear();
+    element->getProperty(i, value);
+
+    if (list.append(value) != ERR_OK)
+      return NULL;
+  }
+
+  if (_defaults.put(tagName, list) != ERR_OK)
+    return NULL;
+
+  return _defaults.getPtr(tagName);
+}
+
+// ============================================================================
+// [Fog::DomXmlWriter - Construction / Destruction]
+// ============================================================================
+
+DomXmlWriter::DomXmlWriter(const DomDocument* document, Stream& stream) :
+  _document(document),
+  _stream(&stream),
+  _defaults(document),
+  _bufferStart(NULL),
+  _bufferPtr(NULL),
+  _bufferEnd(NULL)
+{
+}
+
+DomXmlWriter::~DomXmlWriter()
+{
+}
+
+// ============================================================================
+// [Fog::DomXmlWriter - Write]
+// ============================================================================
+
+err_t DomXmlWriter::write()
+{
+  _bufferStart = _buffer._add(DOM_XML_BUFFER_SIZE);
+  if (FOG_IS_NULL(_bufferStart))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  _bufferPtr = _bufferStart;
+  _bufferEnd = _bufferStart + DOM_XML_BUFFER_SIZE;
+
+  FOG_RETURN_ON_ERROR(_writeDeclaration());
+  FOG_RETURN_ON_ERROR(_writeNodes());
+
+  return _flush();
+}
+
+err_t DomXmlWriter::_writeDeclaration()
+{
+  const StringW& version = _document->getXmlVersion();
+
+  FOG_RETURN_ON_ERROR(_writeAscii("<?xml version=\""));
+  if (version.isEmpty())
+    FOG_RETURN_ON_ERROR(_writeAscii("1.0"));
+  else
+    FOG_RETURN_ON_ERROR(_writeString(version, DOM_XML_ESCAPE_ATTRIBUTE));
+
+  // The document is always written in UTF-8, the original encoding is lost.
+  FOG_RETURN_ON_ERROR(_writeAscii("\" encoding=\"UTF-8\""));
+  if (_document->getXmlStandalone())
+    FOG_RETURN_ON_ERROR(_writeAscii(" standalone=\"yes\""));
+
+  return _writeAscii("?>\n");
+}
+
+err_t DomXmlWriter::_writeNodes()
+{
+  const DomNode* node = _document->getFirstChild();
+
+  while (node != NULL)
+  {
+    switch (node->getNodeType())
+    {
+      case DOM_NODE_TYPE_ELEMENT:
+      {
+        const DomElement* element = static_cast<const DomElement*>(node);
+        const DomNode* child = element->getFirstChild();
+
+        FOG_RETURN_ON_ERROR(_writeStartTag(element, child == NULL));
+
+        if (child != NULL)
+        {
+          node = child;
+          continue;
+        }
+        break;
+      }
+
+      case DOM_NODE_TYPE_TEXT:
+        FOG_RETURN_ON_ERROR(_writeString(static_cast<const DomText*>(node)->getData(), DOM_XML_ESCAPE_TEXT));
+        break;
+
+      case DOM_NODE_TYPE_CDATA_SECTION:
+        FOG_RETURN_ON_ERROR(_writeAscii("<![CDATA["));
+        FOG_RETURN_ON_ERROR(_writeString(static_cast<const DomCDATASection*>(node)->getData(), DOM_XML_ESCAPE_NONE));
+        FOG_RETURN_ON_ERROR(_writeAscii("]]>"));
+        break;
+
+      case DOM_NODE_TYPE_COMMENT:
+        FOG_RETURN_ON_ERROR(_writeAscii("<!--"));
+        FOG_RETURN_ON_ERROR(_writeString(static_cast<const DomComment*>(node)->getData(), DOM_XML_ESCAPE_NONE));
+        FOG_RETURN_ON_ERROR(_writeAscii("-->"));
+        break;
+
+      case DOM_NODE_TYPE_PROCESSING_INSTRUCTION:
+      {
+        const DomProcessingInstruction* pi = static_cast<const DomProcessingInstruction*>(node);
+
+        FOG_RETURN_ON_ERROR(_writeAscii("<?"));
+        FOG_RETURN_ON_ERROR(_writeString(pi->getTarget(), DOM_XML_ESCAPE_NONE));
+        FOG_RETURN_ON_ERROR(_writeAscii(" "));
+        FOG_RETURN_ON_ERROR(_writeString(pi->getData(), DOM_XML_ESCAPE_NONE));
+        FOG_RETURN_ON_ERROR(_writeAscii("?>"));
+        break;
+      }
+
+      // Nodes not created by the XML reader are not written.
+      default:
+        break;
+    }
+
+    // Leave all containers which have no more children.
+    while (node->getNextSibling() == NULL)
+    {
+      node = node->_parentNode;
+      if (node == _document)
+        return ERR_OK;
+
+      FOG_RETURN_ON_ERROR(_writeEndTag(static_cast<const DomElement*>(node)));
+    }
+
+    node = node->getNextSibling();
+  }
+
+  return ERR_OK;
+}
+
+err_t DomXmlWriter::_writeStartTag(const DomElement* element, bool empty)
+{
+  const List<StringW>* defaults = _defaults.get(element->getTagName());
+  if (FOG_IS_NULL(defaults))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  FOG_RETURN_ON_ERROR(_writeAscii("<"));
+  FOG_RETURN_ON_ERROR(_writeString(element->getTagName(), DOM_XML_ESCAPE_NONE));
+
+  size_t objectCount = element->_objectPropertyCount;
+  size_t count = objectCount + element->_getDynamicPropertyCount();
+
+  PropertyInfo info;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    // Overlapping properties are written through the properties they overlap.
+    if (element->_getPropertyInfo(i, info) != ERR_OK || (info.getFlags() & PROPERTY_FLAG_OVERLAPS) != 0)
+      continue;
+
+    if (_document->_serializeValue(element, i, _data))
+    {
+      FOG_RETURN_ON_ERROR(_writeAscii(" "));
+      FOG_RETURN_ON_ERROR(_writeString(info.getName(), DOM_XML_ESCAPE_NONE));
+      FOG_RETURN_ON_ERROR(_writeAscii("=\""));
+      FOG_RETURN_ON_ERROR(_writeAscii(_data.getData(), _data.getLength()));
+      FOG_RETURN_ON_ERROR(_writeAscii("\""));
+    }
+    else
+    {
+      // Some properties are serialized by appending to the value.
+      _value.clear();
+      if (element->getProperty(i, _value) != ERR_OK)
+        continue;
+
+      // Properties which weren't changed are not written.
+      if (i < objectCount && _defaults.isDefault(defaults, i, _value))
+        continue;
+
+      FOG_RETURN_ON_ERROR(_writeAscii(" "));
+      FOG_RETURN_ON_ERROR(_writeString(info.getName(), DOM_XML_ESCAPE_NONE));
+      FOG_RETURN_ON_ERROR(_writeAscii("=\""));
+      FOG_RETURN_ON_ERROR(_writeString(_value, DOM_XML_ESCAPE_ATTRIBUTE));
+      FOG_RETURN_ON_ERROR(_writeAscii("\""));
+    }
+  }
+
+  if (empty)
+    return _writeAscii("/>");
+  else
+    return _writeAscii(">");
+}
+
+err_t DomXmlWriter::_writeEndTag(const DomElement* element)
+{
+  FOG_RETURN_ON_ERROR(_writeAscii("</"));
+  FOG_RETURN_ON_ERROR(_writeString(element->getTagName(), DOM_XML_ESCAPE_NONE));
+  return _writeAscii(">");
+}
+
+// ============================================================================
+// [Fog::DomXmlWriter - Buffer]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get whether the characters following '&' form an entity or character
+//! reference ("amp;", "#38;", "#x26;").
+static bool DomXmlWriter_isReference(const CharW* p, const CharW* end)
+{
+  size_t length = Math::min<size_t>((size_t)(end - p), 32);
+
+  for (size_t i = 0; i < length; i++)
+  {
+    CharW c = p[i];
+
+    if (c == CharW(';'))
+      return i != 0;
+
+    if (!c.isAsciiLetter() && !c.isAsciiDigit() && !(i == 0 && c == CharW('#')))
+      return false;
+  }
+
+  return false;
+}
+
+err_t DomXmlWriter::_writeString(const StringW& s, uint32_t escape)
+{
+  const CharW* sPtr = s.getData();
+  const CharW* sEnd = sPtr + s.getLength();
+
+  while (sPtr != sEnd)
+  {
+    // Each character produces at most 6 bytes ("&quot;"), surrogate pair 4.
+    size_t length = Math::min<size_t>((size_t)(sEnd - sPtr), (size_t)(_bufferEnd - _bufferPtr) / 6);
+
+    if (length == 0)
+    {
+      FOG_RETURN_ON_ERROR(_flush());
+      continue;
+    }
+
+    const CharW* sMark = sPtr + length;
+    char* p = _bufferPtr;
+
+    do {
+      uint32_t c = sPtr->getValue();
+      sPtr++;
+
+      if (c < 0x80)
+      {
+        if (escape != DOM_XML_ESCAPE_NONE)
+        {
+          const char* entity = NULL;
+
+          switch (c)
+          {
+            // Reader doesn't expand references, they are kept as read.
+            case '&': if (!DomXmlWriter_isReference(sPtr, sEnd)) entity = "&amp;"; break;
+            case '<': entity = "&lt;"; break;
+            case '"': if (escape == DOM_XML_ESCAPE_ATTRIBUTE) entity = "&quot;"; break;
+          }
+
+          if (entity != NULL)
+          {
+            while (*entity)
+              *p++ = *entity++;
+            continue;
+          }
+        }
+
+        *p++ = static_cast<char>(c);
+      }
+      else if (c < 0x800)
+      {
+        p[0] = static_cast<char>(0xC0 | (c >> 6));
+        p[1] = static_cast<char>(0x80 | (c & 0x3F));
+        p += 2;
+      }
+      else
+      {
+        if (CharW::isSurrogate(c))
+        {
+          // Unpaired surrogate is replaced by U+FFFD.
+          if (CharW::isHiSurrogate(c) && sPtr != sEnd && sPtr->isLoSurrogate())
+          {
+            c = CharW::ucs4FromSurrogate(c, static_cast<uint32_t>(sPtr->getValue()));
+            sPtr++;
+
+            p[0] = static_cast<char>(0xF0 | (c >> 18));
+            p[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            p[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            p[3] = static_cast<char>(0x80 | (c & 0x3F));
+            p += 4;
+            continue;
+          }
+
+          c = 0xFFFD;
+        }
+
+        p[0] = static_cast<char>(0xE0 | (c >> 12));
+        p[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        p[2] = static_cast<char>(0x80 | (c & 0x3F));
+        p += 3;
+      }
+    } while (sPtr < sMark);
+
+    _bufferPtr = p;
+  }
+
+  return ERR_OK;
+}
+
+err_t DomXmlWriter::_writeAscii(const char* s, size_t length)
+{
+  while (length != 0)
+  {
+    size_t n = Math::min<size_t>(length, (size_t)(_bufferEnd - _bufferPtr));
+
+    if (n == 0)
+    {
+      FOG_RETURN_ON_ERROR(_flush());
+      continue;
+    }
+
+    MemOps::copy(_bufferPtr, s, n);
+    _bufferPtr += n;
+
+    s += n;
+    length -= n;
+  }
+
+  return ERR_OK;
+}
+
+err_t DomXmlWriter::_flush()
+{
+  size_t length = (size_t)(_bufferPtr - _bufferStart);
+  _bufferPtr = _bufferStart;
+
+  if (length != 0 && _stream->write(_bufferStart, length) != length)
+    return ERR_IO_CANT_WRITE;
+
+  return ERR_OK;
+}
+
+} // Fog namespace
@@ -0,0 +1,175 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_DOM_DOMWRITER_P_H
+#define _FOG_CORE_DOM_DOMWRITER_P_H
+
+// [Dependencies]
+#include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Tools/Hash.h>
+#include <Fog/Core/Tools/InternedString.h>
+#include <Fog/Core/Tools/List.h>
+#include <Fog/Core/Tools/String.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_Core_Dom
+//! @{
+
+// ============================================================================
+// [Fog::DOM_XML_ESCAPE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Characters escaped by @ref DomXmlWriter.
+enum DOM_XML_ESCAPE
+{
+  //! @brief Nothing is escaped (comments, CDATA and processing instructions).
+  DOM_XML_ESCAPE_NONE = 0,
+  //! @brief Text, escape "<" and "&" which doesn't start a reference (the
+  //! reader keeps references as they were read).
+  DOM_XML_ESCAPE_TEXT = 1,
+  //! @brief Attribute value, escape also quote.
+  DOM_XML_ESCAPE_ATTRIBUTE = 2
+};
+
+// ============================================================================
+// [Fog::DOM_XML_MISC]
+// ============================================================================
+
+//! @internal
+enum DOM_XML_MISC
+{
+  //! @brief Size of buffer used by @ref DomXmlWriter.
+  DOM_XML_BUFFER_SIZE = 65536
+};
+
+// ============================================================================
+// [Fog::DomPropertyDefaults]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Serialized properties of newly created elements, used by writers to
+//! omit properties which weren't changed.
+struct FOG_NO_EXPORT DomPropertyDefaults
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DomPropertyDefaults(const DomDocument* document);
+  ~DomPropertyDefaults();
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get serialized properties of a new element named @a tagName.
+  const List<StringW>* get(const InternedStringW& tagName);
+
+  //! @brief Get whether the object property @a index is equal to its value
+  //! in @a defaults (returned by @ref get()).
+  FOG_INLINE bool isDefault(const List<StringW>* defaults, size_t index, const StringW& value) const
+  {
+    return index < defaults->getLength() && defaults->getAt(index) == value;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Document being written.
+  const DomDocument* _document;
+  //! @brief Document where elements used by @ref get() are created.
+  DomDocument* _scratch;
+
+  //! @brief Default property values of elements, by tag name.
+  Hash<StringW, List<StringW> > _defaults;
+
+private:
+  FOG_NO_COPY(DomPropertyDefaults)
+};
+
+// ============================================================================
+// [Fog::DomXmlWriter]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief DOM XML writer.
+//!
+//! The document is written as UTF-8 into a buffer which is flushed to the
+//! stream when it's full, so the whole document is never held in memory.
+struct FOG_NO_EXPORT DomXmlWriter
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DomXmlWriter(const DomDocument* document, Stream& stream);
+  ~DomXmlWriter();
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  err_t write();
+
+  err_t _writeDeclaration();
+  err_t _writeNodes();
+  err_t _writeStartTag(const DomElement* element, bool empty);
+  err_t _writeEndTag(const DomElement* element);
+
+  //! @brief Write string @a s escaped by @a escape (see @ref DOM_XML_ESCAPE).
+  err_t _writeString(const StringW& s, uint32_t escape);
+  err_t _writeAscii(const char* s, size_t length);
+
+  FOG_INLINE err_t _writeAscii(const char* s)
+  {
+    return _writeAscii(s, strlen(s));
+  }
+
+  //! @brief Write buffered data to the stream.
+  err_t _flush();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Document being written.
+  const DomDocument* _document;
+  //! @brief Stream where the document is written.
+  Stream* _stream;
+
+  //! @brief Default properties of elements.
+  DomPropertyDefaults _defaults;
+
+  //! @brief Buffer (@c DOM_XML_BUFFER_SIZE bytes).
+  StringA _buffer;
+  //! @brief Start of the buffer.
+  char* _bufferStart;
+  //! @brief Current position in the buffer.
+  char* _bufferPtr;
+  //! @brief End of the buffer.
+  char* _bufferEnd;
+
+  //! @brief Property value (reused).
+  StringW _value;
+  //! @brief Property value serialized by @ref DomDocument::_serializeValue().
+  StringA _data;
+
+private:
+  FOG_NO_COPY(DomXmlWriter)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_DOM_DOMWRITER_P_H
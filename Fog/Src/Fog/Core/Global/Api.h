@@ -418,6 +418,31 @@ struct FOG_NO_EXPORT Api
   void (FOG_CDECL* lock_unlock)(Lock* self);
 #endif // FOG_OS_WINDOWS
 
+  // --------------------------------------------------------------------------
+  // [Core/Threading - AdaptiveLock]
+  // --------------------------------------------------------------------------
+
+  FOG_CAPI_METHOD(void, adaptivelock_lockSlow)(AdaptiveLock* self);
+  FOG_CAPI_METHOD(void, adaptivelock_unlockSlow)(AdaptiveLock* self);
+
+  // --------------------------------------------------------------------------
+  // [Core/Threading - ReadWriteLock]
+  // --------------------------------------------------------------------------
+
+  FOG_CAPI_METHOD(void, readwritelock_lockReadSlow)(ReadWriteLock* self);
+  FOG_CAPI_METHOD(void, readwritelock_unlockReadSlow)(ReadWriteLock* self);
+  FOG_CAPI_METHOD(void, readwritelock_lockWrite)(ReadWriteLock* self);
+  FOG_CAPI_METHOD(bool, readwritelock_tryLockWrite)(ReadWriteLock* self);
+  FOG_CAPI_METHOD(void, readwritelock_unlockWrite)(ReadWriteLock* self);
+
+  // --------------------------------------------------------------------------
+  // [Core/Threading - LockProfile]
+  // --------------------------------------------------------------------------
+
+  FOG_CAPI_STATIC(size_t, lockprofile_getList)(LockProfile* dst, size_t capacity);
+  FOG_CAPI_STATIC(void, lockprofile_reset)(void);
+  FOG_CAPI_METHOD(void, locksite_unregister)(LockSite* self);
+
   // --------------------------------------------------------------------------
   // [Core/Threading - ThreadCondition]
   // --------------------------------------------------------------------------
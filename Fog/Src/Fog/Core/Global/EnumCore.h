@@ -1232,6 +1232,8 @@ enum CPU_FEATURE
   CPU_FEATURE_SSE4_1 = 1U << 19,
   //! @brief Cpu has SSE4.2.
   CPU_FEATURE_SSE4_2 = 1U << 20,
+  //! @brief Cpu has AVX2 (and the OS saves YMM registers).
+  CPU_FEATURE_AVX2 = 1U << 21,
   //! @brief Cpu has AVX.
   CPU_FEATURE_AVX = 1U << 22,
   //! @brief Cpu has Misaligned SSE (MSSE).
@@ -1500,7 +1502,72 @@ enum DOM_POSITION
 enum DOM_RESOURCE_FLAG
 {
   DOM_RESOURCE_FLAG_LOADED = 0x0001,
-  DOM_RESOURCE_FLAG_ERROR = 0x0002
+  DOM_RESOURCE_FLAG_ERROR = 0x0002,
+  //! @brief Resource is being loaded asynchronously.
+  DOM_RESOURCE_FLAG_PENDING = 0x0004
+};
+
+// ============================================================================
+// [Fog::DOM_RESOURCE_LOADER]
+// ============================================================================
+
+enum DOM_RESOURCE_LOADER
+{
+  //! @brief Maximum count of threads used to load the queued resources.
+  DOM_RESOURCE_LOADER_MAX_THREADS = 8,
+
+  //! @brief Default byte budget of @ref DomResourceCache (64MB).
+  DOM_RESOURCE_CACHE_DEFAULT_BUDGET = 64 * 1024 * 1024
+};
+
+// ============================================================================
+// [Fog::DOM_SNAPSHOT]
+// ============================================================================
+
+//! @brief Binary snapshot of @ref DomDocument.
+enum DOM_SNAPSHOT
+{
+  //! @brief Snapshot signature ("FDOM" in memory).
+  DOM_SNAPSHOT_MAGIC = 0x4D4F4446,
+  //! @brief Snapshot format version.
+  DOM_SNAPSHOT_VERSION = 1,
+  //! @brief Used to detect snapshot written on machine with different
+  //! byte-order.
+  DOM_SNAPSHOT_BYTE_ORDER = 0x01020304
+};
+
+// ============================================================================
+// [Fog::DOM_SNAPSHOT_NODE]
+// ============================================================================
+
+//! @brief Record of the snapshot node stream.
+enum DOM_SNAPSHOT_NODE
+{
+  //! @brief End of the current container.
+  DOM_SNAPSHOT_NODE_END = 0,
+  //! @brief Element - tag name, attribute count and attributes.
+  DOM_SNAPSHOT_NODE_ELEMENT = 1,
+  //! @brief Text - data.
+  DOM_SNAPSHOT_NODE_TEXT = 2,
+  //! @brief CDATA section - data.
+  DOM_SNAPSHOT_NODE_CDATA_SECTION = 3,
+  //! @brief Comment - data.
+  DOM_SNAPSHOT_NODE_COMMENT = 4,
+  //! @brief Processing instruction - target and data.
+  DOM_SNAPSHOT_NODE_PROCESSING_INSTRUCTION = 5
+};
+
+// ============================================================================
+// [Fog::DOM_SNAPSHOT_VALUE]
+// ============================================================================
+
+//! @brief Type of attribute value stored in snapshot.
+enum DOM_SNAPSHOT_VALUE
+{
+  //! @brief String (index to the string table).
+  DOM_SNAPSHOT_VALUE_STRING = 0,
+  //! @brief Binary value encoded by @ref DomDocument::_encodeSnapshotValue().
+  DOM_SNAPSHOT_VALUE_BINARY = 1
 };
 
 // ============================================================================
@@ -1709,7 +1776,11 @@ enum LOGGER_TYPE
   LOGGER_TYPE_STREAM = 2,
 
   //! @brief Logging into OutputDebugString function under Windows OS.
-  LOGGER_TYPE_WIN_DEBUG = 3
+  LOGGER_TYPE_WIN_DEBUG = 3,
+
+  //! @brief Asynchronous logging, records are written by a background thread
+  //! into a target @ref Logger.
+  LOGGER_TYPE_ASYNC = 4
 };
 
 // ============================================================================
@@ -2097,9 +2168,11 @@ enum STR
 
   STR_a,
   STR_actualFrame,
+  STR_amplitude,
   STR_angle,
   STR_ani,
   STR_apng,
+  STR_baseFrequency,
   STR_bmp,
   STR_circle,
   STR_clip,
@@ -2122,10 +2195,24 @@ enum STR
   STR_ellipse,
   STR_enable_background,
   STR_encoding,
+  STR_exponent,
+  STR_feColorMatrix,
+  STR_feComponentTransfer,
+  STR_feFuncA,
+  STR_feFuncB,
+  STR_feFuncG,
+  STR_feFuncR,
+  STR_feGaussianBlur,
+  STR_feMerge,
+  STR_feMergeNode,
+  STR_feMorphology,
+  STR_feOffset,
+  STR_feTurbulence,
   STR_fill,
   STR_fill_opacity,
   STR_fill_rule,
   STR_filter,
+  STR_filterUnits,
   STR_flood_color,
   STR_flood_opacity,
   STR_font,
@@ -2148,6 +2235,8 @@ enum STR
   STR_id,
   STR_image,
   STR_image_rendering,
+  STR_in,
+  STR_intercept,
   STR_jfi,
   STR_jfif,
   STR_jpeg,
@@ -2166,8 +2255,10 @@ enum STR
   STR_mng,
   STR_name,
   STR_none,
+  STR_numOctaves,
   STR_offset,
   STR_opacity,
+  STR_operator,
   STR_overflow,
   STR_path,
   STR_pattern,
@@ -2181,20 +2272,27 @@ enum STR
   STR_polygon,
   STR_polyline,
   STR_preserveAspectRatio,
+  STR_primitiveUnits,
   STR_progress,
   STR_quality,
   STR_r,
   STR_radialGradient,
+  STR_radius,
   STR_ras,
   STR_rect,
+  STR_result,
   STR_rotate,
   STR_rx,
   STR_ry,
+  STR_seed,
   STR_shape_rendering,
   STR_skipFileHeader,
+  STR_slope,
   STR_solidColor,
   STR_spreadMethod,
   STR_standalone,
+  STR_stdDeviation,
+  STR_stitchTiles,
   STR_stop,
   STR_stop_color,
   STR_stop_opacity,
@@ -2209,6 +2307,7 @@ enum STR
   STR_style,
   STR_svg,
   STR_symbol,
+  STR_tableValues,
   STR_text,
   STR_text_decoration,
   STR_text_rendering,
@@ -2220,7 +2319,9 @@ enum STR
   STR_transform,
   STR_tref,
   STR_tspan,
+  STR_type,
   STR_use,
+  STR_values,
   STR_version,
   STR_view,
   STR_viewBox,
@@ -2251,6 +2352,7 @@ enum STR
   STR_APPLICATION_UI_Win,
   STR_APPLICATION_UI_Mac,
   STR_APPLICATION_UI_X11,
+  STR_APPLICATION_UI_Offscreen,
 
   // --------------------------------------------------------------------------
   // [...]
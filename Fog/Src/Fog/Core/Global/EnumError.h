@@ -235,6 +235,12 @@ enum ERR_CODE
   //! after calling the attribute is marked as invalid.
   ERR_DOM_INVALID_VALUE,
 
+  //! @brief Data are not a valid DOM snapshot.
+  ERR_DOM_SNAPSHOT_INVALID_FORMAT,
+  //! @brief DOM snapshot was written by an incompatible version or on a
+  //! machine with different byte-order.
+  ERR_DOM_SNAPSHOT_INCOMPATIBLE,
+
   // --------------------------------------------------------------------------
   // [Core/OS - Environment]
   // --------------------------------------------------------------------------
@@ -593,6 +599,16 @@ enum ERR_CODE
   ERR_UI_X11_ENGINE_CANT_CREATE_PIPE,
   //! @brief Unable to create color-map.
   ERR_UI_X11_ENGINE_CANT_CREATE_CMAP,
+
+  // --------------------------------------------------------------------------
+  // [UI/Engine/Offscreen]
+  // --------------------------------------------------------------------------
+
+  //! @brief Unable to create or resize shared memory object using shm_open()
+  //! and ftruncate().
+  ERR_UI_OFFSCREEN_ENGINE_CANT_CREATE_SHM,
+  //! @brief Unable to map shared memory object using mmap().
+  ERR_UI_OFFSCREEN_ENGINE_CANT_MAP_SHM,
   
   // --------------------------------------------------------------------------
   // [UI/Theme]
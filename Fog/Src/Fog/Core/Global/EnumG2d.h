@@ -32,7 +32,11 @@ enum ALPHA_DISTRIBUTION
   ALPHA_DISTRIBUTION_VARIANT = 3,
 
   //! @brief Count of alpha distribution types.
-  ALPHA_DISTRIBUTION_COUNT = 4
+  ALPHA_DISTRIBUTION_COUNT = 4,
+
+  //! @brief Alpha distribution wasn't analyzed yet (only used by the
+  //! @c ImageData cache).
+  ALPHA_DISTRIBUTION_UNKNOWN = 0xFF
 };
 
 // ============================================================================
@@ -2216,6 +2220,108 @@ enum PAINT_DEVICE
   PAINT_DEVICE_COUNT = 2
 };
 
+// ============================================================================
+// [Fog::PAINT_STATISTICS_CMD]
+// ============================================================================
+
+//! @brief Paint-engine command counted by @ref PaintStatistics.
+//!
+//! Commands match the lowest-level operations executed by the raster
+//! paint-engine renderer (commands recorded by a paint group are counted
+//! when the group is rendered).
+enum PAINT_STATISTICS_CMD
+{
+  PAINT_STATISTICS_CMD_FILL_ALL = 0,
+  PAINT_STATISTICS_CMD_FILL_BOX_I = 1,
+  PAINT_STATISTICS_CMD_FILL_BOX_F = 2,
+  PAINT_STATISTICS_CMD_FILL_BOX_D = 3,
+  PAINT_STATISTICS_CMD_FILL_PATH_F = 4,
+  PAINT_STATISTICS_CMD_FILL_PATH_D = 5,
+  //! @brief Fill path using the coverage-mask cache.
+  //!
+  //! Counted for each cache lookup, paths which can't be cached are then
+  //! counted again as @c PAINT_STATISTICS_CMD_FILL_PATH_F or _D.
+  PAINT_STATISTICS_CMD_FILL_CACHED_PATH_F = 6,
+  PAINT_STATISTICS_CMD_FILL_CACHED_PATH_D = 7,
+
+  PAINT_STATISTICS_CMD_BLIT_IMAGE_D = 8,
+  PAINT_STATISTICS_CMD_BLIT_IMAGE_A = 9,
+  PAINT_STATISTICS_CMD_BLIT_NORMALIZED_IMAGE_I = 10,
+  PAINT_STATISTICS_CMD_BLIT_NORMALIZED_IMAGE_D = 11,
+
+  PAINT_STATISTICS_CMD_FILTER_BOX_I = 12,
+  PAINT_STATISTICS_CMD_FILTER_BOX_F = 13,
+  PAINT_STATISTICS_CMD_FILTER_BOX_D = 14,
+  PAINT_STATISTICS_CMD_FILTER_PATH_F = 15,
+  PAINT_STATISTICS_CMD_FILTER_PATH_D = 16,
+
+  PAINT_STATISTICS_CMD_SWITCH_TO_MASK = 17,
+  PAINT_STATISTICS_CMD_DISCARD_MASK = 18,
+  PAINT_STATISTICS_CMD_SAVE_MASK = 19,
+  PAINT_STATISTICS_CMD_RESTORE_MASK = 20,
+
+  PAINT_STATISTICS_CMD_MASK_BOX_I = 21,
+  PAINT_STATISTICS_CMD_MASK_BOX_F = 22,
+  PAINT_STATISTICS_CMD_MASK_BOX_D = 23,
+  PAINT_STATISTICS_CMD_MASK_PATH_F = 24,
+  PAINT_STATISTICS_CMD_MASK_PATH_D = 25,
+
+  //! @brief Count of paint-engine commands.
+  PAINT_STATISTICS_CMD_COUNT = 26
+};
+
+// ============================================================================
+// [Fog::PAINT_STATISTICS_CLIP]
+// ============================================================================
+
+//! @brief Clip type used by a command counted by @ref PaintStatistics.
+enum PAINT_STATISTICS_CLIP
+{
+  //! @brief Command was clipped by the clip-box only.
+  PAINT_STATISTICS_CLIP_BOX = 0,
+  //! @brief Command was clipped by the clip-region.
+  PAINT_STATISTICS_CLIP_REGION = 1,
+  //! @brief Command was clipped by the clip-mask.
+  PAINT_STATISTICS_CLIP_MASK = 2,
+
+  //! @brief Count of clip types.
+  PAINT_STATISTICS_CLIP_COUNT = 3
+};
+
+// ============================================================================
+// [Fog::PAINT_STATISTICS_SOURCE]
+// ============================================================================
+
+//! @brief Source types counted by @ref PaintStatistics.
+//!
+//! The counters are indexed by @c PATTERN_TYPE (@c PATTERN_TYPE_NULL to
+//! @c PATTERN_TYPE_GRADIENT).
+enum PAINT_STATISTICS_SOURCE
+{
+  //! @brief Count of source types.
+  PAINT_STATISTICS_SOURCE_COUNT = 4
+};
+
+// ============================================================================
+// [Fog::PAINT_STATISTICS_TIME]
+// ============================================================================
+
+//! @brief Operation timed by @ref PaintStatistics.
+enum PAINT_STATISTICS_TIME
+{
+  //! @brief Stroking (generating the outline, without filling it).
+  PAINT_STATISTICS_TIME_STROKE = 0,
+  //! @brief Filling (rasterizing and compositing).
+  PAINT_STATISTICS_TIME_FILL = 1,
+  //! @brief Blitting images.
+  PAINT_STATISTICS_TIME_BLIT = 2,
+  //! @brief Filtering.
+  PAINT_STATISTICS_TIME_FILTER = 3,
+
+  //! @brief Count of timed operations.
+  PAINT_STATISTICS_TIME_COUNT = 4
+};
+
 // ============================================================================
 // [Fog::PAINTER_PARAMETER]
 // ============================================================================
@@ -2324,12 +2430,22 @@ enum PAINTER_PARAMETER
   PAINTER_PARAMETER_FILTER_SCALE_F = 34,
   PAINTER_PARAMETER_FILTER_SCALE_D = 35,
 
+  // --------------------------------------------------------------------------
+  // [Statistics]
+  // --------------------------------------------------------------------------
+
+  //! @brief Paint-engine statistics, see @ref PaintStatistics.
+  //!
+  //! Only available if Fog was built with @c FOG_BUILD_PAINT_STATISTICS,
+  //! resetting the parameter clears the counters.
+  PAINTER_PARAMETER_STATISTICS = 36,
+
   // --------------------------------------------------------------------------
   // [...]
   // --------------------------------------------------------------------------
 
   //! @brief Count of painter parameters.
-  PAINTER_PARAMETER_COUNT = 36
+  PAINTER_PARAMETER_COUNT = 37
 };
 
 // ============================================================================
@@ -2867,6 +2983,19 @@ enum SVG_ELEMENT
   SVG_ELEMENT_DEFS,
   SVG_ELEMENT_DESC,
   SVG_ELEMENT_ELLIPSE,
+  SVG_ELEMENT_FE_COLOR_MATRIX,
+  SVG_ELEMENT_FE_COMPONENT_TRANSFER,
+  SVG_ELEMENT_FE_FUNC_A,
+  SVG_ELEMENT_FE_FUNC_B,
+  SVG_ELEMENT_FE_FUNC_G,
+  SVG_ELEMENT_FE_FUNC_R,
+  SVG_ELEMENT_FE_GAUSSIAN_BLUR,
+  SVG_ELEMENT_FE_MERGE,
+  SVG_ELEMENT_FE_MERGE_NODE,
+  SVG_ELEMENT_FE_MORPHOLOGY,
+  SVG_ELEMENT_FE_OFFSET,
+  SVG_ELEMENT_FE_TURBULENCE,
+  SVG_ELEMENT_FILTER,
   SVG_ELEMENT_G,
   SVG_ELEMENT_IMAGE,
   SVG_ELEMENT_LINE,
@@ -2891,6 +3020,26 @@ enum SVG_ELEMENT
   SVG_ELEMENT_VIEW
 };
 
+// ============================================================================
+// [Fog::SVG_FE_COLOR_MATRIX_TYPE]
+// ============================================================================
+
+//! @brief Type of SVG \<feColorMatrix\> element.
+enum SVG_FE_COLOR_MATRIX_TYPE
+{
+  //! @brief 5x4 matrix defined by 'values' attribute.
+  SVG_FE_COLOR_MATRIX_TYPE_MATRIX = 0,
+  //! @brief Saturation defined by a single value.
+  SVG_FE_COLOR_MATRIX_TYPE_SATURATE = 1,
+  //! @brief Hue rotation (in degrees) defined by a single value.
+  SVG_FE_COLOR_MATRIX_TYPE_HUE_ROTATE = 2,
+  //! @brief Luminance converted to alpha, 'values' are not used.
+  SVG_FE_COLOR_MATRIX_TYPE_LUMINANCE_TO_ALPHA = 3,
+
+  //! @brief Count of color matrix types.
+  SVG_FE_COLOR_MATRIX_TYPE_COUNT = 4
+};
+
 // ============================================================================
 // [Fog::SVG_PAINT]
 // ============================================================================
@@ -3050,7 +3199,23 @@ enum SVG_CONTEXT
   //! @brief SVG context is @ref SvgMeasureContext.
   SVG_CONTEXT_MEASURE = 2,
   //! @brief SVG context is @ref SvgHitTestContext.
-  SVG_CONTEXT_HIT_TEST = 3
+  SVG_CONTEXT_HIT_TEST = 3,
+  //! @brief SVG context is @c SvgRecordContext (private).
+  SVG_CONTEXT_RECORD = 4
+};
+
+// ============================================================================
+// [Fog::SVG_SNAPSHOT_VALUE]
+// ============================================================================
+
+//! @brief Type of binary attribute value stored in DOM snapshot by
+//! @ref SvgDocument.
+enum SVG_SNAPSHOT_VALUE
+{
+  //! @brief Path (path data or points) - length, vertices and commands.
+  SVG_SNAPSHOT_VALUE_PATH = 1,
+  //! @brief Transform - 9 floats.
+  SVG_SNAPSHOT_VALUE_TRANSFORM = 2
 };
 
 // ============================================================================
@@ -53,7 +53,14 @@ enum UI_ENGINE_BUFFER
   UI_ENGINE_BUFFER_X11_XIMAGE = 16,
 
   //! @brief Double-buffer is XSHM-Image (UI/X11).
-  UI_ENGINE_BUFFER_X11_XSHMIMAGE = 17
+  UI_ENGINE_BUFFER_X11_XSHMIMAGE = 17,
+
+  // --------------------------------------------------------------------------
+  // [UI/Offscreen Support]
+  // --------------------------------------------------------------------------
+
+  //! @brief Double-buffer is a POSIX shared memory object (UI/Offscreen).
+  UI_ENGINE_BUFFER_OFFSCREEN_SHM = 24
 };
 
 // ============================================================================
@@ -147,6 +154,29 @@ enum UI_ENGINE_MISC
   UI_ENGINE_MISC_DEFAULT_WHEEL_LINES = 3
 };
 
+// ============================================================================
+// [Fog::UI_ENGINE_OFFSCREEN_SHM]
+// ============================================================================
+
+//! @brief Layout constants of the shared memory object used by the offscreen
+//! @ref UIEngine (see @ref OffscreenUIEngineShmHeader).
+enum UI_ENGINE_OFFSCREEN_SHM
+{
+  //! @brief Magic number stored in the header ('FOGS' in little endian).
+  UI_ENGINE_OFFSCREEN_SHM_MAGIC = 0x53474F46,
+  //! @brief Version of the header layout.
+  UI_ENGINE_OFFSCREEN_SHM_VERSION = 1,
+
+  //! @brief Size of the header, the first buffer starts after it.
+  UI_ENGINE_OFFSCREEN_SHM_HEADER_SIZE = 4096,
+  //! @brief Count of buffers (double-buffer).
+  UI_ENGINE_OFFSCREEN_SHM_BUFFER_COUNT = 2,
+
+  //! @brief Maximum count of damage boxes exported per frame, the bounding box
+  //! of the damage is exported if the region is more complex.
+  UI_ENGINE_OFFSCREEN_SHM_DAMAGE_MAX = 128
+};
+
 // ============================================================================
 // [Fog::BUTTON_CODE]
 // ============================================================================
@@ -44,6 +44,7 @@ FOG_CAPI_DECLARE void _fog_init(void)
   ThreadLocal_init();
   ThreadEvent_init();
   ThreadCondition_init();
+  AdaptiveLock_init();           // Depends on Cpu, Lock and ThreadCondition.
 
   // [Core/Math]
   Math_init();                   // Depends on Cpu.
@@ -111,7 +112,11 @@ FOG_CAPI_DECLARE void _fog_init(void)
   EventLoopObserverList_init();  // Depends on List<>.
   Application_init();
 
+  // [Core/Dom]
+  DomResourceCache_init();
+
   // [G2d/Tools]
+  ColorAnalyzer_init();
   Dpi_init();
   Matrix_init();
   Region_init();
@@ -185,6 +190,9 @@ FOG_CAPI_DECLARE void _fog_init(void)
   PaintDeviceInfo_init();
   Painter_init();
 
+  // [G2d/Svg]
+  SvgPathParser_init();
+
   // [G2d/Text]
   OTApi_init();
   Font_init();
@@ -200,6 +208,9 @@ FOG_CAPI_DECLARE void _fog_fini(void)
   // [G2d/Text]
   Font_fini();
 
+  // [G2d/Painting]
+  Painter_fini();
+
   // [G2d/OS]
 #if defined(FOG_OS_WINDOWS)
   WinUtil_G2d_fini();
@@ -208,6 +219,9 @@ FOG_CAPI_DECLARE void _fog_fini(void)
   // [G2d/Imaging]
   ImageCodecProvider_fini();
 
+  // [Core/Dom]
+  DomResourceCache_fini();
+
   // [Core/Application]
   Application_fini();
 
@@ -231,6 +245,7 @@ FOG_CAPI_DECLARE void _fog_fini(void)
   Logger_fini();
 
   // [Core/Threading]
+  AdaptiveLock_fini();
   ThreadLocal_fini();
 
   // [Core/Memory]
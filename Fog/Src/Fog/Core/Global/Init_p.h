@@ -29,6 +29,10 @@ FOG_NO_EXPORT void MemOps_init(void);
 FOG_NO_EXPORT void MemPool_init(void);
 FOG_NO_EXPORT void MemZoneAllocator_init(void);
 
+// [Fog/Core/Dom]
+FOG_NO_EXPORT void DomResourceCache_init(void);
+FOG_NO_EXPORT void DomResourceCache_fini(void);
+
 // [Fog/Core/Kernel]
 FOG_NO_EXPORT void Application_init(void);
 FOG_NO_EXPORT void Application_fini(void);
@@ -64,6 +68,9 @@ FOG_NO_EXPORT void MacUtil_init(void);
 #endif // FOG_OS_MAC
 
 // [Fog/Core/Threading]
+FOG_NO_EXPORT void AdaptiveLock_init(void);
+FOG_NO_EXPORT void AdaptiveLock_fini(void);
+
 FOG_NO_EXPORT void Lock_init(void);
 FOG_NO_EXPORT void Lock_fini(void);
 
@@ -177,6 +184,7 @@ FOG_NO_EXPORT void WinUtil_G2d_fini(void);
 
 // [Fog/G2d/Painting]
 FOG_NO_EXPORT void Painter_init(void);
+FOG_NO_EXPORT void Painter_fini(void);
 FOG_NO_EXPORT void PaintDeviceInfo_init(void);
 FOG_NO_EXPORT void RasterOps_init(void);
 FOG_NO_EXPORT void Rasterizer_init(void);
@@ -188,6 +196,7 @@ FOG_NO_EXPORT void Gradient_init(void);
 FOG_NO_EXPORT void Pattern_init(void);
 
 // [Fog/G2d/Tools]
+FOG_NO_EXPORT void ColorAnalyzer_init(void);
 FOG_NO_EXPORT void Dpi_init(void);
 FOG_NO_EXPORT void Matrix_init(void);
 FOG_NO_EXPORT void Region_init(void);
@@ -198,6 +207,9 @@ FOG_NO_EXPORT void Region_init_win(void);
 
 FOG_NO_EXPORT void RegionUtil_init(void);
 
+// [Fog/G2d/Svg]
+FOG_NO_EXPORT void SvgPathParser_init(void);
+
 // [Fog/G2d/Text]
 FOG_NO_EXPORT void Font_init(void);
 FOG_NO_EXPORT void Font_fini(void);
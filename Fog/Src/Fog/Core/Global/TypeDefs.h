@@ -33,9 +33,17 @@ struct DomNode;
 struct DomNodeList;
 struct DomObj;
 struct DomProcessingInstruction;
+struct DomPropertyDefaults;
+struct DomResourceCache;
 struct DomResourceItem;
+struct DomResourceLoadJob;
 struct DomResourceManager;
+struct DomSaxHandler;
+struct DomSnapshotHeader;
+struct DomSnapshotReader;
+struct DomSnapshotWriter;
 struct DomText;
+struct DomXmlWriter;
 
 // Fog/Core/Global.
 struct BuildInfo;
@@ -87,8 +95,12 @@ struct WinVersion;
 #endif // FOG_OS_WINDOWS
 
 // Fog/Core/Threading.
+struct AdaptiveLock;
 template<typename T> struct Atomic;
 struct Lock;
+struct LockProfile;
+struct LockSite;
+struct ReadWriteLock;
 struct Thread;
 struct ThreadCondition;
 struct ThreadEvent;
@@ -317,6 +329,8 @@ typedef ArgbBaseF PrgbBaseF;
 // Fog/G2d/Svg.
 struct SvgAElement;
 struct SvgCircleElement;
+struct SvgComputedStyle;
+struct SvgComputedStyleCache;
 struct SvgContext;
 struct SvgContextExtension;
 struct SvgContextGState;
@@ -325,18 +339,39 @@ struct SvgDefsElement;
 struct SvgDocument;
 struct SvgElement;
 struct SvgEllipseElement;
+struct SvgFeColorMatrixElement;
+struct SvgFeComponentTransferElement;
+struct SvgFeFuncElement;
+struct SvgFeGaussianBlurElement;
+struct SvgFeMergeElement;
+struct SvgFeMergeNodeElement;
+struct SvgFeMorphologyElement;
+struct SvgFeOffsetElement;
+struct SvgFePrimitiveElement;
+struct SvgFeTurbulenceElement;
+struct SvgFilterElement;
+struct SvgFilterPlan;
+struct SvgInstance;
 struct SvgGElement;
 struct SvgGradientElement;
 struct SvgImageElement;
 struct SvgLineElement;
 struct SvgLinearGradientElement;
+struct SvgPathCommand;
 struct SvgPathElement;
+struct SvgPathJob;
+struct SvgPathParser;
+struct SvgPathPart;
+struct SvgPathTokens;
 struct SvgPatternElement;
 struct SvgPolygonElement;
 struct SvgPolylineElement;
 struct SvgRadialGradientElement;
 struct SvgRectElement;
 struct SvgRootElement;
+struct SvgSaxChunk;
+struct SvgSaxHandler;
+struct SvgSaxJob;
 struct SvgSolidColorElement;
 struct SvgStopElement;
 struct SvgStylableElement;
@@ -52,8 +52,10 @@
 
 #if defined(FOG_OS_POSIX) && !defined(FOG_OS_MAC)
 # include <errno.h>
+# include <stdlib.h>
 # include <unistd.h>
 # if defined(FOG_BUILD_UI)
+#  include <Fog/UI/Engine/OffscreenUIEngine.h>
 #  include <Fog/UI/Engine/UIEngine.h>
 # endif // FOG_BUILD_UI
 #endif // FOG_OS_POSIX
@@ -546,6 +548,11 @@ StringW Application::detectUIEngine()
 # if defined(FOG_OS_MAC)
   return FOG_S(APPLICATION_UI_Mac);
 # else
+  // There is no display to connect to, use the headless engine.
+  const char* display = ::getenv("DISPLAY");
+  if (display == NULL || display[0] == '\0')
+    return FOG_S(APPLICATION_UI_Offscreen);
+
   return FOG_S(APPLICATION_UI_X11);
 # endif
 #endif // FOG_OS_POSIX
@@ -624,6 +631,11 @@ static UIEngine* FOG_CDECL Application_MacUIEngineConstructor() { return fog_new
 # endif // FOG_BUILD_UI
 #endif // FOG_OS_MAC
 
+// [Offscreen]
+#if defined(FOG_OS_POSIX) && !defined(FOG_OS_MAC) && defined(FOG_BUILD_UI)
+static UIEngine* FOG_CDECL Application_OffscreenUIEngineConstructor() { return fog_new OffscreenUIEngine(); }
+#endif // FOG_OS_POSIX && !FOG_OS_MAC && FOG_BUILD_UI
+
 // [X11]
 #if defined(FOG_BUILD_UI_X11) && !defined(FOG_BUILD_UI_X11_MODULE)
 static UIEngine* FOG_CDECL Application_X11UIEngineConstructor() { return fog_new X11UIEngine(); }
@@ -661,6 +673,14 @@ FOG_NO_EXPORT void Application_init(void)
 # endif // FOG_BUILD_UI && FOG_OS_MAC
 #endif // FOG_OS_MAC
 
+  // --------------------------------------------------------------------------
+  // [Offscreen]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_OS_POSIX) && !defined(FOG_OS_MAC) && defined(FOG_BUILD_UI)
+  Application::registerUIEngine(FOG_S(APPLICATION_UI_Offscreen), Application_OffscreenUIEngineConstructor);
+#endif // FOG_OS_POSIX && !FOG_OS_MAC && FOG_BUILD_UI
+
   // --------------------------------------------------------------------------
   // [X11]
   // --------------------------------------------------------------------------
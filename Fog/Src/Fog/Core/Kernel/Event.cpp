@@ -12,8 +12,8 @@
 #include <Fog/Core/Kernel/Application.h>
 #include <Fog/Core/Kernel/Event.h>
 #include <Fog/Core/Kernel/Object.h>
+#include <Fog/Core/Threading/AdaptiveLock.h>
 #include <Fog/Core/Threading/Atomic.h>
-#include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Tools/Logger.h>
 
 namespace Fog {
@@ -42,7 +42,7 @@ void Event::run()
 
     // Remove object from its event queue
     {
-      Fog::AutoLock locked(Object::_internalLock);
+      Fog::AutoAdaptiveLock locked(Object::_internalLock);
 
       if (this == r->_events)
       {
@@ -15,7 +15,7 @@
 #include <Fog/Core/Kernel/Object.h>
 #include <Fog/Core/Memory/MemPool.h>
 #include <Fog/Core/Threading/Thread.h>
-#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/AdaptiveLock.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/HashUtil.h>
 #include <Fog/Core/Tools/InternedString.h>
@@ -32,10 +32,10 @@ namespace Fog {
 // ============================================================================
 
 const MetaClass* Object::_staticMetaClass;
-Static<Lock> Object::_internalLock;
+Static<AdaptiveLock> Object::_internalLock;
 
 static Static<ObjectExtra> Object_extraNull;
-static Static<Lock> Object_memPoolLock;
+static Static<AdaptiveLock> Object_memPoolLock;
 static Static<MemPool> Object_memPoolExtra;
 static Static<MemPool> Object_memPoolConn;
 
@@ -48,7 +48,7 @@ static ObjectExtra* ObjectExtra_create()
   ObjectExtra* extra;
 
   { // Synchronized.
-    AutoLock locked(Object_memPoolLock);
+    AutoAdaptiveLock locked(Object_memPoolLock);
 
     extra = reinterpret_cast<ObjectExtra*>(Object_memPoolExtra->alloc(sizeof(ObjectExtra)));
     if (FOG_IS_NULL(extra))
@@ -63,7 +63,7 @@ static void ObjectExtra_destroy(ObjectExtra* extra)
   extra->~ObjectExtra();
 
   { // Synchronized.
-    AutoLock locked(Object_memPoolLock);
+    AutoAdaptiveLock locked(Object_memPoolLock);
     Object_memPoolExtra->free(extra);
   }
 }
@@ -113,7 +113,7 @@ Object::~Object()
   // Delete all posted events.
   if (_events)
   {
-    AutoLock locked(Object::_internalLock);
+    AutoAdaptiveLock locked(Object::_internalLock);
 
     // Set "wasDeleted" for all pending events.
     Event* ev = _events;
@@ -581,7 +581,7 @@ uint Object::removeListener(Object* listener)
   if (extra == &Object_extraNull)
     return 0;
 
-  AutoLock locked(Object::_internalLock);
+  AutoAdaptiveLock locked(Object::_internalLock);
   uint result = 0;
 
   ObjectConnection* prev;
@@ -645,7 +645,7 @@ uint Object::removeAllListeners()
   if (extra == &Object_extraNull)
     return 0;
 
-  AutoLock locked(Object::_internalLock);
+  AutoAdaptiveLock locked(Object::_internalLock);
 
   uint result = 0;
 
@@ -684,7 +684,7 @@ uint Object::removeAllListeners()
 // Private.
 bool Object::_addListener(uint32_t code, Object* listener, const void* del, uint32_t type)
 {
-  AutoLock locked(Object::_internalLock);
+  AutoAdaptiveLock locked(Object::_internalLock);
 
   ObjectExtra* extra = getMutableExtra();
   if (FOG_IS_NULL(extra))
@@ -733,7 +733,7 @@ bool Object::_removeListener(uint32_t code, Object* listener, const void* del, u
   if (FOG_IS_NULL(extra))
     return false;
 
-  AutoLock locked(Object::_internalLock);
+  AutoAdaptiveLock locked(Object::_internalLock);
 
   ObjectConnection* prev = NULL;
   ObjectConnection* conn = extra->_forwardConnection.get(code, NULL);
@@ -816,7 +816,7 @@ void Object::postEvent(Event* ev)
 
   // Link event with object`s event queue.
   {
-    AutoLock locked(_internalLock);
+    AutoAdaptiveLock locked(_internalLock);
 
     ev->_prev = this->_events;
     this->_events = ev;
@@ -910,7 +910,10 @@ FOG_NO_EXPORT void Object_init(void)
 
   // Initialize the locks.
   Object::_internalLock.init();
+  Object::_internalLock->setName("Fog::Object");
+
   Object_memPoolLock.init();
+  Object_memPoolLock->setName("Fog::Object::memPool");
 
   // Initialize the memory pools.
   Object_memPoolExtra.init();
@@ -11,6 +11,7 @@
 #include <Fog/Core/Global/Global.h>
 #include <Fog/Core/Kernel/Delegate.h>
 #include <Fog/Core/Kernel/Event.h>
+#include <Fog/Core/Threading/AdaptiveLock.h>
 #include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Threading/Thread.h>
 #include <Fog/Core/Tools/Char.h>
@@ -650,7 +651,7 @@ struct FOG_API Object
   // --------------------------------------------------------------------------
 
   static const MetaClass* _staticMetaClass;
-  static Static<Lock> _internalLock;
+  static Static<AdaptiveLock> _internalLock;
 
   // --------------------------------------------------------------------------
   // [Members]
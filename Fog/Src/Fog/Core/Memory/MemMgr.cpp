@@ -12,7 +12,7 @@
 #include <Fog/Core/Global/Init_p.h>
 #include <Fog/Core/Memory/MemDebug_p.h>
 #include <Fog/Core/Memory/MemMgr.h>
-#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/AdaptiveLock.h>
 
 // [Dependencies - C]
 #include <stdio.h>
@@ -122,6 +122,7 @@ struct FOG_NO_EXPORT MemMgrGlobal
     registerAfter(NULL),
     iterating(false)
   {
+    lock.setName("Fog::MemMgr");
   }
 
   ~MemMgrGlobal()
@@ -134,7 +135,7 @@ struct FOG_NO_EXPORT MemMgrGlobal
 
   //! @brief Lock to protect MemMgr::cleanup(), registerCleanupHandler(), and
   //! unregisterCleanupHandler().
-  Lock lock;
+  AdaptiveLock lock;
 
   //! @brief First cleanup handler in the list.
   MemCleanupItem* first;
@@ -160,7 +161,7 @@ static Static<MemMgrGlobal> MemMgr_global;
 static void FOG_CDECL MemMgr_cleanup(uint32_t reason)
 {
   // Synchronized section.
-  { AutoLock locked(MemMgr_global->lock);
+  { AutoAdaptiveLock locked(MemMgr_global->lock);
 
     MemMgr_global->iterating = true;
 
@@ -174,7 +175,7 @@ static void FOG_CDECL MemMgr_cleanup(uint32_t reason)
 
       // Release the lock and call the handler.
       {
-        AutoUnlock unlocked(MemMgr_global->lock);
+        AutoAdaptiveUnlock unlocked(MemMgr_global->lock);
         func(closure, reason);
       }
 
@@ -214,7 +215,7 @@ static err_t FOG_CDECL MemMgr_registerCleanupFunc(MemCleanupFunc func, void* clo
     return ERR_RT_OUT_OF_MEMORY;
 
   // Synchronized section.
-  { AutoLock locked(MemMgr_global->lock);
+  { AutoAdaptiveLock locked(MemMgr_global->lock);
 
     MemCleanupItem** prev = &MemMgr_global->first;
     MemCleanupItem* item = *prev;
@@ -261,7 +262,7 @@ static err_t FOG_CDECL MemMgr_unregisterCleanupFunc(MemCleanupFunc func, void* c
   MemCleanupItem* item = NULL;
 
   // Synchronized section.
-  { AutoLock locked(MemMgr_global->lock);
+  { AutoAdaptiveLock locked(MemMgr_global->lock);
 
     MemCleanupItem** prev = &MemMgr_global->first;
 
@@ -0,0 +1,575 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Threading/AdaptiveLock.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/ThreadCondition.h>
+#include <Fog/Core/Tools/Cpu.h>
+#include <Fog/Core/Tools/Time.h>
+
+// [Dependencies - Linux]
+#if defined(FOG_OS_LINUX)
+# include <limits.h>
+# include <unistd.h>
+# include <sys/syscall.h>
+# include <linux/futex.h>
+#endif // FOG_OS_LINUX
+
+// [Dependencies - MSC]
+#if defined(FOG_CC_MSC) && (defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64))
+# include <intrin.h>
+#endif // FOG_CC_MSC && (FOG_ARCH_X86 || FOG_ARCH_X86_64)
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::AdaptiveLock - Constants]
+// ============================================================================
+
+enum
+{
+  //! @brief Count of spin rounds before a waiting thread is parked.
+  ADAPTIVE_LOCK_SPIN_ROUNDS = 12,
+  //! @brief Maximum count of pause instructions per spin round (the count
+  //! doubles each round, starting at one).
+  ADAPTIVE_LOCK_SPIN_BACKOFF = 64,
+
+  //! @brief Count of parking buckets (if futex is not available).
+  ADAPTIVE_LOCK_BUCKET_COUNT = 64
+};
+
+//! @brief Count of spin rounds, zero on single processor machines.
+static uint32_t AdaptiveLock_spinRounds;
+
+// ============================================================================
+// [Fog::AdaptiveLock - Spin]
+// ============================================================================
+
+static FOG_INLINE void AdaptiveLock_pause()
+{
+#if defined(FOG_CC_MSC) && (defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64))
+  _mm_pause();
+#elif (defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)) && (defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64))
+  __asm__ __volatile__("pause" ::: "memory");
+#elif defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+  __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+//! @internal
+//!
+//! @brief Spins with an exponential pause backoff.
+struct FOG_NO_EXPORT AdaptiveLockSpinner
+{
+  FOG_INLINE AdaptiveLockSpinner() :
+    _rounds(AdaptiveLock_spinRounds),
+    _backoff(1)
+  {
+  }
+
+  //! @brief Spin one round, returns @c false if the thread should be parked
+  //! instead.
+  FOG_INLINE bool spin()
+  {
+    if (_rounds == 0)
+      return false;
+
+    for (uint32_t i = 0; i < _backoff; i++)
+      AdaptiveLock_pause();
+
+    if (_backoff < ADAPTIVE_LOCK_SPIN_BACKOFF)
+      _backoff <<= 1;
+
+    _rounds--;
+    return true;
+  }
+
+  uint32_t _rounds;
+  uint32_t _backoff;
+};
+
+// ============================================================================
+// [Fog::AdaptiveLock - Park (Linux)]
+// ============================================================================
+
+#if defined(FOG_OS_LINUX)
+//! @internal
+//!
+//! @brief Park the current thread if @a atomic equals to @a expected. It can
+//! return spuriously.
+static FOG_INLINE void AdaptiveLock_park(Atomic<uint32_t>* atomic, uint32_t expected)
+{
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(atomic), FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+//! @internal
+//!
+//! @brief Wake up one or all threads parked at @a atomic.
+static FOG_INLINE void AdaptiveLock_unpark(Atomic<uint32_t>* atomic, bool all)
+{
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(atomic), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, NULL, NULL, 0);
+}
+#endif // FOG_OS_LINUX
+
+// ============================================================================
+// [Fog::AdaptiveLock - Park (Generic)]
+// ============================================================================
+
+#if !defined(FOG_OS_LINUX)
+//! @internal
+//!
+//! @brief Parking bucket, shared by all locks of which the address hashes to
+//! the bucket.
+struct FOG_NO_EXPORT AdaptiveLockBucket
+{
+  FOG_INLINE AdaptiveLockBucket() :
+    cond(&lock)
+  {
+  }
+
+  Lock lock;
+  ThreadCondition cond;
+};
+
+static Static<AdaptiveLockBucket> AdaptiveLock_buckets[ADAPTIVE_LOCK_BUCKET_COUNT];
+
+static FOG_INLINE AdaptiveLockBucket& AdaptiveLock_getBucket(Atomic<uint32_t>* atomic)
+{
+  size_t hashCode = (size_t)atomic >> 2;
+  hashCode ^= hashCode >> 7;
+
+  return AdaptiveLock_buckets[hashCode % ADAPTIVE_LOCK_BUCKET_COUNT]();
+}
+
+static FOG_INLINE void AdaptiveLock_park(Atomic<uint32_t>* atomic, uint32_t expected)
+{
+  AdaptiveLockBucket& bucket = AdaptiveLock_getBucket(atomic);
+  AutoLock locked(bucket.lock);
+
+  // The state is changed before unpark() locks the bucket, so checking it
+  // here while the bucket is locked can't miss the wake up.
+  if (atomic->get() == expected)
+    bucket.cond.wait();
+}
+
+static FOG_INLINE void AdaptiveLock_unpark(Atomic<uint32_t>* atomic, bool all)
+{
+  AdaptiveLockBucket& bucket = AdaptiveLock_getBucket(atomic);
+  AutoLock locked(bucket.lock);
+
+  // The bucket can contain threads parked at a different address, so all
+  // threads are woken up, they check the state and park again if needed.
+  FOG_UNUSED(all);
+  bucket.cond.broadcast();
+}
+#endif // !FOG_OS_LINUX
+
+// ============================================================================
+// [Fog::LockSite]
+// ============================================================================
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+static Static<Lock> LockSite_lock;
+static LockSite* LockSite_first;
+
+static void LockSite_record(LockSite* site, uint64_t waitTime, uint32_t parkCount)
+{
+  AutoLock locked(LockSite_lock);
+
+  if (!site->registered)
+  {
+    site->next = LockSite_first;
+    site->registered = true;
+    LockSite_first = site;
+  }
+
+  LockProfile& profile = site->profile;
+  profile.contendedCount++;
+  profile.parkCount += parkCount;
+  profile.waitTime += waitTime;
+
+  if (profile.waitTimeMax < waitTime)
+    profile.waitTimeMax = waitTime;
+}
+
+static void FOG_CDECL LockSite_unregister(LockSite* self)
+{
+  AutoLock locked(LockSite_lock);
+  LockSite** prev = &LockSite_first;
+
+  while (*prev != NULL)
+  {
+    if (*prev == self)
+    {
+      *prev = self->next;
+      break;
+    }
+    prev = &(*prev)->next;
+  }
+
+  self->next = NULL;
+  self->registered = false;
+}
+
+//! @internal
+//!
+//! @brief Measures the time a thread waits for a lock.
+struct FOG_NO_EXPORT AdaptiveLockWait
+{
+  FOG_INLINE AdaptiveLockWait(LockSite* site) :
+    _site(site),
+    _parkCount(0),
+    _started(false)
+  {
+  }
+
+  FOG_INLINE ~AdaptiveLockWait()
+  {
+    if (_started)
+      LockSite_record(_site, (uint64_t)(TimeTicks::now(CPU_TICKS_PRECISION_HIGH) - _start).getDelta(), _parkCount);
+  }
+
+  //! @brief Start measuring (does nothing if already started).
+  FOG_INLINE void begin()
+  {
+    if (!_started)
+    {
+      _start = TimeTicks::now(CPU_TICKS_PRECISION_HIGH);
+      _started = true;
+    }
+  }
+
+  FOG_INLINE void park() { _parkCount++; }
+
+  LockSite* _site;
+  TimeTicks _start;
+  uint32_t _parkCount;
+  bool _started;
+};
+
+# define _FOG_LOCK_SITE(_Self_) (&(_Self_)->_site)
+# define _FOG_LOCK_ACQUIRED(_Self_) (_Self_)->_site.acquireCount.inc()
+#else
+struct FOG_NO_EXPORT AdaptiveLockWait
+{
+  FOG_INLINE AdaptiveLockWait(LockSite* site) { FOG_UNUSED(site); }
+
+  FOG_INLINE void begin() {}
+  FOG_INLINE void park() {}
+};
+
+# define _FOG_LOCK_SITE(_Self_) NULL
+# define _FOG_LOCK_ACQUIRED(_Self_) FOG_MACRO_BEGIN FOG_MACRO_END
+#endif // FOG_BUILD_LOCK_PROFILING
+
+// ============================================================================
+// [Fog::LockProfile]
+// ============================================================================
+
+static size_t FOG_CDECL LockProfile_getList(LockProfile* dst, size_t capacity)
+{
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  AutoLock locked(LockSite_lock);
+  size_t count = 0;
+
+  for (LockSite* site = LockSite_first; site != NULL; site = site->next, count++)
+  {
+    if (count >= capacity)
+      continue;
+
+    dst[count] = site->profile;
+    dst[count].acquireCount = site->acquireCount.get();
+  }
+
+  return count;
+#else
+  FOG_UNUSED(dst);
+  FOG_UNUSED(capacity);
+
+  return 0;
+#endif // FOG_BUILD_LOCK_PROFILING
+}
+
+static void FOG_CDECL LockProfile_reset(void)
+{
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  AutoLock locked(LockSite_lock);
+
+  for (LockSite* site = LockSite_first; site != NULL; site = site->next)
+  {
+    LockProfile& profile = site->profile;
+
+    site->acquireCount.set(0);
+    profile.contendedCount = 0;
+    profile.parkCount = 0;
+    profile.waitTime = 0;
+    profile.waitTimeMax = 0;
+  }
+#endif // FOG_BUILD_LOCK_PROFILING
+}
+
+// ============================================================================
+// [Fog::AdaptiveLock - Lock / Unlock]
+// ============================================================================
+
+static void AdaptiveLock_lockContended(AdaptiveLock* self, AdaptiveLockWait& wait)
+{
+  AdaptiveLockSpinner spinner;
+  wait.begin();
+
+  // Spin while the lock is held, it's likely to be released soon.
+  do {
+    if (self->_state.get() == 0 && self->_state.cmpXchg(0, 1))
+      return;
+  } while (spinner.spin());
+
+  // Park. The state is set to 2 so the owner knows that it has to wake up a
+  // thread when unlocking. The lock is then acquired in state 2 even if there
+  // are no more parked threads, which costs only one unnecessary wake up.
+  while (self->_state.setXchg(2) != 0)
+  {
+    wait.park();
+    AdaptiveLock_park(&self->_state, 2);
+  }
+}
+
+static void FOG_CDECL AdaptiveLock_lockSlow(AdaptiveLock* self)
+{
+  AdaptiveLockWait wait(_FOG_LOCK_SITE(self));
+  AdaptiveLock_lockContended(self, wait);
+}
+
+static void FOG_CDECL AdaptiveLock_unlockSlow(AdaptiveLock* self)
+{
+  // Waiting threads only change the state from 1 to 2, which already happened.
+  uint32_t state;
+  do {
+    state = self->_state.get();
+  } while (!self->_state.cmpXchg(state, 0));
+
+  AdaptiveLock_unpark(&self->_state, false);
+}
+
+// ============================================================================
+// [Fog::ReadWriteLock - Read]
+// ============================================================================
+
+static void FOG_CDECL ReadWriteLock_lockReadSlow(ReadWriteLock* self)
+{
+  uint32_t state;
+
+  // The fast path fails also if another reader changed the state at the same
+  // time, that's not a contention.
+  while (((state = self->_state.get()) & ReadWriteLock::STATE_WRITER) == 0)
+  {
+    if (self->_state.cmpXchg(state, state + 1))
+      return;
+  }
+
+  AdaptiveLockWait wait(_FOG_LOCK_SITE(self));
+  AdaptiveLockSpinner spinner;
+  wait.begin();
+
+  for (;;)
+  {
+    state = self->_state.get();
+
+    if ((state & ReadWriteLock::STATE_WRITER) == 0)
+    {
+      if (self->_state.cmpXchg(state, state + 1))
+        return;
+      continue;
+    }
+
+    if (spinner.spin())
+      continue;
+
+    if ((state & ReadWriteLock::STATE_PARKED) == 0)
+    {
+      if (!self->_state.cmpXchg(state, state | ReadWriteLock::STATE_PARKED))
+        continue;
+      state |= ReadWriteLock::STATE_PARKED;
+    }
+
+    wait.park();
+    AdaptiveLock_park(&self->_state, state);
+  }
+}
+
+static void FOG_CDECL ReadWriteLock_unlockReadSlow(ReadWriteLock* self)
+{
+  // The last reader left while a writer is waiting, new readers can't come in
+  // so only parked threads can change the state.
+  for (;;)
+  {
+    uint32_t state = self->_state.get();
+
+    if ((state & ReadWriteLock::STATE_PARKED) == 0)
+      return;
+
+    if (self->_state.cmpXchg(state, state & ~(uint32_t)ReadWriteLock::STATE_PARKED))
+      break;
+  }
+
+  // Parked readers are woken up too, they park again until the writer unlocks.
+  AdaptiveLock_unpark(&self->_state, true);
+}
+
+// ============================================================================
+// [Fog::ReadWriteLock - Write]
+// ============================================================================
+
+static void FOG_CDECL ReadWriteLock_lockWrite(ReadWriteLock* self)
+{
+  AdaptiveLockWait wait(_FOG_LOCK_SITE(self));
+  uint32_t state;
+
+  // Serialize writers, the wait is recorded to this lock.
+  if (!self->_writerLock._state.cmpXchg(0, 1))
+    AdaptiveLock_lockContended(&self->_writerLock, wait);
+
+  // Block new readers.
+  do {
+    state = self->_state.get();
+  } while (!self->_state.cmpXchg(state, state | ReadWriteLock::STATE_WRITER));
+
+  _FOG_LOCK_ACQUIRED(self);
+
+  // Wait until all readers leave.
+  if ((state & ReadWriteLock::STATE_READER_MASK) == 0)
+    return;
+
+  AdaptiveLockSpinner spinner;
+  wait.begin();
+
+  for (;;)
+  {
+    state = self->_state.get();
+
+    if ((state & ReadWriteLock::STATE_READER_MASK) == 0)
+      return;
+
+    if (spinner.spin())
+      continue;
+
+    if ((state & ReadWriteLock::STATE_PARKED) == 0)
+    {
+      if (!self->_state.cmpXchg(state, state | ReadWriteLock::STATE_PARKED))
+        continue;
+      state |= ReadWriteLock::STATE_PARKED;
+    }
+
+    wait.park();
+    AdaptiveLock_park(&self->_state, state);
+  }
+}
+
+static bool FOG_CDECL ReadWriteLock_tryLockWrite(ReadWriteLock* self)
+{
+  if (!self->_writerLock._state.cmpXchg(0, 1))
+    return false;
+
+  if (!self->_state.cmpXchg(0, ReadWriteLock::STATE_WRITER))
+  {
+    self->_writerLock.unlock();
+    return false;
+  }
+
+  _FOG_LOCK_ACQUIRED(self);
+  return true;
+}
+
+static void FOG_CDECL ReadWriteLock_unlockWrite(ReadWriteLock* self)
+{
+  // There are no readers when a writer holds the lock, but a reader can mark
+  // the lock as parked meanwhile. Released by a full barrier, see AdaptiveLock.
+  uint32_t state;
+  do {
+    state = self->_state.get();
+  } while (!self->_state.cmpXchg(state, 0));
+
+  if ((state & ReadWriteLock::STATE_PARKED) != 0)
+    AdaptiveLock_unpark(&self->_state, true);
+
+  self->_writerLock.unlock();
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void AdaptiveLock_init(void)
+{
+  // --------------------------------------------------------------------------
+  // [Funcs]
+  // --------------------------------------------------------------------------
+
+  fog_api.adaptivelock_lockSlow = AdaptiveLock_lockSlow;
+  fog_api.adaptivelock_unlockSlow = AdaptiveLock_unlockSlow;
+
+  fog_api.readwritelock_lockReadSlow = ReadWriteLock_lockReadSlow;
+  fog_api.readwritelock_unlockReadSlow = ReadWriteLock_unlockReadSlow;
+  fog_api.readwritelock_lockWrite = ReadWriteLock_lockWrite;
+  fog_api.readwritelock_tryLockWrite = ReadWriteLock_tryLockWrite;
+  fog_api.readwritelock_unlockWrite = ReadWriteLock_unlockWrite;
+
+  fog_api.lockprofile_getList = LockProfile_getList;
+  fog_api.lockprofile_reset = LockProfile_reset;
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  fog_api.locksite_unregister = LockSite_unregister;
+#endif // FOG_BUILD_LOCK_PROFILING
+
+  // --------------------------------------------------------------------------
+  // [Data]
+  // --------------------------------------------------------------------------
+
+  // Spinning makes no sense if the lock owner can't run at the same time.
+  AdaptiveLock_spinRounds = Cpu::get()->getNumberOfProcessors() > 1 ? ADAPTIVE_LOCK_SPIN_ROUNDS : 0;
+
+#if !defined(FOG_OS_LINUX)
+  for (uint i = 0; i < ADAPTIVE_LOCK_BUCKET_COUNT; i++)
+    AdaptiveLock_buckets[i].init();
+#endif // !FOG_OS_LINUX
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  LockSite_lock.init();
+  LockSite_first = NULL;
+#endif // FOG_BUILD_LOCK_PROFILING
+}
+
+FOG_NO_EXPORT void AdaptiveLock_fini(void)
+{
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  // Locks destroyed after this point must not touch the list.
+  LockSite* site = LockSite_first;
+  while (site != NULL)
+  {
+    LockSite* next = site->next;
+
+    site->next = NULL;
+    site->registered = false;
+
+    site = next;
+  }
+
+  LockSite_first = NULL;
+  LockSite_lock.destroy();
+#endif // FOG_BUILD_LOCK_PROFILING
+
+#if !defined(FOG_OS_LINUX)
+  for (uint i = 0; i < ADAPTIVE_LOCK_BUCKET_COUNT; i++)
+    AdaptiveLock_buckets[i].destroy();
+#endif // !FOG_OS_LINUX
+}
+
+} // Fog namespace
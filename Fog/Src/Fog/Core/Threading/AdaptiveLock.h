@@ -0,0 +1,488 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_THREADING_ADAPTIVELOCK_H
+#define _FOG_CORE_THREADING_ADAPTIVELOCK_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Threading/Atomic.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_Core_Threading
+//! @{
+
+// ============================================================================
+// [Fog::LockProfile]
+// ============================================================================
+
+//! @brief Contention profile of a lock site (@ref AdaptiveLock or
+//! @ref ReadWriteLock).
+//!
+//! Profiles are collected only if Fog was built with
+//! @c FOG_BUILD_LOCK_PROFILING, otherwise @ref LockProfile::getList() always
+//! returns zero and locks don't contain any profiling code. A lock becomes a
+//! site when it's contended for the first time, use @c setName() to give it
+//! a name.
+struct FOG_NO_EXPORT LockProfile
+{
+  // --------------------------------------------------------------------------
+  // [Statics]
+  // --------------------------------------------------------------------------
+
+  //! @brief Copy profiles of all contended lock sites into @a dst.
+  //!
+  //! Returns the count of sites, which can be greater than @a capacity.
+  static FOG_INLINE size_t getList(LockProfile* dst, size_t capacity)
+  {
+    return fog_api.lockprofile_getList(dst, capacity);
+  }
+
+  //! @brief Reset profiles of all lock sites.
+  static FOG_INLINE void reset()
+  {
+    fog_api.lockprofile_reset();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Name of the lock site (can be @c NULL).
+  const char* name;
+
+  //! @brief Count of acquisitions (exclusive and shared).
+  uint64_t acquireCount;
+  //! @brief Count of acquisitions which had to wait.
+  uint64_t contendedCount;
+  //! @brief Count of times a waiting thread was parked.
+  uint64_t parkCount;
+
+  //! @brief Total wait time (in microseconds).
+  uint64_t waitTime;
+  //! @brief Longest wait (in microseconds).
+  uint64_t waitTimeMax;
+};
+
+// ============================================================================
+// [Fog::LockSite]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Lock site, contains the profile of a lock.
+//!
+//! Only available when Fog was built with @c FOG_BUILD_LOCK_PROFILING. The
+//! site is linked into the global list of sites the first time the lock is
+//! contended and unlinked when the lock is destroyed.
+struct FOG_NO_EXPORT LockSite
+{
+  FOG_INLINE void init()
+  {
+    next = NULL;
+    registered = false;
+    acquireCount.init(0);
+
+    profile.name = NULL;
+    profile.acquireCount = 0;
+    profile.contendedCount = 0;
+    profile.parkCount = 0;
+    profile.waitTime = 0;
+    profile.waitTimeMax = 0;
+  }
+
+  FOG_INLINE void destroy()
+  {
+    if (registered)
+      fog_api.locksite_unregister(this);
+  }
+
+  //! @brief Next registered site.
+  LockSite* next;
+  //! @brief Whether the site is registered.
+  bool registered;
+
+  //! @brief Count of acquisitions, including uncontended ones.
+  Atomic<size_t> acquireCount;
+  //! @brief Profile (modified only by the contended path).
+  LockProfile profile;
+};
+
+// ============================================================================
+// [Fog::AdaptiveLock]
+// ============================================================================
+
+//! @brief Adaptive lock (spins, then parks the thread).
+//!
+//! Unlike @ref Lock, which is a thin wrapper around the OS mutex, the adaptive
+//! lock is a single 32-bit word which is acquired and released by one atomic
+//! operation when not contended. A thread which finds the lock held spins with
+//! an exponential pause backoff (only on multiprocessor machines) before it's
+//! parked, so short critical sections don't pay a system call when contended.
+//!
+//! The adaptive lock is not recursive and it can't be used together with
+//! @ref ThreadCondition.
+//!
+//! @note Unlocking must have release semantics, the writes done in the critical
+//! section must be visible before the lock is seen unlocked. @c Atomic::set()
+//! and @c Atomic::setXchg() don't guarantee that on all targets (they are only
+//! acquire barriers when compiled by GCC intrinsics), so the lock is always
+//! released by @c Atomic::cmpXchg(), which is a full barrier.
+struct FOG_NO_EXPORT AdaptiveLock
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE AdaptiveLock()
+  {
+    _state.init(0);
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.init();
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  FOG_INLINE ~AdaptiveLock()
+  {
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.destroy();
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  // --------------------------------------------------------------------------
+  // [Name]
+  // --------------------------------------------------------------------------
+
+  //! @brief Set the name of the lock reported by @ref LockProfile (@a name
+  //! must be a static string).
+  FOG_INLINE void setName(const char* name)
+  {
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.profile.name = name;
+#else
+    FOG_UNUSED(name);
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  // --------------------------------------------------------------------------
+  // [Lock / Unlock]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void lock()
+  {
+    if (!_state.cmpXchg(0, 1))
+      fog_api.adaptivelock_lockSlow(this);
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.acquireCount.inc();
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  FOG_INLINE bool tryLock()
+  {
+    if (!_state.cmpXchg(0, 1))
+      return false;
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.acquireCount.inc();
+#endif // FOG_BUILD_LOCK_PROFILING
+    return true;
+  }
+
+  FOG_INLINE void unlock()
+  {
+    // Fails if the state is 2 - there might be parked threads.
+    if (!_state.cmpXchg(1, 0))
+      fog_api.adaptivelock_unlockSlow(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief State - 0 (unlocked), 1 (locked), 2 (locked, parked threads).
+  Atomic<uint32_t> _state;
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  //! @brief Lock site.
+  LockSite _site;
+#endif // FOG_BUILD_LOCK_PROFILING
+
+private:
+  FOG_NO_COPY(AdaptiveLock)
+};
+
+// ============================================================================
+// [Fog::ReadWriteLock]
+// ============================================================================
+
+//! @brief Reader-writer lock for read-mostly data.
+//!
+//! Any count of readers can hold the lock at the same time, a writer holds it
+//! exclusively. Acquiring and releasing a read lock is a single atomic
+//! operation when there is no writer. Writers are preferred - once a writer
+//! waits for the lock, new readers wait until the writer finishes. Because of
+//! that the read lock can't be acquired recursively.
+//!
+//! Waiting threads spin with a pause backoff before they are parked, see
+//! @ref AdaptiveLock.
+struct FOG_NO_EXPORT ReadWriteLock
+{
+  // --------------------------------------------------------------------------
+  // [Constants]
+  // --------------------------------------------------------------------------
+
+  enum
+  {
+    //! @brief Mask of the count of readers.
+    STATE_READER_MASK = 0x3FFFFFFFU,
+    //! @brief There might be parked threads.
+    STATE_PARKED = 0x40000000U,
+    //! @brief A writer holds or waits for the lock.
+    STATE_WRITER = 0x80000000U
+  };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE ReadWriteLock()
+  {
+    _state.init(0);
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.init();
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  FOG_INLINE ~ReadWriteLock()
+  {
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.destroy();
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  // --------------------------------------------------------------------------
+  // [Name]
+  // --------------------------------------------------------------------------
+
+  //! @brief Set the name of the lock reported by @ref LockProfile (@a name
+  //! must be a static string).
+  FOG_INLINE void setName(const char* name)
+  {
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.profile.name = name;
+#else
+    FOG_UNUSED(name);
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  // --------------------------------------------------------------------------
+  // [Read]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void lockRead()
+  {
+    uint32_t state = _state.get();
+
+    if ((state & STATE_WRITER) != 0 || !_state.cmpXchg(state, state + 1))
+      fog_api.readwritelock_lockReadSlow(this);
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.acquireCount.inc();
+#endif // FOG_BUILD_LOCK_PROFILING
+  }
+
+  FOG_INLINE bool tryLockRead()
+  {
+    uint32_t state = _state.get();
+
+    if ((state & STATE_WRITER) != 0 || !_state.cmpXchg(state, state + 1))
+      return false;
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+    _site.acquireCount.inc();
+#endif // FOG_BUILD_LOCK_PROFILING
+    return true;
+  }
+
+  FOG_INLINE void unlockRead()
+  {
+    uint32_t state = _state.subXchg(1);
+
+    // The last reader has to wake up the waiting writer.
+    if ((state & (STATE_PARKED | STATE_READER_MASK)) == (STATE_PARKED | 1))
+      fog_api.readwritelock_unlockReadSlow(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Write]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void lockWrite()
+  {
+    fog_api.readwritelock_lockWrite(this);
+  }
+
+  FOG_INLINE bool tryLockWrite()
+  {
+    return fog_api.readwritelock_tryLockWrite(this);
+  }
+
+  FOG_INLINE void unlockWrite()
+  {
+    fog_api.readwritelock_unlockWrite(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief State - count of readers and @c STATE_PARKED and @c STATE_WRITER
+  //! flags.
+  Atomic<uint32_t> _state;
+  //! @brief Lock which serializes writers (its wait is recorded to @c _site).
+  AdaptiveLock _writerLock;
+
+#if defined(FOG_BUILD_LOCK_PROFILING)
+  //! @brief Lock site.
+  LockSite _site;
+#endif // FOG_BUILD_LOCK_PROFILING
+
+private:
+  FOG_NO_COPY(ReadWriteLock)
+};
+
+// ============================================================================
+// [Fog::AutoAdaptiveLock]
+// ============================================================================
+
+//! @brief Auto @c AdaptiveLock locker, see @ref AutoLock.
+struct FOG_NO_EXPORT AutoAdaptiveLock
+{
+  FOG_INLINE AutoAdaptiveLock(AdaptiveLock& target)
+  {
+    _target = &target;
+    _target->lock();
+  }
+
+  FOG_INLINE AutoAdaptiveLock(AdaptiveLock* target)
+  {
+    _target = target;
+    _target->lock();
+  }
+
+  FOG_INLINE ~AutoAdaptiveLock()
+  {
+    _target->unlock();
+  }
+
+  //! @brief Pointer to a lock.
+  AdaptiveLock* _target;
+
+private:
+  FOG_NO_COPY(AutoAdaptiveLock)
+};
+
+// ============================================================================
+// [Fog::AutoAdaptiveUnlock]
+// ============================================================================
+
+//! @brief Opposite to @c AutoAdaptiveLock, see @ref AutoUnlock.
+struct FOG_NO_EXPORT AutoAdaptiveUnlock
+{
+  FOG_INLINE AutoAdaptiveUnlock(AdaptiveLock& target)
+  {
+    _target = &target;
+    _target->unlock();
+  }
+
+  FOG_INLINE AutoAdaptiveUnlock(AdaptiveLock* target)
+  {
+    _target = target;
+    _target->unlock();
+  }
+
+  FOG_INLINE ~AutoAdaptiveUnlock()
+  {
+    _target->lock();
+  }
+
+  //! @brief Pointer to a lock.
+  AdaptiveLock* _target;
+
+private:
+  FOG_NO_COPY(AutoAdaptiveUnlock)
+};
+
+// ============================================================================
+// [Fog::AutoReadLock]
+// ============================================================================
+
+//! @brief Auto @c ReadWriteLock read locker.
+struct FOG_NO_EXPORT AutoReadLock
+{
+  FOG_INLINE AutoReadLock(ReadWriteLock& target)
+  {
+    _target = &target;
+    _target->lockRead();
+  }
+
+  FOG_INLINE AutoReadLock(ReadWriteLock* target)
+  {
+    _target = target;
+    _target->lockRead();
+  }
+
+  FOG_INLINE ~AutoReadLock()
+  {
+    _target->unlockRead();
+  }
+
+  //! @brief Pointer to a lock.
+  ReadWriteLock* _target;
+
+private:
+  FOG_NO_COPY(AutoReadLock)
+};
+
+// ============================================================================
+// [Fog::AutoWriteLock]
+// ============================================================================
+
+//! @brief Auto @c ReadWriteLock write locker.
+struct FOG_NO_EXPORT AutoWriteLock
+{
+  FOG_INLINE AutoWriteLock(ReadWriteLock& target)
+  {
+    _target = &target;
+    _target->lockWrite();
+  }
+
+  FOG_INLINE AutoWriteLock(ReadWriteLock* target)
+  {
+    _target = target;
+    _target->lockWrite();
+  }
+
+  FOG_INLINE ~AutoWriteLock()
+  {
+    _target->unlockWrite();
+  }
+
+  //! @brief Pointer to a lock.
+  ReadWriteLock* _target;
+
+private:
+  FOG_NO_COPY(AutoWriteLock)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_THREADING_ADAPTIVELOCK_H
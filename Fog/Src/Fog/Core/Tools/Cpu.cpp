@@ -24,6 +24,9 @@
 # include <unistd.h>
 #endif // FOG_OS_POSIX
 
+// [Dependencies - C]
+#include <stdlib.h>
+
 namespace Fog {
 
 // ============================================================================
@@ -74,7 +77,10 @@ union FOG_NO_EXPORT CpuId
 #if defined(FOG_CC_MSC)
 static void FOG_CDECL Cpu_cpuid(uint32_t in, CpuId* out)
 {
-#if _MSC_VER >= 1400
+#if _MSC_VER >= 1500
+  // Done by intrinsics, sub-leaf (ECX) is always zero.
+  __cpuidex(reinterpret_cast<int*>(out->i), in, 0);
+#elif _MSC_VER >= 1400
   // Done by intrinsics.
   __cpuid(reinterpret_cast<int*>(out->i), in);
 #else // _MSC_VER < 1400
@@ -84,6 +90,7 @@ static void FOG_CDECL Cpu_cpuid(uint32_t in, CpuId* out)
   __asm
   {
     mov     eax, cpuid_in
+    xor     ecx, ecx
     mov     edi, cpuid_out
     cpuid
     mov     dword ptr[edi +  0], eax
@@ -104,18 +111,33 @@ static void FOG_CDECL Cpu_cpuid(uint32_t in, CpuId* out)
   asm("mov %%ebx, %%edi\n"    \
       "cpuid\n"               \
       "xchg %%edi, %%ebx\n"   \
-      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp))
+      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp), "c" (0))
 #else
 #define _Cpuid(a, b, c, d, inp) \
   asm("mov %%rbx, %%rdi\n"    \
       "cpuid\n"               \
       "xchg %%rdi, %%rbx\n"   \
-      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp))
+      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp), "c" (0))
 #endif
   _Cpuid(out->eax, out->ebx, out->ecx, out->edx, in);
 }
 #endif // FOG_CC_GNU
 
+// Get the XCR0 register (the state components enabled by the OS), only valid
+// if the cpu reports OSXSAVE support.
+static uint32_t FOG_CDECL Cpu_xgetbv(void)
+{
+#if defined(FOG_CC_MSC) && (_MSC_FULL_VER >= 160040219)
+  return (uint32_t)_xgetbv(0);
+#elif defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+  uint32_t lo, hi;
+  asm(".byte 0x0F, 0x01, 0xD0" : "=a" (lo), "=d" (hi) : "c" (0));
+  return lo;
+#else
+  return 0;
+#endif
+}
+
 #endif // FOG_ARCH_X86) || FOG_ARCH_X86_64
 
 // ============================================================================
@@ -207,6 +229,7 @@ static void Cpu_detect(Cpu* cpu)
 
   // Get vendor string.
   Cpu_cpuid(0, &out);
+  uint32_t maxId = out.eax;
 
   reinterpret_cast<uint32_t*>(cpu->_vendor)[0] = out.ebx;
   reinterpret_cast<uint32_t*>(cpu->_vendor)[1] = out.edx;
@@ -247,6 +270,9 @@ static void Cpu_detect(Cpu* cpu)
   if (out.ecx & 0x00800000U) features |= CPU_FEATURE_POPCNT;
   if (out.ecx & 0x10000000U) features |= CPU_FEATURE_AVX;
 
+  // AVX2 is only usable when the OS saves XMM and YMM state (XCR0 bits 1-2).
+  bool hasYmmState = (out.ecx & 0x18000000U) == 0x18000000U && (Cpu_xgetbv() & 0x6U) == 0x6U;
+
   if (out.edx & 0x00000010U) features |= CPU_FEATURE_RDTSC;
   if (out.edx & 0x00000100U) features |= CPU_FEATURE_CMPXCHG8B;
   if (out.edx & 0x00008000U) features |= CPU_FEATURE_CMOV;
@@ -271,6 +297,13 @@ static void Cpu_detect(Cpu* cpu)
     cpu->_bugs |= CPU_BUG_AMD_LOCK_MB;
   }
 
+  // Get structured extended feature flags in EBX.
+  if (maxId >= 7)
+  {
+    Cpu_cpuid(7, &out);
+    if ((out.ebx & 0x00000020U) && hasYmmState) features |= CPU_FEATURE_AVX2;
+  }
+
   // Calling cpuid with 0x80000000 as the in argument gets the number of valid
   // extended IDs.
   Cpu_cpuid(0x80000000, &out);
@@ -323,6 +356,76 @@ static void Cpu_detect(Cpu* cpu)
   cpu->_features = features;
 }
 
+// ============================================================================
+// [Fog::Cpu - Disable]
+// ============================================================================
+
+struct FOG_NO_EXPORT CpuFeatureName
+{
+  char name[8];
+  uint32_t mask;
+};
+
+// Disabling a feature disables also all features which imply it, so the
+// initializers of higher tiers are never called without the lower ones.
+#define CPU_FEATURES_ABOVE_SSE2 \
+  (CPU_FEATURE_SSE3 | CPU_FEATURES_ABOVE_SSE3)
+#define CPU_FEATURES_ABOVE_SSE3 \
+  (CPU_FEATURE_SSSE3 | CPU_FEATURES_ABOVE_SSSE3)
+#define CPU_FEATURES_ABOVE_SSSE3 \
+  (CPU_FEATURE_SSE4_1 | CPU_FEATURE_SSE4_2 | CPU_FEATURE_AVX | CPU_FEATURE_AVX2)
+
+static const CpuFeatureName Cpu_featureNames[] =
+{
+  { "MMX"   , CPU_FEATURE_MMX    | CPU_FEATURE_MMX_EXT | CPU_FEATURE_3DNOW | CPU_FEATURE_3DNOW_EXT },
+  { "SSE"   , CPU_FEATURE_SSE    | CPU_FEATURE_SSE2 | CPU_FEATURES_ABOVE_SSE2 },
+  { "SSE2"  , CPU_FEATURE_SSE2   | CPU_FEATURES_ABOVE_SSE2  },
+  { "SSE3"  , CPU_FEATURE_SSE3   | CPU_FEATURES_ABOVE_SSE3  },
+  { "SSSE3" , CPU_FEATURE_SSSE3  | CPU_FEATURES_ABOVE_SSSE3 },
+  { "SSE4.1", CPU_FEATURE_SSE4_1 | CPU_FEATURE_SSE4_2 | CPU_FEATURE_AVX | CPU_FEATURE_AVX2 },
+  { "SSE4.2", CPU_FEATURE_SSE4_2 | CPU_FEATURE_AVX | CPU_FEATURE_AVX2 },
+  { "AVX"   , CPU_FEATURE_AVX    | CPU_FEATURE_AVX2 },
+  { "AVX2"  , CPU_FEATURE_AVX2   }
+};
+
+//! @internal
+//!
+//! @brief Remove features listed in the FOG_CPU_DISABLE environment variable.
+//!
+//! The variable contains a comma separated list of feature names, for example
+//! "AVX2" or "SSE2". It's read once at startup (all CPU based initializers are
+//! called by the library initialization) and it's used to benchmark and
+//! compare the optimized code-paths against each other.
+static void Cpu_disable(Cpu* cpu)
+{
+  const char* env = getenv("FOG_CPU_DISABLE");
+  if (env == NULL)
+    return;
+
+  for (;;)
+  {
+    const char* end = env;
+    while (*end != '\0' && *end != ',')
+      end++;
+
+    size_t len = (size_t)(end - env);
+    for (size_t i = 0; i < FOG_ARRAY_SIZE(Cpu_featureNames); i++)
+    {
+      const CpuFeatureName& feature = Cpu_featureNames[i];
+
+      if (strlen(feature.name) == len && strncmp(feature.name, env, len) == 0)
+      {
+        cpu->_features &= ~feature.mask;
+        break;
+      }
+    }
+
+    if (*end == '\0')
+      break;
+    env = end + 1;
+  }
+}
+
 // ============================================================================
 // [Init / Fini]
 // ============================================================================
@@ -331,6 +434,7 @@ FOG_NO_EXPORT void Cpu_init(void)
 {
   fog_api.cpu_oInstance = &Cpu_instance;
   Cpu_detect(fog_api.cpu_oInstance);
+  Cpu_disable(fog_api.cpu_oInstance);
 }
 
 } // Fog namespace
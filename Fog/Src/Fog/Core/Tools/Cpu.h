@@ -44,6 +44,13 @@ enum { CPU_CACHE_LINE = 64 };
 //!   // Cpu hasn't SSE2 support.
 //! }
 //! @endverbatim
+//!
+//! Features can be masked out by the @c FOG_CPU_DISABLE environment variable,
+//! which contains a comma separated list of feature names (for example
+//! "AVX2" or "SSSE3,AVX2"). Disabling a feature disables also all features
+//! above it, this is used to run the library using a lower optimization tier.
+//! Features hardcoded at compile time (for example SSE2 on x86-64) can't be
+//! masked, the raster tier can be selected by @c RasterOps_setTier() instead.
 struct FOG_NO_EXPORT Cpu
 {
   // --------------------------------------------------------------------------
@@ -227,6 +234,27 @@ struct FOG_NO_EXPORT Cpu
 #define FOG_CPU_USE_INITIALIZER_SSSE3(_Initializer_)
 #endif // FOG_OPTIMIZE_SSSE3
 
+// ============================================================================
+// [FOG_CPU - AVX2]
+// ============================================================================
+
+#if defined(FOG_OPTIMIZE_AVX2)
+#define FOG_CPU_DECLARE_INITIALIZER_AVX2(_Initializer_) \
+  FOG_NO_EXPORT void _Initializer_;
+
+#if defined(FOG_HARDCODE_AVX2)
+#define FOG_CPU_USE_INITIALIZER_AVX2(_Initializer_) \
+  _Initializer_;
+#else
+#define FOG_CPU_USE_INITIALIZER_AVX2(_Initializer_) \
+  if (::Fog::Cpu::get()->hasFeature(::Fog::CPU_FEATURE_AVX2)) _Initializer_;
+#endif // FOG_HARDCODE_AVX2
+
+#else
+#define FOG_CPU_DECLARE_INITIALIZER_AVX2(_Initializer_)
+#define FOG_CPU_USE_INITIALIZER_AVX2(_Initializer_)
+#endif // FOG_OPTIMIZE_AVX2
+
 //! @}
 
 } // Fog namespace
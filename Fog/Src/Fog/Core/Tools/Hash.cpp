@@ -211,7 +211,7 @@ static err_t FOG_CDECL Hash_Unknown_Unknown_rehashExclude(HashUntyped* self, con
           uint32_t hashCode = v->hashKey(reinterpret_cast<uint8_t*>(oNode) + idxKey);
           uint32_t hashMod = hashCode % newCapacity;
 
-          HashUntypedNode** nPrev = &d->data[hashMod];
+          HashUntypedNode** nPrev = &nData[hashMod];
           HashUntypedNode* nNode = reinterpret_cast<HashUntypedNode*>(newd->nodePool.alloc(szNode));
 
           // We preallocated all nodes, it's not possible to get NULL here.
@@ -221,7 +221,7 @@ static err_t FOG_CDECL Hash_Unknown_Unknown_rehashExclude(HashUntyped* self, con
                          reinterpret_cast<uint8_t*>(oNode) + idxItem);
 
           nNode->next = *nPrev;
-          *nPrev = nNode->next;
+          *nPrev = nNode;
         }
 
         oNode = oNode->next;
@@ -2244,7 +2244,7 @@ FOG_NO_EXPORT void Hash_init(void)
   Hash_StringW_Var_vTable->setItem = (HashUntypedVTable::SetItem)fog_api.var_copy;
   Hash_StringW_Var_vTable->hashKey = (HashFunc)fog_api.stringw_getHashCode;
   Hash_StringW_Var_vTable->eqKey = (EqFunc)fog_api.stringw_eqStringW;
-  fog_api.hash_stringa_var_vTable = &Hash_StringW_Var_vTable;
+  fog_api.hash_stringw_var_vTable = &Hash_StringW_Var_vTable;
 }
 
 } // Fog namespace
@@ -11,7 +11,7 @@
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
 #include <Fog/Core/Memory/MemMgr.h>
-#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/AdaptiveLock.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/HashUtil.h>
 #include <Fog/Core/Tools/InternedString.h>
@@ -370,10 +370,67 @@ InternedStringNodeW* InternedStringHashW::_cleanup()
 // [Fog::InternedStringW - Global]
 // ============================================================================
 
-static Static<Lock> InternedStringW_lock;
+static Static<ReadWriteLock> InternedStringW_lock;
 static Static<InternedStringHashW> InternedStringW_hash;
 static Static<InternedStringW> InternedStringW_oEmpty;
 
+// ============================================================================
+// [Fog::InternedStringW - Get]
+// ============================================================================
+
+// Most strings are already interned, so the table is searched using the read
+// lock first and the write lock is only used to add a new string.
+
+static err_t InternedStringW_getStubA(StringDataW** dst, const char* sData, size_t sLength, uint32_t hashCode, uint32_t options)
+{
+  StringDataW* d;
+
+  {
+    AutoReadLock locked(InternedStringW_lock);
+    d = InternedStringW_hash->lookupStubA(sData, sLength, hashCode);
+  }
+
+  if (FOG_IS_NULL(d))
+  {
+    if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    AutoWriteLock locked(InternedStringW_lock);
+    d = InternedStringW_hash->addStubA(sData, sLength, hashCode);
+
+    if (FOG_IS_NULL(d))
+      return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  *dst = d;
+  return ERR_OK;
+}
+
+static err_t InternedStringW_getStubW(StringDataW** dst, const CharW* sData, size_t sLength, uint32_t hashCode, uint32_t options)
+{
+  StringDataW* d;
+
+  {
+    AutoReadLock locked(InternedStringW_lock);
+    d = InternedStringW_hash->lookupStubW(sData, sLength, hashCode);
+  }
+
+  if (FOG_IS_NULL(d))
+  {
+    if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    AutoWriteLock locked(InternedStringW_lock);
+    d = InternedStringW_hash->addStubW(sData, sLength, hashCode);
+
+    if (FOG_IS_NULL(d))
+      return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  *dst = d;
+  return ERR_OK;
+}
+
 // ============================================================================
 // [Fog::InternedStringW - Construction / Destruction]
 // ============================================================================
@@ -401,26 +458,13 @@ static err_t FOG_CDECL InternedStringW_ctorStubA(InternedStringW* self, const St
 
   uint32_t hashCode = HashUtil::hash(StubA(sData, sLength));
 
-  AutoLock locked(InternedStringW_lock);
   StringDataW* d;
+  err_t err = InternedStringW_getStubA(&d, sData, sLength, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+  if (FOG_IS_ERROR(err))
   {
-    d = InternedStringW_hash->lookupStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OBJECT_NOT_FOUND;
-    }
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OUT_OF_MEMORY;
-    }
+    self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
+    return err;
   }
 
   self->_string->_d = d;
@@ -439,26 +483,13 @@ static err_t FOG_CDECL InternedStringW_ctorStubW(InternedStringW* self, const St
 
   uint32_t hashCode = HashUtil::hash(StubW(sData, sLength));
 
-  AutoLock locked(InternedStringW_lock);
   StringDataW* d;
+  err_t err = InternedStringW_getStubW(&d, sData, sLength, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OBJECT_NOT_FOUND;
-    }
-  }
-  else
+  if (FOG_IS_ERROR(err))
   {
-    d = InternedStringW_hash->addStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OUT_OF_MEMORY;
-    }
+    self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
+    return err;
   }
 
   self->_string->_d = d;
@@ -482,25 +513,12 @@ static err_t FOG_CDECL InternedStringW_ctorStringW(InternedStringW* self, const
   }
 
   uint32_t hashCode = str->getHashCode();
-  AutoLock locked(InternedStringW_lock);
+  err_t err = InternedStringW_getStubW(&d, d->data, d->length, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+  if (FOG_IS_ERROR(err))
   {
-    d = InternedStringW_hash->lookupStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OBJECT_NOT_FOUND;
-    }
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OUT_OF_MEMORY;
-    }
+    self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
+    return err;
   }
 
   self->_string->_d = d;
@@ -532,21 +550,11 @@ static err_t FOG_CDECL InternedStringW_setStubA(InternedStringW* self, const Stu
 
   uint32_t hashCode = HashUtil::hash(StubA(sData, sLength));
 
-  AutoLock locked(InternedStringW_lock);
   StringDataW* d;
+  err_t err = InternedStringW_getStubA(&d, sData, sLength, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OBJECT_NOT_FOUND;
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OUT_OF_MEMORY;
-  }
+  if (FOG_IS_ERROR(err))
+    return err;
 
   atomicPtrXchg(&self->_string->_d, d)->reference.dec();
   return ERR_OK;
@@ -565,21 +573,11 @@ static err_t FOG_CDECL InternedStringW_setStubW(InternedStringW* self, const Stu
 
   uint32_t hashCode = HashUtil::hash(StubW(sData, sLength));
 
-  AutoLock locked(InternedStringW_lock);
   StringDataW* d;
+  err_t err = InternedStringW_getStubW(&d, sData, sLength, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OBJECT_NOT_FOUND;
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OUT_OF_MEMORY;
-  }
+  if (FOG_IS_ERROR(err))
+    return err;
 
   atomicPtrXchg(&self->_string->_d, d)->reference.dec();
   return ERR_OK;
@@ -596,20 +594,10 @@ static err_t FOG_CDECL InternedStringW_setStringW(InternedStringW* self, const S
   }
 
   uint32_t hashCode = str->getHashCode();
-  AutoLock locked(InternedStringW_lock);
+  err_t err = InternedStringW_getStubW(&d, d->data, d->length, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OBJECT_NOT_FOUND;
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OUT_OF_MEMORY;
-  }
+  if (FOG_IS_ERROR(err))
+    return err;
 
   atomicPtrXchg(&self->_string->_d, d)->reference.dec();
   return ERR_OK;
@@ -643,25 +631,45 @@ static bool FOG_CDECL InternedStringW_eq(const InternedStringW* a, const Interne
 // [Fog::InternedStringCacheW - Cleanup]
 // ============================================================================
 
+static void InternedStringW_freeNodes(InternedStringNodeW* node)
+{
+  while (node)
+  {
+    InternedStringNodeW* next = node->next;
+    MemMgr::free(node);
+    node = next;
+  }
+}
+
 static void FOG_CDECL InternedStringW_cleanup(void)
 {
   InternedStringNodeW* node;
 
   {
-    AutoLock locked(InternedStringW_lock);
+    AutoWriteLock locked(InternedStringW_lock);
     node = InternedStringW_hash->_cleanup();
   }
 
-  while (node)
-  {
-    InternedStringNodeW* next = node->next;
-    MemMgr::free(node);
-    node = next;
-  }
+  InternedStringW_freeNodes(node);
 }
 
 static void FOG_CDECL InternedStringW_cleanupFunc(void* closure, uint32_t reason)
 {
+  // The lock is not recursive and running out of memory while adding a string
+  // calls this handler with the lock held, so the cleanup is skipped if the
+  // table is in use.
+  if (reason == MEMORY_CLEANUP_REASON_NO_MEMORY)
+  {
+    if (!InternedStringW_lock->tryLockWrite())
+      return;
+
+    InternedStringNodeW* node = InternedStringW_hash->_cleanup();
+    InternedStringW_lock->unlockWrite();
+
+    InternedStringW_freeNodes(node);
+    return;
+  }
+
   InternedStringW::cleanup();
 }
 
@@ -753,7 +761,7 @@ static InternedStringCacheW* FOG_CDECL InternedStringCacheW_create(const char* s
   FOG_ASSERT(listLength == counter);
   FOG_ASSERT(pData <= pEnd);
 
-  AutoLock locked(InternedStringW_lock);
+  AutoWriteLock locked(InternedStringW_lock);
   InternedStringW_hash->addList(pListBase, listLength);
 
   return self;
@@ -794,9 +802,11 @@ static const char InternedStringCacheW_data[] =
 
   "a\0"
   "actualFrame\0"
+  "amplitude\0"
   "angle\0"
   "ani\0"
   "apng\0"
+  "baseFrequency\0"
   "bmp\0"
   "circle\0"
   "clip\0"
@@ -819,10 +829,24 @@ static const char InternedStringCacheW_data[] =
   "ellipse\0"
   "enable-background\0"
   "encoding\0"
+  "exponent\0"
+  "feColorMatrix\0"
+  "feComponentTransfer\0"
+  "feFuncA\0"
+  "feFuncB\0"
+  "feFuncG\0"
+  "feFuncR\0"
+  "feGaussianBlur\0"
+  "feMerge\0"
+  "feMergeNode\0"
+  "feMorphology\0"
+  "feOffset\0"
+  "feTurbulence\0"
   "fill\0"
   "fill-opacity\0"
   "fill-rule\0"
   "filter\0"
+  "filterUnits\0"
   "flood-color\0"
   "flood-opacity\0"
   "font\0"
@@ -845,6 +869,8 @@ static const char InternedStringCacheW_data[] =
   "id\0"
   "image\0"
   "image-rendering\0"
+  "in\0"
+  "intercept\0"
   "jfi\0"
   "jfif\0"
   "jpg\0"
@@ -863,8 +889,10 @@ static const char InternedStringCacheW_data[] =
   "mng\0"
   "name\0"
   "none\0"
+  "numOctaves\0"
   "offset\0"
   "opacity\0"
+  "operator\0"
   "overflow\0"
   "path\0"
   "pattern\0"
@@ -878,20 +906,27 @@ static const char InternedStringCacheW_data[] =
   "polygon\0"
   "polyline\0"
   "preserveAspectRatio\0"
+  "primitiveUnits\0"
   "progress\0"
   "quality\0"
   "r\0"
   "radialGradient\0"
+  "radius\0"
   "ras\0"
   "rect\0"
+  "result\0"
   "rotate\0"
   "rx\0"
   "ry\0"
+  "seed\0"
   "shape-rendering\0"
   "skipFileHeader\0"
+  "slope\0"
   "solidColor\0"
   "spreadMethod\0"
   "standalone\0"
+  "stdDeviation\0"
+  "stitchTiles\0"
   "stop\0"
   "stop-color\0"
   "stop-opacity\0"
@@ -906,6 +941,7 @@ static const char InternedStringCacheW_data[] =
   "style\0"
   "svg\0"
   "symbol\0"
+  "tableValues\0"
   "text\0"
   "text-decoration\0"
   "text-rendering\0"
@@ -917,7 +953,9 @@ static const char InternedStringCacheW_data[] =
   "transform\0"
   "tref\0"
   "tspan\0"
+  "type\0"
   "use\0"
+  "values\0"
   "version\0"
   "view\0"
   "viewBox\0"
@@ -946,6 +984,7 @@ static const char InternedStringCacheW_data[] =
   "UI.Win\0"
   "UI.Mac\0"
   "UI.X11\0"
+  "UI.Offscreen\0"
 };
 
 // ============================================================================
@@ -984,6 +1023,7 @@ FOG_NO_EXPORT void InternedString_init(void)
   fog_api.internedstringw_oEmpty = &InternedStringW_oEmpty;
 
   InternedStringW_lock.init();
+  InternedStringW_lock->setName("Fog::InternedStringW");
   InternedStringW_hash.init();
 
   MemMgr::registerCleanupFunc(InternedStringW_cleanupFunc, NULL);
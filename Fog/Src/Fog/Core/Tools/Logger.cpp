@@ -11,9 +11,13 @@
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
 #include <Fog/Core/Kernel/Application.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/AtomicPadding.h>
 #include <Fog/Core/Threading/Thread.h>
 #include <Fog/Core/Threading/ThreadLocal.h>
 #include <Fog/Core/Tools/Logger.h>
+#include <Fog/Core/Tools/StringUtil.h>
 
 namespace Fog {
 
@@ -198,7 +202,7 @@ static err_t Logger_formatRecord(StringA& dst, const LoggerRecord& record)
     FormatInt(16, STRING_FORMAT_CAPITALIZE | STRING_FORMAT_ZERO_PAD, 0, sizeof(void*) * 2)));
   FOG_RETURN_ON_ERROR(dst.append(' '));
 
-  err_t err = TextCodec::local8().encode(dst, record.getMessage());
+  err_t err = TextCodec::local8().encode(dst, record.getMessage(), NULL, NULL, CONTAINER_OP_APPEND);
   if (!dst.endsWith('\n'))
     FOG_RETURN_ON_ERROR(dst.append('\n'));
   return err;
@@ -216,6 +220,12 @@ void Logger::emitRecord(const LoggerRecord& record)
   fflush(stderr);
 }
 
+void Logger::emitRecords(const LoggerRecord* records, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    emitRecord(records[i]);
+}
+
 // ============================================================================
 // [Fog::Logger - Statics - Instance]
 // ============================================================================
@@ -331,7 +341,928 @@ StreamLogger::~StreamLogger()
 
 void StreamLogger::emitRecord(const LoggerRecord& record)
 {
-  // TODO:???
+  emitRecords(&record, 1);
+}
+
+void StreamLogger::emitRecords(const LoggerRecord* records, size_t count)
+{
+  StringA buf;
+
+  for (size_t i = 0; i < count; i++)
+    Logger_formatRecord(buf, records[i]);
+
+  _stream.write(buf);
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Constants]
+// ============================================================================
+
+enum LOGGER_ASYNC
+{
+  //! @brief Size of a ring record (in bytes).
+  LOGGER_ASYNC_RECORD_SIZE = 256,
+  //! @brief Count of records in a ring (must be power of two).
+  LOGGER_ASYNC_RING_CAPACITY = 256,
+  //! @brief Maximum count of records passed to the target at once.
+  LOGGER_ASYNC_BATCH_SIZE = 64,
+  //! @brief Interval in which the background thread writes records (in ms).
+  LOGGER_ASYNC_INTERVAL = 20,
+  //! @brief Maximum length of a format specification.
+  LOGGER_ASYNC_SPEC_SIZE = 64
+};
+
+//! @internal
+//!
+//! @brief Type of argument consumed by a format specification.
+enum LOGGER_ASYNC_ARG
+{
+  //! @brief No argument ("%%" or unsupported specification).
+  LOGGER_ASYNC_ARG_NONE = 0,
+  //! @brief @c int, stored as @c int64_t.
+  LOGGER_ASYNC_ARG_INT = 1,
+  //! @brief @c int64_t.
+  LOGGER_ASYNC_ARG_INT64 = 2,
+  //! @brief @c uint, stored as @c uint64_t.
+  LOGGER_ASYNC_ARG_UINT = 3,
+  //! @brief @c uint64_t.
+  LOGGER_ASYNC_ARG_UINT64 = 4,
+  //! @brief @c double.
+  LOGGER_ASYNC_ARG_DOUBLE = 5,
+  //! @brief @c long @c double, stored as @c double.
+  LOGGER_ASYNC_ARG_LONG_DOUBLE = 6,
+  //! @brief @c char* string, copied.
+  LOGGER_ASYNC_ARG_STRING_A = 7,
+  //! @brief @c CharW* string, copied.
+  LOGGER_ASYNC_ARG_STRING_W = 8,
+  //! @brief Pointer used by "%n", ignored.
+  LOGGER_ASYNC_ARG_POINTER = 9
+};
+
+// ============================================================================
+// [Fog::AsyncLogger - Record]
+// ============================================================================
+
+struct FOG_NO_EXPORT AsyncLoggerRecordHeader
+{
+  //! @brief Time (in microseconds).
+  int64_t time;
+  //! @brief Thread id.
+  uintptr_t threadId;
+
+  //! @brief Class name (static string).
+  const char* where;
+  //! @brief Method name (static string).
+  const char* method;
+  //! @brief Format (static string), identifies the record.
+  const char* fmt;
+
+  //! @brief Severity.
+  uint32_t severity;
+  //! @brief Size of arguments stored in data.
+  uint16_t size;
+  //! @brief Whether the arguments were truncated.
+  uint16_t truncated;
+};
+
+//! @internal
+//!
+//! @brief Record in @ref AsyncLoggerRing.
+//!
+//! Arguments are stored in 8-byte slots in the order they are consumed by the
+//! format. Width and precision given by '*' and numbers are stored in one
+//! slot, strings are stored as a length slot followed by the NULL terminated
+//! string padded to 8 bytes.
+struct FOG_NO_EXPORT AsyncLoggerRecord : public AsyncLoggerRecordHeader
+{
+  uint8_t data[LOGGER_ASYNC_RECORD_SIZE - sizeof(AsyncLoggerRecordHeader)];
+};
+
+// ============================================================================
+// [Fog::AsyncLogger - Ring]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Single-producer single-consumer ring of records.
+//!
+//! The ring is written only by the thread which owns it and read only by the
+//! background thread, so no locking is needed.
+struct FOG_NO_EXPORT AsyncLoggerRing
+{
+  //! @brief Next ring in @ref AsyncLogger::_rings.
+  AsyncLoggerRing* next;
+  //! @brief Id of the thread which owns the ring.
+  uintptr_t threadId;
+
+  //! @brief Position of the next record to read (background thread).
+  uint32_t position;
+  //! @brief Count of dropped records already reported (background thread).
+  size_t droppedReported;
+
+  AtomicPadding4<AsyncLoggerRing*, uintptr_t, uint32_t, size_t> padding0;
+
+  //! @brief Position of the next record to write (written by the owner).
+  Atomic<uint32_t> head;
+  //! @brief Count of dropped records (written by the owner).
+  Atomic<size_t> dropped;
+  //! @brief Whether the owner thread terminated.
+  Atomic<uint32_t> abandoned;
+
+  AtomicPadding3<uint32_t, size_t, uint32_t> padding1;
+
+  //! @brief Position of the first record which can't be overwritten
+  //! (written by the background thread after the record was written).
+  Atomic<uint32_t> tail;
+
+  AtomicPadding1<uint32_t> padding2;
+
+  //! @brief Records.
+  AsyncLoggerRecord records[LOGGER_ASYNC_RING_CAPACITY];
+};
+
+static void FOG_CDECL AsyncLogger_tls_destructor(void* value)
+{
+  AsyncLoggerRing* ring = static_cast<AsyncLoggerRing*>(value);
+
+  if (ring != NULL)
+    ring->abandoned.set(1);
+}
+
+static AsyncLoggerRing* AsyncLogger_getRing(AsyncLogger* self)
+{
+  AsyncLoggerRing* ring = static_cast<AsyncLoggerRing*>(self->_tls.get());
+
+  if (FOG_LIKELY(ring != NULL))
+    return ring;
+
+  ring = static_cast<AsyncLoggerRing*>(MemMgr::alloc(sizeof(AsyncLoggerRing)));
+  if (FOG_IS_NULL(ring))
+    return NULL;
+
+  ring->threadId = Thread::getCurrentThreadId();
+  ring->position = 0;
+  ring->droppedReported = 0;
+  ring->head.init(0);
+  ring->dropped.init(0);
+  ring->abandoned.init(0);
+  ring->tail.init(0);
+
+  if (self->_tls.set(ring) != ERR_OK)
+  {
+    MemMgr::free(ring);
+    return NULL;
+  }
+
+  // Publish the ring, the background thread can see it from now.
+  AsyncLoggerRing* first;
+  do {
+    first = self->_rings.get();
+    ring->next = first;
+  } while (!self->_rings.cmpXchg(first, ring));
+
+  return ring;
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Format Specification]
+// ============================================================================
+
+struct FOG_NO_EXPORT AsyncLoggerSpec
+{
+  //! @brief Argument type, see @ref LOGGER_ASYNC_ARG.
+  uint32_t type;
+  //! @brief Count of width and precision arguments ('*').
+  uint32_t starCount;
+};
+
+// Parse a format specification, fmt points after '%'. Argument sizes are the
+// same as used by StringW::appendVFormat(). Returns the end of the format
+// specification.
+static const char* AsyncLogger_parseSpec(const char* fmt, AsyncLoggerSpec& spec)
+{
+  uint32_t size = 0;
+  bool isLong = false;
+  bool isLongDouble = false;
+
+  spec.type = LOGGER_ASYNC_ARG_NONE;
+  spec.starCount = 0;
+
+  // Flags.
+  while (*fmt == '#' || *fmt == '0' || *fmt == '-' || *fmt == ' ' || *fmt == '+' || *fmt == '\'')
+    fmt++;
+
+  // Width.
+  if (*fmt == '*')
+  {
+    spec.starCount++;
+    fmt++;
+  }
+  else
+  {
+    while (*fmt >= '0' && *fmt <= '9')
+      fmt++;
+  }
+
+  // Precision.
+  if (*fmt == '.')
+  {
+    fmt++;
+
+    if (*fmt == '*')
+    {
+      spec.starCount++;
+      fmt++;
+    }
+    else
+    {
+      while (*fmt >= '0' && *fmt <= '9')
+        fmt++;
+    }
+  }
+
+  // Argument size.
+  switch (*fmt)
+  {
+    case 'h':
+      size = sizeof(short);
+      if (*++fmt == 'h')
+      {
+        size = sizeof(char);
+        fmt++;
+      }
+      break;
+
+    case 'l':
+      isLong = true;
+      size = sizeof(long);
+      if (*++fmt == 'l')
+      {
+        size = sizeof(uint64_t);
+        fmt++;
+      }
+      break;
+
+    case 'L':
+      isLongDouble = true;
+      fmt++;
+      break;
+
+    case 'j':
+    case 'q':
+      size = sizeof(uint64_t);
+      fmt++;
+      break;
+
+    case 't':
+      size = sizeof(ptrdiff_t);
+      fmt++;
+      break;
+
+    case 'z':
+    case 'Z':
+      size = sizeof(size_t);
+      fmt++;
+      break;
+  }
+
+  // Type.
+  switch (*fmt)
+  {
+    case 'd':
+    case 'i':
+      spec.type = (size >= sizeof(int64_t)) ? LOGGER_ASYNC_ARG_INT64 : LOGGER_ASYNC_ARG_INT;
+      break;
+
+    case 'o':
+    case 'X':
+    case 'x':
+    case 'u':
+      spec.type = (size >= sizeof(uint64_t)) ? LOGGER_ASYNC_ARG_UINT64 : LOGGER_ASYNC_ARG_UINT;
+      break;
+
+    case 'p':
+      spec.type = (sizeof(void*) >= sizeof(uint64_t)) ? LOGGER_ASYNC_ARG_UINT64 : LOGGER_ASYNC_ARG_UINT;
+      break;
+
+    case 'F':
+    case 'E':
+    case 'G':
+    case 'f':
+    case 'e':
+    case 'g':
+      spec.type = isLongDouble ? LOGGER_ASYNC_ARG_LONG_DOUBLE : LOGGER_ASYNC_ARG_DOUBLE;
+      break;
+
+    case 'C':
+    case 'c':
+      spec.type = LOGGER_ASYNC_ARG_UINT;
+      break;
+
+    case 'S':
+      spec.type = LOGGER_ASYNC_ARG_STRING_W;
+      break;
+
+    case 's':
+      spec.type = isLong ? LOGGER_ASYNC_ARG_STRING_W : LOGGER_ASYNC_ARG_STRING_A;
+      break;
+
+    case 'n':
+      spec.type = LOGGER_ASYNC_ARG_POINTER;
+      break;
+
+    case '\0':
+      return fmt;
+  }
+
+  return fmt + 1;
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Capture]
+// ============================================================================
+
+static FOG_INLINE bool AsyncLogger_storeSlot(AsyncLoggerRecord* record, uint8_t*& p, uint64_t value)
+{
+  if ((size_t)(record->data + FOG_ARRAY_SIZE(record->data) - p) < sizeof(uint64_t))
+  {
+    record->truncated = 1;
+    return false;
+  }
+
+  MemOps::copy(p, &value, sizeof(uint64_t));
+  p += sizeof(uint64_t);
+  return true;
+}
+
+static bool AsyncLogger_storeString(AsyncLoggerRecord* record, uint8_t*& p, const void* str, size_t length, size_t charSize)
+{
+  size_t remain = (size_t)(record->data + FOG_ARRAY_SIZE(record->data) - p);
+
+  if (remain < sizeof(uint64_t) + charSize)
+  {
+    record->truncated = 1;
+    return false;
+  }
+
+  size_t maxLength = (remain - sizeof(uint64_t)) / charSize - 1;
+  if (length > maxLength)
+  {
+    length = maxLength;
+    record->truncated = 1;
+  }
+
+  AsyncLogger_storeSlot(record, p, (uint64_t)length);
+
+  MemOps::copy(p, str, length * charSize);
+  MemOps::zero(p + length * charSize, charSize);
+
+  p += ((length + 1) * charSize + 7) & ~(size_t)7;
+  return true;
+}
+
+// Copy arguments consumed by fmt into the record.
+static void AsyncLogger_capture(AsyncLoggerRecord* record, const char* fmt, va_list ap)
+{
+  uint8_t* p = record->data;
+  record->truncated = 0;
+
+  for (;;)
+  {
+    char c = *fmt++;
+
+    if (c == '\0')
+      break;
+
+    if (c != '%')
+      continue;
+
+    AsyncLoggerSpec spec;
+    fmt = AsyncLogger_parseSpec(fmt, spec);
+
+    for (uint32_t i = 0; i < spec.starCount; i++)
+    {
+      if (!AsyncLogger_storeSlot(record, p, (uint64_t)(int64_t)va_arg(ap, int)))
+        goto _End;
+    }
+
+    switch (spec.type)
+    {
+      case LOGGER_ASYNC_ARG_NONE:
+        break;
+
+      case LOGGER_ASYNC_ARG_INT:
+        if (!AsyncLogger_storeSlot(record, p, (uint64_t)(int64_t)va_arg(ap, int)))
+          goto _End;
+        break;
+
+      case LOGGER_ASYNC_ARG_INT64:
+        if (!AsyncLogger_storeSlot(record, p, (uint64_t)va_arg(ap, int64_t)))
+          goto _End;
+        break;
+
+      case LOGGER_ASYNC_ARG_UINT:
+        if (!AsyncLogger_storeSlot(record, p, (uint64_t)va_arg(ap, uint)))
+          goto _End;
+        break;
+
+      case LOGGER_ASYNC_ARG_UINT64:
+        if (!AsyncLogger_storeSlot(record, p, va_arg(ap, uint64_t)))
+          goto _End;
+        break;
+
+      case LOGGER_ASYNC_ARG_DOUBLE:
+      case LOGGER_ASYNC_ARG_LONG_DOUBLE:
+      {
+        DoubleBits bits;
+        bits.d = (spec.type == LOGGER_ASYNC_ARG_DOUBLE)
+          ? va_arg(ap, double)
+          : (double)va_arg(ap, long double);
+
+        if (!AsyncLogger_storeSlot(record, p, bits.u64))
+          goto _End;
+        break;
+      }
+
+      case LOGGER_ASYNC_ARG_STRING_A:
+      {
+        const char* str = va_arg(ap, const char*);
+        if (str == NULL)
+          str = "(null)";
+
+        if (!AsyncLogger_storeString(record, p, str, StringUtil::len(str), sizeof(char)))
+          goto _End;
+        break;
+      }
+
+      case LOGGER_ASYNC_ARG_STRING_W:
+      {
+        const CharW* str = va_arg(ap, const CharW*);
+        size_t length = (str != NULL) ? StringUtil::len(str) : 0;
+
+        if (!AsyncLogger_storeString(record, p, str, length, sizeof(CharW)))
+          goto _End;
+        break;
+      }
+
+      case LOGGER_ASYNC_ARG_POINTER:
+        va_arg(ap, void*);
+        break;
+    }
+  }
+
+_End:
+  record->size = (uint16_t)(size_t)(p - record->data);
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Format]
+// ============================================================================
+
+static FOG_INLINE bool AsyncLogger_loadSlot(const uint8_t*& p, const uint8_t* pEnd, uint64_t& value)
+{
+  if ((size_t)(pEnd - p) < sizeof(uint64_t))
+    return false;
+
+  MemOps::copy(&value, p, sizeof(uint64_t));
+  p += sizeof(uint64_t);
+  return true;
+}
+
+// Copy the format specification to dst, width and precision given by '*' are
+// replaced by the stored numbers.
+static bool AsyncLogger_buildSpec(char* dst, const char* spec, const char* specEnd, const uint8_t*& p, const uint8_t* pEnd)
+{
+  // Reserve space for a number and the NULL terminator.
+  char* dstEnd = dst + LOGGER_ASYNC_SPEC_SIZE - 8;
+
+  while (spec != specEnd)
+  {
+    if (dst >= dstEnd)
+      return false;
+
+    char c = *spec++;
+    if (c != '*')
+    {
+      *dst++ = c;
+      continue;
+    }
+
+    uint64_t value;
+    if (!AsyncLogger_loadSlot(p, pEnd, value))
+      return false;
+
+    // Clamped the same way as StringW::appendVFormat() does.
+    int n = (int)(int64_t)value;
+    if (n < 0) n = 0;
+    if (n > 4096) n = 4096;
+
+    char digits[8];
+    int i = 0;
+
+    do {
+      digits[i++] = (char)('0' + n % 10);
+      n /= 10;
+    } while (n != 0);
+
+    while (i > 0)
+      *dst++ = digits[--i];
+  }
+
+  *dst = '\0';
+  return true;
+}
+
+static void AsyncLogger_format(StringW& dst, const AsyncLoggerRecord* record)
+{
+  Logger_buildPrefix(dst, record->where, record->method);
+
+  const uint8_t* p = record->data;
+  const uint8_t* pEnd = record->data + record->size;
+
+  const char* fmt = record->fmt;
+  const char* chunk = fmt;
+
+  char specBuf[LOGGER_ASYNC_SPEC_SIZE];
+
+  while (*fmt != '\0')
+  {
+    if (*fmt != '%')
+    {
+      fmt++;
+      continue;
+    }
+
+    const char* specBegin = fmt;
+
+    AsyncLoggerSpec spec;
+    fmt = AsyncLogger_parseSpec(fmt + 1, spec);
+
+    // "%%" and unsupported specifications are formatted with the text.
+    if (spec.type == LOGGER_ASYNC_ARG_NONE && spec.starCount == 0)
+      continue;
+
+    if (chunk != specBegin)
+      dst.appendFormat(Ascii8(chunk, (size_t)(specBegin - chunk)));
+    chunk = fmt;
+
+    if (!AsyncLogger_buildSpec(specBuf, specBegin, fmt, p, pEnd))
+      goto _Truncated;
+
+    uint64_t value;
+
+    switch (spec.type)
+    {
+      case LOGGER_ASYNC_ARG_NONE:
+      case LOGGER_ASYNC_ARG_POINTER:
+        break;
+
+      case LOGGER_ASYNC_ARG_INT:
+        if (!AsyncLogger_loadSlot(p, pEnd, value))
+          goto _Truncated;
+        dst.appendFormat(specBuf, (int)(int64_t)value);
+        break;
+
+      case LOGGER_ASYNC_ARG_INT64:
+        if (!AsyncLogger_loadSlot(p, pEnd, value))
+          goto _Truncated;
+        dst.appendFormat(specBuf, (int64_t)value);
+        break;
+
+      case LOGGER_ASYNC_ARG_UINT:
+        if (!AsyncLogger_loadSlot(p, pEnd, value))
+          goto _Truncated;
+        dst.appendFormat(specBuf, (uint)value);
+        break;
+
+      case LOGGER_ASYNC_ARG_UINT64:
+        if (!AsyncLogger_loadSlot(p, pEnd, value))
+          goto _Truncated;
+        dst.appendFormat(specBuf, value);
+        break;
+
+      case LOGGER_ASYNC_ARG_DOUBLE:
+      case LOGGER_ASYNC_ARG_LONG_DOUBLE:
+      {
+        DoubleBits bits;
+        if (!AsyncLogger_loadSlot(p, pEnd, bits.u64))
+          goto _Truncated;
+        dst.appendFormat(specBuf, bits.d);
+        break;
+      }
+
+      case LOGGER_ASYNC_ARG_STRING_A:
+      case LOGGER_ASYNC_ARG_STRING_W:
+      {
+        size_t charSize = (spec.type == LOGGER_ASYNC_ARG_STRING_A) ? sizeof(char) : sizeof(CharW);
+        if (!AsyncLogger_loadSlot(p, pEnd, value))
+          goto _Truncated;
+
+        const uint8_t* str = p;
+        p += (((size_t)value + 1) * charSize + 7) & ~(size_t)7;
+
+        if (charSize == sizeof(char))
+          dst.appendFormat(specBuf, reinterpret_cast<const char*>(str));
+        else
+          dst.appendFormat(specBuf, reinterpret_cast<const CharW*>(str));
+        break;
+      }
+    }
+  }
+
+  if (chunk != fmt)
+    dst.appendFormat(Ascii8(chunk, (size_t)(fmt - chunk)));
+
+  if (!record->truncated)
+    return;
+
+_Truncated:
+  dst.append(Ascii8("..."));
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Background Thread]
+// ============================================================================
+
+static void AsyncLogger_releaseAbandoned(AsyncLogger* self)
+{
+  // Producers may walk the rings in flush(), don't free them meanwhile.
+  AutoLock locked(self->_ringsLock);
+
+  AsyncLoggerRing* prev = NULL;
+  AsyncLoggerRing* ring = self->_rings.get();
+
+  while (ring != NULL)
+  {
+    AsyncLoggerRing* next = ring->next;
+
+    if (ring->abandoned.get() == 0 ||
+        ring->position != ring->head.get() ||
+        ring->droppedReported != ring->dropped.get())
+    {
+      prev = ring;
+      ring = next;
+      continue;
+    }
+
+    if (prev != NULL)
+    {
+      prev->next = next;
+    }
+    else if (!self->_rings.cmpXchg(ring, next))
+    {
+      // Another ring was published meanwhile, it's now before the released one.
+      prev = self->_rings.get();
+      while (prev->next != ring)
+        prev = prev->next;
+      prev->next = next;
+    }
+
+    MemMgr::free(ring);
+    ring = next;
+  }
+}
+
+static void AsyncLogger_drain(AsyncLogger* self)
+{
+  LoggerRecord batch[LOGGER_ASYNC_BATCH_SIZE];
+  AsyncLoggerRing* ring;
+
+  for (;;)
+  {
+    size_t count = 0;
+
+    // Merge records of all rings, ordered by time.
+    while (count < LOGGER_ASYNC_BATCH_SIZE)
+    {
+      AsyncLoggerRing* oldestRing = NULL;
+      const AsyncLoggerRecord* oldest = NULL;
+
+      for (ring = self->_rings.get(); ring != NULL; ring = ring->next)
+      {
+        if (ring->position == ring->head.get())
+          continue;
+
+        const AsyncLoggerRecord* record = &ring->records[ring->position & (LOGGER_ASYNC_RING_CAPACITY - 1)];
+        if (oldest == NULL || record->time < oldest->time)
+        {
+          oldestRing = ring;
+          oldest = record;
+        }
+      }
+
+      if (oldest == NULL)
+        break;
+
+      StringW message;
+      AsyncLogger_format(message, oldest);
+
+      batch[count++] = LoggerRecord(Time(oldest->time), oldest->threadId, oldest->severity, message);
+      oldestRing->position++;
+    }
+
+    // Report dropped records.
+    for (ring = self->_rings.get(); ring != NULL && count < LOGGER_ASYNC_BATCH_SIZE; ring = ring->next)
+    {
+      size_t dropped = ring->dropped.get();
+      if (dropped == ring->droppedReported)
+        continue;
+
+      StringW message;
+      message.appendFormat("Fog::AsyncLogger - %llu records dropped, the ring was full.",
+        (uint64_t)(dropped - ring->droppedReported));
+
+      batch[count++] = LoggerRecord(Time::now(), ring->threadId, LOGGER_SEVERITY_WARNING, message);
+      ring->droppedReported = dropped;
+    }
+
+    if (count == 0)
+      break;
+
+    self->_target->emitRecords(batch, count);
+
+    // Records are written, the producers can reuse them. The tail is released
+    // by a full barrier, the ring has a single consumer so it never fails.
+    for (ring = self->_rings.get(); ring != NULL; ring = ring->next)
+      ring->tail.cmpXchg(ring->tail.get(), ring->position);
+  }
+
+  AsyncLogger_releaseAbandoned(self);
+}
+
+struct FOG_NO_EXPORT AsyncLoggerThread : public Thread
+{
+  AsyncLoggerThread(AsyncLogger* logger);
+  virtual void main();
+
+  AsyncLogger* _logger;
+};
+
+AsyncLoggerThread::AsyncLoggerThread(AsyncLogger* logger) :
+  _logger(logger)
+{
+}
+
+void AsyncLoggerThread::main()
+{
+  // Startup without an event loop.
+  Thread::main();
+
+  for (;;)
+  {
+    _logger->_event.wait(TimeDelta::fromMilliseconds(LOGGER_ASYNC_INTERVAL));
+
+    bool quit = _logger->_quit.get() != 0;
+    AsyncLogger_drain(_logger);
+
+    if (quit)
+      break;
+  }
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Construction / Destruction]
+// ============================================================================
+
+AsyncLogger::AsyncLogger(Logger* target) :
+  _target(target->addRef()),
+  _thread(NULL)
+{
+  _type = LOGGER_TYPE_ASYNC;
+  _severity = target->getSeverity();
+
+  _rings.init(NULL);
+  _droppedCount.init(0);
+  _quit.init(0);
+
+  _tls.create(AsyncLogger_tls_destructor);
+
+  AsyncLoggerThread* thread = fog_new AsyncLoggerThread(this);
+  if (thread != NULL && thread->start(StringW()))
+    _thread = thread;
+  else if (thread != NULL)
+    fog_delete(thread);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+  if (_thread != NULL)
+  {
+    _quit.set(1);
+    _event.signal();
+
+    // Joins the thread, all records are written at this point.
+    fog_delete(_thread);
+  }
+
+  _tls.destroy();
+
+  AsyncLoggerRing* ring = _rings.get();
+  while (ring != NULL)
+  {
+    AsyncLoggerRing* next = ring->next;
+    MemMgr::free(ring);
+    ring = next;
+  }
+
+  _target->release();
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Log]
+// ============================================================================
+
+void AsyncLogger::logVFormat(uint32_t severity, const char* where, const char* method, const char* fmt, va_list ap)
+{
+  if (severity < _severity)
+    return;
+
+  AsyncLoggerRing* ring = (_thread != NULL) ? AsyncLogger_getRing(this) : NULL;
+
+  if (FOG_IS_NULL(ring))
+  {
+    // The background thread or the ring can't be created, log synchronously.
+    _target->logVFormat(severity, where, method, fmt, ap);
+    return;
+  }
+
+  uint32_t head = ring->head.get();
+  uint32_t used = head - ring->tail.get();
+
+  if (used >= (uint32_t)LOGGER_ASYNC_RING_CAPACITY)
+  {
+    ring->dropped.set(ring->dropped.get() + 1);
+    _droppedCount.inc();
+    return;
+  }
+
+  AsyncLoggerRecord* record = &ring->records[head & (LOGGER_ASYNC_RING_CAPACITY - 1)];
+
+  record->time = Time::now().getValue();
+  record->threadId = ring->threadId;
+  record->where = where;
+  record->method = method;
+  record->fmt = fmt;
+  record->severity = severity;
+  AsyncLogger_capture(record, fmt, ap);
+
+  // Publish the record. Atomic::set() doesn't guarantee release semantics,
+  // so a full barrier is used. The ring has a single producer, it never fails.
+  ring->head.cmpXchg(head, head + 1);
+
+  // Wake-up the background thread if the ring is getting full or the record
+  // is important, otherwise the records are written periodically.
+  if (severity >= LOGGER_SEVERITY_ERROR || used + 1 == (uint32_t)LOGGER_ASYNC_RING_CAPACITY / 2)
+    _event.signal();
+
+  // The application is likely to terminate.
+  if (severity >= LOGGER_SEVERITY_FATAL)
+    flush();
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Emit]
+// ============================================================================
+
+void AsyncLogger::emitRecord(const LoggerRecord& record)
+{
+  logFormat(record.getSeverity(), NULL, NULL, "%S", record.getMessage().getData());
+}
+
+// ============================================================================
+// [Fog::AsyncLogger - Flush]
+// ============================================================================
+
+void AsyncLogger::flush()
+{
+  // Records logged by the background thread are written after it returns.
+  if (_thread == NULL || Thread::getCurrentThreadId() == _thread->getId())
+    return;
+
+  for (;;)
+  {
+    bool pending = false;
+
+    {
+      // Abandoned rings are released by the background thread.
+      AutoLock locked(_ringsLock);
+
+      for (AsyncLoggerRing* ring = _rings.get(); ring != NULL; ring = ring->next)
+      {
+        if (ring->tail.get() != ring->head.get())
+        {
+          pending = true;
+          break;
+        }
+      }
+    }
+
+    if (!pending)
+      break;
+
+    _event.signal();
+    Thread::sleep(1);
+  }
 }
 
 // ============================================================================
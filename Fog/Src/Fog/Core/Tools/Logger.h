@@ -10,6 +10,9 @@
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
 #include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Threading/ThreadLocal.h>
 #include <Fog/Core/Tools/Char.h>
 #include <Fog/Core/Tools/Stream.h>
 #include <Fog/Core/Tools/String.h>
@@ -105,7 +108,7 @@ struct FOG_API Logger
   // --------------------------------------------------------------------------
 
   void logFormat(uint32_t severity, const char* where, const char* method, const char* fmt, ...);
-  void logVFormat(uint32_t severity, const char* where, const char* method, const char* fmt, va_list ap);
+  virtual void logVFormat(uint32_t severity, const char* where, const char* method, const char* fmt, va_list ap);
 
   // --------------------------------------------------------------------------
   // [Emit]
@@ -113,6 +116,10 @@ struct FOG_API Logger
 
   virtual void emitRecord(const LoggerRecord& record);
 
+  //! @brief Emit @a count records at once, by default it calls
+  //! @ref emitRecord() for each record.
+  virtual void emitRecords(const LoggerRecord* records, size_t count);
+
   // --------------------------------------------------------------------------
   // [Statics - Instance]
   // --------------------------------------------------------------------------
@@ -179,6 +186,7 @@ struct FOG_API StreamLogger : public Logger
   // --------------------------------------------------------------------------
 
   virtual void emitRecord(const LoggerRecord& record);
+  virtual void emitRecords(const LoggerRecord* records, size_t count);
 
   // --------------------------------------------------------------------------
   // [Members]
@@ -190,6 +198,93 @@ private:
   FOG_NO_COPY(StreamLogger)
 };
 
+// ============================================================================
+// [Fog::AsyncLogger]
+// ============================================================================
+
+struct AsyncLoggerRing;
+
+//! @brief Asynchronous logger.
+//!
+//! Logging threads don't format messages, they only copy the arguments into
+//! fixed-size records in their own lock-free ring buffers. The records are
+//! formatted and passed in batches to the target logger (typically
+//! @ref StreamLogger) by a background thread, so the only cost paid by the
+//! logging thread is copying a few bytes.
+//!
+//! The @c where, @c method and @c fmt arguments are stored as pointers, they
+//! must be static strings (string literals). String arguments are copied, but
+//! truncated if they don't fit into the record. If the ring of a thread is
+//! full, the record is dropped and counted, the count of dropped records is
+//! reported by the background thread.
+struct FOG_API AsyncLogger : public Logger
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  AsyncLogger(Logger* target);
+  virtual ~AsyncLogger();
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE Logger* getTarget() const { return _target; }
+
+  //! @brief Get count of records dropped, because the ring was full.
+  FOG_INLINE size_t getDroppedCount() const { return _droppedCount.get(); }
+
+  // --------------------------------------------------------------------------
+  // [Log]
+  // --------------------------------------------------------------------------
+
+  virtual void logVFormat(uint32_t severity, const char* where, const char* method, const char* fmt, va_list ap);
+
+  // --------------------------------------------------------------------------
+  // [Emit]
+  // --------------------------------------------------------------------------
+
+  //! @brief Queue the record, the message is truncated if it doesn't fit into
+  //! the ring record.
+  virtual void emitRecord(const LoggerRecord& record);
+
+  // --------------------------------------------------------------------------
+  // [Flush]
+  // --------------------------------------------------------------------------
+
+  //! @brief Wait until all queued records are written to the target.
+  void flush();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Target logger.
+  Logger* _target;
+  //! @brief Background thread.
+  Thread* _thread;
+
+  //! @brief Rings (one per logging thread).
+  Atomic<AsyncLoggerRing*> _rings;
+  //! @brief Lock held while the rings are walked by @ref flush() or released
+  //! by the background thread.
+  Lock _ringsLock;
+  //! @brief Ring of the current thread.
+  ThreadLocal _tls;
+
+  //! @brief Event used to wake-up the background thread.
+  ThreadEvent _event;
+
+  //! @brief Count of dropped records.
+  Atomic<size_t> _droppedCount;
+  //! @brief Whether the background thread should quit.
+  Atomic<uint32_t> _quit;
+
+private:
+  FOG_NO_COPY(AsyncLogger)
+};
+
 //! @}
 
 } // Fog namespace
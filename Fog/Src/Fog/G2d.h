@@ -128,6 +128,7 @@
 #include <Fog/G2d/Painting/PaintDeviceInfo.h>
 #include <Fog/G2d/Painting/PaintEngine.h>
 #include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Painting/PaintStatistics.h>
 #include <Fog/G2d/Painting/PaintUtil.h>
 #include <Fog/G2d/Painting/Painter.h>
 
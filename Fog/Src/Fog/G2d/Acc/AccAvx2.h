@@ -0,0 +1,47 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_ACC_ACCAVX2_H
+#define _FOG_G2D_ACC_ACCAVX2_H
+
+// [Dependencies]
+#include <Fog/Core/Acc/AccAvx2.h>
+
+namespace Fog {
+namespace Acc {
+
+//! @addtogroup Fog_G2d_Acc_Avx2
+//! @{
+
+// ============================================================================
+// [Fog::Acc::AVX2 - Raster - Alpha]
+// ============================================================================
+
+//! @brief Expand the alpha bytes of ARGB32 pixels in @a x0 to the 16-bit
+//! integers of the lo/hi unpacked pixels (per 128-bit lane).
+static FOG_INLINE void m256iUnpackAlphaPI16FromARGB32_PI8(__m256i& dst0, __m256i& dst1, const __m256i& x0)
+{
+  const __m256i lo = _mm256_setr_epi8(
+     3, -1,  3, -1,  3, -1,  3, -1,  7, -1,  7, -1,  7, -1,  7, -1,
+     3, -1,  3, -1,  3, -1,  3, -1,  7, -1,  7, -1,  7, -1,  7, -1);
+  const __m256i hi = _mm256_setr_epi8(
+    11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1,
+    11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1);
+
+  __m256i t0 = _mm256_shuffle_epi8(x0, lo);
+  __m256i t1 = _mm256_shuffle_epi8(x0, hi);
+
+  dst0 = t0;
+  dst1 = t1;
+}
+
+//! @}
+
+} // Acc namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_ACC_ACCAVX2_H
@@ -97,7 +97,7 @@ static err_t FOG_CDECL Image_Buffer_create(ImageData** pd, const SizeI* size, ui
   d->adopted = 0;
   d->colorKey = IMAGE_COLOR_KEY_NONE;
   d->bytesPerPixel = desc.getBytesPerPixel();
-  FOG_PADDING_ZERO_64(d->padding);
+  d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
 
   d->stride = stride;
   d->data = (uint8_t*)( ((size_t)d + sizeof(ImageData) + 15) & ~(size_t)15 );
@@ -165,6 +165,25 @@ static void FOG_CDECL Image_dtor(Image* self)
 // [Fog::Image - Sharing]
 // ============================================================================
 
+//! @internal
+//!
+//! @brief Copy pixels of @a src to @a dst (same size and format).
+//!
+//! The cached alpha distribution is copied too, the pixels are the same.
+static void Image_copyPixels(ImageData* dst, const ImageData* src)
+{
+  uint8_t* dPixels = dst->first;
+  const uint8_t* sPixels = src->first;
+
+  size_t bpl = (size_t)src->size.w * src->bytesPerPixel;
+
+  for (int y = src->size.h; y; y--, dPixels += dst->stride, sPixels += src->stride)
+    MemOps::copy(dPixels, sPixels, bpl);
+
+  if (src->locked == 0)
+    dst->alphaDistribution = src->alphaDistribution;
+}
+
 static err_t FOG_CDECL Image_detach(Image* self)
 {
   ImageData* d = self->_d;
@@ -187,10 +206,7 @@ static err_t FOG_CDECL Image_detach(Image* self)
   newd->colorKey = d->colorKey;
   newd->palette->setData(d->palette);
 
-  _api_raster.getCopyRectFunc(newd->format)(
-    newd->first, newd->stride,
-    d->first, d->stride,
-    newd->size.w, newd->size.h, NULL);
+  Image_copyPixels(newd, d);
 
   atomicPtrXchg(&self->_d, newd)->release();
   return ERR_OK;
@@ -328,7 +344,7 @@ static err_t FOG_CDECL Image_adopt(Image* self, const ImageBits* imageBits, uint
     d->adopted = 1;
     d->colorKey = IMAGE_COLOR_KEY_NONE;
     d->bytesPerPixel = desc.getBytesPerPixel();
-    FOG_PADDING_ZERO_64(d->padding);
+    d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
 
     d->palette.init();
     atomicPtrXchg(&self->_d, d)->release();
@@ -360,6 +376,10 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
 {
   ImageData* d = self->_d;
 
+  uint32_t result = d->alphaDistribution;
+  if (result != ALPHA_DISTRIBUTION_UNKNOWN)
+    return result;
+
   ColorAnalyzer::AnalyzerFunc analyzer = NULL;
   int aPos = 0;
   int inc = 0;
@@ -375,7 +395,7 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
       break;
 
     case IMAGE_FORMAT_PRGB64:
-      analyzer = ColorAnalyzer::analyzeAlpha64; aPos = PIXEL_ARGB64_WORD_A; inc = 8;
+      analyzer = ColorAnalyzer::analyzeAlpha64; aPos = PIXEL_ARGB64_WORD_A * 2; inc = 8;
       break;
 
     case IMAGE_FORMAT_A16:
@@ -384,9 +404,16 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
   }
 
   if (analyzer != NULL)
-    return analyzer(d->first, d->stride, d->size.w, d->size.h, aPos, inc);
+    result = analyzer(d->first, d->stride, d->size.w, d->size.h, aPos, inc);
   else
-    return ALPHA_DISTRIBUTION_FULL;
+    result = ALPHA_DISTRIBUTION_FULL;
+
+  // Don't cache the result if the image is being painted, the paint-engine
+  // doesn't notify about each change it does.
+  if (d->locked == 0)
+    d->alphaDistribution = result;
+
+  return result;
 }
 
 // ============================================================================
@@ -395,7 +422,7 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
 
 static void FOG_CDECL Image_modified(Image* self)
 {
-  // TODO:
+  self->_d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
 }
 
 // ============================================================================
@@ -445,17 +472,11 @@ static err_t FOG_CDECL Image_copyDeep(Image* self, const Image* other)
   FOG_RETURN_ON_ERROR(self->create(d->size, d->format, IMAGE_TYPE_BUFFER));
 
   ImageData* newd = self->_d;
-  _api_raster.getCopyRectFunc(newd->format)(
-    newd->first, newd->stride,
-    d->first, d->stride,
-    d->size.w, d->size.h, NULL);
+  Image_copyPixels(newd, d);
 
   newd->colorKey = d->colorKey;
   newd->palette->setData(d->palette);
 
-  atomicPtrXchg(&self->_d, newd)->release();
-
-  self->_modified();
   return ERR_OK;
 }
 
@@ -569,6 +590,7 @@ static err_t FOG_CDECL Image_convert(Image* self, uint32_t format)
       blitLine(dstCur, dstCur, w, &closure);
 
     d->format = targetFormat;
+    self->_modified();
     return ERR_OK;
   }
   else
@@ -1009,6 +1031,7 @@ static err_t Image_fillRectPrivate(Image* self, const RectI* r, uint32_t composi
     }
   }
 
+  self->_modified();
   return ERR_OK;
 }
 
@@ -1184,6 +1207,20 @@ static err_t Image_blitImagePrivate(
       FOG_ASSERT_NOT_REACHED();
   }
 
+  // SRC_OVER of a fully-opaque source is SRC, fully-transparent is NOP.
+  if (compositingOperator == COMPOSITE_SRC_OVER && sFormat == IMAGE_FORMAT_PRGB32)
+  {
+    switch (src->getAlphaDistribution())
+    {
+      case ALPHA_DISTRIBUTION_ZERO:
+        return ERR_OK;
+
+      case ALPHA_DISTRIBUTION_FULL:
+        compositingOperator = COMPOSITE_SRC;
+        break;
+    }
+  }
+
   if (!dst_d->isDetached())
   {
     FOG_RETURN_ON_ERROR(dst->_detach());
@@ -1330,6 +1367,7 @@ static err_t Image_blitImagePrivate(
     }
   }
 
+  dst->_modified();
   return ERR_OK;
 }
 
@@ -1482,6 +1520,7 @@ static err_t FOG_CDECL Image_scroll(Image* self, const PointI* pt, const RectI*
     MemOps::move(dstPixels, srcPixels, size);
   }
 
+  self->_modified();
   return ERR_OK;
 }
 
@@ -1586,7 +1625,11 @@ static err_t FOG_CDECL Image_writeToBuffer(const Image* self, StringA* buffer, u
   if (cntOp != CONTAINER_OP_REPLACE)
     stream.seek(buffer->getLength(), STREAM_SEEK_SET);
 
-  return fog_api.image_writeToStream(self, &stream, ext, options);
+  // The stream works on its own copy of the buffer, store the result back.
+  FOG_RETURN_ON_ERROR(fog_api.image_writeToStream(self, &stream, ext, options));
+
+  *buffer = stream.getBuffer();
+  return ERR_OK;
 }
 
 // ============================================================================
@@ -2740,6 +2783,7 @@ FOG_NO_EXPORT void Image_init(void)
   d->adopted = 0;
   d->colorKey = IMAGE_COLOR_KEY_NONE;
   d->bytesPerPixel = 0;
+  d->alphaDistribution = ALPHA_DISTRIBUTION_ZERO;
   d->palette.initCustom1(fog_api.imagepalette_oEmpty->_d);
 
   fog_api.image_oEmpty = Image_oEmpty.initCustom1(d);
@@ -147,9 +147,11 @@ struct FOG_NO_EXPORT ImageData
     uint32_t packedProperties;
   };
 
-#if FOG_ARCH_BITS >= 64
-  uint32_t padding;
-#endif // FOG_ARCH_BITS >= 64
+  //! @brief Cached alpha distribution, see @c ALPHA_DISTRIBUTION.
+  //!
+  //! Set to @c ALPHA_DISTRIBUTION_UNKNOWN when the image is created or
+  //! modified, analyzed lazily by @c Image::getAlphaDistribution().
+  uint32_t alphaDistribution;
 
   //! @brief Image stride.
   ssize_t stride;
@@ -305,6 +307,7 @@ struct FOG_NO_EXPORT Image
     FOG_ASSERT_X(isDetached(),
       "Fog::Image::getDataX() - Not detached.");
 
+    _d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
     return _d->data;
   }
 
@@ -322,6 +325,7 @@ struct FOG_NO_EXPORT Image
     FOG_ASSERT_X(isDetached(),
       "Fog::Image::getFirstX() - Not detached.");
 
+    _d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
     return _d->first;
   }
 
@@ -344,10 +348,15 @@ struct FOG_NO_EXPORT Image
     FOG_ASSERT_X(isDetached(),
       "Fog::Image::getScanlineX() - Not detached.");
 
+    _d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
     return _d->first + (ssize_t)y * _d->stride;
   }
 
-  //! @brief Get the alpha distribution.
+  //! @brief Get the alpha distribution, see @c ALPHA_DISTRIBUTION.
+  //!
+  //! The result is cached by the image data and discarded by @c _modified()
+  //! or when a mutable pointer to the pixels is requested. Code writing to a
+  //! pointer obtained earlier must call @c _modified() when done.
   FOG_INLINE uint32_t getAlphaDistribution() const
   {
     return fog_api.image_getAlphaDistribution(this);
@@ -10,10 +10,12 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Math/Math.h>
 #include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/G2d/Imaging/ImageConverter.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterUtil_p.h>
 
 namespace Fog {
 
@@ -248,33 +250,23 @@ static void FOG_CDECL ImageConverter_blitLine(const ImageConverter* self,
   d->blitFn(reinterpret_cast<uint8_t*>(dst), reinterpret_cast<const uint8_t*>(src), w, &closure);
 }
 
-static void FOG_CDECL ImageConverter_blitRect(const ImageConverter* self,
-  void* dst, size_t dstStride,
-  const void* src, size_t srcStride,
-  int w, int h, const PointI* ditherOrigin)
+static void ImageConverter_blitBand(ImageConverterData* d,
+  uint8_t* dPtr, size_t dstStride,
+  const uint8_t* sPtr, size_t srcStride,
+  int w, int y, int yEnd, const PointI& ditherOrigin)
 {
-  ImageConverterData* d = self->_d;
-  if (d == &ImageConverter_dNull)
-    return;
-
   ImageConverterClosure closure;
-  if (ditherOrigin == NULL)
-    closure.ditherOrigin.reset();
-  else
-    closure.ditherOrigin.set(*ditherOrigin);
+  closure.ditherOrigin = ditherOrigin;
   closure.data = d;
 
   closure.palette = d->srcPalette->_d;
   closure.colorKey = 0xFFFFFFFF; // TODO: ColorKey should be part if image converter.
 
-  uint8_t* dPtr = reinterpret_cast<uint8_t*>(dst);
-  const uint8_t* sPtr = reinterpret_cast<const uint8_t*>(src);
-
   ImageConverterBlitLineFunc blitLine = d->blitFn;
 
-  for (int y = 0; y < h; y++)
+  for (; y < yEnd; y++)
   {
-    closure.ditherOrigin.y = y;
+    closure.ditherOrigin.y = ditherOrigin.y + y;
     blitLine(dPtr, sPtr, w, &closure);
 
     dPtr += dstStride;
@@ -282,6 +274,75 @@ static void FOG_CDECL ImageConverter_blitRect(const ImageConverter* self,
   }
 }
 
+// ============================================================================
+// [Fog::ImageConverter - Blit - Multithreaded]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Data of multithreaded @c blitRect(), see @c RasterUtil::doBandsMT().
+struct FOG_NO_EXPORT ImageConverterBlitData
+{
+  ImageConverterData* d;
+  uint8_t* dst;
+  const uint8_t* src;
+  size_t dstStride;
+  size_t srcStride;
+  int w;
+  PointI ditherOrigin;
+};
+
+static void FOG_FASTCALL ImageConverter_blitBandMT(void* data, int y, int yEnd)
+{
+  const ImageConverterBlitData* b = static_cast<const ImageConverterBlitData*>(data);
+
+  ImageConverter_blitBand(b->d,
+    b->dst + (ssize_t)y * (ssize_t)b->dstStride, b->dstStride,
+    b->src + (ssize_t)y * (ssize_t)b->srcStride, b->srcStride,
+    b->w, y, yEnd, b->ditherOrigin);
+}
+
+static bool ImageConverter_blitRectMT(ImageConverterData* d,
+  uint8_t* dst, size_t dstStride,
+  const uint8_t* src, size_t srcStride,
+  int w, int h, const PointI& ditherOrigin)
+{
+  ImageConverterBlitData data;
+  data.d = d;
+  data.dst = dst;
+  data.src = src;
+  data.dstStride = dstStride;
+  data.srcStride = srcStride;
+  data.w = w;
+  data.ditherOrigin = ditherOrigin;
+
+  return RasterUtil::doBandsMT(ImageConverter_blitBandMT, &data, w, h,
+    RASTER_CONVERT_MT_THRESHOLD, RASTER_CONVERT_MT_MIN_ROWS);
+}
+
+static void FOG_CDECL ImageConverter_blitRect(const ImageConverter* self,
+  void* dst, size_t dstStride,
+  const void* src, size_t srcStride,
+  int w, int h, const PointI* ditherOrigin)
+{
+  ImageConverterData* d = self->_d;
+  if (d == &ImageConverter_dNull || w <= 0 || h <= 0)
+    return;
+
+  PointI origin(0, 0);
+  if (ditherOrigin != NULL)
+    origin = *ditherOrigin;
+
+  uint8_t* dPtr = reinterpret_cast<uint8_t*>(dst);
+  const uint8_t* sPtr = reinterpret_cast<const uint8_t*>(src);
+
+  // Large rectangles are converted in parallel, split into horizontal bands.
+  if (ImageConverter_blitRectMT(d, dPtr, dstStride, sPtr, srcStride, w, h, origin))
+    return;
+
+  ImageConverter_blitBand(d, dPtr, dstStride, sPtr, srcStride, w, 0, h, origin);
+}
+
 // ============================================================================
 // [Fog::ImageConverter - ImageConverterData]
 // ============================================================================
@@ -344,9 +344,9 @@ static err_t FOG_CDECL ImageFormatDescription_createArgb(
   0, \
   0, \
   _AlignedComponents_, \
-  0, \
   _FillUnusedBits_, \
   (_ASize_ > 8) || (_RSize_ > 8) || (_GSize_ > 8) || (_BSize_ > 8), \
+  0, \
   \
   _APos_, \
   _RPos_, \
@@ -166,7 +166,7 @@ static err_t FOG_CDECL Image_WinDib_create(ImageData** pd, const SizeI* size, ui
   d->adopted = 0;
   d->colorKey = IMAGE_COLOR_KEY_NONE;
   d->bytesPerPixel = desc.getBytesPerPixel();
-  FOG_PADDING_ZERO_64(d->padding);
+  d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
 
   d->data = bits;
   d->first = bits;
@@ -0,0 +1,100 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_PAINTSTATISTICS_H
+#define _FOG_G2D_PAINTING_PAINTSTATISTICS_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemOps.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::PaintStatistics]
+// ============================================================================
+
+//! @brief Counters and timings collected by the paint-engine.
+//!
+//! Statistics are collected only if Fog was built with
+//! @c FOG_BUILD_PAINT_STATISTICS, otherwise @ref Painter::getStatistics()
+//! returns @c ERR_RT_NOT_IMPLEMENTED and the paint-engine doesn't contain any
+//! code related to statistics.
+//!
+//! Timings are in CPU cycles (time-stamp counter) if available, otherwise in
+//! high-precision ticks. Nested operations are timed only once, for example
+//! filling a box which is converted into an aligned box.
+struct FOG_NO_EXPORT PaintStatistics
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE PaintStatistics()
+  {
+    reset();
+  }
+
+  explicit FOG_INLINE PaintStatistics(_Uninitialized) {}
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get count of all executed commands.
+  FOG_INLINE uint64_t getCmdCount() const
+  {
+    uint64_t count = 0;
+    for (uint i = 0; i < PAINT_STATISTICS_CMD_COUNT; i++)
+      count += cmdCount[i];
+    return count;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    MemOps::zero(this, sizeof(PaintStatistics));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Count of commands, see @c PAINT_STATISTICS_CMD.
+  uint64_t cmdCount[PAINT_STATISTICS_CMD_COUNT];
+  //! @brief Count of fill and blit commands per compositing operator.
+  uint64_t opCount[COMPOSITE_COUNT];
+  //! @brief Count of fill commands per source type, see @c PATTERN_TYPE.
+  uint64_t sourceCount[PAINT_STATISTICS_SOURCE_COUNT];
+  //! @brief Count of fill, blit and filter commands per clip type, see
+  //! @c PAINT_STATISTICS_CLIP.
+  uint64_t clipCount[PAINT_STATISTICS_CLIP_COUNT];
+
+  //! @brief Count of composited pixels.
+  uint64_t pixelCount;
+  //! @brief Count of composited spans.
+  uint64_t spanCount;
+  //! @brief Count of cells produced by the path rasterizer.
+  uint64_t cellCount;
+
+  //! @brief Count of timed operations, see @c PAINT_STATISTICS_TIME.
+  uint64_t timeCount[PAINT_STATISTICS_TIME_COUNT];
+  //! @brief Time spent by timed operations, see @c PAINT_STATISTICS_TIME.
+  uint64_t timeCycles[PAINT_STATISTICS_TIME_COUNT];
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_PAINTSTATISTICS_H
@@ -16,6 +16,7 @@ namespace Fog {
 
 FOG_NO_EXPORT void NullPaintEngine_init(void);
 FOG_NO_EXPORT void RasterPaintEngine_init(void);
+FOG_NO_EXPORT void RasterPaintEngine_fini(void);
 
 // ============================================================================
 // [Init / Fini]
@@ -27,4 +28,9 @@ FOG_NO_EXPORT void Painter_init(void)
   RasterPaintEngine_init();
 }
 
+FOG_NO_EXPORT void Painter_fini(void)
+{
+  RasterPaintEngine_fini();
+}
+
 } // Fog namespace
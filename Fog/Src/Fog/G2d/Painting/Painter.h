@@ -30,6 +30,7 @@
 #include <Fog/G2d/Imaging/ImageFilter.h>
 #include <Fog/G2d/Painting/PaintEngine.h>
 #include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Painting/PaintStatistics.h>
 
 namespace Fog {
 
@@ -840,6 +841,23 @@ struct FOG_NO_EXPORT Painter
     return _vtable->resetParameter(this, PAINTER_PARAMETER_FILTER_SCALE_F);
   }
 
+  // --------------------------------------------------------------------------
+  // [Parameters - Statistics]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get statistics collected by the paint-engine, see
+  //! @ref PaintStatistics.
+  FOG_INLINE err_t getStatistics(PaintStatistics& statistics) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_STATISTICS, &statistics);
+  }
+
+  //! @brief Reset statistics collected by the paint-engine.
+  FOG_INLINE err_t resetStatistics()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_STATISTICS);
+  }
+
   // --------------------------------------------------------------------------
   // [Source - Type]
   // --------------------------------------------------------------------------
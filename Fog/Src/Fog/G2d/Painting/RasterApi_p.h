@@ -57,6 +57,7 @@ struct RasterPatternFetcher;
 struct RasterFilter;
 struct RasterFilterBlur;
 struct RasterFilterImage;
+struct RasterFilterTurbulence;
 
 // Raster paint-engine.
 struct RasterPaintContext;
@@ -187,6 +188,19 @@ typedef void (FOG_FASTCALL *RasterPatternFetchFunc)(
 typedef void (FOG_FASTCALL *RasterPatternSkipFunc)(
   RasterPatternFetcher* fetcher, int step);
 
+// ============================================================================
+// [Fog::Raster - TypeDefs - Pattern - Fused]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fetch a scanline of pattern and composite it into @a dst (fetch and
+//! composite stages are bound at compile-time).
+typedef void (FOG_FASTCALL *RasterFusedSpanFunc)(
+  uint8_t* dst, RasterSpan* span,
+  RasterPatternFetcher* fetcher, uint8_t* buffer,
+  const RasterClosure* closure);
+
 // ============================================================================
 // [Fog::Raster - TypeDefs - Pattern - Gradient]
 // ============================================================================
@@ -236,6 +250,9 @@ typedef err_t (FOG_FASTCALL *RasterFilterDoRectFunc)(
 typedef void (FOG_FASTCALL *RasterFilterDoBlurFunc)(
   RasterFilterBlur* ctx);
 
+typedef void (FOG_FASTCALL *RasterFilterDoTurbulenceFunc)(
+  const RasterFilterTurbulence* ctx, uint8_t* dst, int x, int y, int w);
+
 // ============================================================================
 // [Fog::RasterConvertFuncs]
 // ============================================================================
@@ -247,6 +264,7 @@ struct FOG_NO_EXPORT RasterConvertFuncs
   RasterVBlitLineFunc copy[RASTER_COPY_COUNT];
   RasterVBlitLineFunc fill[RASTER_FILL_COUNT];
   RasterVBlitLineFunc bswap[RASTER_BSWAP_COUNT];
+  RasterVBlitLineFunc shuffle[RASTER_SHUFFLE_COUNT];
 
   RasterVBlitLineFunc argb32_from_prgb32;
   RasterVBlitLineFunc prgb32_from_argb32;
@@ -411,6 +429,67 @@ struct FOG_NO_EXPORT RasterFilterFuncs
       RasterFilterDoBlurFunc v[IMAGE_FORMAT_COUNT];
     } exponential;
   } blur;
+
+  struct _Turbulence
+  {
+    RasterFilterDoTurbulenceFunc row[IMAGE_FORMAT_COUNT];
+  } turbulence;
+};
+
+// ============================================================================
+// [Fog::RasterFusedFuncs]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Cache of fused fetch+composite kernels.
+//!
+//! Each CPU tier registers kernels for the hot combinations of pattern fetcher
+//! and span compositor it provides. Kernels are keyed by the function pointers
+//! stored in the fetch and composite tables, so a kernel is only returned when
+//! it does exactly what the two separate stages would do.
+struct FOG_NO_EXPORT RasterFusedFuncs
+{
+  struct _Entry
+  {
+    RasterPatternFetchFunc fetch;
+    RasterVBlitSpanFunc blit;
+    RasterFusedSpanFunc span;
+  };
+
+  //! @brief Remove all kernels, called by a CPU tier which replaced the span
+  //! compositors, because kernels of the previous tier can't match anymore.
+  FOG_INLINE void reset()
+  {
+    length = 0;
+  }
+
+  FOG_INLINE void add(RasterPatternFetchFunc fetch, RasterVBlitSpanFunc blit, RasterFusedSpanFunc span)
+  {
+    if (length >= RASTER_FUSED_CACHE_SIZE)
+      return;
+
+    entries[length].fetch = fetch;
+    entries[length].blit = blit;
+    entries[length].span = span;
+    length++;
+  }
+
+  FOG_INLINE RasterFusedSpanFunc get(RasterPatternFetchFunc fetch, RasterVBlitSpanFunc blit) const
+  {
+    // Entries added by the most specialized CPU tier are matched first.
+    for (uint32_t i = length; i; i--)
+    {
+      const _Entry& entry = entries[i - 1];
+      if (entry.fetch == fetch && entry.blit == blit)
+        return entry.span;
+    }
+
+    return NULL;
+  }
+
+  _Entry entries[RASTER_FUSED_CACHE_SIZE];
+  uint32_t length;
 };
 
 // ============================================================================
@@ -558,10 +637,23 @@ struct FOG_NO_EXPORT ApiRaster
   RasterGradientFuncs gradient;
 
   RasterFilterFuncs filter;
+  RasterFusedFuncs fused;
 };
 
 extern FOG_API ApiRaster _api_raster;
 
+//! @brief Get the CPU tier used by @c _api_raster (see @c RASTER_TIER).
+FOG_API uint32_t RasterOps_getTier(void);
+
+//! @brief Reinitialize @c _api_raster to use the CPU tier @a tier.
+//!
+//! Used to compare the output of CPU tiers against each other. Returns
+//! @c ERR_RT_NOT_IMPLEMENTED if the tier wasn't compiled or isn't supported
+//! by the CPU (or was masked out by FOG_CPU_DISABLE). Must be called before
+//! anything is painted, the functions already fetched from @c _api_raster
+//! aren't updated.
+FOG_API err_t RasterOps_setTier(uint32_t tier);
+
 //! @}
 
 } // Fog namespace
@@ -36,6 +36,13 @@ enum RASTER_CORE
   //! @brief Internal buffer-size used for multi-pass image conversion.
   RASTER_CONVERT_BUFFER_SIZE = 2048,
 
+  //! @brief Minimum count of pixels to convert by ImageConverter::blitRect()
+  //! before the work is split into bands processed by the thread pool.
+  RASTER_CONVERT_MT_THRESHOLD = 512 * 512,
+  //! @brief Minimum count of scanlines per band used by the multithreaded
+  //! ImageConverter::blitRect().
+  RASTER_CONVERT_MT_MIN_ROWS = 32,
+
   // --------------------------------------------------------------------------
   // [Multithreaded Paint Engine]
   // --------------------------------------------------------------------------
@@ -65,6 +72,75 @@ enum RASTER_BSWAP
   RASTER_BSWAP_COUNT
 };
 
+// ============================================================================
+// [RASTER_TURBULENCE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Constants used by the turbulence generator (feTurbulence).
+//!
+//! Random number generator and lattice sizes are the same as in the reference
+//! implementation found in SVG specification, so the generated noise matches
+//! other SVG implementations.
+enum RASTER_TURBULENCE
+{
+  //! @brief Random number generator modulus (2^31 - 1).
+  RASTER_TURBULENCE_RAND_M = 2147483647,
+  //! @brief Random number generator multiplier (7^5, primitive root of M).
+  RASTER_TURBULENCE_RAND_A = 16807,
+  //! @brief M / A.
+  RASTER_TURBULENCE_RAND_Q = 127773,
+  //! @brief M % A.
+  RASTER_TURBULENCE_RAND_R = 2836,
+
+  //! @brief Size of the lattice.
+  RASTER_TURBULENCE_BSIZE = 0x100,
+  //! @brief Lattice mask.
+  RASTER_TURBULENCE_BMASK = 0xFF,
+  //! @brief Offset added to coordinates to keep them positive.
+  RASTER_TURBULENCE_PERLIN = 0x1000,
+
+  //! @brief Maximum count of octaves.
+  RASTER_TURBULENCE_MAX_OCTAVES = 10,
+
+  //! @brief Minimum count of pixels to generate before the work is split into
+  //! bands processed by the thread pool.
+  RASTER_TURBULENCE_MT_THRESHOLD = 128 * 128,
+  //! @brief Minimum count of scanlines per band.
+  RASTER_TURBULENCE_MT_MIN_ROWS = 8
+};
+
+// ============================================================================
+// [RASTER_FUSED]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused span pipeline constants.
+enum RASTER_FUSED
+{
+  //! @brief Maximum count of fused fetch+composite kernels (all CPU tiers).
+  RASTER_FUSED_CACHE_SIZE = 128
+};
+
+// ============================================================================
+// [Fog::RASTER_TIER]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Raster CPU tier, each tier initializes also all tiers below it.
+enum RASTER_TIER
+{
+  RASTER_TIER_C = 0,
+  RASTER_TIER_SSE2 = 1,
+  RASTER_TIER_SSSE3 = 2,
+  RASTER_TIER_AVX2 = 3,
+
+  RASTER_TIER_COUNT = 4
+};
+
 // ============================================================================
 // [Fog::Raster - RASTER_CBLIT]
 // ============================================================================
@@ -354,6 +430,72 @@ enum RASTER_FORMAT
   RASTER_FORMAT_INVALID = RASTER_FORMAT_COUNT
 };
 
+// ============================================================================
+// [RASTER_GROUP_LAYER]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Group layer constants.
+enum RASTER_GROUP_LAYER
+{
+  //! @brief Shift of the group tile size.
+  RASTER_GROUP_TILE_SHIFT = 6,
+  //! @brief Size of the group tile (64x64 pixels).
+  RASTER_GROUP_TILE_SIZE = 1 << RASTER_GROUP_TILE_SHIFT,
+
+  //! @brief Maximum size of the group tile-map (one byte per tile), larger
+  //! targets don't track tiles and use the whole group bounding-box.
+  RASTER_GROUP_TILE_MAP_MAX = 16000,
+
+  //! @brief Count of layers kept by the global layer pool.
+  RASTER_GROUP_LAYER_POOL_SIZE = 8
+};
+
+// ============================================================================
+// [RASTER_MASK_CACHE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Coverage-mask cache constants.
+enum RASTER_MASK_CACHE
+{
+  //! @brief Default memory budget of the cache (in bytes).
+  RASTER_MASK_CACHE_BUDGET = 4 * 1024 * 1024,
+
+  //! @brief Maximum width and height of a cached path (in pixels).
+  RASTER_MASK_CACHE_MAX_SIZE = 256,
+
+  //! @brief Subpixel phase of the translation is quantized to 1/4 of pixel.
+  RASTER_MASK_CACHE_PHASE_SHIFT = 2,
+  //! @brief Count of subpixel phases per axis.
+  RASTER_MASK_CACHE_PHASE_COUNT = 1 << RASTER_MASK_CACHE_PHASE_SHIFT,
+
+  //! @brief Count of hash buckets (power of 2).
+  RASTER_MASK_CACHE_BUCKET_COUNT = 256,
+
+  //! @brief Count of slots of the admission table (power of 2).
+  RASTER_MASK_CACHE_SLOT_COUNT = 1024
+};
+
+// ============================================================================
+// [RASTER_MASK_CACHE_SLOT]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief State of a slot in the coverage-mask cache admission table.
+enum RASTER_MASK_CACHE_SLOT
+{
+  //! @brief Slot is empty.
+  RASTER_MASK_CACHE_SLOT_EMPTY = 0,
+  //! @brief Key was missed once, it will be recorded when missed again.
+  RASTER_MASK_CACHE_SLOT_SEEN = 1,
+  //! @brief Key can't be cached (the path is too large).
+  RASTER_MASK_CACHE_SLOT_REJECTED = 2
+};
+
 // ============================================================================
 // [Fog::RASTER_INTEGRAL_TRANSFORM]
 // ============================================================================
@@ -448,6 +590,23 @@ enum RASTER_PRGB_PREPARE
   RASTER_PRGB_PREPARE_ZRGB = 2
 };
 
+// ============================================================================
+// [RASTER_SHUFFLE]
+// ============================================================================
+
+//! @brief Byte-shuffle converters used to convert between 24-bit and 32-bit
+//! formats which have all components byte-aligned (see
+//! @c RasterConvertShuffle).
+enum RASTER_SHUFFLE
+{
+  RASTER_SHUFFLE_24_FROM_24 = 0,
+  RASTER_SHUFFLE_24_FROM_32,
+  RASTER_SHUFFLE_32_FROM_24,
+  RASTER_SHUFFLE_32_FROM_32,
+
+  RASTER_SHUFFLE_COUNT
+};
+
 // ============================================================================
 // [Fog::Raster - RASTER_VBLIT]
 // ============================================================================
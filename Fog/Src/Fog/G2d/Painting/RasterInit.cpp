@@ -10,6 +10,7 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Tools/Cpu.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
@@ -26,12 +27,16 @@ FOG_NO_EXPORT void RasterOps_init_C(void);
 FOG_NO_EXPORT void RasterOps_init_skipped(void);
 
 FOG_CPU_DECLARE_INITIALIZER_SSE2( RasterOps_init_SSE2(void) )
+FOG_CPU_DECLARE_INITIALIZER_SSSE3( RasterOps_init_SSSE3(void) )
+FOG_CPU_DECLARE_INITIALIZER_AVX2( RasterOps_init_AVX2(void) )
 
 // ============================================================================
-// [Fog::G2d - Initialization / Finalization]
+// [Fog::G2d - Tier]
 // ============================================================================
 
-FOG_NO_EXPORT void RasterOps_init(void)
+static uint32_t RasterOps_tier;
+
+static void RasterOps_initTier(uint32_t tier)
 {
   // Install C optimized code (default).
   RasterOps_init_C();
@@ -40,7 +45,17 @@ FOG_NO_EXPORT void RasterOps_init(void)
   // [CPU Based Optimizations]
   // --------------------------------------------------------------------------
 
-  FOG_CPU_USE_INITIALIZER_SSE2( RasterOps_init_SSE2() )
+#if defined(FOG_OPTIMIZE_SSE2)
+  if (tier >= RASTER_TIER_SSE2) RasterOps_init_SSE2();
+#endif // FOG_OPTIMIZE_SSE2
+
+#if defined(FOG_OPTIMIZE_SSSE3)
+  if (tier >= RASTER_TIER_SSSE3) RasterOps_init_SSSE3();
+#endif // FOG_OPTIMIZE_SSSE3
+
+#if defined(FOG_OPTIMIZE_AVX2)
+  if (tier >= RASTER_TIER_AVX2) RasterOps_init_AVX2();
+#endif // FOG_OPTIMIZE_AVX2
 
   // --------------------------------------------------------------------------
   // [Init-Skipped]
@@ -48,6 +63,72 @@ FOG_NO_EXPORT void RasterOps_init(void)
 
   // Initialize functions marked as 'SKIP'.
   RasterOps_init_skipped();
+
+  RasterOps_tier = tier;
+}
+
+uint32_t RasterOps_getTier(void)
+{
+  return RasterOps_tier;
+}
+
+err_t RasterOps_setTier(uint32_t tier)
+{
+  const Cpu* cpu = Cpu::get();
+
+  switch (tier)
+  {
+    case RASTER_TIER_C:
+      break;
+
+#if defined(FOG_OPTIMIZE_SSE2)
+    case RASTER_TIER_SSE2:
+      if (!cpu->hasFeature(CPU_FEATURE_SSE2))
+        return ERR_RT_NOT_IMPLEMENTED;
+      break;
+#endif // FOG_OPTIMIZE_SSE2
+
+#if defined(FOG_OPTIMIZE_SSE2) && defined(FOG_OPTIMIZE_SSSE3)
+    case RASTER_TIER_SSSE3:
+      if (!cpu->hasFeatures(CPU_FEATURE_SSE2 | CPU_FEATURE_SSSE3))
+        return ERR_RT_NOT_IMPLEMENTED;
+      break;
+#endif // FOG_OPTIMIZE_SSE2 && FOG_OPTIMIZE_SSSE3
+
+#if defined(FOG_OPTIMIZE_SSE2) && defined(FOG_OPTIMIZE_SSSE3) && defined(FOG_OPTIMIZE_AVX2)
+    case RASTER_TIER_AVX2:
+      if (!cpu->hasFeatures(CPU_FEATURE_SSE2 | CPU_FEATURE_SSSE3 | CPU_FEATURE_AVX2))
+        return ERR_RT_NOT_IMPLEMENTED;
+      break;
+#endif // FOG_OPTIMIZE_SSE2 && FOG_OPTIMIZE_SSSE3 && FOG_OPTIMIZE_AVX2
+
+    default:
+      return ERR_RT_NOT_IMPLEMENTED;
+  }
+
+  // Start from the same state as the library initialization, the higher tier
+  // may install functions the lower tiers don't have.
+  MemOps::zero(&_api_raster, sizeof(ApiRaster));
+  RasterOps_initTier(tier);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::G2d - Initialization / Finalization]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterOps_init(void)
+{
+  // Hardcoded tiers are always initialized, the others only if supported by
+  // the CPU (FOG_CPU_USE_INITIALIZER_...).
+  uint32_t tier = RASTER_TIER_C;
+
+  FOG_CPU_USE_INITIALIZER_SSE2( tier = RASTER_TIER_SSE2 )
+  FOG_CPU_USE_INITIALIZER_SSSE3( tier = RASTER_TIER_SSSE3 )
+  FOG_CPU_USE_INITIALIZER_AVX2( tier = RASTER_TIER_AVX2 )
+
+  RasterOps_initTier(tier);
 }
 
 // ============================================================================
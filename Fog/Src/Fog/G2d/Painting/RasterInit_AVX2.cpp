@@ -0,0 +1,245 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterInit_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeClear_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeFused_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrc_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrcOver_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/GradientLinear_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/GradientRadial_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/TextureSimple_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - Fallback]
+// ============================================================================
+
+RasterOps_AVX2::Fallback RasterOps_AVX2::_fallback;
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterOps_init_AVX2(void)
+{
+  using namespace RasterOps_AVX2;
+
+  ApiRaster& api = _api_raster;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Src - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_CORE_SRC];
+
+    _fallback.cblit_span[FALLBACK_CBLIT_SPAN_SRC_PRGB32] = funcs.cblit_span[RASTER_CBLIT_PRGB];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_PRGB32] = funcs.vblit_span[IMAGE_FORMAT_PRGB32];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_XRGB32] = funcs.vblit_span[IMAGE_FORMAT_XRGB32];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], CompositeSrc::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], CompositeSrc::prgb32_cblit_prgb32_span<FALLBACK_CBLIT_SPAN_SRC_PRGB32>);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], CompositeSrc::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], CompositeSrc::prgb32_vblit_xrgb32_line);
+
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], CompositeSrc::prgb32_vblit_prgb32_span<FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_PRGB32>);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_XRGB32   ], CompositeSrc::prgb32_vblit_xrgb32_span<FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_XRGB32>);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Src - XRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_XRGB32][RASTER_COMPOSITE_CORE_SRC];
+
+    _fallback.cblit_span[FALLBACK_CBLIT_SPAN_SRC_XRGB32] = funcs.cblit_span[RASTER_CBLIT_PRGB];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_PRGB32] = funcs.vblit_span[IMAGE_FORMAT_PRGB32];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_XRGB32] = funcs.vblit_span[IMAGE_FORMAT_XRGB32];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], CompositeSrc::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], CompositeSrc::prgb32_cblit_prgb32_span<FALLBACK_CBLIT_SPAN_SRC_XRGB32>);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], CompositeSrc::prgb32_vblit_xrgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], CompositeSrc::prgb32_vblit_prgb32_line);
+
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], CompositeSrc::prgb32_vblit_xrgb32_span<FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_PRGB32>);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_XRGB32   ], CompositeSrc::prgb32_vblit_xrgb32_span<FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_XRGB32>);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - SrcOver - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_CORE_SRC_OVER];
+
+    _fallback.cblit_span[FALLBACK_CBLIT_SPAN_SRC_OVER_PRGB32] = funcs.cblit_span[RASTER_CBLIT_PRGB];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_SRC_OVER_PRGB32_AND_PRGB32] = funcs.vblit_span[IMAGE_FORMAT_PRGB32];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], CompositeSrcOver::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], CompositeSrcOver::prgb32_cblit_prgb32_span<FALLBACK_CBLIT_SPAN_SRC_OVER_PRGB32>);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], CompositeSrcOver::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], CompositeSrcOver::prgb32_vblit_prgb32_span<FALLBACK_VBLIT_SPAN_SRC_OVER_PRGB32_AND_PRGB32>);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - SrcOver - XRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_XRGB32][RASTER_COMPOSITE_CORE_SRC_OVER];
+
+    _fallback.cblit_span[FALLBACK_CBLIT_SPAN_SRC_OVER_XRGB32] = funcs.cblit_span[RASTER_CBLIT_PRGB];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_SRC_OVER_XRGB32_AND_PRGB32] = funcs.vblit_span[IMAGE_FORMAT_PRGB32];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], CompositeSrcOver::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], CompositeSrcOver::prgb32_cblit_prgb32_span<FALLBACK_CBLIT_SPAN_SRC_OVER_XRGB32>);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], CompositeSrcOver::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], CompositeSrcOver::prgb32_vblit_prgb32_span<FALLBACK_VBLIT_SPAN_SRC_OVER_XRGB32_AND_PRGB32>);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Clear - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeExtFuncs& funcs = api.compositeExt[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_EXT_CLEAR];
+
+    _fallback.cblit_span[FALLBACK_CBLIT_SPAN_CLEAR_PRGB32] = funcs.cblit_span[RASTER_CBLIT_PRGB];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_CLEAR_PRGB32] = funcs.vblit_span[RASTER_VBLIT_PRGB32_AND_PRGB32];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB             ], (RasterCBlitLineFunc)CompositeClear::prgb32_xblit_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB             ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB             ], CompositeClear::prgb32_cblit_span<FALLBACK_CBLIT_SPAN_CLEAR_PRGB32>);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB             ]);
+
+    FOG_RASTER_INIT(vblit_line[RASTER_VBLIT_PRGB32_AND_PRGB32], (RasterVBlitLineFunc)CompositeClear::prgb32_xblit_line);
+    FOG_RASTER_INIT(vblit_span[RASTER_VBLIT_PRGB32_AND_PRGB32], CompositeClear::prgb32_vblit_span<FALLBACK_VBLIT_SPAN_CLEAR_PRGB32>);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Clear - XRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeExtFuncs& funcs = api.compositeExt[IMAGE_FORMAT_XRGB32][RASTER_COMPOSITE_EXT_CLEAR];
+
+    _fallback.cblit_span[FALLBACK_CBLIT_SPAN_CLEAR_XRGB32] = funcs.cblit_span[RASTER_CBLIT_PRGB];
+    _fallback.vblit_span[FALLBACK_VBLIT_SPAN_CLEAR_XRGB32] = funcs.vblit_span[RASTER_VBLIT_XRGB32_AND_PRGB32];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB             ], (RasterCBlitLineFunc)CompositeClear::xrgb32_xblit_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB             ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB             ], CompositeClear::xrgb32_cblit_span<FALLBACK_CBLIT_SPAN_CLEAR_XRGB32>);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB             ]);
+
+    FOG_RASTER_INIT(vblit_line[RASTER_VBLIT_XRGB32_AND_PRGB32], (RasterVBlitLineFunc)CompositeClear::xrgb32_xblit_line);
+    FOG_RASTER_INIT(vblit_span[RASTER_VBLIT_XRGB32_AND_PRGB32], CompositeClear::xrgb32_vblit_span<FALLBACK_VBLIT_SPAN_CLEAR_XRGB32>);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Solid]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterSolidFuncs& solid = api.solid;
+
+    solid.fetch[IMAGE_FORMAT_PRGB32] = Helpers::p_solid_fetch_prgb32_xrgb32;
+    solid.fetch[IMAGE_FORMAT_XRGB32] = Helpers::p_solid_fetch_prgb32_xrgb32;
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Gradient - Linear]
+  // --------------------------------------------------------------------------
+
+  RasterGradientFuncs& gradient = api.gradient;
+
+  _fallback.fetch[FALLBACK_FETCH_LINEAR_PAD_PRGB32   ] = gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_PAD   ];
+  _fallback.fetch[FALLBACK_FETCH_LINEAR_PAD_XRGB32   ] = gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_PAD   ];
+  _fallback.fetch[FALLBACK_FETCH_LINEAR_REPEAT_PRGB32] = gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_REPEAT];
+  _fallback.fetch[FALLBACK_FETCH_LINEAR_REPEAT_XRGB32] = gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_REPEAT];
+
+  gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_PAD    ] = PGradientLinear::fetch_simple_nearest_pad<FALLBACK_FETCH_LINEAR_PAD_PRGB32>;
+  gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_PAD    ] = PGradientLinear::fetch_simple_nearest_pad<FALLBACK_FETCH_LINEAR_PAD_XRGB32>;
+
+  gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_REPEAT ] = PGradientLinear::fetch_simple_nearest_repeat<FALLBACK_FETCH_LINEAR_REPEAT_PRGB32>;
+  gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_REPEAT ] = PGradientLinear::fetch_simple_nearest_repeat<FALLBACK_FETCH_LINEAR_REPEAT_XRGB32>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Gradient - Radial]
+  // --------------------------------------------------------------------------
+
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_PAD    ] = PGradientRadial::fetch_simple_nearest<PGradientAccessor_PRGB32_Pad>;
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_PAD    ] = PGradientRadial::fetch_simple_nearest<PGradientAccessor_PRGB32_Pad>;
+
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_REPEAT ] = PGradientRadial::fetch_simple_nearest<PGradientAccessor_PRGB32_Repeat>;
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_REPEAT ] = PGradientRadial::fetch_simple_nearest<PGradientAccessor_PRGB32_Repeat>;
+
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_REFLECT] = PGradientRadial::fetch_simple_nearest<PGradientAccessor_PRGB32_Reflect>;
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_REFLECT] = PGradientRadial::fetch_simple_nearest<PGradientAccessor_PRGB32_Reflect>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Texture - Simple]
+  // --------------------------------------------------------------------------
+
+  RasterTextureFuncs& texture = api.texture;
+
+  texture.prgb32.fetch_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = PTextureSimple::fetch_align_pad<PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_simple_align[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = PTextureSimple::fetch_align_pad<PTextureAccessor_PRGB32_From_XRGB32>;
+
+  texture.prgb32.fetch_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT ] = PTextureSimple::fetch_align_repeat<PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_simple_align[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT ] = PTextureSimple::fetch_align_repeat<PTextureAccessor_PRGB32_From_XRGB32>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Fused]
+  // --------------------------------------------------------------------------
+
+  RasterFusedFuncs& fused = api.fused;
+
+  // Replace the SSE2 kernels, they are keyed by compositors and fetchers
+  // replaced above. The scaled texture is still fetched by the previous tier.
+  fused.reset();
+
+  CompositeFused::addPRGB32Fetchers<PFusedOp_Src_PRGB32    , CompositeSrc::prgb32_vblit_prgb32_span<FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_PRGB32> >(fused, texture);
+  CompositeFused::addPRGB32Fetchers<PFusedOp_Src_XRGB32    , CompositeSrc::prgb32_vblit_xrgb32_span<FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_XRGB32> >(fused, texture);
+  CompositeFused::addPRGB32Fetchers<PFusedOp_Src_XRGB32    , CompositeSrc::prgb32_vblit_xrgb32_span<FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_PRGB32> >(fused, texture);
+  CompositeFused::addPRGB32Fetchers<PFusedOp_Src_XRGB32    , CompositeSrc::prgb32_vblit_xrgb32_span<FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_XRGB32> >(fused, texture);
+  CompositeFused::addPRGB32Fetchers<PFusedOp_SrcOver_PRGB32, CompositeSrcOver::prgb32_vblit_prgb32_span<FALLBACK_VBLIT_SPAN_SRC_OVER_PRGB32_AND_PRGB32> >(fused, texture);
+  CompositeFused::addPRGB32Fetchers<PFusedOp_SrcOver_PRGB32, CompositeSrcOver::prgb32_vblit_prgb32_span<FALLBACK_VBLIT_SPAN_SRC_OVER_XRGB32_AND_PRGB32> >(fused, texture);
+}
+
+} // Fog namespace
@@ -23,6 +23,7 @@
 #include <Fog/G2d/Painting/RasterOps_C/CompositeBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeClear_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeExt_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/CompositeFused_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeNop_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeSrc_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeSrcOver_p.h>
@@ -34,6 +35,7 @@
 #include <Fog/G2d/Painting/RasterOps_C/GradientRectangular_p.h>
 
 #include <Fog/G2d/Painting/RasterOps_C/FilterBlur_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/FilterTurbulence_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/FilterColorLut_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/FilterColorMatrix_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/FilterComponentTransfer_p.h>
@@ -107,6 +109,17 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
   convert.bswap[RASTER_BSWAP_64] = (ImageConverterBlitLineFunc)RasterOps_C::Convert::bswap_64;
 #endif // FOG_RASTER_INIT_C
 
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - Shuffle]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_RASTER_INIT_C)
+  convert.shuffle[RASTER_SHUFFLE_24_FROM_24] = (ImageConverterBlitLineFunc)RasterOps_C::Convert::shuffle_24_from_24;
+  convert.shuffle[RASTER_SHUFFLE_24_FROM_32] = (ImageConverterBlitLineFunc)RasterOps_C::Convert::shuffle_24_from_32;
+  convert.shuffle[RASTER_SHUFFLE_32_FROM_24] = (ImageConverterBlitLineFunc)RasterOps_C::Convert::shuffle_32_from_24;
+  convert.shuffle[RASTER_SHUFFLE_32_FROM_32] = (ImageConverterBlitLineFunc)RasterOps_C::Convert::shuffle_32_from_32;
+#endif // FOG_RASTER_INIT_C
+
   // --------------------------------------------------------------------------
   // [RasterOps - Convert - Premultiply / Demultiply]
   // --------------------------------------------------------------------------
@@ -1820,6 +1833,58 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
   texture.prgb32.fetch_simple_subxy[IMAGE_FORMAT_A8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureSimple::fetch_subxy_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
   texture.prgb32.fetch_simple_subxy[IMAGE_FORMAT_I8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureSimple::fetch_subxy_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
 
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Texture - Scale]
+  // --------------------------------------------------------------------------
+
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_A8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_I8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_A8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_I8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_nearest_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_nearest_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_nearest_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_A8    ][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_nearest_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_I8    ][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_nearest_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_A8    ][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_I8    ][TEXTURE_TILE_REPEAT ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_repeat<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_nearest_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_nearest_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_nearest_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_A8    ][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_nearest_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_I8    ][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_nearest_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_bilinear_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_bilinear_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_bilinear_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_A8    ][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_bilinear_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_I8    ][TEXTURE_TILE_REFLECT] = RasterOps_C::PTextureScale::fetch_scale_bilinear_reflect<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_nearest_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_nearest_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_nearest_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_A8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_nearest_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_I8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_nearest_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_A8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_I8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureScale::fetch_scale_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
   // --------------------------------------------------------------------------
   // [RasterOps - Pattern - Texture - Affine]
   // --------------------------------------------------------------------------
@@ -1921,6 +1986,30 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
   filter.blur.exponential.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_XRGB32>;
   filter.blur.exponential.v[IMAGE_FORMAT_RGB24 ] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_RGB24 >;
   filter.blur.exponential.v[IMAGE_FORMAT_A8    ] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_A8    >;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Turbulence]
+  // --------------------------------------------------------------------------
+
+  filter.create[FE_TYPE_TURBULENCE] = RasterOps_C::FTurbulence::create;
+
+  filter.turbulence.row[IMAGE_FORMAT_PRGB32] = RasterOps_C::FTurbulence::doRow<RasterOps_C::FTurbulenceAccessor_PRGB32>;
+  filter.turbulence.row[IMAGE_FORMAT_XRGB32] = RasterOps_C::FTurbulence::doRow<RasterOps_C::FTurbulenceAccessor_XRGB32>;
+  filter.turbulence.row[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FTurbulence::doRow<RasterOps_C::FTurbulenceAccessor_RGB24 >;
+  filter.turbulence.row[IMAGE_FORMAT_A8    ] = RasterOps_C::FTurbulence::doRow<RasterOps_C::FTurbulenceAccessor_A8    >;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Fused]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_RASTER_INIT_C)
+  RasterFusedFuncs& fused = api.fused;
+
+  RasterOps_C::CompositeFused::addPRGB32Fetchers<RasterOps_C::PFusedOp_Src_PRGB32    , RasterOps_C::CompositeSrc::prgb32_vblit_prgb32_span    >(fused);
+  RasterOps_C::CompositeFused::addPRGB32Fetchers<RasterOps_C::PFusedOp_Src_XRGB32    , RasterOps_C::CompositeSrc::prgb32_vblit_xrgb32_span    >(fused);
+  RasterOps_C::CompositeFused::addPRGB32Fetchers<RasterOps_C::PFusedOp_Src_XRGB32    , RasterOps_C::CompositeSrc::xrgb32_vblit_xrgb32_span    >(fused);
+  RasterOps_C::CompositeFused::addPRGB32Fetchers<RasterOps_C::PFusedOp_SrcOver_PRGB32, RasterOps_C::CompositeSrcOver::prgb32_vblit_prgb32_span>(fused);
+#endif // FOG_RASTER_INIT_C
 }
 
 } // Fog namespace
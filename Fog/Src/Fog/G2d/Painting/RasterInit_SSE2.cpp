@@ -23,9 +23,12 @@
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeClear_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeExt_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/CompositeFused_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrc_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrcOver_p.h>
 
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterTurbulence_p.h>
+
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientConical_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientLinear_p.h>
@@ -72,17 +75,26 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
   */
   convert.fill[RASTER_FILL_8] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::fill_8;
   convert.fill[RASTER_FILL_16] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::fill_16;
-  /*
+
   // --------------------------------------------------------------------------
   // [RasterOps - Convert - BSwap]
   // --------------------------------------------------------------------------
 
   convert.bswap[RASTER_BSWAP_16] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_16;
-  convert.bswap[RASTER_BSWAP_24] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_24;
   convert.bswap[RASTER_BSWAP_32] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_32;
+  /*
+  convert.bswap[RASTER_BSWAP_24] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_24;
   convert.bswap[RASTER_BSWAP_48] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_48;
   convert.bswap[RASTER_BSWAP_64] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_64;
+  */
 
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - Shuffle]
+  // --------------------------------------------------------------------------
+
+  convert.shuffle[RASTER_SHUFFLE_32_FROM_32] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::shuffle_32_from_32;
+
+  /*
   // --------------------------------------------------------------------------
   // [RasterOps - Convert - Premultiply / Demultiply]
   // --------------------------------------------------------------------------
@@ -1546,6 +1558,42 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
 
   gradient.interpolate[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::PGradientBase::interpolate_prgb32;
   gradient.interpolate[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::PGradientBase::interpolate_prgb32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Texture - Scale]
+  // --------------------------------------------------------------------------
+
+  RasterTextureFuncs& texture = api.texture;
+
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_SSE2::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_SSE2::PTextureScale::fetch_scale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_SSE2::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_scale_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_SSE2::PTextureScale::fetch_scale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Turbulence]
+  // --------------------------------------------------------------------------
+
+  RasterFilterFuncs& filter = api.filter;
+
+  filter.turbulence.row[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FTurbulence::doRow_32<0>;
+  filter.turbulence.row[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FTurbulence::doRow_32<1>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Fused]
+  // --------------------------------------------------------------------------
+
+  RasterFusedFuncs& fused = api.fused;
+
+  // Replace the C kernels, SSE2 kernels composite four pixels at a time and
+  // are keyed by the SRC_OVER compositor and the scale fetcher replaced above.
+  fused.reset();
+
+  RasterOps_SSE2::CompositeFused::addPRGB32Fetchers<RasterOps_SSE2::PFusedOp_Src_PRGB32    , RasterOps_C::CompositeSrc::prgb32_vblit_prgb32_span>(fused);
+  RasterOps_SSE2::CompositeFused::addPRGB32Fetchers<RasterOps_SSE2::PFusedOp_Src_XRGB32    , RasterOps_C::CompositeSrc::prgb32_vblit_xrgb32_span>(fused);
+  RasterOps_SSE2::CompositeFused::addPRGB32Fetchers<RasterOps_SSE2::PFusedOp_Src_XRGB32    , RasterOps_C::CompositeSrc::xrgb32_vblit_xrgb32_span>(fused);
+  RasterOps_SSE2::CompositeFused::addPRGB32Fetchers<RasterOps_SSE2::PFusedOp_SrcOver_PRGB32, RasterOps_SSE2::CompositeSrcOver::prgb32_vblit_prgb32_span>(fused);
 }
 
 } // Fog namespace
@@ -0,0 +1,46 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterInit_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_SSSE3/BaseConvert_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterOps_init_SSSE3(void)
+{
+  ApiRaster& api = _api_raster;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - API]
+  // --------------------------------------------------------------------------
+
+  RasterConvertFuncs& convert = api.convert;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - Shuffle]
+  // --------------------------------------------------------------------------
+
+  convert.shuffle[RASTER_SHUFFLE_24_FROM_24] = (ImageConverterBlitLineFunc)RasterOps_SSSE3::Convert::shuffle_24_from_24;
+  convert.shuffle[RASTER_SHUFFLE_24_FROM_32] = (ImageConverterBlitLineFunc)RasterOps_SSSE3::Convert::shuffle_24_from_32;
+  convert.shuffle[RASTER_SHUFFLE_32_FROM_24] = (ImageConverterBlitLineFunc)RasterOps_SSSE3::Convert::shuffle_32_from_24;
+  convert.shuffle[RASTER_SHUFFLE_32_FROM_32] = (ImageConverterBlitLineFunc)RasterOps_SSSE3::Convert::shuffle_32_from_32;
+}
+
+} // Fog namespace
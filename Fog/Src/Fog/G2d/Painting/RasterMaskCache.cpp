@@ -0,0 +1,545 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Painting/RasterMaskCache_p.h>
+#include <Fog/G2d/Painting/RasterSpan_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterMaskCache - Global]
+// ============================================================================
+
+FOG_NO_EXPORT Static<RasterMaskCache> RasterMaskCache_global;
+
+// ============================================================================
+// [Fog::RasterMaskCache - Helpers]
+// ============================================================================
+
+// Whether the path data are referenced only by the entry, so the entry can't
+// be matched anymore.
+static FOG_INLINE bool RasterMaskCache_isPathUnused(const RasterMaskCacheEntry* entry)
+{
+  if (entry->key.pathType == RASTER_PRECISION_F)
+    return static_cast<const PathDataF*>(entry->key.pathData)->reference.get() == 1;
+  else
+    return static_cast<const PathDataD*>(entry->key.pathData)->reference.get() == 1;
+}
+
+// Memory used by the path data referenced by the key.
+static FOG_INLINE size_t RasterMaskCache_getPathSize(const RasterMaskCacheKey& key)
+{
+  if (key.pathType == RASTER_PRECISION_F)
+  {
+    const PathDataF* d = static_cast<const PathDataF*>(key.pathData);
+    return sizeof(PathDataF) + d->capacity * (sizeof(PointF) + sizeof(uint8_t));
+  }
+  else
+  {
+    const PathDataD* d = static_cast<const PathDataD*>(key.pathData);
+    return sizeof(PathDataD) + d->capacity * (sizeof(PointD) + sizeof(uint8_t));
+  }
+}
+
+// ============================================================================
+// [Fog::RasterMaskCache - Construction / Destruction]
+// ============================================================================
+
+RasterMaskCache::RasterMaskCache() :
+  _budget(RASTER_MASK_CACHE_BUDGET),
+  _size(0),
+  _lruFirst(NULL),
+  _lruLast(NULL)
+{
+  MemOps::zero(_buckets, sizeof(_buckets));
+  MemOps::zero(_slotHashCode, sizeof(_slotHashCode));
+  MemOps::zero(_slotState, sizeof(_slotState));
+}
+
+RasterMaskCache::~RasterMaskCache()
+{
+  clear();
+}
+
+// ============================================================================
+// [Fog::RasterMaskCache - Budget]
+// ============================================================================
+
+void RasterMaskCache::setBudget(size_t budget)
+{
+  AutoLock locked(_lock);
+
+  _budget = budget;
+  _evict(budget);
+}
+
+// ============================================================================
+// [Fog::RasterMaskCache - Get / Put]
+// ============================================================================
+
+RasterMaskCacheEntry* RasterMaskCache::get(const RasterMaskCacheKey& key, uint32_t hashCode)
+{
+  AutoLock locked(_lock);
+  RasterMaskCacheEntry* entry = _buckets[hashCode & (RASTER_MASK_CACHE_BUCKET_COUNT - 1)];
+
+  while (entry != NULL)
+  {
+    if (entry->hashCode == hashCode && entry->key.eq(key))
+    {
+      // Move to the front of the LRU list.
+      if (entry != _lruFirst)
+      {
+        RasterMaskCacheEntry* prev = entry->lruPrev;
+        RasterMaskCacheEntry* next = entry->lruNext;
+
+        prev->lruNext = next;
+        if (next != NULL)
+          next->lruPrev = prev;
+        else
+          _lruLast = prev;
+
+        entry->lruPrev = NULL;
+        entry->lruNext = _lruFirst;
+        _lruFirst->lruPrev = entry;
+        _lruFirst = entry;
+      }
+
+      entry->reference.inc();
+      return entry;
+    }
+
+    entry = entry->hashNext;
+  }
+
+  return NULL;
+}
+
+void RasterMaskCache::put(RasterMaskCacheEntry* entry)
+{
+  AutoLock locked(_lock);
+
+  if (entry->size > _budget)
+    return;
+
+  // Replace the entry with the same key (added by another painter meanwhile).
+  RasterMaskCacheEntry* cur = _buckets[entry->hashCode & (RASTER_MASK_CACHE_BUCKET_COUNT - 1)];
+  while (cur != NULL)
+  {
+    if (cur->hashCode == entry->hashCode && cur->key.eq(entry->key))
+    {
+      _unlink(cur);
+      break;
+    }
+    cur = cur->hashNext;
+  }
+
+  // Release entries of paths which don't exist anymore, then the least
+  // recently used entries until the new entry fits into the budget.
+  while (_lruLast != NULL && RasterMaskCache_isPathUnused(_lruLast))
+    _unlink(_lruLast);
+  _evict(_budget - entry->size);
+
+  RasterMaskCacheEntry** bucket = &_buckets[entry->hashCode & (RASTER_MASK_CACHE_BUCKET_COUNT - 1)];
+  entry->hashNext = *bucket;
+  *bucket = entry;
+
+  entry->lruPrev = NULL;
+  entry->lruNext = _lruFirst;
+
+  if (_lruFirst != NULL)
+    _lruFirst->lruPrev = entry;
+  else
+    _lruLast = entry;
+  _lruFirst = entry;
+
+  _size += entry->size;
+  entry->reference.inc();
+}
+
+void RasterMaskCache::clear()
+{
+  AutoLock locked(_lock);
+  _evict(0);
+}
+
+// ============================================================================
+// [Fog::RasterMaskCache - Admission]
+// ============================================================================
+
+bool RasterMaskCache::admit(uint32_t hashCode)
+{
+  AutoLock locked(_lock);
+  size_t slot = hashCode & (RASTER_MASK_CACHE_SLOT_COUNT - 1);
+
+  if (_slotState[slot] != RASTER_MASK_CACHE_SLOT_EMPTY && _slotHashCode[slot] == hashCode)
+    return _slotState[slot] == RASTER_MASK_CACHE_SLOT_SEEN;
+
+  // Missed for the first time, the slot is reused (it's a hint only).
+  _slotHashCode[slot] = hashCode;
+  _slotState[slot] = RASTER_MASK_CACHE_SLOT_SEEN;
+  return false;
+}
+
+void RasterMaskCache::reject(uint32_t hashCode)
+{
+  AutoLock locked(_lock);
+  size_t slot = hashCode & (RASTER_MASK_CACHE_SLOT_COUNT - 1);
+
+  _slotHashCode[slot] = hashCode;
+  _slotState[slot] = RASTER_MASK_CACHE_SLOT_REJECTED;
+}
+
+// ============================================================================
+// [Fog::RasterMaskCache - Entry]
+// ============================================================================
+
+RasterMaskCacheEntry* RasterMaskCache::create(const RasterMaskCacheKey& key, uint32_t hashCode,
+  const BoxI& box, size_t spanCount, size_t maskSize)
+{
+  size_t rowCount = (size_t)(uint)box.getHeight() + 1;
+
+  size_t spansOffset = (sizeof(RasterMaskCacheEntry) + 15) & ~(size_t)15;
+  size_t rowsOffset = spansOffset + spanCount * sizeof(RasterMaskCacheSpan);
+  size_t masksOffset = (rowsOffset + rowCount * sizeof(uint32_t) + 15) & ~(size_t)15;
+  size_t size = masksOffset + maskSize;
+
+  RasterMaskCacheEntry* entry = reinterpret_cast<RasterMaskCacheEntry*>(MemMgr::alloc(size));
+  if (FOG_IS_NULL(entry))
+    return NULL;
+
+  uint8_t* p = reinterpret_cast<uint8_t*>(entry);
+
+  entry->reference.init(1);
+  entry->hashNext = NULL;
+  entry->lruPrev = NULL;
+  entry->lruNext = NULL;
+  entry->hashCode = hashCode;
+  entry->key = key;
+
+  // The path data are kept alive by the entry, count them to the budget.
+  entry->size = size + RasterMaskCache_getPathSize(key);
+
+  entry->box = box;
+  entry->rows = reinterpret_cast<uint32_t*>(p + rowsOffset);
+  entry->spans = reinterpret_cast<RasterMaskCacheSpan*>(p + spansOffset);
+  entry->masks = p + masksOffset;
+
+  if (key.pathType == RASTER_PRECISION_F)
+    static_cast<const PathDataF*>(key.pathData)->addRef();
+  else
+    static_cast<const PathDataD*>(key.pathData)->addRef();
+
+  return entry;
+}
+
+void RasterMaskCache::_destroy(RasterMaskCacheEntry* entry)
+{
+  if (entry->key.pathType == RASTER_PRECISION_F)
+    const_cast<PathDataF*>(static_cast<const PathDataF*>(entry->key.pathData))->release();
+  else
+    const_cast<PathDataD*>(static_cast<const PathDataD*>(entry->key.pathData))->release();
+
+  MemMgr::free(entry);
+}
+
+// ============================================================================
+// [Fog::RasterMaskCache - Private]
+// ============================================================================
+
+void RasterMaskCache::_unlink(RasterMaskCacheEntry* entry)
+{
+  RasterMaskCacheEntry** pPrev = &_buckets[entry->hashCode & (RASTER_MASK_CACHE_BUCKET_COUNT - 1)];
+  while (*pPrev != entry)
+    pPrev = &(*pPrev)->hashNext;
+  *pPrev = entry->hashNext;
+
+  RasterMaskCacheEntry* prev = entry->lruPrev;
+  RasterMaskCacheEntry* next = entry->lruNext;
+
+  if (prev != NULL)
+    prev->lruNext = next;
+  else
+    _lruFirst = next;
+
+  if (next != NULL)
+    next->lruPrev = prev;
+  else
+    _lruLast = prev;
+
+  _size -= entry->size;
+  release(entry);
+}
+
+void RasterMaskCache::_evict(size_t budget)
+{
+  while (_size > budget)
+  {
+    FOG_ASSERT(_lruLast != NULL);
+    _unlink(_lruLast);
+  }
+}
+
+// ============================================================================
+// [Fog::RasterMaskCacheRecorder - Filler]
+// ============================================================================
+
+static void FOG_FASTCALL RasterMaskCacheRecorder_prepare(RasterMaskCacheRecorder* self, int y)
+{
+  FOG_ASSERT(y >= self->box.y0 && y <= self->box.y1);
+
+  for (int i = self->box.y0; i < y; i++)
+    self->rows[i - self->box.y0] = 0;
+  self->y = y;
+}
+
+static void FOG_FASTCALL RasterMaskCacheRecorder_process(RasterMaskCacheRecorder* self, RasterSpan8* spans)
+{
+  FOG_ASSERT(self->y < self->box.y1);
+  self->rows[self->y - self->box.y0] = (uint32_t)self->spanCount;
+  self->y++;
+
+  if (self->failed)
+    return;
+
+  RasterSpan8* span = spans;
+  do {
+    size_t spansSize = (self->spanCount + 1) * sizeof(RasterMaskCacheSpan);
+    if (spansSize > self->spanCapacity &&
+        !self->_grow(reinterpret_cast<uint8_t**>(&self->spans), &self->spanCapacity, spansSize))
+      return;
+
+    RasterMaskCacheSpan& dst = self->spans[self->spanCount++];
+    uint type = span->getType();
+
+    dst.x0 = (uint16_t)(span->getX0() - self->box.x0);
+    dst.x1 = (uint16_t)(span->getX1() - self->box.x0);
+    dst.type = type;
+
+    if (span->isConst())
+    {
+      dst.mask = span->getConstMask();
+    }
+    else
+    {
+      size_t size = (size_t)(uint)RasterSpan8::getMaskAdvance(type, span->getLength());
+      size_t sizeAligned = (size + 3) & ~(size_t)3;
+
+      if (self->maskSize + sizeAligned > self->maskCapacity &&
+          !self->_grow(&self->masks, &self->maskCapacity, self->maskSize + sizeAligned))
+        return;
+
+      MemOps::copy(self->masks + self->maskSize, span->getVariantMask(), size);
+      dst.mask = (uint32_t)self->maskSize;
+      self->maskSize += sizeAligned;
+    }
+
+    span = span->getNext();
+  } while (span != NULL);
+}
+
+static void FOG_FASTCALL RasterMaskCacheRecorder_skip(RasterMaskCacheRecorder* self, int step)
+{
+  FOG_ASSERT(self->y + step <= self->box.y1);
+
+  for (int i = 0; i < step; i++)
+    self->rows[self->y++ - self->box.y0] = (uint32_t)self->spanCount;
+}
+
+// ============================================================================
+// [Fog::RasterMaskCacheRecorder - Construction / Destruction]
+// ============================================================================
+
+RasterMaskCacheRecorder::RasterMaskCacheRecorder() :
+  y(0),
+  failed(false),
+  rows(NULL),
+  rowCapacity(0),
+  spans(NULL),
+  spanCount(0),
+  spanCapacity(0),
+  masks(NULL),
+  maskSize(0),
+  maskCapacity(0)
+{
+  box.reset();
+
+  _prepare = (RasterFiller::PrepareFunc)RasterMaskCacheRecorder_prepare;
+  _process = (RasterFiller::ProcessFunc)RasterMaskCacheRecorder_process;
+  _skip = (RasterFiller::SkipFunc)RasterMaskCacheRecorder_skip;
+}
+
+RasterMaskCacheRecorder::~RasterMaskCacheRecorder()
+{
+  if (rows != NULL)
+    MemMgr::free(rows);
+
+  if (spans != NULL)
+    MemMgr::free(spans);
+
+  if (masks != NULL)
+    MemMgr::free(masks);
+}
+
+// ============================================================================
+// [Fog::RasterMaskCacheRecorder - Methods]
+// ============================================================================
+
+void RasterMaskCacheRecorder::begin(const BoxI& box)
+{
+  this->box = box;
+  this->y = box.y0;
+
+  spanCount = 0;
+  maskSize = 0;
+
+  size_t rowsSize = ((size_t)(uint)box.getHeight() + 1) * sizeof(uint32_t);
+  failed = false;
+
+  if (rowsSize > rowCapacity)
+    _grow(reinterpret_cast<uint8_t**>(&rows), &rowCapacity, rowsSize);
+}
+
+RasterMaskCacheEntry* RasterMaskCacheRecorder::createEntry(const RasterMaskCacheKey& key, uint32_t hashCode)
+{
+  if (failed)
+    return NULL;
+
+  // Rows not reached by the rasterizer are empty.
+  while (y <= box.y1)
+    rows[y++ - box.y0] = (uint32_t)spanCount;
+
+  RasterMaskCacheEntry* entry = RasterMaskCache::create(key, hashCode, box, spanCount, maskSize);
+  if (FOG_IS_NULL(entry))
+    return NULL;
+
+  MemOps::copy(entry->rows, rows, ((size_t)(uint)box.getHeight() + 1) * sizeof(uint32_t));
+  MemOps::copy(entry->spans, spans, spanCount * sizeof(RasterMaskCacheSpan));
+  MemOps::copy(entry->masks, masks, maskSize);
+
+  return entry;
+}
+
+bool RasterMaskCacheRecorder::_grow(uint8_t** data, size_t* capacity, size_t size)
+{
+  size_t newCapacity = Math::max<size_t>(size, *capacity * 2);
+  if (newCapacity < 1024)
+    newCapacity = 1024;
+
+  uint8_t* newData = reinterpret_cast<uint8_t*>(MemMgr::realloc(*data, newCapacity));
+  if (FOG_IS_NULL(newData))
+  {
+    failed = true;
+    return false;
+  }
+
+  *data = newData;
+  *capacity = newCapacity;
+  return true;
+}
+
+// ============================================================================
+// [Fog::RasterMaskCacheRasterizer8 - Render]
+// ============================================================================
+
+static void FOG_CDECL RasterMaskCacheRasterizer8_render(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  RasterMaskCacheRasterizer8* self = static_cast<RasterMaskCacheRasterizer8*>(_self);
+  const RasterMaskCacheEntry* entry = self->_entry;
+
+  int dx = self->_offset.x + entry->box.x0;
+  int dy = self->_offset.y;
+
+  int cx0 = self->_boundingBox.x0;
+  int cx1 = self->_boundingBox.x1;
+
+  int y = self->_boundingBox.y0;
+  int yEnd = self->_boundingBox.y1;
+
+  int skip = 0;
+  filler->prepare(y);
+
+  for (; y < yEnd; y++)
+  {
+    const RasterMaskCacheSpan* src = entry->getSpans(y - dy);
+    const RasterMaskCacheSpan* srcEnd = entry->getSpansEnd(y - dy);
+
+    RasterSpan8* span = scanline->begin();
+
+    for (; src != srcEnd; src++)
+    {
+      int x0 = dx + (int)src->x0;
+      int x1 = dx + (int)src->x1;
+
+      if (x1 <= cx0)
+        continue;
+      if (x0 >= cx1)
+        break;
+
+      RasterSpan8* newSpan = scanline->allocSpan();
+      if (FOG_IS_NULL(newSpan))
+        return;
+
+      span->_next = newSpan;
+      span = newSpan;
+
+      int sx0 = Math::max<int>(x0, cx0);
+      int sx1 = Math::min<int>(x1, cx1);
+
+      span->setPositionAndType(sx0, sx1, src->type);
+      if (src->type == RASTER_SPAN_C)
+        span->setConstMask(src->mask);
+      else
+        span->setVariantMask(entry->masks + src->mask + RasterSpan8::getMaskAdvance(src->type, sx0 - x0));
+    }
+
+    span = scanline->end(span);
+
+    if (FOG_IS_NULL(span))
+    {
+      skip++;
+      continue;
+    }
+
+    if (skip != 0)
+    {
+      filler->skip(skip);
+      skip = 0;
+    }
+
+    filler->process(span);
+  }
+}
+
+// ============================================================================
+// [Fog::RasterMaskCacheRasterizer8 - Init]
+// ============================================================================
+
+bool RasterMaskCacheRasterizer8::init(const RasterMaskCacheEntry* entry, const PointI& offset)
+{
+  _entry = entry;
+  _offset = offset;
+
+  BoxI box(entry->box.x0 + offset.x, entry->box.y0 + offset.y,
+           entry->box.x1 + offset.x, entry->box.y1 + offset.y);
+
+  if (!BoxI::intersect(_boundingBox, box, _sceneBox))
+    return false;
+
+  _render = RasterMaskCacheRasterizer8_render;
+  _initialized = true;
+  return true;
+}
+
+} // Fog namespace
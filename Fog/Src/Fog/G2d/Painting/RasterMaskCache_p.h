@@ -0,0 +1,352 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERMASKCACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERMASKCACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Geometry/Path.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/Rasterizer_p.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RasterMaskCacheKey]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Key of the coverage-mask cache.
+//!
+//! The path is identified by its data, the cache entry holds a reference to
+//! them so they can't change (modifying the path detaches it).
+struct FOG_NO_EXPORT RasterMaskCacheKey
+{
+  FOG_INLINE uint32_t getHashCode() const
+  {
+    uint32_t hashCode = (uint32_t)((size_t)pathData >> 4);
+
+    hashCode ^= (uint32_t)phase.x * 0x9E3779B1U;
+    hashCode ^= (uint32_t)phase.y * 0x85EBCA77U;
+    hashCode ^= (fillRule << 9) ^ opacity;
+
+    return hashCode;
+  }
+
+  FOG_INLINE bool eq(const RasterMaskCacheKey& other) const
+  {
+    return pathData     == other.pathData     &&
+           pathType     == other.pathType     &&
+           fillRule     == other.fillRule     &&
+           opacity      == other.opacity      &&
+           phase        == other.phase        &&
+           linear[0]    == other.linear[0]    &&
+           linear[1]    == other.linear[1]    &&
+           linear[2]    == other.linear[2]    &&
+           linear[3]    == other.linear[3]    ;
+  }
+
+  //! @brief Path data (@c PathDataF or @c PathDataD).
+  const void* pathData;
+  //! @brief Path data type (@c RASTER_PRECISION_F or @c RASTER_PRECISION_D).
+  uint32_t pathType;
+
+  //! @brief Fill rule.
+  uint32_t fillRule;
+  //! @brief Opacity (0 to 0x100, inclusive).
+  uint32_t opacity;
+
+  //! @brief Subpixel phase of the translation (see @c RASTER_MASK_CACHE_PHASE_SHIFT).
+  PointI phase;
+  //! @brief Transform without translation (_00, _01, _10, _11).
+  double linear[4];
+};
+
+// ============================================================================
+// [Fog::RasterMaskCacheSpan]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Span stored in @ref RasterMaskCacheEntry.
+struct FOG_NO_EXPORT RasterMaskCacheSpan
+{
+  //! @brief Start of the span relative to the entry box.
+  uint16_t x0;
+  //! @brief End of the span relative to the entry box.
+  uint16_t x1;
+  //! @brief Span type, see @c RASTER_SPAN.
+  uint32_t type;
+  //! @brief Const mask or offset of the variant mask in the entry mask data.
+  uint32_t mask;
+};
+
+// ============================================================================
+// [Fog::RasterMaskCacheEntry]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Coverage of a path stored as compressed spans.
+//!
+//! The spans are relative to the integral part of the translation used to
+//! fill the path, so the entry can be rendered anywhere.
+struct FOG_NO_EXPORT RasterMaskCacheEntry
+{
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const RasterMaskCacheSpan* getSpans(int y) const { return spans + rows[y - box.y0]; }
+  FOG_INLINE const RasterMaskCacheSpan* getSpansEnd(int y) const { return spans + rows[y - box.y0 + 1]; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reference count (the cache and each renderer).
+  mutable Atomic<size_t> reference;
+
+  //! @brief Next entry in the hash bucket.
+  RasterMaskCacheEntry* hashNext;
+  //! @brief Previous entry in LRU list (more recently used).
+  RasterMaskCacheEntry* lruPrev;
+  //! @brief Next entry in LRU list (less recently used).
+  RasterMaskCacheEntry* lruNext;
+
+  //! @brief Hash code of @c key.
+  uint32_t hashCode;
+  //! @brief Size of the entry, including the spans, masks and the referenced
+  //! path data.
+  size_t size;
+
+  //! @brief Key.
+  RasterMaskCacheKey key;
+
+  //! @brief Box of the coverage (relative to the integral translation).
+  BoxI box;
+
+  //! @brief Index of the first span of each row (@c box height plus one).
+  uint32_t* rows;
+  //! @brief Spans.
+  RasterMaskCacheSpan* spans;
+  //! @brief Variant masks.
+  uint8_t* masks;
+};
+
+// ============================================================================
+// [Fog::RasterMaskCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Global cache of coverage masks of filled paths.
+//!
+//! Icons and markers are often filled many times using the same path and the
+//! same transform, only translated. The raster paint-engine caches spans
+//! produced by the rasterizer for such paths, keyed by the path data, the
+//! transform without translation, the subpixel phase of the translation (it's
+//! quantized), the fill rule and the opacity. Cached spans are then sent to
+//! the span compositors directly, without clipping, rasterizing and sweeping.
+//!
+//! Only paths of which the transformed control points fit into
+//! @c RASTER_MASK_CACHE_MAX_SIZE are cached, entries are released in LRU
+//! order to keep the memory used by the cache within the budget. The entry
+//! references the path data, so their size is counted as well.
+//!
+//! Paths filled only once are not recorded. A key is admitted when it's
+//! missed for the second time, the keys missed once are remembered by their
+//! hash code in a small direct-mapped table (@c RASTER_MASK_CACHE_SLOT_COUNT),
+//! which also remembers paths rejected because they are too large.
+struct FOG_NO_EXPORT RasterMaskCache
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  RasterMaskCache();
+  ~RasterMaskCache();
+
+  // --------------------------------------------------------------------------
+  // [Budget]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE size_t getBudget() const { return _budget; }
+  void setBudget(size_t budget);
+
+  // --------------------------------------------------------------------------
+  // [Get / Put]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get entry matching @a key, the returned entry must be released
+  //! by @c release(). Returns @c NULL if there is no such entry.
+  RasterMaskCacheEntry* get(const RasterMaskCacheKey& key, uint32_t hashCode);
+
+  //! @brief Add entry to the cache (the entry is referenced by the caller and
+  //! must be released by @c release()).
+  //!
+  //! If there is an entry with the same key, it's replaced.
+  void put(RasterMaskCacheEntry* entry);
+
+  //! @brief Release all entries.
+  void clear();
+
+  // --------------------------------------------------------------------------
+  // [Admission]
+  // --------------------------------------------------------------------------
+
+  //! @brief Called when @c get() failed, returns whether the entry should be
+  //! recorded (the key was missed recently and wasn't rejected).
+  bool admit(uint32_t hashCode);
+
+  //! @brief Remember that the path of key having @a hashCode can't be cached.
+  void reject(uint32_t hashCode);
+
+  // --------------------------------------------------------------------------
+  // [Entry]
+  // --------------------------------------------------------------------------
+
+  //! @brief Create entry for coverage within @a box, which contains
+  //! @a spanCount spans and @a maskSize bytes of variant masks. The entry
+  //! references the path data of @a key.
+  static RasterMaskCacheEntry* create(const RasterMaskCacheKey& key, uint32_t hashCode,
+    const BoxI& box, size_t spanCount, size_t maskSize);
+
+  static FOG_INLINE void release(RasterMaskCacheEntry* entry)
+  {
+    if (entry->reference.deref())
+      _destroy(entry);
+  }
+
+  static void _destroy(RasterMaskCacheEntry* entry);
+
+  // --------------------------------------------------------------------------
+  // [Private]
+  // --------------------------------------------------------------------------
+
+  void _unlink(RasterMaskCacheEntry* entry);
+  void _evict(size_t budget);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Lock.
+  Lock _lock;
+
+  //! @brief Memory budget (in bytes).
+  size_t _budget;
+  //! @brief Memory used by the cached entries (in bytes).
+  size_t _size;
+
+  //! @brief Most recently used entry.
+  RasterMaskCacheEntry* _lruFirst;
+  //! @brief Least recently used entry.
+  RasterMaskCacheEntry* _lruLast;
+
+  //! @brief Hash buckets.
+  RasterMaskCacheEntry* _buckets[RASTER_MASK_CACHE_BUCKET_COUNT];
+
+  //! @brief Hash codes of keys in the admission table.
+  uint32_t _slotHashCode[RASTER_MASK_CACHE_SLOT_COUNT];
+  //! @brief States of keys in the admission table, see @c RASTER_MASK_CACHE_SLOT.
+  uint8_t _slotState[RASTER_MASK_CACHE_SLOT_COUNT];
+
+private:
+  FOG_NO_COPY(RasterMaskCache)
+};
+
+extern FOG_NO_EXPORT Static<RasterMaskCache> RasterMaskCache_global;
+
+// ============================================================================
+// [Fog::RasterMaskCacheRecorder]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Filler which records spans produced by a rasterizer.
+struct FOG_NO_EXPORT RasterMaskCacheRecorder : public RasterFiller
+{
+  RasterMaskCacheRecorder();
+  ~RasterMaskCacheRecorder();
+
+  //! @brief Start recording, @a box is the box of the rasterized shape.
+  void begin(const BoxI& box);
+
+  //! @brief Create entry from the recorded spans.
+  RasterMaskCacheEntry* createEntry(const RasterMaskCacheKey& key, uint32_t hashCode);
+
+  //! @brief Grow @a data so it can hold at least @a size bytes, @a capacity
+  //! is in bytes.
+  bool _grow(uint8_t** data, size_t* capacity, size_t size);
+
+  //! @brief Box of the rasterized shape.
+  BoxI box;
+  //! @brief Current row.
+  int y;
+  //! @brief Whether the memory allocation failed.
+  bool failed;
+
+  //! @brief Index of the first span of each row.
+  uint32_t* rows;
+  //! @brief Capacity of @c rows (in bytes).
+  size_t rowCapacity;
+
+  //! @brief Spans.
+  RasterMaskCacheSpan* spans;
+  //! @brief Count of spans.
+  size_t spanCount;
+  //! @brief Capacity of @c spans (in bytes).
+  size_t spanCapacity;
+
+  //! @brief Variant masks.
+  uint8_t* masks;
+  //! @brief Size of variant masks (in bytes).
+  size_t maskSize;
+  //! @brief Capacity of @c masks (in bytes).
+  size_t maskCapacity;
+
+private:
+  FOG_NO_COPY(RasterMaskCacheRecorder)
+};
+
+// ============================================================================
+// [Fog::RasterMaskCacheRasterizer8]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Rasterizer which renders spans of @ref RasterMaskCacheEntry.
+struct FOG_NO_EXPORT RasterMaskCacheRasterizer8 : public Rasterizer8
+{
+  //! @brief Setup rendering of @a entry at @a offset clipped by the scene-box,
+  //! returns @c false if nothing would be rendered.
+  bool init(const RasterMaskCacheEntry* entry, const PointI& offset);
+
+  //! @brief Cache entry.
+  const RasterMaskCacheEntry* _entry;
+  //! @brief Offset (integral part of the translation).
+  PointI _offset;
+  //! @brief Clipped bounding box (x1/y1 coordinates are outside).
+  BoxI _boundingBox;
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERMASKCACHE_P_H
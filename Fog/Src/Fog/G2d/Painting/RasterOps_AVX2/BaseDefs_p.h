@@ -0,0 +1,176 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEDEFS_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEDEFS_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Acc/AccAvx2.h>
+
+// [Dependencies - RasterOps_C]
+#include <Fog/G2d/Painting/RasterOps_C/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - Fallback]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief CBlit span slots delegated to the previous tier.
+enum FALLBACK_CBLIT_SPAN
+{
+  FALLBACK_CBLIT_SPAN_SRC_PRGB32 = 0,
+  FALLBACK_CBLIT_SPAN_SRC_XRGB32,
+  FALLBACK_CBLIT_SPAN_SRC_OVER_PRGB32,
+  FALLBACK_CBLIT_SPAN_SRC_OVER_XRGB32,
+  FALLBACK_CBLIT_SPAN_CLEAR_PRGB32,
+  FALLBACK_CBLIT_SPAN_CLEAR_XRGB32,
+
+  FALLBACK_CBLIT_SPAN_COUNT
+};
+
+//! @internal
+//!
+//! @brief VBlit span slots delegated to the previous tier.
+enum FALLBACK_VBLIT_SPAN
+{
+  FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_PRGB32 = 0,
+  FALLBACK_VBLIT_SPAN_SRC_PRGB32_AND_XRGB32,
+  FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_PRGB32,
+  FALLBACK_VBLIT_SPAN_SRC_XRGB32_AND_XRGB32,
+  FALLBACK_VBLIT_SPAN_SRC_OVER_PRGB32_AND_PRGB32,
+  FALLBACK_VBLIT_SPAN_SRC_OVER_XRGB32_AND_PRGB32,
+  FALLBACK_VBLIT_SPAN_CLEAR_PRGB32,
+  FALLBACK_VBLIT_SPAN_CLEAR_XRGB32,
+
+  FALLBACK_VBLIT_SPAN_COUNT
+};
+
+//! @internal
+//!
+//! @brief Pattern fetchers delegated to the previous tier.
+enum FALLBACK_FETCH
+{
+  FALLBACK_FETCH_LINEAR_PAD_PRGB32 = 0,
+  FALLBACK_FETCH_LINEAR_PAD_XRGB32,
+  FALLBACK_FETCH_LINEAR_REPEAT_PRGB32,
+  FALLBACK_FETCH_LINEAR_REPEAT_XRGB32,
+
+  FALLBACK_FETCH_COUNT
+};
+
+//! @internal
+//!
+//! @brief Functions of the previous tier the AVX2 tier delegates to.
+//!
+//! The AVX2 code handles only opaque spans and the common pattern cases, the
+//! rest is passed to whatever was installed before @c RasterOps_init_AVX2()
+//! replaced the function. The pointers are captured at runtime, this way the
+//! AVX2 translation unit never instantiates a C or SSE2 template (which could
+//! be merged by the linker with the VEX encoded copy).
+struct FOG_NO_EXPORT Fallback
+{
+  RasterCBlitSpanFunc cblit_span[FALLBACK_CBLIT_SPAN_COUNT];
+  RasterVBlitSpanFunc vblit_span[FALLBACK_VBLIT_SPAN_COUNT];
+  RasterPatternFetchFunc fetch[FALLBACK_FETCH_COUNT];
+};
+
+extern FOG_NO_EXPORT Fallback _fallback;
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// ============================================================================
+// [FOG_CBLIT_SPAN8_AVX2 - Opaque span in AVX2, the rest by the fallback]
+// ============================================================================
+
+#define FOG_CBLIT_SPAN8_AVX2_BEGIN(_Bpp_) \
+  uint8_t* dstBase = dst; \
+  \
+  do { \
+    uint x = (uint)span->getX0(); \
+    int w = (int)((uint)span->getX1() - x); \
+    FOG_ASSUME(w > 0); \
+    \
+    dst = dstBase + x * _Bpp_; \
+    const uint8_t* _msk = (const uint8_t*)reinterpret_cast<const RasterSpan8*>(span)->getGenericMask(); \
+    \
+    if (span->getType() == RASTER_SPAN_C && RasterSpan8::getConstMaskFromPointer(_msk) == 0x100) \
+    {
+
+#define FOG_CBLIT_SPAN8_AVX2_END(_Fallback_) \
+    } \
+    else \
+    { \
+      RasterSpan _single = *span; \
+      _single.setNext(NULL); \
+      _fallback.cblit_span[_Fallback_](dstBase, src, &_single, closure); \
+    } \
+  } while ((span = span->getNext()) != NULL);
+
+// ============================================================================
+// [FOG_VBLIT_SPAN8_AVX2 - Opaque span in AVX2, the rest by the fallback]
+// ============================================================================
+
+#define FOG_VBLIT_SPAN8_AVX2_BEGIN(_Bpp_) \
+  uint8_t* dstBase = dst; \
+  \
+  do { \
+    uint x = (uint)span->getX0(); \
+    int w = (int)((uint)span->getX1() - x); \
+    FOG_ASSUME(w > 0); \
+    \
+    dst = dstBase + x * _Bpp_; \
+    const uint8_t* _msk = (const uint8_t*)reinterpret_cast<const RasterSpan8*>(span)->getGenericMask(); \
+    \
+    if (span->getType() == RASTER_SPAN_C && RasterSpan8::getConstMaskFromPointer(_msk) == 0x100) \
+    { \
+      const uint8_t* src = (const uint8_t*)reinterpret_cast<const RasterSpan8*>(span)->getData(); \
+      FOG_UNUSED(src);
+
+#define FOG_VBLIT_SPAN8_AVX2_END(_Fallback_) \
+    } \
+    else \
+    { \
+      RasterSpan _single = *span; \
+      _single.setNext(NULL); \
+      _fallback.vblit_span[_Fallback_](dstBase, &_single, closure); \
+    } \
+  } while ((span = span->getNext()) != NULL);
+
+// ============================================================================
+// [FOG_BLIT_LOOP - 32x8 - 32-bits per pixel, 8 pixels in a main loop]
+// ============================================================================
+
+// The AVX2 loops don't align the destination, unaligned 256-bit loads and
+// stores are as fast as aligned ones when the data are aligned and the tail
+// (1-7 pixels) is handled by masked loads and stores.
+
+#define FOG_BLIT_LOOP_32x8_AVX2_INIT() \
+  FOG_ASSUME(w > 0); \
+  __m256i _tailMask;
+
+#define FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(_Group_) \
+  while (w >= 8) \
+  {
+
+#define FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(_Group_) \
+    w -= 8; \
+  }
+
+#define FOG_BLIT_LOOP_32x8_AVX2_TAIL_BEGIN(_Group_) \
+  if (w > 0) \
+  { \
+    Acc::m256iHeadMaskPI32(_tailMask, w);
+
+#define FOG_BLIT_LOOP_32x8_AVX2_TAIL_END(_Group_) \
+  }
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEDEFS_P_H
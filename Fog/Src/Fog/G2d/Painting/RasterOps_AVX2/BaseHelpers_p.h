@@ -0,0 +1,200 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEHELPERS_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEHELPERS_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - Helpers]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT Helpers
+{
+  // ==========================================================================
+  // [Helpers - Repeat]
+  // ==========================================================================
+
+  //! @brief Same as RasterOps_C::Helpers::p_repeat_integer(), duplicated so
+  //! the AVX2 translation unit doesn't depend on C helpers.
+  static FOG_INLINE int p_repeat_integer(int x, int y)
+  {
+    if ((uint)x >= (uint)y)
+    {
+      x %= y;
+      if (x < 0) x += y;
+    }
+
+    return x;
+  }
+
+  // ==========================================================================
+  // [Helpers - Fill]
+  // ==========================================================================
+
+  static FOG_INLINE uint8_t* p_fill_prgb32(uint8_t* dst, const __m256i& src0ymm, int w)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    while (w >= 32)
+    {
+      Acc::m256iStore32u(dst +  0, src0ymm);
+      Acc::m256iStore32u(dst + 32, src0ymm);
+      Acc::m256iStore32u(dst + 64, src0ymm);
+      Acc::m256iStore32u(dst + 96, src0ymm);
+
+      dst += 128;
+      w -= 32;
+    }
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(Fill)
+      Acc::m256iStore32u(dst, src0ymm);
+      dst += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(Fill)
+
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_BEGIN(Fill)
+      Acc::m256iStoreMaskPI32(dst, src0ymm, _tailMask);
+      dst += (uint)w * 4;
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_END(Fill)
+
+    return dst;
+  }
+
+  static FOG_INLINE uint8_t* p_fill_prgb32(uint8_t* dst, uint32_t c0, int w)
+  {
+    __m256i src0ymm;
+    Acc::m256iExtendPI32FromSI32(src0ymm, c0);
+    return p_fill_prgb32(dst, src0ymm, w);
+  }
+
+  // ==========================================================================
+  // [Helpers - Copy]
+  // ==========================================================================
+
+  //! @brief Copy @a w pixels, OR-ing each one by @a fill0ymm (zero to copy
+  //! PRGB32, 0xFF000000 to convert XRGB32 to PRGB32).
+  static FOG_INLINE uint8_t* p_copy_prgb32(
+    uint8_t* dst, const uint8_t* src, int w, const __m256i& fill0ymm)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    while (w >= 16)
+    {
+      __m256i src0ymm, src1ymm;
+
+      Acc::m256iLoad32u(src0ymm, src +  0);
+      Acc::m256iLoad32u(src1ymm, src + 32);
+      Acc::m256iOr(src0ymm, src0ymm, fill0ymm);
+      Acc::m256iOr(src1ymm, src1ymm, fill0ymm);
+      Acc::m256iStore32u(dst +  0, src0ymm);
+      Acc::m256iStore32u(dst + 32, src1ymm);
+
+      dst += 64;
+      src += 64;
+      w -= 16;
+    }
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i src0ymm;
+
+      Acc::m256iLoad32u(src0ymm, src);
+      Acc::m256iOr(src0ymm, src0ymm, fill0ymm);
+      Acc::m256iStore32u(dst, src0ymm);
+
+      dst += 32;
+      src += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_BEGIN(C_Opaque)
+      __m256i src0ymm;
+
+      Acc::m256iLoadMaskPI32(src0ymm, src, _tailMask);
+      Acc::m256iOr(src0ymm, src0ymm, fill0ymm);
+      Acc::m256iStoreMaskPI32(dst, src0ymm, _tailMask);
+      dst += (uint)w * 4;
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_END(C_Opaque)
+
+    return dst;
+  }
+
+  // ==========================================================================
+  // [Helpers - Gather]
+  // ==========================================================================
+
+  //! @brief Gather @a w (1-8) pixels from @a table indexed by @a idx0ymm.
+  static FOG_INLINE void p_gather_prgb32(uint8_t* dst, const uint32_t* table, const __m256i& idx0ymm, int w)
+  {
+    __m256i pix0ymm;
+
+    if (w >= 8)
+    {
+      Acc::m256iGatherPI32(pix0ymm, table, idx0ymm);
+      Acc::m256iStore32u(dst, pix0ymm);
+    }
+    else
+    {
+      __m256i msk0ymm;
+
+      // Indexes of the masked out lanes are valid as well, the gather is not
+      // masked to keep the code simple.
+      Acc::m256iHeadMaskPI32(msk0ymm, w);
+      Acc::m256iGatherPI32(pix0ymm, table, idx0ymm);
+      Acc::m256iStoreMaskPI32(dst, pix0ymm, msk0ymm);
+    }
+  }
+
+  // ==========================================================================
+  // [Helpers - Pattern - Solid - Fetch]
+  // ==========================================================================
+
+  static void FOG_FASTCALL p_solid_fetch_prgb32_xrgb32(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    __m256i c0ymm;
+    Acc::m256iExtendPI32FromSI32(c0ymm, fetcher->getContext()->_d.solid.prgb32.u32);
+
+    if (fetcher->getMode() == RASTER_FETCH_REFERENCE)
+    {
+      // All spans reference the same buffer, fill only the width needed by
+      // the largest span (see RasterOps_C::Helpers::p_solid_fetch_helper_prgb32).
+      int filledWidth = 0;
+
+      P_FETCH_SPAN8_INIT()
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CUSTOM(buffer)
+
+        if (filledWidth < w)
+        {
+          dst = p_fill_prgb32(dst, c0ymm, w - filledWidth);
+          filledWidth = w;
+        }
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+    else
+    {
+      P_FETCH_SPAN8_INIT()
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT()
+        dst = p_fill_prgb32(dst, c0ymm, w);
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEHELPERS_P_H
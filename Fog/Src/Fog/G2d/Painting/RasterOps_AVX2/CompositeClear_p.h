@@ -0,0 +1,115 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITECLEAR_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITECLEAR_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeClear]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeClear
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_CLEAR };
+
+  // ==========================================================================
+  // [PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_xblit_line(
+    uint8_t* dst, const void* src, int w, const RasterClosure* closure)
+  {
+    Helpers::p_fill_prgb32(dst, 0x00000000U, w);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_cblit_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    Acc::m256iZero(src0ymm);
+
+    FOG_CBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_fill_prgb32(dst, src0ymm, w);
+    FOG_CBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_vblit_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    Acc::m256iZero(src0ymm);
+
+    FOG_VBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_fill_prgb32(dst, src0ymm, w);
+    FOG_VBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+
+  // ==========================================================================
+  // [XRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL xrgb32_xblit_line(
+    uint8_t* dst, const void* src, int w, const RasterClosure* closure)
+  {
+    Helpers::p_fill_prgb32(dst, 0xFF000000U, w);
+  }
+
+  // ==========================================================================
+  // [XRGB32 - CBlit - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL xrgb32_cblit_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    Acc::m256iExtendPI32FromSI32(src0ymm, 0xFF000000U);
+
+    FOG_CBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_fill_prgb32(dst, src0ymm, w);
+    FOG_CBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+
+  // ==========================================================================
+  // [XRGB32 - VBlit - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL xrgb32_vblit_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    Acc::m256iExtendPI32FromSI32(src0ymm, 0xFF000000U);
+
+    FOG_VBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_fill_prgb32(dst, src0ymm, w);
+    FOG_VBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITECLEAR_P_H
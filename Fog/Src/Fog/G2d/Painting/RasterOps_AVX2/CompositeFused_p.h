@@ -0,0 +1,784 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEFUSED_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEFUSED_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrc_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrcOver_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/GradientLinear_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/TextureSimple_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedSource]
+// ============================================================================
+
+// Pixel sources of the AVX2 fused kernels, the vector versions of the sources
+// in RasterOps_C::CompositeFused (duplicated, because this translation unit
+// can't instantiate C templates, see RasterOps_AVX2::Fallback). The interface
+// is:
+//
+//   isSupported(ctx)        - Whether the pattern can be generated by the
+//                             source, otherwise the kernel calls the fetcher.
+//   Source(fetcher, x)      - Start at the first span, which begins at x.
+//   skip(n)                 - Skip a hole of n pixels between two spans.
+//   fetch(pix0ymm, n)       - Generate the next n (1-8) pixels into pix0ymm.
+//   getRun(w)               - Return a pointer to the next w pixels if they
+//                             are stored in the texture as PRGB32, NULL if
+//                             they have to be generated by fetch().
+//   advance(fetcher)        - Advance the fetcher to the next scanline.
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedSource - Texture - Align - Pad]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PTextureSimple::fetch_align_pad().
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedSource_TextureAlignPad
+{
+  static FOG_INLINE bool isSupported(const RasterPattern* ctx) { return true; }
+
+  FOG_INLINE PFusedSource_TextureAlignPad(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int y = fetcher->_d.texture.simple.py;
+    int th = ctx->_d.texture.base.h;
+
+    if (y < 0)
+      y = 0;
+    else if (y >= th)
+      y = th - 1;
+
+    _srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    _tw = ctx->_d.texture.base.w;
+    _x = x + ctx->_d.texture.simple.tx;
+
+    Acc::m256iExtendPI32FromSI32(_fill0ymm, Accessor::getFill());
+    Acc::m256iExtendPI32FromSI32(_max0ymm, (uint32_t)(_tw - 1));
+    Acc::m256iSeqPI32(_seq0ymm, 0, 1);
+  }
+
+  FOG_INLINE void skip(int n) { _x += n; }
+
+  FOG_INLINE void fetch(__m256i& pix0ymm, int n)
+  {
+    if (_x >= 0 && _x <= _tw - 8)
+    {
+      Acc::m256iLoad32u(pix0ymm, _srcLine + (uint)_x * Accessor::SRC_BPP);
+    }
+    else
+    {
+      __m256i idx0ymm;
+      __m256i zero0ymm;
+
+      Acc::m256iZero(zero0ymm);
+      Acc::m256iExtendPI32FromSI32(idx0ymm, (uint32_t)_x);
+      Acc::m256iAddPI32(idx0ymm, idx0ymm, _seq0ymm);
+      Acc::m256iMaxPI32(idx0ymm, idx0ymm, zero0ymm);
+      Acc::m256iMinPI32(idx0ymm, idx0ymm, _max0ymm);
+      Acc::m256iGatherPI32(pix0ymm, reinterpret_cast<const uint32_t*>(_srcLine), idx0ymm);
+    }
+
+    Acc::m256iOr(pix0ymm, pix0ymm, _fill0ymm);
+    _x += n;
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w)
+  {
+    if (!Accessor::FETCH_REFERENCE || _x < 0 || w > _tw - _x)
+      return NULL;
+
+    const uint8_t* src = _srcLine + (uint)_x * Accessor::SRC_BPP;
+    _x += w;
+    return src;
+  }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.texture.simple.py += fetcher->_d.texture.simple.dy;
+  }
+
+  const uint8_t* _srcLine;
+  int _tw;
+  int _x;
+
+  __m256i _fill0ymm;
+  __m256i _max0ymm;
+  __m256i _seq0ymm;
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedSource - Texture - Align - Repeat]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PTextureSimple::fetch_align_repeat().
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedSource_TextureAlignRepeat
+{
+  static FOG_INLINE bool isSupported(const RasterPattern* ctx) { return true; }
+
+  FOG_INLINE PFusedSource_TextureAlignRepeat(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int y = fetcher->_d.texture.simple.py;
+    FOG_ASSERT(y >= 0 && y < ctx->_d.texture.base.h);
+
+    _srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    _tw = ctx->_d.texture.base.w;
+    _x = Helpers::p_repeat_integer(x + ctx->_d.texture.simple.tx, _tw);
+
+    Acc::m256iExtendPI32FromSI32(_fill0ymm, Accessor::getFill());
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    _x += n;
+    if (_x >= _tw) _x %= _tw;
+  }
+
+  FOG_INLINE void fetch(__m256i& pix0ymm, int n)
+  {
+    if (_x <= _tw - 8)
+    {
+      Acc::m256iLoad32u(pix0ymm, _srcLine + (uint)_x * Accessor::SRC_BPP);
+    }
+    else
+    {
+      // The texture wraps inside of these eight pixels (possibly more than
+      // once if it's narrow).
+      int idx[8];
+      int k = _x;
+
+      for (int i = 0; i < 8; i++)
+      {
+        idx[i] = k;
+        if (++k == _tw) k = 0;
+      }
+
+      __m256i idx0ymm;
+      Acc::m256iLoad32u(idx0ymm, idx);
+      Acc::m256iGatherPI32(pix0ymm, reinterpret_cast<const uint32_t*>(_srcLine), idx0ymm);
+    }
+
+    Acc::m256iOr(pix0ymm, pix0ymm, _fill0ymm);
+    skip(n);
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w)
+  {
+    if (!Accessor::FETCH_REFERENCE || w > _tw - _x)
+      return NULL;
+
+    const uint8_t* src = _srcLine + (uint)_x * Accessor::SRC_BPP;
+    if ((_x += w) == _tw) _x = 0;
+    return src;
+  }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    int y = fetcher->_d.texture.simple.py + fetcher->_d.texture.simple.dy;
+    if (y >= fetcher->getContext()->_d.texture.base.h)
+      y -= fetcher->getContext()->_d.texture.base.h;
+    fetcher->_d.texture.simple.py = y;
+  }
+
+  const uint8_t* _srcLine;
+  int _tw;
+  int _x;
+
+  __m256i _fill0ymm;
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedSource - Texture - Scale - Nearest - Pad]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of the nearest scaled texture fetcher, PAD tiling.
+//!
+//! The fetcher isn't implemented by AVX2, the source generates the same pixels
+//! as the C and SSE2 versions. Source columns are calculated by scalar code
+//! and the pixels are gathered.
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedSource_TextureScaleNearestPad
+{
+  static FOG_INLINE bool isSupported(const RasterPattern* ctx) { return true; }
+
+  FOG_INLINE PFusedSource_TextureScaleNearestPad(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int th = ctx->_d.texture.base.h;
+    int py0 = Math::bound<int>((int)(fetcher->_d.texture.scale.py >> 32), 0, th - 1);
+
+    _srcLine = ctx->_d.texture.base.pixels + py0 * ctx->_d.texture.base.stride;
+    _tw = ctx->_d.texture.base.w;
+
+    _rx = ctx->_d.texture.scale.replicateX;
+    _rx0 = ctx->_d.texture.scale.replicateX0;
+
+    _px = ctx->_d.texture.scale.tx + (Fixed32x32)x * ctx->_d.texture.scale.xx;
+    _xx = ctx->_d.texture.scale.xx;
+
+    _x = x;
+    _k = 0;
+    _i = 0;
+    if (_rx) _seekReplicate();
+
+    Acc::m256iExtendPI32FromSI32(_fill0ymm, Accessor::getFill());
+    Acc::m256iExtendPI32FromSI32(_max0ymm, (uint32_t)(_tw - 1));
+  }
+
+  //! @brief Same as RasterOps_C::PTextureScale::floorDiv().
+  static FOG_INLINE int _floorDiv(int a, int b)
+  {
+    int q = a / b;
+    if (q * b != a && a < 0) q--;
+    return q;
+  }
+
+  FOG_INLINE void _seekReplicate()
+  {
+    int d = _x - _rx0;
+
+    _k = _floorDiv(d, _rx);
+    _i = _rx - (d - _k * _rx);
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    if (_rx)
+    {
+      _x += n;
+      _seekReplicate();
+    }
+    else
+    {
+      _px += (Fixed32x32)n * _xx;
+    }
+  }
+
+  FOG_INLINE void fetch(__m256i& pix0ymm, int n)
+  {
+    int idx[8];
+    int i = 0;
+
+    if (_rx)
+    {
+      _x += n;
+
+      do {
+        idx[i] = _k;
+        if (--_i == 0)
+        {
+          _i = _rx;
+          _k++;
+        }
+      } while (++i < n);
+    }
+    else
+    {
+      do {
+        idx[i] = (int)(_px >> 32);
+        _px += _xx;
+      } while (++i < n);
+    }
+
+    // Lanes past n are not stored, but they must be valid indexes.
+    while (i < 8)
+    {
+      idx[i] = idx[i - 1];
+      i++;
+    }
+
+    __m256i idx0ymm;
+    __m256i zero0ymm;
+
+    Acc::m256iZero(zero0ymm);
+    Acc::m256iLoad32u(idx0ymm, idx);
+    Acc::m256iMaxPI32(idx0ymm, idx0ymm, zero0ymm);
+    Acc::m256iMinPI32(idx0ymm, idx0ymm, _max0ymm);
+
+    Acc::m256iGatherPI32(pix0ymm, reinterpret_cast<const uint32_t*>(_srcLine), idx0ymm);
+    Acc::m256iOr(pix0ymm, pix0ymm, _fill0ymm);
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w) { return NULL; }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.texture.scale.py += fetcher->_d.texture.scale.dy;
+  }
+
+  const uint8_t* _srcLine;
+  int _tw;
+
+  int _rx;
+  int _rx0;
+  int _x;
+  int _k;
+  int _i;
+
+  Fixed32x32 _px;
+  Fixed32x32 _xx;
+
+  __m256i _fill0ymm;
+  __m256i _max0ymm;
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedSource - Gradient - Linear - Pad]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PGradientLinear::fetch_simple_nearest_pad().
+struct FOG_NO_EXPORT PFusedSource_GradientLinearPad
+{
+  static FOG_INLINE bool isSupported(const RasterPattern* ctx)
+  {
+    int xx = ctx->_d.gradient.linear.simple.xx16x16;
+    return xx > -0x01000000 && xx < 0x01000000;
+  }
+
+  FOG_INLINE PFusedSource_GradientLinearPad(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+    _xx = ctx->_d.gradient.linear.simple.xx16x16;
+    _len = ctx->_d.gradient.base.len16x16;
+    _pos = Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * _xx;
+
+    Acc::m256iSeqPI32(_seq0ymm, 0, _xx);
+    Acc::m256iExtendPI32FromSI32(_max0ymm, (uint32_t)ctx->_d.gradient.base.len);
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    _pos = PGradientLinear::_advance_pad(_pos, (int64_t)n * _xx, _xx, _len);
+  }
+
+  FOG_INLINE void fetch(__m256i& pix0ymm, int n)
+  {
+    __m256i idx0ymm;
+    __m256i zero0ymm;
+
+    Acc::m256iZero(zero0ymm);
+    Acc::m256iExtendPI32FromSI32(idx0ymm, (uint32_t)_pos);
+    Acc::m256iAddPI32(idx0ymm, idx0ymm, _seq0ymm);
+    Acc::m256iRShiftPI32<16>(idx0ymm, idx0ymm);
+    Acc::m256iMaxPI32(idx0ymm, idx0ymm, zero0ymm);
+    Acc::m256iMinPI32(idx0ymm, idx0ymm, _max0ymm);
+
+    Acc::m256iGatherPI32(pix0ymm, _table, idx0ymm);
+    skip(n);
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w) { return NULL; }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  const uint32_t* _table;
+  int _xx;
+  int _len;
+  int _pos;
+
+  __m256i _seq0ymm;
+  __m256i _max0ymm;
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedSource - Gradient - Linear - Repeat]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PGradientLinear::fetch_simple_nearest_repeat().
+//!
+//! Positions of the next eight pixels are kept in a register and advanced by
+//! (8 * xx) mod len, they are rebuilt by scalar code only after a hole or at
+//! the end of a span.
+struct FOG_NO_EXPORT PFusedSource_GradientLinearRepeat
+{
+  static FOG_INLINE bool isSupported(const RasterPattern* ctx)
+  {
+    int xx = ctx->_d.gradient.linear.simple.xx16x16;
+    int len = ctx->_d.gradient.base.len16x16;
+    return xx > -len && xx < len;
+  }
+
+  FOG_INLINE PFusedSource_GradientLinearRepeat(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+    _xx = ctx->_d.gradient.linear.simple.xx16x16;
+    _len = ctx->_d.gradient.base.len16x16;
+
+    int step = (int)(((int64_t)_xx * 8) % _len);
+    if (step < 0) step += _len;
+
+    Acc::m256iExtendPI32FromSI32(_step0ymm, (uint32_t)step);
+    Acc::m256iExtendPI32FromSI32(_len0ymm, (uint32_t)_len);
+    Acc::m256iExtendPI32FromSI32(_lm10ymm, (uint32_t)(_len - 1));
+
+    _seek(Helpers::p_repeat_integer(
+      Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * _xx, _len));
+  }
+
+  //! @brief Set the position of the next pixel to @a pos, lane 0 is @a pos
+  //! (it can be equal to len after a hole, see the C version), lanes 1-7 are
+  //! the wrapped successors.
+  FOG_INLINE void _seek(int pos)
+  {
+    int p[8];
+    p[0] = pos;
+
+    for (int k = 1; k < 8; k++)
+    {
+      int64_t t = ((int64_t)pos + (int64_t)k * _xx) % _len;
+      p[k] = (int)(t < 0 ? t + _len : t);
+    }
+
+    Acc::m256iLoad32u(_pos0ymm, p);
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    int p[8];
+    Acc::m256iStore32u(p, _pos0ymm);
+
+    int pos = p[0];
+    if (_xx > 0)
+    {
+      pos = (int)((uint)pos + (uint)_xx * (uint)n);
+      if (pos > _len) pos %= _len;
+    }
+    else if (_xx < 0)
+    {
+      pos = Helpers::p_repeat_integer((int)((uint)pos + (uint)_xx * (uint)n), _len);
+    }
+
+    _seek(pos);
+  }
+
+  FOG_INLINE void fetch(__m256i& pix0ymm, int n)
+  {
+    __m256i idx0ymm;
+
+    Acc::m256iRShiftPI32<16>(idx0ymm, _pos0ymm);
+    Acc::m256iGatherPI32(pix0ymm, _table, idx0ymm);
+
+    if (n == 8)
+    {
+      __m256i cmp0ymm;
+
+      // pos = (pos + step) >= len ? pos + step - len : pos + step.
+      Acc::m256iAddPI32(_pos0ymm, _pos0ymm, _step0ymm);
+      Acc::m256iCmpGtPI32(cmp0ymm, _pos0ymm, _lm10ymm);
+      Acc::m256iAnd(cmp0ymm, cmp0ymm, _len0ymm);
+      Acc::m256iSubPI32(_pos0ymm, _pos0ymm, cmp0ymm);
+    }
+    else
+    {
+      int p[8];
+      Acc::m256iStore32u(p, _pos0ymm);
+      _seek(p[n]);
+    }
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w) { return NULL; }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  const uint32_t* _table;
+  int _xx;
+  int _len;
+
+  __m256i _pos0ymm;
+  __m256i _step0ymm;
+  __m256i _len0ymm;
+  __m256i _lm10ymm;
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PFusedOp]
+// ============================================================================
+
+// Operators of the AVX2 fused kernels, pixels() composites eight pixels and
+// pixelsMask() the lanes selected by a head mask. The line() function is used
+// for runs referenced directly from the texture.
+
+//! @internal
+//!
+//! @brief Fused SRC operator, PRGB32 destination and PRGB32 source (AVX2).
+struct FOG_NO_EXPORT PFusedOp_Src_PRGB32
+{
+  static FOG_INLINE void pixels(uint8_t* dst, const __m256i& src0ymm)
+  {
+    Acc::m256iStore32u(dst, src0ymm);
+  }
+
+  static FOG_INLINE void pixelsMask(uint8_t* dst, const __m256i& src0ymm, const __m256i& msk0ymm)
+  {
+    Acc::m256iStoreMaskPI32(dst, src0ymm, msk0ymm);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w)
+  {
+    CompositeSrc::prgb32_vblit_prgb32_line(dst, src, w, NULL);
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused SRC operator, the alpha of the result is forced to 0xFF
+//! (PRGB32 destination and XRGB32 source, or XRGB32 destination) (AVX2).
+struct FOG_NO_EXPORT PFusedOp_Src_XRGB32
+{
+  static FOG_INLINE void pixels(uint8_t* dst, const __m256i& src0ymm)
+  {
+    __m256i dst0ymm;
+
+    Acc::m256iExtendPI32FromSI32(dst0ymm, 0xFF000000);
+    Acc::m256iOr(dst0ymm, dst0ymm, src0ymm);
+    Acc::m256iStore32u(dst, dst0ymm);
+  }
+
+  static FOG_INLINE void pixelsMask(uint8_t* dst, const __m256i& src0ymm, const __m256i& msk0ymm)
+  {
+    __m256i dst0ymm;
+
+    Acc::m256iExtendPI32FromSI32(dst0ymm, 0xFF000000);
+    Acc::m256iOr(dst0ymm, dst0ymm, src0ymm);
+    Acc::m256iStoreMaskPI32(dst, dst0ymm, msk0ymm);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w)
+  {
+    CompositeSrc::prgb32_vblit_xrgb32_line(dst, src, w, NULL);
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused SRC_OVER operator, PRGB32 or XRGB32 destination and PRGB32
+//! source (AVX2).
+struct FOG_NO_EXPORT PFusedOp_SrcOver_PRGB32
+{
+  static FOG_INLINE void pixels(uint8_t* dst, const __m256i& src0ymm)
+  {
+    __m256i dst0ymm;
+
+    Acc::m256iLoad32u(dst0ymm, dst);
+    CompositeSrcOver::_prgb32_vblit_prgb32_pixels(dst0ymm, src0ymm);
+    Acc::m256iStore32u(dst, dst0ymm);
+  }
+
+  static FOG_INLINE void pixelsMask(uint8_t* dst, const __m256i& src0ymm, const __m256i& msk0ymm)
+  {
+    __m256i dst0ymm;
+
+    Acc::m256iLoadMaskPI32(dst0ymm, dst, msk0ymm);
+    CompositeSrcOver::_prgb32_vblit_prgb32_pixels(dst0ymm, src0ymm);
+    Acc::m256iStoreMaskPI32(dst, dst0ymm, msk0ymm);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w)
+  {
+    CompositeSrcOver::_prgb32_vblit_prgb32_line(dst, src, w);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeFused]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused fetch+composite kernels (AVX2).
+//!
+//! Opaque const-mask spans are generated and composited eight pixels at a
+//! time without touching the span buffer, other spans are generated into the
+//! buffer and passed to @a BlitFunc (which delegates them to the previous
+//! tier). Patterns not supported by the source are fetched and blitted.
+struct FOG_NO_EXPORT CompositeFused
+{
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  //! @brief Generate @a w pixels of a masked span into @a buffer and composite
+  //! them by @a BlitFunc.
+  template<typename Source, RasterVBlitSpanFunc BlitFunc>
+  static FOG_INLINE void _blitMasked(
+    uint8_t* dstBase, const RasterSpan* span, Source& source, int w,
+    uint8_t* buffer, const RasterClosure* closure)
+  {
+    RasterSpan8 single = *reinterpret_cast<const RasterSpan8*>(span);
+    single.setData(buffer);
+    single.setNext(NULL);
+
+    __m256i pix0ymm;
+
+    while (w >= 8)
+    {
+      source.fetch(pix0ymm, 8);
+      Acc::m256iStore32u(buffer, pix0ymm);
+
+      buffer += 32;
+      w -= 8;
+    }
+
+    if (w > 0)
+    {
+      __m256i msk0ymm;
+
+      source.fetch(pix0ymm, w);
+      Acc::m256iHeadMaskPI32(msk0ymm, w);
+      Acc::m256iStoreMaskPI32(buffer, pix0ymm, msk0ymm);
+    }
+
+    BlitFunc(dstBase, &single, closure);
+  }
+
+  // ==========================================================================
+  // [Span]
+  // ==========================================================================
+
+  template<typename Source, typename Op, RasterVBlitSpanFunc BlitFunc>
+  static void FOG_FASTCALL span(
+    uint8_t* dst, RasterSpan* span,
+    RasterPatternFetcher* fetcher, uint8_t* buffer,
+    const RasterClosure* closure)
+  {
+    if (!Source::isSupported(fetcher->getContext()))
+    {
+      fetcher->fetch(span, buffer);
+      BlitFunc(dst, span, closure);
+      return;
+    }
+
+    uint8_t* dstBase = dst;
+
+    int x = (int)span->getX0();
+    Source source(fetcher, x);
+
+    for (;;)
+    {
+      int w = (int)span->getX1() - x;
+      FOG_ASSERT(w > 0);
+
+      if (span->getType() == RASTER_SPAN_C && reinterpret_cast<const RasterSpan8*>(span)->isConstMaskOpaque())
+      {
+        const uint8_t* src = source.getRun(w);
+        dst = dstBase + (uint)x * 4;
+
+        if (src != NULL)
+        {
+          Op::line(dst, src, w);
+        }
+        else
+        {
+          __m256i pix0ymm;
+
+          while (w >= 8)
+          {
+            source.fetch(pix0ymm, 8);
+            Op::pixels(dst, pix0ymm);
+
+            dst += 32;
+            w -= 8;
+          }
+
+          if (w > 0)
+          {
+            __m256i msk0ymm;
+
+            source.fetch(pix0ymm, w);
+            Acc::m256iHeadMaskPI32(msk0ymm, w);
+            Op::pixelsMask(dst, pix0ymm, msk0ymm);
+          }
+        }
+      }
+      else
+      {
+        _blitMasked<Source, BlitFunc>(dstBase, span, source, w, buffer, closure);
+      }
+
+      int xEnd = (int)span->getX1();
+      if ((span = span->getNext()) == NULL)
+        break;
+
+      x = (int)span->getX0();
+      if (x != xEnd)
+        source.skip(x - xEnd);
+    }
+
+    source.advance(fetcher);
+  }
+
+  // ==========================================================================
+  // [Add]
+  // ==========================================================================
+
+  template<typename Source, typename Op, RasterVBlitSpanFunc BlitFunc>
+  static FOG_INLINE void add(RasterFusedFuncs& fused, RasterPatternFetchFunc fetch)
+  {
+    fused.add(fetch, BlitFunc, span<Source, Op, BlitFunc>);
+  }
+
+  //! @brief Add kernels for the hot PRGB32 pattern fetchers composited by
+  //! @a BlitFunc.
+  //!
+  //! The scaled texture fetchers come from the previous tier, they are keyed
+  //! by the function pointers found in @a texture.
+  template<typename Op, RasterVBlitSpanFunc BlitFunc>
+  static void addPRGB32Fetchers(RasterFusedFuncs& fused, const RasterTextureFuncs& texture)
+  {
+    typedef PTextureAccessor_PRGB32_From_PRGB32 Accessor_PRGB32;
+    typedef PTextureAccessor_PRGB32_From_XRGB32 Accessor_XRGB32;
+
+    add<PFusedSource_TextureAlignPad   <Accessor_PRGB32>, Op, BlitFunc>(fused, PTextureSimple::fetch_align_pad   <Accessor_PRGB32>);
+    add<PFusedSource_TextureAlignPad   <Accessor_XRGB32>, Op, BlitFunc>(fused, PTextureSimple::fetch_align_pad   <Accessor_XRGB32>);
+    add<PFusedSource_TextureAlignRepeat<Accessor_PRGB32>, Op, BlitFunc>(fused, PTextureSimple::fetch_align_repeat<Accessor_PRGB32>);
+    add<PFusedSource_TextureAlignRepeat<Accessor_XRGB32>, Op, BlitFunc>(fused, PTextureSimple::fetch_align_repeat<Accessor_XRGB32>);
+
+    add<PFusedSource_TextureScaleNearestPad<Accessor_PRGB32>, Op, BlitFunc>(fused, texture.prgb32.fetch_scale_nearest[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD]);
+    add<PFusedSource_TextureScaleNearestPad<Accessor_XRGB32>, Op, BlitFunc>(fused, texture.prgb32.fetch_scale_nearest[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD]);
+
+    add<PFusedSource_GradientLinearPad   , Op, BlitFunc>(fused, PGradientLinear::fetch_simple_nearest_pad   <FALLBACK_FETCH_LINEAR_PAD_PRGB32   >);
+    add<PFusedSource_GradientLinearPad   , Op, BlitFunc>(fused, PGradientLinear::fetch_simple_nearest_pad   <FALLBACK_FETCH_LINEAR_PAD_XRGB32   >);
+    add<PFusedSource_GradientLinearRepeat, Op, BlitFunc>(fused, PGradientLinear::fetch_simple_nearest_repeat<FALLBACK_FETCH_LINEAR_REPEAT_PRGB32>);
+    add<PFusedSource_GradientLinearRepeat, Op, BlitFunc>(fused, PGradientLinear::fetch_simple_nearest_repeat<FALLBACK_FETCH_LINEAR_REPEAT_XRGB32>);
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEFUSED_P_H
@@ -0,0 +1,191 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRCOVER_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRCOVER_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrc_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeSrcOver]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief SrcOver operator (AVX2).
+//!
+//! The arithmetic is the same as in RasterOps_SSE2::CompositeSrcOver (main
+//! loop), so both tiers produce identical pixels.
+struct FOG_NO_EXPORT CompositeSrcOver
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_SRC_OVER };
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb32_cblit_prgb32_pixels(
+    __m256i& dst0ymm, const __m256i& src0ymm, const __m256i& sra0ymm)
+  {
+    __m256i dst1ymm;
+
+    Acc::m256iUnpackPI16FromPI8Hi(dst1ymm, dst0ymm);
+    Acc::m256iUnpackPI16FromPI8Lo(dst0ymm, dst0ymm);
+    Acc::m256iMulHiPU16(dst0ymm, dst0ymm, sra0ymm);
+    Acc::m256iMulHiPU16(dst1ymm, dst1ymm, sra0ymm);
+    Acc::m256iPackPU8FromPU16(dst0ymm, dst0ymm, dst1ymm);
+    Acc::m256iAddPI16(dst0ymm, dst0ymm, src0ymm);
+  }
+
+  static FOG_INLINE void _prgb32_cblit_prgb32_line(
+    uint8_t* dst, int w, const __m256i& src0ymm, const __m256i& sra0ymm)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i dst0ymm;
+
+      Acc::m256iLoad32u(dst0ymm, dst);
+      _prgb32_cblit_prgb32_pixels(dst0ymm, src0ymm, sra0ymm);
+      Acc::m256iStore32u(dst, dst0ymm);
+
+      dst += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_BEGIN(C_Opaque)
+      __m256i dst0ymm;
+
+      Acc::m256iLoadMaskPI32(dst0ymm, dst, _tailMask);
+      _prgb32_cblit_prgb32_pixels(dst0ymm, src0ymm, sra0ymm);
+      Acc::m256iStoreMaskPI32(dst, dst0ymm, _tailMask);
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_END(C_Opaque)
+  }
+
+  //! @brief Prepare the source pixel and its inverted alpha shifted left by 8
+  //! bits (the dst * (255 - sa) >> 8 approximation used by SSE2).
+  static FOG_INLINE void _prgb32_cblit_prgb32_prepare(
+    __m256i& src0ymm, __m256i& sra0ymm, uint32_t src0)
+  {
+    Acc::m256iExtendPI32FromSI32(src0ymm, src0);
+    Acc::m256iExtendPI16FromSI16(sra0ymm, (255 - (src0 >> 24)) << 8);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_cblit_prgb32_line(
+    uint8_t* dst, const RasterSolid* src, int w, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    __m256i sra0ymm;
+
+    _prgb32_cblit_prgb32_prepare(src0ymm, sra0ymm, src->prgb32.u32);
+    _prgb32_cblit_prgb32_line(dst, w, src0ymm, sra0ymm);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_cblit_prgb32_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    __m256i sra0ymm;
+
+    _prgb32_cblit_prgb32_prepare(src0ymm, sra0ymm, src->prgb32.u32);
+
+    FOG_CBLIT_SPAN8_AVX2_BEGIN(4)
+      _prgb32_cblit_prgb32_line(dst, w, src0ymm, sra0ymm);
+    FOG_CBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb32_vblit_prgb32_pixels(
+    __m256i& dst0ymm, const __m256i& src0ymm)
+  {
+    __m256i dst1ymm;
+    __m256i sra0ymm, sra1ymm;
+
+    Acc::m256iFill(sra0ymm);
+    Acc::m256iXor(sra0ymm, sra0ymm, src0ymm);
+    Acc::m256iUnpackAlphaPI16FromARGB32_PI8(sra0ymm, sra1ymm, sra0ymm);
+
+    Acc::m256iUnpackPI16FromPI8Hi(dst1ymm, dst0ymm);
+    Acc::m256iUnpackPI16FromPI8Lo(dst0ymm, dst0ymm);
+    Acc::m256iMulDiv255PI16(dst0ymm, dst0ymm, sra0ymm);
+    Acc::m256iMulDiv255PI16(dst1ymm, dst1ymm, sra1ymm);
+    Acc::m256iPackPU8FromPU16(dst0ymm, dst0ymm, dst1ymm);
+    Acc::m256iAddPI32(dst0ymm, dst0ymm, src0ymm);
+  }
+
+  static FOG_INLINE void _prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i dst0ymm;
+      __m256i src0ymm;
+
+      Acc::m256iLoad32u(src0ymm, src);
+      Acc::m256iLoad32u(dst0ymm, dst);
+      _prgb32_vblit_prgb32_pixels(dst0ymm, src0ymm);
+      Acc::m256iStore32u(dst, dst0ymm);
+
+      dst += 32;
+      src += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_BEGIN(C_Opaque)
+      __m256i dst0ymm;
+      __m256i src0ymm;
+
+      Acc::m256iLoadMaskPI32(src0ymm, src, _tailMask);
+      Acc::m256iLoadMaskPI32(dst0ymm, dst, _tailMask);
+      _prgb32_vblit_prgb32_pixels(dst0ymm, src0ymm);
+      Acc::m256iStoreMaskPI32(dst, dst0ymm, _tailMask);
+    FOG_BLIT_LOOP_32x8_AVX2_TAIL_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    _prgb32_vblit_prgb32_line(dst, src, w);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_vblit_prgb32_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    FOG_VBLIT_SPAN8_AVX2_BEGIN(4)
+      _prgb32_vblit_prgb32_line(dst, src, w);
+    FOG_VBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRCOVER_P_H
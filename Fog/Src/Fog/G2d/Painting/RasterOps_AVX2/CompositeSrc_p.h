@@ -0,0 +1,115 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRC_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRC_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeSrc]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeSrc
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_SRC };
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_cblit_prgb32_line(
+    uint8_t* dst, const RasterSolid* src, int w, const RasterClosure* closure)
+  {
+    Helpers::p_fill_prgb32(dst, src->prgb32.u32, w);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_cblit_prgb32_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i src0ymm;
+    Acc::m256iExtendPI32FromSI32(src0ymm, src->prgb32.u32);
+
+    FOG_CBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_fill_prgb32(dst, src0ymm, w);
+    FOG_CBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    __m256i fill0ymm;
+    Acc::m256iZero(fill0ymm);
+
+    Helpers::p_copy_prgb32(dst, src, w, fill0ymm);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_vblit_prgb32_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i fill0ymm;
+    Acc::m256iZero(fill0ymm);
+
+    FOG_VBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_copy_prgb32(dst, src, w, fill0ymm);
+    FOG_VBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - XRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_xrgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    __m256i fill0ymm;
+    Acc::m256iExtendPI32FromSI32(fill0ymm, 0xFF000000);
+
+    Helpers::p_copy_prgb32(dst, src, w, fill0ymm);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - XRGB32 - Span]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL prgb32_vblit_xrgb32_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i fill0ymm;
+    Acc::m256iExtendPI32FromSI32(fill0ymm, 0xFF000000);
+
+    FOG_VBLIT_SPAN8_AVX2_BEGIN(4)
+      Helpers::p_copy_prgb32(dst, src, w, fill0ymm);
+    FOG_VBLIT_SPAN8_AVX2_END(FallbackId)
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRC_P_H
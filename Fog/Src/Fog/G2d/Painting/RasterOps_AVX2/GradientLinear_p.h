@@ -0,0 +1,226 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTLINEAR_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTLINEAR_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PGradientLinear]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Linear gradient fetchers (AVX2).
+//!
+//! Eight positions are calculated at once and the colors are gathered from
+//! the gradient table. The results are identical to RasterOps_C, gradients
+//! with a step larger than 256 table entries per pixel are delegated to the
+//! previous tier (to keep the vector arithmetic in 32-bit range).
+struct FOG_NO_EXPORT PGradientLinear
+{
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  //! @brief Advance the pad position by @a d, saturating in the direction of
+  //! @a xx. Once the position is out of the table it's never used again, so
+  //! saturation can't change the result, but it prevents 32-bit overflow.
+  static FOG_INLINE int _advance_pad(int pos, int64_t d, int xx, int len)
+  {
+    int64_t p = (int64_t)pos + d;
+
+    if (xx > 0)
+    {
+      if (p > len) p = len;
+    }
+    else
+    {
+      if (p < -0x10000) p = -0x10000;
+    }
+
+    return (int)p;
+  }
+
+  // ==========================================================================
+  // [Fetch - Simple - Nearest - Pad]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL fetch_simple_nearest_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int xx = ctx->_d.gradient.linear.simple.xx16x16;
+    if (xx <= -0x01000000 || xx >= 0x01000000)
+    {
+      _fallback.fetch[FallbackId](fetcher, span, buffer);
+      return;
+    }
+
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+    int len = ctx->_d.gradient.base.len16x16;
+
+    P_FETCH_SPAN8_INIT()
+
+    int pos = Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * xx;
+
+    __m256i seq0ymm;
+    __m256i max0ymm;
+    __m256i zero0ymm;
+
+    Acc::m256iSeqPI32(seq0ymm, 0, xx);
+    Acc::m256iExtendPI32FromSI32(max0ymm, (uint32_t)ctx->_d.gradient.base.len);
+    Acc::m256iZero(zero0ymm);
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      for (;;)
+      {
+        __m256i idx0ymm;
+
+        // Index is clamp(pos >> 16, 0, len), this is exactly what the C
+        // version does by switching between the c0, table and c1 loops.
+        Acc::m256iExtendPI32FromSI32(idx0ymm, (uint32_t)pos);
+        Acc::m256iAddPI32(idx0ymm, idx0ymm, seq0ymm);
+        Acc::m256iRShiftPI32<16>(idx0ymm, idx0ymm);
+        Acc::m256iMaxPI32(idx0ymm, idx0ymm, zero0ymm);
+        Acc::m256iMinPI32(idx0ymm, idx0ymm, max0ymm);
+
+        int i = Math::min(w, 8);
+        Helpers::p_gather_prgb32(dst, table, idx0ymm, i);
+
+        dst += (uint)i * 4;
+        pos = _advance_pad(pos, (int64_t)i * xx, xx, len);
+
+        if ((w -= i) == 0)
+          break;
+      }
+
+      P_FETCH_SPAN8_HOLE(
+      {
+        pos = _advance_pad(pos, (int64_t)hole * xx, xx, len);
+      })
+    P_FETCH_SPAN8_END()
+
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  // ==========================================================================
+  // [Fetch - Simple - Nearest - Repeat]
+  // ==========================================================================
+
+  template<uint FallbackId>
+  static void FOG_FASTCALL fetch_simple_nearest_repeat(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int xx = ctx->_d.gradient.linear.simple.xx16x16;
+    int len = ctx->_d.gradient.base.len16x16;
+
+    // The C version wraps the position only once per pixel, so it's only
+    // defined for steps smaller than the table.
+    if (xx <= -len || xx >= len)
+    {
+      _fallback.fetch[FallbackId](fetcher, span, buffer);
+      return;
+    }
+
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+
+    P_FETCH_SPAN8_INIT()
+
+    int pos = Helpers::p_repeat_integer(
+      Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * xx, len);
+
+    // Positions of eight consecutive pixels are advanced by (8 * xx) mod len,
+    // each lane stays in [0, len) by a single conditional subtraction.
+    int step = (int)(((int64_t)xx * 8) % len);
+    if (step < 0) step += len;
+
+    __m256i step0ymm;
+    __m256i len0ymm;
+    __m256i lm10ymm;
+
+    Acc::m256iExtendPI32FromSI32(step0ymm, (uint32_t)step);
+    Acc::m256iExtendPI32FromSI32(len0ymm, (uint32_t)len);
+    Acc::m256iExtendPI32FromSI32(lm10ymm, (uint32_t)(len - 1));
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      // Lane 0 is the current position (it can be equal to len after a hole,
+      // see the C version), lanes 1-7 are the wrapped successors.
+      __m256i pos0ymm;
+      {
+        int p[8];
+        p[0] = pos;
+
+        for (int k = 1; k < 8; k++)
+        {
+          int64_t t = ((int64_t)pos + (int64_t)k * xx) % len;
+          p[k] = (int)(t < 0 ? t + len : t);
+        }
+
+        Acc::m256iLoad32u(pos0ymm, p);
+      }
+
+      int64_t end = ((int64_t)pos + (int64_t)w * xx) % len;
+      pos = (int)(end < 0 ? end + len : end);
+
+      for (;;)
+      {
+        __m256i idx0ymm;
+        __m256i cmp0ymm;
+
+        Acc::m256iRShiftPI32<16>(idx0ymm, pos0ymm);
+
+        int i = Math::min(w, 8);
+        Helpers::p_gather_prgb32(dst, table, idx0ymm, i);
+        dst += (uint)i * 4;
+
+        if ((w -= i) == 0)
+          break;
+
+        // pos = (pos + step) >= len ? pos + step - len : pos + step.
+        Acc::m256iAddPI32(pos0ymm, pos0ymm, step0ymm);
+        Acc::m256iCmpGtPI32(cmp0ymm, pos0ymm, lm10ymm);
+        Acc::m256iAnd(cmp0ymm, cmp0ymm, len0ymm);
+        Acc::m256iSubPI32(pos0ymm, pos0ymm, cmp0ymm);
+      }
+
+      P_FETCH_SPAN8_HOLE(
+      {
+        if (xx > 0)
+        {
+          pos = (int)((uint)pos + (uint)xx * (uint)hole);
+          if (pos > len) pos %= len;
+        }
+        else
+        {
+          pos = Helpers::p_repeat_integer((int)((uint)pos + (uint)xx * (uint)hole), len);
+        }
+      })
+    P_FETCH_SPAN8_END()
+
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTLINEAR_P_H
@@ -0,0 +1,204 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTRADIAL_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTRADIAL_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PGradientAccessor]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Convert four gradient positions to table indexes (pad).
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Pad
+{
+  FOG_INLINE PGradientAccessor_PRGB32_Pad(const RasterPattern* ctx)
+  {
+    Acc::m256dExtendPD(_len, (double)ctx->_d.gradient.base.len);
+  }
+
+  FOG_INLINE void indexAtD(__m128i& dst, const __m256d& d)
+  {
+    __m256d t;
+    __m256d zero;
+
+    zero = _mm256_setzero_pd();
+    Acc::m256dMaxPD(t, d, zero);
+    Acc::m256dMinPD(t, t, _len);
+    Acc::m128iTruncPI32FromPD(dst, t);
+  }
+
+  __m256d _len;
+};
+
+//! @internal
+//!
+//! @brief Convert four gradient positions to table indexes (repeat).
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Repeat
+{
+  FOG_INLINE PGradientAccessor_PRGB32_Repeat(const RasterPattern* ctx)
+  {
+    _lenMask = _mm_set1_epi32(ctx->_d.gradient.base.len - 1);
+  }
+
+  FOG_INLINE void indexAtD(__m128i& dst, const __m256d& d)
+  {
+    Acc::m128iTruncPI32FromPD(dst, d);
+    dst = _mm_and_si128(dst, _lenMask);
+  }
+
+  __m128i _lenMask;
+};
+
+//! @internal
+//!
+//! @brief Convert four gradient positions to table indexes (reflect).
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Reflect
+{
+  FOG_INLINE PGradientAccessor_PRGB32_Reflect(const RasterPattern* ctx)
+  {
+    _len = _mm_set1_epi32(ctx->_d.gradient.base.len);
+    _lenMask2 = _mm_set1_epi32(ctx->_d.gradient.base.len * 2 - 1);
+  }
+
+  FOG_INLINE void indexAtD(__m128i& dst, const __m256d& d)
+  {
+    __m128i cmp;
+
+    Acc::m128iTruncPI32FromPD(dst, d);
+    dst = _mm_and_si128(dst, _lenMask2);
+    cmp = _mm_cmpgt_epi32(dst, _len);
+    dst = _mm_xor_si128(dst, _mm_and_si128(cmp, _lenMask2));
+  }
+
+  __m128i _len;
+  __m128i _lenMask2;
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PGradientRadial]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Radial gradient fetcher (AVX2).
+//!
+//! The quadratic recurrence is evaluated in scalar code exactly like in
+//! RasterOps_C::PGradientRadial, the square root, scaling and index
+//! calculation are done for eight pixels at once, so the result is bit-exact.
+struct FOG_NO_EXPORT PGradientRadial
+{
+  // ==========================================================================
+  // [Fetch - Simple - Nearest]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_simple_nearest(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+
+    Accessor accessor(ctx);
+
+    __m256d scale;
+    Acc::m256dExtendPD(scale, ctx->_d.gradient.radial.simple.scale);
+
+    P_FETCH_SPAN8_INIT()
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      double _x    = (double)x;
+      double px    = _x * ctx->_d.gradient.radial.simple.xx + fetcher->_d.gradient.radial.simple.px;
+      double py    = _x * ctx->_d.gradient.radial.simple.xy + fetcher->_d.gradient.radial.simple.py;
+
+      double b     = ctx->_d.gradient.radial.simple.fx * px +
+                     ctx->_d.gradient.radial.simple.fy * py;
+      double b_d   = ctx->_d.gradient.radial.simple.b_d;
+
+      double d     = ctx->_d.gradient.radial.simple.r2mfyfy * px * px +
+                     ctx->_d.gradient.radial.simple.r2mfxfx * py * py +
+                     ctx->_d.gradient.radial.simple._2_fxfy * px * py;
+      double d_d   = ctx->_d.gradient.radial.simple.d_d +
+                     ctx->_d.gradient.radial.simple.d_d_x * px +
+                     ctx->_d.gradient.radial.simple.d_d_y * py;
+      double d_d_d = ctx->_d.gradient.radial.simple.d_d_d;
+
+      do {
+        FOG_ALIGNED_VAR(double, bArray[8], 32);
+        FOG_ALIGNED_VAR(double, dArray[8], 32);
+
+        int i = Math::min(w, 8);
+        int k;
+
+        for (k = 0; k < i; k++)
+        {
+          bArray[k] = b;
+          dArray[k] = d;
+
+          b   += b_d;
+          d   += d_d;
+          d_d += d_d_d;
+        }
+
+        for (; k < 8; k++)
+        {
+          bArray[k] = 0.0;
+          dArray[k] = 0.0;
+        }
+
+        __m256d t0, t1;
+        __m256d s0, s1;
+        __m128i idx0, idx1;
+        __m256i idx0ymm;
+
+        // (b + sqrt(|d|)) * scale.
+        t0 = _mm256_load_pd(bArray + 0);
+        t1 = _mm256_load_pd(bArray + 4);
+        s0 = _mm256_load_pd(dArray + 0);
+        s1 = _mm256_load_pd(dArray + 4);
+
+        Acc::m256dAbsPD(s0, s0);
+        Acc::m256dAbsPD(s1, s1);
+        Acc::m256dSqrtPD(s0, s0);
+        Acc::m256dSqrtPD(s1, s1);
+        Acc::m256dAddPD(t0, t0, s0);
+        Acc::m256dAddPD(t1, t1, s1);
+        Acc::m256dMulPD(t0, t0, scale);
+        Acc::m256dMulPD(t1, t1, scale);
+
+        accessor.indexAtD(idx0, t0);
+        accessor.indexAtD(idx1, t1);
+
+        idx0ymm = _mm256_inserti128_si256(_mm256_castsi128_si256(idx0), idx1, 1);
+        Helpers::p_gather_prgb32(dst, table, idx0ymm, i);
+
+        dst += (uint)i * 4;
+        w -= i;
+      } while (w);
+
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    fetcher->_d.gradient.radial.simple.px += fetcher->_d.gradient.radial.simple.dx;
+    fetcher->_d.gradient.radial.simple.py += fetcher->_d.gradient.radial.simple.dy;
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTRADIAL_P_H
@@ -0,0 +1,229 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_TEXTURESIMPLE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_TEXTURESIMPLE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseHelpers_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PTextureAccessor]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT PTextureAccessor_PRGB32_From_PRGB32
+{
+  enum
+  {
+    SRC_BPP = 4,
+    FETCH_REFERENCE = 1
+  };
+
+  static FOG_INLINE uint32_t getFill() { return 0x00000000U; }
+};
+
+//! @internal
+struct FOG_NO_EXPORT PTextureAccessor_PRGB32_From_XRGB32
+{
+  enum
+  {
+    SRC_BPP = 4,
+    FETCH_REFERENCE = 0
+  };
+
+  static FOG_INLINE uint32_t getFill() { return 0xFF000000U; }
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PTextureSimple]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Aligned texture fetchers (AVX2).
+//!
+//! Only 32-bit sources are handled, pixels are copied eight at a time. The
+//! control flow matches RasterOps_C::PTextureSimple so the fetched spans (and
+//! the use of the RASTER_FETCH_REFERENCE mode) are identical.
+struct FOG_NO_EXPORT PTextureSimple
+{
+  // --------------------------------------------------------------------------
+  // [Fetch - Align - Pad]
+  // --------------------------------------------------------------------------
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_align_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
+
+    const uint8_t* srcLine;
+    uint32_t fill = Accessor::getFill();
+
+    __m256i fill0ymm;
+    Acc::m256iExtendPI32FromSI32(fill0ymm, fill);
+
+    P_FETCH_SPAN8_INIT()
+    int y = fetcher->_d.texture.simple.py;
+    if (y < 0)
+      y = 0;
+    else if (y >= th)
+      y = th - 1;
+
+    srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+      x += ctx->_d.texture.simple.tx;
+
+      // Pad (left).
+      if (x < 0)
+      {
+        int i = Math::min(-x, w);
+        x = 0;
+        w -= i;
+
+        dst = Helpers::p_fill_prgb32(dst, reinterpret_cast<const uint32_t*>(srcLine)[0] | fill, i);
+        if (w == 0) goto _FetchSkip;
+      }
+
+      // Reference.
+      else if (Accessor::FETCH_REFERENCE && fetcher->_mode == RASTER_FETCH_REFERENCE && x < tw && w < tw - x)
+      {
+        P_FETCH_SPAN8_SET_CUSTOM(srcLine + (uint)x * Accessor::SRC_BPP);
+        goto _FetchSkip;
+      }
+
+      // Fetch.
+      if (x < tw)
+      {
+        int i = Math::min(tw - x, w);
+        w -= i;
+
+        dst = Helpers::p_copy_prgb32(dst, srcLine + (uint)x * Accessor::SRC_BPP, i, fill0ymm);
+        if (w == 0) goto _FetchSkip;
+      }
+
+      // Pad (right). Spans are sorted, so all following spans would be padded
+      // as well and it's not needed to switch to a separate solid loop.
+      dst = Helpers::p_fill_prgb32(dst, reinterpret_cast<const uint32_t*>(srcLine)[tw - 1] | fill, w);
+
+_FetchSkip:
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    fetcher->_d.texture.simple.py += fetcher->_d.texture.simple.dy;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Fetch - Align - Repeat]
+  // --------------------------------------------------------------------------
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_align_repeat(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
+
+    const uint8_t* srcLine;
+    const uint8_t* src;
+
+    __m256i fill0ymm;
+    Acc::m256iExtendPI32FromSI32(fill0ymm, Accessor::getFill());
+
+    P_FETCH_SPAN8_INIT()
+    int y = fetcher->_d.texture.simple.py;
+    FOG_ASSERT(y >= 0 && y < th);
+
+    x = Helpers::p_repeat_integer(x + ctx->_d.texture.simple.tx, tw);
+
+    srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    src = srcLine + (uint)x * Accessor::SRC_BPP;
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      // Reference.
+      if (Accessor::FETCH_REFERENCE && fetcher->_mode == RASTER_FETCH_REFERENCE && w <= tw - x)
+      {
+        P_FETCH_SPAN8_SET_CUSTOM(src);
+        src += (uint)w * Accessor::SRC_BPP;
+
+        if ((x += w) == tw) { x = 0; src = srcLine; }
+        goto _FetchSkip;
+      }
+
+      // Fetch.
+      for (;;)
+      {
+        int i = Math::min(tw - x, w);
+
+        w -= i;
+        x += i;
+
+        dst = Helpers::p_copy_prgb32(dst, src, i, fill0ymm);
+        src += (uint)i * Accessor::SRC_BPP;
+
+        if (x == tw) { x = 0; src = srcLine; }
+        if (!w) break;
+      }
+
+_FetchSkip:
+      P_FETCH_SPAN8_HOLE(
+      {
+        x += hole;
+        if (x >= tw) x %= tw;
+
+        src = srcLine + (uint)x * Accessor::SRC_BPP;
+      })
+    P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    y += fetcher->_d.texture.simple.dy;
+    if (y >= th) y -= th;
+    fetcher->_d.texture.simple.py = y;
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_TEXTURESIMPLE_P_H
@@ -131,6 +131,26 @@ struct FOG_NO_EXPORT Convert
       }
     }
 
+    // ------------------------------------------------------------------------
+    // [Special Case - Shuffle]
+    // ------------------------------------------------------------------------
+
+    // 24-bit and 32-bit formats with byte-aligned components (RGBA, ABGR, BGR,
+    // ...) can be converted by moving bytes only.
+    if (keepColorSpace)
+    {
+      RasterConvertShuffle* shuffle = reinterpret_cast<RasterConvertShuffle*>(d->buffer);
+
+      if (initShuffle(shuffle, df, sf))
+      {
+        uint32_t shuffleId = (df.getDepth() == 32 ? RASTER_SHUFFLE_32_FROM_24 : RASTER_SHUFFLE_24_FROM_24) +
+                             (sf.getDepth() == 32);
+
+        d->blitFn = _api_raster.convert.shuffle[shuffleId];
+        return ERR_OK;
+      }
+    }
+
     // Prepare the structure.
     RasterConvertMulti* multi = reinterpret_cast<RasterConvertMulti*>(d->buffer);
     memset(multi, 0, sizeof(RasterConvertMulti));
@@ -456,6 +476,107 @@ struct FOG_NO_EXPORT Convert
       return (uint32_t)( (uint64_t)((1 << dstSize) - 1) * 65537 / ((1 << srcSize) - 1) );
   }
 
+  static bool FOG_FASTCALL initShuffle(
+    RasterConvertShuffle* shuffle,
+    const ImageFormatDescription& df,
+    const ImageFormatDescription& sf)
+  {
+    uint32_t dfDepth = df.getDepth();
+    uint32_t sfDepth = sf.getDepth();
+
+    if ((dfDepth != 24 && dfDepth != 32) || (sfDepth != 24 && sfDepth != 32))
+      return false;
+
+    if (df.isIndexed() || !df.hasAlignedComponents() || df.isByteSwapped() ||
+        sf.isIndexed() || !sf.hasAlignedComponents() || sf.isByteSwapped())
+      return false;
+
+    uint32_t dfBpp = dfDepth >> 3;
+    uint32_t sfBpp = sfDepth >> 3;
+
+    uint32_t dfPos[4] = { df.getAPos(), df.getRPos(), df.getGPos(), df.getBPos() };
+    uint32_t sfPos[4] = { sf.getAPos(), sf.getRPos(), sf.getGPos(), sf.getBPos() };
+
+    uint32_t dfSize[4] = { df.getASize(), df.getRSize(), df.getGSize(), df.getBSize() };
+    uint32_t sfSize[4] = { sf.getASize(), sf.getRSize(), sf.getGSize(), sf.getBSize() };
+
+    // Map of destination bytes of one pixel, 0x80 means not used.
+    uint8_t map[4] = { 0x80, 0x80, 0x80, 0x80 };
+    uint8_t fill[4] = { 0x00, 0x00, 0x00, 0x00 };
+    uint32_t used = 0;
+    uint32_t i, c;
+
+    for (c = 0; c < 4; c++)
+    {
+      if (dfSize[c] == 0)
+        continue;
+
+      uint32_t dIndex = FOG_BYTE_ORDER_CHOICE(dfPos[c] >> 3, dfBpp - 1 - (dfPos[c] >> 3));
+      used |= 1 << dIndex;
+
+      if (sfSize[c] == 0)
+      {
+        // Only alpha can be missing in the source, it's filled to 0xFF.
+        fill[dIndex] = 0xFF;
+        continue;
+      }
+
+      map[dIndex] = (uint8_t)FOG_BYTE_ORDER_CHOICE(sfPos[c] >> 3, sfBpp - 1 - (sfPos[c] >> 3));
+    }
+
+    if (df.fillUnusedBits())
+    {
+      for (i = 0; i < dfBpp; i++)
+      {
+        if ((used & (1 << i)) == 0)
+          fill[i] = 0xFF;
+      }
+    }
+
+    // Mask and fill for four pixels, compatible with PSHUFB.
+    memset(shuffle, 0, sizeof(RasterConvertShuffle));
+    memset(shuffle->mask, 0x80, 16);
+
+    for (i = 0; i < 4; i++)
+    {
+      for (c = 0; c < dfBpp; c++)
+      {
+        shuffle->mask[i * dfBpp + c] = (map[c] & 0x80) ? 0x80 : (uint8_t)(i * sfBpp + map[c]);
+        shuffle->fill[i * dfBpp + c] = fill[c];
+      }
+    }
+
+    // Shift/mask pairs used by the SSE2 implementation which has no byte
+    // shuffle (only 32-bit to 32-bit conversion, little endian only).
+    if (dfBpp == 4 && sfBpp == 4)
+    {
+      for (c = 0; c < 4; c++)
+      {
+        if (map[c] & 0x80)
+          continue;
+
+        int32_t shift = ((int32_t)c - (int32_t)map[c]) * 8;
+        uint32_t mask = 0xFFU << (c * 8);
+
+        for (i = 0; i < shuffle->shiftCount; i++)
+        {
+          if (shuffle->shift[i] == shift)
+            break;
+        }
+
+        if (i == shuffle->shiftCount)
+        {
+          shuffle->shift[i] = shift;
+          shuffle->shiftCount++;
+        }
+
+        shuffle->shiftMask[i] |= mask;
+      }
+    }
+
+    return true;
+  }
+
   // ==========================================================================
   // [Helpers - Conversion]
   // ==========================================================================
@@ -1067,6 +1188,59 @@ struct FOG_NO_EXPORT Convert
 #endif // FOG_ARCH_BITS
   }
 
+  // ==========================================================================
+  // [Shuffle]
+  // ==========================================================================
+
+  static FOG_INLINE void shufflePixel(uint8_t* dst, const uint8_t* src, uint32_t dstBpp,
+    const RasterConvertShuffle* shuffle)
+  {
+    for (uint32_t i = 0; i < dstBpp; i++)
+    {
+      uint32_t m = shuffle->mask[i];
+      dst[i] = ((m & 0x80) ? 0x00 : src[m]) | shuffle->fill[i];
+    }
+  }
+
+  template<uint32_t DstBpp, uint32_t SrcBpp>
+  static void FOG_FASTCALL shuffle_generic(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    const ImageConverterData* d = reinterpret_cast<const ImageConverterData*>(closure->data);
+    const RasterConvertShuffle* shuffle = reinterpret_cast<const RasterConvertShuffle*>(d->buffer);
+
+    do {
+      shufflePixel(dst, src, DstBpp, shuffle);
+
+      dst += DstBpp;
+      src += SrcBpp;
+    } while (--w);
+  }
+
+  static void FOG_FASTCALL shuffle_24_from_24(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_generic<3, 3>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL shuffle_24_from_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_generic<3, 4>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL shuffle_32_from_24(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_generic<4, 3>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL shuffle_32_from_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_generic<4, 4>(dst, src, w, closure);
+  }
+
   // ==========================================================================
   // [Convert - Premultiply / Demultiply]
   // ==========================================================================
@@ -0,0 +1,613 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEFUSED_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEFUSED_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/CompositeBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/CompositeSrc_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/CompositeSrcOver_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/GradientLinear_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/TextureScale_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/TextureSimple_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedSource]
+// ============================================================================
+
+// Pixel sources of the fused kernels. Each source generates the same pixels
+// as the pattern fetcher it replaces, but one by one, so the compositor can
+// consume them without storing the scanline into the span buffer. The
+// interface is:
+//
+//   Source(fetcher, x)      - Start at the first span, which begins at x.
+//   skip(n)                 - Skip a hole of n pixels between two spans.
+//   next()                  - Return the next pixel (PRGB32).
+//   getRun(w)               - Return a pointer to the next w pixels if they
+//                             are stored in the texture as PRGB32, NULL if
+//                             they have to be generated by next().
+//   advance(fetcher)        - Advance the fetcher to the next scanline, this
+//                             is done by the fetcher after the last span.
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedSource - Texture - Align - Pad]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PTextureSimple::fetch_align_pad().
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedSource_TextureAlignPad
+{
+  FOG_INLINE PFusedSource_TextureAlignPad(RasterPatternFetcher* fetcher, int x) :
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int y = fetcher->_d.texture.simple.py;
+    int th = ctx->_d.texture.base.h;
+
+    if (y < 0)
+      y = 0;
+    else if (y >= th)
+      y = th - 1;
+
+    _srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    _tw = ctx->_d.texture.base.w;
+    _x = x + ctx->_d.texture.simple.tx;
+  }
+
+  FOG_INLINE void skip(int n) { _x += n; }
+
+  FOG_INLINE uint32_t next()
+  {
+    int x = _x++;
+
+    if (x < 0)
+      x = 0;
+    else if (x >= _tw)
+      x = _tw - 1;
+
+    typename Accessor::Pixel pix;
+    _accessor.fetchNorm(pix, _srcLine + (uint)x * Accessor::SRC_BPP);
+    return pix;
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w)
+  {
+    if (!Accessor::FETCH_REFERENCE || _x < 0 || w > _tw - _x)
+      return NULL;
+
+    const uint8_t* src = _srcLine + (uint)_x * Accessor::SRC_BPP;
+    _x += w;
+    return src;
+  }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.texture.simple.py += fetcher->_d.texture.simple.dy;
+  }
+
+  Accessor _accessor;
+  const uint8_t* _srcLine;
+  int _tw;
+  int _x;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedSource - Texture - Align - Repeat]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PTextureSimple::fetch_align_repeat().
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedSource_TextureAlignRepeat
+{
+  FOG_INLINE PFusedSource_TextureAlignRepeat(RasterPatternFetcher* fetcher, int x) :
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int y = fetcher->_d.texture.simple.py;
+    FOG_ASSERT(y >= 0 && y < ctx->_d.texture.base.h);
+
+    _srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    _tw = ctx->_d.texture.base.w;
+    _x = Helpers::p_repeat_integer(x + ctx->_d.texture.simple.tx, _tw);
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    _x += n;
+    if (_x >= _tw) _x %= _tw;
+  }
+
+  FOG_INLINE uint32_t next()
+  {
+    typename Accessor::Pixel pix;
+    _accessor.fetchNorm(pix, _srcLine + (uint)_x * Accessor::SRC_BPP);
+
+    if (++_x == _tw) _x = 0;
+    return pix;
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w)
+  {
+    if (!Accessor::FETCH_REFERENCE || w > _tw - _x)
+      return NULL;
+
+    const uint8_t* src = _srcLine + (uint)_x * Accessor::SRC_BPP;
+    if ((_x += w) == _tw) _x = 0;
+    return src;
+  }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    int y = fetcher->_d.texture.simple.py + fetcher->_d.texture.simple.dy;
+    if (y >= fetcher->getContext()->_d.texture.base.h)
+      y -= fetcher->getContext()->_d.texture.base.h;
+    fetcher->_d.texture.simple.py = y;
+  }
+
+  Accessor _accessor;
+  const uint8_t* _srcLine;
+  int _tw;
+  int _x;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedSource - Texture - Scale - Nearest - Pad]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PTextureScale::fetch_scale_nearest_pad().
+//!
+//! The SSE2 fetcher of the same name produces identical pixels, so this
+//! source is used by the SSE2 kernels as well.
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedSource_TextureScaleNearestPad
+{
+  FOG_INLINE PFusedSource_TextureScaleNearestPad(RasterPatternFetcher* fetcher, int x) :
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int th = ctx->_d.texture.base.h;
+    int py0 = Math::bound<int>((int)(fetcher->_d.texture.scale.py >> 32), 0, th - 1);
+
+    _srcLine = ctx->_d.texture.base.pixels + py0 * ctx->_d.texture.base.stride;
+    _tw = ctx->_d.texture.base.w;
+
+    _rx = ctx->_d.texture.scale.replicateX;
+    _rx0 = ctx->_d.texture.scale.replicateX0;
+
+    _px = ctx->_d.texture.scale.tx + (Fixed32x32)x * ctx->_d.texture.scale.xx;
+    _xx = ctx->_d.texture.scale.xx;
+
+    _x = x;
+    _k = 0;
+    _i = 0;
+    if (_rx) _seekReplicate();
+  }
+
+  //! @brief Find the source column @c _k of @c _x and the count of remaining
+  //! pixels @c _i it's replicated to (integral scale only).
+  FOG_INLINE void _seekReplicate()
+  {
+    int d = _x - _rx0;
+
+    _k = PTextureScale::floorDiv(d, _rx);
+    _i = _rx - (d - _k * _rx);
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    if (_rx)
+    {
+      _x += n;
+      _seekReplicate();
+    }
+    else
+    {
+      _px += (Fixed32x32)n * _xx;
+    }
+  }
+
+  FOG_INLINE uint32_t next()
+  {
+    int k;
+
+    if (_rx)
+    {
+      k = _k;
+      _x++;
+
+      if (--_i == 0)
+      {
+        _i = _rx;
+        _k++;
+      }
+    }
+    else
+    {
+      k = (int)(_px >> 32);
+      _px += _xx;
+    }
+
+    typename Accessor::Pixel pix;
+    _accessor.fetchNorm(pix, _srcLine + Math::bound<int>(k, 0, _tw - 1) * Accessor::SRC_BPP);
+    return pix;
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w) { return NULL; }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    PTextureScale::advance<TEXTURE_TILE_PAD>(fetcher);
+  }
+
+  Accessor _accessor;
+  const uint8_t* _srcLine;
+  int _tw;
+
+  int _rx;
+  int _rx0;
+  int _x;
+  int _k;
+  int _i;
+
+  Fixed32x32 _px;
+  Fixed32x32 _xx;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedSource - Gradient - Linear - Pad]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PGradientLinear::fetch_simple_nearest_pad().
+//!
+//! The fetcher switches between the c0, table and c1 loops, which is the same
+//! as clamping the position to [0, len].
+struct FOG_NO_EXPORT PFusedSource_GradientLinearPad
+{
+  FOG_INLINE PFusedSource_GradientLinearPad(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+
+    _table = table;
+    _c0 = table[0];
+    _c1 = table[ctx->_d.gradient.base.len];
+
+    _xx = ctx->_d.gradient.linear.simple.xx16x16;
+    _len = ctx->_d.gradient.base.len16x16;
+    _pos = Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * _xx;
+  }
+
+  //! @brief Advance the position by @a d, saturating in the direction of
+  //! @c _xx. Once the position is out of the table it's never used again, so
+  //! saturation can't change the result, but it prevents 32-bit overflow.
+  FOG_INLINE void _advance(int64_t d)
+  {
+    int64_t p = (int64_t)_pos + d;
+
+    if (_xx > 0)
+    {
+      if (p > _len) p = _len;
+    }
+    else
+    {
+      if (p < -0x10000) p = -0x10000;
+    }
+
+    _pos = (int)p;
+  }
+
+  FOG_INLINE void skip(int n) { _advance((int64_t)n * _xx); }
+
+  FOG_INLINE uint32_t next()
+  {
+    int pos = _pos;
+    _advance(_xx);
+
+    if (pos <= 0)
+      return _c0;
+    if (pos >= _len)
+      return _c1;
+    return _table[pos >> 16];
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w) { return NULL; }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  const uint32_t* _table;
+  uint32_t _c0;
+  uint32_t _c1;
+
+  int _xx;
+  int _len;
+  int _pos;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedSource - Gradient - Linear - Repeat]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused source of @c PGradientLinear::fetch_simple_nearest_repeat().
+//!
+//! Positions are wrapped exactly like in the fetcher, including the holes.
+struct FOG_NO_EXPORT PFusedSource_GradientLinearRepeat
+{
+  FOG_INLINE PFusedSource_GradientLinearRepeat(RasterPatternFetcher* fetcher, int x)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+    _xx = ctx->_d.gradient.linear.simple.xx16x16;
+    _len = ctx->_d.gradient.base.len16x16;
+
+    _pos = Helpers::p_repeat_integer(
+      Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * _xx, _len);
+  }
+
+  FOG_INLINE void skip(int n)
+  {
+    if (_xx > 0)
+    {
+      _pos += _xx * n;
+      if (_pos > _len) _pos %= _len;
+    }
+    else if (_xx < 0)
+    {
+      _pos = Helpers::p_repeat_integer(_pos + _xx * n, _len);
+    }
+  }
+
+  FOG_INLINE uint32_t next()
+  {
+    uint32_t pix = _table[_pos >> 16];
+
+    _pos += _xx;
+    if (_pos >= _len)
+      _pos -= _len;
+    else if (_pos < 0)
+      _pos += _len;
+
+    return pix;
+  }
+
+  FOG_INLINE const uint8_t* getRun(int w) { return NULL; }
+
+  FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  const uint32_t* _table;
+  int _xx;
+  int _len;
+  int _pos;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - PFusedOp]
+// ============================================================================
+
+// Operators of the fused kernels, they composite a single pixel exactly like
+// the C-Opaque loop of the span compositor does. The line() function is used
+// for runs referenced directly from the texture.
+
+//! @internal
+//!
+//! @brief Fused SRC operator, PRGB32 destination and PRGB32 source.
+struct FOG_NO_EXPORT PFusedOp_Src_PRGB32
+{
+  static FOG_INLINE void pixel(uint8_t* dst, uint32_t src0p)
+  {
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    do {
+      uint32_t src0p;
+
+      Acc::p32Load4a(src0p, src);
+      Acc::p32Store4a(dst, src0p);
+
+      dst += 4;
+      src += 4;
+    } while (--w);
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused SRC operator, PRGB32 or XRGB32 destination and XRGB32 source.
+struct FOG_NO_EXPORT PFusedOp_Src_XRGB32
+{
+  static FOG_INLINE void pixel(uint8_t* dst, uint32_t src0p)
+  {
+    Acc::p32FillPBB3(src0p, src0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    CompositeSrc::prgb32_vblit_xrgb32_line(dst, src, w, closure);
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused SRC_OVER operator, PRGB32 destination and PRGB32 source.
+struct FOG_NO_EXPORT PFusedOp_SrcOver_PRGB32
+{
+  static FOG_INLINE void pixel(uint8_t* dst, uint32_t src0p)
+  {
+    if (Acc::p32PRGB32IsAlpha00(src0p))
+      return;
+
+    if (!Acc::p32PRGB32IsAlphaFF(src0p))
+    {
+      uint32_t dst0p;
+      uint32_t sra0p;
+
+      Acc::p32Load4a(dst0p, dst);
+      Acc::p32ExtractPBB3(sra0p, src0p);
+      Acc::p32Negate255SBW(sra0p, sra0p);
+      Acc::p32MulDiv255PBB_SBW(dst0p, dst0p, sra0p);
+      Acc::p32Add(src0p, src0p, dst0p);
+    }
+
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    CompositeSrcOver::prgb32_vblit_prgb32_line(dst, src, w, closure);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeFused]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused fetch+composite kernels.
+//!
+//! Opaque const-mask spans (the interior of every shape) are composited in a
+//! single pass, the source generates a pixel and the operator stores it into
+//! the destination, the span buffer isn't touched. Other spans (antialiased
+//! edges and glyphs) are rare, they are generated into the buffer one by one
+//! and passed to @a BlitFunc, which is the compositor the kernel is keyed by.
+struct FOG_NO_EXPORT CompositeFused
+{
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  //! @brief Generate @a w pixels of a masked span into @a buffer and composite
+  //! them by @a BlitFunc.
+  template<typename Source, RasterVBlitSpanFunc BlitFunc>
+  static FOG_INLINE void _blitMasked(
+    uint8_t* dstBase, const RasterSpan* span, Source& source, int w,
+    uint8_t* buffer, const RasterClosure* closure)
+  {
+    RasterSpan8 single = *reinterpret_cast<const RasterSpan8*>(span);
+    single.setData(buffer);
+    single.setNext(NULL);
+
+    do {
+      Acc::p32Store4a(buffer, source.next());
+      buffer += 4;
+    } while (--w);
+
+    BlitFunc(dstBase, &single, closure);
+  }
+
+  // ==========================================================================
+  // [Span]
+  // ==========================================================================
+
+  template<typename Source, typename Op, RasterVBlitSpanFunc BlitFunc>
+  static void FOG_FASTCALL span(
+    uint8_t* dst, RasterSpan* span,
+    RasterPatternFetcher* fetcher, uint8_t* buffer,
+    const RasterClosure* closure)
+  {
+    uint8_t* dstBase = dst;
+
+    int x = (int)span->getX0();
+    Source source(fetcher, x);
+
+    for (;;)
+    {
+      int w = (int)span->getX1() - x;
+      FOG_ASSERT(w > 0);
+
+      if (span->getType() == RASTER_SPAN_C && reinterpret_cast<const RasterSpan8*>(span)->isConstMaskOpaque())
+      {
+        const uint8_t* src = source.getRun(w);
+        dst = dstBase + (uint)x * 4;
+
+        if (src != NULL)
+        {
+          Op::line(dst, src, w, closure);
+        }
+        else
+        {
+          do {
+            Op::pixel(dst, source.next());
+            dst += 4;
+          } while (--w);
+        }
+      }
+      else
+      {
+        _blitMasked<Source, BlitFunc>(dstBase, span, source, w, buffer, closure);
+      }
+
+      int xEnd = (int)span->getX1();
+      if ((span = span->getNext()) == NULL)
+        break;
+
+      x = (int)span->getX0();
+      if (x != xEnd)
+        source.skip(x - xEnd);
+    }
+
+    source.advance(fetcher);
+  }
+
+  // ==========================================================================
+  // [Add]
+  // ==========================================================================
+
+  template<RasterPatternFetchFunc FetchFunc, typename Source, typename Op, RasterVBlitSpanFunc BlitFunc>
+  static FOG_INLINE void add(RasterFusedFuncs& fused)
+  {
+    fused.add(FetchFunc, BlitFunc, span<Source, Op, BlitFunc>);
+  }
+
+  //! @brief Add kernels for the hot PRGB32 pattern fetchers (aligned and
+  //! scaled texture blit, linear gradient) composited by @a BlitFunc.
+  template<typename Op, RasterVBlitSpanFunc BlitFunc>
+  static void addPRGB32Fetchers(RasterFusedFuncs& fused)
+  {
+    add<PTextureSimple::fetch_align_pad   <PTextureAccessor_PRGB32_From_PRGB32>, PFusedSource_TextureAlignPad   <PTextureAccessor_PRGB32_From_PRGB32>, Op, BlitFunc>(fused);
+    add<PTextureSimple::fetch_align_pad   <PTextureAccessor_PRGB32_From_XRGB32>, PFusedSource_TextureAlignPad   <PTextureAccessor_PRGB32_From_XRGB32>, Op, BlitFunc>(fused);
+    add<PTextureSimple::fetch_align_repeat<PTextureAccessor_PRGB32_From_PRGB32>, PFusedSource_TextureAlignRepeat<PTextureAccessor_PRGB32_From_PRGB32>, Op, BlitFunc>(fused);
+    add<PTextureSimple::fetch_align_repeat<PTextureAccessor_PRGB32_From_XRGB32>, PFusedSource_TextureAlignRepeat<PTextureAccessor_PRGB32_From_XRGB32>, Op, BlitFunc>(fused);
+
+    add<PTextureScale::fetch_scale_nearest_pad<PTextureAccessor_PRGB32_From_PRGB32>, PFusedSource_TextureScaleNearestPad<PTextureAccessor_PRGB32_From_PRGB32>, Op, BlitFunc>(fused);
+    add<PTextureScale::fetch_scale_nearest_pad<PTextureAccessor_PRGB32_From_XRGB32>, PFusedSource_TextureScaleNearestPad<PTextureAccessor_PRGB32_From_XRGB32>, Op, BlitFunc>(fused);
+
+    add<PGradientLinear::fetch_simple_nearest_pad   <PGradientAccessor_PRGB32_Base>, PFusedSource_GradientLinearPad   , Op, BlitFunc>(fused);
+    add<PGradientLinear::fetch_simple_nearest_repeat<PGradientAccessor_PRGB32_Base>, PFusedSource_GradientLinearRepeat, Op, BlitFunc>(fused);
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEFUSED_P_H
@@ -0,0 +1,587 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERTURBULENCE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERTURBULENCE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Imaging/Filters/FeTurbulence.h>
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+#include <Fog/G2d/Painting/RasterUtil_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence - Base]
+// ============================================================================
+
+// The turbulence generator is based on the reference implementation published
+// in the SVG specification (filters.html#feTurbulenceElement). The random
+// number generator, the lattice initialization and the noise function are kept
+// so the generated noise is compatible with other SVG implementations.
+//
+// The generator doesn't use the source image, it generates pixels of the
+// source rectangle in device coordinates. The base frequencies are scaled by
+// the filter scale, and the source rectangle is the tile used for stitching.
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence - Stitch]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Stitching state of a single octave.
+struct FOG_NO_EXPORT FTurbulenceStitch
+{
+  //! @brief How much to subtract to wrap for stitching.
+  int width;
+  int height;
+
+  //! @brief Minimum value to wrap.
+  int wrapX;
+  int wrapY;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence - Accessor]
+// ============================================================================
+
+struct FOG_NO_EXPORT FTurbulenceAccessor_PRGB32
+{
+  enum { PIXEL_BPP = 4 };
+
+  static FOG_INLINE void storePixel(uint8_t* dst, uint32_t prgb32)
+  {
+    Acc::p32Store4a(dst, prgb32);
+  }
+};
+
+struct FOG_NO_EXPORT FTurbulenceAccessor_XRGB32
+{
+  enum { PIXEL_BPP = 4 };
+
+  static FOG_INLINE void storePixel(uint8_t* dst, uint32_t prgb32)
+  {
+    Acc::p32Store4a(dst, prgb32 | 0xFF000000);
+  }
+};
+
+struct FOG_NO_EXPORT FTurbulenceAccessor_RGB24
+{
+  enum { PIXEL_BPP = 3 };
+
+  static FOG_INLINE void storePixel(uint8_t* dst, uint32_t prgb32)
+  {
+    Acc::p32Store3b(dst, prgb32);
+  }
+};
+
+struct FOG_NO_EXPORT FTurbulenceAccessor_A8
+{
+  enum { PIXEL_BPP = 1 };
+
+  static FOG_INLINE void storePixel(uint8_t* dst, uint32_t prgb32)
+  {
+    Acc::p8Store1b(dst, static_cast<uint8_t>(prgb32 >> 24));
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence - Bands]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Rectangle generated by @c FTurbulence::doBand().
+struct FOG_NO_EXPORT FTurbulenceBandData
+{
+  const RasterFilterTurbulence* turbulence;
+  RasterFilterDoTurbulenceFunc doRow;
+
+  uint8_t* dst;
+  ssize_t dstStride;
+
+  int x;
+  int y;
+  int w;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence]
+// ============================================================================
+
+struct FOG_NO_EXPORT FTurbulence
+{
+  // ==========================================================================
+  // [Turbulence - Random]
+  // ==========================================================================
+
+  // Produces results in the range 1...2^31 - 2 using R = (A * R) % M. See
+  // [Park & Miller], CACM vol. 31 no. 10 p. 1195, Oct. 1988.
+  //
+  // The algorithm should produce the result 1043618065 as the 10,000th
+  // generated number if the original seed is 1.
+
+  static FOG_INLINE int32_t setupSeed(int32_t seed)
+  {
+    if (seed <= 0)
+      seed = -(seed % (RASTER_TURBULENCE_RAND_M - 1)) + 1;
+
+    if (seed > RASTER_TURBULENCE_RAND_M - 1)
+      seed = RASTER_TURBULENCE_RAND_M - 1;
+
+    return seed;
+  }
+
+  static FOG_INLINE int32_t random(int32_t& seed)
+  {
+    int32_t result = RASTER_TURBULENCE_RAND_A * (seed % RASTER_TURBULENCE_RAND_Q) -
+                     RASTER_TURBULENCE_RAND_R * (seed / RASTER_TURBULENCE_RAND_Q);
+
+    if (result <= 0)
+      result += RASTER_TURBULENCE_RAND_M;
+
+    seed = result;
+    return result;
+  }
+
+  static void initTables(RasterFilterTurbulenceTables* tables, int32_t seed)
+  {
+    enum { BSIZE = RASTER_TURBULENCE_BSIZE };
+
+    int i, j, k;
+    seed = setupSeed(seed);
+
+    for (k = 0; k < 4; k++)
+    {
+      for (i = 0; i < BSIZE; i++)
+      {
+        tables->lattice[i] = i;
+
+        float gx = float((random(seed) % (BSIZE + BSIZE)) - BSIZE) / float(BSIZE);
+        float gy = float((random(seed) % (BSIZE + BSIZE)) - BSIZE) / float(BSIZE);
+        float s = Math::sqrt(gx * gx + gy * gy);
+
+        tables->gradient[i][k    ] = gx / s;
+        tables->gradient[i][k + 4] = gy / s;
+      }
+    }
+
+    while (--i)
+    {
+      k = tables->lattice[i];
+      j = random(seed) % BSIZE;
+
+      tables->lattice[i] = tables->lattice[j];
+      tables->lattice[j] = k;
+    }
+
+    for (i = 0; i < BSIZE + 2; i++)
+    {
+      tables->lattice[BSIZE + i] = tables->lattice[i];
+      for (j = 0; j < 8; j++)
+        tables->gradient[BSIZE + i][j] = tables->gradient[i][j];
+    }
+  }
+
+  // ==========================================================================
+  // [Turbulence - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_TURBULENCE);
+    const FeTurbulence* feData = static_cast<const FeTurbulence*>(feBase);
+
+    // The source image is not used, only the destination format matters.
+    RasterFilterDoTurbulenceFunc doRow = _api_raster.filter.turbulence.row[dstFormat];
+    if (doRow == NULL)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    RasterFilterTurbulenceTables* tables = reinterpret_cast<RasterFilterTurbulenceTables*>(
+      MemMgr::alloc(sizeof(RasterFilterTurbulenceTables)));
+
+    if (FOG_IS_NULL(tables))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    initTables(tables, feData->getSeed());
+
+    ctx->reference.init(1);
+    ctx->destroy = destroy;
+
+    ctx->doRect = doRect;
+    ctx->doLine = NULL;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    float hFrequency = Math::abs(feData->getHorizontalBaseFrequency());
+    float vFrequency = Math::abs(feData->getVerticalBaseFrequency());
+
+    // Frequencies are in user units, convert them to device pixels.
+    if (feScale != NULL)
+    {
+      if (feScale->isSwapped())
+        swap(hFrequency, vFrequency);
+
+      if (feScale->_pt.x > 0.0) hFrequency /= float(feScale->_pt.x);
+      if (feScale->_pt.y > 0.0) vFrequency /= float(feScale->_pt.y);
+    }
+
+    ctx->turbulence.turbulenceType = feData->getTurbulenceType();
+    ctx->turbulence.numOctaves = Math::min<uint32_t>(feData->getNumOctaves(), RASTER_TURBULENCE_MAX_OCTAVES);
+    ctx->turbulence.stitchTiles = feData->getStitchTitles();
+    ctx->turbulence.hFrequency = hFrequency;
+    ctx->turbulence.vFrequency = vFrequency;
+    ctx->turbulence.tables = tables;
+    ctx->turbulence.doRow = doRow;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [Turbulence - Destroy]
+  // ==========================================================================
+
+  static void FOG_FASTCALL destroy(
+    RasterFilter* ctx)
+  {
+    MemMgr::free(ctx->turbulence.tables);
+    ctx->turbulence.tables = NULL;
+
+    // Just be safe and detect possible NULL pointer dereference.
+    ctx->destroy = NULL;
+    ctx->doRect = NULL;
+    ctx->doLine = NULL;
+  }
+
+  // ==========================================================================
+  // [Turbulence - DoRect]
+  // ==========================================================================
+
+  static void initContext(RasterFilterTurbulence* tCtx, const RasterFilter* ctx, const RectI* tile)
+  {
+    float hFrequency = ctx->turbulence.hFrequency;
+    float vFrequency = ctx->turbulence.vFrequency;
+
+    tCtx->filterCtx = ctx;
+    tCtx->tables = ctx->turbulence.tables;
+    tCtx->numOctaves = (int)ctx->turbulence.numOctaves;
+    tCtx->fractalSum = ctx->turbulence.turbulenceType == FE_TURBULENCE_TYPE_FRACTAL_NOISE;
+    tCtx->stitchTiles = ctx->turbulence.stitchTiles;
+
+    tCtx->stitchWidth = 0;
+    tCtx->stitchHeight = 0;
+    tCtx->stitchWrapX = 0;
+    tCtx->stitchWrapY = 0;
+
+    if (tCtx->stitchTiles)
+    {
+      float tileX = float(tile->x);
+      float tileY = float(tile->y);
+      float tileW = float(tile->w);
+      float tileH = float(tile->h);
+
+      // When stitching tiled turbulence, the frequencies must be adjusted so
+      // that the tile borders will be continuous.
+      if (hFrequency != 0.0f)
+      {
+        float lo = Math::floor(tileW * hFrequency) / tileW;
+        float hi = Math::ceil(tileW * hFrequency) / tileW;
+        hFrequency = (hFrequency / lo < hi / hFrequency) ? lo : hi;
+      }
+
+      if (vFrequency != 0.0f)
+      {
+        float lo = Math::floor(tileH * vFrequency) / tileH;
+        float hi = Math::ceil(tileH * vFrequency) / tileH;
+        vFrequency = (vFrequency / lo < hi / vFrequency) ? lo : hi;
+      }
+
+      tCtx->stitchWidth = int(tileW * hFrequency + 0.5f);
+      tCtx->stitchHeight = int(tileH * vFrequency + 0.5f);
+      tCtx->stitchWrapX = int(tileX * hFrequency + float(RASTER_TURBULENCE_PERLIN) + float(tCtx->stitchWidth));
+      tCtx->stitchWrapY = int(tileY * vFrequency + float(RASTER_TURBULENCE_PERLIN) + float(tCtx->stitchHeight));
+    }
+
+    tCtx->hFrequency = hFrequency;
+    tCtx->vFrequency = vFrequency;
+  }
+
+  static err_t FOG_FASTCALL doRect(
+    RasterFilter* ctx,
+    RasterFilterImage* dst, const PointI* dstPos,
+    RasterFilterImage* src, const RectI* srcRect,
+    MemBuffer* intermediateBuffer)
+  {
+    const ImageFormatDescription& dstDesc = ImageFormatDescription::getByFormat(ctx->dstFormat);
+    uint32_t dstBpp = dstDesc.getBytesPerPixel();
+
+    int w = srcRect->w;
+    int h = srcRect->h;
+
+    if (w <= 0 || h <= 0)
+      return ERR_OK;
+
+    uint8_t* dstPixels;
+    ssize_t dstStride;
+
+    if (dst->data == NULL)
+    {
+      dstStride = (ssize_t)w * dstBpp;
+      dstPixels = reinterpret_cast<uint8_t*>(intermediateBuffer->alloc((size_t)h * (size_t)dstStride));
+
+      if (FOG_IS_NULL(dstPixels))
+        return ERR_RT_OUT_OF_MEMORY;
+
+      // And initialize the destination buffer so the caller can use the data.
+      dst->data = dstPixels;
+      dst->stride = dstStride;
+    }
+    else
+    {
+      dstStride = dst->stride;
+      dstPixels = dst->data + dstPos->y * dstStride + dstPos->x * (ssize_t)dstBpp;
+    }
+
+    RasterFilterTurbulence tCtx;
+    initContext(&tCtx, ctx, srcRect);
+
+    FTurbulenceBandData data;
+    data.turbulence = &tCtx;
+    data.doRow = ctx->turbulence.doRow;
+    data.dst = dstPixels;
+    data.dstStride = dstStride;
+    data.x = srcRect->x;
+    data.y = srcRect->y;
+    data.w = w;
+
+    // Large rectangles are generated in parallel, split into horizontal bands.
+    if (!RasterUtil::doBandsMT(doBand, &data, w, h,
+      RASTER_TURBULENCE_MT_THRESHOLD, RASTER_TURBULENCE_MT_MIN_ROWS))
+    {
+      doBand(&data, 0, h);
+    }
+
+    return ERR_OK;
+  }
+
+  static void FOG_FASTCALL doBand(void* data, int y, int yEnd)
+  {
+    const FTurbulenceBandData* b = static_cast<const FTurbulenceBandData*>(data);
+    uint8_t* dst = b->dst + (ssize_t)y * b->dstStride;
+
+    for (; y < yEnd; y++, dst += b->dstStride)
+      b->doRow(b->turbulence, dst, b->x, b->y + y, b->w);
+  }
+
+  // ==========================================================================
+  // [Turbulence - Noise]
+  // ==========================================================================
+
+  static FOG_INLINE float sCurve(float t) { return t * t * (3.0f - 2.0f * t); }
+  static FOG_INLINE float lerp(float t, float a, float b) { return a + t * (b - a); }
+
+  static FOG_INLINE void initStitch(FTurbulenceStitch& stitch, const RasterFilterTurbulence* ctx)
+  {
+    stitch.width = ctx->stitchWidth;
+    stitch.height = ctx->stitchHeight;
+    stitch.wrapX = ctx->stitchWrapX;
+    stitch.wrapY = ctx->stitchWrapY;
+  }
+
+  static FOG_INLINE void nextStitch(FTurbulenceStitch& stitch)
+  {
+    // Subtracting PERLIN before the multiplication and adding it afterward
+    // simplifies to subtracting it once.
+    stitch.width *= 2;
+    stitch.wrapX = 2 * stitch.wrapX - RASTER_TURBULENCE_PERLIN;
+    stitch.height *= 2;
+    stitch.wrapY = 2 * stitch.wrapY - RASTER_TURBULENCE_PERLIN;
+  }
+
+  //! @brief Get lattice cell of point @a vx, @a vy (shared by C and SSE2).
+  //!
+  //! Fills the gradient indices @a b (b00, b10, b01, b11) and the fractional
+  //! parts @a rx0 and @a ry0.
+  static FOG_INLINE void lattice(int* b, float& rx0, float& ry0,
+    const RasterFilterTurbulenceTables* tables, float vx, float vy,
+    const FTurbulenceStitch* stitch)
+  {
+    float t;
+
+    t = vx + float(RASTER_TURBULENCE_PERLIN);
+    int bx0 = (int)t;
+    int bx1 = bx0 + 1;
+    rx0 = t - float(bx0);
+
+    t = vy + float(RASTER_TURBULENCE_PERLIN);
+    int by0 = (int)t;
+    int by1 = by0 + 1;
+    ry0 = t - float(by0);
+
+    // If stitching, adjust lattice points accordingly.
+    if (stitch != NULL)
+    {
+      if (bx0 >= stitch->wrapX) bx0 -= stitch->width;
+      if (bx1 >= stitch->wrapX) bx1 -= stitch->width;
+      if (by0 >= stitch->wrapY) by0 -= stitch->height;
+      if (by1 >= stitch->wrapY) by1 -= stitch->height;
+    }
+
+    bx0 &= RASTER_TURBULENCE_BMASK;
+    bx1 &= RASTER_TURBULENCE_BMASK;
+    by0 &= RASTER_TURBULENCE_BMASK;
+    by1 &= RASTER_TURBULENCE_BMASK;
+
+    int i = tables->lattice[bx0];
+    int j = tables->lattice[bx1];
+
+    b[0] = tables->lattice[i + by0];
+    b[1] = tables->lattice[j + by0];
+    b[2] = tables->lattice[i + by1];
+    b[3] = tables->lattice[j + by1];
+  }
+
+  static FOG_INLINE void noise2(float* result,
+    const RasterFilterTurbulenceTables* tables, float vx, float vy,
+    const FTurbulenceStitch* stitch)
+  {
+    int b[4];
+    float rx0, ry0;
+
+    lattice(b, rx0, ry0, tables, vx, vy, stitch);
+
+    float rx1 = rx0 - 1.0f;
+    float ry1 = ry0 - 1.0f;
+
+    float sx = sCurve(rx0);
+    float sy = sCurve(ry0);
+
+    const float* q00 = tables->gradient[b[0]];
+    const float* q10 = tables->gradient[b[1]];
+    const float* q01 = tables->gradient[b[2]];
+    const float* q11 = tables->gradient[b[3]];
+
+    for (int n = 0; n < 4; n++)
+    {
+      float u, v;
+      float a, c;
+
+      u = rx0 * q00[n] + ry0 * q00[n + 4];
+      v = rx1 * q10[n] + ry0 * q10[n + 4];
+      a = lerp(sx, u, v);
+
+      u = rx0 * q01[n] + ry1 * q01[n + 4];
+      v = rx1 * q11[n] + ry1 * q11[n + 4];
+      c = lerp(sx, u, v);
+
+      result[n] = lerp(sy, a, c);
+    }
+  }
+
+  //! @brief Get turbulence at point @a x, @a y as PRGB32 pixel.
+  static FOG_INLINE uint32_t turbulence(const RasterFilterTurbulence* ctx, float x, float y)
+  {
+    // No octaves, no noise (transparent black, even for fractal noise).
+    if (ctx->numOctaves <= 0)
+      return 0x00000000;
+
+    FTurbulenceStitch stitch;
+    FTurbulenceStitch* pStitch = NULL;
+
+    if (ctx->stitchTiles)
+    {
+      initStitch(stitch, ctx);
+      pStitch = &stitch;
+    }
+
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float ratio = 1.0f;
+
+    float vx = x * ctx->hFrequency;
+    float vy = y * ctx->vFrequency;
+
+    int octave = 0;
+    for (;;)
+    {
+      float noise[4];
+      noise2(noise, ctx->tables, vx, vy, pStitch);
+
+      if (ctx->fractalSum)
+      {
+        sum[0] += noise[0] * ratio;
+        sum[1] += noise[1] * ratio;
+        sum[2] += noise[2] * ratio;
+        sum[3] += noise[3] * ratio;
+      }
+      else
+      {
+        sum[0] += Math::abs(noise[0] * ratio);
+        sum[1] += Math::abs(noise[1] * ratio);
+        sum[2] += Math::abs(noise[2] * ratio);
+        sum[3] += Math::abs(noise[3] * ratio);
+      }
+
+      if (++octave >= ctx->numOctaves)
+        break;
+
+      vx *= 2.0f;
+      vy *= 2.0f;
+      ratio *= 0.5f;
+
+      if (pStitch != NULL)
+        nextStitch(stitch);
+    }
+
+    if (ctx->fractalSum)
+    {
+      sum[0] = sum[0] * 0.5f + 0.5f;
+      sum[1] = sum[1] * 0.5f + 0.5f;
+      sum[2] = sum[2] * 0.5f + 0.5f;
+      sum[3] = sum[3] * 0.5f + 0.5f;
+    }
+
+    sum[0] = Math::bound<float>(sum[0], 0.0f, 1.0f);
+    sum[1] = Math::bound<float>(sum[1], 0.0f, 1.0f);
+    sum[2] = Math::bound<float>(sum[2], 0.0f, 1.0f);
+    sum[3] = Math::bound<float>(sum[3], 0.0f, 1.0f);
+
+    // Premultiply.
+    float a = sum[3] * 255.0f;
+
+    return (uint32_t(int(a         )) << 24) |
+           (uint32_t(int(sum[0] * a)) << 16) |
+           (uint32_t(int(sum[1] * a)) <<  8) |
+           (uint32_t(int(sum[2] * a))      ) ;
+  }
+
+  // ==========================================================================
+  // [Turbulence - DoRow]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static void FOG_FASTCALL doRow(
+    const RasterFilterTurbulence* ctx, uint8_t* dst, int x, int y, int w)
+  {
+    float fy = float(y);
+
+    for (int i = 0; i < w; i++, dst += Accessor::PIXEL_BPP)
+      Accessor::storePixel(dst, turbulence(ctx, float(x + i), fy));
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERTURBULENCE_P_H
@@ -128,7 +128,7 @@ struct FOG_NO_EXPORT PGradientBase
           else
           {
             uint32_t mask0 = mask & 0x00FF00FFU;
-            uint32_t mask1 = mask >> 8;
+            uint32_t mask1 = (mask >> 8) & 0x000000FFU;
 
             do {
               uint32_t t0 = _FOG_ACC_COMBINE_2((rPos & 0xFF000000) >> 8, bPos >> 24);
@@ -165,7 +165,7 @@ struct FOG_NO_EXPORT PGradientBase
     p1 >>= 8;
     if (p1 < (uint)_wTotal)
     {
-      uint32_t* dst = reinterpret_cast<uint32_t*>(_dst) + p1 * 4;
+      uint8_t* dst = _dst + p1 * 4;
       int w = (uint)_wTotal - p1 + 1;
 
       Acc::p32PRGB32FromARGB32(c1, c1);
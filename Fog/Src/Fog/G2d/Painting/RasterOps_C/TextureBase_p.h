@@ -55,6 +55,13 @@ struct FOG_NO_EXPORT PTextureBase
     uint32_t srcHasAlpha = (srcImage->getFormatDescription().getComponentMask() & IMAGE_COMPONENT_ALPHA) != 0;
     ssize_t srcStride = srcImage->getStride();
 
+    // Fully-opaque PRGB32 image is fetched as XRGB32, so SRC_OVER becomes
+    // a copy.
+    if (srcFormat == IMAGE_FORMAT_PRGB32 && srcImage->getAlphaDistribution() == ALPHA_DISTRIBUTION_FULL)
+    {
+      srcHasAlpha = false;
+    }
+
     if (tileMode == TEXTURE_TILE_CLAMP)
     {
       srcHasAlpha |= !clampColor->isOpaque();
@@ -246,6 +253,106 @@ _Has16BPC:
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Scale]
+    // ------------------------------------------------------------------------
+
+    if (transformType == TRANSFORM_TYPE_SCALING && inv._00 > 0.0 && inv._11 > 0.0)
+    {
+      // Input values are centered to (0.5, 0.5), translated back if the
+      // filter is not NEAREST (the same as affine).
+      double tx = 0.5 * inv._00 + inv._20;
+      double ty = 0.5 * inv._11 + inv._21;
+
+      if (imageQuality != IMAGE_QUALITY_NEAREST)
+      {
+        tx -= 0.5;
+        ty -= 0.5;
+      }
+
+      double xx = inv._00;
+      double yy = inv._11;
+
+      double mx = (double)ctx->_d.texture.base.w;
+      double my = (double)ctx->_d.texture.base.h;
+
+      if (tileMode == TEXTURE_TILE_REFLECT)
+      {
+        mx *= 2.0;
+        my *= 2.0;
+      }
+
+      if (tileMode == TEXTURE_TILE_REPEAT || tileMode == TEXTURE_TILE_REFLECT)
+      {
+        tx = Math::repeat(tx, mx);
+        ty = Math::repeat(ty, my);
+
+        if (xx >= mx) xx = Math::mod(xx, mx);
+        if (yy >= my) yy = Math::mod(yy, my);
+      }
+
+      // Fetchers step in 32.32 fixed point from the start of each span, all
+      // source coordinates within the bounding box must fit into 30 bits.
+      double limit = 1073741824.0;
+
+      bool safeFixedPoint =
+        Math::abs(tx) + (double)(boundingBox->x1 + 1) * xx < limit &&
+        Math::abs(ty) + (double)(boundingBox->y1 + 1) * yy < limit &&
+        mx < limit && my < limit;
+
+      ctx->_d.texture.scale.tx = Math::fixed32x32FromFloat(tx);
+      ctx->_d.texture.scale.ty = Math::fixed32x32FromFloat(ty);
+      ctx->_d.texture.scale.xx = Math::fixed32x32FromFloat(xx);
+      ctx->_d.texture.scale.yy = Math::fixed32x32FromFloat(yy);
+      ctx->_d.texture.scale.mx = (Fixed32x32)mx << 32;
+      ctx->_d.texture.scale.my = (Fixed32x32)my << 32;
+
+      // PAD and CLAMP fetchers divide by the advance.
+      if (tileMode == TEXTURE_TILE_PAD || tileMode == TEXTURE_TILE_CLAMP)
+      {
+        safeFixedPoint &= ctx->_d.texture.scale.xx > 0 &&
+                          ctx->_d.texture.scale.yy > 0;
+      }
+
+      if (safeFixedPoint)
+      {
+        // Integer scale aligned to the pixel grid is a pixel replication.
+        int replicateX;
+        int replicateX0;
+
+        ctx->_d.texture.scale.replicateX = 0;
+        ctx->_d.texture.scale.replicateX0 = 0;
+
+        if (imageQuality == IMAGE_QUALITY_NEAREST &&
+            Math::isFuzzyToInt(tr->_00, replicateX) && replicateX >= 2 &&
+            Math::isFuzzyToInt(tr->_20, replicateX0))
+        {
+          ctx->_d.texture.scale.replicateX = replicateX;
+          ctx->_d.texture.scale.replicateX0 = replicateX0;
+        }
+
+        // Setup functions.
+        if (tileMode == TEXTURE_TILE_PAD || tileMode == TEXTURE_TILE_CLAMP)
+        {
+          ctx->_prepare = prepare_scale_pad_clamp;
+          ctx->_skip = skip_scale_pad_clamp;
+        }
+        else
+        {
+          ctx->_prepare = prepare_scale_repeat_reflect;
+          ctx->_skip = skip_scale_repeat_reflect;
+        }
+
+        if (imageQuality == IMAGE_QUALITY_NEAREST)
+          ctx->_fetch = fetchFuncs->fetch_scale_nearest[srcFormat][tileMode];
+        else
+          ctx->_fetch = fetchFuncs->fetch_scale_bilinear[srcFormat][tileMode];
+
+        if (ctx->_fetch != NULL)
+          return ERR_OK;
+      }
+    }
+
     // ------------------------------------------------------------------------
     // [Affine]
     // ------------------------------------------------------------------------
@@ -436,6 +543,32 @@ _Has16BPC:
     fetcher->_d.texture.affine.dy = Math::repeat(d * ctx->_d.texture.affine.yy, ctx->_d.texture.affine.my);
   }
 
+  static void FOG_FASTCALL prepare_scale_pad_clamp(
+    const RasterPattern* ctx, RasterPatternFetcher* fetcher, int _y, int _delta, uint32_t mode)
+  {
+    fetcher->_ctx = ctx;
+    fetcher->_fetch = ctx->_fetch;
+    fetcher->_skip = ctx->_skip;
+    fetcher->_mode = mode;
+
+    fetcher->_d.texture.scale.py = ctx->_d.texture.scale.ty + (Fixed32x32)_y * ctx->_d.texture.scale.yy;
+    fetcher->_d.texture.scale.dy = (Fixed32x32)_delta * ctx->_d.texture.scale.yy;
+  }
+
+  static void FOG_FASTCALL prepare_scale_repeat_reflect(
+    const RasterPattern* ctx, RasterPatternFetcher* fetcher, int _y, int _delta, uint32_t mode)
+  {
+    Fixed32x32 my = ctx->_d.texture.scale.my;
+
+    fetcher->_ctx = ctx;
+    fetcher->_fetch = ctx->_fetch;
+    fetcher->_skip = ctx->_skip;
+    fetcher->_mode = mode;
+
+    fetcher->_d.texture.scale.py = (ctx->_d.texture.scale.ty + (Fixed32x32)_y * ctx->_d.texture.scale.yy) % my;
+    fetcher->_d.texture.scale.dy = ((Fixed32x32)_delta * ctx->_d.texture.scale.yy) % my;
+  }
+
   // ==========================================================================
   // [Skip]
   // ==========================================================================
@@ -460,6 +593,19 @@ _Has16BPC:
     fetcher->_d.texture.simple.py = _y;
   }
 
+  static void FOG_FASTCALL skip_scale_pad_clamp(
+    RasterPatternFetcher* fetcher, int step)
+  {
+    fetcher->_d.texture.scale.py += fetcher->_d.texture.scale.dy * step;
+  }
+
+  static void FOG_FASTCALL skip_scale_repeat_reflect(
+    RasterPatternFetcher* fetcher, int step)
+  {
+    fetcher->_d.texture.scale.py = (fetcher->_d.texture.scale.py +
+      fetcher->_d.texture.scale.dy * step) % fetcher->_ctx->_d.texture.scale.my;
+  }
+
   static void FOG_FASTCALL skip_affine_pad_clamp(
     RasterPatternFetcher* fetcher, int step)
   {
@@ -545,6 +691,7 @@ struct FOG_NO_EXPORT PTextureAccessor_PRGB32_From_XRGB32 : public PTextureAccess
   FOG_INLINE PTextureAccessor_PRGB32_From_XRGB32(const RasterPattern* ctx) {}
 
   FOG_INLINE void fetchRaw(Pixel& dst, const uint8_t* src) { Acc::p32Load4a(dst, src); }
+  FOG_INLINE void fetchNorm(Pixel& dst, const uint8_t* src) { fetchRaw(dst, src); normalize(dst, dst); }
 
   FOG_INLINE void interpolateRaw_2(Pixel& dst, const Pixel& c0, uint w0, const Pixel& c1, uint w1)
   { P_INTERPOLATE_C_32_2(dst, c0, w0, c1, w1); }
@@ -566,6 +713,7 @@ struct FOG_NO_EXPORT PTextureAccessor_PRGB32_From_RGB24 : public PTextureAccesso
   FOG_INLINE PTextureAccessor_PRGB32_From_RGB24(const RasterPattern* ctx) {}
 
   FOG_INLINE void fetchRaw(Pixel& dst, const uint8_t* src) { Acc::p32Load3b(dst, src); }
+  FOG_INLINE void fetchNorm(Pixel& dst, const uint8_t* src) { fetchRaw(dst, src); normalize(dst, dst); }
 
   FOG_INLINE void interpolateRaw_2(Pixel& dst, const Pixel& c0, uint w0, const Pixel& c1, uint w1)
   { P_INTERPOLATE_C_32_2(dst, c0, w0, c1, w1); }
@@ -587,6 +735,7 @@ struct FOG_NO_EXPORT PTextureAccessor_PRGB32_From_A8 : public PTextureAccessor_P
   FOG_INLINE PTextureAccessor_PRGB32_From_A8(const RasterPattern* ctx) {}
 
   FOG_INLINE void fetchRaw(Pixel& dst, const uint8_t* p) { Acc::p32Load1b(dst, p); }
+  FOG_INLINE void fetchNorm(Pixel& dst, const uint8_t* src) { fetchRaw(dst, src); normalize(dst, dst); }
 
   FOG_INLINE void interpolateRaw_2(Pixel& dst, const Pixel& c0, uint w0, const Pixel& c1, uint w1)
   { dst = (c0 * w0 + c1 * w1) >> 8; }
@@ -608,6 +757,7 @@ struct FOG_NO_EXPORT PTextureAccessor_PRGB32_From_I8 : public PTextureAccessor_P
   FOG_INLINE PTextureAccessor_PRGB32_From_I8(const RasterPattern* ctx) : pal(ctx->_d.texture.base.pal) {}
 
   FOG_INLINE void fetchRaw(Pixel& dst, const uint8_t* src) { Acc::p32Load4a(dst, pal + src[0]); }
+  FOG_INLINE void fetchNorm(Pixel& dst, const uint8_t* src) { fetchRaw(dst, src); normalize(dst, dst); }
 
   FOG_INLINE void interpolateRaw_2(Pixel& dst, const Pixel& c0, uint w0, const Pixel& c1, uint w1)
   { P_INTERPOLATE_C_32_2(dst, c0, w0, c1, w1); }
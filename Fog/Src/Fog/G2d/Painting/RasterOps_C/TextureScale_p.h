@@ -13,739 +13,638 @@
 namespace Fog {
 namespace RasterOps_C {
 
-} // RasterOps_C namespace
-} // Fog namespace
+// ============================================================================
+// [Fog::RasterOps_C - PTextureScale]
+// ============================================================================
 
-// [Guard]
-#endif // _FOG_G2D_PAINTING_RASTEROPS_C_TEXTURESCALE_P_H
+//! @internal
+//!
+//! @brief Texture fetchers used when the transform is only scale and
+//! translation.
+//!
+//! Source X is advanced in 32.32 fixed point and the source row(s) are
+//! resolved once per scanline. The PAD and CLAMP fetchers split each span into
+//! the parts before, inside, and after the texture, so the inner loop doesn't
+//! bound coordinates. The NEAREST fetcher replicates each source pixel if the
+//! scale is an integer and the texture is aligned to the pixel grid.
+struct FOG_NO_EXPORT PTextureScale
+{
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
 
+  //! @brief Get count of positions (at most @a w) starting at @a p and
+  //! advanced by @a d which are less than @a limit.
+  static FOG_INLINE int countBelow(Fixed32x32 p, Fixed32x32 d, Fixed32x32 limit, int w)
+  {
+    if (p >= limit) return 0;
 
+    Fixed32x32 n = (limit - p + d - 1) / d;
+    return n < (Fixed32x32)w ? (int)n : w;
+  }
 
+  static FOG_INLINE int floorDiv(int a, int b)
+  {
+    int q = a / b;
+    if (q * b != a && a < 0) q--;
+    return q;
+  }
 
+  static FOG_INLINE int repeatIndex(int i, int size)
+  {
+    i %= size;
+    if (i < 0) i += size;
+    return i;
+  }
 
+  static FOG_INLINE int reflectIndex(int i, int size)
+  {
+    return i < size ? i : size * 2 - 1 - i;
+  }
 
+  //! @brief Advance the fetcher to the next scanline.
+  template<int TILE>
+  static FOG_INLINE void advance(RasterPatternFetcher* fetcher)
+  {
+    fetcher->_d.texture.scale.py += fetcher->_d.texture.scale.dy;
 
-#if 0
+    if (TILE == TEXTURE_TILE_REPEAT || TILE == TEXTURE_TILE_REFLECT)
+    {
+      Fixed32x32 my = fetcher->_ctx->_d.texture.scale.my;
+      if (fetcher->_d.texture.scale.py >= my)
+        fetcher->_d.texture.scale.py -= my;
+    }
+  }
 
-namespace Fog {
-namespace Render {
+  // --------------------------------------------------------------------------
+  // [Fetch - Scale (Nearest)]
+  // --------------------------------------------------------------------------
 
-// ============================================================================
-// [Fog::RasterOps_C - Scale]
-// ============================================================================
+  template<typename Accessor, int TILE>
+  static FOG_INLINE void _fetch_nearest(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
 
-#define A_VAL(p) ((uint8_t*)(p))[PIXEL_ARGB32_POS_A]
-#define R_VAL(p) ((uint8_t*)(p))[PIXEL_ARGB32_POS_R]
-#define G_VAL(p) ((uint8_t*)(p))[PIXEL_ARGB32_POS_G]
-#define B_VAL(p) ((uint8_t*)(p))[PIXEL_ARGB32_POS_B]
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
 
-#define ARGB_COMPOSE(r, g, b, a) \
-  ((uint32_t)(a) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b)
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
 
-#define XAP (xapoints[x])
-#define YAP (yapoints[y])
-#define INV_XAP (256 - xapoints[x])
-#define INV_YAP (256 - yapoints[y])
+    Fixed32x32 tx = ctx->_d.texture.scale.tx;
+    Fixed32x32 xx = ctx->_d.texture.scale.xx;
+    Fixed32x32 mx = ctx->_d.texture.scale.mx;
 
-//! @internal
-struct FOG_NO_EXPORT PatternScaleC
-{
-  // --------------------------------------------------------------------------
-  // [Scale]
-  // --------------------------------------------------------------------------
+    const uint8_t* srcPixels = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
 
-  static FOG_NO_INLINE uint32_t** calcYPoints(uint32_t* src, int sw, int sh, int dh)
-  {
-    uint32_t** p;
-    int i;
-    int j = 0;
-    int val;
-    int inc;
-    int rv = 0;
-
-    if (dh < 0)
-    {
-      dh = -dh;
-      rv = 1;
-    }
+    typename Accessor::Pixel clamp;
+    if (TILE == TEXTURE_TILE_CLAMP)
+      accessor.fetchSolid(clamp, ctx->_d.texture.base.clamp);
 
-    p = reinterpret_cast<uint32_t**>(MemMgr::alloc((dh + 1) * sizeof(uint32_t*)));
-    if (p == NULL) return p;
+    P_FETCH_SPAN8_INIT()
 
-    val = (dh >= sh) ? ((0x8000 * sh / dh) + 0x8000) : 0;
-    inc = (sh << 16) / dh;
+    int py0 = (int)(fetcher->_d.texture.scale.py >> 32);
 
-    for (i = 0; i < dh; i++)
+    switch (TILE)
     {
-      p[j++] = src + Math::max(val >> 16, 0) * sw;
-      val += inc;
+      case TEXTURE_TILE_PAD:
+        py0 = Math::bound<int>(py0, 0, th - 1);
+        break;
+      case TEXTURE_TILE_REFLECT:
+        py0 = reflectIndex(py0, th);
+        break;
+      case TEXTURE_TILE_CLAMP:
+        if ((uint)py0 >= (uint)th) goto _FetchSolid;
+        break;
     }
 
-    if (rv)
-    {
-      for (i = dh / 2; --i >= 0;)
-      {
-        uint32_t* tmp = p[i];
+    srcPixels += py0 * srcStride;
 
-        p[i] = p[dh - i - 1];
-        p[dh - i - 1] = tmp;
-      }
-    }
-    return p;
-  }
+    // ------------------------------------------------------------------------
+    // [Loop - Replicate]
+    // ------------------------------------------------------------------------
 
-  static FOG_NO_INLINE int* calcXPoints(int sw, int dw)
-  {
-    int* p;
-    int i;
-    int j = 0;
-    int val;
-    int inc;
-    int rv = 0;
-
-    if (dw < 0)
+    if (ctx->_d.texture.scale.replicateX)
     {
-      dw = -dw;
-      rv = 1;
-    }
+      int rx = ctx->_d.texture.scale.replicateX;
+      int rx0 = ctx->_d.texture.scale.replicateX0;
 
-    p = reinterpret_cast<int*>(MemMgr::alloc((dw + 1) * sizeof(int)));
-    if (p == NULL) return p;
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
 
-    val = (dw >= sw) ? ((0x8000 * sw / dw) + 0x8000) : 0;
-    inc = (sw << 16) / dw;
+        int d = x - rx0;
+        int k = floorDiv(d, rx);
+        int i = rx - (d - k * rx);
 
-    for (i = 0; i < dw; i++)
-    {
-      p[j++] = Math::max(val >> 16, 0);
-      val += inc;
-    }
+        if (TILE == TEXTURE_TILE_REPEAT ) k = repeatIndex(k, tw);
+        if (TILE == TEXTURE_TILE_REFLECT) k = repeatIndex(k, tw * 2);
 
-    if (rv)
-    {
-      for (i = dw / 2; --i >= 0;)
-      {
-        int tmp = p[i];
+        for (;;)
+        {
+          typename Accessor::Pixel pix;
 
-        p[i] = p[dw - i - 1];
-        p[dw - i - 1] = tmp;
-      }
-    }
-    return p;
-  }
+          if (i > w) i = w;
+          w -= i;
 
-  static FOG_NO_INLINE int* calcAPoints(int s, int d, int up)
-  {
-    int* p;
-    int i;
-    int j = 0;
-    int rv = 0;
-    int val;
-    int inc;
-
-    if (d < 0)
-    {
-      rv = 1;
-      d = -d;
-    }
+          switch (TILE)
+          {
+            case TEXTURE_TILE_PAD:
+              accessor.fetchNorm(pix, srcPixels + Math::bound<int>(k, 0, tw - 1) * Accessor::SRC_BPP);
+              break;
+            case TEXTURE_TILE_REPEAT:
+              accessor.fetchNorm(pix, srcPixels + k * Accessor::SRC_BPP);
+              break;
+            case TEXTURE_TILE_REFLECT:
+              accessor.fetchNorm(pix, srcPixels + reflectIndex(k, tw) * Accessor::SRC_BPP);
+              break;
+            case TEXTURE_TILE_CLAMP:
+              if ((uint)k < (uint)tw)
+                accessor.fetchNorm(pix, srcPixels + k * Accessor::SRC_BPP);
+              else
+                pix = clamp;
+              break;
+          }
 
-    p = reinterpret_cast<int*>(MemMgr::alloc(d * sizeof(int)));
-    if (p == NULL) return p;
+          do {
+            accessor.store(dst, pix);
+            dst += Accessor::DST_BPP;
+          } while (--i);
 
-    val = 0;
-    inc = (s << 16) / d;
+          if (w == 0) break;
 
-    if (up)
-    {
-      // Scaling up.
-      val = 0x8000 * s / d - 0x8000;
-
-      for (i = 0; i < d; i++)
-      {
-        int pos = val >> 16;
-        if ((uint)pos >= (uint)(s - 1))
-          p[j] = 0;
-        else
-          p[j] = (val >> 8) - ((val >> 8) & 0xFFFFFF00);
-        val += inc;
-        j++;
-      }
-    }
-    else
-    {
-      // Scaling down.
-      int ap;
-      int Cp = ((d << 14) / s) + 1;
-
-      for (i = 0; i < d; i++)
-      {
-        ap = ((0x100 - ((val >> 8) & 0xFF)) * Cp) >> 8;
-        p[j] = ap | (Cp << 16);
-        j++;
-        val += inc;
-      }
+          i = rx;
+          k++;
+
+          if (TILE == TEXTURE_TILE_REPEAT  && k == tw    ) k = 0;
+          if (TILE == TEXTURE_TILE_REFLECT && k == tw * 2) k = 0;
+        }
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
     }
 
-    if (rv)
+    // ------------------------------------------------------------------------
+    // [Loop - Pad / Clamp]
+    // ------------------------------------------------------------------------
+
+    else if (TILE == TEXTURE_TILE_PAD || TILE == TEXTURE_TILE_CLAMP)
     {
-      for (i = d / 2; --i >= 0;)
-      {
-        int tmp = p[i];
+      Fixed32x32 limit = (Fixed32x32)tw << 32;
 
-        p[i] = p[d - i - 1];
-        p[d - i - 1] = tmp;
-      }
-    }
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
 
-    return p;
-  }
+        Fixed32x32 px = tx + (Fixed32x32)x * xx;
+        typename Accessor::Pixel pix;
 
-  static err_t FOG_FASTCALL init(RasterPattern* ctx, const Image& image, int dw, int dh, uint32_t interpolationType)
-  {
-    MemOps::zero(&ctx->scale, sizeof(ctx->scale));
+        // Before the texture.
+        int i = countBelow(px, xx, 0, w);
+        if (i != 0)
+        {
+          if (TILE == TEXTURE_TILE_PAD)
+            accessor.fetchNorm(pix, srcPixels);
+          else
+            pix = clamp;
 
-    int sw = image.getWidth();
-    int sh = image.getHeight();
+          w -= i;
+          dst = accessor.fill(dst, pix, i);
+          px += (Fixed32x32)i * xx;
+        }
 
-    ctx->scale.sw = sw;
-    ctx->scale.sh = sh;
-    ctx->scale.dw = Math::abs(dw);
-    ctx->scale.dh = Math::abs(dh);
-    ctx->scale.xup_yup = (ctx->scale.dw >= sw) | ((ctx->scale.dh >= sh) << 1);
+        // Inside the texture.
+        i = countBelow(px, xx, limit, w);
+        w -= i;
 
-    ctx->scale.xpoints = calcXPoints(sw, dw);
-    if (!ctx->scale.xpoints) goto fail;
+        while (i)
+        {
+          accessor.fetchNorm(pix, srcPixels + (int)(px >> 32) * Accessor::SRC_BPP);
+          accessor.store(dst, pix);
 
-    ctx->scale.ypoints = calcYPoints((uint32_t*)image.getData(), sw, sh, dh);
-    if (!ctx->scale.ypoints) goto fail;
+          dst += Accessor::DST_BPP;
+          px += xx;
+          i--;
+        }
 
-    if (interpolationType == IMAGE_INTERPOLATION_SMOOTH)
-    {
-      ctx->scale.xapoints = calcAPoints(sw, dw, (ctx->scale.xup_yup & 0x1) == 0x1);
-      if (!ctx->scale.xapoints) goto fail;
+        // After the texture.
+        if (w != 0)
+        {
+          if (TILE == TEXTURE_TILE_PAD)
+            accessor.fetchNorm(pix, srcPixels + (tw - 1) * Accessor::SRC_BPP);
+          else
+            pix = clamp;
 
-      ctx->scale.yapoints = calcAPoints(sh, dh, (ctx->scale.xup_yup & 0x2) == 0x2);
-      if (!ctx->scale.yapoints) goto fail;
+          dst = accessor.fill(dst, pix, w);
+        }
 
-      ctx->fetch = fetch_argb32_aa;
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
     }
+
+    // ------------------------------------------------------------------------
+    // [Loop - Repeat / Reflect]
+    // ------------------------------------------------------------------------
+
     else
     {
-      ctx->fetch = fetch_argb32_nn;
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
+
+        Fixed32x32 px = (tx + (Fixed32x32)x * xx) % mx;
+
+        do {
+          int px0 = (int)(px >> 32);
+          if (TILE == TEXTURE_TILE_REFLECT) px0 = reflectIndex(px0, tw);
+
+          typename Accessor::Pixel pix;
+          accessor.fetchNorm(pix, srcPixels + px0 * Accessor::SRC_BPP);
+          accessor.store(dst, pix);
+
+          dst += Accessor::DST_BPP;
+          px += xx;
+          if (px >= mx) px -= mx;
+        } while (--w);
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
     }
+    goto _FetchEnd;
+
+    // ------------------------------------------------------------------------
+    // [Solid]
+    // ------------------------------------------------------------------------
 
-    ctx->destroy = destroy;
+_FetchSolid:
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+      dst = accessor.fill(dst, clamp, w);
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
 
-    return ERR_OK;
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
 
-fail:
-    destroy(ctx);
-    return ERR_RT_OUT_OF_MEMORY;
+_FetchEnd:
+    advance<TILE>(fetcher);
   }
 
-  static void FOG_FASTCALL destroy(RasterPattern* ctx)
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_nearest_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
   {
-    MemMgr::free(ctx->scale.xpoints);
-    MemMgr::free(ctx->scale.ypoints);
-    MemMgr::free(ctx->scale.xapoints);
-    MemMgr::free(ctx->scale.yapoints);
+    _fetch_nearest<Accessor, TEXTURE_TILE_PAD>(fetcher, span, buffer);
   }
 
-  // Scale by pixel sampling only.
-  static void FOG_FASTCALL fetch_argb32_nn(
-    const RasterPattern* ctx, RasterSpan* span, uint8_t* buffer, int y, uint32_t mode)
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_nearest_repeat(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
   {
-    P_FETCH_SPAN8_INIT()
+    _fetch_nearest<Accessor, TEXTURE_TILE_REPEAT>(fetcher, span, buffer);
+  }
 
-    int dw = ctx->scale.dw;
-    int dh = ctx->scale.dh;
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_nearest_reflect(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    _fetch_nearest<Accessor, TEXTURE_TILE_REFLECT>(fetcher, span, buffer);
+  }
 
-    int i;
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_nearest_clamp(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    _fetch_nearest<Accessor, TEXTURE_TILE_CLAMP>(fetcher, span, buffer);
+  }
 
-    // Bound Y.
-    if ((uint)y >= (uint)dh) { y %= dh; if (y < 0) y += dh; }
+  // --------------------------------------------------------------------------
+  // [Fetch - Scale (Bilinear)]
+  // --------------------------------------------------------------------------
 
-    // Calculate the source line we'll scan from.
-    const uint32_t** ypoints = (const uint32_t**)ctx->scale.ypoints;
-    const uint32_t* sptr = ypoints[y];
+  template<typename Accessor, int TILE>
+  static FOG_INLINE void _fetch_bilinear(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
 
-    P_FETCH_SPAN8_BEGIN()
-      P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(4)
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
 
-      // Bound X.
-      if ((uint)x >= (uint)dw) { x %= dw; if (x < 0) x += dw; }
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
 
-      // Go through the scanline and copy across.
-      i = Math::min(dw - x, w);
-      const int* xpoints = ctx->scale.xpoints + x;
+    Fixed32x32 tx = ctx->_d.texture.scale.tx;
+    Fixed32x32 xx = ctx->_d.texture.scale.xx;
+    Fixed32x32 mx = ctx->_d.texture.scale.mx;
 
-      for (;;)
-      {
-        w -= i;
+    const uint8_t* srcPixels = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
 
-        do {
-          ((uint32_t*)dst)[0] = sptr[*xpoints++];
-          dst += 4;
-        } while(--i);
-        if (w == 0) break;
+    typename Accessor::Pixel clamp;
+    if (TILE == TEXTURE_TILE_CLAMP)
+      accessor.fetchSolid(clamp, ctx->_d.texture.base.clamp);
 
-        i = Math::min(dw, w);
-        xpoints = ctx->scale.xpoints;
-      }
+    P_FETCH_SPAN8_INIT()
 
-      P_FETCH_SPAN8_NEXT()
-    P_FETCH_SPAN8_END()
-  }
+    Fixed32x32 py = fetcher->_d.texture.scale.py;
 
-  // Scale by area sampling.
-  static void FOG_FASTCALL fetch_argb32_aa(
-    const RasterPattern* ctx, RasterSpan* span, uint8_t* buffer, int y, uint32_t mode)
-  {
-    P_FETCH_SPAN8_INIT()
+    int py0 = (int)(py >> 32);
+    int py1 = py0 + 1;
 
-    int dw = ctx->scale.dw;
-    int dh = ctx->scale.dh;
+    uint32_t wy = (uint32_t)(py >> 24) & 0xFF;
+    uint32_t inv_wy = 0x100 - wy;
 
-    // Bound Y.
-    if ((uint)y >= (uint)dh) { y %= dh; if (y < 0) y += dh; }
+    const uint8_t* srcLine0 = NULL;
+    const uint8_t* srcLine1 = NULL;
 
-    const uint32_t** ypoints = (const uint32_t**)ctx->scale.ypoints;
-    const int* xpoints = ctx->scale.xpoints;
+    switch (TILE)
+    {
+      case TEXTURE_TILE_PAD:
+        if (py0 < 0)
+          py0 = py1 = 0;
+        else if (py0 >= th - 1)
+          py0 = py1 = th - 1;
+        break;
+
+      case TEXTURE_TILE_REPEAT:
+        if (py1 == th) py1 = 0;
+        break;
+
+      case TEXTURE_TILE_REFLECT:
+        if (py1 == th * 2) py1 = 0;
+        py0 = reflectIndex(py0, th);
+        py1 = reflectIndex(py1, th);
+        break;
+
+      case TEXTURE_TILE_CLAMP:
+        if (py0 < -1 || py0 >= th) goto _FetchSolid;
+        break;
+    }
 
-    const int* xapoints = ctx->scale.xapoints;
-    const int* yapoints = ctx->scale.yapoints;
+    if ((uint)py0 < (uint)th) srcLine0 = srcPixels + py0 * srcStride;
+    if ((uint)py1 < (uint)th) srcLine1 = srcPixels + py1 * srcStride;
 
-    const uint32_t* sptr;
-    ssize_t sow = ctx->scale.sw;
+    // ------------------------------------------------------------------------
+    // [Loop - Pad]
+    // ------------------------------------------------------------------------
 
-    P_FETCH_SPAN8_BEGIN()
-      P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(4)
+    if (TILE == TEXTURE_TILE_PAD)
+    {
+      Fixed32x32 limit = (Fixed32x32)(tw - 1) << 32;
 
-      // Bounds X.
-      if ((uint)x >= (uint)dw) { x %= dw; if (x < 0) x += dw; }
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
 
-      // Go through the scanline and copy across.
-      int i = Math::min(dw - x, w);
-      int end = x + i;
+        Fixed32x32 px = tx + (Fixed32x32)x * xx;
 
-      for (;;)
-      {
-        w -= i;
+        typename Accessor::Pixel pix_x0y0;
+        typename Accessor::Pixel pix_x1y0;
+        typename Accessor::Pixel pix_x0y1;
+        typename Accessor::Pixel pix_x1y1;
 
-        if (ctx->scale.xup_yup == 3)
+        // Before the texture, only the first column is interpolated.
+        int i = countBelow(px, xx, 0, w);
+        if (i != 0)
         {
-          // Scaling up.
+          accessor.fetchRaw(pix_x0y0, srcLine0);
+          accessor.fetchRaw(pix_x0y1, srcLine1);
+          accessor.interpolateRaw_2(pix_x0y0, pix_x0y0, inv_wy, pix_x0y1, wy);
+          accessor.normalize(pix_x0y0, pix_x0y0);
+
+          w -= i;
+          dst = accessor.fill(dst, pix_x0y0, i);
+          px += (Fixed32x32)i * xx;
+        }
 
-          // Calculate the source line we'll scan from.
-          sptr = ypoints[y];
+        // Inside the texture, both columns are valid.
+        i = countBelow(px, xx, limit, w);
+        w -= i;
 
-          // BUG: Out of bounds!
-          if (YAP > 0 && y < ctx->scale.dh-1)
-          {
-            for (; x < end; x++)
-            {
-              int r, g, b, a;
-              int rr, gg, bb, aa;
-              const uint32_t* pix;
-
-              if (XAP > 0)
-              {
-                pix = ypoints[y] + xpoints[x];
-                r = R_VAL(pix) * INV_XAP;
-                g = G_VAL(pix) * INV_XAP;
-                b = B_VAL(pix) * INV_XAP;
-                a = A_VAL(pix) * INV_XAP;
-
-                pix++;
-                r += R_VAL(pix) * XAP;
-                g += G_VAL(pix) * XAP;
-                b += B_VAL(pix) * XAP;
-                a += A_VAL(pix) * XAP;
-
-                pix += sow;
-                rr = R_VAL(pix) * XAP;
-                gg = G_VAL(pix) * XAP;
-                bb = B_VAL(pix) * XAP;
-                aa = A_VAL(pix) * XAP;
-
-                pix--;
-                rr += R_VAL(pix) * INV_XAP;
-                gg += G_VAL(pix) * INV_XAP;
-                bb += B_VAL(pix) * INV_XAP;
-                aa += A_VAL(pix) * INV_XAP;
-
-                r = ((rr * YAP) + (r * INV_YAP)) >> 16;
-                g = ((gg * YAP) + (g * INV_YAP)) >> 16;
-                b = ((bb * YAP) + (b * INV_YAP)) >> 16;
-                a = ((aa * YAP) + (a * INV_YAP)) >> 16;
-
-                ((uint32_t*)dst)[0] = ARGB_COMPOSE(r, g, b, a);
-                dst += 4;
-              }
-              else
-              {
-                pix = ypoints[y] + xpoints[x];
-                r = R_VAL(pix) * INV_YAP;
-                g = G_VAL(pix) * INV_YAP;
-                b = B_VAL(pix) * INV_YAP;
-                a = A_VAL(pix) * INV_YAP;
-
-                pix += sow;
-                r += R_VAL(pix) * YAP;
-                g += G_VAL(pix) * YAP;
-                b += B_VAL(pix) * YAP;
-                a += A_VAL(pix) * YAP;
-
-                r >>= 8;
-                g >>= 8;
-                b >>= 8;
-                a >>= 8;
-
-                ((uint32_t*)dst)[0] = ARGB_COMPOSE(r, g, b, a);
-                dst += 4;
-              }
-            }
-          }
-          else
-          {
-            for (; x < end; x++)
-            {
-              int r, g, b, a;
-              const uint32_t* pix;
-
-              if (XAP > 0)
-              {
-                pix = ypoints[y] + xpoints[x];
-                r = R_VAL(pix) * INV_XAP;
-                g = G_VAL(pix) * INV_XAP;
-                b = B_VAL(pix) * INV_XAP;
-                a = A_VAL(pix) * INV_XAP;
-
-                pix++;
-                r += R_VAL(pix) * XAP;
-                g += G_VAL(pix) * XAP;
-                b += B_VAL(pix) * XAP;
-                a += A_VAL(pix) * XAP;
-
-                r >>= 8;
-                g >>= 8;
-                b >>= 8;
-                a >>= 8;
-
-                ((uint32_t*)dst)[0] = ARGB_COMPOSE(r, g, b, a);
-                dst += 4;
-              }
-              else
-              {
-                ((uint32_t*)dst)[0] = sptr[xpoints[x]];
-                dst += 4;
-              }
-            }
-          }
+        while (i)
+        {
+          uint px0 = (uint)(px >> 32) * Accessor::SRC_BPP;
+          uint32_t wx = (uint32_t)(px >> 24) & 0xFF;
+
+          accessor.fetchRaw(pix_x0y0, srcLine0 + px0);
+          accessor.fetchRaw(pix_x1y0, srcLine0 + px0 + Accessor::SRC_BPP);
+          accessor.fetchRaw(pix_x0y1, srcLine1 + px0);
+          accessor.fetchRaw(pix_x1y1, srcLine1 + px0 + Accessor::SRC_BPP);
+
+          accessor.interpolateRaw_4(pix_x0y0,
+            pix_x0y0, ((0x100 - wx) * (inv_wy)) >> 8,
+            pix_x1y0, ((wx        ) * (inv_wy)) >> 8,
+            pix_x0y1, ((0x100 - wx) * (wy    )) >> 8,
+            pix_x1y1, ((wx        ) * (wy    )) >> 8);
+          accessor.normalize(pix_x0y0, pix_x0y0);
+          accessor.store(dst, pix_x0y0);
+
+          dst += Accessor::DST_BPP;
+          px += xx;
+          i--;
         }
-        else if (ctx->scale.xup_yup == 1)
+
+        // After the texture, only the last column is interpolated.
+        if (w != 0)
         {
-          // Scaling down vertically.
-          int Cy, j;
-          const uint32_t* pix;
-          int r, g, b, a, rr, gg, bb, aa;
-          int yap;
+          accessor.fetchRaw(pix_x0y0, srcLine0 + (tw - 1) * Accessor::SRC_BPP);
+          accessor.fetchRaw(pix_x0y1, srcLine1 + (tw - 1) * Accessor::SRC_BPP);
+          accessor.interpolateRaw_2(pix_x0y0, pix_x0y0, inv_wy, pix_x0y1, wy);
+          accessor.normalize(pix_x0y0, pix_x0y0);
 
-          Cy = YAP >> 16;
-          yap = YAP & 0xffff;
+          dst = accessor.fill(dst, pix_x0y0, w);
+        }
 
-          for (; x < end; x++)
-          {
-            pix = ypoints[y] + xpoints[x];
-            r = (R_VAL(pix) * yap) >> 10;
-            g = (G_VAL(pix) * yap) >> 10;
-            b = (B_VAL(pix) * yap) >> 10;
-            a = (A_VAL(pix) * yap) >> 10;
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
 
-            for (j = (1 << 14) - yap; j > Cy; j -= Cy)
-            {
-              pix += sow;
-              r += (R_VAL(pix) * Cy) >> 10;
-              g += (G_VAL(pix) * Cy) >> 10;
-              b += (B_VAL(pix) * Cy) >> 10;
-              a += (A_VAL(pix) * Cy) >> 10;
-            }
+    // ------------------------------------------------------------------------
+    // [Loop - Repeat / Reflect]
+    // ------------------------------------------------------------------------
 
-            if (j > 0)
-            {
-              pix += sow;
-              r += (R_VAL(pix) * j) >> 10;
-              g += (G_VAL(pix) * j) >> 10;
-              b += (B_VAL(pix) * j) >> 10;
-              a += (A_VAL(pix) * j) >> 10;
-            }
+    else if (TILE == TEXTURE_TILE_REPEAT || TILE == TEXTURE_TILE_REFLECT)
+    {
+      int mw = (TILE == TEXTURE_TILE_REFLECT) ? tw * 2 : tw;
 
-            if (XAP > 0)
-            {
-              pix = ypoints[y] + xpoints[x] + 1;
-              rr = (R_VAL(pix) * yap) >> 10;
-              gg = (G_VAL(pix) * yap) >> 10;
-              bb = (B_VAL(pix) * yap) >> 10;
-              aa = (A_VAL(pix) * yap) >> 10;
-
-              for (j = (1 << 14) - yap; j > Cy; j -= Cy)
-              {
-                pix += sow;
-                rr += (R_VAL(pix) * Cy) >> 10;
-                gg += (G_VAL(pix) * Cy) >> 10;
-                bb += (B_VAL(pix) * Cy) >> 10;
-                aa += (A_VAL(pix) * Cy) >> 10;
-              }
-              if (j > 0)
-              {
-                pix += sow;
-                rr += (R_VAL(pix) * j) >> 10;
-                gg += (G_VAL(pix) * j) >> 10;
-                bb += (B_VAL(pix) * j) >> 10;
-                aa += (A_VAL(pix) * j) >> 10;
-              }
-
-              r = r * INV_XAP;
-              g = g * INV_XAP;
-              b = b * INV_XAP;
-              a = a * INV_XAP;
-
-              r = (r + ((rr * XAP))) >> 12;
-              g = (g + ((gg * XAP))) >> 12;
-              b = (b + ((bb * XAP))) >> 12;
-              a = (a + ((aa * XAP))) >> 12;
-            }
-            else
-            {
-              r >>= 4;
-              g >>= 4;
-              b >>= 4;
-              a >>= 4;
-            }
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
 
-            ((uint32_t*)dst)[0] = ARGB_COMPOSE(r, g, b, a);
-            dst += 4;
-          }
-        }
-        else if (ctx->scale.xup_yup == 2)
-        {
-          // Scaling down horizontally.
-          int Cx, j;
-          const uint32_t* pix;
-          int r, g, b, a, rr, gg, bb, aa;
-          int xap;
+        Fixed32x32 px = (tx + (Fixed32x32)x * xx) % mx;
 
-          for (; x < end; x++)
-          {
-            Cx = XAP >> 16;
-            xap = XAP & 0xffff;
+        do {
+          int px0 = (int)(px >> 32);
+          int px1 = px0 + 1;
+          uint32_t wx = (uint32_t)(px >> 24) & 0xFF;
 
-            pix = ypoints[y] + xpoints[x];
-            r = (R_VAL(pix) * xap) >> 10;
-            g = (G_VAL(pix) * xap) >> 10;
-            b = (B_VAL(pix) * xap) >> 10;
-            a = (A_VAL(pix) * xap) >> 10;
+          if (px1 == mw) px1 = 0;
 
-            for (j = (1 << 14) - xap; j > Cx; j -= Cx)
-            {
-              pix++;
-              r += (R_VAL(pix) * Cx) >> 10;
-              g += (G_VAL(pix) * Cx) >> 10;
-              b += (B_VAL(pix) * Cx) >> 10;
-              a += (A_VAL(pix) * Cx) >> 10;
-            }
+          if (TILE == TEXTURE_TILE_REFLECT)
+          {
+            px0 = reflectIndex(px0, tw);
+            px1 = reflectIndex(px1, tw);
+          }
 
-            if (j > 0)
-            {
-              pix++;
-              r += (R_VAL(pix) * j) >> 10;
-              g += (G_VAL(pix) * j) >> 10;
-              b += (B_VAL(pix) * j) >> 10;
-              a += (A_VAL(pix) * j) >> 10;
-            }
+          typename Accessor::Pixel pix_x0y0;
+          typename Accessor::Pixel pix_x1y0;
+          typename Accessor::Pixel pix_x0y1;
+          typename Accessor::Pixel pix_x1y1;
+
+          accessor.fetchRaw(pix_x0y0, srcLine0 + px0 * Accessor::SRC_BPP);
+          accessor.fetchRaw(pix_x1y0, srcLine0 + px1 * Accessor::SRC_BPP);
+          accessor.fetchRaw(pix_x0y1, srcLine1 + px0 * Accessor::SRC_BPP);
+          accessor.fetchRaw(pix_x1y1, srcLine1 + px1 * Accessor::SRC_BPP);
+
+          accessor.interpolateRaw_4(pix_x0y0,
+            pix_x0y0, ((0x100 - wx) * (inv_wy)) >> 8,
+            pix_x1y0, ((wx        ) * (inv_wy)) >> 8,
+            pix_x0y1, ((0x100 - wx) * (wy    )) >> 8,
+            pix_x1y1, ((wx        ) * (wy    )) >> 8);
+          accessor.normalize(pix_x0y0, pix_x0y0);
+          accessor.store(dst, pix_x0y0);
+
+          dst += Accessor::DST_BPP;
+          px += xx;
+          if (px >= mx) px -= mx;
+        } while (--w);
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
 
-            if (YAP > 0)
-            {
-              pix = ypoints[y] + xpoints[x] + sow;
-
-              rr = (R_VAL(pix) * xap) >> 10;
-              gg = (G_VAL(pix) * xap) >> 10;
-              bb = (B_VAL(pix) * xap) >> 10;
-              aa = (A_VAL(pix) * xap) >> 10;
-
-              for (j = (1 << 14) - xap; j > Cx; j -= Cx)
-              {
-                pix++;
-                rr += (R_VAL(pix) * Cx) >> 10;
-                gg += (G_VAL(pix) * Cx) >> 10;
-                bb += (B_VAL(pix) * Cx) >> 10;
-                aa += (A_VAL(pix) * Cx) >> 10;
-              }
-              if (j > 0)
-              {
-                pix++;
-                rr += (R_VAL(pix) * j) >> 10;
-                gg += (G_VAL(pix) * j) >> 10;
-                bb += (B_VAL(pix) * j) >> 10;
-                aa += (A_VAL(pix) * j) >> 10;
-              }
-
-              r = r * INV_YAP;
-              g = g * INV_YAP;
-              b = b * INV_YAP;
-              a = a * INV_YAP;
-
-              r = (r + ((rr * YAP))) >> 12;
-              g = (g + ((gg * YAP))) >> 12;
-              b = (b + ((bb * YAP))) >> 12;
-              a = (a + ((aa * YAP))) >> 12;
-            }
-            else
-            {
-              r >>= 4;
-              g >>= 4;
-              b >>= 4;
-              a >>= 4;
-            }
+    // ------------------------------------------------------------------------
+    // [Loop - Clamp]
+    // ------------------------------------------------------------------------
 
-            ((uint32_t*)dst)[0] = ARGB_COMPOSE(r, g, b, a);
-            dst += 4;
-          }
-        }
-        else
-        {
-          // Scaling down horizontally & vertically.
-          int Cx, Cy, i, j;
-          const uint32_t* pix;
-          int a, r, g, b, ax, rx, gx, bx;
-          int xap, yap;
+    else
+    {
+      tw--;
 
-          Cy = YAP >> 16;
-          yap = YAP & 0xffff;
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
 
-          for (; x < end; x++)
-          {
-            Cx = XAP >> 16;
-            xap = XAP & 0xffff;
+        Fixed32x32 px = tx + (Fixed32x32)x * xx;
 
-            sptr = ypoints[y] + xpoints[x];
-            pix = sptr;
-            sptr += sow;
+        do {
+          int px0 = (int)(px >> 32);
+          uint32_t wx = (uint32_t)(px >> 24) & 0xFF;
 
-            rx = (R_VAL(pix) * xap) >> 9;
-            gx = (G_VAL(pix) * xap) >> 9;
-            bx = (B_VAL(pix) * xap) >> 9;
-            ax = (A_VAL(pix) * xap) >> 9;
+          typename Accessor::Pixel pix_x0y0;
+          typename Accessor::Pixel pix_x1y0;
+          typename Accessor::Pixel pix_x0y1;
+          typename Accessor::Pixel pix_x1y1;
 
-            pix++;
+          if (FOG_LIKELY((uint)px0 < (uint)tw && srcLine0 != NULL && srcLine1 != NULL))
+          {
+            accessor.fetchRaw(pix_x0y0, srcLine0 + (uint)px0 * Accessor::SRC_BPP);
+            accessor.fetchRaw(pix_x1y0, srcLine0 + (uint)px0 * Accessor::SRC_BPP + Accessor::SRC_BPP);
+            accessor.fetchRaw(pix_x0y1, srcLine1 + (uint)px0 * Accessor::SRC_BPP);
+            accessor.fetchRaw(pix_x1y1, srcLine1 + (uint)px0 * Accessor::SRC_BPP + Accessor::SRC_BPP);
+
+            accessor.interpolateRaw_4(pix_x0y0,
+              pix_x0y0, ((0x100 - wx) * (inv_wy)) >> 8,
+              pix_x1y0, ((wx        ) * (inv_wy)) >> 8,
+              pix_x0y1, ((0x100 - wx) * (wy    )) >> 8,
+              pix_x1y1, ((wx        ) * (wy    )) >> 8);
+            accessor.normalize(pix_x0y0, pix_x0y0);
+            accessor.store(dst, pix_x0y0);
+          }
+          else if (px0 >= -1 && px0 <= tw)
+          {
+            int px1 = px0 + 1;
 
-            for (i = (1 << 14) - xap; i > Cx; i -= Cx)
-            {
-              rx += (R_VAL(pix) * Cx) >> 9;
-              gx += (G_VAL(pix) * Cx) >> 9;
-              bx += (B_VAL(pix) * Cx) >> 9;
-              ax += (A_VAL(pix) * Cx) >> 9;
-              pix++;
-            }
+            pix_x0y0 = clamp;
+            pix_x1y0 = clamp;
+            pix_x0y1 = clamp;
+            pix_x1y1 = clamp;
 
-            if (i > 0)
+            if (srcLine0 != NULL)
             {
-              rx += (R_VAL(pix) * i) >> 9;
-              gx += (G_VAL(pix) * i) >> 9;
-              bx += (B_VAL(pix) * i) >> 9;
-              ax += (A_VAL(pix) * i) >> 9;
+              if (px0 >= 0) accessor.fetchNorm(pix_x0y0, srcLine0 + px0 * Accessor::SRC_BPP);
+              if (px1 <= tw) accessor.fetchNorm(pix_x1y0, srcLine0 + px1 * Accessor::SRC_BPP);
             }
 
-            r = (rx * yap) >> 14;
-            g = (gx * yap) >> 14;
-            b = (bx * yap) >> 14;
-            a = (ax * yap) >> 14;
-
-            for (j = (1 << 14) - yap; j > Cy; j -= Cy)
+            if (srcLine1 != NULL)
             {
-              pix = sptr;
-              sptr += sow;
-              rx = (R_VAL(pix) * xap) >> 9;
-              gx = (G_VAL(pix) * xap) >> 9;
-              bx = (B_VAL(pix) * xap) >> 9;
-              ax = (A_VAL(pix) * xap) >> 9;
-              pix++;
-
-              for (i = (1 << 14) - xap; i > Cx; i -= Cx)
-              {
-                rx += (R_VAL(pix) * Cx) >> 9;
-                gx += (G_VAL(pix) * Cx) >> 9;
-                bx += (B_VAL(pix) * Cx) >> 9;
-                ax += (A_VAL(pix) * Cx) >> 9;
-                pix++;
-              }
-
-              if (i > 0)
-              {
-                rx += (R_VAL(pix) * i) >> 9;
-                gx += (G_VAL(pix) * i) >> 9;
-                bx += (B_VAL(pix) * i) >> 9;
-                ax += (A_VAL(pix) * i) >> 9;
-              }
-
-              r += (rx * Cy) >> 14;
-              g += (gx * Cy) >> 14;
-              b += (bx * Cy) >> 14;
-              a += (ax * Cy) >> 14;
-            }
-            if (j > 0)
-            {
-              pix = sptr;
-              sptr += sow;
-              rx = (R_VAL(pix) * xap) >> 9;
-              gx = (G_VAL(pix) * xap) >> 9;
-              bx = (B_VAL(pix) * xap) >> 9;
-              ax = (A_VAL(pix) * xap) >> 9;
-              pix++;
-
-              for (i = (1 << 14) - xap; i > Cx; i -= Cx)
-              {
-                rx += (R_VAL(pix) * Cx) >> 9;
-                gx += (G_VAL(pix) * Cx) >> 9;
-                bx += (B_VAL(pix) * Cx) >> 9;
-                ax += (A_VAL(pix) * Cx) >> 9;
-                pix++;
-              }
-
-              if (i > 0)
-              {
-                rx += (R_VAL(pix) * i) >> 9;
-                gx += (G_VAL(pix) * i) >> 9;
-                bx += (B_VAL(pix) * i) >> 9;
-                ax += (A_VAL(pix) * i) >> 9;
-              }
-
-              r += (rx * j) >> 14;
-              g += (gx * j) >> 14;
-              b += (bx * j) >> 14;
-              a += (ax * j) >> 14;
+              if (px0 >= 0) accessor.fetchNorm(pix_x0y1, srcLine1 + px0 * Accessor::SRC_BPP);
+              if (px1 <= tw) accessor.fetchNorm(pix_x1y1, srcLine1 + px1 * Accessor::SRC_BPP);
             }
 
-            R_VAL(dst) = r >> 5;
-            G_VAL(dst) = g >> 5;
-            B_VAL(dst) = b >> 5;
-            A_VAL(dst) = a >> 5;
-            dst += 4;
+            accessor.interpolateNorm_4(pix_x0y0,
+              pix_x0y0, ((0x100 - wx) * (inv_wy)) >> 8,
+              pix_x1y0, ((wx        ) * (inv_wy)) >> 8,
+              pix_x0y1, ((0x100 - wx) * (wy    )) >> 8,
+              pix_x1y1, ((wx        ) * (wy    )) >> 8);
+            accessor.store(dst, pix_x0y0);
           }
-        }
+          else
+          {
+            accessor.store(dst, clamp);
+          }
+
+          dst += Accessor::DST_BPP;
+          px += xx;
+        } while (--w);
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+    goto _FetchEnd;
 
-        if (w == 0) break;
+    // ------------------------------------------------------------------------
+    // [Solid]
+    // ------------------------------------------------------------------------
 
-        i = Math::min(dw, w);
-        x = 0;
-        end = i;
-      };
+_FetchSolid:
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+      dst = accessor.fill(dst, clamp, w);
       P_FETCH_SPAN8_NEXT()
     P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+_FetchEnd:
+    advance<TILE>(fetcher);
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_bilinear_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    _fetch_bilinear<Accessor, TEXTURE_TILE_PAD>(fetcher, span, buffer);
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_bilinear_repeat(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    _fetch_bilinear<Accessor, TEXTURE_TILE_REPEAT>(fetcher, span, buffer);
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_bilinear_reflect(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    _fetch_bilinear<Accessor, TEXTURE_TILE_REFLECT>(fetcher, span, buffer);
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_bilinear_clamp(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    _fetch_bilinear<Accessor, TEXTURE_TILE_CLAMP>(fetcher, span, buffer);
   }
 };
 
 } // RasterOps_C namespace
 } // Fog namespace
 
-#endif
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_TEXTURESCALE_P_H
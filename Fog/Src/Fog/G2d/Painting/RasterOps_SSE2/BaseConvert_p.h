@@ -122,6 +122,127 @@ struct FOG_NO_EXPORT Convert
       Acc::m128iStore16u(dst + (uint)w * 2 - 16, xmm0);
     }
   }
+
+  // ==========================================================================
+  // [BSwap - 16]
+  // ==========================================================================
+
+  static void FOG_FASTCALL bswap_16(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i xmm0, xmm1;
+
+      Acc::m128iLoad16u(xmm0, src);
+      Acc::m128iRShiftPU16<8>(xmm1, xmm0);
+      Acc::m128iLShiftPU16<8>(xmm0, xmm0);
+      Acc::m128iOr(xmm0, xmm0, xmm1);
+      Acc::m128iStore16u(dst, xmm0);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 8;
+    if (w > 0)
+      RasterOps_C::Convert::bswap_16(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [BSwap - 32]
+  // ==========================================================================
+
+  static void FOG_FASTCALL bswap_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i xmm0, xmm1;
+
+      Acc::m128iLoad16u(xmm0, src);
+      Acc::m128iShufflePI16Lo<1, 0, 3, 2>(xmm0, xmm0);
+      Acc::m128iShufflePI16Hi<1, 0, 3, 2>(xmm0, xmm0);
+      Acc::m128iRShiftPU16<8>(xmm1, xmm0);
+      Acc::m128iLShiftPU16<8>(xmm0, xmm0);
+      Acc::m128iOr(xmm0, xmm0, xmm1);
+      Acc::m128iStore16u(dst, xmm0);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w > 0)
+      RasterOps_C::Convert::bswap_32(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [Shuffle - 32 <- 32]
+  // ==========================================================================
+
+  //! @brief 32-bit to 32-bit shuffle without PSHUFB, each destination byte is
+  //! produced by one of the precalculated shift/mask pairs.
+  static void FOG_FASTCALL shuffle_32_from_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    const ImageConverterData* d = reinterpret_cast<const ImageConverterData*>(closure->data);
+    const RasterConvertShuffle* shuffle = reinterpret_cast<const RasterConvertShuffle*>(d->buffer);
+
+    uint32_t i;
+    uint32_t count = shuffle->shiftCount;
+
+    __m128i xmmFill;
+    __m128i xmmMask[4];
+    __m128i xmmShift[4];
+    bool shiftLeft[4];
+
+    Acc::m128iLoad16u(xmmFill, shuffle->fill);
+
+    for (i = 0; i < count; i++)
+    {
+      int32_t shift = shuffle->shift[i];
+
+      shiftLeft[i] = shift >= 0;
+      Acc::m128iCvtSI128FromSI(xmmShift[i], shift >= 0 ? shift : -shift);
+      Acc::m128iCvtSI128FromSI(xmmMask[i], (int)shuffle->shiftMask[i]);
+      Acc::m128iShufflePI32<0, 0, 0, 0>(xmmMask[i], xmmMask[i]);
+    }
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i xmm0, xmm1, xmm2;
+
+      Acc::m128iLoad16u(xmm0, src);
+      xmm2 = xmmFill;
+
+      for (i = 0; i < count; i++)
+      {
+        if (shiftLeft[i])
+          Acc::m128iLShiftPU32(xmm1, xmm0, xmmShift[i]);
+        else
+          Acc::m128iRShiftPU32(xmm1, xmm0, xmmShift[i]);
+
+        Acc::m128iAnd(xmm1, xmm1, xmmMask[i]);
+        Acc::m128iOr(xmm2, xmm2, xmm1);
+      }
+
+      Acc::m128iStore16u(dst, xmm2);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w > 0)
+      RasterOps_C::Convert::shuffle_32_from_32(dst, src, w, closure);
+  }
 };
 
 } // RasterOps_SSE2 namespace
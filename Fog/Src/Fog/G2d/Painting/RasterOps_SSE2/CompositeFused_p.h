@@ -0,0 +1,290 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_COMPOSITEFUSED_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_COMPOSITEFUSED_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/CompositeFused_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrcOver_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/TextureScale_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - PFusedOp]
+// ============================================================================
+
+// Operators of the SSE2 fused kernels. The pixels are generated by the sources
+// of RasterOps_C::CompositeFused and composited four at a time, pixels4() gets
+// them packed in a single register, pixels1() gets one pixel in the low dword.
+
+//! @internal
+//!
+//! @brief Fused SRC operator, PRGB32 destination and PRGB32 source (SSE2).
+struct FOG_NO_EXPORT PFusedOp_Src_PRGB32
+{
+  static FOG_INLINE void pixels1(uint8_t* dst, const __m128i& src0xmm)
+  {
+    Acc::m128iStore4(dst, src0xmm);
+  }
+
+  static FOG_INLINE void pixels4(uint8_t* dst, const __m128i& src0xmm)
+  {
+    Acc::m128iStore16u(dst, src0xmm);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    __m128i src0xmm;
+
+    while (w >= 4)
+    {
+      Acc::m128iLoad16u(src0xmm, src);
+      Acc::m128iStore16u(dst, src0xmm);
+
+      dst += 16;
+      src += 16;
+      w -= 4;
+    }
+
+    while (w)
+    {
+      Acc::m128iLoad4(src0xmm, src);
+      Acc::m128iStore4(dst, src0xmm);
+
+      dst += 4;
+      src += 4;
+      w--;
+    }
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused SRC operator, PRGB32 or XRGB32 destination and XRGB32 source
+//! (SSE2).
+struct FOG_NO_EXPORT PFusedOp_Src_XRGB32
+{
+  static FOG_INLINE void pixels1(uint8_t* dst, const __m128i& src0xmm)
+  {
+    __m128i dst0xmm;
+
+    Acc::m128iOr(dst0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+    Acc::m128iStore4(dst, dst0xmm);
+  }
+
+  static FOG_INLINE void pixels4(uint8_t* dst, const __m128i& src0xmm)
+  {
+    __m128i dst0xmm;
+
+    Acc::m128iOr(dst0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+    Acc::m128iStore16u(dst, dst0xmm);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    __m128i src0xmm;
+
+    while (w >= 4)
+    {
+      Acc::m128iLoad16u(src0xmm, src);
+      pixels4(dst, src0xmm);
+
+      dst += 16;
+      src += 16;
+      w -= 4;
+    }
+
+    while (w)
+    {
+      Acc::m128iLoad4(src0xmm, src);
+      pixels1(dst, src0xmm);
+
+      dst += 4;
+      src += 4;
+      w--;
+    }
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused SRC_OVER operator, PRGB32 destination and PRGB32 source
+//! (SSE2).
+//!
+//! The math is the C-Opaque loop of @c CompositeSrcOver::prgb32_vblit_prgb32_span().
+struct FOG_NO_EXPORT PFusedOp_SrcOver_PRGB32
+{
+  static FOG_INLINE void pixels1(uint8_t* dst, const __m128i& src0xmm)
+  {
+    __m128i dst0xmm;
+    __m128i src1xmm;
+    __m128i sra0xmm;
+
+    Acc::m128iLoad4ZX(dst0xmm, dst);
+    Acc::m128iUnpackPI16FromPI8Lo(src1xmm, src0xmm);
+    Acc::m128iShufflePI16Lo<3, 3, 3, 3>(sra0xmm, src1xmm);
+    Acc::m128iNegate255PI16(sra0xmm, sra0xmm);
+    Acc::m128iMulDiv255PI16(dst0xmm, dst0xmm, sra0xmm);
+    Acc::m128iAddPI32(dst0xmm, dst0xmm, src1xmm);
+    Acc::m128iPackPU8FromPU16(dst0xmm, dst0xmm);
+    Acc::m128iStore4(dst, dst0xmm);
+  }
+
+  static FOG_INLINE void pixels4(uint8_t* dst, const __m128i& src0xmm)
+  {
+    __m128i dst0xmm, dst1xmm;
+    __m128i sra0xmm, sra1xmm;
+
+    Acc::m128iLoad16u(dst0xmm, dst);
+
+    Acc::m128iFill(sra0xmm);
+    Acc::m128iXor(sra0xmm, sra0xmm, src0xmm);
+    Acc::m128iUnpackPI16FromPI8Hi(dst1xmm, dst0xmm);
+    Acc::m128iUnpackPI16FromPI8Lo(dst0xmm, dst0xmm);
+
+    Acc::m128iUnpackAlphaPI16FromARGB32_PI8(sra0xmm, sra1xmm, sra0xmm);
+    Acc::m128iMulDiv255PI16_2x(dst0xmm, dst0xmm, sra0xmm, dst1xmm, dst1xmm, sra1xmm);
+
+    Acc::m128iPackPU8FromPU16(dst0xmm, dst0xmm, dst1xmm);
+    Acc::m128iAddPI32(dst0xmm, dst0xmm, src0xmm);
+    Acc::m128iStore16u(dst, dst0xmm);
+  }
+
+  static FOG_INLINE void line(uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    CompositeSrcOver::_prgb32_vblit_prgb32_line(dst, src, w);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - CompositeFused]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused fetch+composite kernels (SSE2).
+//!
+//! Same as @c RasterOps_C::CompositeFused, but pixels of opaque spans are
+//! gathered into a register and composited four at a time.
+struct FOG_NO_EXPORT CompositeFused
+{
+  // ==========================================================================
+  // [Span]
+  // ==========================================================================
+
+  template<typename Source, typename Op, RasterVBlitSpanFunc BlitFunc>
+  static void FOG_FASTCALL span(
+    uint8_t* dst, RasterSpan* span,
+    RasterPatternFetcher* fetcher, uint8_t* buffer,
+    const RasterClosure* closure)
+  {
+    uint8_t* dstBase = dst;
+
+    int x = (int)span->getX0();
+    Source source(fetcher, x);
+
+    for (;;)
+    {
+      int w = (int)span->getX1() - x;
+      FOG_ASSERT(w > 0);
+
+      if (span->getType() == RASTER_SPAN_C && reinterpret_cast<const RasterSpan8*>(span)->isConstMaskOpaque())
+      {
+        const uint8_t* src = source.getRun(w);
+        dst = dstBase + (uint)x * 4;
+
+        if (src != NULL)
+        {
+          Op::line(dst, src, w, closure);
+        }
+        else
+        {
+          __m128i pix0, pix1, pix2, pix3;
+
+          while (w >= 4)
+          {
+            Acc::m128iCvtSI128FromSI(pix0, (int)source.next());
+            Acc::m128iCvtSI128FromSI(pix1, (int)source.next());
+            Acc::m128iCvtSI128FromSI(pix2, (int)source.next());
+            Acc::m128iCvtSI128FromSI(pix3, (int)source.next());
+
+            Acc::m128iUnpackPI64FromPI32Lo(pix0, pix0, pix1);
+            Acc::m128iUnpackPI64FromPI32Lo(pix2, pix2, pix3);
+            Acc::m128iUnpackSI128FromPI64Lo(pix0, pix0, pix2);
+
+            Op::pixels4(dst, pix0);
+
+            dst += 16;
+            w -= 4;
+          }
+
+          while (w)
+          {
+            Acc::m128iCvtSI128FromSI(pix0, (int)source.next());
+            Op::pixels1(dst, pix0);
+
+            dst += 4;
+            w--;
+          }
+        }
+      }
+      else
+      {
+        RasterOps_C::CompositeFused::_blitMasked<Source, BlitFunc>(dstBase, span, source, w, buffer, closure);
+      }
+
+      int xEnd = (int)span->getX1();
+      if ((span = span->getNext()) == NULL)
+        break;
+
+      x = (int)span->getX0();
+      if (x != xEnd)
+        source.skip(x - xEnd);
+    }
+
+    source.advance(fetcher);
+  }
+
+  // ==========================================================================
+  // [Add]
+  // ==========================================================================
+
+  template<RasterPatternFetchFunc FetchFunc, typename Source, typename Op, RasterVBlitSpanFunc BlitFunc>
+  static FOG_INLINE void add(RasterFusedFuncs& fused)
+  {
+    fused.add(FetchFunc, BlitFunc, span<Source, Op, BlitFunc>);
+  }
+
+  //! @brief Add kernels for the hot PRGB32 pattern fetchers composited by
+  //! @a BlitFunc, the scaled texture is fetched by the SSE2 fetcher.
+  template<typename Op, RasterVBlitSpanFunc BlitFunc>
+  static void addPRGB32Fetchers(RasterFusedFuncs& fused)
+  {
+    typedef RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32 Accessor_PRGB32;
+    typedef RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32 Accessor_XRGB32;
+    typedef RasterOps_C::PGradientAccessor_PRGB32_Base Accessor_Gradient;
+
+    add<RasterOps_C::PTextureSimple::fetch_align_pad   <Accessor_PRGB32>, RasterOps_C::PFusedSource_TextureAlignPad   <Accessor_PRGB32>, Op, BlitFunc>(fused);
+    add<RasterOps_C::PTextureSimple::fetch_align_pad   <Accessor_XRGB32>, RasterOps_C::PFusedSource_TextureAlignPad   <Accessor_XRGB32>, Op, BlitFunc>(fused);
+    add<RasterOps_C::PTextureSimple::fetch_align_repeat<Accessor_PRGB32>, RasterOps_C::PFusedSource_TextureAlignRepeat<Accessor_PRGB32>, Op, BlitFunc>(fused);
+    add<RasterOps_C::PTextureSimple::fetch_align_repeat<Accessor_XRGB32>, RasterOps_C::PFusedSource_TextureAlignRepeat<Accessor_XRGB32>, Op, BlitFunc>(fused);
+
+    add<PTextureScale::fetch_scale_nearest_pad<Accessor_PRGB32>, RasterOps_C::PFusedSource_TextureScaleNearestPad<Accessor_PRGB32>, Op, BlitFunc>(fused);
+    add<PTextureScale::fetch_scale_nearest_pad<Accessor_XRGB32>, RasterOps_C::PFusedSource_TextureScaleNearestPad<Accessor_XRGB32>, Op, BlitFunc>(fused);
+
+    add<RasterOps_C::PGradientLinear::fetch_simple_nearest_pad   <Accessor_Gradient>, RasterOps_C::PFusedSource_GradientLinearPad   , Op, BlitFunc>(fused);
+    add<RasterOps_C::PGradientLinear::fetch_simple_nearest_repeat<Accessor_Gradient>, RasterOps_C::PFusedSource_GradientLinearRepeat, Op, BlitFunc>(fused);
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_COMPOSITEFUSED_P_H
@@ -0,0 +1,427 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERTURBULENCE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERTURBULENCE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterTurbulence_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Turbulence - Constants]
+// ============================================================================
+
+FOG_XMM_DECLARE_CONST_PI32_VAR(FTurbulence_3_2_1_0, 3, 2, 1, 0);
+FOG_XMM_DECLARE_CONST_PS_SET  (FTurbulence_2      , 2.0f);
+FOG_XMM_DECLARE_CONST_PS_SET  (FTurbulence_3      , 3.0f);
+FOG_XMM_DECLARE_CONST_PS_SET  (FTurbulence_Perlin , float(Fog::RASTER_TURBULENCE_PERLIN));
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Turbulence - Octave]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Octave data shared by all pixels of a row.
+//!
+//! All pixels of a row have the same y coordinate, so the vertical lattice
+//! coordinates are computed only once per row and octave.
+struct FOG_NO_EXPORT FTurbulenceOctave
+{
+  //! @brief Fractional y coordinate (ry0, ry1) and its s-curve (sy).
+  __m128f ry0;
+  __m128f ry1;
+  __m128f sy;
+
+  //! @brief Stitching, the minimum x lattice coordinate to wrap minus one and
+  //! how much to subtract (zero if not stitching).
+  __m128i wrapX;
+  __m128i width;
+
+  //! @brief Lattice rows (by0, by1).
+  int by0;
+  int by1;
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Turbulence]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Turbulence generator (SSE2).
+//!
+//! Four neighbouring pixels are generated at once. The lattice coordinates and
+//! s-curves are computed for all pixels in one xmm register (one pixel per
+//! lane), then the lattice lookups are gathered per lane and the gradients of
+//! each pixel are interpolated with all four channels in one xmm register.
+//! Transposing the gradients to interpolate each channel of all pixels at once
+//! needs 8 transposes per octave and was measured to be slower. The result is
+//! bit-exact with RasterOps_C::FTurbulence.
+struct FOG_NO_EXPORT FTurbulence
+{
+  // ==========================================================================
+  // [Turbulence - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void fillPS(__m128f& dst, float x)
+  {
+    Acc::m128fLoad4(dst, &x);
+    Acc::m128fExtendSS(dst, dst);
+  }
+
+  static FOG_INLINE void fillPI32(__m128i& dst, int x)
+  {
+    Acc::m128iCvtSI128FromSI(dst, x);
+    Acc::m128iExtendPI32FromSI32(dst, dst);
+  }
+
+  //! @brief Get the s-curve of @a t (t * t * (3 - 2 * t)).
+  static FOG_INLINE void sCurve(__m128f& dst, const __m128f& t)
+  {
+    __m128f u;
+
+    Acc::m128fMulPS(u, t, FOG_XMM_GET_CONST_PS(FTurbulence_2));
+    Acc::m128fSubPS(u, FOG_XMM_GET_CONST_PS(FTurbulence_3), u);
+    Acc::m128fMulPS(dst, t, t);
+    Acc::m128fMulPS(dst, dst, u);
+  }
+
+  //! @brief Transpose 4x4 matrix @a m.
+  static FOG_INLINE void transpose(__m128f* m)
+  {
+    __m128f t0, t1, t2, t3;
+
+    Acc::m128fUnpackLo(t0, m[0], m[1]);
+    Acc::m128fUnpackHi(t1, m[0], m[1]);
+    Acc::m128fUnpackLo(t2, m[2], m[3]);
+    Acc::m128fUnpackHi(t3, m[2], m[3]);
+
+    Acc::m128fMoveLH(m[0], t0, t2);
+    Acc::m128fMoveHL(m[1], t2, t0);
+    Acc::m128fMoveLH(m[2], t1, t3);
+    Acc::m128fMoveHL(m[3], t3, t1);
+  }
+
+  // ==========================================================================
+  // [Turbulence - Octaves]
+  // ==========================================================================
+
+  //! @brief Initialize octaves of row @a y, returns the number of octaves.
+  static FOG_INLINE int initOctaves(FTurbulenceOctave* octaves, const RasterFilterTurbulence* ctx, int y)
+  {
+    int numOctaves = ctx->numOctaves;
+
+    RasterOps_C::FTurbulenceStitch stitch;
+    RasterOps_C::FTurbulence::initStitch(stitch, ctx);
+
+    float vy = float(y) * ctx->vFrequency;
+
+    for (int i = 0; i < numOctaves; i++)
+    {
+      FTurbulenceOctave& octave = octaves[i];
+
+      float t = vy + float(RASTER_TURBULENCE_PERLIN);
+      int by0 = (int)t;
+      int by1 = by0 + 1;
+      float ry0 = t - float(by0);
+
+      fillPS(octave.ry0, ry0);
+      fillPS(octave.ry1, ry0 - 1.0f);
+      fillPS(octave.sy, RasterOps_C::FTurbulence::sCurve(ry0));
+
+      // If stitching, adjust lattice points accordingly.
+      if (ctx->stitchTiles)
+      {
+        if (by0 >= stitch.wrapY) by0 -= stitch.height;
+        if (by1 >= stitch.wrapY) by1 -= stitch.height;
+
+        fillPI32(octave.wrapX, stitch.wrapX - 1);
+        fillPI32(octave.width, stitch.width);
+
+        RasterOps_C::FTurbulence::nextStitch(stitch);
+      }
+      else
+      {
+        Acc::m128iZero(octave.wrapX);
+        Acc::m128iZero(octave.width);
+      }
+
+      octave.by0 = by0 & RASTER_TURBULENCE_BMASK;
+      octave.by1 = by1 & RASTER_TURBULENCE_BMASK;
+
+      vy *= 2.0f;
+    }
+
+    return numOctaves;
+  }
+
+  // ==========================================================================
+  // [Turbulence - Noise]
+  // ==========================================================================
+
+  //! @brief Get noise of pixel @a K of four pixels, all channels at once.
+  //!
+  //! The lattice coordinates @a rx0, @a rx1 and @a sx contain all four pixels
+  //! (one pixel per lane), @a b0 and @a b1 are the masked lattice columns.
+  template<int K>
+  static FOG_INLINE void noisePixel(__m128f& dst,
+    const RasterFilterTurbulenceTables* tables, const int* b0, const int* b1,
+    const __m128f& rx0, const __m128f& rx1, const __m128f& sx,
+    const FTurbulenceOctave& octave)
+  {
+    int i = tables->lattice[b0[K]];
+    int j = tables->lattice[b1[K]];
+
+    const float* q00 = tables->gradient[tables->lattice[i + octave.by0]];
+    const float* q10 = tables->gradient[tables->lattice[j + octave.by0]];
+    const float* q01 = tables->gradient[tables->lattice[i + octave.by1]];
+    const float* q11 = tables->gradient[tables->lattice[j + octave.by1]];
+
+    __m128f xmmRx0, xmmRx1, xmmSx;
+
+    Acc::m128fShuffle<K, K, K, K>(xmmRx0, rx0);
+    Acc::m128fShuffle<K, K, K, K>(xmmRx1, rx1);
+    Acc::m128fShuffle<K, K, K, K>(xmmSx, sx);
+
+    __m128f u, v, t;
+    __m128f a, c;
+
+    // u = rx0 * q00.x + ry0 * q00.y.
+    // v = rx1 * q10.x + ry0 * q10.y.
+    Acc::m128fLoad16u(u, q00);
+    Acc::m128fLoad16u(t, q00 + 4);
+    Acc::m128fMulPS(u, u, xmmRx0);
+    Acc::m128fMulPS(t, t, octave.ry0);
+    Acc::m128fAddPS(u, u, t);
+
+    Acc::m128fLoad16u(v, q10);
+    Acc::m128fLoad16u(t, q10 + 4);
+    Acc::m128fMulPS(v, v, xmmRx1);
+    Acc::m128fMulPS(t, t, octave.ry0);
+    Acc::m128fAddPS(v, v, t);
+
+    // a = u + sx * (v - u).
+    Acc::m128fSubPS(v, v, u);
+    Acc::m128fMulPS(v, v, xmmSx);
+    Acc::m128fAddPS(a, u, v);
+
+    // u = rx0 * q01.x + ry1 * q01.y.
+    // v = rx1 * q11.x + ry1 * q11.y.
+    Acc::m128fLoad16u(u, q01);
+    Acc::m128fLoad16u(t, q01 + 4);
+    Acc::m128fMulPS(u, u, xmmRx0);
+    Acc::m128fMulPS(t, t, octave.ry1);
+    Acc::m128fAddPS(u, u, t);
+
+    Acc::m128fLoad16u(v, q11);
+    Acc::m128fLoad16u(t, q11 + 4);
+    Acc::m128fMulPS(v, v, xmmRx1);
+    Acc::m128fMulPS(t, t, octave.ry1);
+    Acc::m128fAddPS(v, v, t);
+
+    // c = u + sx * (v - u).
+    Acc::m128fSubPS(v, v, u);
+    Acc::m128fMulPS(v, v, xmmSx);
+    Acc::m128fAddPS(c, u, v);
+
+    // dst = a + sy * (c - a).
+    Acc::m128fSubPS(c, c, a);
+    Acc::m128fMulPS(c, c, octave.sy);
+    Acc::m128fAddPS(dst, a, c);
+  }
+
+  //! @brief Get noise of four pixels at @a vx (one pixel per lane) in octave
+  //! @a octave, @a dst[k] contains all channels of pixel @a k.
+  static FOG_INLINE void noise2(__m128f* dst,
+    const RasterFilterTurbulenceTables* tables, const __m128f& vx,
+    const FTurbulenceOctave& octave, bool stitchTiles)
+  {
+    __m128f t;
+    __m128i bx0, bx1;
+
+    Acc::m128fAddPS(t, vx, FOG_XMM_GET_CONST_PS(FTurbulence_Perlin));
+    Acc::m128iTruncPI32FromPS(bx0, t);
+    Acc::m128iAddPI32(bx1, bx0, FOG_XMM_GET_CONST_PI(0000000100000001_0000000100000001));
+
+    __m128f rx0, rx1, sx;
+
+    Acc::m128fCvtPSFromPI32(rx0, bx0);
+    Acc::m128fSubPS(rx0, t, rx0);
+    Acc::m128fSubPS(rx1, rx0, FOG_XMM_GET_CONST_PS(m128f_p1_p1_p1_p1));
+    sCurve(sx, rx0);
+
+    // If stitching, adjust lattice points accordingly.
+    if (stitchTiles)
+    {
+      __m128i m0, m1;
+
+      Acc::m128iCmpGtPI32(m0, bx0, octave.wrapX);
+      Acc::m128iCmpGtPI32(m1, bx1, octave.wrapX);
+      Acc::m128iAnd(m0, m0, octave.width);
+      Acc::m128iAnd(m1, m1, octave.width);
+      Acc::m128iSubPI32(bx0, bx0, m0);
+      Acc::m128iSubPI32(bx1, bx1, m1);
+    }
+
+    Acc::m128iAnd(bx0, bx0, FOG_XMM_GET_CONST_PI(000000FF000000FF_000000FF000000FF));
+    Acc::m128iAnd(bx1, bx1, FOG_XMM_GET_CONST_PI(000000FF000000FF_000000FF000000FF));
+
+    // Gather the lattice, one pixel per lane.
+    int b0[4];
+    int b1[4];
+
+    Acc::m128iStore16u(b0, bx0);
+    Acc::m128iStore16u(b1, bx1);
+
+    noisePixel<0>(dst[0], tables, b0, b1, rx0, rx1, sx, octave);
+    noisePixel<1>(dst[1], tables, b0, b1, rx0, rx1, sx, octave);
+    noisePixel<2>(dst[2], tables, b0, b1, rx0, rx1, sx, octave);
+    noisePixel<3>(dst[3], tables, b0, b1, rx0, rx1, sx, octave);
+  }
+
+  //! @brief Get turbulence of four pixels starting at @a x as PRGB32 pixels.
+  static FOG_INLINE void turbulence4(__m128i& dst, const RasterFilterTurbulence* ctx,
+    const FTurbulenceOctave* octaves, int numOctaves, int x)
+  {
+    __m128f vx;
+    __m128f hFrequency;
+    __m128f ratio;
+    __m128f sum[4];
+
+    fillPI32(dst, x);
+    Acc::m128iAddPI32(dst, dst, FOG_XMM_GET_CONST_PI(FTurbulence_3_2_1_0));
+    Acc::m128fCvtPSFromPI32(vx, dst);
+
+    fillPS(hFrequency, ctx->hFrequency);
+    Acc::m128fMulPS(vx, vx, hFrequency);
+
+    ratio = FOG_XMM_GET_CONST_PS(m128f_p1_p1_p1_p1);
+    Acc::m128fZero(sum[0]);
+    Acc::m128fZero(sum[1]);
+    Acc::m128fZero(sum[2]);
+    Acc::m128fZero(sum[3]);
+
+    int octave = 0;
+    for (;;)
+    {
+      __m128f noise[4];
+      noise2(noise, ctx->tables, vx, octaves[octave], ctx->stitchTiles != 0);
+
+      for (int k = 0; k < 4; k++)
+      {
+        Acc::m128fMulPS(noise[k], noise[k], ratio);
+        if (!ctx->fractalSum)
+          Acc::m128fAnd(noise[k], noise[k], FOG_XMM_GET_CONST_PS(m128f_nm_nm_nm_nm));
+        Acc::m128fAddPS(sum[k], sum[k], noise[k]);
+      }
+
+      if (++octave >= numOctaves)
+        break;
+
+      Acc::m128fAddPS(vx, vx, vx);
+      Acc::m128fMulPS(ratio, ratio, FOG_XMM_GET_CONST_PS(m128f_4x_0_5));
+    }
+
+    // Transpose, sum[n] contains channel n of all pixels (R, G, B, A).
+    transpose(sum);
+
+    __m128f zero;
+    Acc::m128fZero(zero);
+
+    for (int n = 0; n < 4; n++)
+    {
+      if (ctx->fractalSum)
+      {
+        Acc::m128fMulPS(sum[n], sum[n], FOG_XMM_GET_CONST_PS(m128f_4x_0_5));
+        Acc::m128fAddPS(sum[n], sum[n], FOG_XMM_GET_CONST_PS(m128f_4x_0_5));
+      }
+
+      Acc::m128fMaxPS(sum[n], sum[n], zero);
+      Acc::m128fMinPS(sum[n], sum[n], FOG_XMM_GET_CONST_PS(m128f_p1_p1_p1_p1));
+    }
+
+    // Premultiply.
+    __m128i r, g, b;
+
+    Acc::m128fMulPS(sum[3], sum[3], FOG_XMM_GET_CONST_PS(m128f_4x_255));
+    Acc::m128fMulPS(sum[0], sum[0], sum[3]);
+    Acc::m128fMulPS(sum[1], sum[1], sum[3]);
+    Acc::m128fMulPS(sum[2], sum[2], sum[3]);
+
+    Acc::m128iTruncPI32FromPS(dst, sum[3]);
+    Acc::m128iTruncPI32FromPS(r, sum[0]);
+    Acc::m128iTruncPI32FromPS(g, sum[1]);
+    Acc::m128iTruncPI32FromPS(b, sum[2]);
+
+    Acc::m128iLShiftPU32<24>(dst, dst);
+    Acc::m128iLShiftPU32<16>(r, r);
+    Acc::m128iLShiftPU32<8>(g, g);
+
+    Acc::m128iOr(dst, dst, r);
+    Acc::m128iOr(g, g, b);
+    Acc::m128iOr(dst, dst, g);
+  }
+
+  // ==========================================================================
+  // [Turbulence - DoRow]
+  // ==========================================================================
+
+  template<int IsXRGB>
+  static void FOG_FASTCALL doRow_32(
+    const RasterFilterTurbulence* ctx, uint8_t* dst, int x, int y, int w)
+  {
+    // No octaves, no noise (transparent black, even for fractal noise).
+    if (ctx->numOctaves <= 0)
+    {
+      uint32_t pix0 = IsXRGB ? 0xFF000000 : 0x00000000;
+      for (int i = 0; i < w; i++, dst += 4)
+        Acc::p32Store4a(dst, pix0);
+      return;
+    }
+
+    FTurbulenceOctave octaves[RASTER_TURBULENCE_MAX_OCTAVES];
+    int numOctaves = initOctaves(octaves, ctx, y);
+
+    int i = w;
+    __m128i pix0;
+
+    while (i >= 4)
+    {
+      turbulence4(pix0, ctx, octaves, numOctaves, x);
+      if (IsXRGB)
+        Acc::m128iOr(pix0, pix0, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore16u(dst, pix0);
+
+      dst += 16;
+      x += 4;
+      i -= 4;
+    }
+
+    if (i > 0)
+    {
+      uint32_t tail[4];
+
+      turbulence4(pix0, ctx, octaves, numOctaves, x);
+      if (IsXRGB)
+        Acc::m128iOr(pix0, pix0, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore16u(tail, pix0);
+
+      for (int k = 0; k < i; k++, dst += 4)
+        Acc::p32Store4a(dst, tail[k]);
+    }
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERTURBULENCE_P_H
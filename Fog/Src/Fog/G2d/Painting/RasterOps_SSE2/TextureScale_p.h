@@ -0,0 +1,340 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_TEXTURESCALE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_TEXTURESCALE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/TextureScale_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - PTextureScale]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Texture scale fetchers (SSE2), 32-bit sources and PAD tiling.
+//!
+//! @a Accessor is either @c RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32
+//! or @c RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32, the latter doesn't
+//! fetch by reference, so the alpha is filled. Edges are fetched by the
+//! accessor, the result is bit-exact with @c RasterOps_C::PTextureScale.
+struct FOG_NO_EXPORT PTextureScale
+{
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static FOG_INLINE void normalize(__m128i& pix)
+  {
+    if (!Accessor::FETCH_REFERENCE)
+      Acc::m128iOr(pix, pix, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+  }
+
+  // ==========================================================================
+  // [Fetch - Scale (Nearest) - Pad]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_nearest_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
+
+    Fixed32x32 tx = ctx->_d.texture.scale.tx;
+    Fixed32x32 xx = ctx->_d.texture.scale.xx;
+
+    const uint8_t* srcPixels = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
+
+    P_FETCH_SPAN8_INIT()
+
+    int py0 = Math::bound<int>((int)(fetcher->_d.texture.scale.py >> 32), 0, th - 1);
+    srcPixels += py0 * srcStride;
+
+    // ------------------------------------------------------------------------
+    // [Loop - Replicate]
+    // ------------------------------------------------------------------------
+
+    if (ctx->_d.texture.scale.replicateX)
+    {
+      int rx = ctx->_d.texture.scale.replicateX;
+      int rx0 = ctx->_d.texture.scale.replicateX0;
+
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(4)
+
+        int d = x - rx0;
+        int k = RasterOps_C::PTextureScale::floorDiv(d, rx);
+        int i = rx - (d - k * rx);
+
+        for (;;)
+        {
+          __m128i pix0;
+
+          if (i > w) i = w;
+          w -= i;
+
+          Acc::m128iLoad4(pix0, srcPixels + Math::bound<int>(k, 0, tw - 1) * 4);
+          Acc::m128iExpandPI32FromSI32(pix0, pix0);
+          normalize<Accessor>(pix0);
+
+          while (i >= 4)
+          {
+            Acc::m128iStore16u(dst, pix0);
+            dst += 16;
+            i -= 4;
+          }
+
+          while (i)
+          {
+            Acc::m128iStore4(dst, pix0);
+            dst += 4;
+            i--;
+          }
+
+          if (w == 0) break;
+
+          i = rx;
+          k++;
+        }
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+
+    // ------------------------------------------------------------------------
+    // [Loop - Pad]
+    // ------------------------------------------------------------------------
+
+    else
+    {
+      Fixed32x32 limit = (Fixed32x32)tw << 32;
+
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(4)
+
+        Fixed32x32 px = tx + (Fixed32x32)x * xx;
+        typename Accessor::Pixel pix;
+
+        // Before the texture.
+        int i = RasterOps_C::PTextureScale::countBelow(px, xx, 0, w);
+        if (i != 0)
+        {
+          accessor.fetchNorm(pix, srcPixels);
+
+          w -= i;
+          dst = accessor.fill(dst, pix, i);
+          px += (Fixed32x32)i * xx;
+        }
+
+        // Inside the texture.
+        i = RasterOps_C::PTextureScale::countBelow(px, xx, limit, w);
+        w -= i;
+
+        while (i >= 4)
+        {
+          __m128i pix0, pix1, pix2, pix3;
+
+          Acc::m128iLoad4(pix0, srcPixels + (uint)(px >> 32) * 4); px += xx;
+          Acc::m128iLoad4(pix1, srcPixels + (uint)(px >> 32) * 4); px += xx;
+          Acc::m128iLoad4(pix2, srcPixels + (uint)(px >> 32) * 4); px += xx;
+          Acc::m128iLoad4(pix3, srcPixels + (uint)(px >> 32) * 4); px += xx;
+
+          Acc::m128iUnpackPI64FromPI32Lo(pix0, pix0, pix1);
+          Acc::m128iUnpackPI64FromPI32Lo(pix2, pix2, pix3);
+          Acc::m128iUnpackSI128FromPI64Lo(pix0, pix0, pix2);
+
+          normalize<Accessor>(pix0);
+          Acc::m128iStore16u(dst, pix0);
+
+          dst += 16;
+          i -= 4;
+        }
+
+        while (i)
+        {
+          accessor.fetchNorm(pix, srcPixels + (uint)(px >> 32) * 4);
+          accessor.store(dst, pix);
+
+          dst += 4;
+          px += xx;
+          i--;
+        }
+
+        // After the texture.
+        if (w != 0)
+        {
+          accessor.fetchNorm(pix, srcPixels + (tw - 1) * 4);
+          dst = accessor.fill(dst, pix, w);
+        }
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    RasterOps_C::PTextureScale::advance<TEXTURE_TILE_PAD>(fetcher);
+  }
+
+  // ==========================================================================
+  // [Fetch - Scale (Bilinear) - Pad]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_scale_bilinear_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
+
+    Fixed32x32 tx = ctx->_d.texture.scale.tx;
+    Fixed32x32 xx = ctx->_d.texture.scale.xx;
+
+    const uint8_t* srcPixels = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
+
+    P_FETCH_SPAN8_INIT()
+
+    Fixed32x32 py = fetcher->_d.texture.scale.py;
+
+    int py0 = (int)(py >> 32);
+    int py1 = py0 + 1;
+
+    uint32_t wy = (uint32_t)(py >> 24) & 0xFF;
+    uint32_t inv_wy = 0x100 - wy;
+
+    if (py0 < 0)
+      py0 = py1 = 0;
+    else if (py0 >= th - 1)
+      py0 = py1 = th - 1;
+
+    const uint8_t* srcLine0 = srcPixels + py0 * srcStride;
+    const uint8_t* srcLine1 = srcPixels + py1 * srcStride;
+
+    Fixed32x32 limit = (Fixed32x32)(tw - 1) << 32;
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(4)
+
+      Fixed32x32 px = tx + (Fixed32x32)x * xx;
+
+      typename Accessor::Pixel pix_y0;
+      typename Accessor::Pixel pix_y1;
+
+      // Before the texture, only the first column is interpolated.
+      int i = RasterOps_C::PTextureScale::countBelow(px, xx, 0, w);
+      if (i != 0)
+      {
+        accessor.fetchRaw(pix_y0, srcLine0);
+        accessor.fetchRaw(pix_y1, srcLine1);
+        accessor.interpolateRaw_2(pix_y0, pix_y0, inv_wy, pix_y1, wy);
+        accessor.normalize(pix_y0, pix_y0);
+
+        w -= i;
+        dst = accessor.fill(dst, pix_y0, i);
+        px += (Fixed32x32)i * xx;
+      }
+
+      // Inside the texture, both columns are valid. The pair of neighbors
+      // [x0, x1] is loaded by a single 64-bit load and unpacked to 16-bit.
+      i = RasterOps_C::PTextureScale::countBelow(px, xx, limit, w);
+      w -= i;
+
+      while (i)
+      {
+        uint px0 = (uint)(px >> 32) * 4;
+        uint32_t wx = (uint32_t)(px >> 24) & 0xFF;
+        uint32_t inv_wx = 0x100 - wx;
+
+        __m128i pix0, pix1;
+        __m128i wgt0, wgt1;
+
+        Acc::m128iLoad8(pix0, srcLine0 + px0);
+        Acc::m128iLoad8(pix1, srcLine1 + px0);
+
+        Acc::m128iCvtSI128FromSI(wgt0, (int)((((wx * inv_wy) >> 8) << 16) | ((inv_wx * inv_wy) >> 8)));
+        Acc::m128iCvtSI128FromSI(wgt1, (int)((((wx * wy    ) >> 8) << 16) | ((inv_wx * wy    ) >> 8)));
+
+        Acc::m128iUnpackPI16FromPI8Lo(pix0, pix0);
+        Acc::m128iUnpackPI16FromPI8Lo(pix1, pix1);
+
+        Acc::m128iUnpackPI32FromPI16Lo(wgt0, wgt0, wgt0);
+        Acc::m128iUnpackPI32FromPI16Lo(wgt1, wgt1, wgt1);
+        Acc::m128iUnpackPI64FromPI32Lo(wgt0, wgt0, wgt0);
+        Acc::m128iUnpackPI64FromPI32Lo(wgt1, wgt1, wgt1);
+
+        Acc::m128iMulLoPI16(pix0, pix0, wgt0);
+        Acc::m128iMulLoPI16(pix1, pix1, wgt1);
+        Acc::m128iAddPI16(pix0, pix0, pix1);
+
+        Acc::m128iShufflePI32<3, 2, 3, 2>(pix1, pix0);
+        Acc::m128iAddPI16(pix0, pix0, pix1);
+        Acc::m128iRShiftPU16<8>(pix0, pix0);
+        Acc::m128iPackPU8FromPU16(pix0, pix0, pix0);
+
+        normalize<Accessor>(pix0);
+        Acc::m128iStore4(dst, pix0);
+
+        dst += 4;
+        px += xx;
+        i--;
+      }
+
+      // After the texture, only the last column is interpolated.
+      if (w != 0)
+      {
+        accessor.fetchRaw(pix_y0, srcLine0 + (tw - 1) * 4);
+        accessor.fetchRaw(pix_y1, srcLine1 + (tw - 1) * 4);
+        accessor.interpolateRaw_2(pix_y0, pix_y0, inv_wy, pix_y1, wy);
+        accessor.normalize(pix_y0, pix_y0);
+
+        dst = accessor.fill(dst, pix_y0, w);
+      }
+
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    RasterOps_C::PTextureScale::advance<TEXTURE_TILE_PAD>(fetcher);
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_TEXTURESCALE_P_H
@@ -0,0 +1,117 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSSE3_BASECONVERT_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSSE3_BASECONVERT_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Acc/AccSsse3.h>
+
+// [Dependencies - RasterOps_SSE2]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseConvert_p.h>
+
+namespace Fog {
+namespace RasterOps_SSSE3 {
+
+// ============================================================================
+// [Fog::RasterOps_SSSE3 - Convert]
+// ============================================================================
+
+struct FOG_NO_EXPORT Convert
+{
+  // ==========================================================================
+  // [Shuffle - Helpers]
+  // ==========================================================================
+
+  template<uint32_t DstBpp, uint32_t SrcBpp>
+  static FOG_INLINE void shuffle_pshufb(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    const ImageConverterData* d = reinterpret_cast<const ImageConverterData*>(closure->data);
+    const RasterConvertShuffle* shuffle = reinterpret_cast<const RasterConvertShuffle*>(d->buffer);
+
+    // Four pixels are converted at a time, but 16 bytes are always fetched. In
+    // case that the source is 24-bit there must be at least 16 bytes available.
+    const int minWidth = (SrcBpp == 3) ? 6 : 4;
+
+    if (w >= minWidth)
+    {
+      __m128i xmmMask;
+      __m128i xmmFill;
+
+      Acc::m128iLoad16u(xmmMask, shuffle->mask);
+      Acc::m128iLoad16u(xmmFill, shuffle->fill);
+
+      do {
+        __m128i xmm0;
+
+        Acc::m128iLoad16u(xmm0, src);
+        Acc::m128iShufflePI8(xmm0, xmm0, xmmMask);
+        Acc::m128iOr(xmm0, xmm0, xmmFill);
+
+        if (DstBpp == 4)
+        {
+          Acc::m128iStore16u(dst, xmm0);
+        }
+        else
+        {
+          Acc::m128iStore8(dst, xmm0);
+          Acc::m128iRShiftSU128<64>(xmm0, xmm0);
+          Acc::m128iStore4(dst + 8, xmm0);
+        }
+
+        dst += DstBpp * 4;
+        src += SrcBpp * 4;
+        w -= 4;
+      } while (w >= minWidth);
+
+      if (w == 0)
+        return;
+    }
+
+    do {
+      RasterOps_C::Convert::shufflePixel(dst, src, DstBpp, shuffle);
+
+      dst += DstBpp;
+      src += SrcBpp;
+    } while (--w);
+  }
+
+  // ==========================================================================
+  // [Shuffle]
+  // ==========================================================================
+
+  static void FOG_FASTCALL shuffle_24_from_24(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_pshufb<3, 3>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL shuffle_24_from_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_pshufb<3, 4>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL shuffle_32_from_24(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_pshufb<4, 3>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL shuffle_32_from_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    shuffle_pshufb<4, 4>(dst, src, w, closure);
+  }
+};
+
+} // RasterOps_SSSE3 namespace
+} // Fog namespace
+
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSSE3_BASECONVERT_P_H
@@ -31,6 +31,7 @@
 #include <Fog/G2d/Painting/Painter.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterMaskCache_p.h>
 #include <Fog/G2d/Painting/RasterPaintCmd_p.h>
 #include <Fog/G2d/Painting/RasterPaintContext_p.h>
 #include <Fog/G2d/Painting/RasterPaintEngine_p.h>
@@ -627,6 +628,20 @@ static err_t FOG_CDECL RasterPaintEngine_getParameter(const Painter* self, uint3
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Statistics]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STATISTICS:
+    {
+#if defined(FOG_BUILD_PAINT_STATISTICS)
+      _PARAM_M(PaintStatistics) = engine->statistics;
+      return ERR_OK;
+#else
+      return ERR_RT_NOT_IMPLEMENTED;
+#endif // FOG_BUILD_PAINT_STATISTICS
+    }
+
     default:
     {
       return ERR_RT_INVALID_ARGUMENT;
@@ -1475,6 +1490,16 @@ _GlobalOpacityF:
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Statistics]
+    // ------------------------------------------------------------------------
+
+    // Statistics are collected by the engine, they can be only reset.
+    case PAINTER_PARAMETER_STATISTICS:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+
     default:
     {
       return ERR_RT_INVALID_ARGUMENT;
@@ -1812,6 +1837,20 @@ static err_t FOG_CDECL RasterPaintEngine_resetParameter(Painter* self, uint32_t
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Statistics]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STATISTICS:
+    {
+#if defined(FOG_BUILD_PAINT_STATISTICS)
+      engine->statistics.reset();
+      return ERR_OK;
+#else
+      return ERR_RT_NOT_IMPLEMENTED;
+#endif // FOG_BUILD_PAINT_STATISTICS
+    }
+
     default:
     {
       return ERR_RT_INVALID_ARGUMENT;
@@ -2604,7 +2643,11 @@ static err_t FOG_FASTCALL RasterPaintEngine_drawRawPathF(
   PathF& tmp = engine->ctx.tmpPathF[0];
 
   tmp.clear();
-  FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
+
+  {
+    _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_STROKE);
+    FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
+  }
 
   return engine->doCmd->fillNormalizedPathF(engine, &tmp, &engine->dummyPointF, FILL_RULE_NON_ZERO);
 }
@@ -2623,7 +2666,11 @@ static err_t FOG_FASTCALL RasterPaintEngine_drawRawPathD(
   PathD& tmp = engine->ctx.tmpPathD[0];
 
   tmp.clear();
-  FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
+
+  {
+    _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_STROKE);
+    FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
+  }
 
   return engine->doCmd->fillNormalizedPathD(engine, &tmp, &engine->dummyPointD, FILL_RULE_NON_ZERO);
 }
@@ -3028,6 +3075,14 @@ static err_t FOG_CDECL RasterPaintEngine_fillShapeF(Painter* self, uint32_t shap
     case SHAPE_TYPE_PATH:
     {
       const PathF* path = reinterpret_cast<const PathF*>(shapeData);
+
+      if (engine->doCmd->fillCachedPathF != NULL)
+      {
+        err_t err = engine->doCmd->fillCachedPathF(engine, path, engine->ctx.paintHints.fillRule);
+        if (err != ERR_RT_OBJECT_NOT_FOUND)
+          return err;
+      }
+
       return RasterPaintEngine_fillRawPathF(engine, path, engine->ctx.paintHints.fillRule);
     }
 
@@ -3066,6 +3121,14 @@ static err_t FOG_CDECL RasterPaintEngine_fillShapeD(Painter* self, uint32_t shap
     case SHAPE_TYPE_PATH:
     {
       const PathD* path = reinterpret_cast<const PathD*>(shapeData);
+
+      if (engine->doCmd->fillCachedPathD != NULL)
+      {
+        err_t err = engine->doCmd->fillCachedPathD(engine, path, engine->ctx.paintHints.fillRule);
+        if (err != ERR_RT_OBJECT_NOT_FOUND)
+          return err;
+      }
+
       return RasterPaintEngine_fillRawPathD(engine, path, engine->ctx.paintHints.fillRule);
     }
 
@@ -4885,6 +4948,154 @@ static err_t FOG_CDECL RasterPaintEngine_resetClip(Painter* self)
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::RasterPaintEngine - Group - Layer Pool]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Global pool of group layers (PRGB32 images).
+//!
+//! Layers are recycled across groups and painters. A layer is reused only if
+//! the pool holds its only reference, because the layer of a nested group can
+//! still be referenced by a command recorded by the parent group.
+struct FOG_NO_EXPORT RasterPaintLayerPool
+{
+  Lock lock;
+  Image layers[RASTER_GROUP_LAYER_POOL_SIZE];
+};
+
+static Static<RasterPaintLayerPool> RasterPaintLayerPool_global;
+
+static err_t RasterPaintLayerPool_acquire(Image& dst, const SizeI& size)
+{
+  RasterPaintLayerPool* pool = &RasterPaintLayerPool_global;
+  AutoLock locked(pool->lock);
+
+  Image* best = NULL;
+  Image* slot = NULL;
+
+  for (uint i = 0; i < RASTER_GROUP_LAYER_POOL_SIZE; i++)
+  {
+    Image& layer = pool->layers[i];
+
+    if (layer.isEmpty())
+    {
+      if (slot == NULL || !slot->isEmpty())
+        slot = &layer;
+      continue;
+    }
+
+    ImageData* d = layer._d;
+    if (d->reference.get() != 1)
+      continue;
+
+    if (d->size.w >= size.w && d->size.h >= size.h)
+    {
+      if (best == NULL || (uint64_t)d->size.w * d->size.h < (uint64_t)best->_d->size.w * best->_d->size.h)
+        best = &layer;
+    }
+    else if (slot == NULL)
+    {
+      slot = &layer;
+    }
+  }
+
+  if (best == NULL)
+  {
+    // Round the size to tiles to make the layer reusable by similar groups.
+    SizeI layerSize((size.w + RASTER_GROUP_TILE_SIZE - 1) & ~(RASTER_GROUP_TILE_SIZE - 1),
+                    (size.h + RASTER_GROUP_TILE_SIZE - 1) & ~(RASTER_GROUP_TILE_SIZE - 1));
+
+    FOG_RETURN_ON_ERROR(dst.create(layerSize, IMAGE_FORMAT_PRGB32));
+
+    // If all layers are in use the new one is not pooled.
+    if (slot != NULL)
+      *slot = dst;
+  }
+  else
+  {
+    dst = *best;
+  }
+
+  // The layer contains garbage outside of used tiles, so its alpha can't be
+  // analyzed, VARIANT is always valid for SRC_OVER compositing.
+  dst._d->alphaDistribution = ALPHA_DISTRIBUTION_VARIANT;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Group - Tile Runs]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Iterator over horizontal runs of tiles used by a group.
+//!
+//! If the group has no tile-map, the whole @a box is returned as a single run.
+struct FOG_NO_EXPORT RasterPaintTileRunIterator
+{
+  FOG_INLINE RasterPaintTileRunIterator(const RasterPaintGroup* g, const BoxI& box) :
+    _g(g),
+    _box(box),
+    _tx0(box.x0 >> RASTER_GROUP_TILE_SHIFT),
+    _tx1(((box.x1 - 1) >> RASTER_GROUP_TILE_SHIFT) + 1),
+    _ty1(((box.y1 - 1) >> RASTER_GROUP_TILE_SHIFT) + 1),
+    _tx(_tx0),
+    _ty(box.y0 >> RASTER_GROUP_TILE_SHIFT)
+  {
+  }
+
+  FOG_INLINE bool next(BoxI& run)
+  {
+    if (_g->tileMap == NULL)
+    {
+      if (_ty >= _ty1)
+        return false;
+
+      _ty = _ty1;
+      run = _box;
+      return true;
+    }
+
+    while (_ty < _ty1)
+    {
+      const uint8_t* row = _g->tileMap + _ty * _g->tileStride;
+
+      while (_tx < _tx1 && row[_tx] == 0)
+        _tx++;
+
+      if (_tx < _tx1)
+      {
+        int start = _tx;
+        while (_tx < _tx1 && row[_tx] != 0)
+          _tx++;
+
+        run.setBox(Math::max<int>(start << RASTER_GROUP_TILE_SHIFT, _box.x0),
+                   Math::max<int>(_ty << RASTER_GROUP_TILE_SHIFT, _box.y0),
+                   Math::min<int>(_tx << RASTER_GROUP_TILE_SHIFT, _box.x1),
+                   Math::min<int>((_ty + 1) << RASTER_GROUP_TILE_SHIFT, _box.y1));
+        return true;
+      }
+
+      _tx = _tx0;
+      _ty++;
+    }
+
+    return false;
+  }
+
+  const RasterPaintGroup* _g;
+  BoxI _box;
+
+  int _tx0;
+  int _tx1;
+  int _ty1;
+
+  int _tx;
+  int _ty;
+};
+
 // ============================================================================
 // [Fog::RasterPaintEngine - Group]
 // ============================================================================
@@ -5168,6 +5379,29 @@ static err_t FOG_CDECL RasterPaintEngine_beginGroup(Painter* self, uint32_t flag
   // Prepare.
   g->reset();
   g->top = engine->curGroup;
+  g->targetSize = engine->ctx.target.size;
+
+  // Tile-map, a command marks all tiles it touches, only these are cleared
+  // and composited by paintGroup().
+  int tileStride = (g->targetSize.w + RASTER_GROUP_TILE_SIZE - 1) >> RASTER_GROUP_TILE_SHIFT;
+  int tileRows = (g->targetSize.h + RASTER_GROUP_TILE_SIZE - 1) >> RASTER_GROUP_TILE_SHIFT;
+  size_t tileMapSize = (size_t)(uint)tileStride * (uint)tileRows;
+
+  if (tileMapSize != 0 && tileMapSize <= RASTER_GROUP_TILE_MAP_MAX)
+  {
+    g->tileMap = static_cast<uint8_t*>(engine->groupAllocator.alloc(tileMapSize));
+
+    if (FOG_IS_NULL(g->tileMap))
+    {
+      engine->cmdAllocator.revert(cRecord);
+      engine->groupAllocator.revert(gRecord);
+
+      return ERR_RT_OUT_OF_MEMORY;
+    }
+
+    MemOps::zero(g->tileMap, tileMapSize);
+    g->tileStride = tileStride;
+  }
 
   g->groupRecord = gRecord;
   g->cmdRecord = cRecord;
@@ -5211,45 +5445,60 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
   if (engine->state != g->savedState)
     engine->discardStates(g->savedState);
   
-  Static<Image> image;
+  Static<Image> layer;
   BoxI targetBBox = g->boundingBox;
+  BoxI layerBox;
 
-  image->_d = NULL;
+  layer->_d = NULL;
   engine->curGroup = g->top;
 
   if (targetBBox.isValid())
   {
     RasterPaintTarget savedTarget = engine->ctx.target;
-    SizeI targetSize(targetBBox.getWidth(), targetBBox.getHeight());
 
-    image.init();
-    if (image->create(targetSize, IMAGE_FORMAT_PRGB32) != ERR_OK)
+    // The layer is aligned to tiles and covers the group bounding box.
+    layerBox.setBox(
+      targetBBox.x0 & ~(RASTER_GROUP_TILE_SIZE - 1),
+      targetBBox.y0 & ~(RASTER_GROUP_TILE_SIZE - 1),
+      Math::min<int>((targetBBox.x1 + RASTER_GROUP_TILE_SIZE - 1) & ~(RASTER_GROUP_TILE_SIZE - 1), g->targetSize.w),
+      Math::min<int>((targetBBox.y1 + RASTER_GROUP_TILE_SIZE - 1) & ~(RASTER_GROUP_TILE_SIZE - 1), g->targetSize.h));
+
+    layer.init();
+    if (RasterPaintLayerPool_acquire(layer, SizeI(layerBox.getWidth(), layerBox.getHeight())) != ERR_OK)
+    {
+      layer.destroy();
+      layer->_d = NULL;
       goto _DiscardCommands;
+    }
 
     // We don't change target size.
-    engine->ctx.target.stride = image->getStride();
-    engine->ctx.target.pixels = image->getFirstX();
+    engine->ctx.target.stride = layer->_d->stride;
+    engine->ctx.target.pixels = layer->_d->first;
     engine->ctx.target.format = IMAGE_FORMAT_PRGB32;
     engine->ctx.target.setup();
 
     // Offset target buffer.
-    engine->ctx.target.pixels -= targetBBox.x0 * engine->ctx.target.bpp;
-    engine->ctx.target.pixels -= targetBBox.y0 * engine->ctx.target.stride;
+    engine->ctx.target.pixels -= layerBox.x0 * engine->ctx.target.bpp;
+    engine->ctx.target.pixels -= layerBox.y0 * engine->ctx.target.stride;
 
     engine->doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
 
-    // Clear the temporary image.
-    uint32_t oldPaintHints = engine->ctx.paintHints.packed;
-    uint32_t oldPrgb32 = engine->ctx.solid.prgb32.u32;
+    // Clear the used tiles, the pooled layer contains the previous content and
+    // the other tiles are never composited.
+    {
+      RasterPaintTileRunIterator it(g, targetBBox);
+      BoxI run;
 
-    engine->ctx.paintHints.compositingOperator = COMPOSITE_SRC;
-    engine->ctx.solid.prgb32.u32 = 0x00000000;
-    engine->ctx.pc = (RasterPattern*)(size_t)0x1;
+      while (it.next(run))
+      {
+        uint8_t* p = engine->ctx.target.pixels + run.y0 * engine->ctx.target.stride + run.x0 * 4;
+        size_t size = (size_t)(uint)run.getWidth() * 4;
 
-    engine->doCmd->fillNormalizedBoxI(engine, &targetBBox);
+        for (int y = run.y0; y < run.y1; y++, p += engine->ctx.target.stride)
+          MemOps::zero(p, size);
+      }
+    }
 
-    engine->ctx.paintHints.packed = oldPaintHints;
-    engine->ctx.solid.prgb32.u32 = oldPrgb32;
     engine->ctx.pc = NULL;
 
     // Reset core states which are always set to default values when new group
@@ -5286,19 +5535,30 @@ _DiscardCommands:
   engine->state->lockedByGroup = false;
   engine->vtable->restore(self);
 
-  // Revert group and command allocators.
+  // Revert command allocator, the parent group records the composition.
   engine->cmdAllocator.revert(g->cmdRecord);
-  engine->groupAllocator.revert(g->groupRecord);
 
-  // Destroy image buffer, if created.
-  if (image->_d != NULL)
+  // Composite the used tiles and release the layer back to the pool.
+  if (layer->_d != NULL)
   {
-    PointI dPos(targetBBox.x0, targetBBox.y0);
-    RectI sRect(0, 0, image->getWidth(), image->getHeight());
-    engine->doCmd->blitNormalizedImageA(engine, &dPos, &image, &sRect);
-    image.destroy();
+    RasterPaintTileRunIterator it(g, targetBBox);
+    BoxI run;
+
+    while (it.next(run))
+    {
+      if (!BoxI::intersect(run, run, engine->ctx.clipBoxI))
+        continue;
+
+      PointI dPos(run.x0, run.y0);
+      RectI sRect(run.x0 - layerBox.x0, run.y0 - layerBox.y0, run.getWidth(), run.getHeight());
+      engine->doCmd->blitNormalizedImageA(engine, &dPos, &layer, &sRect);
+    }
+
+    layer.destroy();
   }
 
+  // Revert group allocator (the tile-map is not used anymore).
+  engine->groupAllocator.revert(g->groupRecord);
   return ERR_OK;
 }
 
@@ -5337,11 +5597,14 @@ RasterPaintEngine::RasterPaintEngine() :
   state(NULL),
   pcAllocator(16300),
   pcPool(NULL),
-  groupAllocator(500),
+  groupAllocator(16300),
   curGroup(&topGroup),
   cmdAllocator(16300),
   maxThreads(0),
   finalizing(0)
+#if defined(FOG_BUILD_PAINT_STATISTICS)
+  , statisticsNested(0)
+#endif // FOG_BUILD_PAINT_STATISTICS
 {
   // Setup the essentials.
   vtable = NULL;
@@ -5372,7 +5635,11 @@ RasterPaintEngine::RasterPaintEngine() :
 RasterPaintEngine::~RasterPaintEngine()
 {
   if (ctx.target.imageData)
+  {
+    // The cached alpha distribution is not valid after painting.
+    ctx.target.imageData->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
     ctx.target.imageData->locked--;
+  }
 
   discardStates(NULL);
   // TODO: Discard also groups.
@@ -5391,7 +5658,11 @@ err_t RasterPaintEngine::init(const ImageBits& imageBits, ImageData* imaged, uin
   ctx.target.format = imageBits.getFormat();
 
   ctx.target.imageData = imaged;
-  if (imaged) imaged->locked++;
+  if (imaged)
+  {
+    imaged->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
+    imaged->locked++;
+  }
 
   vtable = &RasterPaintEngine_vtable[ctx.target.precision];
   doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
@@ -6515,6 +6786,9 @@ FOG_NO_EXPORT void RasterPaintEngine_init(void)
   RasterPaintDoRender_init();
   RasterPaintDoGroup_init();
 
+  RasterPaintLayerPool_global.init();
+  RasterMaskCache_global.init();
+
   // --------------------------------------------------------------------------
   // [RasterPaintEngine - CPU Based Optimizations]
   // --------------------------------------------------------------------------
@@ -6522,4 +6796,10 @@ FOG_NO_EXPORT void RasterPaintEngine_init(void)
   FOG_CPU_USE_INITIALIZER_SSE2( RasterPaintEngine_init_SSE2() )
 }
 
+FOG_NO_EXPORT void RasterPaintEngine_fini(void)
+{
+  RasterMaskCache_global.destroy();
+  RasterPaintLayerPool_global.destroy();
+}
+
 } // Fog namespace
@@ -261,11 +261,12 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathF(
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F,
     *path, *pt, engine->ctx.paintHints.fillRule);
 
+  // The path is translated by 'pt' when rendered.
   engine->curGroup->mergeBoundingBox(
-    Math::ifloor(boundingBox.x0),
-    Math::ifloor(boundingBox.y0),
-    Math::iceil(boundingBox.x1),
-    Math::iceil(boundingBox.y1));
+    Math::ifloor(boundingBox.x0 + pt->x),
+    Math::ifloor(boundingBox.y0 + pt->y),
+    Math::iceil(boundingBox.x1 + pt->x),
+    Math::iceil(boundingBox.y1 + pt->y));
   return ERR_OK;
 }
 
@@ -283,11 +284,12 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathD(
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D,
     *path, *pt, engine->ctx.paintHints.fillRule);
 
+  // The path is translated by 'pt' when rendered.
   engine->curGroup->mergeBoundingBox(
-    Math::ifloor(boundingBox.x0),
-    Math::ifloor(boundingBox.y0),
-    Math::iceil(boundingBox.x1),
-    Math::iceil(boundingBox.y1));
+    Math::ifloor(boundingBox.x0 + pt->x),
+    Math::ifloor(boundingBox.y0 + pt->y),
+    Math::iceil(boundingBox.x1 + pt->x),
+    Math::iceil(boundingBox.y1 + pt->y));
   return ERR_OK;
 }
 
@@ -524,6 +526,8 @@ void FOG_NO_EXPORT RasterPaintDoGroup_init(void)
   v->fillNormalizedBoxD = RasterPaintDoGroup_fillNormalizedBoxD;
   v->fillNormalizedPathF = RasterPaintDoGroup_fillNormalizedPathF;
   v->fillNormalizedPathD = RasterPaintDoGroup_fillNormalizedPathD;
+  v->fillCachedPathF = NULL;
+  v->fillCachedPathD = NULL;
 
   // --------------------------------------------------------------------------
   // [Blit]
@@ -25,6 +25,7 @@
 #include <Fog/G2d/Painting/Painter.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterMaskCache_p.h>
 #include <Fog/G2d/Painting/RasterPaintContext_p.h>
 #include <Fog/G2d/Painting/RasterPaintEngine_p.h>
 #include <Fog/G2d/Painting/RasterPaintStructs_p.h>
@@ -68,6 +69,7 @@ struct FOG_NO_EXPORT RasterPaintFiller : public RasterFiller
     RasterPattern* pc;
     MemBuffer* pb;
     RasterPatternFetcher pf;
+    RasterFusedSpanFunc fused;
   };
   
   struct _FBlit
@@ -113,6 +115,8 @@ static void FOG_FASTCALL RasterPaintFiller_process_solid(RasterPaintFiller* self
   RasterUtil::validateSpans<RasterSpan8>(spans, self->ctx->clipBoxI.x0, self->ctx->clipBoxI.x1);
 #endif // FOG_DEBUG
 
+  _FOG_RASTER_STATISTICS_SPANS(self->ctx->engine, spans);
+
   self->c.blit(self->dstPixels, self->c.solid, spans, self->c.closure);
   self->dstPixels += self->dstStride;
 }
@@ -126,10 +130,23 @@ static void FOG_FASTCALL RasterPaintFiller_skip_solid(RasterPaintFiller* self, i
 // [Fog::RasterPaintDoRender - Filler - Pattern]
 // ============================================================================
 
+static void FOG_FASTCALL RasterPaintFiller_process_pattern_fused(RasterPaintFiller* self, RasterSpan8* spans);
+
+static FOG_INLINE void RasterPaintFiller_prepare_fused(RasterPaintFiller* self)
+{
+  // The fetcher is known after the pattern was prepared. The rasterizer reads
+  // the process function after calling prepare, so it can be replaced here.
+  self->v.fused = _api_raster.fused.get(self->v.pf._fetch, self->v.blit);
+  if (self->v.fused != NULL)
+    self->_process = (RasterFiller::ProcessFunc)RasterPaintFiller_process_pattern_fused;
+}
+
 static void FOG_FASTCALL RasterPaintFiller_prepare_pattern_st(RasterPaintFiller* self, int y)
 {
   self->v.pc->prepare(&self->v.pf, y, 1, RASTER_FETCH_REFERENCE);
   self->dstPixels += self->dstStride * y;
+
+  RasterPaintFiller_prepare_fused(self);
 }
 
 static void FOG_FASTCALL RasterPaintFiller_prepare_pattern_mt(RasterPaintFiller* self, int y)
@@ -139,6 +156,8 @@ static void FOG_FASTCALL RasterPaintFiller_prepare_pattern_mt(RasterPaintFiller*
   self->v.pc->prepare(&self->v.pf, y, delta, RASTER_FETCH_REFERENCE);
   self->dstPixels += self->dstStride * y;
   self->dstStride *= delta;
+
+  RasterPaintFiller_prepare_fused(self);
 }
 
 static void FOG_FASTCALL RasterPaintFiller_process_pattern(RasterPaintFiller* self, RasterSpan8* spans)
@@ -147,11 +166,26 @@ static void FOG_FASTCALL RasterPaintFiller_process_pattern(RasterPaintFiller* se
   RasterUtil::validateSpans<RasterSpan8>(spans, self->ctx->clipBoxI.x0, self->ctx->clipBoxI.x1);
 #endif // FOG_DEBUG
 
+  _FOG_RASTER_STATISTICS_SPANS(self->ctx->engine, spans);
+
   self->v.pf.fetch(spans, reinterpret_cast<uint8_t*>(self->v.pb->getMem()));
   self->v.blit(self->dstPixels, spans, self->v.closure);
   self->dstPixels += self->dstStride;
 }
 
+static void FOG_FASTCALL RasterPaintFiller_process_pattern_fused(RasterPaintFiller* self, RasterSpan8* spans)
+{
+#if defined(FOG_DEBUG)
+  RasterUtil::validateSpans<RasterSpan8>(spans, self->ctx->clipBoxI.x0, self->ctx->clipBoxI.x1);
+#endif // FOG_DEBUG
+
+  _FOG_RASTER_STATISTICS_SPANS(self->ctx->engine, spans);
+
+  self->v.fused(self->dstPixels, spans, &self->v.pf,
+    reinterpret_cast<uint8_t*>(self->v.pb->getMem()), self->v.closure);
+  self->dstPixels += self->dstStride;
+}
+
 static void FOG_FASTCALL RasterPaintFiller_skip_pattern(RasterPaintFiller* self, int step)
 {
   self->dstPixels += self->dstStride * step;
@@ -187,6 +221,8 @@ static void FOG_FASTCALL RasterPaintFiller_process_filter(RasterPaintFiller* sel
   RasterUtil::validateSpans<RasterSpan8>(spans, self->ctx->clipBoxI.x0, self->ctx->clipBoxI.x1);
 #endif // FOG_DEBUG
 
+  _FOG_RASTER_STATISTICS_SPANS(self->ctx->engine, spans);
+
   RasterSpan8* s = spans;
   FOG_ASSERT(s != NULL);
 
@@ -301,6 +337,8 @@ _Solid:
 static err_t FOG_FASTCALL RasterPaintDoRender_fillAll(
   RasterPaintEngine* engine)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_FILL_ALL);
+
   return engine->doCmd->fillNormalizedBoxI(engine, &engine->ctx.clipBoxI);
 }
 
@@ -311,6 +349,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillAll(
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxI(
   RasterPaintEngine* engine, const BoxI* box)
 {
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_BOX_I);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
   FOG_ASSERT(box->isValid());
 
   switch (engine->ctx.precision)
@@ -329,6 +370,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxI(
 
         int w = box->x1 - box->x0;
         int i = box->y1 - box->y0;
+        _FOG_RASTER_STATISTICS_BOX(engine, w, i);
 
         dstPixels += y0 * dstStride;
 
@@ -417,6 +459,9 @@ _Solid:
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxF(
   RasterPaintEngine* engine, const BoxF* box)
 {
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_BOX_F);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -457,6 +502,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxF(
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxD(
   RasterPaintEngine* engine, const BoxD* box)
 {
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_BOX_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -501,6 +549,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxD(
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathF(
   RasterPaintEngine* engine, const PathF* path, const PointF* pt, uint32_t fillRule)
 {
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_PATH_F);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -514,6 +565,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathF(
 
       rasterizer->addPath(*path, *pt);
       rasterizer->finalize();
+      _FOG_RASTER_STATISTICS_CELLS(engine, rasterizer);
 
       if (rasterizer->isValid())
         return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
@@ -538,6 +590,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathF(
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
   RasterPaintEngine* engine, const PathD* path, const PointD* pt, uint32_t fillRule)
 {
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_PATH_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -551,6 +606,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
 
       rasterizer->addPath(*path, *pt);
       rasterizer->finalize();
+      _FOG_RASTER_STATISTICS_CELLS(engine, rasterizer);
 
       if (rasterizer->isValid())
         return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
@@ -572,6 +628,225 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
   return ERR_RT_INVALID_STATE;
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoRender - FillCachedPath]
+// ============================================================================
+
+// Initialize the key of the coverage-mask cache, the transform used to record
+// the mask (linear part of the final transform translated by the subpixel
+// phase) and the integral offset where the mask is rendered. Returns false if
+// the path can't be cached.
+static bool RasterPaintDoRender_initMaskCacheKey(RasterPaintEngine* engine,
+  RasterMaskCacheKey& key, TransformD& tr, PointI& offset, uint32_t fillRule)
+{
+  if (engine->ctx.clipType != RASTER_CLIP_BOX || engine->ctx.precision != IMAGE_PRECISION_BYTE)
+    return false;
+
+  const TransformD& transform = engine->getFinalTransformD();
+  if (transform._getType() > TRANSFORM_TYPE_AFFINE)
+    return false;
+
+  double tx = transform._20;
+  double ty = transform._21;
+
+  // Also handles NaN.
+  if (!(Math::abs(tx) < 1073741824.0 && Math::abs(ty) < 1073741824.0))
+    return false;
+
+  double fx = Math::floor(tx);
+  double fy = Math::floor(ty);
+
+  int px = Math::iround((tx - fx) * double(RASTER_MASK_CACHE_PHASE_COUNT));
+  int py = Math::iround((ty - fy) * double(RASTER_MASK_CACHE_PHASE_COUNT));
+
+  offset.set((int)fx, (int)fy);
+
+  if (px == RASTER_MASK_CACHE_PHASE_COUNT) { px = 0; offset.x++; }
+  if (py == RASTER_MASK_CACHE_PHASE_COUNT) { py = 0; offset.y++; }
+
+  key.fillRule = fillRule;
+  key.opacity = engine->ctx.rasterHints.opacity;
+  key.phase.set(px, py);
+  key.linear[0] = transform._00;
+  key.linear[1] = transform._01;
+  key.linear[2] = transform._10;
+  key.linear[3] = transform._11;
+
+  tr = TransformD(
+    transform._00, transform._01,
+    transform._10, transform._11,
+    double(px) / double(RASTER_MASK_CACHE_PHASE_COUNT),
+    double(py) / double(RASTER_MASK_CACHE_PHASE_COUNT));
+  return true;
+}
+
+// Rasterize the transformed path and record its spans into a new cache entry.
+// Returns NULL if the path is rejected (too large) or on out of memory.
+static RasterMaskCacheEntry* RasterPaintDoRender_recordMask(RasterPaintEngine* engine,
+  const RasterMaskCacheKey& key, uint32_t hashCode, const PathD& path)
+{
+  const uint8_t* cmd = path.getCommands();
+  const PointD* pts = path.getVertices();
+  size_t i, length = path.getLength();
+
+  // Control points are used instead of the bounding-box, because the path
+  // must be within the scene-box (there is no clipping).
+  for (i = 0; i < length; i++)
+  {
+    if (PathCmd::isVertex(cmd[i]))
+      break;
+  }
+
+  RasterMaskCacheRecorder recorder;
+
+  if (i == length)
+  {
+    recorder.begin(BoxI(0, 0, 0, 0));
+    return recorder.createEntry(key, hashCode);
+  }
+
+  BoxD hull(pts[i].x, pts[i].y, pts[i].x, pts[i].y);
+  for (; i < length; i++)
+  {
+    if (!PathCmd::isVertex(cmd[i]))
+      continue;
+
+    if (pts[i].x < hull.x0) hull.x0 = pts[i].x;
+    if (pts[i].y < hull.y0) hull.y0 = pts[i].y;
+    if (pts[i].x > hull.x1) hull.x1 = pts[i].x;
+    if (pts[i].y > hull.y1) hull.y1 = pts[i].y;
+  }
+
+  // Reject large paths, and paths far from the origin (the coordinates must
+  // fit into 24.8 fixed point).
+  if (!(hull.x1 - hull.x0 < double(RASTER_MASK_CACHE_MAX_SIZE) &&
+        hull.y1 - hull.y0 < double(RASTER_MASK_CACHE_MAX_SIZE) &&
+        Math::abs(hull.x0) < 4194304.0 && Math::abs(hull.y0) < 4194304.0))
+  {
+    RasterMaskCache_global->reject(hashCode);
+    return NULL;
+  }
+
+  BoxI box((int)Math::floor(hull.x0)    , (int)Math::floor(hull.y0)    ,
+           (int)Math::floor(hull.x1) + 1, (int)Math::floor(hull.y1) + 1);
+
+  PathRasterizer8* rasterizer = &engine->ctx.pathRasterizer8;
+  rasterizer->setSceneBox(box);
+  rasterizer->setOpacity(key.opacity);
+  rasterizer->setFillRule(key.fillRule);
+
+  if (FOG_IS_ERROR(rasterizer->init()))
+    return NULL;
+
+  rasterizer->addPath(path);
+  rasterizer->finalize();
+
+  if (rasterizer->isValid())
+  {
+    recorder.begin(rasterizer->getBoundingBox());
+    if (!recorder.failed)
+      rasterizer->render(&recorder, &engine->ctx.scanline8);
+  }
+  else
+  {
+    recorder.begin(BoxI(0, 0, 0, 0));
+  }
+
+  return recorder.createEntry(key, hashCode);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRender_fillMaskCacheEntry(RasterPaintEngine* engine,
+  RasterMaskCacheEntry* entry, const PointI& offset)
+{
+  RasterMaskCacheRasterizer8 rasterizer;
+  RasterPaintDoRender_prepareRasterizer(engine, &rasterizer);
+
+  err_t err = ERR_OK;
+  if (rasterizer.init(entry, offset))
+    err = RasterPaintDoRender_fillRasterizedShape8(engine, &rasterizer);
+
+  RasterMaskCache::release(entry);
+  return err;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRender_fillCachedPathF(
+  RasterPaintEngine* engine, const PathF* path, uint32_t fillRule)
+{
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_CACHED_PATH_F);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
+  RasterMaskCacheKey key;
+  TransformD tr(UNINITIALIZED);
+  PointI offset(UNINITIALIZED);
+
+  if (!RasterPaintDoRender_initMaskCacheKey(engine, key, tr, offset, fillRule))
+    return ERR_RT_OBJECT_NOT_FOUND;
+
+  key.pathData = path->_d;
+  key.pathType = RASTER_PRECISION_F;
+
+  uint32_t hashCode = key.getHashCode();
+  RasterMaskCacheEntry* entry = RasterMaskCache_global->get(key, hashCode);
+
+  if (entry == NULL)
+  {
+    // Don't record paths filled only once.
+    if (!RasterMaskCache_global->admit(hashCode))
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    PathD* tmp = &engine->ctx.tmpPathD[1];
+    if (FOG_IS_ERROR(tr.mapPath(*tmp, *path)))
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    entry = RasterPaintDoRender_recordMask(engine, key, hashCode, *tmp);
+    if (entry == NULL)
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    RasterMaskCache_global->put(entry);
+  }
+
+  return RasterPaintDoRender_fillMaskCacheEntry(engine, entry, offset);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRender_fillCachedPathD(
+  RasterPaintEngine* engine, const PathD* path, uint32_t fillRule)
+{
+  _FOG_RASTER_STATISTICS_RENDER(engine, PAINT_STATISTICS_CMD_FILL_CACHED_PATH_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILL);
+
+  RasterMaskCacheKey key;
+  TransformD tr(UNINITIALIZED);
+  PointI offset(UNINITIALIZED);
+
+  if (!RasterPaintDoRender_initMaskCacheKey(engine, key, tr, offset, fillRule))
+    return ERR_RT_OBJECT_NOT_FOUND;
+
+  key.pathData = path->_d;
+  key.pathType = RASTER_PRECISION_D;
+
+  uint32_t hashCode = key.getHashCode();
+  RasterMaskCacheEntry* entry = RasterMaskCache_global->get(key, hashCode);
+
+  if (entry == NULL)
+  {
+    // Don't record paths filled only once.
+    if (!RasterMaskCache_global->admit(hashCode))
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    PathD* tmp = &engine->ctx.tmpPathD[1];
+    if (FOG_IS_ERROR(tr.mapPath(*tmp, *path)))
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    entry = RasterPaintDoRender_recordMask(engine, key, hashCode, *tmp);
+    if (entry == NULL)
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    RasterMaskCache_global->put(entry);
+  }
+
+  return RasterPaintDoRender_fillMaskCacheEntry(engine, entry, offset);
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoRender - BlitImage]
 // ============================================================================
@@ -579,6 +854,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
 static err_t FOG_FASTCALL RasterPaintDoRender_blitImageD(
   RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
+  _FOG_RASTER_STATISTICS_BLIT(engine, PAINT_STATISTICS_CMD_BLIT_IMAGE_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_BLIT);
+
   BoxD boxClipped(*box);
   engine->getFinalTransformD().mapBox(boxClipped, boxClipped);
 
@@ -623,6 +901,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitImageD(
 static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
   RasterPaintEngine* engine, const PointI* pt, const Image* srcImage, const RectI* srcFragment)
 {
+  _FOG_RASTER_STATISTICS_BLIT(engine, PAINT_STATISTICS_CMD_BLIT_IMAGE_A);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_BLIT);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -642,6 +923,20 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
         uint32_t compositingOperator = engine->ctx.paintHints.compositingOperator;
         uint32_t opacity = engine->ctx.rasterHints.opacity;
 
+        // SRC_OVER of a fully-opaque source is SRC, fully-transparent is NOP.
+        if (compositingOperator == COMPOSITE_SRC_OVER && srcFormat == IMAGE_FORMAT_PRGB32)
+        {
+          switch (srcImage->getAlphaDistribution())
+          {
+            case ALPHA_DISTRIBUTION_ZERO:
+              return ERR_OK;
+
+            case ALPHA_DISTRIBUTION_FULL:
+              compositingOperator = COMPOSITE_SRC;
+              break;
+          }
+        }
+
         // --------------------------------------------------------------------------
         // [Clip == Box]
         // --------------------------------------------------------------------------
@@ -654,6 +949,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
 
         int i = srcHeight;
         FOG_ASSERT(y0 + srcHeight <= engine->ctx.target.size.h);
+        _FOG_RASTER_STATISTICS_BOX(engine, srcWidth, srcHeight);
 
         pixels += y0 * stride;
         srcPixels += srcFragment->y * srcStride;
@@ -815,6 +1111,9 @@ _BlitImageA8_Alpha:
 static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageI(
   RasterPaintEngine* engine, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
+  _FOG_RASTER_STATISTICS_BLIT(engine, PAINT_STATISTICS_CMD_BLIT_NORMALIZED_IMAGE_I);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_BLIT);
+
   // Must be already clipped.
   FOG_ASSERT(engine->ctx.clipBoxI.subsumes(*box));
 
@@ -840,6 +1139,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageI(
 static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageD(
   RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
+  _FOG_RASTER_STATISTICS_BLIT(engine, PAINT_STATISTICS_CMD_BLIT_NORMALIZED_IMAGE_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_BLIT);
+
   // Must be already clipped.
   FOG_ASSERT(engine->getClipBoxD().subsumes(*box));
 
@@ -936,6 +1238,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterRasterizedShape8(RasterPaint
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
   RasterPaintEngine* engine, const FeBase* feBase, const BoxI* box)
 {
+  _FOG_RASTER_STATISTICS_FILTER(engine, PAINT_STATISTICS_CMD_FILTER_BOX_I);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILTER);
+
   FOG_ASSERT(box->isValid());
 
   // Destination and source formats are the same.
@@ -957,6 +1262,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
 
   PointI dPos;
   RectI sRect(box->x0, box->y0, box->x1 - box->x0, box->y1 - box->y0);
+  _FOG_RASTER_STATISTICS_BOX(engine, sRect.w, sRect.h);
 
   uint32_t opacity = engine->ctx.rasterHints.opacity;
   MemBuffer intermediateBuffer;
@@ -1036,6 +1342,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxF(
   RasterPaintEngine* engine, const FeBase* feBase, const BoxF* box)
 {
+  _FOG_RASTER_STATISTICS_FILTER(engine, PAINT_STATISTICS_CMD_FILTER_BOX_F);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILTER);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -1078,6 +1387,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxF(
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxD(
   RasterPaintEngine* engine, const FeBase* feBase, const BoxD* box)
 {
+  _FOG_RASTER_STATISTICS_FILTER(engine, PAINT_STATISTICS_CMD_FILTER_BOX_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILTER);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -1124,6 +1436,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxD(
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathF(
   RasterPaintEngine* engine, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule)
 {
+  _FOG_RASTER_STATISTICS_FILTER(engine, PAINT_STATISTICS_CMD_FILTER_PATH_F);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILTER);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -1137,6 +1452,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathF(
 
       rasterizer->addPath(*path, *pt);
       rasterizer->finalize();
+      _FOG_RASTER_STATISTICS_CELLS(engine, rasterizer);
 
       if (rasterizer->isValid())
         return RasterPaintDoRender_filterRasterizedShape8(engine, feBase, rasterizer, &rasterizer->_boundingBox);
@@ -1161,6 +1477,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathF(
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathD(
   RasterPaintEngine* engine, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule)
 {
+  _FOG_RASTER_STATISTICS_FILTER(engine, PAINT_STATISTICS_CMD_FILTER_PATH_D);
+  _FOG_RASTER_STATISTICS_TIME(engine, PAINT_STATISTICS_TIME_FILTER);
+
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
@@ -1174,6 +1493,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathD(
 
       rasterizer->addPath(*path, *pt);
       rasterizer->finalize();
+      _FOG_RASTER_STATISTICS_CELLS(engine, rasterizer);
 
       if (rasterizer->isValid())
         return RasterPaintDoRender_filterRasterizedShape8(engine, feBase, rasterizer, &rasterizer->_boundingBox);
@@ -1201,12 +1521,16 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathD(
 
 static err_t FOG_FASTCALL RasterPaintDoRender_switchToMask(RasterPaintEngine* engine)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_SWITCH_TO_MASK);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_discardMask(RasterPaintEngine* engine)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_DISCARD_MASK);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
@@ -1217,12 +1541,16 @@ static err_t FOG_FASTCALL RasterPaintDoRender_discardMask(RasterPaintEngine* eng
 
 static err_t FOG_FASTCALL RasterPaintDoRender_saveMask(RasterPaintEngine* engine)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_SAVE_MASK);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_restoreMask(RasterPaintEngine* engine)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_RESTORE_MASK);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
@@ -1233,18 +1561,24 @@ static err_t FOG_FASTCALL RasterPaintDoRender_restoreMask(RasterPaintEngine* eng
 
 static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxI(RasterPaintEngine* engine, uint32_t clipOp, const BoxI* box)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_MASK_BOX_I);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxF(RasterPaintEngine* engine, uint32_t clipOp, const BoxF* box)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_MASK_BOX_F);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxD(RasterPaintEngine* engine, uint32_t clipOp, const BoxD* box)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_MASK_BOX_D);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
@@ -1255,12 +1589,16 @@ static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxD(RasterPaintEngi
 
 static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedPathF(RasterPaintEngine* engine, uint32_t clipOp, const PathF* path, uint32_t fillRule)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_MASK_PATH_F);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedPathD(RasterPaintEngine* engine, uint32_t clipOp, const PathD* path, uint32_t fillRule)
 {
+  _FOG_RASTER_STATISTICS_CMD(engine, PAINT_STATISTICS_CMD_MASK_PATH_D);
+
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
@@ -1283,6 +1621,8 @@ void FOG_NO_EXPORT RasterPaintDoRender_init(void)
   v->fillNormalizedBoxD = RasterPaintDoRender_fillNormalizedBoxD;
   v->fillNormalizedPathF = RasterPaintDoRender_fillNormalizedPathF;
   v->fillNormalizedPathD = RasterPaintDoRender_fillNormalizedPathD;
+  v->fillCachedPathF = RasterPaintDoRender_fillCachedPathF;
+  v->fillCachedPathD = RasterPaintDoRender_fillCachedPathD;
 
   // --------------------------------------------------------------------------
   // [Blit]
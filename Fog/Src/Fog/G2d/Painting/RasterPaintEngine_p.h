@@ -27,6 +27,7 @@
 #include <Fog/G2d/Painting/RasterPaintStructs_p.h>
 #include <Fog/G2d/Painting/RasterScanline_p.h>
 #include <Fog/G2d/Painting/RasterSpan_p.h>
+#include <Fog/G2d/Painting/RasterStatistics_p.h>
 #include <Fog/G2d/Painting/RasterUtil_p.h>
 #include <Fog/G2d/Painting/Rasterizer_p.h>
 
@@ -460,6 +461,17 @@ _DiscardContinue:
   //! related to changing multithreaded mode into singlethreaded can't fail.
   uint finalizing;
 
+#if defined(FOG_BUILD_PAINT_STATISTICS)
+  // --------------------------------------------------------------------------
+  // [Members - Statistics]
+  // --------------------------------------------------------------------------
+
+  //! @brief Statistics (see @c PAINTER_PARAMETER_STATISTICS).
+  PaintStatistics statistics;
+  //! @brief Count of nested @ref RasterStatisticsTimer instances.
+  uint32_t statisticsNested;
+#endif // FOG_BUILD_PAINT_STATISTICS
+
   // --------------------------------------------------------------------------
   // [Members - Temporary]
   // --------------------------------------------------------------------------
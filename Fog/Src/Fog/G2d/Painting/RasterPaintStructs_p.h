@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/G2d/Geometry/Box.h>
 #include <Fog/G2d/Geometry/Path.h>
 #include <Fog/G2d/Geometry/PathStroker.h>
@@ -212,6 +213,10 @@ struct FOG_NO_EXPORT RasterPaintGroup
     opacityF = 1.0f;
     boundingBox.setBox(INT_MIN, INT_MIN, INT_MIN, INT_MIN);
 
+    tileMap = NULL;
+    tileStride = 0;
+    targetSize.reset();
+
     groupRecord = NULL;
     cmdRecord = NULL;
     cmdStart = NULL;
@@ -228,14 +233,20 @@ struct FOG_NO_EXPORT RasterPaintGroup
 
   FOG_INLINE void mergeBoundingBox(const BoxI& box)
   {
-    if (hasBoundingBox())
-      BoxI::bound(boundingBox, boundingBox, box);
-    else
-      boundingBox = box;
+    mergeBoundingBox(box.x0, box.y0, box.x1, box.y1);
   }
 
   FOG_INLINE void mergeBoundingBox(int x0, int y0, int x1, int y1)
   {
+    // The group can't paint outside of the target.
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > targetSize.w) x1 = targetSize.w;
+    if (y1 > targetSize.h) y1 = targetSize.h;
+
+    if (x0 >= x1 || y0 >= y1)
+      return;
+
     if (hasBoundingBox())
     {
       if (boundingBox.x0 > x0) boundingBox.x0 = x0;
@@ -247,6 +258,31 @@ struct FOG_NO_EXPORT RasterPaintGroup
     {
       boundingBox.setBox(x0, y0, x1, y1);
     }
+
+    if (tileMap != NULL)
+      markTiles(x0, y0, x1, y1);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Tiles]
+  // --------------------------------------------------------------------------
+
+  //! @brief Mark all tiles intersecting the box [x0, y0, x1, y1] as used, the
+  //! box must be valid and within the target.
+  FOG_INLINE void markTiles(int x0, int y0, int x1, int y1)
+  {
+    int tx0 = x0 >> RASTER_GROUP_TILE_SHIFT;
+    int ty0 = y0 >> RASTER_GROUP_TILE_SHIFT;
+    int tx1 = ((x1 - 1) >> RASTER_GROUP_TILE_SHIFT) + 1;
+    int ty1 = ((y1 - 1) >> RASTER_GROUP_TILE_SHIFT) + 1;
+
+    uint8_t* p = tileMap + ty0 * tileStride + tx0;
+    size_t count = (size_t)(uint)(tx1 - tx0);
+
+    do {
+      MemOps::set(p, 1, count);
+      p += tileStride;
+    } while (++ty0 < ty1);
   }
 
   // --------------------------------------------------------------------------
@@ -273,6 +309,14 @@ struct FOG_NO_EXPORT RasterPaintGroup
   BoxI boundingBox;
 #endif
 
+  //! @brief Map of tiles (@c RASTER_GROUP_TILE_SIZE) touched by commands of
+  //! this group, one byte per tile (or @c NULL if the map is not used).
+  uint8_t* tileMap;
+  //! @brief Count of tiles per row in @c tileMap.
+  int tileStride;
+  //! @brief Size of the target, the bounding box is clipped to it.
+  SizeI targetSize;
+
   RasterPaintState* savedState;
 
   //! @brief Group record (recorded position in groupAllocator).
@@ -436,6 +480,12 @@ struct FOG_NO_EXPORT RasterPaintDoCmd
   err_t (FOG_FASTCALL *fillNormalizedPathF)(RasterPaintEngine* engine, const PathF* path, const PointF* pt, uint32_t fillRule);
   err_t (FOG_FASTCALL *fillNormalizedPathD)(RasterPaintEngine* engine, const PathD* path, const PointD* pt, uint32_t fillRule);
 
+  //! @brief Fill user path (not clipped and not transformed) using the
+  //! coverage-mask cache, returns @c ERR_RT_OBJECT_NOT_FOUND if the path
+  //! can't be cached. Can be @c NULL.
+  err_t (FOG_FASTCALL *fillCachedPathF)(RasterPaintEngine* engine, const PathF* path, uint32_t fillRule);
+  err_t (FOG_FASTCALL *fillCachedPathD)(RasterPaintEngine* engine, const PathD* path, uint32_t fillRule);
+
   // --------------------------------------------------------------------------
   // [Funcs - Blit]
   // --------------------------------------------------------------------------
@@ -0,0 +1,261 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERSTATISTICS_P_H
+#define _FOG_G2D_PAINTING_RASTERSTATISTICS_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Painting/PaintStatistics.h>
+
+#if defined(FOG_BUILD_PAINT_STATISTICS)
+#include <Fog/Core/Tools/Time.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterSpan_p.h>
+#include <Fog/G2d/Painting/Rasterizer_p.h>
+
+#if defined(FOG_CC_MSC) && (defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64))
+# include <intrin.h>
+#endif // FOG_CC_MSC && (FOG_ARCH_X86 || FOG_ARCH_X86_64)
+#endif // FOG_BUILD_PAINT_STATISTICS
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+#if defined(FOG_BUILD_PAINT_STATISTICS)
+
+// ============================================================================
+// [Fog::RasterStatistics - Cycles]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get the time-stamp counter, or high-precision ticks if the counter
+//! is not available.
+static FOG_INLINE uint64_t RasterStatistics_getCycles()
+{
+#if defined(FOG_CC_MSC) && (defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64))
+  return (uint64_t)__rdtsc();
+#elif (defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)) && (defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64))
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+#else
+  return (uint64_t)TimeTicks::now(CPU_TICKS_PRECISION_HIGH).getTicks();
+#endif
+}
+
+// ============================================================================
+// [Fog::RasterStatistics - Counters]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Count a command which renders using the current source.
+//!
+//! The compositing operator, source and clip type are counted only for the
+//! outermost command, @a nested is the count of active timers.
+static FOG_INLINE void RasterStatistics_render(PaintStatistics& statistics, uint32_t nested,
+  uint32_t cmd, uint32_t compositingOperator, uint32_t sourceType, uint32_t clipType)
+{
+  static const uint8_t patternType[] =
+  {
+    /* RASTER_SOURCE_NONE     */ PATTERN_TYPE_NULL,
+    /* RASTER_SOURCE_ARGB32   */ PATTERN_TYPE_COLOR,
+    /* RASTER_SOURCE_COLOR    */ PATTERN_TYPE_COLOR,
+    /* RASTER_SOURCE_TEXTURE  */ PATTERN_TYPE_TEXTURE,
+    /* RASTER_SOURCE_GRADIENT */ PATTERN_TYPE_GRADIENT
+  };
+
+  statistics.cmdCount[cmd]++;
+  if (nested != 0)
+    return;
+
+  statistics.opCount[compositingOperator]++;
+  statistics.sourceCount[patternType[sourceType]]++;
+  statistics.clipCount[clipType]++;
+}
+
+//! @internal
+//!
+//! @brief Count composited spans and their pixels.
+static FOG_INLINE void RasterStatistics_spans(PaintStatistics& statistics, const RasterSpan8* span)
+{
+  do {
+    statistics.spanCount++;
+    statistics.pixelCount += (uint)(span->getX1() - span->getX0());
+    span = span->getNext();
+  } while (span != NULL);
+}
+
+//! @internal
+//!
+//! @brief Count cells of the finalized path rasterizer.
+static FOG_INLINE void RasterStatistics_cells(PaintStatistics& statistics, const PathRasterizer8* rasterizer)
+{
+  if (!rasterizer->isValid())
+    return;
+
+  const BoxI& box = rasterizer->getBoundingBox();
+  uint64_t count = 0;
+
+  for (int y = box.y0; y < box.y1; y++)
+  {
+    const PathRasterizer8::Chunk* first = rasterizer->_rowsAdjusted[y].first;
+    const PathRasterizer8::Chunk* chunk = first;
+
+    if (chunk == NULL)
+      continue;
+
+    do {
+      count += (uint)(chunk->x1 - chunk->x0);
+      chunk = chunk->next;
+    } while (chunk != first);
+  }
+
+  statistics.cellCount += count;
+}
+
+// ============================================================================
+// [Fog::RasterStatisticsTimer]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Adds the time spent in the current scope to the statistics.
+//!
+//! Only the outermost timer records the time, so operations which call
+//! other timed operations (for example a box fill forwarded to an aligned box
+//! fill) are timed once.
+struct FOG_NO_EXPORT RasterStatisticsTimer
+{
+  FOG_INLINE RasterStatisticsTimer(PaintStatistics& statistics, uint32_t& nested, uint32_t id) :
+    _statistics(statistics),
+    _nested(nested),
+    _id(id),
+    _start(0)
+  {
+    if (_nested++ == 0)
+      _start = RasterStatistics_getCycles();
+  }
+
+  FOG_INLINE ~RasterStatisticsTimer()
+  {
+    if (--_nested == 0)
+    {
+      _statistics.timeCount[_id]++;
+      _statistics.timeCycles[_id] += RasterStatistics_getCycles() - _start;
+    }
+  }
+
+  PaintStatistics& _statistics;
+  uint32_t& _nested;
+  uint32_t _id;
+  uint64_t _start;
+
+private:
+  FOG_NO_COPY(RasterStatisticsTimer)
+};
+
+// ============================================================================
+// [Fog::RasterStatistics - Macros]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Count command @a _Cmd_ which doesn't render.
+#define _FOG_RASTER_STATISTICS_CMD(_Engine_, _Cmd_) \
+  FOG_MACRO_BEGIN \
+    (_Engine_)->statistics.cmdCount[_Cmd_]++; \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Count command @a _Cmd_ which renders using the current source.
+#define _FOG_RASTER_STATISTICS_RENDER(_Engine_, _Cmd_) \
+  FOG_MACRO_BEGIN \
+    ::Fog::RasterStatistics_render((_Engine_)->statistics, (_Engine_)->statisticsNested, _Cmd_, \
+      (_Engine_)->ctx.paintHints.compositingOperator, \
+      (_Engine_)->sourceType, \
+      (_Engine_)->ctx.clipType); \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Count command @a _Cmd_ which blits an image (the source is not used).
+#define _FOG_RASTER_STATISTICS_BLIT(_Engine_, _Cmd_) \
+  FOG_MACRO_BEGIN \
+    (_Engine_)->statistics.cmdCount[_Cmd_]++; \
+    if ((_Engine_)->statisticsNested == 0) \
+    { \
+      (_Engine_)->statistics.opCount[(_Engine_)->ctx.paintHints.compositingOperator]++; \
+      (_Engine_)->statistics.clipCount[(_Engine_)->ctx.clipType]++; \
+    } \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Count command @a _Cmd_ which filters.
+#define _FOG_RASTER_STATISTICS_FILTER(_Engine_, _Cmd_) \
+  FOG_MACRO_BEGIN \
+    (_Engine_)->statistics.cmdCount[_Cmd_]++; \
+    if ((_Engine_)->statisticsNested == 0) \
+      (_Engine_)->statistics.clipCount[(_Engine_)->ctx.clipType]++; \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Count spans (linked list) composited by the engine.
+#define _FOG_RASTER_STATISTICS_SPANS(_Engine_, _Spans_) \
+  FOG_MACRO_BEGIN \
+    ::Fog::RasterStatistics_spans((_Engine_)->statistics, _Spans_); \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Count box of @a _Width_ x @a _Height_ pixels composited without
+//! spans (one span per row is counted).
+#define _FOG_RASTER_STATISTICS_BOX(_Engine_, _Width_, _Height_) \
+  FOG_MACRO_BEGIN \
+    (_Engine_)->statistics.spanCount += (uint)(_Height_); \
+    (_Engine_)->statistics.pixelCount += (uint64_t)(uint)(_Width_) * (uint)(_Height_); \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Count cells of the finalized path rasterizer.
+#define _FOG_RASTER_STATISTICS_CELLS(_Engine_, _Rasterizer_) \
+  FOG_MACRO_BEGIN \
+    ::Fog::RasterStatistics_cells((_Engine_)->statistics, _Rasterizer_); \
+  FOG_MACRO_END
+
+//! @internal
+//!
+//! @brief Time the current scope, see @c PAINT_STATISTICS_TIME.
+#define _FOG_RASTER_STATISTICS_TIME(_Engine_, _Id_) \
+  ::Fog::RasterStatisticsTimer _statisticsTimer((_Engine_)->statistics, (_Engine_)->statisticsNested, _Id_)
+
+#else
+
+#define _FOG_RASTER_STATISTICS_CMD(_Engine_, _Cmd_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_RENDER(_Engine_, _Cmd_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_BLIT(_Engine_, _Cmd_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_FILTER(_Engine_, _Cmd_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_SPANS(_Engine_, _Spans_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_BOX(_Engine_, _Width_, _Height_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_CELLS(_Engine_, _Rasterizer_) FOG_MACRO_BEGIN FOG_MACRO_END
+#define _FOG_RASTER_STATISTICS_TIME(_Engine_, _Id_) FOG_MACRO_BEGIN FOG_MACRO_END
+
+#endif // FOG_BUILD_PAINT_STATISTICS
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERSTATISTICS_P_H
@@ -166,6 +166,39 @@ struct FOG_NO_EXPORT RasterConvertMulti
   int step;
 };
 
+// ============================================================================
+// [Fog::RasterConvertShuffle]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Structure used by the byte-shuffle converter (the converter used to
+//! convert between 24-bit and 32-bit formats which have all components aligned
+//! to bytes, for example RGBA, ABGR or BGR24).
+//!
+//! The shuffle is compiled from the destination and source image format
+//! descriptions by @c RasterOps_C::Convert::initShuffle().
+struct FOG_NO_EXPORT RasterConvertShuffle
+{
+  //! @brief PSHUFB compatible mask for four destination pixels.
+  //!
+  //! Each byte contains the index of the source byte to copy or 0x80 in case
+  //! that the destination byte has no source component.
+  uint8_t mask[16];
+  //! @brief Constant ORed with the shuffled bytes (four destination pixels).
+  //!
+  //! Used to fill the alpha channel if the source has no alpha, and to fill
+  //! the unused bits if requested by the destination format.
+  uint8_t fill[16];
+
+  //! @brief Count of shift/mask pairs used by the SSE2 shuffle (32-bit only).
+  uint32_t shiftCount;
+  //! @brief Shift of each source pixel, positive is left, negative is right.
+  int32_t shift[4];
+  //! @brief Mask applied to each shifted source pixel.
+  uint32_t shiftMask[4];
+};
+
 // ============================================================================
 // [Fog::RasterSolid]
 // ============================================================================
@@ -402,6 +435,23 @@ struct FOG_NO_EXPORT RasterPattern
     //int fyrewind;
   };
 
+  struct _TextureScale
+  {
+    //! @brief Source X/Y of the pixel [0, 0] (32.32 fixed point).
+    Fixed32x32 tx, ty;
+    //! @brief Source X/Y advance per destination pixel (32.32 fixed point).
+    Fixed32x32 xx, yy;
+    //! @brief Max X/Y (32.32 fixed point), used by @c TEXTURE_TILE_REPEAT or
+    //! @c TEXTURE_TILE_REFLECT tiling.
+    Fixed32x32 mx, my;
+
+    //! @brief Integer X scale if each source pixel is replicated by NEAREST
+    //! fetcher, otherwise zero.
+    int replicateX;
+    //! @brief Destination X where the first source pixel starts (replication).
+    int replicateX0;
+  };
+
   struct _TexturePacked
   {
     _TextureBase base;
@@ -409,6 +459,7 @@ struct FOG_NO_EXPORT RasterPattern
     union
     {
       _TextureSimple simple;
+      _TextureScale scale;
       _TextureAffine affine;
     };
   };
@@ -613,6 +664,12 @@ struct FOG_NO_EXPORT RasterPatternFetcher
       int dy;
     } simple;
 
+    struct _Scale
+    {
+      Fixed32x32 py;
+      Fixed32x32 dy;
+    } scale;
+
     struct _Affine
     {
       double px, py;
@@ -817,6 +874,56 @@ struct FOG_NO_EXPORT RasterFilterBlur
   uint8_t* stack;
 };
 
+// ============================================================================
+// [Fog::RasterFilterTurbulenceTables]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Lattice and gradients used by the turbulence generator.
+struct FOG_NO_EXPORT RasterFilterTurbulenceTables
+{
+  //! @brief Gradients, each entry contains four x components followed by four
+  //! y components (one per channel, in R, G, B, A order).
+  float gradient[RASTER_TURBULENCE_BSIZE * 2 + 2][8];
+  //! @brief Lattice selector.
+  int lattice[RASTER_TURBULENCE_BSIZE * 2 + 2];
+};
+
+// ============================================================================
+// [Fog::RasterFilterTurbulence]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT RasterFilterTurbulence
+{
+  //! @brief Filter context (immutable at this place).
+  const RasterFilter* filterCtx;
+  //! @brief Lattice and gradients.
+  const RasterFilterTurbulenceTables* tables;
+
+  //! @brief Horizontal base frequency (in device pixels).
+  float hFrequency;
+  //! @brief Vertical base frequency (in device pixels).
+  float vFrequency;
+
+  //! @brief Number of octaves.
+  int numOctaves;
+  //! @brief Whether to generate fractal noise instead of turbulence.
+  uint32_t fractalSum;
+
+  //! @brief Whether to stitch tiles.
+  uint32_t stitchTiles;
+  //! @brief Width of the stitched tile (in lattice units, first octave).
+  int stitchWidth;
+  //! @brief Height of the stitched tile (in lattice units, first octave).
+  int stitchHeight;
+  //! @brief Minimum x lattice coordinate to wrap (first octave).
+  int stitchWrapX;
+  //! @brief Minimum y lattice coordinate to wrap (first octave).
+  int stitchWrapY;
+};
+
 // ============================================================================
 // [Fog::RasterFilter]
 // ============================================================================
@@ -899,6 +1006,23 @@ struct FOG_NO_EXPORT RasterFilter
   {
   };
 
+  // --------------------------------------------------------------------------
+  // [Members - Turbulence]
+  // --------------------------------------------------------------------------
+
+  struct FOG_NO_EXPORT _Turbulence
+  {
+    uint32_t turbulenceType;
+    uint32_t numOctaves;
+    uint32_t stitchTiles;
+
+    float hFrequency;
+    float vFrequency;
+
+    RasterFilterTurbulenceTables* tables;
+    RasterFilterDoTurbulenceFunc doRow;
+  };
+
   // --------------------------------------------------------------------------
   // [Members - Data]
   // --------------------------------------------------------------------------
@@ -939,6 +1063,7 @@ struct FOG_NO_EXPORT RasterFilter
     _ConvolveSeparable convolveSeparable;
 
     _Morphology morphology;
+    _Turbulence turbulence;
   };
 };
 
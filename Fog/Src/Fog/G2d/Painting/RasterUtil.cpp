@@ -0,0 +1,150 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/Cpu.h>
+#include <Fog/G2d/Painting/RasterUtil_p.h>
+
+namespace Fog {
+namespace RasterUtil {
+
+// ============================================================================
+// [Fog::RasterUtil - Bands]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Context shared by all bands of @c doBandsMT().
+//!
+//! The context is reference counted, because the worker thread may still touch
+//! it after the calling thread was woken-up. The job data are only used before
+//! the band is marked as finished, so they can live on the caller's stack.
+struct FOG_NO_EXPORT RasterBandContext
+{
+  FOG_INLINE RasterBandContext() :
+    event(false, false)
+  {
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      fog_delete(this);
+  }
+
+  //! @brief Reference count (the calling thread and each task).
+  Atomic<size_t> reference;
+  //! @brief Count of bands not finished yet.
+  Atomic<size_t> remaining;
+  //! @brief Signaled by the band which finished as the last one.
+  ThreadEvent event;
+
+  BandFunc func;
+  void* data;
+};
+
+//! @internal
+struct FOG_NO_EXPORT RasterBandTask : public Task
+{
+  FOG_INLINE RasterBandTask(RasterBandContext* ctx, int y, int yEnd) :
+    ctx(ctx),
+    y(y),
+    yEnd(yEnd)
+  {
+  }
+
+  virtual void run()
+  {
+    ctx->func(ctx->data, y, yEnd);
+
+    if (ctx->remaining.deref())
+      ctx->event.signal();
+    ctx->release();
+  }
+
+  RasterBandContext* ctx;
+  int y;
+  int yEnd;
+};
+
+bool doBandsMT(BandFunc func, void* data, int w, int h, uint32_t threshold, int minRows)
+{
+  if ((uint64_t)(uint)w * (uint)h < (uint64_t)threshold)
+    return false;
+
+  int numBands = Math::min<int>(
+    (int)Cpu::get()->getNumberOfProcessors(),
+    h / minRows, RASTER_MAX_THREADS_SUGGESTED);
+
+  if (numBands < 2)
+    return false;
+
+  Thread* threads[RASTER_MAX_THREADS_SUGGESTED];
+  ThreadPool* pool = ThreadPool::get();
+
+  while (numBands >= 2 && pool->getThreads(threads, (size_t)(numBands - 1)) != ERR_OK)
+    numBands >>= 1;
+
+  if (numBands < 2)
+    return false;
+
+  RasterBandContext* ctx = fog_new RasterBandContext();
+  if (FOG_IS_NULL(ctx))
+  {
+    pool->releaseThreads(threads, (size_t)(numBands - 1));
+    return false;
+  }
+
+  ctx->reference.init((size_t)numBands);
+  ctx->remaining.init((size_t)numBands);
+  ctx->func = func;
+  ctx->data = data;
+
+  int bandSize = (h + numBands - 1) / numBands;
+  int i;
+
+  for (i = 1; i < numBands; i++)
+  {
+    int y = i * bandSize;
+    int yEnd = Math::min<int>(y + bandSize, h);
+
+    RasterBandTask* task = fog_new RasterBandTask(ctx, y, yEnd);
+    if (FOG_IS_NULL(task) || threads[i - 1]->getEventLoop().postTask(task) != ERR_OK)
+    {
+      if (task != NULL)
+        fog_delete(task);
+
+      // Process the band here if it can't be posted.
+      func(data, y, yEnd);
+
+      ctx->remaining.dec();
+      ctx->reference.dec();
+    }
+  }
+
+  func(data, 0, Math::min<int>(bandSize, h));
+
+  if (!ctx->remaining.deref())
+    ctx->event.wait();
+
+  pool->releaseThreads(threads, (size_t)(numBands - 1));
+  ctx->release();
+
+  return true;
+}
+
+} // RasterUtil namespace
+} // Fog namespace
@@ -195,6 +195,23 @@ static FOG_INLINE bool canAlignToGrid(BoxI& dst, const RectD& src, double x, dou
   return true;
 }
 
+// ============================================================================
+// [Fog::RasterUtil - Bands]
+// ============================================================================
+
+//! @brief Band function, processes rows [@a y, @a yEnd) of the job described
+//! by @a data.
+typedef void (FOG_FASTCALL *BandFunc)(void* data, int y, int yEnd);
+
+//! @brief Split @a h rows into horizontal bands processed in parallel, the
+//! calling thread processes the first band and the other bands are processed
+//! by threads taken from the thread pool. Returns after all bands were done.
+//!
+//! Returns false (and doesn't call @a func) if the job has less than
+//! @a threshold pixels, can't be split into at least two bands of @a minRows
+//! rows, or there are no threads available.
+FOG_NO_EXPORT bool doBandsMT(BandFunc func, void* data, int w, int h, uint32_t threshold, int minRows);
+
 //! @}
 
 } // RasterUtil namespace
@@ -14,7 +14,9 @@
 #include <Fog/Core/Global/Private.h>
 #include <Fog/Core/Math/Math.h>
 #include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/Cpu.h>
 #include <Fog/Core/Tools/Swap.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
 #include <Fog/G2d/Painting/RasterScanline_p.h>
@@ -171,7 +173,15 @@ enum A8_ENUM
   A8_I32_COORD_LIMIT = 16384 << A8_SHIFT,
 
   A8_ALLOCATOR_SIZE = 16384 - 84,
-  A8_MAX_CHUNK_LENGTH = A8_ALLOCATOR_SIZE / (sizeof(PathRasterizer8::Cell) * 8)
+  A8_MAX_CHUNK_LENGTH = A8_ALLOCATOR_SIZE / (sizeof(PathRasterizer8::Cell) * 8),
+
+  // Maximum count of cells in the dense storage - shape up to 256x256 pixels,
+  // including cells at the right and bottom edge.
+  A8_DENSE_MAX_CELLS = 257 * 257,
+
+  // Count of cells reserved for the chunk header at the start of each dense
+  // row.
+  A8_DENSE_HEADER = (sizeof(PathRasterizer8::Chunk) - 1) / sizeof(PathRasterizer8::Cell)
 };
 
 enum CELL_OP
@@ -780,6 +790,11 @@ PathRasterizer8::PathRasterizer8() :
   _rowsStorage = NULL;
   _rowsAdjusted = NULL;
 
+  // Clear dense storage.
+  _denseBox.reset();
+  _denseCapacity = 0;
+  _denseStorage = NULL;
+
   reset();
 }
 
@@ -787,14 +802,26 @@ PathRasterizer8::~PathRasterizer8()
 {
   if (_rowsStorage != NULL)
     MemMgr::free(_rowsStorage);
+
+  if (_denseStorage != NULL)
+    MemMgr::free(_denseStorage);
 }
 
 // ============================================================================
 // [Fog::PathRasterizer8 - Helpers]
 // ============================================================================
 
+template<typename FixedT, int _DENSE>
+static bool PathRasterizer8_renderLineT(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1);
+
 template<typename FixedT>
-static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1);
+static FOG_INLINE bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1)
+{
+  if (self->_isDense)
+    return PathRasterizer8_renderLineT<FixedT, 1>(self, x0, y0, x1, y1);
+  else
+    return PathRasterizer8_renderLineT<FixedT, 0>(self, x0, y0, x1, y1);
+}
 
 // ============================================================================
 // [Fog::PathRasterizer8 - Reset]
@@ -816,6 +843,7 @@ void PathRasterizer8::reset()
   // Not valid neither finalized.
   _isValid = false;
   _isFinalized = false;
+  _isDense = false;
 }
 
 // ============================================================================
@@ -830,6 +858,7 @@ err_t PathRasterizer8::init()
   _error = ERR_OK;
   _isValid = false;
   _isFinalized = false;
+  _isDense = false;
 
   _sceneBox24x8.setBox(_sceneBox.x0 << 8, _sceneBox.y0 << 8, _sceneBox.x1 << 8, _sceneBox.y1 << 8);
 
@@ -859,6 +888,163 @@ err_t PathRasterizer8::init()
   return _error;
 }
 
+// ============================================================================
+// [Fog::PathRasterizer8 - Dense Storage]
+// ============================================================================
+
+// Convert the dense rows into chunks, called when a shape which doesn't fit
+// into the dense storage is added.
+static bool PathRasterizer8_spillDense(PathRasterizer8* self)
+{
+  FOG_ASSERT(self->_isDense);
+  self->_isDense = false;
+
+  if (self->_boundingBox.y0 == -1)
+    return true;
+
+  PathRasterizer8::Row* rows = self->_rowsAdjusted;
+
+  int y = self->_boundingBox.y0;
+  int yEnd = self->_boundingBox.y1 + 1;
+
+  do {
+    PathRasterizer8::Cell* cells = rows[y].cells;
+    PathRasterizer8::Chunk* first = NULL;
+
+    // Bounding-box is not normalized yet, cells at x1 can be used.
+    int x = self->_boundingBox.x0;
+    int xEnd = self->_boundingBox.x1 + 1;
+
+    while (x < xEnd && (cells[x].cover | cells[x].area) == 0)
+      x++;
+
+    while (xEnd > x && (cells[xEnd - 1].cover | cells[xEnd - 1].area) == 0)
+      xEnd--;
+
+    while (x < xEnd)
+    {
+      int length = Math::min<int>(xEnd - x, A8_MAX_CHUNK_LENGTH);
+
+      PathRasterizer8::Chunk* chunk = static_cast<PathRasterizer8::Chunk*>(
+        self->_allocator.alloc(PathRasterizer8::Chunk::getSizeOf(length)));
+
+      if (FOG_IS_NULL(chunk))
+      {
+        self->setError(ERR_RT_OUT_OF_MEMORY);
+        return false;
+      }
+
+      chunk->x0 = x;
+      chunk->x1 = x + length;
+      MemOps::copy(chunk->cells, &cells[x], length * sizeof(PathRasterizer8::Cell));
+
+      if (first == NULL)
+      {
+        chunk->prev = chunk;
+        chunk->next = chunk;
+        first = chunk;
+      }
+      else
+      {
+        PathRasterizer8::Chunk* last = first->prev;
+
+        chunk->prev = last;
+        chunk->next = first;
+
+        last->next = chunk;
+        first->prev = chunk;
+      }
+
+      x += length;
+    }
+
+    rows[y].first = first;
+  } while (++y != yEnd);
+
+  return true;
+}
+
+// Select the storage for a shape which is going to be added. The dense storage
+// is used if the convex hull of vertices of the first shape is small enough.
+// The hull is calculated in the same way as the vertices are converted in
+// PathRasterizer8_addPathData() so the cells never fall outside of it (curves
+// are flattened by subdividing their control polygon).
+template<typename SrcT>
+static bool PathRasterizer8_prepareDense(PathRasterizer8* self,
+  const SrcT_(Point)* srcPts, const uint8_t* srcCmd, size_t count, const SrcT_(Point)& offset)
+{
+  int minX = INT_MAX, minY = INT_MAX;
+  int maxX = INT_MIN, maxY = INT_MIN;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!PathCmd::isVertex(srcCmd[i]))
+      continue;
+
+    int x = Math::bound<Fixed24x8>(upscale24x8(srcPts[i].x + offset.x), self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
+    int y = Math::bound<Fixed24x8>(upscale24x8(srcPts[i].y + offset.y), self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+
+    if (x < minX) minX = x;
+    if (x > maxX) maxX = x;
+    if (y < minY) minY = y;
+    if (y > maxY) maxY = y;
+  }
+
+  if (minX > maxX)
+    return true;
+
+  BoxI box(minX >> A8_SHIFT, minY >> A8_SHIFT, (maxX >> A8_SHIFT) + 1, (maxY >> A8_SHIFT) + 1);
+
+  if (self->_isDense)
+  {
+    if (self->_denseBox.subsumes(box))
+      return true;
+    else
+      return PathRasterizer8_spillDense(self);
+  }
+
+  uint w = (uint)box.getWidth();
+  uint h = (uint)box.getHeight();
+
+  if ((uint64_t)w * h > A8_DENSE_MAX_CELLS)
+    return true;
+
+  size_t stride = A8_DENSE_HEADER + w;
+  size_t capacity = stride * h;
+
+  if (self->_denseCapacity < capacity)
+  {
+    if (self->_denseStorage != NULL)
+      MemMgr::free(self->_denseStorage);
+
+    // Align the capacity to 4096 cells so the storage isn't reallocated often.
+    size_t newCapacity = (capacity + 4095) & ~(size_t)4095;
+
+    self->_denseStorage = reinterpret_cast<PathRasterizer8::Cell*>(
+      MemMgr::alloc(newCapacity * sizeof(PathRasterizer8::Cell)));
+    self->_denseCapacity = newCapacity;
+
+    // Not an error, the chunks will be used instead.
+    if (self->_denseStorage == NULL)
+    {
+      self->_denseCapacity = 0;
+      return true;
+    }
+  }
+
+  MemOps::zero(self->_denseStorage, capacity * sizeof(PathRasterizer8::Cell));
+
+  PathRasterizer8::Row* rows = self->_rowsAdjusted;
+  PathRasterizer8::Cell* cells = self->_denseStorage + A8_DENSE_HEADER - box.x0;
+
+  for (int y = box.y0; y < box.y1; y++, cells += stride)
+    rows[y].cells = cells;
+
+  self->_denseBox = box;
+  self->_isDense = true;
+  return true;
+}
+
 // ============================================================================
 // [Fog::PathRasterizer8 - AddPath]
 // ============================================================================
@@ -870,6 +1056,13 @@ static void PathRasterizer8_addPathData(PathRasterizer8* self,
   if (count == 0)
     return;
 
+  // The storage is selected by the first shape.
+  if (self->_boundingBox.y0 == -1 || self->_isDense)
+  {
+    if (!PathRasterizer8_prepareDense<SrcT>(self, srcPts, srcCmd, count, offset))
+      return;
+  }
+
   const uint8_t* srcEnd = srcCmd + count;
 
   // Current/Start moveTo x position.
@@ -1283,10 +1476,10 @@ void PathRasterizer8::addBox(const BoxD& box)
   FOG_MACRO_END
 
 // ============================================================================
-// [Fog::PathRasterizer8 - ROW_ADD_ONE]
+// [Fog::PathRasterizer8 - CHUNK_ADD_ONE]
 // ============================================================================
 
-#define ROW_ADD_ONE(_Name_, _Row_, _X_, _Cover_, _Area_) \
+#define CHUNK_ADD_ONE(_Name_, _Row_, _X_, _Cover_, _Area_) \
   FOG_MACRO_BEGIN \
     PathRasterizer8::Chunk* _chunk = _Row_->first; \
     PathRasterizer8::Chunk* _cNew; \
@@ -1391,10 +1584,10 @@ _Name_##_Add_One_End: \
   FOG_MACRO_END \
 
 // ============================================================================
-// [Fog::PathRasterizer8 - ROW_ADD_TWO]
+// [Fog::PathRasterizer8 - CHUNK_ADD_TWO]
 // ============================================================================
 
-#define ROW_ADD_TWO(_Name_, _Row_, _X_, _Cover_, _Area_, _Advance_) \
+#define CHUNK_ADD_TWO(_Name_, _Row_, _X_, _Cover_, _Area_, _Advance_) \
   FOG_MACRO_BEGIN \
     PathRasterizer8::Chunk* _chunk = _Row_->first; \
     PathRasterizer8::Chunk* _cNew; \
@@ -1562,10 +1755,10 @@ _Name_##_Add_Two_End: \
   FOG_MACRO_END
 
 // ============================================================================
-// [Fog::PathRasterizer8 - ROW_ADD_N]
+// [Fog::PathRasterizer8 - CHUNK_ADD_N]
 // ============================================================================
 
-#define ROW_ADD_N(_Name_, _Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_) \
+#define CHUNK_ADD_N(_Name_, _Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_) \
   FOG_MACRO_BEGIN \
     PathRasterizer8::Chunk* _cFirst = _Row_->first; \
     PathRasterizer8::Chunk* _cLast = NULL; \
@@ -1869,8 +2062,108 @@ _Name_##_Add_N_Fill: \
     } \
   FOG_MACRO_END
 
-template<typename FixedT>
-static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1)
+// ============================================================================
+// [Fog::PathRasterizer8 - DENSE_ADD_ONE / DENSE_ADD_TWO / DENSE_ADD_N]
+// ============================================================================
+
+// The dense storage is zeroed, there is no difference between copy and merge.
+
+#define DENSE_ADD_ONE(_Row_, _X_, _Cover_, _Area_) \
+  FOG_MACRO_BEGIN \
+    FOG_ASSERT(_X_ >= self->_denseBox.x0 && _X_ < self->_denseBox.x1); \
+    \
+    LOG_CELL("Add_One", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+    _Row_->cells[_X_].add(_Cover_, _Area_); \
+  FOG_MACRO_END
+
+#define DENSE_ADD_TWO(_Row_, _X_, _Cover_, _Area_, _Advance_) \
+  FOG_MACRO_BEGIN \
+    FOG_ASSERT(_X_ >= self->_denseBox.x0 && _X_ + 1 < self->_denseBox.x1); \
+    \
+    LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+    _Row_->cells[_X_].add(_Cover_, _Area_); \
+    \
+    _Advance_ \
+    \
+    LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+    _Row_->cells[_X_].add(_Cover_, _Area_); \
+  FOG_MACRO_END
+
+#define DENSE_ADD_N(_Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_) \
+  FOG_MACRO_BEGIN \
+    FOG_ASSERT(_X0_ >= self->_denseBox.x0 && _X1_ <= self->_denseBox.x1); \
+    \
+    PathRasterizer8::Cell* _cell = &_Row_->cells[_X0_]; \
+    int _stop = _X1_ - 1; \
+    \
+    if ((_cellOp & CELL_OP_NEGATIVE) == 0) \
+    { \
+      while (_X0_ != _stop) \
+      { \
+        LOG_CELL("Add_N", _X0_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+        _cell->add(_Cover_, _Area_); \
+        _cell++; \
+        \
+        _Advance_ \
+        _X0_++; \
+      } \
+      \
+      _Last_ \
+      \
+      LOG_CELL("Add_N", _X0_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+      _cell->add(_Cover_, _Area_); \
+    } \
+    else \
+    { \
+      while (_X0_ != _stop) \
+      { \
+        LOG_CELL("Add_N", _X0_, (int)(_Row_ - self->_rowsAdjusted), -(_Cover_), -(_Area_)); \
+        _cell->sub(_Cover_, _Area_); \
+        _cell++; \
+        \
+        _Advance_ \
+        _X0_++; \
+      } \
+      \
+      _Last_ \
+      \
+      LOG_CELL("Add_N", _X0_, (int)(_Row_ - self->_rowsAdjusted), -(_Cover_), -(_Area_)); \
+      _cell->sub(_Cover_, _Area_); \
+    } \
+  FOG_MACRO_END
+
+// ============================================================================
+// [Fog::PathRasterizer8 - ROW_ADD_ONE / ROW_ADD_TWO / ROW_ADD_N]
+// ============================================================================
+
+// Used by PathRasterizer8_renderLineT(), _DENSE is its template parameter.
+
+#define ROW_ADD_ONE(_Name_, _Row_, _X_, _Cover_, _Area_) \
+  FOG_MACRO_BEGIN \
+    if (_DENSE) \
+      DENSE_ADD_ONE(_Row_, _X_, _Cover_, _Area_); \
+    else \
+      CHUNK_ADD_ONE(_Name_, _Row_, _X_, _Cover_, _Area_); \
+  FOG_MACRO_END
+
+#define ROW_ADD_TWO(_Name_, _Row_, _X_, _Cover_, _Area_, _Advance_) \
+  FOG_MACRO_BEGIN \
+    if (_DENSE) \
+      DENSE_ADD_TWO(_Row_, _X_, _Cover_, _Area_, _Advance_); \
+    else \
+      CHUNK_ADD_TWO(_Name_, _Row_, _X_, _Cover_, _Area_, _Advance_); \
+  FOG_MACRO_END
+
+#define ROW_ADD_N(_Name_, _Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_) \
+  FOG_MACRO_BEGIN \
+    if (_DENSE) \
+      DENSE_ADD_N(_Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_); \
+    else \
+      CHUNK_ADD_N(_Name_, _Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_); \
+  FOG_MACRO_END
+
+template<typename FixedT, int _DENSE>
+static bool PathRasterizer8_renderLineT(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1)
 {
   // --------------------------------------------------------------------------
   // [Prepare]
@@ -1897,7 +2190,7 @@ static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT
   // only when drawing to a screen where one or both dimensions is larger than
   // 16384 pixels.
   if (sizeof(FixedT) < sizeof(int64_t) && (dx >= FixedT(A8_I32_COORD_LIMIT) || dy >= FixedT(A8_I32_COORD_LIMIT)))
-    return PathRasterizer8_renderLine<int64_t>(self, int64_t(x0), int64_t(y0), int64_t(x1), int64_t(y1));
+    return PathRasterizer8_renderLineT<int64_t, _DENSE>(self, int64_t(x0), int64_t(y0), int64_t(x1), int64_t(y1));
 
   int rInc = 1;
   int coverSign = 1;
@@ -1974,13 +2267,16 @@ static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT
       self->_boundingBox.x1 = ex1;
       self->_boundingBox.y1 = by1;
 
-      // Initialize the rows.
-      for (;;)
+      // Initialize the rows (dense rows are already initialized).
+      if (!_DENSE)
       {
-        rPtr[by0].first = NULL;
-        if (by0 == by1)
-          break;
-        by0++;
+        for (;;)
+        {
+          rPtr[by0].first = NULL;
+          if (by0 == by1)
+            break;
+          by0++;
+        }
       }
     }
     else
@@ -1996,18 +2292,24 @@ static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT
       if (by0 < bEnd)
       {
         self->_boundingBox.y0 = by0;
-        do {
-          rPtr[by0++].first = NULL;
-        } while (by0 != bEnd);
+        if (!_DENSE)
+        {
+          do {
+            rPtr[by0++].first = NULL;
+          } while (by0 != bEnd);
+        }
       }
 
       bEnd = self->_boundingBox.y1;
       if (by1 > bEnd)
       {
         self->_boundingBox.y1 = by1;
-        do {
-          rPtr[++bEnd].first = NULL;
-        } while (by1 != bEnd);
+        if (!_DENSE)
+        {
+          do {
+            rPtr[++bEnd].first = NULL;
+          } while (by1 != bEnd);
+        }
       }
     }
   }
@@ -3065,10 +3367,173 @@ static void FOG_CDECL PathRasterizer8_render_st_clip_mask(
   PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
 }
 
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Dense]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_FASTCALL PathRasterizer8_resolveDense(const PathRasterizer8* self, uint8_t* mask, int y)
+{
+  const PathRasterizer8::Chunk* chunk = self->_rowsAdjusted[y].first;
+  const PathRasterizer8::Cell* cell = chunk->cells;
+
+  uint i = static_cast<uint>(chunk->getLength());
+  int cover = 0;
+
+  do {
+    cover += cell->cover;
+    uint32_t alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover - (cell->area >> A8_SHIFT_2));
+
+    Acc::p32Store2a(mask, alpha);
+    mask += 2;
+
+    cell++;
+  } while (--i);
+}
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_CDECL PathRasterizer8_render_dense_st_clip_box(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
+  FOG_ASSERT(self->_isFinalized);
+  FOG_ASSERT(self->_isDense);
+
+  int x0 = self->_boundingBox.x0;
+  int w = self->_boundingBox.getWidth();
+
+  int y0 = self->_boundingBox.y0;
+  int y1 = self->_boundingBox.y1;
+
+  RasterizerApi::PathRasterizer8_ResolveDense resolve = (_RULE == FILL_RULE_NON_ZERO)
+    ? Rasterizer_api.path8.resolve_dense_nonzero[_USE_ALPHA]
+    : Rasterizer_api.path8.resolve_dense_evenodd[_USE_ALPHA];
+
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
+
+  if (FOG_IS_ERROR(scanline->prepare(w * 2)))
+    return;
+
+  filler->prepare(y0);
+
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
+
+  for (;;)
+  {
+    // ------------------------------------------------------------------------
+    // [Resolve]
+    // ------------------------------------------------------------------------
+
+    uint8_t* mask = scanline->getMask();
+    resolve(self, mask, y0);
+
+    // ------------------------------------------------------------------------
+    // [Fetch]
+    // ------------------------------------------------------------------------
+
+    // Runs of zero alpha are skipped, long runs of the same alpha are turned
+    // into const-mask spans and the rest is referenced by AX-Extra spans.
+    const uint16_t* alphas = reinterpret_cast<const uint16_t*>(mask);
+    RasterSpan8* span = scanline->begin();
+
+    int i = 0;
+    int axEnd = -1;
+
+    do {
+      uint32_t alpha = alphas[i];
+      int j = i + 1;
+
+      while (j < w && alphas[j] == alpha)
+        j++;
+
+      if (alpha != 0)
+      {
+        if (j - i > RASTER_SPAN_C_THRESHOLD)
+        {
+          NEW_SPAN(span, return);
+          span->setPositionAndType(x0 + i, x0 + j, RASTER_SPAN_C);
+          span->setConstMask(alpha);
+          axEnd = -1;
+        }
+        else
+        {
+          // Link to the previous span if possible.
+          if (axEnd != i)
+          {
+            NEW_SPAN(span, return);
+            span->setX0AndType(x0 + i, RASTER_SPAN_AX_EXTRA);
+            span->setVariantMask(mask + i * 2);
+          }
+
+          span->setX1(x0 + j);
+          axEnd = j;
+        }
+      }
+
+      i = j;
+    } while (i < w);
+
+    span = scanline->end(span);
+
+    // ------------------------------------------------------------------------
+    // [Fill / Skip]
+    // ------------------------------------------------------------------------
+
+    if (FOG_IS_NULL(span))
+    {
+      filler->skip(1);
+    }
+    else
+    {
+#if defined(FOG_DEBUG_RASTERIZER)
+      Rasterizer_dumpSpans(y0, scanline->getSpans());
+#endif // FOG_DEBUG_RASTERIZER
+      filler->process(span);
+    }
+
+    if (++y0 >= y1)
+      return;
+  }
+}
+
 // ============================================================================
 // [Fog::PathRasterizer8 - Finalize]
 // ============================================================================
 
+// Make each dense row a single chunk starting at the bounding-box, so the dense
+// storage can be used by all render functions. The chunk header overwrites
+// cells before the bounding-box, which are not used (or the space reserved
+// at the start of the row).
+static void PathRasterizer8_finalizeDense(PathRasterizer8* self)
+{
+  PathRasterizer8::Row* rows = self->_rowsAdjusted;
+
+  int x0 = self->_boundingBox.x0;
+  int x1 = self->_boundingBox.x1;
+
+  int y = self->_boundingBox.y0;
+  int yEnd = self->_boundingBox.y1;
+
+  FOG_ASSERT(x0 >= self->_denseBox.x0 && x1 <= self->_denseBox.x1);
+  FOG_ASSERT(y >= self->_denseBox.y0 && yEnd <= self->_denseBox.y1);
+
+  do {
+    PathRasterizer8::Chunk* chunk = reinterpret_cast<PathRasterizer8::Chunk*>(
+      reinterpret_cast<uint8_t*>(&rows[y].cells[x0]) - (sizeof(PathRasterizer8::Chunk) - sizeof(PathRasterizer8::Cell)));
+
+    chunk->prev = chunk;
+    chunk->next = chunk;
+    chunk->x0 = x0;
+    chunk->x1 = x1;
+
+    rows[y].first = chunk;
+  } while (++y != yEnd);
+}
+
 err_t PathRasterizer8::finalize()
 {
   PathRasterizer8* self = this;
@@ -3100,11 +3565,24 @@ err_t PathRasterizer8::finalize()
               _boundingBox.y0 != _boundingBox.y1);
   _isFinalized = true;
 
+  if (_isDense && _isValid)
+    PathRasterizer8_finalizeDense(self);
+
   // Setup render method.
-  if (self->_fillRule == FILL_RULE_NON_ZERO)
-    self->_render = Rasterizer_api.path8.render_nonzero[self->_opacity != 0x100][self->_clipType];
+  if (_isDense && self->_clipType == RASTER_CLIP_BOX)
+  {
+    if (self->_fillRule == FILL_RULE_NON_ZERO)
+      self->_render = Rasterizer_api.path8.render_dense_nonzero[self->_opacity != 0x100];
+    else
+      self->_render = Rasterizer_api.path8.render_dense_evenodd[self->_opacity != 0x100];
+  }
   else
-    self->_render = Rasterizer_api.path8.render_evenodd[self->_opacity != 0x100][self->_clipType];
+  {
+    if (self->_fillRule == FILL_RULE_NON_ZERO)
+      self->_render = Rasterizer_api.path8.render_nonzero[self->_opacity != 0x100][self->_clipType];
+    else
+      self->_render = Rasterizer_api.path8.render_evenodd[self->_opacity != 0x100][self->_clipType];
+  }
   return ERR_OK;
 
 _NotValid:
@@ -3115,6 +3593,8 @@ _NotValid:
 #undef SETUP_FUNCS
 }
 
+FOG_CPU_DECLARE_INITIALIZER_SSE2( Rasterizer_init_SSE2(void) )
+
 FOG_NO_EXPORT void Rasterizer_init(void)
 {
   // --------------------------------------------------------------------------
@@ -3151,6 +3631,22 @@ FOG_NO_EXPORT void Rasterizer_init(void)
   Rasterizer_api.path8.render_evenodd[1][RASTER_CLIP_BOX   ] = PathRasterizer8_render_st_clip_box   <FILL_RULE_EVEN_ODD, 1>;
   Rasterizer_api.path8.render_evenodd[1][RASTER_CLIP_REGION] = PathRasterizer8_render_st_clip_region<FILL_RULE_EVEN_ODD, 1>;
   Rasterizer_api.path8.render_evenodd[1][RASTER_CLIP_MASK  ] = PathRasterizer8_render_st_clip_mask  <FILL_RULE_EVEN_ODD, 1>;
+
+  Rasterizer_api.path8.render_dense_nonzero[0] = PathRasterizer8_render_dense_st_clip_box<FILL_RULE_NON_ZERO, 0>;
+  Rasterizer_api.path8.render_dense_nonzero[1] = PathRasterizer8_render_dense_st_clip_box<FILL_RULE_NON_ZERO, 1>;
+  Rasterizer_api.path8.render_dense_evenodd[0] = PathRasterizer8_render_dense_st_clip_box<FILL_RULE_EVEN_ODD, 0>;
+  Rasterizer_api.path8.render_dense_evenodd[1] = PathRasterizer8_render_dense_st_clip_box<FILL_RULE_EVEN_ODD, 1>;
+
+  Rasterizer_api.path8.resolve_dense_nonzero[0] = PathRasterizer8_resolveDense<FILL_RULE_NON_ZERO, 0>;
+  Rasterizer_api.path8.resolve_dense_nonzero[1] = PathRasterizer8_resolveDense<FILL_RULE_NON_ZERO, 1>;
+  Rasterizer_api.path8.resolve_dense_evenodd[0] = PathRasterizer8_resolveDense<FILL_RULE_EVEN_ODD, 0>;
+  Rasterizer_api.path8.resolve_dense_evenodd[1] = PathRasterizer8_resolveDense<FILL_RULE_EVEN_ODD, 1>;
+
+  // --------------------------------------------------------------------------
+  // [Fog::PathRasterizer8 - CPU Based Optimizations]
+  // --------------------------------------------------------------------------
+
+  FOG_CPU_USE_INITIALIZER_SSE2( Rasterizer_init_SSE2() )
 }
 
 } // Fog namespace
@@ -0,0 +1,197 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Acc/AccC.h>
+#include <Fog/Core/Acc/AccSse2.h>
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/G2d/Painting/Rasterizer_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Constants]
+// ============================================================================
+
+FOG_XMM_DECLARE_CONST_PI32_SET(PathRasterizer8_511, 511);
+FOG_XMM_DECLARE_CONST_PI16_SET(PathRasterizer8_256, 256);
+FOG_XMM_DECLARE_CONST_PI16_SET(PathRasterizer8_512, 512);
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Dense]
+// ============================================================================
+
+// Scalar version used by the tail, the same as PathRasterizer8_calculateAlpha().
+template<int _RULE, int _USE_ALPHA>
+static FOG_INLINE uint32_t PathRasterizer8_calculateAlpha_SSE2(const PathRasterizer8* self, int cover)
+{
+  if (cover < 0) cover = -cover;
+
+  if (_RULE == FILL_RULE_NON_ZERO)
+  {
+    if (cover > 256)
+      cover = 256;
+  }
+  else
+  {
+    cover &= 511;
+    if (cover > 256)
+      cover = 512 - cover;
+  }
+
+  if (_USE_ALPHA)
+    cover = (cover * self->_opacity) >> 8;
+
+  return cover;
+}
+
+// Load four cells, the result is covers in dst0 and areas in dst1.
+static FOG_INLINE void PathRasterizer8_loadCells_SSE2(__m128i& dst0, __m128i& dst1, const PathRasterizer8::Cell* cell)
+{
+  __m128i t0;
+  __m128i t1;
+
+  Acc::m128iLoad16u(t0, cell + 0);
+  Acc::m128iLoad16u(t1, cell + 2);
+
+  // [c0 a0 c1 a1] [c2 a2 c3 a3] => [c0 c1 a0 a1] [c2 c3 a2 a3].
+  Acc::m128iShufflePI32<3, 1, 2, 0>(t0, t0);
+  Acc::m128iShufflePI32<3, 1, 2, 0>(t1, t1);
+
+  Acc::m128iUnpackSI128FromPI64Lo(dst0, t0, t1);
+  Acc::m128iUnpackSI128FromPI64Hi(dst1, t0, t1);
+}
+
+// Inclusive prefix sum of four covers, acc contains the cover accumulated so
+// far in all elements and is updated.
+static FOG_INLINE void PathRasterizer8_prefixSum_SSE2(__m128i& x0, __m128i& acc)
+{
+  __m128i t0;
+
+  Acc::m128iLShiftSU128<32>(t0, x0);
+  Acc::m128iAddPI32(x0, x0, t0);
+  Acc::m128iLShiftSU128<64>(t0, x0);
+  Acc::m128iAddPI32(x0, x0, t0);
+
+  Acc::m128iAddPI32(x0, x0, acc);
+  Acc::m128iShufflePI32<3, 3, 3, 3>(acc, x0);
+}
+
+// Absolute value of four 32-bit integers.
+static FOG_INLINE void PathRasterizer8_abs_SSE2(__m128i& x0)
+{
+  __m128i t0;
+
+  Acc::m128iRShiftPI32<31>(t0, x0);
+  Acc::m128iXor(x0, x0, t0);
+  Acc::m128iSubPI32(x0, x0, t0);
+}
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_FASTCALL PathRasterizer8_resolveDense_SSE2(const PathRasterizer8* self, uint8_t* mask, int y)
+{
+  const PathRasterizer8::Chunk* chunk = self->_rowsAdjusted[y].first;
+  const PathRasterizer8::Cell* cell = chunk->cells;
+
+  uint i = static_cast<uint>(chunk->getLength());
+
+  __m128i acc;
+  __m128i opacity;
+
+  Acc::m128iZero(acc);
+
+  if (_USE_ALPHA)
+  {
+    Acc::m128iCvtSI128FromSI(opacity, (int)self->_opacity);
+    Acc::m128iExpandPI16FromSI16(opacity, opacity);
+  }
+
+  while (i >= 8)
+  {
+    __m128i c0, a0;
+    __m128i c1, a1;
+
+    PathRasterizer8_loadCells_SSE2(c0, a0, cell + 0);
+    PathRasterizer8_loadCells_SSE2(c1, a1, cell + 4);
+
+    PathRasterizer8_prefixSum_SSE2(c0, acc);
+    PathRasterizer8_prefixSum_SSE2(c1, acc);
+
+    // cover - (area >> 9).
+    Acc::m128iRShiftPI32<9>(a0, a0);
+    Acc::m128iRShiftPI32<9>(a1, a1);
+
+    Acc::m128iSubPI32(c0, c0, a0);
+    Acc::m128iSubPI32(c1, c1, a1);
+
+    PathRasterizer8_abs_SSE2(c0);
+    PathRasterizer8_abs_SSE2(c1);
+
+    if (_RULE == FILL_RULE_NON_ZERO)
+    {
+      // Saturated pack keeps everything above 256 above 256.
+      Acc::m128iPackPI16FromPI32(c0, c0, c1);
+      Acc::m128iMinPI16(c0, c0, FOG_XMM_GET_CONST_PI(PathRasterizer8_256));
+    }
+    else
+    {
+      // min(c, 512 - c) is c if c <= 256, otherwise 512 - c.
+      Acc::m128iAnd(c0, c0, FOG_XMM_GET_CONST_PI(PathRasterizer8_511));
+      Acc::m128iAnd(c1, c1, FOG_XMM_GET_CONST_PI(PathRasterizer8_511));
+      Acc::m128iPackPI16FromPI32(c0, c0, c1);
+
+      Acc::m128iSubPI16(c1, FOG_XMM_GET_CONST_PI(PathRasterizer8_512), c0);
+      Acc::m128iMinPI16(c0, c0, c1);
+    }
+
+    // Opacity is below 256, the product fits into unsigned 16-bit integer.
+    if (_USE_ALPHA)
+    {
+      Acc::m128iMulLoPI16(c0, c0, opacity);
+      Acc::m128iRShiftPU16<8>(c0, c0);
+    }
+
+    Acc::m128iStore16u(mask, c0);
+    mask += 16;
+
+    cell += 8;
+    i -= 8;
+  }
+
+  if (i == 0)
+    return;
+
+  int cover;
+  Acc::m128iCvtSIFromSI128(cover, acc);
+
+  do {
+    cover += cell->cover;
+    uint32_t alpha = PathRasterizer8_calculateAlpha_SSE2<_RULE, _USE_ALPHA>(self, cover - (cell->area >> 9));
+
+    Acc::p32Store2a(mask, alpha);
+    mask += 2;
+
+    cell++;
+  } while (--i);
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void Rasterizer_init_SSE2(void)
+{
+  Rasterizer_api.path8.resolve_dense_nonzero[0] = PathRasterizer8_resolveDense_SSE2<FILL_RULE_NON_ZERO, 0>;
+  Rasterizer_api.path8.resolve_dense_nonzero[1] = PathRasterizer8_resolveDense_SSE2<FILL_RULE_NON_ZERO, 1>;
+  Rasterizer_api.path8.resolve_dense_evenodd[0] = PathRasterizer8_resolveDense_SSE2<FILL_RULE_EVEN_ODD, 0>;
+  Rasterizer_api.path8.resolve_dense_evenodd[1] = PathRasterizer8_resolveDense_SSE2<FILL_RULE_EVEN_ODD, 1>;
+}
+
+} // Fog namespace
@@ -54,10 +54,21 @@ struct FOG_NO_EXPORT RasterizerApi
   // [Path]
   // --------------------------------------------------------------------------
 
+  typedef void (FOG_FASTCALL *PathRasterizer8_ResolveDense)(const PathRasterizer8* self, uint8_t* mask, int y);
+
   struct _Api_PathRasterizer8
   {
     Render8Func render_nonzero[2][RASTER_CLIP_COUNT];
     Render8Func render_evenodd[2][RASTER_CLIP_COUNT];
+
+    //! @brief Render functions used when cells are in the dense storage and
+    //! the clip-type is @c RASTER_CLIP_BOX.
+    Render8Func render_dense_nonzero[2];
+    Render8Func render_dense_evenodd[2];
+
+    //! @brief Convert one row of the dense storage into the AX-Extra mask.
+    PathRasterizer8_ResolveDense resolve_dense_nonzero[2];
+    PathRasterizer8_ResolveDense resolve_dense_evenodd[2];
   } path8;
 };
 
@@ -405,6 +416,14 @@ struct FOG_NO_EXPORT BoxRasterizer8 : public Rasterizer8
 //! the new coverage and area is merged to the existing cell (that is, there
 //! are no overlapping cells in the final result).
 //!
+//! Small shapes (the convex hull of vertices of the first shape added fits
+//! into 256x256 pixels) are rasterized into the dense storage instead, where
+//! each row is a zeroed array of cells spanning the whole hull. Adding a cell
+//! is then only an indexed add, and a row is resolved into the mask by prefix
+//! sum of covers, which is vectorized when SSE2 is available. If a shape that
+//! doesn't fit into the dense storage is added later, the dense rows are
+//! converted into chunks and the rasterizer continues as usual.
+//!
 //! The analytic rasterizer idea and first implementation was based on the AGG,
 //! which was based on the freetype2 library. Although there is motivation the
 //! rasterizer was rewritten to use different algorithm to render-line/hline
@@ -519,11 +538,19 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
 
   struct FOG_NO_EXPORT Row
   {
-    //! @brief First chunk in this row (sorted from left).
-    //!
-    //! @note The chunk list is circular, thus chunk->prev can be used to
-    //! access the last chunk.
-    Chunk* first;
+    union
+    {
+      //! @brief First chunk in this row (sorted from left).
+      //!
+      //! @note The chunk list is circular, thus chunk->prev can be used to
+      //! access the last chunk.
+      Chunk* first;
+
+      //! @brief Cells of this row in the dense storage, adjusted so the
+      //! index matches the position in the raster (only used until the
+      //! rasterizer is finalized).
+      Cell* cells;
+    };
   };
 
   // --------------------------------------------------------------------------
@@ -617,6 +644,13 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   //! @internal
   bool getNextChunkStorage(size_t chunkSize);
 
+  // --------------------------------------------------------------------------
+  // [Dense Storage]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get whether the cells are in the dense storage.
+  FOG_INLINE uint8_t isDense() const { return _isDense; }
+
   // --------------------------------------------------------------------------
   // [Finalize]
   // --------------------------------------------------------------------------
@@ -652,6 +686,8 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   uint8_t _isValid;
   //! @brief Whether the rasterizer was finalized.
   uint8_t _isFinalized;
+  //! @brief Whether the cells are in the dense storage.
+  uint8_t _isDense;
 
   //! @brief Rows array capacity.
   //!
@@ -673,6 +709,18 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   //! subtracting @c _sceneBox.y0 from @c _rowsStorage.
   Row* _rowsAdjusted;
 
+  //! @brief Box of the dense storage (cells, x1/y1 coordinates are outside).
+  BoxI _denseBox;
+
+  //! @brief Dense storage capacity (in cells).
+  size_t _denseCapacity;
+
+  //! @brief Dense storage.
+  //!
+  //! Each row starts with a space for @c Chunk header, which is used to make
+  //! the row a single chunk when the rasterizer is finalized.
+  Cell* _denseStorage;
+
 private:
   FOG_NO_COPY(PathRasterizer8)
 };
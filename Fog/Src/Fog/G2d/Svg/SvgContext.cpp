@@ -5,6 +5,9 @@
 
 // [Dependencies]
 #include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Tools/HashUtil.h>
 #include <Fog/G2d/Geometry/PathStroker.h>
 #include <Fog/G2d/Geometry/PathTmp_p.h>
 #include <Fog/G2d/Svg/SvgContext.h>
@@ -12,6 +15,242 @@
 
 namespace Fog {
 
+// ============================================================================
+// [Fog::SvgComputedStyle - Helpers]
+// ============================================================================
+
+static FOG_INLINE uint32_t SvgComputedStyle_hashFloat(float f)
+{
+  union { float f; uint32_t u; } u;
+  u.f = f;
+  return u.u;
+}
+
+static FOG_INLINE uint32_t SvgComputedStyle_hashSource(const SvgContextSource& source)
+{
+  return HashUtil::combine(source.type,
+    SvgComputedStyle_hashFloat(source.opacity),
+    HashUtil::hashPtr(source.uriRef),
+    source.color.getPacked32());
+}
+
+static FOG_INLINE bool SvgComputedStyle_eqSource(const SvgContextSource& a, const SvgContextSource& b)
+{
+  return a.type    == b.type    &&
+         a.opacity == b.opacity &&
+         a.uriRef  == b.uriRef  &&
+         a.color   == b.color   ;
+}
+
+static FOG_INLINE bool SvgComputedStyle_eqStrokeParams(const PathStrokerParamsF& a, const PathStrokerParamsF& b)
+{
+  return a.getLineWidth()  == b.getLineWidth()  &&
+         a.getMiterLimit() == b.getMiterLimit() &&
+         a.getDashOffset() == b.getDashOffset() &&
+         a.getHints()      == b.getHints()      &&
+         a.getDashList()   == b.getDashList()   ;
+}
+
+// ============================================================================
+// [Fog::SvgComputedStyle - Construction / Destruction]
+// ============================================================================
+
+SvgComputedStyle::SvgComputedStyle() :
+  _reference(1),
+  _hashCode(0),
+  _hasUri(false),
+  _hashNext(NULL),
+  _compOp(COMPOSITE_SRC_OVER),
+  _fillRule(FILL_RULE_EVEN_ODD),
+  _opacity(1.0f),
+  _filter(NULL)
+{
+}
+
+SvgComputedStyle::~SvgComputedStyle()
+{
+}
+
+// ============================================================================
+// [Fog::SvgComputedStyle - Methods]
+// ============================================================================
+
+void SvgComputedStyle::init(const SvgContext* context)
+{
+  _fillSource = context->_fillSource;
+  _strokeSource = context->_strokeSource;
+  _strokeParams = context->_strokeParams;
+  _font = context->_font;
+
+  _compOp = context->_compOp;
+  _fillRule = context->_fillRule;
+  _opacity = context->_opacity;
+  _filter = context->_filter;
+
+  _hasUri = _fillSource.type == SVG_SOURCE_URI ||
+            _strokeSource.type == SVG_SOURCE_URI ||
+            _filter != NULL;
+
+  _hashCode = HashUtil::combine(
+    SvgComputedStyle_hashSource(_fillSource),
+    SvgComputedStyle_hashSource(_strokeSource),
+    SvgComputedStyle_hashFloat(_strokeParams.getLineWidth()),
+    _strokeParams.getHints(),
+    _font.getFamily().getHashCode(),
+    SvgComputedStyle_hashFloat(_font.getSize()),
+    (_compOp << 8) | _fillRule,
+    SvgComputedStyle_hashFloat(_opacity),
+    HashUtil::hashPtr(_filter));
+}
+
+bool SvgComputedStyle::eq(const SvgComputedStyle* other) const
+{
+  return _hashCode == other->_hashCode &&
+         _compOp   == other->_compOp   &&
+         _fillRule == other->_fillRule &&
+         _opacity  == other->_opacity  &&
+         _filter   == other->_filter   &&
+         SvgComputedStyle_eqSource(_fillSource, other->_fillSource) &&
+         SvgComputedStyle_eqSource(_strokeSource, other->_strokeSource) &&
+         SvgComputedStyle_eqStrokeParams(_strokeParams, other->_strokeParams) &&
+         _font == other->_font;
+}
+
+// ============================================================================
+// [Fog::SvgComputedStyleCache - Construction / Destruction]
+// ============================================================================
+
+SvgComputedStyleCache::SvgComputedStyleCache() :
+  _buckets(NULL),
+  _capacity(0),
+  _length(0),
+  _purgeLength(256)
+{
+}
+
+SvgComputedStyleCache::~SvgComputedStyleCache()
+{
+  // Styles still referenced by elements are released by them.
+  for (size_t i = 0; i < _capacity; i++)
+  {
+    SvgComputedStyle* style = _buckets[i];
+    while (style != NULL)
+    {
+      SvgComputedStyle* next = style->_hashNext;
+      style->_hashNext = NULL;
+      style->release();
+      style = next;
+    }
+  }
+
+  if (_buckets != NULL)
+    MemMgr::free(_buckets);
+}
+
+// ============================================================================
+// [Fog::SvgComputedStyleCache - Methods]
+// ============================================================================
+
+const SvgComputedStyle* SvgComputedStyleCache::intern(const SvgContext* context)
+{
+  SvgComputedStyle* style = fog_new SvgComputedStyle();
+  if (FOG_IS_NULL(style))
+    return NULL;
+
+  style->init(context);
+
+  if (_capacity != 0)
+  {
+    SvgComputedStyle* node = _buckets[style->_hashCode & (_capacity - 1)];
+    while (node != NULL)
+    {
+      if (node->eq(style))
+      {
+        style->release();
+        return node->addRef();
+      }
+      node = node->_hashNext;
+    }
+  }
+
+  if (_length >= _purgeLength)
+  {
+    purge();
+    _purgeLength = Math::max<size_t>(_length * 2, 256);
+  }
+
+  if (_length >= _capacity)
+  {
+    _rehash(_capacity != 0 ? _capacity * 2 : 64);
+    if (_length >= _capacity)
+      return style;
+  }
+
+  // The cache keeps one reference, the second one is returned.
+  size_t index = style->_hashCode & (_capacity - 1);
+  style->_hashNext = _buckets[index];
+  _buckets[index] = style;
+  _length++;
+
+  return style->addRef();
+}
+
+void SvgComputedStyleCache::purge()
+{
+  for (size_t i = 0; i < _capacity; i++)
+  {
+    SvgComputedStyle** pPrev = &_buckets[i];
+    SvgComputedStyle* node = *pPrev;
+
+    while (node != NULL)
+    {
+      SvgComputedStyle* next = node->_hashNext;
+
+      if (node->_reference == 1)
+      {
+        *pPrev = next;
+        node->release();
+        _length--;
+      }
+      else
+      {
+        pPrev = &node->_hashNext;
+      }
+
+      node = next;
+    }
+  }
+}
+
+void SvgComputedStyleCache::_rehash(size_t capacity)
+{
+  SvgComputedStyle** buckets = static_cast<SvgComputedStyle**>(
+    MemMgr::calloc(capacity * sizeof(SvgComputedStyle*)));
+
+  if (FOG_IS_NULL(buckets))
+    return;
+
+  for (size_t i = 0; i < _capacity; i++)
+  {
+    SvgComputedStyle* node = _buckets[i];
+    while (node != NULL)
+    {
+      SvgComputedStyle* next = node->_hashNext;
+      size_t index = node->_hashCode & (capacity - 1);
+
+      node->_hashNext = buckets[index];
+      buckets[index] = node;
+      node = next;
+    }
+  }
+
+  if (_buckets != NULL)
+    MemMgr::free(_buckets);
+
+  _buckets = buckets;
+  _capacity = capacity;
+}
+
 // ============================================================================
 // [Fog::SvgContext - Construction / Destruction]
 // ============================================================================
@@ -29,6 +268,8 @@ SvgContext::SvgContext(SvgContextExtension* contextExtension)
   _fillRule = FILL_RULE_EVEN_ODD;
   _unused = 0;
   _opacity = 1.0f;
+  _filter = NULL;
+  _computedStyle = NULL;
 
   _textCursor.reset();
 
@@ -182,6 +423,24 @@ static FOG_INLINE void SvgRenderContext_setupStroke(SvgRenderContext* context, S
   context->_painter->setStrokeParams(context->_strokeParams);
 }
 
+err_t SvgRenderContext::onVisit(SvgElement* obj)
+{
+  SvgContextGState state(this);
+
+  FOG_RETURN_ON_ERROR(obj->onPrepare(this, &state));
+
+  // Filter applies only to the element which referenced it, the content is
+  // rendered by the filter into its SourceGraphic buffer.
+  const SvgFilterElement* filter = _filter;
+  if (filter != NULL)
+  {
+    _filter = NULL;
+    return filter->_render(this, obj);
+  }
+
+  return obj->onProcess(this);
+}
+
 err_t SvgRenderContext::onShape(SvgElement* obj, const ShapeF& shape)
 {
   bool canFill   = shape.isClosed() && 
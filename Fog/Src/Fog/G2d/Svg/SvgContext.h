@@ -91,6 +91,129 @@ struct FOG_NO_EXPORT SvgContextSource
   Argb32 color;
 };
 
+// ============================================================================
+// [Fog::SvgComputedStyle]
+// ============================================================================
+
+//! @brief Computed style of SVG element - the inheritable context state after
+//! the element styles were resolved and applied.
+//!
+//! Computed styles are interned by @ref SvgComputedStyleCache, elements with
+//! the same computed style share the instance. The pointer therefore fully
+//! identifies the state inherited by children, which can reuse their own
+//! computed style while their parent keeps the same one.
+struct FOG_NO_EXPORT SvgComputedStyle
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgComputedStyle();
+  ~SvgComputedStyle();
+
+  // --------------------------------------------------------------------------
+  // [AddRef / Release]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const SvgComputedStyle* addRef() const
+  {
+    _reference++;
+    return this;
+  }
+
+  FOG_INLINE void release() const
+  {
+    if (--_reference == 0)
+      fog_delete(const_cast<SvgComputedStyle*>(this));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Capture the state of @a context.
+  void init(const SvgContext* context);
+
+  bool eq(const SvgComputedStyle* other) const;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reference count.
+  mutable size_t _reference;
+  //! @brief Hash code.
+  uint32_t _hashCode;
+  //! @brief Whether fill, stroke or filter were resolved from URI, these
+  //! depend on the whole document and not only on the element's ancestors.
+  uint32_t _hasUri;
+  //! @brief Next style in the same @ref SvgComputedStyleCache bucket.
+  SvgComputedStyle* _hashNext;
+
+  SvgContextSource _fillSource;
+  SvgContextSource _strokeSource;
+  PathStrokerParamsF _strokeParams;
+  Font _font;
+
+  uint32_t _compOp;
+  uint32_t _fillRule;
+  float _opacity;
+  const SvgFilterElement* _filter;
+
+private:
+  FOG_NO_COPY(SvgComputedStyle)
+};
+
+// ============================================================================
+// [Fog::SvgComputedStyleCache]
+// ============================================================================
+
+//! @brief Table of interned @ref SvgComputedStyle instances (per document).
+//!
+//! The table holds a reference of each style; styles not referenced by any
+//! element anymore are purged when the table grows.
+struct FOG_NO_EXPORT SvgComputedStyleCache
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgComputedStyleCache();
+  ~SvgComputedStyleCache();
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE size_t getLength() const { return _length; }
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get computed style matching the state of @a context, the returned
+  //! style is referenced (caller must release it).
+  const SvgComputedStyle* intern(const SvgContext* context);
+
+  //! @brief Release styles which are only referenced by the cache.
+  void purge();
+
+  void _rehash(size_t capacity);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  SvgComputedStyle** _buckets;
+  size_t _capacity;
+  size_t _length;
+  //! @brief Length at which the unused styles are purged.
+  size_t _purgeLength;
+
+private:
+  FOG_NO_COPY(SvgComputedStyleCache)
+};
+
 // ============================================================================
 // [Fog::SvgContext]
 // ============================================================================
@@ -162,6 +285,9 @@ struct FOG_API SvgContext
   FOG_INLINE float getOpacity() const { return _opacity; }
   FOG_INLINE void setOpacity(float opacity) { _opacity = opacity; }
 
+  FOG_INLINE const SvgFilterElement* getFilter() const { return _filter; }
+  FOG_INLINE void setFilter(const SvgFilterElement* filter) { _filter = filter; }
+
   // --------------------------------------------------------------------------
   // [Fill Parameters]
   // --------------------------------------------------------------------------
@@ -292,6 +418,12 @@ struct FOG_API SvgContext
   uint32_t _unused : 16;
   float _opacity;
 
+  //! @brief Filter applied to the element being visited (not inherited).
+  const SvgFilterElement* _filter;
+  //! @brief Computed style matching the current state, NULL if the state is
+  //! the initial one.
+  const SvgComputedStyle* _computedStyle;
+
   PointF _textCursor;
   Font _font;
 
@@ -328,6 +460,8 @@ struct FOG_NO_EXPORT SvgContextGState
   {
     _compOp = _context->_compOp;
     _opacity = _context->_opacity;
+    _filter = _context->_filter;
+    _computedStyle = _context->_computedStyle;
   }
 
   FOG_INLINE ~SvgContextGState()
@@ -345,6 +479,8 @@ struct FOG_NO_EXPORT SvgContextGState
     
     _context->_compOp = _compOp;
     _context->_opacity = _opacity;
+    _context->_filter = _filter;
+    _context->_computedStyle = _computedStyle;
   }
 
   // --------------------------------------------------------------------------
@@ -460,6 +596,8 @@ struct FOG_NO_EXPORT SvgContextGState
 
   Static<Font> _font;
   float _opacity;
+  const SvgFilterElement* _filter;
+  const SvgComputedStyle* _computedStyle;
   PointF _cursor;
 
 private:
@@ -519,6 +657,7 @@ struct FOG_API SvgRenderContext : public SvgContext
   // [Interface]
   // --------------------------------------------------------------------------
 
+  virtual err_t onVisit(SvgElement* obj);
   virtual err_t onShape(SvgElement* obj, const ShapeF& shape);
   virtual err_t onImage(SvgElement* obj, const PointF& pt, const Image& image);
 
@@ -571,9 +710,14 @@ struct FOG_API SvgMeasureContext : public SvgContext
   FOG_INLINE void boundWith(const BoxF& b)
   {
     if (_hasBBox)
+    {
       BoxF::bound(_bbox, _bbox, b);
+    }
     else
+    {
       _bbox = b;
+      _hasBBox = true;
+    }
   }
 
   // --------------------------------------------------------------------------
@@ -10,11 +10,14 @@
 
 // [Dependencies]
 #include <Fog/Core/Kernel/Property.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Tools/InternedString.h>
 #include <Fog/Core/Tools/Stream.h>
 #include <Fog/Core/Tools/Var.h>
+#include <Fog/G2d/Imaging/Filters/FeComponentFunction.h>
 #include <Fog/G2d/Svg/SvgContext.h>
 #include <Fog/G2d/Svg/SvgDom.h>
+#include <Fog/G2d/Svg/SvgSaxHandler_p.h>
 #include <Fog/G2d/Svg/SvgUtil.h>
 
 namespace Fog {
@@ -139,6 +142,25 @@ _Bail:
 // [Fog::SvgDom - Enumerations]
 // ============================================================================
 
+static const PropertyEnum svgEnum_colorMatrixType[] =
+{
+  { "matrix", SVG_FE_COLOR_MATRIX_TYPE_MATRIX },
+  { "saturate", SVG_FE_COLOR_MATRIX_TYPE_SATURATE },
+  { "hueRotate", SVG_FE_COLOR_MATRIX_TYPE_HUE_ROTATE },
+  { "luminanceToAlpha", SVG_FE_COLOR_MATRIX_TYPE_LUMINANCE_TO_ALPHA },
+  { "", SVG_FE_COLOR_MATRIX_TYPE_MATRIX }
+};
+
+static const PropertyEnum svgEnum_componentFunction[] =
+{
+  { "identity", FE_COMPONENT_FUNCTION_IDENTITY },
+  { "table", FE_COMPONENT_FUNCTION_TABLE },
+  { "discrete", FE_COMPONENT_FUNCTION_DISCRETE },
+  { "linear", FE_COMPONENT_FUNCTION_LINEAR },
+  { "gamma", FE_COMPONENT_FUNCTION_GAMMA },
+  { "", FE_COMPONENT_FUNCTION_IDENTITY }
+};
+
 static const PropertyEnum svgEnum_compOp[] =
 {
   { "src"           , COMPOSITE_SRC         },
@@ -192,6 +214,13 @@ static const PropertyEnum svgEnum_lengthAdjust[3] =
   { "", 0 }
 };
 
+static const PropertyEnum svgEnum_morphologyOperator[] =
+{
+  { "erode", FE_MORPHOLOGY_TYPE_ERODE },
+  { "dilate", FE_MORPHOLOGY_TYPE_DILATE },
+  { "", FE_MORPHOLOGY_TYPE_ERODE }
+};
+
 static const PropertyEnum svgEnum_spreadMethod[4] =
 {
   { "pad", GRADIENT_SPREAD_PAD },
@@ -216,16 +245,24 @@ static const PropertyEnum svgEnum_strokeLineJoin[] =
   { "", 0 }
 };
 
-// ============================================================================
-// [Fog::SvgDom - PropertyIO]
-// ============================================================================
+static const PropertyEnum svgEnum_stitchTiles[] =
+{
+  { "noStitch", 0 },
+  { "stitch", 1 },
+  { "", 0 }
+};
 
-struct FOG_NO_EXPORT SvgDomIO_OffsetF
+static const PropertyEnum svgEnum_turbulenceType[] =
 {
-  FOG_INLINE err_t parse(float& dst, const StringW& src) { return SvgUtil::parseOffset(dst, src); }
-  FOG_INLINE err_t serialize(StringW& dst, const float& src) { return SvgUtil::serializeOffset(dst, src); }
+  { "turbulence", FE_TURBULENCE_TYPE_TURBULENCE },
+  { "fractalNoise", FE_TURBULENCE_TYPE_FRACTAL_NOISE },
+  { "", FE_TURBULENCE_TYPE_TURBULENCE }
 };
 
+// ============================================================================
+// [Fog::SvgDom - PropertyIO]
+// ============================================================================
+
 struct FOG_NO_EXPORT SvgDomIO_OpacityF
 {
   FOG_INLINE err_t parse(float& dst, const StringW& src) { return SvgUtil::parseOpacity(dst, src); }
@@ -250,20 +287,39 @@ struct FOG_NO_EXPORT SvgDomIO_TransformF
   FOG_INLINE err_t serialize(StringW& dst, const TransformF& src) { return SvgUtil::serializeTransform(dst, src); }
 };
 
-struct FOG_NO_EXPORT SvgDomIO_PathF
+struct FOG_NO_EXPORT SvgDomIO_NumberListF
 {
-  FOG_INLINE err_t parse(PathF& dst, const StringW& src) { return SvgUtil::parsePath(dst, src); }
-  FOG_INLINE err_t serialize(StringW& dst, const PathF& src) { return SvgUtil::serializePath(dst, src); }
+  FOG_INLINE err_t parse(List<float>& dst, const StringW& src) { return SvgUtil::parseNumberList(dst, src); }
+  FOG_INLINE err_t serialize(StringW& dst, const List<float>& src) { return SvgUtil::serializeNumberList(dst, src); }
 };
 
-struct FOG_NO_EXPORT SvgDomIO_PointsF
+//! @internal
+//!
+//! @brief "number-optional-number" IO, the second number defaults to the
+//! first one.
+struct FOG_NO_EXPORT SvgDomIO_NumberPairF
 {
-  FOG_INLINE SvgDomIO_PointsF(bool closePath) : _closePath(closePath) {}
+  FOG_INLINE err_t parse(PointF& dst, const StringW& src)
+  {
+    List<float> numbers;
+    FOG_RETURN_ON_ERROR(SvgUtil::parseNumberList(numbers, src));
 
-  FOG_INLINE err_t parse(PathF& dst, const StringW& src) { return SvgUtil::parsePoints(dst, src, _closePath); }
-  FOG_INLINE err_t serialize(StringW& dst, const PathF& src) { return SvgUtil::serializePoints(dst, src); }
+    switch (numbers.getLength())
+    {
+      case 1: dst.set(numbers.getAt(0), numbers.getAt(0)); return ERR_OK;
+      case 2: dst.set(numbers.getAt(0), numbers.getAt(1)); return ERR_OK;
+      default: return ERR_RT_INVALID_ARGUMENT;
+    }
+  }
 
-  bool _closePath;
+  FOG_INLINE err_t serialize(StringW& dst, const PointF& src)
+  {
+    List<float> numbers;
+    numbers.append(src.x);
+    if (src.y != src.x)
+      numbers.append(src.y);
+    return SvgUtil::serializeNumberList(dst, numbers);
+  }
 };
 
 struct FOG_NO_EXPORT SvgDomIO_Enum
@@ -287,6 +343,10 @@ SvgElement::SvgElement(
   :
   DomElement(ownerDocument, tagName),
   _computedBoundingBox(0.0f, 0.0f, 0.0f, 0.0f),
+  _instance(NULL),
+  _computedStyle(NULL),
+  _computedParent(NULL),
+  _computedVersion(0),
   _boundingBoxDirty(true),
   _visible(true),
   _unused_0(0),
@@ -299,6 +359,68 @@ SvgElement::SvgElement(
 
 SvgElement::~SvgElement()
 {
+  _resetInstance();
+  _resetComputedStyle();
+}
+
+// ============================================================================
+// [Fog::SvgElement - Dirty]
+// ============================================================================
+
+void SvgElement::_setDirty()
+{
+  // Records of elements referenced by <use> may depend on any element, they
+  // are checked against the document version.
+  static_cast<SvgDocument*>(_ownerDocument)->_version++;
+
+  // The computed style of this element must be resolved again, descendants
+  // resolve theirs again only if the result differs.
+  _resetComputedStyle();
+
+  // Patterns cache the rendered tile and filters the compiled plan, invalidate
+  // all patterns and filters this element belongs to.
+  DomNode* node = this;
+
+  do {
+    if (node->isSvgObject(SVG_ELEMENT_PATTERN))
+      static_cast<SvgPatternElement*>(node)->_resetTileCache();
+    else if (node->isSvgObject(SVG_ELEMENT_FILTER))
+      static_cast<SvgFilterElement*>(node)->_resetPlan();
+    node = node->getParentNode();
+  } while (node != NULL);
+}
+
+// ============================================================================
+// [Fog::SvgElement - Computed Style]
+// ============================================================================
+
+void SvgElement::_resetComputedStyle() const
+{
+  if (_computedStyle != NULL)
+  {
+    _computedStyle->release();
+    _computedStyle = NULL;
+  }
+
+  if (_computedParent != NULL)
+  {
+    _computedParent->release();
+    _computedParent = NULL;
+  }
+}
+
+// ============================================================================
+// [Fog::SvgElement - Events]
+// ============================================================================
+
+void SvgElement::_onChildAdd(DomNode* firstNode, DomNode* lastNode)
+{
+  _setDirty();
+}
+
+void SvgElement::_onChildRemove(DomNode* firstNode, DomNode* lastNode)
+{
+  _setDirty();
 }
 
 // ============================================================================
@@ -422,7 +544,8 @@ SvgStyleData::SvgStyleData() :
   strokeDashArray(),
   fontFamily(),
   fillUri(),
-  strokeUri()
+  strokeUri(),
+  filterUri()
 {
 }
 
@@ -618,7 +741,10 @@ err_t SvgStyle::_getProperty(size_t index, StringW& value) const
       break;
 
     case SVG_STYLE_FILTER:
-      // TODO: SVG - Filter.
+      if (_d.filterUri.isEmpty())
+        value.append(Ascii8("none"));
+      else
+        value = _d.filterUri;
       break;
 
     // ------------------------------------------------------------------------
@@ -817,8 +943,12 @@ err_t SvgStyle::_setProperty(size_t index, const StringW& value)
 
     case SVG_STYLE_FILTER:
     {
-      // TODO: SVG - Filter.
-      err = ERR_RT_NOT_IMPLEMENTED;
+      if (value == Ascii8("none"))
+        _d.filterUri.reset();
+      else if (value.startsWith(Ascii8("url(")))
+        _d.filterUri = value;
+      else
+        err = ERR_SVG_INVALID_STYLE_VALUE;
       break;
     }
 
@@ -967,9 +1097,14 @@ err_t SvgStyle::_setProperty(size_t index, const StringW& value)
   }
 
   if (err == ERR_OK)
+  {
     _styleMask |= ((uint64_t)1 << index);
+    _ownerElement->_setDirty();
+  }
   else
+  {
     _resetProperty(index);
+  }
 
   return err;
 }
@@ -1033,6 +1168,7 @@ err_t SvgStyle::_resetProperty(size_t index)
       break;
 
     case SVG_STYLE_FILTER:
+      _d.filterUri.reset();
       break;
 
     // ------------------------------------------------------------------------
@@ -1107,7 +1243,8 @@ err_t SvgStyle::_resetProperty(size_t index)
       break;
   }
 
-  _styleMask &= ~(1 << index);
+  _styleMask &= ~((uint64_t)1 << index);
+  _ownerElement->_setDirty();
   return ERR_OK;
 }
 
@@ -1223,15 +1360,72 @@ FOG_CORE_OBJ_END()
 // [Fog::SvgStylableElement - SVG Interface]
 // ============================================================================
 
+#define SVG_STYLE_MASK_FONT \
+  (((uint64_t)1 << SVG_STYLE_FONT_FAMILY       ) | \
+   ((uint64_t)1 << SVG_STYLE_FONT_SIZE         ))
+
+#define SVG_STYLE_MASK_FILL \
+  (((uint64_t)1 << SVG_STYLE_FILL              ) | \
+   ((uint64_t)1 << SVG_STYLE_FILL_OPACITY      ) | \
+   ((uint64_t)1 << SVG_STYLE_FILL_RULE         ))
+
+#define SVG_STYLE_MASK_STROKE \
+  (((uint64_t)1 << SVG_STYLE_STROKE            ) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_DASH_ARRAY ) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_DASH_OFFSET) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_LINE_CAP   ) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_LINE_JOIN  ) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_MITER_LIMIT) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_OPACITY    ) | \
+   ((uint64_t)1 << SVG_STYLE_STROKE_WIDTH      ))
+
 err_t SvgStylableElement::onPrepare(SvgContext* context, SvgContextGState* state) const
 {
   // Apply transformations and setup styles defined by this element.
   uint64_t styleMask = _style.getStyleMask();
+  SvgDocument* doc = reinterpret_cast<SvgDocument*>(getOwnerDocument());
 
-  if (styleMask != 0)
+  // If the element was already prepared with the same inherited state the
+  // computed style is simply applied, the styles are not resolved again.
+  const SvgComputedStyle* computed = _computedStyle;
+
+  if (computed != NULL &&
+      _computedParent == context->_computedStyle &&
+      _computedVersion == (computed->_hasUri ? doc->_version : doc->_styleVersion))
   {
-    SvgDocument* doc = reinterpret_cast<SvgDocument*>(getOwnerDocument());
+    if (styleMask & SVG_STYLE_MASK_FONT)
+    {
+      if (state)
+        state->saveFont();
+      context->_font = computed->_font;
+    }
+
+    if (styleMask & SVG_STYLE_MASK_FILL)
+    {
+      if (state)
+        state->saveFill();
+      context->_fillSource = computed->_fillSource;
+      context->_fillRule = computed->_fillRule;
+    }
+
+    if (styleMask & SVG_STYLE_MASK_STROKE)
+    {
+      if (state)
+        state->saveStroke();
+      context->_strokeSource = computed->_strokeSource;
+      context->_strokeParams = computed->_strokeParams;
+    }
+
+    context->setCompOp(computed->_compOp);
+    context->setOpacity(computed->_opacity);
+    context->setFilter(computed->_filter);
+    context->_computedStyle = computed;
 
+    return ERR_OK;
+  }
+
+  if (styleMask != 0)
+  {
     // Comp-op.
     if (styleMask & (((uint64_t)1 << SVG_STYLE_COMP_OP)))
     {
@@ -1250,9 +1444,19 @@ err_t SvgStylableElement::onPrepare(SvgContext* context, SvgContextGState* state
       context->setOpacity(_style._d.opacity);
     }
 
+    // Filter (non-inheritable).
+    context->setFilter(NULL);
+    if ((styleMask & (((uint64_t)1 << SVG_STYLE_FILTER))) && !_style._d.filterUri.isEmpty())
+    {
+      DomElement* uriRef = getOwnerDocument()->getElementById(
+        parseCssLinkId(_style._d.filterUri));
+
+      if (uriRef != NULL && uriRef->isSvgObject(SVG_ELEMENT_FILTER))
+        context->setFilter(static_cast<SvgFilterElement*>(uriRef));
+    }
+
     // Setup font parameters.
-    if (styleMask & (((uint64_t)1 << SVG_STYLE_FONT_FAMILY) |
-                     ((uint64_t)1 << SVG_STYLE_FONT_SIZE  )))
+    if (styleMask & SVG_STYLE_MASK_FONT)
     {
       if (state)
         state->saveFont();
@@ -1275,9 +1479,7 @@ err_t SvgStylableElement::onPrepare(SvgContext* context, SvgContextGState* state
     }
 
     // Setup fill parameters.
-    if (styleMask & (((uint64_t)1 << SVG_STYLE_FILL               ) |
-                     ((uint64_t)1 << SVG_STYLE_FILL_OPACITY       ) |
-                     ((uint64_t)1 << SVG_STYLE_FILL_RULE          )))
+    if (styleMask & SVG_STYLE_MASK_FILL)
     {
       if (state)
         state->saveFill();
@@ -1323,14 +1525,7 @@ err_t SvgStylableElement::onPrepare(SvgContext* context, SvgContextGState* state
     }
 
     // Setup stroke parameters.
-    if (styleMask & (((uint64_t)1 << SVG_STYLE_STROKE             ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_DASH_ARRAY  ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_DASH_OFFSET ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_LINE_CAP    ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_LINE_JOIN   ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_MITER_LIMIT ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_OPACITY     ) |
-                     ((uint64_t)1 << SVG_STYLE_STROKE_WIDTH       )))
+    if (styleMask & SVG_STYLE_MASK_STROKE)
     {
       if (state)
         state->saveStroke();
@@ -1400,8 +1595,29 @@ err_t SvgStylableElement::onPrepare(SvgContext* context, SvgContextGState* state
     context->setCompOp(COMPOSITE_SRC_OVER);
     // Set opacity 1.0 (default, non-ihneritable).
     context->setOpacity(1.0f);
+    // Set no filter (default, non-inheritable).
+    context->setFilter(NULL);
+  }
+
+  // Intern the computed style, elements sharing it (siblings with identical
+  // styles) are then seen as the same inherited state by their children.
+  if (doc->_computedStyleCache == NULL)
+    doc->_computedStyleCache = fog_new SvgComputedStyleCache();
+
+  const SvgComputedStyle* parent = context->_computedStyle;
+  _resetComputedStyle();
+
+  if (FOG_IS_NULL(doc->_computedStyleCache) ||
+      FOG_IS_NULL(computed = doc->_computedStyleCache->intern(context)))
+  {
+    return ERR_RT_OUT_OF_MEMORY;
   }
 
+  _computedStyle = computed;
+  _computedParent = parent != NULL ? parent->addRef() : NULL;
+  _computedVersion = computed->_hasUri ? doc->_version : doc->_styleVersion;
+
+  context->_computedStyle = computed;
   return ERR_OK;
 }
 
@@ -1426,7 +1642,7 @@ SvgTransformableElement::~SvgTransformableElement()
 // ============================================================================
 
 FOG_CORE_OBJ_DEF(SvgTransformableElement)
-  FOG_CORE_OBJ_PROPERTY_BASE(Transform, FOG_S(transform), SvgDomIO_TransformF())
+  FOG_CORE_OBJ_PROPERTY_ACCESS(Transform, FOG_S(transform), _getTransformString, _setTransformString, resetTransform)
 FOG_CORE_OBJ_END()
 
 err_t SvgTransformableElement::setTransform(const TransformF& transform)
@@ -1434,6 +1650,7 @@ err_t SvgTransformableElement::setTransform(const TransformF& transform)
   FOG_DOM_ELEMENT_INIT();
 
   _transform = transform;
+  _transformString.reset();
   _setDirty();
 
   return ERR_OK;
@@ -1442,22 +1659,54 @@ err_t SvgTransformableElement::setTransform(const TransformF& transform)
 err_t SvgTransformableElement::resetTransform()
 {
   _transform.reset();
+  _transformString.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgTransformableElement - SVG Properties - Lazy]
+// ============================================================================
+
+err_t SvgTransformableElement::_getTransformString(StringW& value) const
+{
+  if (!_transformString.isEmpty())
+    return value.set(_transformString);
+  else
+    return SvgUtil::serializeTransform(value, _transform);
+}
+
+err_t SvgTransformableElement::_setTransformString(const StringW& value)
+{
+  _transform.reset();
+  _transformString = value;
   _setDirty();
 
   return ERR_OK;
 }
 
+void SvgTransformableElement::_parseTransform() const
+{
+  // Invalid transform is ignored, like it would be if parsed by setAttribute().
+  if (SvgUtil::parseTransform(_transform, _transformString) != ERR_OK)
+    _transform.reset();
+  _transformString.reset();
+}
+
 // ============================================================================
 // [Fog::SvgTransformableElement - SVG Interface]
 // ============================================================================
 
 err_t SvgTransformableElement::onPrepare(SvgContext* context, SvgContextGState* state) const
 {
-  if (!_transform.isIdentity())
+  const TransformF& transform = getTransform();
+
+  if (!transform.isIdentity())
   {
     if (state && !state->hasState(SvgContextGState::SAVED_TRANSFORM))
       state->saveTransform();
-    context->transform(_transform);
+    context->transform(transform);
   }
 
   return Base::onPrepare(context, state);
@@ -2182,6 +2431,8 @@ SvgPatternElement::SvgPatternElement(DomDocument* ownerDocument) :
   SvgElement(ownerDocument, FOG_S(pattern), SVG_ELEMENT_PATTERN),
   _patternTransform(),
   _viewBox(0.0f, 0.0f, 0.0f, 0.0f),
+  _tileCacheSize(0, 0),
+  _tileCacheVersion(0),
   _x(0.0f),
   _y(0.0f),
   _width(0.0f),
@@ -2376,6 +2627,20 @@ err_t SvgPatternElement::_createPattern(Pattern& pattern, SvgElement* obj) const
     if (w == 0 || h == 0)
       return ERR_IMAGE_INVALID_SIZE;
 
+    float tx = svgGetCoord(doc, _x, _xUnit);
+    float ty = svgGetCoord(doc, _y, _yUnit);
+
+    // The tile doesn't depend on the element using the pattern, it's rendered
+    // once and reused until the document is changed. The pattern content can
+    // reference elements outside of its subtree (<use>, paint servers), so
+    // the document version is part of the key.
+    if (!_tileCache.isEmpty() && _tileCacheSize == SizeI(w, h) && _tileCacheVersion == doc->_version)
+    {
+      pattern.createTexture(Texture(_tileCache, TEXTURE_TILE_REPEAT));
+      pattern.translate(PointF(tx, ty));
+      goto _AssignTransform;
+    }
+
     Image image;
     FOG_RETURN_ON_ERROR(image.create(SizeI(w, h), IMAGE_FORMAT_PRGB32));
 
@@ -2408,8 +2673,9 @@ err_t SvgPatternElement::_createPattern(Pattern& pattern, SvgElement* obj) const
     ctx.resetPainter();
     painter.end();
 
-    float tx = svgGetCoord(doc, _x, _xUnit);
-    float ty = svgGetCoord(doc, _y, _yUnit);
+    _tileCache = image;
+    _tileCacheSize.set(w, h);
+    _tileCacheVersion = doc->_version;
 
     pattern.createTexture(Texture(image, TEXTURE_TILE_REPEAT));
     pattern.translate(PointF(tx, ty));
@@ -2423,152 +2689,1088 @@ _AssignTransform:
 }
 
 // ============================================================================
-// [Fog::SvgStopElement - Construction / Destruction]
+// [Fog::SvgFilterElement - Construction / Destruction]
 // ============================================================================
 
-SvgStopElement::SvgStopElement(DomDocument* ownerDocument) :
-  SvgStylableElement(ownerDocument, FOG_S(stop), SVG_ELEMENT_STOP),
-  _offset(0.0f),
-  _offsetAssigned(false)
+SvgFilterElement::SvgFilterElement(DomDocument* ownerDocument) :
+  SvgElement(ownerDocument, FOG_S(filter), SVG_ELEMENT_FILTER),
+  _plan(NULL),
+  _x(-0.1f),
+  _y(-0.1f),
+  _width(1.2f),
+  _height(1.2f),
+  _xUnit(UNIT_PERCENTAGE),
+  _yUnit(UNIT_PERCENTAGE),
+  _widthUnit(UNIT_PERCENTAGE),
+  _heightUnit(UNIT_PERCENTAGE),
+  _filterUnits(SVG_OBJECT_BOUNDING_BOX),
+  _primitiveUnits(SVG_USER_SPACE_ON_USE)
 {
   FOG_DOM_ELEMENT_INIT();
 }
 
-SvgStopElement::~SvgStopElement()
+SvgFilterElement::~SvgFilterElement()
 {
+  _resetPlan();
 }
 
 // ============================================================================
-// [Fog::SvgStopElement - SVG Properties]
+// [Fog::SvgFilterElement - SVG Properties]
 // ============================================================================
 
-FOG_CORE_OBJ_DEF(SvgStopElement)
-  FOG_CORE_OBJ_PROPERTY_BASE(Offset, FOG_S(offset), SvgDomIO_OffsetF())
+FOG_CORE_OBJ_DEF(SvgFilterElement)
+  FOG_CORE_OBJ_PROPERTY_BASE(X, FOG_S(x), SvgDomIO_CoordF())
+  FOG_CORE_OBJ_PROPERTY_BASE(Y, FOG_S(y), SvgDomIO_CoordF())
+  FOG_CORE_OBJ_PROPERTY_BASE(Width, FOG_S(width), SvgDomIO_CoordF())
+  FOG_CORE_OBJ_PROPERTY_BASE(Height, FOG_S(height), SvgDomIO_CoordF())
+  FOG_CORE_OBJ_PROPERTY_BASE(FilterUnits, FOG_S(filterUnits), SvgDomIO_Enum(svgEnum_gradientUnits))
+  FOG_CORE_OBJ_PROPERTY_BASE(PrimitiveUnits, FOG_S(primitiveUnits), SvgDomIO_Enum(svgEnum_gradientUnits))
 FOG_CORE_OBJ_END()
 
-err_t SvgStopElement::setOffset(float offset)
+err_t SvgFilterElement::setX(const CoordF& x)
 {
-  if (!Math::isFinite(offset))
-    return ERR_OBJ_INVALID_VALUE;
-
-  _offset = Math::bound<float>(offset, 0.0f, 1.0f);
-  _offsetAssigned = true;
+  _x = x.getValue();
+  _xUnit = x.getUnit();
   _setDirty();
 
   return ERR_OK;
 }
 
-err_t SvgStopElement::resetOffset()
+err_t SvgFilterElement::resetX()
 {
-  _offset = 0.0f;
-  _offsetAssigned = false;
+  _x = -0.1f;
+  _xUnit = UNIT_PERCENTAGE;
   _setDirty();
 
   return ERR_OK;
 }
 
-// ============================================================================
-// [Fog::SvgStopElement - SVG Interface]
-// ============================================================================
-
-err_t SvgStopElement::onProcess(SvgContext* context) const
+err_t SvgFilterElement::setY(const CoordF& y)
 {
+  _y = y.getValue();
+  _yUnit = y.getUnit();
+  _setDirty();
+
   return ERR_OK;
 }
 
-// ============================================================================
-// [Fog::SvgDefsElement - Construction / Destruction]
-// ============================================================================
-
-SvgDefsElement::SvgDefsElement(DomDocument* ownerDocument) :
-  SvgElement(ownerDocument, FOG_S(defs), SVG_ELEMENT_DEFS)
+err_t SvgFilterElement::resetY()
 {
-  FOG_DOM_ELEMENT_INIT();
+  _y = -0.1f;
+  _yUnit = UNIT_PERCENTAGE;
+  _setDirty();
+
+  return ERR_OK;
 }
 
-SvgDefsElement::~SvgDefsElement()
+err_t SvgFilterElement::setWidth(const CoordF& width)
 {
-}
+  _width = width.getValue();
+  _widthUnit = width.getUnit();
+  _setDirty();
 
-// ============================================================================
-// [Fog::SvgDefsElement - SVG Interface]
-// ============================================================================
+  return ERR_OK;
+}
 
-err_t SvgDefsElement::onProcess(SvgContext* context) const
+err_t SvgFilterElement::resetWidth()
 {
-  // <defs> section is used only to define shared resources. Never go inside.
+  _width = 1.2f;
+  _widthUnit = UNIT_PERCENTAGE;
+  _setDirty();
+
   return ERR_OK;
 }
 
-// ============================================================================
-// [Fog::SvgGElement - Construction / Destruction]
-// ============================================================================
+err_t SvgFilterElement::setHeight(const CoordF& height)
+{
+  _height = height.getValue();
+  _heightUnit = height.getUnit();
+  _setDirty();
 
-SvgGElement::SvgGElement(DomDocument* ownerDocument) :
-  SvgTransformableElement(ownerDocument, FOG_S(g), SVG_ELEMENT_G)
+  return ERR_OK;
+}
+
+err_t SvgFilterElement::resetHeight()
 {
-  FOG_DOM_ELEMENT_INIT();
+  _height = 1.2f;
+  _heightUnit = UNIT_PERCENTAGE;
+  _setDirty();
+
+  return ERR_OK;
 }
 
-SvgGElement::~SvgGElement()
+err_t SvgFilterElement::setFilterUnits(uint32_t filterUnits)
 {
+  if (filterUnits >= SVG_PATTERN_UNITS_COUNT)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _filterUnits = filterUnits;
+  _setDirty();
+
+  return ERR_OK;
 }
 
-// ============================================================================
-// [Fog::SvgGElement - SVG Interface]
-// ============================================================================
+err_t SvgFilterElement::resetFilterUnits()
+{
+  _filterUnits = SVG_OBJECT_BOUNDING_BOX;
+  _setDirty();
 
-err_t SvgGElement::onProcess(SvgContext* context) const
+  return ERR_OK;
+}
+
+err_t SvgFilterElement::setPrimitiveUnits(uint32_t primitiveUnits)
 {
-  if (!hasChildNodes())
-    return ERR_OK;
-  return _visitContainer(context);
+  if (primitiveUnits >= SVG_PATTERN_UNITS_COUNT)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _primitiveUnits = primitiveUnits;
+  _setDirty();
+
+  return ERR_OK;
 }
 
-err_t SvgGElement::onGeometryBoundingBox(BoxF& box, const TransformF* tr) const
+err_t SvgFilterElement::resetPrimitiveUnits()
 {
-  if (!hasChildNodes())
-  {
-    box.reset();
-    return ERR_GEOMETRY_NONE;
-  }
+  _primitiveUnits = SVG_USER_SPACE_ON_USE;
+  _setDirty();
 
-  // TODO: SVG - It seems that there is nothing to do, because all render specific
-  // options are related to a single SVG element, not to a group.
-  // return _walkAndMergeBBox(this);
+  return ERR_OK;
+}
 
-  return ERR_RT_NOT_IMPLEMENTED;
+// ============================================================================
+// [Fog::SvgFilterElement - SVG Interface]
+// ============================================================================
+
+err_t SvgFilterElement::onProcess(SvgContext* context) const
+{
+  // Filter is applied only through the 'filter' style property.
+  return ERR_OK;
 }
 
 // ============================================================================
-// [Fog::SvgSymbolElement - Construction / Destruction]
+// [Fog::SvgFePrimitiveElement - Construction / Destruction]
 // ============================================================================
 
-SvgSymbolElement::SvgSymbolElement(DomDocument* ownerDocument) :
-  SvgStylableElement(ownerDocument, FOG_S(symbol), SVG_ELEMENT_SYMBOL)
+SvgFePrimitiveElement::SvgFePrimitiveElement(DomDocument* ownerDocument, const InternedStringW& tagName, uint32_t svgType) :
+  SvgElement(ownerDocument, tagName, svgType),
+  _in(),
+  _result()
 {
   FOG_DOM_ELEMENT_INIT();
 }
 
-SvgSymbolElement::~SvgSymbolElement()
+SvgFePrimitiveElement::~SvgFePrimitiveElement()
 {
 }
 
 // ============================================================================
-// [Fog::SvgSymbolElement - SVG Interface]
+// [Fog::SvgFePrimitiveElement - SVG Properties]
 // ============================================================================
 
-err_t SvgSymbolElement::onProcess(SvgContext* context) const
+FOG_CORE_OBJ_DEF(SvgFePrimitiveElement)
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(In, FOG_S(in))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Result, FOG_S(result))
+FOG_CORE_OBJ_END()
+
+err_t SvgFePrimitiveElement::setIn(const StringW& in)
 {
-  if (!hasChildNodes())
-    return ERR_OK;
+  FOG_RETURN_ON_ERROR(_in.set(in));
+  _setDirty();
 
-  return _visitContainer(context);
+  return ERR_OK;
 }
 
-// ============================================================================
-// [Fog::SvgUseElement - Construction / Destruction]
-// ============================================================================
+err_t SvgFePrimitiveElement::resetIn()
+{
+  _in.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFePrimitiveElement::setResult(const StringW& result)
+{
+  FOG_RETURN_ON_ERROR(_result.set(result));
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFePrimitiveElement::resetResult()
+{
+  _result.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFePrimitiveElement - SVG Interface]
+// ============================================================================
+
+err_t SvgFePrimitiveElement::onProcess(SvgContext* context) const
+{
+  // Filter primitives are never rendered directly, see SvgFilterPlan.
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeColorMatrixElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeColorMatrixElement::SvgFeColorMatrixElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feColorMatrix), SVG_ELEMENT_FE_COLOR_MATRIX),
+  _values(),
+  _type(SVG_FE_COLOR_MATRIX_TYPE_MATRIX)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeColorMatrixElement::~SvgFeColorMatrixElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeColorMatrixElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeColorMatrixElement)
+  FOG_CORE_OBJ_PROPERTY_BASE(Type, FOG_S(type), SvgDomIO_Enum(svgEnum_colorMatrixType))
+  FOG_CORE_OBJ_PROPERTY_BASE(Values, FOG_S(values), SvgDomIO_NumberListF())
+FOG_CORE_OBJ_END()
+
+err_t SvgFeColorMatrixElement::setType(uint32_t type)
+{
+  if (type >= SVG_FE_COLOR_MATRIX_TYPE_COUNT)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _type = type;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeColorMatrixElement::resetType()
+{
+  _type = SVG_FE_COLOR_MATRIX_TYPE_MATRIX;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeColorMatrixElement::setValues(const List<float>& values)
+{
+  _values = values;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeColorMatrixElement::resetValues()
+{
+  _values.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeColorMatrixElement - SVG Methods]
+// ============================================================================
+
+void SvgFeColorMatrixElement::getMatrix(float* m) const
+{
+  const float* v = _values.getData();
+  size_t length = _values.getLength();
+
+  // Identity.
+  for (uint32_t i = 0; i < 20; i++)
+    m[i] = (i % 6) == 0 ? 1.0f : 0.0f;
+
+  switch (_type)
+  {
+    case SVG_FE_COLOR_MATRIX_TYPE_MATRIX:
+    {
+      if (length == 20)
+      {
+        for (uint32_t i = 0; i < 20; i++)
+          m[i] = v[i];
+      }
+      break;
+    }
+
+    case SVG_FE_COLOR_MATRIX_TYPE_SATURATE:
+    {
+      float s = length > 0 ? v[0] : 1.0f;
+
+      m[ 0] = 0.213f + 0.787f * s; m[ 1] = 0.715f - 0.715f * s; m[ 2] = 0.072f - 0.072f * s;
+      m[ 5] = 0.213f - 0.213f * s; m[ 6] = 0.715f + 0.285f * s; m[ 7] = 0.072f - 0.072f * s;
+      m[10] = 0.213f - 0.213f * s; m[11] = 0.715f - 0.715f * s; m[12] = 0.072f + 0.928f * s;
+      break;
+    }
+
+    case SVG_FE_COLOR_MATRIX_TYPE_HUE_ROTATE:
+    {
+      float sa, ca;
+      Math::sincos(Math::deg2rad(length > 0 ? v[0] : 0.0f), &sa, &ca);
+
+      m[ 0] = 0.213f + ca * 0.787f - sa * 0.213f;
+      m[ 1] = 0.715f - ca * 0.715f - sa * 0.715f;
+      m[ 2] = 0.072f - ca * 0.072f + sa * 0.928f;
+
+      m[ 5] = 0.213f - ca * 0.213f + sa * 0.143f;
+      m[ 6] = 0.715f + ca * 0.285f + sa * 0.140f;
+      m[ 7] = 0.072f - ca * 0.072f - sa * 0.283f;
+
+      m[10] = 0.213f - ca * 0.213f - sa * 0.787f;
+      m[11] = 0.715f - ca * 0.715f + sa * 0.715f;
+      m[12] = 0.072f + ca * 0.928f + sa * 0.072f;
+      break;
+    }
+
+    case SVG_FE_COLOR_MATRIX_TYPE_LUMINANCE_TO_ALPHA:
+    {
+      for (uint32_t i = 0; i < 20; i++)
+        m[i] = 0.0f;
+
+      m[15] = 0.2125f;
+      m[16] = 0.7154f;
+      m[17] = 0.0721f;
+      break;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::SvgFeComponentTransferElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeComponentTransferElement::SvgFeComponentTransferElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feComponentTransfer), SVG_ELEMENT_FE_COMPONENT_TRANSFER)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeComponentTransferElement::~SvgFeComponentTransferElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeFuncElement - Construction / Destruction]
+// ============================================================================
+
+static uint32_t SvgFeFuncElement_getSvgType(const InternedStringW& tagName)
+{
+  if (tagName == FOG_S(feFuncR)) return SVG_ELEMENT_FE_FUNC_R;
+  if (tagName == FOG_S(feFuncG)) return SVG_ELEMENT_FE_FUNC_G;
+  if (tagName == FOG_S(feFuncB)) return SVG_ELEMENT_FE_FUNC_B;
+  return SVG_ELEMENT_FE_FUNC_A;
+}
+
+SvgFeFuncElement::SvgFeFuncElement(DomDocument* ownerDocument, const InternedStringW& tagName) :
+  SvgElement(ownerDocument, tagName, SvgFeFuncElement_getSvgType(tagName)),
+  _tableValues(),
+  _type(FE_COMPONENT_FUNCTION_IDENTITY),
+  _slope(1.0f),
+  _intercept(0.0f),
+  _amplitude(1.0f),
+  _exponent(1.0f),
+  _offset(0.0f)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeFuncElement::~SvgFeFuncElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeFuncElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeFuncElement)
+  FOG_CORE_OBJ_PROPERTY_BASE(Type, FOG_S(type), SvgDomIO_Enum(svgEnum_componentFunction))
+  FOG_CORE_OBJ_PROPERTY_BASE(TableValues, FOG_S(tableValues), SvgDomIO_NumberListF())
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Slope, FOG_S(slope))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Intercept, FOG_S(intercept))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Amplitude, FOG_S(amplitude))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Exponent, FOG_S(exponent))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Offset, FOG_S(offset))
+FOG_CORE_OBJ_END()
+
+err_t SvgFeFuncElement::setType(uint32_t type)
+{
+  if (type >= FE_COMPONENT_FUNCTION_COUNT)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _type = type;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetType()
+{
+  _type = FE_COMPONENT_FUNCTION_IDENTITY;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::setTableValues(const List<float>& tableValues)
+{
+  _tableValues = tableValues;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetTableValues()
+{
+  _tableValues.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::setSlope(float slope)
+{
+  _slope = slope;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetSlope()
+{
+  _slope = 1.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::setIntercept(float intercept)
+{
+  _intercept = intercept;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetIntercept()
+{
+  _intercept = 0.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::setAmplitude(float amplitude)
+{
+  _amplitude = amplitude;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetAmplitude()
+{
+  _amplitude = 1.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::setExponent(float exponent)
+{
+  _exponent = exponent;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetExponent()
+{
+  _exponent = 1.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::setOffset(float offset)
+{
+  _offset = offset;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeFuncElement::resetOffset()
+{
+  _offset = 0.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeFuncElement - SVG Methods]
+// ============================================================================
+
+uint32_t SvgFeFuncElement::getComponentIndex() const
+{
+  switch (_objectType)
+  {
+    case SVG_ELEMENT_FE_FUNC_R: return 0;
+    case SVG_ELEMENT_FE_FUNC_G: return 1;
+    case SVG_ELEMENT_FE_FUNC_B: return 2;
+    default: return 3;
+  }
+}
+
+err_t SvgFeFuncElement::getComponentFunction(FeComponentFunction& dst) const
+{
+  switch (_type)
+  {
+    case FE_COMPONENT_FUNCTION_TABLE:
+      // Empty table results in identity.
+      if (_tableValues.isEmpty())
+        break;
+      return dst.setTable(_tableValues);
+
+    case FE_COMPONENT_FUNCTION_DISCRETE:
+      if (_tableValues.isEmpty())
+        break;
+      return dst.setDiscrete(_tableValues);
+
+    case FE_COMPONENT_FUNCTION_LINEAR:
+      return dst.setLinear(FeComponentFunctionLinear(_slope, _intercept));
+
+    case FE_COMPONENT_FUNCTION_GAMMA:
+      return dst.setGamma(FeComponentFunctionGamma(_amplitude, _exponent, _offset));
+  }
+
+  dst.reset();
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeFuncElement - SVG Interface]
+// ============================================================================
+
+err_t SvgFeFuncElement::onProcess(SvgContext* context) const
+{
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeGaussianBlurElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeGaussianBlurElement::SvgFeGaussianBlurElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feGaussianBlur), SVG_ELEMENT_FE_GAUSSIAN_BLUR),
+  _stdDeviation(0.0f, 0.0f)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeGaussianBlurElement::~SvgFeGaussianBlurElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeGaussianBlurElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeGaussianBlurElement)
+  FOG_CORE_OBJ_PROPERTY_BASE(StdDeviation, FOG_S(stdDeviation), SvgDomIO_NumberPairF())
+FOG_CORE_OBJ_END()
+
+err_t SvgFeGaussianBlurElement::setStdDeviation(const PointF& stdDeviation)
+{
+  if (stdDeviation.x < 0.0f || stdDeviation.y < 0.0f)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _stdDeviation = stdDeviation;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeGaussianBlurElement::resetStdDeviation()
+{
+  _stdDeviation.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeMergeElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeMergeElement::SvgFeMergeElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feMerge), SVG_ELEMENT_FE_MERGE)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeMergeElement::~SvgFeMergeElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeMergeNodeElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeMergeNodeElement::SvgFeMergeNodeElement(DomDocument* ownerDocument) :
+  SvgElement(ownerDocument, FOG_S(feMergeNode), SVG_ELEMENT_FE_MERGE_NODE),
+  _in()
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeMergeNodeElement::~SvgFeMergeNodeElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeMergeNodeElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeMergeNodeElement)
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(In, FOG_S(in))
+FOG_CORE_OBJ_END()
+
+err_t SvgFeMergeNodeElement::setIn(const StringW& in)
+{
+  FOG_RETURN_ON_ERROR(_in.set(in));
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeMergeNodeElement::resetIn()
+{
+  _in.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeMergeNodeElement - SVG Interface]
+// ============================================================================
+
+err_t SvgFeMergeNodeElement::onProcess(SvgContext* context) const
+{
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeMorphologyElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeMorphologyElement::SvgFeMorphologyElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feMorphology), SVG_ELEMENT_FE_MORPHOLOGY),
+  _radius(0.0f, 0.0f),
+  _operator(FE_MORPHOLOGY_TYPE_ERODE)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeMorphologyElement::~SvgFeMorphologyElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeMorphologyElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeMorphologyElement)
+  FOG_CORE_OBJ_PROPERTY_BASE(Operator, FOG_S(operator), SvgDomIO_Enum(svgEnum_morphologyOperator))
+  FOG_CORE_OBJ_PROPERTY_BASE(Radius, FOG_S(radius), SvgDomIO_NumberPairF())
+FOG_CORE_OBJ_END()
+
+err_t SvgFeMorphologyElement::setOperator(uint32_t op)
+{
+  if (op >= FE_MORPHOLOGY_TYPE_COUNT)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _operator = op;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeMorphologyElement::resetOperator()
+{
+  _operator = FE_MORPHOLOGY_TYPE_ERODE;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeMorphologyElement::setRadius(const PointF& radius)
+{
+  if (radius.x < 0.0f || radius.y < 0.0f)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _radius = radius;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeMorphologyElement::resetRadius()
+{
+  _radius.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeOffsetElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeOffsetElement::SvgFeOffsetElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feOffset), SVG_ELEMENT_FE_OFFSET),
+  _dx(0.0f),
+  _dy(0.0f)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeOffsetElement::~SvgFeOffsetElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeOffsetElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeOffsetElement)
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Dx, FOG_S(dx))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Dy, FOG_S(dy))
+FOG_CORE_OBJ_END()
+
+err_t SvgFeOffsetElement::setDx(float dx)
+{
+  _dx = dx;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeOffsetElement::resetDx()
+{
+  _dx = 0.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeOffsetElement::setDy(float dy)
+{
+  _dy = dy;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeOffsetElement::resetDy()
+{
+  _dy = 0.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFeTurbulenceElement - Construction / Destruction]
+// ============================================================================
+
+SvgFeTurbulenceElement::SvgFeTurbulenceElement(DomDocument* ownerDocument) :
+  SvgFePrimitiveElement(ownerDocument, FOG_S(feTurbulence), SVG_ELEMENT_FE_TURBULENCE),
+  _baseFrequency(0.0f, 0.0f),
+  _seed(0.0f),
+  _numOctaves(1),
+  _stitchTiles(0),
+  _type(FE_TURBULENCE_TYPE_TURBULENCE)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgFeTurbulenceElement::~SvgFeTurbulenceElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgFeTurbulenceElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgFeTurbulenceElement)
+  FOG_CORE_OBJ_PROPERTY_BASE(BaseFrequency, FOG_S(baseFrequency), SvgDomIO_NumberPairF())
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(NumOctaves, FOG_S(numOctaves))
+  FOG_CORE_OBJ_PROPERTY_DEFAULT(Seed, FOG_S(seed))
+  FOG_CORE_OBJ_PROPERTY_BASE(StitchTiles, FOG_S(stitchTiles), SvgDomIO_Enum(svgEnum_stitchTiles))
+  FOG_CORE_OBJ_PROPERTY_BASE(Type, FOG_S(type), SvgDomIO_Enum(svgEnum_turbulenceType))
+FOG_CORE_OBJ_END()
+
+err_t SvgFeTurbulenceElement::setBaseFrequency(const PointF& baseFrequency)
+{
+  if (baseFrequency.x < 0.0f || baseFrequency.y < 0.0f)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _baseFrequency = baseFrequency;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::resetBaseFrequency()
+{
+  _baseFrequency.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::setNumOctaves(uint32_t numOctaves)
+{
+  _numOctaves = numOctaves;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::resetNumOctaves()
+{
+  _numOctaves = 1;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::setSeed(float seed)
+{
+  _seed = seed;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::resetSeed()
+{
+  _seed = 0.0f;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::setStitchTiles(uint32_t stitchTiles)
+{
+  if (stitchTiles > 1)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _stitchTiles = stitchTiles;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::resetStitchTiles()
+{
+  _stitchTiles = 0;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::setType(uint32_t type)
+{
+  if (type >= FE_TURBULENCE_TYPE_COUNT)
+    return ERR_OBJ_INVALID_VALUE;
+
+  _type = type;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgFeTurbulenceElement::resetType()
+{
+  _type = FE_TURBULENCE_TYPE_TURBULENCE;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgStopElement - Construction / Destruction]
+// ============================================================================
+
+SvgStopElement::SvgStopElement(DomDocument* ownerDocument) :
+  SvgStylableElement(ownerDocument, FOG_S(stop), SVG_ELEMENT_STOP),
+  _offset(0.0f),
+  _offsetAssigned(false)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgStopElement::~SvgStopElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgStopElement - SVG Properties]
+// ============================================================================
+
+FOG_CORE_OBJ_DEF(SvgStopElement)
+  FOG_CORE_OBJ_PROPERTY_ACCESS(Offset, FOG_S(offset), _getOffsetString, _setOffsetString, resetOffset)
+FOG_CORE_OBJ_END()
+
+err_t SvgStopElement::setOffset(float offset)
+{
+  if (!Math::isFinite(offset))
+    return ERR_OBJ_INVALID_VALUE;
+
+  _offset = Math::bound<float>(offset, 0.0f, 1.0f);
+  _offsetAssigned = true;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgStopElement::resetOffset()
+{
+  _offset = 0.0f;
+  _offsetAssigned = false;
+  _setDirty();
+
+  return ERR_OK;
+}
+
+err_t SvgStopElement::_getOffsetString(StringW& value) const
+{
+  // Stop without offset is ignored, so it must not serialize as "0".
+  if (!_offsetAssigned)
+    return ERR_OK;
+
+  return SvgUtil::serializeOffset(value, _offset);
+}
+
+err_t SvgStopElement::_setOffsetString(const StringW& value)
+{
+  float offset;
+  FOG_RETURN_ON_ERROR(SvgUtil::parseOffset(offset, value));
+
+  return setOffset(offset);
+}
+
+// ============================================================================
+// [Fog::SvgStopElement - SVG Interface]
+// ============================================================================
+
+err_t SvgStopElement::onProcess(SvgContext* context) const
+{
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgDefsElement - Construction / Destruction]
+// ============================================================================
+
+SvgDefsElement::SvgDefsElement(DomDocument* ownerDocument) :
+  SvgElement(ownerDocument, FOG_S(defs), SVG_ELEMENT_DEFS)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgDefsElement::~SvgDefsElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgDefsElement - SVG Interface]
+// ============================================================================
+
+err_t SvgDefsElement::onProcess(SvgContext* context) const
+{
+  // <defs> section is used only to define shared resources. Never go inside.
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgGElement - Construction / Destruction]
+// ============================================================================
+
+SvgGElement::SvgGElement(DomDocument* ownerDocument) :
+  SvgTransformableElement(ownerDocument, FOG_S(g), SVG_ELEMENT_G)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgGElement::~SvgGElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgGElement - SVG Interface]
+// ============================================================================
+
+err_t SvgGElement::onProcess(SvgContext* context) const
+{
+  if (!hasChildNodes())
+    return ERR_OK;
+  return _visitContainer(context);
+}
+
+err_t SvgGElement::onGeometryBoundingBox(BoxF& box, const TransformF* tr) const
+{
+  if (!hasChildNodes())
+  {
+    box.reset();
+    return ERR_GEOMETRY_NONE;
+  }
+
+  // TODO: SVG - It seems that there is nothing to do, because all render specific
+  // options are related to a single SVG element, not to a group.
+  // return _walkAndMergeBBox(this);
+
+  return ERR_RT_NOT_IMPLEMENTED;
+}
+
+// ============================================================================
+// [Fog::SvgSymbolElement - Construction / Destruction]
+// ============================================================================
+
+SvgSymbolElement::SvgSymbolElement(DomDocument* ownerDocument) :
+  SvgStylableElement(ownerDocument, FOG_S(symbol), SVG_ELEMENT_SYMBOL)
+{
+  FOG_DOM_ELEMENT_INIT();
+}
+
+SvgSymbolElement::~SvgSymbolElement()
+{
+}
+
+// ============================================================================
+// [Fog::SvgSymbolElement - SVG Interface]
+// ============================================================================
+
+err_t SvgSymbolElement::onProcess(SvgContext* context) const
+{
+  if (!hasChildNodes())
+    return ERR_OK;
+
+  return _visitContainer(context);
+}
+
+// ============================================================================
+// [Fog::SvgUseElement - Construction / Destruction]
+// ============================================================================
 
 SvgUseElement::SvgUseElement(DomDocument* ownerDocument) :
   SvgTransformableElement(ownerDocument, FOG_S(use), SVG_ELEMENT_USE),
@@ -2745,6 +3947,16 @@ err_t SvgUseElement::onProcess(SvgContext* context) const
   SvgElement* ref = getLinkedElement();
   if (ref == NULL)
     return ERR_OK;
+
+  // The referenced element is recorded once and each instance only replays
+  // the record with its own transform.
+  if (context->getContextType() == SVG_CONTEXT_RENDER)
+  {
+    err_t err = ref->_renderInstance(static_cast<SvgRenderContext*>(context));
+    if (err != ERR_RT_NOT_IMPLEMENTED)
+      return err;
+  }
+
   return context->onVisit(ref);
 }
 
@@ -3248,12 +4460,13 @@ SvgPathElement::~SvgPathElement()
 // ============================================================================
 
 FOG_CORE_OBJ_DEF(SvgPathElement)
-  FOG_CORE_OBJ_PROPERTY_BASE(D, FOG_S(d), SvgDomIO_PathF())
+  FOG_CORE_OBJ_PROPERTY_ACCESS(D, FOG_S(d), _getDString, _setDString, resetD)
 FOG_CORE_OBJ_END()
 
 err_t SvgPathElement::setD(const PathF& d)
 {
   _d = d;
+  _dString.reset();
   _setDirty();
   
   return ERR_OK;
@@ -3262,28 +4475,61 @@ err_t SvgPathElement::setD(const PathF& d)
 err_t SvgPathElement::resetD()
 {
   _d.reset();
+  _dString.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgPathElement - SVG Properties - Lazy]
+// ============================================================================
+
+err_t SvgPathElement::_getDString(StringW& value) const
+{
+  if (!_dString.isEmpty())
+    return value.set(_dString);
+  else
+    return SvgUtil::serializePath(value, _d);
+}
+
+err_t SvgPathElement::_setDString(const StringW& value)
+{
+  _d.reset();
+  _dString = value;
   _setDirty();
 
   return ERR_OK;
 }
 
+void SvgPathElement::_parseD() const
+{
+  if (SvgUtil::parsePath(_d, _dString) != ERR_OK)
+    _d.reset();
+  _dString.reset();
+}
+
 // ============================================================================
 // [Fog::SvgPathElement - SVG Interface]
 // ============================================================================
 
 err_t SvgPathElement::onProcess(SvgContext* context) const
 {
-  if (!_d.isEmpty())
-    return context->onShape((SvgElement*)this, ShapeF(&_d));
+  const PathF& d = getD();
+
+  if (!d.isEmpty())
+    return context->onShape((SvgElement*)this, ShapeF(&d));
   else
     return ERR_OK;
 }
 
 err_t SvgPathElement::onGeometryBoundingBox(BoxF& box, const TransformF* tr) const
 {
-  if (!_d.isEmpty())
+  const PathF& d = getD();
+
+  if (!d.isEmpty())
   {
-    return _d._getBoundingBox(box, tr);
+    return d._getBoundingBox(box, tr);
   }
   else
   {
@@ -3312,12 +4558,13 @@ SvgPolygonElement::~SvgPolygonElement()
 // ============================================================================
 
 FOG_CORE_OBJ_DEF(SvgPolygonElement)
-  FOG_CORE_OBJ_PROPERTY_BASE(Points, FOG_S(points), SvgDomIO_PointsF(true))
+  FOG_CORE_OBJ_PROPERTY_ACCESS(Points, FOG_S(points), _getPointsString, _setPointsString, resetPoints)
 FOG_CORE_OBJ_END()
 
 err_t SvgPolygonElement::setPoints(const PathF& points)
 {
   _points = points;
+  _pointsString.reset();
   _setDirty();
   
   return ERR_OK;
@@ -3326,28 +4573,61 @@ err_t SvgPolygonElement::setPoints(const PathF& points)
 err_t SvgPolygonElement::resetPoints()
 {
   _points.reset();
+  _pointsString.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgPolygonElement - SVG Properties - Lazy]
+// ============================================================================
+
+err_t SvgPolygonElement::_getPointsString(StringW& value) const
+{
+  if (!_pointsString.isEmpty())
+    return value.set(_pointsString);
+  else
+    return SvgUtil::serializePoints(value, _points);
+}
+
+err_t SvgPolygonElement::_setPointsString(const StringW& value)
+{
+  _points.reset();
+  _pointsString = value;
   _setDirty();
 
   return ERR_OK;
 }
 
+void SvgPolygonElement::_parsePoints() const
+{
+  if (SvgUtil::parsePoints(_points, _pointsString, true) != ERR_OK)
+    _points.reset();
+  _pointsString.reset();
+}
+
 // ============================================================================
 // [Fog::SvgPolygonElement - SVG Interface]
 // ============================================================================
 
 err_t SvgPolygonElement::onProcess(SvgContext* context) const
 {
-  if (!_points.isEmpty())
-    return context->onShape((SvgElement*)this, ShapeF(&_points));
+  const PathF& points = getPoints();
+
+  if (!points.isEmpty())
+    return context->onShape((SvgElement*)this, ShapeF(&points));
   else
     return ERR_OK;
 }
 
 err_t SvgPolygonElement::onGeometryBoundingBox(BoxF& box, const TransformF* tr) const
 {
-  if (!_points.isEmpty())
+  const PathF& points = getPoints();
+
+  if (!points.isEmpty())
   {
-    return _points._getBoundingBox(box, tr);
+    return points._getBoundingBox(box, tr);
   }
   else
   {
@@ -3376,12 +4656,13 @@ SvgPolylineElement::~SvgPolylineElement()
 // ============================================================================
 
 FOG_CORE_OBJ_DEF(SvgPolylineElement)
-  FOG_CORE_OBJ_PROPERTY_BASE(Points, FOG_S(points), SvgDomIO_PointsF(false))
+  FOG_CORE_OBJ_PROPERTY_ACCESS(Points, FOG_S(points), _getPointsString, _setPointsString, resetPoints)
 FOG_CORE_OBJ_END()
 
 err_t SvgPolylineElement::setPoints(const PathF& points)
 {
   _points = points;
+  _pointsString.reset();
   _setDirty();
   
   return ERR_OK;
@@ -3390,28 +4671,61 @@ err_t SvgPolylineElement::setPoints(const PathF& points)
 err_t SvgPolylineElement::resetPoints()
 {
   _points.reset();
+  _pointsString.reset();
+  _setDirty();
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgPolylineElement - SVG Properties - Lazy]
+// ============================================================================
+
+err_t SvgPolylineElement::_getPointsString(StringW& value) const
+{
+  if (!_pointsString.isEmpty())
+    return value.set(_pointsString);
+  else
+    return SvgUtil::serializePoints(value, _points);
+}
+
+err_t SvgPolylineElement::_setPointsString(const StringW& value)
+{
+  _points.reset();
+  _pointsString = value;
   _setDirty();
 
   return ERR_OK;
 }
 
+void SvgPolylineElement::_parsePoints() const
+{
+  if (SvgUtil::parsePoints(_points, _pointsString, false) != ERR_OK)
+    _points.reset();
+  _pointsString.reset();
+}
+
 // ============================================================================
 // [Fog::SvgPolylineElement - SVG Interface]
 // ============================================================================
 
 err_t SvgPolylineElement::onProcess(SvgContext* context) const
 {
-  if (!_points.isEmpty())
-    return context->onShape((SvgElement*)this, ShapeF(&_points));
+  const PathF& points = getPoints();
+
+  if (!points.isEmpty())
+    return context->onShape((SvgElement*)this, ShapeF(&points));
   else
     return ERR_OK;
 }
 
 err_t SvgPolylineElement::onGeometryBoundingBox(BoxF& box, const TransformF* tr) const
 {
-  if (!_points.isEmpty())
+  const PathF& points = getPoints();
+
+  if (!points.isEmpty())
   {
-    return _points._getBoundingBox(box, tr);
+    return points._getBoundingBox(box, tr);
   }
   else
   {
@@ -3837,11 +5151,13 @@ err_t SvgImageElement::resetHref()
 err_t SvgImageElement::onPrepare(SvgContext* context, SvgContextGState* state) const
 {
   // There is only transformation attribute which can be applied to the image.
-  if (!_transform.isIdentity())
+  const TransformF& transform = getTransform();
+
+  if (!transform.isIdentity())
   {
     if (state && !state->hasState(SvgContextGState::SAVED_TRANSFORM))
       state->saveTransform();
-    context->transform(_transform);
+    context->transform(transform);
   }
 
   return ERR_OK;
@@ -4134,7 +5450,10 @@ err_t SvgAElement::onProcess(SvgContext* context) const
 // ============================================================================
 
 SvgDocument::SvgDocument() :
-  _dpi(96.0f)
+  _dpi(96.0f),
+  _version(0),
+  _styleVersion(0),
+  _computedStyleCache(NULL)
 {
   _nodeFlags |= DOM_NODE_FLAG_IS_SVG;
   _objectType = SVG_ELEMENT_NONE;
@@ -4142,6 +5461,8 @@ SvgDocument::SvgDocument() :
 
 SvgDocument::~SvgDocument()
 {
+  if (_computedStyleCache != NULL)
+    fog_delete(_computedStyleCache);
 }
 
 // ============================================================================
@@ -4159,6 +5480,19 @@ DomElement* SvgDocument::_createElement(const InternedStringW& tagName)
   if (tagName == FOG_S(circle        )) return _newElementT<SvgCircleElement>();
   if (tagName == FOG_S(defs          )) return _newElementT<SvgDefsElement>();
   if (tagName == FOG_S(ellipse       )) return _newElementT<SvgEllipseElement>();
+  if (tagName == FOG_S(feColorMatrix )) return _newElementT<SvgFeColorMatrixElement>();
+  if (tagName == FOG_S(feComponentTransfer)) return _newElementT<SvgFeComponentTransferElement>();
+  if (tagName == FOG_S(feFuncA       )) return _newElementT<SvgFeFuncElement>(tagName);
+  if (tagName == FOG_S(feFuncB       )) return _newElementT<SvgFeFuncElement>(tagName);
+  if (tagName == FOG_S(feFuncG       )) return _newElementT<SvgFeFuncElement>(tagName);
+  if (tagName == FOG_S(feFuncR       )) return _newElementT<SvgFeFuncElement>(tagName);
+  if (tagName == FOG_S(feGaussianBlur)) return _newElementT<SvgFeGaussianBlurElement>();
+  if (tagName == FOG_S(feMerge       )) return _newElementT<SvgFeMergeElement>();
+  if (tagName == FOG_S(feMergeNode   )) return _newElementT<SvgFeMergeNodeElement>();
+  if (tagName == FOG_S(feMorphology  )) return _newElementT<SvgFeMorphologyElement>();
+  if (tagName == FOG_S(feOffset      )) return _newElementT<SvgFeOffsetElement>();
+  if (tagName == FOG_S(feTurbulence  )) return _newElementT<SvgFeTurbulenceElement>();
+  if (tagName == FOG_S(filter        )) return _newElementT<SvgFilterElement>();
   if (tagName == FOG_S(g             )) return _newElementT<SvgGElement>();
   if (tagName == FOG_S(image         )) return _newElementT<SvgImageElement>();
   if (tagName == FOG_S(line          )) return _newElementT<SvgLineElement>();
@@ -4183,6 +5517,262 @@ DomElement* SvgDocument::_createElement(const InternedStringW& tagName)
   return Base::_createElement(tagName);
 }
 
+DomSaxHandler* SvgDocument::_createSaxHandler()
+{
+  return fog_new SvgSaxHandler(this);
+}
+
+// ============================================================================
+// [Fog::SvgDocument - Write]
+// ============================================================================
+
+// Parsed path data, points and transforms are serialized directly to UTF-8,
+// attributes not parsed yet are written as they were read.
+
+static FOG_INLINE bool SvgDocument_isTransform(const DomElement* element, size_t index)
+{
+  PropertyInfo info;
+
+  return index == SvgTransformableElement::PROPERTY_Transform &&
+         element->_getPropertyInfo(index, info) == ERR_OK &&
+         info.getName() == FOG_S(transform);
+}
+
+bool SvgDocument::_serializeValue(const DomElement* element, size_t index,
+  StringA& dst) const
+{
+  if (!element->isSvg() || index >= element->_objectPropertyCount)
+    return false;
+
+  dst.clear();
+
+  switch (element->_objectType)
+  {
+    case SVG_ELEMENT_PATH:
+      if (index == SvgPathElement::PROPERTY_D)
+      {
+        const SvgPathElement* e = static_cast<const SvgPathElement*>(element);
+        return e->_dString.isEmpty() && !e->_d.isEmpty() &&
+               SvgUtil::serializePath(dst, e->_d) == ERR_OK;
+      }
+      break;
+
+    case SVG_ELEMENT_POLYGON:
+      if (index == SvgPolygonElement::PROPERTY_Points)
+      {
+        const SvgPolygonElement* e = static_cast<const SvgPolygonElement*>(element);
+        return e->_pointsString.isEmpty() && !e->_points.isEmpty() &&
+               SvgUtil::serializePoints(dst, e->_points) == ERR_OK;
+      }
+      break;
+
+    case SVG_ELEMENT_POLYLINE:
+      if (index == SvgPolylineElement::PROPERTY_Points)
+      {
+        const SvgPolylineElement* e = static_cast<const SvgPolylineElement*>(element);
+        return e->_pointsString.isEmpty() && !e->_points.isEmpty() &&
+               SvgUtil::serializePoints(dst, e->_points) == ERR_OK;
+      }
+      break;
+  }
+
+  if (SvgDocument_isTransform(element, index))
+  {
+    const SvgTransformableElement* e = static_cast<const SvgTransformableElement*>(element);
+    return e->_transformString.isEmpty() && e->_transform.getType() != TRANSFORM_TYPE_IDENTITY &&
+           SvgUtil::serializeTransform(dst, e->_transform) == ERR_OK;
+  }
+
+  return false;
+}
+
+// ============================================================================
+// [Fog::SvgDocument - Snapshot]
+// ============================================================================
+
+// Path data, points and transforms are stored parsed, so the snapshot can be
+// read without running SvgUtil parsers. Other attributes are kept as strings.
+
+static bool SvgDocument_encodePath(const PathF& path, uint32_t& type, StringA& data)
+{
+  size_t length = path.getLength();
+  if (length == 0 || length > UINT32_MAX)
+    return false;
+
+  data.clear();
+  char* p = data._add(sizeof(uint32_t) + length * (sizeof(PointF) + sizeof(uint8_t)));
+  if (FOG_IS_NULL(p))
+    return false;
+
+  reinterpret_cast<uint32_t*>(p)[0] = static_cast<uint32_t>(length);
+  p += sizeof(uint32_t);
+
+  MemOps::copy(p, path.getVertices(), length * sizeof(PointF));
+  p += length * sizeof(PointF);
+
+  MemOps::copy(p, path.getCommands(), length * sizeof(uint8_t));
+
+  type = SVG_SNAPSHOT_VALUE_PATH;
+  return true;
+}
+
+static err_t SvgDocument_decodePath(PathF& path, const void* data, size_t size)
+{
+  if (size < sizeof(uint32_t))
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  size_t length = reinterpret_cast<const uint32_t*>(p)[0];
+
+  if ((size - sizeof(uint32_t)) / (sizeof(PointF) + sizeof(uint8_t)) < length)
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+  p += sizeof(uint32_t);
+
+  // Validate commands, a quad and cubic must be followed by their PATH_CMD_DATA
+  // vertices, otherwise the path can't be safely iterated.
+  const uint8_t* commands = p + length * sizeof(PointF);
+  size_t i = 0;
+
+  while (i < length)
+  {
+    size_t count;
+
+    switch (commands[i])
+    {
+      case PATH_CMD_MOVE_TO:
+      case PATH_CMD_LINE_TO:
+      case PATH_CMD_CLOSE:
+        count = 1;
+        break;
+
+      case PATH_CMD_QUAD_TO:
+        count = 2;
+        break;
+
+      case PATH_CMD_CUBIC_TO:
+        count = 3;
+        break;
+
+      default:
+        return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+    }
+
+    if (length - i < count)
+      return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+    for (size_t j = 1; j < count; j++)
+    {
+      if (commands[i + j] != PATH_CMD_DATA)
+        return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+    }
+
+    i += count;
+  }
+
+  FOG_RETURN_ON_ERROR(path.reserve(length));
+  if (path._add(length) == INVALID_INDEX)
+    return ERR_RT_OUT_OF_MEMORY;
+
+  MemOps::copy(path.getVerticesX(), p, length * sizeof(PointF));
+  p += length * sizeof(PointF);
+
+  MemOps::copy(path.getCommandsX(), p, length * sizeof(uint8_t));
+  path._modified();
+
+  return ERR_OK;
+}
+
+bool SvgDocument::_encodeSnapshotValue(const DomElement* element, size_t index,
+  uint32_t& type, StringA& data) const
+{
+  if (!element->isSvg() || index >= element->_objectPropertyCount)
+    return false;
+
+  switch (element->_objectType)
+  {
+    case SVG_ELEMENT_PATH:
+      if (index == SvgPathElement::PROPERTY_D)
+        return SvgDocument_encodePath(static_cast<const SvgPathElement*>(element)->getD(), type, data);
+      break;
+
+    case SVG_ELEMENT_POLYGON:
+      if (index == SvgPolygonElement::PROPERTY_Points)
+        return SvgDocument_encodePath(static_cast<const SvgPolygonElement*>(element)->getPoints(), type, data);
+      break;
+
+    case SVG_ELEMENT_POLYLINE:
+      if (index == SvgPolylineElement::PROPERTY_Points)
+        return SvgDocument_encodePath(static_cast<const SvgPolylineElement*>(element)->getPoints(), type, data);
+      break;
+  }
+
+  if (SvgDocument_isTransform(element, index))
+  {
+    const TransformF& transform = static_cast<const SvgTransformableElement*>(element)->getTransform();
+    if (transform.getType() == TRANSFORM_TYPE_IDENTITY)
+      return false;
+
+    data.clear();
+    if (data.append(reinterpret_cast<const char*>(transform.getData()), 9 * sizeof(float)) != ERR_OK)
+      return false;
+
+    type = SVG_SNAPSHOT_VALUE_TRANSFORM;
+    return true;
+  }
+
+  return false;
+}
+
+err_t SvgDocument::_decodeSnapshotValue(DomElement* element, const InternedStringW& name,
+  uint32_t type, const void* data, size_t size)
+{
+  if (!element->isSvg())
+    return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+
+  size_t index = element->_getPropertyIndex(name);
+
+  switch (type)
+  {
+    case SVG_SNAPSHOT_VALUE_PATH:
+    {
+      PathF path;
+
+      switch (element->_objectType)
+      {
+        case SVG_ELEMENT_PATH:
+          if (index != SvgPathElement::PROPERTY_D)
+            break;
+          FOG_RETURN_ON_ERROR(SvgDocument_decodePath(path, data, size));
+          return static_cast<SvgPathElement*>(element)->setD(path);
+
+        case SVG_ELEMENT_POLYGON:
+          if (index != SvgPolygonElement::PROPERTY_Points)
+            break;
+          FOG_RETURN_ON_ERROR(SvgDocument_decodePath(path, data, size));
+          return static_cast<SvgPolygonElement*>(element)->setPoints(path);
+
+        case SVG_ELEMENT_POLYLINE:
+          if (index != SvgPolylineElement::PROPERTY_Points)
+            break;
+          FOG_RETURN_ON_ERROR(SvgDocument_decodePath(path, data, size));
+          return static_cast<SvgPolylineElement*>(element)->setPoints(path);
+      }
+      break;
+    }
+
+    case SVG_SNAPSHOT_VALUE_TRANSFORM:
+    {
+      if (size != 9 * sizeof(float) || !SvgDocument_isTransform(element, index))
+        break;
+
+      TransformF transform(reinterpret_cast<const float*>(data));
+      return static_cast<SvgTransformableElement*>(element)->setTransform(transform);
+    }
+  }
+
+  return ERR_DOM_SNAPSHOT_INVALID_FORMAT;
+}
+
 // ============================================================================
 // [Fog::SvgDocument - SVG Interface]
 // ============================================================================
@@ -4199,6 +5789,8 @@ SvgContextExtension* SvgDocument::_createContextExtension(const SvgContextExtens
 
 err_t SvgDocument::setDpi(float dpi)
 {
+  _version++;
+  _styleVersion++;
   return _dpi.setDpi(dpi);
 }
 
@@ -65,8 +65,31 @@ struct FOG_API SvgElement : public DomElement
   err_t getBoundingBox(BoxF& box) const;
   err_t getBoundingBox(BoxF& box, const TransformF* tr) const;
 
-  // TODO:
-  FOG_INLINE void _setDirty() {}
+  //! @brief Called when the element (its property, style or children) has
+  //! been changed, invalidates caches of the element and its ancestors.
+  void _setDirty();
+
+  // --------------------------------------------------------------------------
+  // [SVG Instance]
+  // --------------------------------------------------------------------------
+
+  //! @brief Render the element referenced by \<use\> from its retained
+  //! record, returns @c ERR_RT_NOT_IMPLEMENTED if it must be rendered directly.
+  err_t _renderInstance(SvgRenderContext* context) const;
+  void _resetInstance() const;
+
+  // --------------------------------------------------------------------------
+  // [SVG Computed Style]
+  // --------------------------------------------------------------------------
+
+  void _resetComputedStyle() const;
+
+  // --------------------------------------------------------------------------
+  // [Events]
+  // --------------------------------------------------------------------------
+
+  virtual void _onChildAdd(DomNode* firstNode, DomNode* lastNode) override;
+  virtual void _onChildRemove(DomNode* firstNode, DomNode* lastNode) override;
 
   // --------------------------------------------------------------------------
   // [Visible]
@@ -81,6 +104,16 @@ struct FOG_API SvgElement : public DomElement
 
   mutable BoxF _computedBoundingBox;
 
+  //! @brief Retained records used by \<use\> (created on demand).
+  mutable SvgInstance* _instance;
+
+  //! @brief Computed style (stylable elements only).
+  mutable const SvgComputedStyle* _computedStyle;
+  //! @brief Computed style of the parent @c _computedStyle was resolved for.
+  mutable const SvgComputedStyle* _computedParent;
+  //! @brief Document version @c _computedStyle was resolved at.
+  mutable uint32_t _computedVersion;
+
   mutable uint8_t _boundingBoxDirty;
   uint8_t _visible;
   uint8_t _unused_0;
@@ -145,6 +178,7 @@ struct FOG_API SvgStyleData
   StringW fontFamily;
   StringW fillUri;
   StringW strokeUri;
+  StringW filterUri;
 
 private:
   FOG_NO_COPY(SvgStyleData)
@@ -399,7 +433,7 @@ struct FOG_API SvgStyle : public DomObj
   { \
     typedef StringW Type; \
     enum { ID = PROPERTY_##_PropertyName_ }; \
-    enum { FLAGS = Fog::NO_FLAGS }; \
+    enum { FLAGS = Fog::PROPERTY_FLAG_OVERLAPS }; \
   };
 
 //! @internal
@@ -519,10 +553,27 @@ struct FOG_API SvgTransformableElement : public SvgStylableElement
     FOG_PROPERTY_RW(Transform, TransformF)
   FOG_PROPERTY_END()
 
-  FOG_INLINE const TransformF& getTransform() const { return _transform; }
+  FOG_INLINE const TransformF& getTransform() const
+  {
+    if (!_transformString.isEmpty())
+      _parseTransform();
+    return _transform;
+  }
+
   err_t setTransform(const TransformF& transform);
   err_t resetTransform();
 
+  // --------------------------------------------------------------------------
+  // [SVG Properties - Lazy]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the "transform" attribute, serialized only if it was parsed.
+  err_t _getTransformString(StringW& value) const;
+  //! @brief Set the "transform" attribute, it's parsed on the first use.
+  err_t _setTransformString(const StringW& value);
+  //! @brief Parse the pending "transform" attribute.
+  void _parseTransform() const;
+
   // --------------------------------------------------------------------------
   // [SVG Interface]
   // --------------------------------------------------------------------------
@@ -533,7 +584,10 @@ struct FOG_API SvgTransformableElement : public SvgStylableElement
   // [Members]
   // --------------------------------------------------------------------------
 
-  TransformF _transform;
+  //! @brief Transform (valid if @c _transformString is empty).
+  mutable TransformF _transform;
+  //! @brief Transform not parsed yet.
+  mutable StringW _transformString;
 };
 
 // ============================================================================
@@ -904,6 +958,18 @@ struct FOG_API SvgPatternElement : public SvgElement
 
   err_t _createPattern(Pattern& pattern, SvgElement* obj) const;
 
+  // --------------------------------------------------------------------------
+  // [Tile Cache]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reset the rendered tile (called by @ref SvgElement::_setDirty()
+  //! when the pattern or its subtree has been changed).
+  FOG_INLINE void _resetTileCache() const
+  {
+    _tileCache.reset();
+    _tileCacheSize.reset();
+  }
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -911,6 +977,13 @@ struct FOG_API SvgPatternElement : public SvgElement
   TransformF _patternTransform;
   BoxF _viewBox;
 
+  //! @brief Rendered pattern tile, shared by all elements using the pattern.
+  mutable Image _tileCache;
+  //! @brief Size of the rendered tile (part of the cache key).
+  mutable SizeI _tileCacheSize;
+  //! @brief Document version the tile was rendered at (part of the cache key).
+  mutable uint32_t _tileCacheVersion;
+
   float _x;
   float _y;
   float _width;
@@ -924,6 +997,552 @@ struct FOG_API SvgPatternElement : public SvgElement
   uint32_t _patternUnits : 4;
 };
 
+// ============================================================================
+// [Fog::SvgFilterElement]
+// ============================================================================
+
+//! @brief SVG filter element - \<filter\>.
+//!
+//! The filter primitives (children) are compiled into @ref SvgFilterPlan,
+//! which is cached until the filter or its subtree is changed.
+struct FOG_API SvgFilterElement : public SvgElement
+{
+  FOG_DOM_OBJ(SvgFilterElement, SvgElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFilterElement(DomDocument* ownerDocument);
+  virtual ~SvgFilterElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(X, CoordF)
+    FOG_PROPERTY_RW(Y, CoordF)
+    FOG_PROPERTY_RW(Width, CoordF)
+    FOG_PROPERTY_RW(Height, CoordF)
+    FOG_PROPERTY_RW(FilterUnits, uint32_t)
+    FOG_PROPERTY_RW(PrimitiveUnits, uint32_t)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE CoordF getX() const { return CoordF(_x, _xUnit); }
+  err_t setX(const CoordF& x);
+  err_t resetX();
+
+  FOG_INLINE CoordF getY() const { return CoordF(_y, _yUnit); }
+  err_t setY(const CoordF& y);
+  err_t resetY();
+
+  FOG_INLINE CoordF getWidth() const { return CoordF(_width, _widthUnit); }
+  err_t setWidth(const CoordF& width);
+  err_t resetWidth();
+
+  FOG_INLINE CoordF getHeight() const { return CoordF(_height, _heightUnit); }
+  err_t setHeight(const CoordF& height);
+  err_t resetHeight();
+
+  FOG_INLINE uint32_t getFilterUnits() const { return _filterUnits; }
+  err_t setFilterUnits(uint32_t filterUnits);
+  err_t resetFilterUnits();
+
+  FOG_INLINE uint32_t getPrimitiveUnits() const { return _primitiveUnits; }
+  err_t setPrimitiveUnits(uint32_t primitiveUnits);
+  err_t resetPrimitiveUnits();
+
+  // --------------------------------------------------------------------------
+  // [SVG Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onProcess(SvgContext* context) const override;
+
+  //! @brief Get the filter region of @a obj (in user space of @a obj).
+  err_t getFilterRegion(BoxF& dst, const SvgElement* obj) const;
+
+  //! @brief Render @a obj through the filter (called by @ref SvgRenderContext
+  //! after @a obj has been prepared).
+  err_t _render(SvgRenderContext* context, const SvgElement* obj) const;
+
+  // --------------------------------------------------------------------------
+  // [Plan]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the compiled filter, compile it if not cached.
+  SvgFilterPlan* _getPlan() const;
+
+  //! @brief Reset the compiled filter and its buffers (called by
+  //! @ref SvgElement::_setDirty() when the filter or its subtree has been
+  //! changed).
+  void _resetPlan() const;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Compiled filter (cached).
+  mutable SvgFilterPlan* _plan;
+
+  float _x;
+  float _y;
+  float _width;
+  float _height;
+
+  uint32_t _xUnit : 4;
+  uint32_t _yUnit : 4;
+  uint32_t _widthUnit : 4;
+  uint32_t _heightUnit : 4;
+
+  uint32_t _filterUnits : 4;
+  uint32_t _primitiveUnits : 4;
+};
+
+// ============================================================================
+// [Fog::SvgFePrimitiveElement]
+// ============================================================================
+
+//! @brief SVG filter primitive (base of all fe* elements having 'in' and
+//! 'result' attributes).
+//!
+//! @note This is not the final element, must be overridden.
+struct FOG_API SvgFePrimitiveElement : public SvgElement
+{
+  FOG_DOM_OBJ(SvgFePrimitiveElement, SvgElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFePrimitiveElement(DomDocument* ownerDocument, const InternedStringW& tagName, uint32_t svgType);
+  virtual ~SvgFePrimitiveElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(In, StringW)
+    FOG_PROPERTY_RW(Result, StringW)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE const StringW& getIn() const { return _in; }
+  err_t setIn(const StringW& in);
+  err_t resetIn();
+
+  FOG_INLINE const StringW& getResult() const { return _result; }
+  err_t setResult(const StringW& result);
+  err_t resetResult();
+
+  // --------------------------------------------------------------------------
+  // [SVG Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onProcess(SvgContext* context) const override;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  StringW _in;
+  StringW _result;
+};
+
+// ============================================================================
+// [Fog::SvgFeColorMatrixElement]
+// ============================================================================
+
+//! @brief SVG color matrix filter primitive - \<feColorMatrix\>.
+struct FOG_API SvgFeColorMatrixElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeColorMatrixElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeColorMatrixElement(DomDocument* ownerDocument);
+  virtual ~SvgFeColorMatrixElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(Type, uint32_t)
+    FOG_PROPERTY_RW(Values, List<float>)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE uint32_t getType() const { return _type; }
+  err_t setType(uint32_t type);
+  err_t resetType();
+
+  FOG_INLINE const List<float>& getValues() const { return _values; }
+  err_t setValues(const List<float>& values);
+  err_t resetValues();
+
+  // --------------------------------------------------------------------------
+  // [SVG Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the 5x4 matrix (row-major, SVG layout) defined by the type
+  //! and values.
+  void getMatrix(float* dst) const;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  List<float> _values;
+  uint32_t _type;
+};
+
+// ============================================================================
+// [Fog::SvgFeComponentTransferElement]
+// ============================================================================
+
+//! @brief SVG component transfer filter primitive - \<feComponentTransfer\>.
+//!
+//! Transfer functions are defined by \<feFuncR\>, \<feFuncG\>, \<feFuncB\>
+//! and \<feFuncA\> children.
+struct FOG_API SvgFeComponentTransferElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeComponentTransferElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeComponentTransferElement(DomDocument* ownerDocument);
+  virtual ~SvgFeComponentTransferElement();
+};
+
+// ============================================================================
+// [Fog::SvgFeFuncElement]
+// ============================================================================
+
+//! @brief SVG component transfer function - \<feFuncR\>, \<feFuncG\>,
+//! \<feFuncB\> and \<feFuncA\>.
+struct FOG_API SvgFeFuncElement : public SvgElement
+{
+  FOG_DOM_OBJ(SvgFeFuncElement, SvgElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeFuncElement(DomDocument* ownerDocument, const InternedStringW& tagName);
+  virtual ~SvgFeFuncElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(Type, uint32_t)
+    FOG_PROPERTY_RW(TableValues, List<float>)
+    FOG_PROPERTY_RW(Slope, float)
+    FOG_PROPERTY_RW(Intercept, float)
+    FOG_PROPERTY_RW(Amplitude, float)
+    FOG_PROPERTY_RW(Exponent, float)
+    FOG_PROPERTY_RW(Offset, float)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE uint32_t getType() const { return _type; }
+  err_t setType(uint32_t type);
+  err_t resetType();
+
+  FOG_INLINE const List<float>& getTableValues() const { return _tableValues; }
+  err_t setTableValues(const List<float>& tableValues);
+  err_t resetTableValues();
+
+  FOG_INLINE float getSlope() const { return _slope; }
+  err_t setSlope(float slope);
+  err_t resetSlope();
+
+  FOG_INLINE float getIntercept() const { return _intercept; }
+  err_t setIntercept(float intercept);
+  err_t resetIntercept();
+
+  FOG_INLINE float getAmplitude() const { return _amplitude; }
+  err_t setAmplitude(float amplitude);
+  err_t resetAmplitude();
+
+  FOG_INLINE float getExponent() const { return _exponent; }
+  err_t setExponent(float exponent);
+  err_t resetExponent();
+
+  FOG_INLINE float getOffset() const { return _offset; }
+  err_t setOffset(float offset);
+  err_t resetOffset();
+
+  // --------------------------------------------------------------------------
+  // [SVG Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the component index (@c COLOR_CHANNEL_*) of the function.
+  uint32_t getComponentIndex() const;
+
+  //! @brief Get the transfer function as @ref FeComponentFunction.
+  err_t getComponentFunction(FeComponentFunction& dst) const;
+
+  // --------------------------------------------------------------------------
+  // [SVG Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onProcess(SvgContext* context) const override;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  List<float> _tableValues;
+  uint32_t _type;
+
+  float _slope;
+  float _intercept;
+  float _amplitude;
+  float _exponent;
+  float _offset;
+};
+
+// ============================================================================
+// [Fog::SvgFeGaussianBlurElement]
+// ============================================================================
+
+//! @brief SVG gaussian blur filter primitive - \<feGaussianBlur\>.
+struct FOG_API SvgFeGaussianBlurElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeGaussianBlurElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeGaussianBlurElement(DomDocument* ownerDocument);
+  virtual ~SvgFeGaussianBlurElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(StdDeviation, PointF)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE const PointF& getStdDeviation() const { return _stdDeviation; }
+  err_t setStdDeviation(const PointF& stdDeviation);
+  err_t resetStdDeviation();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  PointF _stdDeviation;
+};
+
+// ============================================================================
+// [Fog::SvgFeMergeElement]
+// ============================================================================
+
+//! @brief SVG merge filter primitive - \<feMerge\>.
+//!
+//! Inputs are defined by \<feMergeNode\> children.
+struct FOG_API SvgFeMergeElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeMergeElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeMergeElement(DomDocument* ownerDocument);
+  virtual ~SvgFeMergeElement();
+};
+
+// ============================================================================
+// [Fog::SvgFeMergeNodeElement]
+// ============================================================================
+
+//! @brief SVG merge node - \<feMergeNode\>.
+struct FOG_API SvgFeMergeNodeElement : public SvgElement
+{
+  FOG_DOM_OBJ(SvgFeMergeNodeElement, SvgElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeMergeNodeElement(DomDocument* ownerDocument);
+  virtual ~SvgFeMergeNodeElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(In, StringW)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE const StringW& getIn() const { return _in; }
+  err_t setIn(const StringW& in);
+  err_t resetIn();
+
+  // --------------------------------------------------------------------------
+  // [SVG Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onProcess(SvgContext* context) const override;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  StringW _in;
+};
+
+// ============================================================================
+// [Fog::SvgFeMorphologyElement]
+// ============================================================================
+
+//! @brief SVG morphology filter primitive - \<feMorphology\>.
+struct FOG_API SvgFeMorphologyElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeMorphologyElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeMorphologyElement(DomDocument* ownerDocument);
+  virtual ~SvgFeMorphologyElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(Operator, uint32_t)
+    FOG_PROPERTY_RW(Radius, PointF)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE uint32_t getOperator() const { return _operator; }
+  err_t setOperator(uint32_t op);
+  err_t resetOperator();
+
+  FOG_INLINE const PointF& getRadius() const { return _radius; }
+  err_t setRadius(const PointF& radius);
+  err_t resetRadius();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  PointF _radius;
+  uint32_t _operator;
+};
+
+// ============================================================================
+// [Fog::SvgFeOffsetElement]
+// ============================================================================
+
+//! @brief SVG offset filter primitive - \<feOffset\>.
+struct FOG_API SvgFeOffsetElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeOffsetElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeOffsetElement(DomDocument* ownerDocument);
+  virtual ~SvgFeOffsetElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(Dx, float)
+    FOG_PROPERTY_RW(Dy, float)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE float getDx() const { return _dx; }
+  err_t setDx(float dx);
+  err_t resetDx();
+
+  FOG_INLINE float getDy() const { return _dy; }
+  err_t setDy(float dy);
+  err_t resetDy();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  float _dx;
+  float _dy;
+};
+
+// ============================================================================
+// [Fog::SvgFeTurbulenceElement]
+// ============================================================================
+
+//! @brief SVG turbulence filter primitive - \<feTurbulence\>.
+struct FOG_API SvgFeTurbulenceElement : public SvgFePrimitiveElement
+{
+  FOG_DOM_OBJ(SvgFeTurbulenceElement, SvgFePrimitiveElement)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFeTurbulenceElement(DomDocument* ownerDocument);
+  virtual ~SvgFeTurbulenceElement();
+
+  // --------------------------------------------------------------------------
+  // [SVG Properties]
+  // --------------------------------------------------------------------------
+
+  FOG_PROPERTY_DEF()
+    FOG_PROPERTY_RW(BaseFrequency, PointF)
+    FOG_PROPERTY_RW(NumOctaves, uint32_t)
+    FOG_PROPERTY_RW(Seed, float)
+    FOG_PROPERTY_RW(StitchTiles, uint32_t)
+    FOG_PROPERTY_RW(Type, uint32_t)
+  FOG_PROPERTY_END()
+
+  FOG_INLINE const PointF& getBaseFrequency() const { return _baseFrequency; }
+  err_t setBaseFrequency(const PointF& baseFrequency);
+  err_t resetBaseFrequency();
+
+  FOG_INLINE uint32_t getNumOctaves() const { return _numOctaves; }
+  err_t setNumOctaves(uint32_t numOctaves);
+  err_t resetNumOctaves();
+
+  FOG_INLINE float getSeed() const { return _seed; }
+  err_t setSeed(float seed);
+  err_t resetSeed();
+
+  FOG_INLINE uint32_t getStitchTiles() const { return _stitchTiles; }
+  err_t setStitchTiles(uint32_t stitchTiles);
+  err_t resetStitchTiles();
+
+  FOG_INLINE uint32_t getType() const { return _type; }
+  err_t setType(uint32_t type);
+  err_t resetType();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  PointF _baseFrequency;
+  float _seed;
+  uint32_t _numOctaves;
+  uint32_t _stitchTiles;
+  uint32_t _type;
+};
+
 // ============================================================================
 // [Fog::SvgStopElement]
 // ============================================================================
@@ -952,6 +1571,11 @@ struct FOG_API SvgStopElement : public SvgStylableElement
   err_t setOffset(float offset);
   err_t resetOffset();
 
+  //! @brief Get the "offset" attribute, empty if it's not assigned.
+  err_t _getOffsetString(StringW& value) const;
+  //! @brief Set the "offset" attribute.
+  err_t _setOffsetString(const StringW& value);
+
   // --------------------------------------------------------------------------
   // [SVG Interface]
   // --------------------------------------------------------------------------
@@ -1366,10 +1990,27 @@ struct FOG_API SvgPathElement : public SvgTransformableElement
     FOG_PROPERTY_RW(D, PathF)
   FOG_PROPERTY_END()
 
-  FOG_INLINE const PathF& getD() const { return _d; }
+  FOG_INLINE const PathF& getD() const
+  {
+    if (!_dString.isEmpty())
+      _parseD();
+    return _d;
+  }
+
   err_t setD(const PathF& d);
   err_t resetD();
 
+  // --------------------------------------------------------------------------
+  // [SVG Properties - Lazy]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the "d" attribute, serialized only if it was parsed.
+  err_t _getDString(StringW& value) const;
+  //! @brief Set the "d" attribute, it's parsed on the first use.
+  err_t _setDString(const StringW& value);
+  //! @brief Parse the pending "d" attribute.
+  void _parseD() const;
+
   // --------------------------------------------------------------------------
   // [SVG Interface]
   // --------------------------------------------------------------------------
@@ -1381,7 +2022,10 @@ struct FOG_API SvgPathElement : public SvgTransformableElement
   // [SVG Attributes]
   // --------------------------------------------------------------------------
 
-  PathF _d;
+  //! @brief Path data (valid if @c _dString is empty).
+  mutable PathF _d;
+  //! @brief Path data not parsed yet.
+  mutable StringW _dString;
 };
 
 // ============================================================================
@@ -1408,10 +2052,27 @@ struct FOG_API SvgPolygonElement : public SvgTransformableElement
     FOG_PROPERTY_RW(Points, PathF)
   FOG_PROPERTY_END()
 
-  FOG_INLINE const PathF& getPoints() const { return _points; }
+  FOG_INLINE const PathF& getPoints() const
+  {
+    if (!_pointsString.isEmpty())
+      _parsePoints();
+    return _points;
+  }
+
   err_t setPoints(const PathF& points);
   err_t resetPoints();
 
+  // --------------------------------------------------------------------------
+  // [SVG Properties - Lazy]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the "points" attribute, serialized only if it was parsed.
+  err_t _getPointsString(StringW& value) const;
+  //! @brief Set the "points" attribute, it's parsed on the first use.
+  err_t _setPointsString(const StringW& value);
+  //! @brief Parse the pending "points" attribute.
+  void _parsePoints() const;
+
   // --------------------------------------------------------------------------
   // [SVG Interface]
   // --------------------------------------------------------------------------
@@ -1423,7 +2084,10 @@ struct FOG_API SvgPolygonElement : public SvgTransformableElement
   // [SVG Attributes]
   // --------------------------------------------------------------------------
 
-  PathF _points;
+  //! @brief Points (valid if @c _pointsString is empty).
+  mutable PathF _points;
+  //! @brief Points not parsed yet.
+  mutable StringW _pointsString;
 };
 
 // ============================================================================
@@ -1450,10 +2114,27 @@ struct FOG_API SvgPolylineElement : public SvgTransformableElement
     FOG_PROPERTY_RW(Points, PathF)
   FOG_PROPERTY_END()
 
-  FOG_INLINE const PathF& getPoints() const { return _points; }
+  FOG_INLINE const PathF& getPoints() const
+  {
+    if (!_pointsString.isEmpty())
+      _parsePoints();
+    return _points;
+  }
+
   err_t setPoints(const PathF& points);
   err_t resetPoints();
 
+  // --------------------------------------------------------------------------
+  // [SVG Properties - Lazy]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the "points" attribute, serialized only if it was parsed.
+  err_t _getPointsString(StringW& value) const;
+  //! @brief Set the "points" attribute, it's parsed on the first use.
+  err_t _setPointsString(const StringW& value);
+  //! @brief Parse the pending "points" attribute.
+  void _parsePoints() const;
+
   // --------------------------------------------------------------------------
   // [SVG Interface]
   // --------------------------------------------------------------------------
@@ -1465,7 +2146,10 @@ struct FOG_API SvgPolylineElement : public SvgTransformableElement
   // [SVG Attributes]
   // --------------------------------------------------------------------------
 
-  PathF _points;
+  //! @brief Points (valid if @c _pointsString is empty).
+  mutable PathF _points;
+  //! @brief Points not parsed yet.
+  mutable StringW _pointsString;
 };
 
 // ============================================================================
@@ -1792,6 +2476,15 @@ struct FOG_API SvgDocument : public DomDocument
 
   virtual DomDocument* _createDocument() override;
   virtual DomElement* _createElement(const InternedStringW& tagName) override;
+  virtual DomSaxHandler* _createSaxHandler() override;
+
+  virtual bool _serializeValue(const DomElement* element, size_t index,
+    StringA& dst) const override;
+
+  virtual bool _encodeSnapshotValue(const DomElement* element, size_t index,
+    uint32_t& type, StringA& data) const override;
+  virtual err_t _decodeSnapshotValue(DomElement* element, const InternedStringW& name,
+    uint32_t type, const void* data, size_t size) override;
 
   // --------------------------------------------------------------------------
   // [SVG Interface]
@@ -1822,6 +2515,16 @@ struct FOG_API SvgDocument : public DomDocument
   // --------------------------------------------------------------------------
 
   Dpi _dpi;
+
+  //! @brief Incremented on each change of the document, see
+  //! @ref SvgElement::_setDirty().
+  uint32_t _version;
+  //! @brief Incremented when all computed styles must be resolved again (DPI
+  //! change).
+  uint32_t _styleVersion;
+
+  //! @brief Interned computed styles (created on demand).
+  SvgComputedStyleCache* _computedStyleCache;
 };
 
 //! @}
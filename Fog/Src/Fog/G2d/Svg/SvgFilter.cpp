@@ -0,0 +1,1399 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemBuffer.h>
+#include <Fog/Core/Memory/MemBufferTmp_p.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Acc/AccC.h>
+#include <Fog/G2d/Imaging/ImageFilterScale.h>
+#include <Fog/G2d/Imaging/Filters/FeBlur.h>
+#include <Fog/G2d/Imaging/Filters/FeColorLutArray.h>
+#include <Fog/G2d/Imaging/Filters/FeComponentFunction.h>
+#include <Fog/G2d/Painting/Painter.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterStructs_p.h>
+#include <Fog/G2d/Svg/SvgContext.h>
+#include <Fog/G2d/Svg/SvgDom.h>
+#include <Fog/G2d/Svg/SvgFilter_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::SvgFilter - Helpers]
+// ============================================================================
+
+static FOG_INLINE void SvgFilter_setIdentityMatrix(float* m)
+{
+  for (uint32_t i = 0; i < 20; i++)
+    m[i] = (i % 6) == 0 ? 1.0f : 0.0f;
+}
+
+static FOG_INLINE void SvgFilter_setIdentityLut(uint8_t* lut)
+{
+  for (uint32_t i = 0; i < 256; i++)
+    lut[i] = (uint8_t)i;
+}
+
+//! @internal
+//!
+//! @brief Compose two 5x4 color matrices, dst = a * b (b is applied first).
+static void SvgFilter_multiplyMatrix(float* dst, const float* a, const float* b)
+{
+  float t[20];
+
+  for (uint32_t r = 0; r < 4; r++)
+  {
+    const float* ar = a + r * 5;
+
+    for (uint32_t c = 0; c < 5; c++)
+    {
+      t[r * 5 + c] = ar[0] * b[c     ] +
+                     ar[1] * b[c +  5] +
+                     ar[2] * b[c + 10] +
+                     ar[3] * b[c + 15] + (c == 4 ? ar[4] : 0.0f);
+    }
+  }
+
+  for (uint32_t i = 0; i < 20; i++)
+    dst[i] = t[i];
+}
+
+//! @internal
+//!
+//! @brief Get whether the color matrix @a m maps all colors into the [0, 1]
+//! range, so the result doesn't need to be clamped.
+static bool SvgFilter_isMatrixBounded(const float* m)
+{
+  for (uint32_t r = 0; r < 4; r++)
+  {
+    const float* mr = m + r * 5;
+
+    float lo = mr[4];
+    float hi = mr[4];
+
+    for (uint32_t c = 0; c < 4; c++)
+    {
+      if (mr[c] < 0.0f)
+        lo += mr[c];
+      else
+        hi += mr[c];
+    }
+
+    if (lo < 0.0f || hi > 1.0f)
+      return false;
+  }
+
+  return true;
+}
+
+static FOG_INLINE bool SvgFilter_isEmpty(const BoxI& box)
+{
+  return !box.isValid();
+}
+
+static FOG_INLINE void SvgFilter_unite(BoxI& dst, const BoxI& src)
+{
+  if (!src.isValid())
+    return;
+
+  if (!dst.isValid())
+  {
+    dst = src;
+  }
+  else
+  {
+    dst.x0 = Math::min(dst.x0, src.x0);
+    dst.y0 = Math::min(dst.y0, src.y0);
+    dst.x1 = Math::max(dst.x1, src.x1);
+    dst.y1 = Math::max(dst.y1, src.y1);
+  }
+}
+
+static FOG_INLINE BoxI SvgFilter_expand(const BoxI& box, int x, int y)
+{
+  return BoxI(box.x0 - x, box.y0 - y, box.x1 + x, box.y1 + y);
+}
+
+//! @internal
+//!
+//! @brief Get radii of three box-blur passes which approximate the gaussian
+//! blur of @a sigma (in pixels), as recommended by SVG specification.
+static void SvgFilter_getBoxRadii(int* r, float sigma)
+{
+  // d = floor(sigma * 3 * sqrt(2 * PI) / 4 + 0.5).
+  int d = sigma > 0.0f ? (int)Math::floor(sigma * 1.87997120597f + 0.5f) : 0;
+
+  if (d <= 1)
+  {
+    r[0] = r[1] = r[2] = 0;
+  }
+  else if (d & 1)
+  {
+    r[0] = r[1] = r[2] = (d - 1) / 2;
+  }
+  else
+  {
+    r[0] = d / 2;
+    r[1] = d / 2 - 1;
+    r[2] = d / 2;
+  }
+}
+
+// ============================================================================
+// [Fog::SvgFilterStep - Construction / Destruction]
+// ============================================================================
+
+SvgFilterStep::SvgFilterStep() :
+  op(SVG_FILTER_OP_POINTWISE),
+  flags(NO_FLAGS),
+  input(SVG_FILTER_SOURCE_GRAPHIC),
+  mergeIndex(0),
+  mergeCount(0),
+  buffer(SVG_FILTER_INVALID),
+  scratch(SVG_FILTER_INVALID),
+  params(0.0f, 0.0f),
+  morphologyType(FE_MORPHOLOGY_TYPE_ERODE),
+  roi(0, 0, 0, 0),
+  turbulence()
+{
+  SvgFilter_setIdentityMatrix(matrix);
+
+  for (uint32_t c = 0; c < 4; c++)
+    SvgFilter_setIdentityLut(lut[c]);
+}
+
+// ============================================================================
+// [Fog::SvgFilterPlan - Construction / Destruction]
+// ============================================================================
+
+SvgFilterPlan::SvgFilterPlan() :
+  _output(SVG_FILTER_SOURCE_GRAPHIC),
+  _bufferCount(0)
+{
+}
+
+SvgFilterPlan::~SvgFilterPlan()
+{
+  reset();
+
+  ListIterator<Image*> it(_buffers);
+  while (it.isValid())
+  {
+    fog_delete(it.getItem());
+    it.next();
+  }
+}
+
+// ============================================================================
+// [Fog::SvgFilterPlan - Reset]
+// ============================================================================
+
+void SvgFilterPlan::reset()
+{
+  ListIterator<SvgFilterStep*> it(_steps);
+  while (it.isValid())
+  {
+    fog_delete(it.getItem());
+    it.next();
+  }
+
+  _steps.clear();
+  _mergeInputs.clear();
+
+  _output = SVG_FILTER_SOURCE_GRAPHIC;
+  _bufferCount = 0;
+}
+
+// ============================================================================
+// [Fog::SvgFilterPlan - Compile]
+// ============================================================================
+
+struct FOG_NO_EXPORT SvgFilterCompiler
+{
+  FOG_INLINE SvgFilterCompiler(SvgFilterPlan* plan) :
+    plan(plan),
+    last(SVG_FILTER_SOURCE_GRAPHIC),
+    sourceAlpha(SVG_FILTER_INVALID)
+  {
+  }
+
+  err_t addStep(SvgFilterStep** dst)
+  {
+    SvgFilterStep* step = fog_new SvgFilterStep();
+    if (FOG_IS_NULL(step))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    err_t err = plan->_steps.append(step);
+    if (FOG_IS_ERROR(err))
+    {
+      fog_delete(step);
+      return err;
+    }
+
+    *dst = step;
+    return ERR_OK;
+  }
+
+  err_t resolve(uint32_t& dst, const StringW& in)
+  {
+    if (in.isEmpty())
+    {
+      dst = last;
+      return ERR_OK;
+    }
+
+    if (in == Ascii8("SourceGraphic"))
+    {
+      dst = SVG_FILTER_SOURCE_GRAPHIC;
+      return ERR_OK;
+    }
+
+    if (in == Ascii8("SourceAlpha"))
+    {
+      // SourceAlpha is a pointwise step (which is usually fused with its
+      // consumer), emitted only once.
+      if (sourceAlpha == SVG_FILTER_INVALID)
+      {
+        SvgFilterStep* step;
+        FOG_RETURN_ON_ERROR(addStep(&step));
+
+        for (uint32_t i = 0; i < 20; i++)
+          step->matrix[i] = 0.0f;
+        step->matrix[18] = 1.0f;
+
+        step->op = SVG_FILTER_OP_POINTWISE;
+        step->flags = SVG_FILTER_STEP_MATRIX;
+        step->input = SVG_FILTER_SOURCE_GRAPHIC;
+
+        sourceAlpha = (uint32_t)plan->_steps.getLength();
+      }
+
+      dst = sourceAlpha;
+      return ERR_OK;
+    }
+
+    // Named result, the last definition wins.
+    size_t i = names.getLength();
+    while (i)
+    {
+      if (names.getAt(--i) == in)
+      {
+        dst = values.getAt(i);
+        return ERR_OK;
+      }
+    }
+
+    // Reference to non-existing result, use the previous one.
+    dst = last;
+    return ERR_OK;
+  }
+
+  err_t define(const StringW& result)
+  {
+    last = (uint32_t)plan->_steps.getLength();
+
+    if (result.isEmpty())
+      return ERR_OK;
+
+    FOG_RETURN_ON_ERROR(names.append(result));
+    FOG_RETURN_ON_ERROR(values.append(last));
+
+    return ERR_OK;
+  }
+
+  SvgFilterPlan* plan;
+
+  List<StringW> names;
+  List<uint32_t> values;
+
+  uint32_t last;
+  uint32_t sourceAlpha;
+};
+
+err_t SvgFilterPlan::compile(const SvgFilterElement* filter)
+{
+  reset();
+
+  SvgFilterCompiler compiler(this);
+  DomNode* node;
+
+  // --------------------------------------------------------------------------
+  // [Steps]
+  // --------------------------------------------------------------------------
+
+  for (node = filter->getFirstChild(); node != NULL; node = node->getNextSibling())
+  {
+    if (!node->isSvgNode(DOM_NODE_TYPE_ELEMENT))
+      continue;
+
+    uint32_t objectType = node->_objectType;
+    switch (objectType)
+    {
+      case SVG_ELEMENT_FE_COLOR_MATRIX:
+      case SVG_ELEMENT_FE_COMPONENT_TRANSFER:
+      case SVG_ELEMENT_FE_GAUSSIAN_BLUR:
+      case SVG_ELEMENT_FE_MERGE:
+      case SVG_ELEMENT_FE_MORPHOLOGY:
+      case SVG_ELEMENT_FE_OFFSET:
+      case SVG_ELEMENT_FE_TURBULENCE:
+        break;
+
+      default:
+        // Unsupported primitive.
+        continue;
+    }
+
+    const SvgFePrimitiveElement* fe = static_cast<const SvgFePrimitiveElement*>(node);
+
+    uint32_t input = SVG_FILTER_SOURCE_GRAPHIC;
+    if (objectType != SVG_ELEMENT_FE_MERGE && objectType != SVG_ELEMENT_FE_TURBULENCE)
+      FOG_RETURN_ON_ERROR(compiler.resolve(input, fe->_in));
+
+    uint32_t mergeIndex = (uint32_t)_mergeInputs.getLength();
+    if (objectType == SVG_ELEMENT_FE_MERGE)
+    {
+      for (DomNode* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+      {
+        if (!child->isSvgObject(SVG_ELEMENT_FE_MERGE_NODE))
+          continue;
+
+        uint32_t value;
+        FOG_RETURN_ON_ERROR(compiler.resolve(value, static_cast<const SvgFeMergeNodeElement*>(child)->_in));
+        FOG_RETURN_ON_ERROR(_mergeInputs.append(value));
+      }
+    }
+
+    SvgFilterStep* step;
+    FOG_RETURN_ON_ERROR(compiler.addStep(&step));
+    step->input = input;
+
+    switch (objectType)
+    {
+      case SVG_ELEMENT_FE_COLOR_MATRIX:
+      {
+        step->op = SVG_FILTER_OP_POINTWISE;
+        step->flags = SVG_FILTER_STEP_MATRIX;
+        static_cast<const SvgFeColorMatrixElement*>(fe)->getMatrix(step->matrix);
+        break;
+      }
+
+      case SVG_ELEMENT_FE_COMPONENT_TRANSFER:
+      {
+        step->op = SVG_FILTER_OP_POINTWISE;
+
+        for (DomNode* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+        {
+          if (!child->isSvg())
+            continue;
+
+          switch (child->_objectType)
+          {
+            case SVG_ELEMENT_FE_FUNC_R:
+            case SVG_ELEMENT_FE_FUNC_G:
+            case SVG_ELEMENT_FE_FUNC_B:
+            case SVG_ELEMENT_FE_FUNC_A:
+              break;
+            default:
+              continue;
+          }
+
+          const SvgFeFuncElement* func = static_cast<const SvgFeFuncElement*>(child);
+          FeComponentFunction function;
+          FOG_RETURN_ON_ERROR(func->getComponentFunction(function));
+
+          if (function.resultsInIdentity())
+            continue;
+
+          FeColorLutArray lutArray;
+          FOG_RETURN_ON_ERROR(fog_api.fecolorlutarray_setFromComponentFunction(&lutArray, &function));
+
+          MemOps::copy(step->lut[func->getComponentIndex()], lutArray.getData(), 256);
+          step->flags |= SVG_FILTER_STEP_LUT;
+        }
+        break;
+      }
+
+      case SVG_ELEMENT_FE_GAUSSIAN_BLUR:
+      {
+        step->op = SVG_FILTER_OP_BLUR;
+        step->params = static_cast<const SvgFeGaussianBlurElement*>(fe)->_stdDeviation;
+        break;
+      }
+
+      case SVG_ELEMENT_FE_MERGE:
+      {
+        step->op = SVG_FILTER_OP_MERGE;
+        step->mergeIndex = mergeIndex;
+        step->mergeCount = (uint32_t)_mergeInputs.getLength() - mergeIndex;
+        break;
+      }
+
+      case SVG_ELEMENT_FE_MORPHOLOGY:
+      {
+        const SvgFeMorphologyElement* e = static_cast<const SvgFeMorphologyElement*>(fe);
+
+        step->op = SVG_FILTER_OP_MORPHOLOGY;
+        step->params = e->_radius;
+        step->morphologyType = e->_operator;
+        break;
+      }
+
+      case SVG_ELEMENT_FE_OFFSET:
+      {
+        const SvgFeOffsetElement* e = static_cast<const SvgFeOffsetElement*>(fe);
+
+        step->op = SVG_FILTER_OP_OFFSET;
+        step->params.set(e->_dx, e->_dy);
+        break;
+      }
+
+      case SVG_ELEMENT_FE_TURBULENCE:
+      {
+        const SvgFeTurbulenceElement* e = static_cast<const SvgFeTurbulenceElement*>(fe);
+
+        step->op = SVG_FILTER_OP_TURBULENCE;
+        step->turbulence.setTurbulenceType(e->_type);
+        step->turbulence.setNumOctaves(e->_numOctaves);
+        step->turbulence.setStitchTitles(e->_stitchTiles);
+        step->turbulence.setSeed(Math::iround(e->_seed));
+        step->turbulence.setHorizontalBaseFrequency(e->_baseFrequency.x);
+        step->turbulence.setVerticalBaseFrequency(e->_baseFrequency.y);
+        break;
+      }
+    }
+
+    FOG_RETURN_ON_ERROR(compiler.define(fe->_result));
+  }
+
+  _output = compiler.last;
+  if (_output == SVG_FILTER_SOURCE_GRAPHIC)
+  {
+    reset();
+    return ERR_OK;
+  }
+
+  uint32_t i;
+  uint32_t count = (uint32_t)_steps.getLength();
+  SvgFilterStep** steps = _steps.getDataX();
+
+  // --------------------------------------------------------------------------
+  // [Liveness]
+  // --------------------------------------------------------------------------
+
+  // Use count and last use of each value, followed by the free buffers.
+  MemBufferTmp<1024> memBuffer;
+  uint32_t* useCount = reinterpret_cast<uint32_t*>(memBuffer.alloc((count + 1) * 4 * sizeof(uint32_t)));
+
+  if (FOG_IS_NULL(useCount))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  uint32_t* lastUse = useCount + count + 1;
+  uint32_t* freeList = lastUse + count + 1;
+  uint32_t freeCount = 0;
+
+  // A value is only used by live steps.
+  for (i = 0; i <= count; i++)
+  {
+    useCount[i] = 0;
+    lastUse[i] = SVG_FILTER_INVALID;
+  }
+
+  for (i = 0; i < count; i++)
+    steps[i]->flags |= SVG_FILTER_STEP_DEAD;
+
+  steps[_output - 1]->flags &= ~SVG_FILTER_STEP_DEAD;
+  useCount[_output]++;
+
+  i = count;
+  while (i)
+  {
+    SvgFilterStep* step = steps[--i];
+    if (step->flags & SVG_FILTER_STEP_DEAD)
+      continue;
+
+    if (step->op == SVG_FILTER_OP_MERGE)
+    {
+      for (uint32_t j = 0; j < step->mergeCount; j++)
+      {
+        uint32_t value = _mergeInputs.getAt(step->mergeIndex + j);
+        if (value != SVG_FILTER_SOURCE_GRAPHIC)
+          steps[value - 1]->flags &= ~SVG_FILTER_STEP_DEAD;
+        useCount[value]++;
+      }
+    }
+    else if (step->op != SVG_FILTER_OP_TURBULENCE)
+    {
+      uint32_t value = step->input;
+      if (value != SVG_FILTER_SOURCE_GRAPHIC)
+        steps[value - 1]->flags &= ~SVG_FILTER_STEP_DEAD;
+      useCount[value]++;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Fusion]
+  // --------------------------------------------------------------------------
+
+  // Pointwise step is fused with its pointwise input if the intermediate
+  // result isn't used elsewhere. The fused step is matrix followed by LUT, so
+  // a LUT can't be followed by a matrix. The result of each primitive is
+  // clamped, so two matrices are only composed if the first one can't produce
+  // values out of range.
+  for (i = 0; i < count; i++)
+  {
+    SvgFilterStep* step = steps[i];
+
+    if (step->op != SVG_FILTER_OP_POINTWISE || (step->flags & SVG_FILTER_STEP_DEAD))
+      continue;
+
+    uint32_t value = step->input;
+    if (value == SVG_FILTER_SOURCE_GRAPHIC || useCount[value] != 1)
+      continue;
+
+    SvgFilterStep* prev = steps[value - 1];
+    if (prev->op != SVG_FILTER_OP_POINTWISE)
+      continue;
+
+    if ((prev->flags & SVG_FILTER_STEP_LUT) && (step->flags & SVG_FILTER_STEP_MATRIX))
+      continue;
+
+    if ((prev->flags & SVG_FILTER_STEP_MATRIX) && (step->flags & SVG_FILTER_STEP_MATRIX) &&
+        !SvgFilter_isMatrixBounded(prev->matrix))
+      continue;
+
+    if (prev->flags & SVG_FILTER_STEP_MATRIX)
+    {
+      if (step->flags & SVG_FILTER_STEP_MATRIX)
+        SvgFilter_multiplyMatrix(step->matrix, step->matrix, prev->matrix);
+      else
+        MemOps::copy(step->matrix, prev->matrix, sizeof(step->matrix));
+    }
+
+    if (prev->flags & SVG_FILTER_STEP_LUT)
+    {
+      for (uint32_t c = 0; c < 4; c++)
+      {
+        uint8_t lut[256];
+        const uint8_t* prevLut = prev->lut[c];
+
+        for (uint32_t x = 0; x < 256; x++)
+          lut[x] = step->lut[c][prevLut[x]];
+        MemOps::copy(step->lut[c], lut, 256);
+      }
+    }
+
+    step->flags |= prev->flags & (SVG_FILTER_STEP_MATRIX | SVG_FILTER_STEP_LUT);
+    step->input = prev->input;
+    prev->flags |= SVG_FILTER_STEP_FUSED;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Buffers]
+  // --------------------------------------------------------------------------
+
+  // Last step which reads each value.
+  for (i = 0; i < count; i++)
+  {
+    SvgFilterStep* step = steps[i];
+    if (step->flags & (SVG_FILTER_STEP_DEAD | SVG_FILTER_STEP_FUSED))
+      continue;
+
+    if (step->op == SVG_FILTER_OP_MERGE)
+    {
+      for (uint32_t j = 0; j < step->mergeCount; j++)
+        lastUse[_mergeInputs.getAt(step->mergeIndex + j)] = i;
+    }
+    else if (step->op != SVG_FILTER_OP_TURBULENCE)
+    {
+      lastUse[step->input] = i;
+    }
+  }
+
+  // The result is never released.
+  lastUse[_output] = count;
+
+  // Buffer #0 is SourceGraphic.
+  _bufferCount = 1;
+
+  for (i = 0; i < count; i++)
+  {
+    SvgFilterStep* step = steps[i];
+    if (step->flags & (SVG_FILTER_STEP_DEAD | SVG_FILTER_STEP_FUSED))
+      continue;
+
+    uint32_t input = step->input;
+    uint32_t inputBuffer = input == SVG_FILTER_SOURCE_GRAPHIC ? 0 : steps[input - 1]->buffer;
+
+    if (step->op == SVG_FILTER_OP_POINTWISE && lastUse[input] == i)
+    {
+      // In-place.
+      step->buffer = inputBuffer;
+      lastUse[input] = SVG_FILTER_INVALID;
+    }
+    else
+    {
+      step->buffer = freeCount ? freeList[--freeCount] : _bufferCount++;
+    }
+
+    if (step->op == SVG_FILTER_OP_BLUR || step->op == SVG_FILTER_OP_MORPHOLOGY)
+    {
+      step->scratch = freeCount ? freeList[--freeCount] : _bufferCount++;
+      freeList[freeCount++] = step->scratch;
+    }
+
+    // Release inputs which die here.
+    if (step->op == SVG_FILTER_OP_MERGE)
+    {
+      for (uint32_t j = 0; j < step->mergeCount; j++)
+      {
+        uint32_t value = _mergeInputs.getAt(step->mergeIndex + j);
+        if (lastUse[value] == i)
+        {
+          freeList[freeCount++] = value == SVG_FILTER_SOURCE_GRAPHIC ? 0 : steps[value - 1]->buffer;
+          lastUse[value] = SVG_FILTER_INVALID;
+        }
+      }
+    }
+    else if (step->op != SVG_FILTER_OP_TURBULENCE && lastUse[input] == i)
+    {
+      freeList[freeCount++] = inputBuffer;
+      lastUse[input] = SVG_FILTER_INVALID;
+    }
+  }
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFilterPlan - Buffers]
+// ============================================================================
+
+err_t SvgFilterPlan::getBuffer(Image** dst, uint32_t index, const SizeI& size)
+{
+  while (_buffers.getLength() <= index)
+  {
+    Image* image = fog_new Image();
+    if (FOG_IS_NULL(image))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    err_t err = _buffers.append(image);
+    if (FOG_IS_ERROR(err))
+    {
+      fog_delete(image);
+      return err;
+    }
+  }
+
+  Image* image = _buffers.getAt(index);
+
+  // Buffers are only grown (rounded to 64 pixels) so they can be reused by
+  // filter regions of different size.
+  if (image->getWidth() < size.w || image->getHeight() < size.h)
+  {
+    SizeI bufferSize((size.w + 63) & ~63, (size.h + 63) & ~63);
+    FOG_RETURN_ON_ERROR(image->create(bufferSize, IMAGE_FORMAT_PRGB32));
+  }
+
+  FOG_RETURN_ON_ERROR(image->detach());
+
+  *dst = image;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgFilterPlan - Run - Helpers]
+// ============================================================================
+
+struct FOG_NO_EXPORT SvgFilterBuffer
+{
+  FOG_INLINE uint32_t* getRow(int y) const
+  {
+    return reinterpret_cast<uint32_t*>(data + (ssize_t)y * stride);
+  }
+
+  uint8_t* data;
+  ssize_t stride;
+};
+
+static void SvgFilter_initImage(RasterFilterImage& dst, const SvgFilterBuffer& src, const SizeI& size)
+{
+  dst.size = size;
+  dst.stride = src.stride;
+  dst.data = src.data;
+}
+
+static void SvgFilter_copy(const SvgFilterBuffer& dst, const SvgFilterBuffer& src, const BoxI& box)
+{
+  size_t size = (size_t)box.getWidth() * 4;
+
+  for (int y = box.y0; y < box.y1; y++)
+    MemOps::copy(dst.getRow(y) + box.x0, src.getRow(y) + box.x0, size);
+}
+
+static void SvgFilter_clear(const SvgFilterBuffer& dst, const BoxI& box)
+{
+  size_t size = (size_t)box.getWidth() * 4;
+
+  for (int y = box.y0; y < box.y1; y++)
+    MemOps::zero(dst.getRow(y) + box.x0, size);
+}
+
+static FOG_INLINE uint32_t SvgFilter_doPixel(uint32_t c0, const SvgFilterStep* step)
+{
+  uint32_t flags = step->flags;
+  Acc::p32ARGB32FromPRGB32(c0, c0);
+
+  float a = float(c0 >> 24);
+  float r = float((c0 >> 16) & 0xFF);
+  float g = float((c0 >>  8) & 0xFF);
+  float b = float((c0      ) & 0xFF);
+
+  if (flags & SVG_FILTER_STEP_MATRIX)
+  {
+    const float* m = step->matrix;
+
+    float nr = m[ 0] * r + m[ 1] * g + m[ 2] * b + m[ 3] * a + m[ 4] * 255.0f;
+    float ng = m[ 5] * r + m[ 6] * g + m[ 7] * b + m[ 8] * a + m[ 9] * 255.0f;
+    float nb = m[10] * r + m[11] * g + m[12] * b + m[13] * a + m[14] * 255.0f;
+    float na = m[15] * r + m[16] * g + m[17] * b + m[18] * a + m[19] * 255.0f;
+
+    r = Math::bound<float>(nr, 0.0f, 255.0f);
+    g = Math::bound<float>(ng, 0.0f, 255.0f);
+    b = Math::bound<float>(nb, 0.0f, 255.0f);
+    a = Math::bound<float>(na, 0.0f, 255.0f);
+  }
+
+  uint32_t ir = (uint32_t)Math::iround(r);
+  uint32_t ig = (uint32_t)Math::iround(g);
+  uint32_t ib = (uint32_t)Math::iround(b);
+  uint32_t ia = (uint32_t)Math::iround(a);
+
+  if (flags & SVG_FILTER_STEP_LUT)
+  {
+    ir = step->lut[0][ir];
+    ig = step->lut[1][ig];
+    ib = step->lut[2][ib];
+    ia = step->lut[3][ia];
+  }
+
+  c0 = (ia << 24) | (ir << 16) | (ig << 8) | ib;
+  Acc::p32PRGB32FromARGB32(c0, c0);
+  return c0;
+}
+
+static void SvgFilter_doPointwise(const SvgFilterBuffer& dst, const SvgFilterBuffer& src, const BoxI& box, const SvgFilterStep* step)
+{
+  // Most of the filter region is usually transparent.
+  uint32_t zero = SvgFilter_doPixel(0x00000000, step);
+
+  for (int y = box.y0; y < box.y1; y++)
+  {
+    uint32_t* d = dst.getRow(y);
+    const uint32_t* s = src.getRow(y);
+
+    for (int x = box.x0; x < box.x1; x++)
+    {
+      uint32_t c0 = s[x];
+      d[x] = c0 == 0 ? zero : SvgFilter_doPixel(c0, step);
+    }
+  }
+}
+
+static err_t SvgFilter_doBoxBlur(const SvgFilterBuffer& dst, const SvgFilterBuffer& src, const SizeI& size, const BoxI& box, int rx, int ry)
+{
+  if ((rx | ry) == 0)
+  {
+    SvgFilter_copy(dst, src, box);
+    return ERR_OK;
+  }
+
+  FeBlur feBlur(FE_BLUR_TYPE_BOX, float(rx), float(ry));
+  MemBuffer memBuffer;
+  MemBuffer intermediateBuffer;
+
+  RasterFilter ctx;
+  FOG_RETURN_ON_ERROR(_api_raster.filter.create[FE_TYPE_BLUR](&ctx,
+    &feBlur, NULL, &memBuffer, IMAGE_FORMAT_PRGB32, IMAGE_FORMAT_PRGB32));
+
+  RasterFilterImage dImage;
+  RasterFilterImage sImage;
+
+  SvgFilter_initImage(dImage, dst, size);
+  SvgFilter_initImage(sImage, src, size);
+
+  PointI dPos(box.x0, box.y0);
+  RectI sRect(box.x0, box.y0, box.getWidth(), box.getHeight());
+
+  err_t err = ctx.doRect(&ctx, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
+  ctx.destroy(&ctx);
+
+  return err;
+}
+
+static void SvgFilter_doOffset(const SvgFilterBuffer& dst, const SvgFilterBuffer& src, const SizeI& size, const BoxI& box, int dx, int dy)
+{
+  // Visible part of the source.
+  int x0 = Math::max(box.x0, dx);
+  int x1 = Math::min(box.x1, size.w + dx);
+
+  for (int y = box.y0; y < box.y1; y++)
+  {
+    uint32_t* d = dst.getRow(y);
+    int sy = y - dy;
+
+    if (sy < 0 || sy >= size.h || x0 >= x1)
+    {
+      MemOps::zero(d + box.x0, (size_t)box.getWidth() * 4);
+      continue;
+    }
+
+    const uint32_t* s = src.getRow(sy) - dx;
+
+    MemOps::zero(d + box.x0, (size_t)(x0 - box.x0) * 4);
+    MemOps::copy(d + x0, s + x0, (size_t)(x1 - x0) * 4);
+    MemOps::zero(d + x1, (size_t)(box.x1 - x1) * 4);
+  }
+}
+
+static FOG_INLINE uint32_t SvgFilter_combine(uint32_t a, uint32_t b, uint32_t dilate)
+{
+  uint32_t result = 0;
+
+  for (uint32_t shift = 0; shift < 32; shift += 8)
+  {
+    uint32_t ca = (a >> shift) & 0xFF;
+    uint32_t cb = (b >> shift) & 0xFF;
+    result |= (dilate ? Math::max(ca, cb) : Math::min(ca, cb)) << shift;
+  }
+
+  return result;
+}
+
+//! @internal
+//!
+//! @brief Erode or dilate @a length pixels of @a line (which contains
+//! @a length + 2 * @a r pixels) using van Herk / Gil-Werman algorithm.
+//!
+//! The line is split into blocks of the window size, @a g contains running
+//! results from the start of each block and @a h from the end of each block.
+//! Each window spans at most two blocks, so only three operations per pixel
+//! are needed regardless of the radius.
+static void SvgFilter_doMorphologyLine(uint32_t* dst, ssize_t dstStride,
+  const uint32_t* line, uint32_t* g, uint32_t* h, int length, int r, uint32_t dilate)
+{
+  int w = 2 * r + 1;
+  int n = length + 2 * r;
+  int i, j;
+
+  for (i = 0; i < n; i += w)
+  {
+    int end = Math::min(i + w, n);
+
+    g[i] = line[i];
+    for (j = i + 1; j < end; j++)
+      g[j] = SvgFilter_combine(g[j - 1], line[j], dilate);
+
+    h[end - 1] = line[end - 1];
+    for (j = end - 2; j >= i; j--)
+      h[j] = SvgFilter_combine(h[j + 1], line[j], dilate);
+  }
+
+  for (i = 0; i < length; i++)
+  {
+    *dst = SvgFilter_combine(h[i], g[i + w - 1], dilate);
+    dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(dst) + dstStride);
+  }
+}
+
+static err_t SvgFilter_doMorphology(const SvgFilterBuffer& dst, const SvgFilterBuffer& src, const SvgFilterBuffer& tmp,
+  const SizeI& size, const BoxI& box, int rx, int ry, uint32_t type)
+{
+  uint32_t dilate = type == FE_MORPHOLOGY_TYPE_DILATE;
+
+  // A larger radius doesn't change the result, the window covers the whole
+  // filter region and the transparent pixels outside.
+  rx = Math::bound(rx, 0, size.w);
+  ry = Math::bound(ry, 0, size.h);
+
+  int bw = box.getWidth();
+  int bh = box.getHeight();
+
+  // Line with the transparent pixels outside of the filter region, followed
+  // by the running results.
+  size_t n = (size_t)Math::max(bw + 2 * rx, bh + 2 * ry);
+
+  MemBufferTmp<4096> memBuffer;
+  uint32_t* line = reinterpret_cast<uint32_t*>(memBuffer.alloc(n * 3 * sizeof(uint32_t)));
+
+  if (FOG_IS_NULL(line))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  uint32_t* g = line + n;
+  uint32_t* h = g + n;
+
+  int x, y;
+
+  // Horizontal pass, src -> tmp.
+  int y0 = Math::max(box.y0 - ry, 0);
+  int y1 = Math::min(box.y1 + ry, size.h);
+
+  int sx0 = Math::max(box.x0 - rx, 0);
+  int sx1 = Math::min(box.x1 + rx, size.w);
+
+  for (y = y0; y < y1; y++)
+  {
+    const uint32_t* s = src.getRow(y);
+    int lx = box.x0 - rx;
+
+    MemOps::zero(line, (size_t)(bw + 2 * rx) * 4);
+    MemOps::copy(line + (sx0 - lx), s + sx0, (size_t)(sx1 - sx0) * 4);
+
+    SvgFilter_doMorphologyLine(tmp.getRow(y) + box.x0, 4, line, g, h, bw, rx, dilate);
+  }
+
+  // Vertical pass, tmp -> dst.
+  for (x = box.x0; x < box.x1; x++)
+  {
+    int ly = box.y0 - ry;
+
+    MemOps::zero(line, (size_t)(bh + 2 * ry) * 4);
+    for (y = y0; y < y1; y++)
+      line[y - ly] = tmp.getRow(y)[x];
+
+    SvgFilter_doMorphologyLine(dst.getRow(box.y0) + x, dst.stride, line, g, h, bh, ry, dilate);
+  }
+
+  return ERR_OK;
+}
+
+static void SvgFilter_doSrcOver(const SvgFilterBuffer& dst, const SvgFilterBuffer& src, const BoxI& box)
+{
+  for (int y = box.y0; y < box.y1; y++)
+  {
+    uint32_t* d = dst.getRow(y);
+    const uint32_t* s = src.getRow(y);
+
+    for (int x = box.x0; x < box.x1; x++)
+    {
+      uint32_t c0 = s[x];
+      if (c0 == 0)
+        continue;
+
+      uint32_t t0;
+      Acc::p32MulDiv255PBB_SBW(t0, d[x], 255 - (c0 >> 24));
+      d[x] = c0 + t0;
+    }
+  }
+}
+
+static err_t SvgFilter_doTurbulence(const SvgFilterBuffer& dst, const SizeI& size, const BoxI& box, const FeTurbulence* feTurbulence, const PointF& scale)
+{
+  ImageFilterScaleD feScale;
+  feScale.setFilterScale(scale.x, scale.y, 0);
+
+  MemBuffer memBuffer;
+  MemBuffer intermediateBuffer;
+
+  RasterFilter ctx;
+  FOG_RETURN_ON_ERROR(_api_raster.filter.create[FE_TYPE_TURBULENCE](&ctx,
+    feTurbulence, &feScale, &memBuffer, IMAGE_FORMAT_PRGB32, IMAGE_FORMAT_PRGB32));
+
+  RasterFilterImage dImage;
+  SvgFilter_initImage(dImage, dst, size);
+
+  PointI dPos(box.x0, box.y0);
+  RectI sRect(box.x0, box.y0, box.getWidth(), box.getHeight());
+
+  err_t err = ctx.doRect(&ctx, &dImage, &dPos, &dImage, &sRect, &intermediateBuffer);
+  ctx.destroy(&ctx);
+
+  return err;
+}
+
+// ============================================================================
+// [Fog::SvgFilterPlan - Run]
+// ============================================================================
+
+err_t SvgFilterPlan::run(const SizeI& size, const PointF& scale, Image** result)
+{
+  uint32_t i;
+  uint32_t count = (uint32_t)_steps.getLength();
+  SvgFilterStep** steps = _steps.getDataX();
+
+  BoxI layer(0, 0, size.w, size.h);
+
+  // --------------------------------------------------------------------------
+  // [Region Of Interest]
+  // --------------------------------------------------------------------------
+
+  // Propagated backwards from the result, steps which don't contribute to
+  // the result end with empty ROI and are not run.
+  for (i = 0; i < count; i++)
+    steps[i]->roi.reset();
+
+  if (_output != SVG_FILTER_SOURCE_GRAPHIC)
+    steps[_output - 1]->roi = layer;
+
+  i = count;
+  while (i)
+  {
+    SvgFilterStep* step = steps[--i];
+    if ((step->flags & (SVG_FILTER_STEP_DEAD | SVG_FILTER_STEP_FUSED)) || SvgFilter_isEmpty(step->roi))
+      continue;
+
+    BoxI roi(step->roi);
+
+    switch (step->op)
+    {
+      case SVG_FILTER_OP_POINTWISE:
+        break;
+
+      case SVG_FILTER_OP_BLUR:
+      {
+        int rx[3], ry[3];
+        SvgFilter_getBoxRadii(rx, step->params.x * scale.x);
+        SvgFilter_getBoxRadii(ry, step->params.y * scale.y);
+
+        roi = SvgFilter_expand(roi, rx[0] + rx[1] + rx[2], ry[0] + ry[1] + ry[2]);
+        break;
+      }
+
+      case SVG_FILTER_OP_OFFSET:
+      {
+        roi.translate(-Math::iround(step->params.x * scale.x),
+                      -Math::iround(step->params.y * scale.y));
+        break;
+      }
+
+      case SVG_FILTER_OP_MORPHOLOGY:
+      {
+        roi = SvgFilter_expand(roi,
+          Math::iround(step->params.x * scale.x),
+          Math::iround(step->params.y * scale.y));
+        break;
+      }
+
+      case SVG_FILTER_OP_TURBULENCE:
+        continue;
+
+      case SVG_FILTER_OP_MERGE:
+        break;
+    }
+
+    if (!BoxI::intersect(roi, roi, layer))
+      continue;
+
+    if (step->op == SVG_FILTER_OP_MERGE)
+    {
+      for (uint32_t j = 0; j < step->mergeCount; j++)
+      {
+        uint32_t value = _mergeInputs.getAt(step->mergeIndex + j);
+        if (value != SVG_FILTER_SOURCE_GRAPHIC)
+          SvgFilter_unite(steps[value - 1]->roi, roi);
+      }
+    }
+    else if (step->input != SVG_FILTER_SOURCE_GRAPHIC)
+    {
+      SvgFilter_unite(steps[step->input - 1]->roi, roi);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Steps]
+  // --------------------------------------------------------------------------
+
+  for (i = 0; i < count; i++)
+  {
+    SvgFilterStep* step = steps[i];
+    if ((step->flags & (SVG_FILTER_STEP_DEAD | SVG_FILTER_STEP_FUSED)) || SvgFilter_isEmpty(step->roi))
+      continue;
+
+    Image* image;
+    SvgFilterBuffer dst;
+    SvgFilterBuffer src;
+
+    FOG_RETURN_ON_ERROR(getBuffer(&image, step->buffer, size));
+    dst.data = image->getFirstX();
+    dst.stride = image->getStride();
+
+    if (step->op != SVG_FILTER_OP_MERGE && step->op != SVG_FILTER_OP_TURBULENCE)
+    {
+      uint32_t input = step->input;
+      FOG_RETURN_ON_ERROR(getBuffer(&image, input == SVG_FILTER_SOURCE_GRAPHIC ? 0 : steps[input - 1]->buffer, size));
+      src.data = image->getFirstX();
+      src.stride = image->getStride();
+    }
+
+    const BoxI& roi = step->roi;
+
+    switch (step->op)
+    {
+      case SVG_FILTER_OP_POINTWISE:
+      {
+        SvgFilter_doPointwise(dst, src, roi, step);
+        break;
+      }
+
+      case SVG_FILTER_OP_BLUR:
+      {
+        SvgFilterBuffer tmp;
+        FOG_RETURN_ON_ERROR(getBuffer(&image, step->scratch, size));
+        tmp.data = image->getFirstX();
+        tmp.stride = image->getStride();
+
+        int rx[3], ry[3];
+        SvgFilter_getBoxRadii(rx, step->params.x * scale.x);
+        SvgFilter_getBoxRadii(ry, step->params.y * scale.y);
+
+        // Each pass produces the region needed by the remaining passes.
+        BoxI box0(SvgFilter_expand(roi, rx[1] + rx[2], ry[1] + ry[2]));
+        BoxI box1(SvgFilter_expand(roi, rx[2], ry[2]));
+
+        BoxI::intersect(box0, box0, layer);
+        BoxI::intersect(box1, box1, layer);
+
+        FOG_RETURN_ON_ERROR(SvgFilter_doBoxBlur(dst, src, size, box0, rx[0], ry[0]));
+        FOG_RETURN_ON_ERROR(SvgFilter_doBoxBlur(tmp, dst, size, box1, rx[1], ry[1]));
+        FOG_RETURN_ON_ERROR(SvgFilter_doBoxBlur(dst, tmp, size, roi , rx[2], ry[2]));
+        break;
+      }
+
+      case SVG_FILTER_OP_OFFSET:
+      {
+        SvgFilter_doOffset(dst, src, size, roi,
+          Math::iround(step->params.x * scale.x),
+          Math::iround(step->params.y * scale.y));
+        break;
+      }
+
+      case SVG_FILTER_OP_MORPHOLOGY:
+      {
+        SvgFilterBuffer tmp;
+        FOG_RETURN_ON_ERROR(getBuffer(&image, step->scratch, size));
+        tmp.data = image->getFirstX();
+        tmp.stride = image->getStride();
+
+        FOG_RETURN_ON_ERROR(SvgFilter_doMorphology(dst, src, tmp, size, roi,
+          Math::iround(step->params.x * scale.x),
+          Math::iround(step->params.y * scale.y),
+          step->morphologyType));
+        break;
+      }
+
+      case SVG_FILTER_OP_TURBULENCE:
+      {
+        FOG_RETURN_ON_ERROR(SvgFilter_doTurbulence(dst, size, roi, &step->turbulence, scale));
+        break;
+      }
+
+      case SVG_FILTER_OP_MERGE:
+      {
+        SvgFilter_clear(dst, roi);
+
+        for (uint32_t j = 0; j < step->mergeCount; j++)
+        {
+          uint32_t value = _mergeInputs.getAt(step->mergeIndex + j);
+          FOG_RETURN_ON_ERROR(getBuffer(&image, value == SVG_FILTER_SOURCE_GRAPHIC ? 0 : steps[value - 1]->buffer, size));
+
+          src.data = image->getFirstX();
+          src.stride = image->getStride();
+          SvgFilter_doSrcOver(dst, src, roi);
+        }
+        break;
+      }
+    }
+  }
+
+  return getBuffer(result, _output == SVG_FILTER_SOURCE_GRAPHIC ? 0 : steps[_output - 1]->buffer, size);
+}
+
+// ============================================================================
+// [Fog::SvgFilterElement - Plan]
+// ============================================================================
+
+SvgFilterPlan* SvgFilterElement::_getPlan() const
+{
+  if (_plan != NULL)
+    return _plan;
+
+  SvgFilterPlan* plan = fog_new SvgFilterPlan();
+  if (FOG_IS_NULL(plan))
+    return NULL;
+
+  if (FOG_IS_ERROR(plan->compile(this)))
+  {
+    fog_delete(plan);
+    return NULL;
+  }
+
+  _plan = plan;
+  return plan;
+}
+
+void SvgFilterElement::_resetPlan() const
+{
+  if (_plan != NULL)
+  {
+    fog_delete(_plan);
+    _plan = NULL;
+  }
+}
+
+// ============================================================================
+// [Fog::SvgFilterElement - SVG Interface]
+// ============================================================================
+
+err_t SvgFilterElement::getFilterRegion(BoxF& dst, const SvgElement* obj) const
+{
+  if (_filterUnits == SVG_OBJECT_BOUNDING_BOX)
+  {
+    BoxF bbox;
+
+    if (obj->getBoundingBox(bbox) != ERR_OK)
+    {
+      // Containers don't provide the geometry bounding-box, measure them.
+      SvgMeasureContext measure(NULL);
+      FOG_RETURN_ON_ERROR(obj->onProcess(&measure));
+
+      if (!measure.hasBoundingBox())
+        return ERR_GEOMETRY_NONE;
+      bbox = measure.getBoundingBox();
+    }
+
+    // Both, fractions and percentages, are relative to the bounding-box.
+    float w = bbox.getWidth();
+    float h = bbox.getHeight();
+
+    dst.x0 = bbox.x0 + _x * w;
+    dst.y0 = bbox.y0 + _y * h;
+    dst.x1 = dst.x0 + _width * w;
+    dst.y1 = dst.y0 + _height * h;
+  }
+  else
+  {
+    SvgDocument* doc = static_cast<SvgDocument*>(getOwnerDocument());
+
+    dst.x0 = doc->_dpi.toDeviceSpace(_x, _xUnit);
+    dst.y0 = doc->_dpi.toDeviceSpace(_y, _yUnit);
+    dst.x1 = dst.x0 + doc->_dpi.toDeviceSpace(_width, _widthUnit);
+    dst.y1 = dst.y0 + doc->_dpi.toDeviceSpace(_height, _heightUnit);
+  }
+
+  if (!dst.isValid())
+    return ERR_GEOMETRY_NONE;
+
+  return ERR_OK;
+}
+
+err_t SvgFilterElement::_render(SvgRenderContext* context, const SvgElement* obj) const
+{
+  SvgFilterPlan* plan = _getPlan();
+  if (FOG_IS_NULL(plan))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  // Filter without primitives disables rendering of the element.
+  if (plan->isEmpty())
+    return ERR_OK;
+
+  BoxF region;
+  if (getFilterRegion(region, obj) != ERR_OK)
+    return ERR_OK;
+
+  Painter* painter = context->_painter;
+
+  // Transform from the user space of the element to the device.
+  TransformF tr;
+  FOG_RETURN_ON_ERROR(painter->getTransform(tr));
+  TransformF userTr(tr);
+  tr.transform(context->_transform, MATRIX_ORDER_PREPEND);
+
+  BoxF deviceRegion;
+  tr.mapBox(deviceRegion, region);
+
+  SizeI deviceSize;
+  FOG_RETURN_ON_ERROR(painter->getSize(deviceSize));
+
+  BoxI layer(Math::ifloor(deviceRegion.x0), Math::ifloor(deviceRegion.y0),
+             Math::iceil (deviceRegion.x1), Math::iceil (deviceRegion.y1));
+
+  if (!BoxI::intersect(layer, layer, BoxI(0, 0, deviceSize.w, deviceSize.h)))
+    return ERR_OK;
+
+  SizeI layerSize(layer.getWidth(), layer.getHeight());
+
+  // --------------------------------------------------------------------------
+  // [SourceGraphic]
+  // --------------------------------------------------------------------------
+
+  Image* source;
+  FOG_RETURN_ON_ERROR(plan->getBuffer(&source, 0, layerSize));
+
+  {
+    Painter layerPainter(*source);
+    layerPainter.setSource(Argb32(0x00000000));
+    layerPainter.setCompositingOperator(COMPOSITE_SRC);
+    layerPainter.fillRect(RectI(0, 0, layerSize.w, layerSize.h));
+
+    userTr.translate(PointF(float(-layer.x0), float(-layer.y0)), MATRIX_ORDER_APPEND);
+    layerPainter.setTransform(userTr);
+
+    // Compositing operator and opacity are applied to the filter result.
+    uint32_t compOp = context->getCompOp();
+    float opacity = context->getOpacity();
+
+    context->setCompOp(COMPOSITE_SRC_OVER);
+    context->setOpacity(1.0f);
+    context->_painter = &layerPainter;
+    context->initPainter();
+
+    err_t err = obj->onProcess(context);
+
+    context->_painter = painter;
+    context->setCompOp(compOp);
+    context->setOpacity(opacity);
+
+    layerPainter.end();
+    FOG_RETURN_ON_ERROR(err);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  // Size of the primitive unit in device pixels.
+  PointF scale(Math::sqrt(tr._00 * tr._00 + tr._01 * tr._01),
+               Math::sqrt(tr._10 * tr._10 + tr._11 * tr._11));
+
+  if (_primitiveUnits == SVG_OBJECT_BOUNDING_BOX)
+  {
+    BoxF bbox;
+    if (obj->getBoundingBox(bbox) == ERR_OK)
+    {
+      scale.x *= bbox.getWidth();
+      scale.y *= bbox.getHeight();
+    }
+  }
+
+  Image* result;
+  FOG_RETURN_ON_ERROR(plan->run(layerSize, scale, &result));
+
+  painter->save();
+  painter->resetTransform();
+  painter->setCompositingOperator(context->getCompOp());
+  painter->setOpacity(context->getOpacity());
+  painter->blitImage(PointI(layer.x0, layer.y0), *result, RectI(0, 0, layerSize.w, layerSize.h));
+  painter->restore();
+
+  return ERR_OK;
+}
+
+} // Fog namespace
@@ -0,0 +1,215 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_SVG_SVGFILTER_P_H
+#define _FOG_G2D_SVG_SVGFILTER_P_H
+
+// [Dependencies]
+#include <Fog/Core/Tools/List.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Imaging/Filters/FeTurbulence.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Svg
+//! @{
+
+// ============================================================================
+// [Fog::SVG_FILTER_OP]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Operation of a compiled filter step.
+enum SVG_FILTER_OP
+{
+  //! @brief Color matrix and/or per-component LUT (fused \<feColorMatrix\>,
+  //! \<feComponentTransfer\> and SourceAlpha).
+  SVG_FILTER_OP_POINTWISE = 0,
+  //! @brief Gaussian blur (three box-blur passes), \<feGaussianBlur\>.
+  SVG_FILTER_OP_BLUR = 1,
+  //! @brief Translation, \<feOffset\>.
+  SVG_FILTER_OP_OFFSET = 2,
+  //! @brief Erode or dilate, \<feMorphology\>.
+  SVG_FILTER_OP_MORPHOLOGY = 3,
+  //! @brief Perlin turbulence, \<feTurbulence\>.
+  SVG_FILTER_OP_TURBULENCE = 4,
+  //! @brief Source-over of all inputs, \<feMerge\>.
+  SVG_FILTER_OP_MERGE = 5
+};
+
+// ============================================================================
+// [Fog::SVG_FILTER_STEP]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Flags of a compiled filter step.
+enum SVG_FILTER_STEP
+{
+  //! @brief Pointwise step contains a color matrix.
+  SVG_FILTER_STEP_MATRIX = 0x01,
+  //! @brief Pointwise step contains a component LUT.
+  SVG_FILTER_STEP_LUT = 0x02,
+  //! @brief Step was fused into the step which consumes its result.
+  SVG_FILTER_STEP_FUSED = 0x04,
+  //! @brief Result of the step is never used.
+  SVG_FILTER_STEP_DEAD = 0x08
+};
+
+// ============================================================================
+// [Fog::SVG_FILTER_MISC]
+// ============================================================================
+
+//! @internal
+enum SVG_FILTER_MISC
+{
+  //! @brief Value index of SourceGraphic, the result of step i is i + 1.
+  SVG_FILTER_SOURCE_GRAPHIC = 0,
+  //! @brief No value / buffer.
+  SVG_FILTER_INVALID = 0xFFFFFFFF
+};
+
+// ============================================================================
+// [Fog::SvgFilterStep]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Compiled filter primitive.
+struct FOG_NO_EXPORT SvgFilterStep
+{
+  SvgFilterStep();
+
+  //! @brief Operation, see @ref SVG_FILTER_OP.
+  uint32_t op;
+  //! @brief Flags, see @ref SVG_FILTER_STEP.
+  uint32_t flags;
+
+  //! @brief Input value (pointwise, blur, offset and morphology).
+  uint32_t input;
+  //! @brief First merge input in @ref SvgFilterPlan::_mergeInputs.
+  uint32_t mergeIndex;
+  //! @brief Count of merge inputs.
+  uint32_t mergeCount;
+
+  //! @brief Buffer which holds the result.
+  uint32_t buffer;
+  //! @brief Scratch buffer (blur and morphology), released after the step.
+  uint32_t scratch;
+
+  //! @brief Step parameters in primitive units - blur standard deviation,
+  //! offset or morphology radius.
+  PointF params;
+  //! @brief Morphology type, see @c FE_MORPHOLOGY_TYPE.
+  uint32_t morphologyType;
+
+  //! @brief Region of interest, computed by @ref SvgFilterPlan::run().
+  BoxI roi;
+
+  //! @brief Turbulence parameters.
+  FeTurbulence turbulence;
+
+  //! @brief 5x4 color matrix (SVG layout, non-premultiplied 0..1 values).
+  float matrix[20];
+  //! @brief Component LUTs (R, G, B, A) applied after the matrix.
+  uint8_t lut[4][256];
+};
+
+// ============================================================================
+// [Fog::SvgFilterPlan]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Execution plan of SVG \<filter\> element.
+//!
+//! The filter graph is compiled once (and cached by the @ref SvgFilterElement)
+//! into a list of steps in which:
+//!
+//!   - Consecutive pointwise primitives (color matrix, component transfer and
+//!     SourceAlpha) are fused into a single pass if the intermediate result
+//!     is not referenced by other primitives (and doesn't need clamping).
+//!   - Primitives whose result is never used are removed.
+//!   - Each result is assigned to a buffer; a buffer is released after the
+//!     last step reading it and reused by the next result. Pointwise steps
+//!     run in-place when their input dies.
+//!
+//! Region of interest of each step is computed before running the plan, from
+//! the output backwards, so only pixels which contribute to the result are
+//! processed (and unused steps are skipped).
+struct FOG_NO_EXPORT SvgFilterPlan
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgFilterPlan();
+  ~SvgFilterPlan();
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE bool isEmpty() const { return _steps.isEmpty(); }
+  FOG_INLINE uint32_t getBufferCount() const { return _bufferCount; }
+
+  // --------------------------------------------------------------------------
+  // [Compile]
+  // --------------------------------------------------------------------------
+
+  err_t compile(const SvgFilterElement* filter);
+
+  //! @brief Release all steps (buffers are kept).
+  void reset();
+
+  // --------------------------------------------------------------------------
+  // [Buffers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get buffer @a index, (re)created if it's smaller than @a size.
+  err_t getBuffer(Image** dst, uint32_t index, const SizeI& size);
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  //! @brief Run the plan, the SourceGraphic must already be rendered in the
+  //! buffer #0.
+  //!
+  //! @param size Size of the filter region in pixels.
+  //! @param scale Size of the primitive unit in pixels.
+  //! @param result The buffer containing the result.
+  err_t run(const SizeI& size, const PointF& scale, Image** result);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Compiled steps.
+  List<SvgFilterStep*> _steps;
+  //! @brief Inputs of merge steps.
+  List<uint32_t> _mergeInputs;
+  //! @brief Pooled buffers (PRGB32), kept between runs.
+  List<Image*> _buffers;
+
+  //! @brief Value which is the result of the filter.
+  uint32_t _output;
+  //! @brief Count of buffers used by the plan.
+  uint32_t _bufferCount;
+
+private:
+  FOG_NO_COPY(SvgFilterPlan)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_SVG_SVGFILTER_P_H
@@ -0,0 +1,595 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/G2d/Geometry/PathStroker.h>
+#include <Fog/G2d/Painting/Painter.h>
+#include <Fog/G2d/Svg/SvgContext.h>
+#include <Fog/G2d/Svg/SvgDom.h>
+#include <Fog/G2d/Svg/SvgInstance_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::SvgInstance - Helpers]
+// ============================================================================
+
+static FOG_INLINE bool SvgInstance_canPaint(uint32_t sourceType)
+{
+  return sourceType != SVG_SOURCE_NONE && sourceType != SVG_SOURCE_INVALID;
+}
+
+static FOG_INLINE bool SvgInstance_eqSource(const SvgContextSource& a, const SvgContextSource& b)
+{
+  return a.type    == b.type    &&
+         a.opacity == b.opacity &&
+         a.uriRef  == b.uriRef  &&
+         a.color   == b.color   ;
+}
+
+static FOG_INLINE bool SvgInstance_eqStrokeParams(const PathStrokerParamsF& a, const PathStrokerParamsF& b)
+{
+  return a.getLineWidth()  == b.getLineWidth()  &&
+         a.getMiterLimit() == b.getMiterLimit() &&
+         a.getDashOffset() == b.getDashOffset() &&
+         a.getHints()      == b.getHints()      &&
+         a.getDashList()   == b.getDashList()   ;
+}
+
+// Get scale of the transform (geometric mean of axes) as a power of two, used
+// to select the flattening tolerance.
+static int SvgInstance_getScaleLog2(const TransformF& tr)
+{
+  float scale = Math::sqrt(Math::abs(tr._00 * tr._11 - tr._01 * tr._10));
+  int scaleLog2 = 0;
+
+  if (scale <= MATH_EPSILON_F)
+    return 0;
+
+  while (scale > 1.0f && scaleLog2 < 8)
+  {
+    scale *= 0.5f;
+    scaleLog2++;
+  }
+
+  while (scale <= 0.5f && scaleLog2 > -8)
+  {
+    scale *= 2.0f;
+    scaleLog2--;
+  }
+
+  return scaleLog2;
+}
+
+// ============================================================================
+// [Fog::SvgInstanceState]
+// ============================================================================
+
+void SvgInstanceState::init(const SvgContext* context, int scaleLog2)
+{
+  fillSource = context->_fillSource;
+  strokeSource = context->_strokeSource;
+  strokeParams = context->_strokeParams;
+  font = context->_font;
+
+  compOp = context->_compOp;
+  fillRule = context->_fillRule;
+  opacity = context->_opacity;
+
+  this->scaleLog2 = scaleLog2;
+}
+
+bool SvgInstanceState::eq(const SvgContext* context, int scaleLog2) const
+{
+  return this->scaleLog2 == scaleLog2            &&
+         compOp   == context->_compOp            &&
+         fillRule == context->_fillRule          &&
+         opacity  == context->_opacity           &&
+         SvgInstance_eqSource(fillSource, context->_fillSource) &&
+         SvgInstance_eqSource(strokeSource, context->_strokeSource) &&
+         SvgInstance_eqStrokeParams(strokeParams, context->_strokeParams) &&
+         font == context->_font;
+}
+
+// ============================================================================
+// [Fog::SvgInstanceRecord - Construction / Destruction]
+// ============================================================================
+
+SvgInstanceRecord::SvgInstanceRecord() :
+  _cacheable(false),
+  _cacheOffset(0, 0),
+  _cacheHits(0),
+  _cacheFailed(false)
+{
+  _bbox.reset();
+}
+
+SvgInstanceRecord::~SvgInstanceRecord()
+{
+  ListIterator<SvgInstanceItem*> it(_items);
+  while (it.isValid())
+  {
+    fog_delete(it.getItem());
+    it.next();
+  }
+}
+
+// ============================================================================
+// [Fog::SvgInstanceRecord - Record]
+// ============================================================================
+
+err_t SvgInstanceRecord::record(const SvgElement* element, const SvgContext* context, int scaleLog2)
+{
+  SvgDocument* doc = static_cast<SvgDocument*>(element->getOwnerDocument());
+
+  float scale = scaleLog2 >= 0 ? float(1 << scaleLog2) : 1.0f / float(1 << -scaleLog2);
+  float flatness = MathConstant<float>::getDefaultFlatness() / scale;
+
+  _state.init(context, scaleLog2);
+
+  SvgRecordContext ctx(doc->_createContextExtension(NULL), this, flatness);
+  ctx._fillSource = context->_fillSource;
+  ctx._strokeSource = context->_strokeSource;
+  ctx._strokeParams = context->_strokeParams;
+  ctx._fillRule = context->_fillRule;
+  ctx._compOp = context->_compOp;
+  ctx._opacity = context->_opacity;
+  ctx._font = context->_font;
+  ctx._computedStyle = context->_computedStyle;
+
+  FOG_RETURN_ON_ERROR(ctx.onVisit(const_cast<SvgElement*>(element)));
+
+  if (ctx._unsupported)
+    return ERR_RT_NOT_IMPLEMENTED;
+
+  // Bounding-box (used by blit cache) and whether the items can be composited
+  // as a group, which is true for src-over.
+  bool hasBBox = false;
+  _cacheable = true;
+
+  ListIterator<SvgInstanceItem*> it(_items);
+  while (it.isValid())
+  {
+    SvgInstanceItem* item = it.getItem();
+    BoxF b;
+
+    if (item->compOp != COMPOSITE_SRC_OVER)
+      _cacheable = false;
+
+    if (item->type == SVG_INSTANCE_ITEM_PATH)
+    {
+      if (item->path.getBoundingBox(b) != ERR_OK)
+        goto _Next;
+    }
+    else
+    {
+      b.setBox(item->point.x, item->point.y,
+        item->point.x + float(item->image.getWidth()),
+        item->point.y + float(item->image.getHeight()));
+      item->transform.mapBox(b, b);
+    }
+
+    if (hasBBox)
+      BoxF::bound(_bbox, _bbox, b);
+    else
+      _bbox = b;
+    hasBBox = true;
+
+_Next:
+    it.next();
+  }
+
+  if (!hasBBox)
+    _cacheable = false;
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgInstanceRecord - Replay]
+// ============================================================================
+
+err_t SvgInstanceRecord::replay(Painter* painter, const TransformF& tr)
+{
+  painter->save();
+  painter->transform(tr);
+
+  ListIterator<SvgInstanceItem*> it(_items);
+  while (it.isValid())
+  {
+    SvgInstanceItem* item = it.getItem();
+
+    if (item->type == SVG_INSTANCE_ITEM_PATH)
+    {
+      painter->setCompositingOperator(item->compOp);
+      painter->setSource(item->source);
+      painter->setOpacity(item->opacity);
+      painter->setFillRule(item->fillRule);
+      painter->fillPath(item->path);
+    }
+    else
+    {
+      painter->save();
+      painter->transform(item->transform);
+      painter->setCompositingOperator(COMPOSITE_SRC_OVER);
+      painter->setOpacity(1.0f);
+      painter->blitImage(item->point, item->image);
+      painter->restore();
+    }
+
+    it.next();
+  }
+
+  painter->restore();
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgInstanceRecord - Render]
+// ============================================================================
+
+err_t SvgInstanceRecord::render(Painter* painter, const TransformF& tr)
+{
+  if (!_cacheable)
+    return replay(painter, tr);
+
+  TransformF m(UNINITIALIZED);
+  painter->getTransform(m);
+  m.transform(tr, MATRIX_ORDER_PREPEND);
+
+  float ix = Math::floor(m._20);
+  float iy = Math::floor(m._21);
+
+  // Instances are blit-cacheable if they differ only by an integral
+  // translation in device space.
+  TransformF key(m._00, m._01, m._10, m._11, m._20 - ix, m._21 - iy);
+
+  if (key._00 == _cacheTransform._00 && key._01 == _cacheTransform._01 &&
+      key._10 == _cacheTransform._10 && key._11 == _cacheTransform._11 &&
+      Math::abs(key._20 - _cacheTransform._20) <= 1.0f / 256.0f &&
+      Math::abs(key._21 - _cacheTransform._21) <= 1.0f / 256.0f)
+  {
+    if (++_cacheHits >= SVG_INSTANCE_CACHE_THRESHOLD && _cache.isEmpty() && !_cacheFailed)
+      _cacheFailed = (_createCache() != ERR_OK);
+  }
+  else
+  {
+    _cache.reset();
+    _cacheTransform = key;
+    _cacheHits = 1;
+    _cacheFailed = false;
+  }
+
+  if (_cache.isEmpty())
+    return replay(painter, tr);
+
+  painter->save();
+  painter->resetTransform();
+  painter->setCompositingOperator(COMPOSITE_SRC_OVER);
+  painter->setOpacity(1.0f);
+  painter->blitImage(PointI((int)ix + _cacheOffset.x, (int)iy + _cacheOffset.y), _cache);
+  painter->restore();
+
+  return ERR_OK;
+}
+
+err_t SvgInstanceRecord::_createCache()
+{
+  BoxF b;
+  _cacheTransform.mapBox(b, _bbox);
+
+  // One pixel of border for antialiasing.
+  int x0 = Math::ifloor(b.x0) - 1;
+  int y0 = Math::ifloor(b.y0) - 1;
+  int x1 = Math::iceil(b.x1) + 1;
+  int y1 = Math::iceil(b.y1) + 1;
+
+  int w = x1 - x0;
+  int h = y1 - y0;
+
+  if (w <= 0 || h <= 0 || (int64_t)w * h > SVG_INSTANCE_CACHE_MAX_AREA)
+    return ERR_IMAGE_INVALID_SIZE;
+
+  Image image;
+  FOG_RETURN_ON_ERROR(image.create(SizeI(w, h), IMAGE_FORMAT_PRGB32));
+
+  Painter painter(image);
+  painter.setSource(Argb32(0x00000000));
+  painter.setCompositingOperator(COMPOSITE_SRC);
+  painter.fillAll();
+
+  TransformF tr(_cacheTransform);
+  tr.translate(PointF(float(-x0), float(-y0)), MATRIX_ORDER_APPEND);
+
+  replay(&painter, tr);
+  painter.end();
+
+  _cache = image;
+  _cacheOffset.set(x0, y0);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgInstance - Construction / Destruction]
+// ============================================================================
+
+SvgInstance::SvgInstance() :
+  _version(0),
+  _unsupported(false)
+{
+}
+
+SvgInstance::~SvgInstance()
+{
+  reset();
+}
+
+// ============================================================================
+// [Fog::SvgInstance - Methods]
+// ============================================================================
+
+SvgInstanceRecord* SvgInstance::getRecord(const SvgElement* element, const SvgContext* context, int scaleLog2)
+{
+  SvgDocument* doc = static_cast<SvgDocument*>(element->getOwnerDocument());
+
+  // Records can depend on any element in the document (gradients, patterns,
+  // nested <use>), so they are dropped whenever the document changes.
+  if (_version != doc->_version)
+  {
+    reset();
+    _version = doc->_version;
+  }
+
+  if (_unsupported)
+    return NULL;
+
+  size_t i, length = _records.getLength();
+  for (i = length; i != 0; i--)
+  {
+    SvgInstanceRecord* record = _records.getAt(i - 1);
+    if (record->_state.eq(context, scaleLog2))
+      return record;
+  }
+
+  SvgInstanceRecord* record = fog_new SvgInstanceRecord();
+  if (FOG_IS_NULL(record))
+    return NULL;
+
+  err_t err = record->record(element, context, scaleLog2);
+  if (FOG_IS_ERROR(err))
+  {
+    if (err == ERR_RT_NOT_IMPLEMENTED)
+    {
+      reset();
+      _unsupported = true;
+    }
+
+    fog_delete(record);
+    return NULL;
+  }
+
+  if (length >= SVG_INSTANCE_MAX_RECORDS)
+  {
+    fog_delete(_records.getAt(0));
+    _records.removeAt(0);
+  }
+
+  if (_records.append(record) != ERR_OK)
+  {
+    fog_delete(record);
+    return NULL;
+  }
+
+  return record;
+}
+
+void SvgInstance::reset()
+{
+  ListIterator<SvgInstanceRecord*> it(_records);
+  while (it.isValid())
+  {
+    fog_delete(it.getItem());
+    it.next();
+  }
+
+  _records.clear();
+  _unsupported = false;
+}
+
+// ============================================================================
+// [Fog::SvgRecordContext - Construction / Destruction]
+// ============================================================================
+
+SvgRecordContext::SvgRecordContext(SvgContextExtension* contextExtension, SvgInstanceRecord* record, float flatness) :
+  SvgContext(contextExtension),
+  _record(record),
+  _flatness(flatness),
+  _unsupported(false)
+{
+  _contextType = SVG_CONTEXT_RECORD;
+}
+
+SvgRecordContext::~SvgRecordContext()
+{
+}
+
+// ============================================================================
+// [Fog::SvgRecordContext - Interface]
+// ============================================================================
+
+static err_t SvgRecordContext_setupSource(SvgRecordContext* context,
+  SvgElement* obj, const SvgContextSource& source, Pattern& dst)
+{
+  switch (source.type)
+  {
+    case SVG_SOURCE_COLOR:
+      return dst.createColor(source.color);
+
+    case SVG_SOURCE_URI:
+      FOG_RETURN_ON_ERROR(source.uriRef->onPattern(context, obj, &dst));
+      // The pattern is defined in the user space of the element, make it
+      // relative to the <use> element.
+      return dst.transform(context->_transform, MATRIX_ORDER_APPEND);
+
+    default:
+      return ERR_RT_INVALID_STATE;
+  }
+}
+
+err_t SvgRecordContext::onVisit(SvgElement* obj)
+{
+  SvgContextGState state(this);
+
+  FOG_RETURN_ON_ERROR(obj->onPrepare(this, &state));
+
+  // Filtered content can't be retained, the <use> is rendered directly.
+  if (_filter != NULL)
+  {
+    _unsupported = true;
+    return ERR_OK;
+  }
+
+  return obj->onProcess(this);
+}
+
+err_t SvgRecordContext::onShape(SvgElement* obj, const ShapeF& shape)
+{
+  bool canFill   = shape.isClosed() &&
+                   SvgInstance_canPaint(_fillSource.type);
+  bool canStroke = SvgInstance_canPaint(_strokeSource.type);
+
+  if (!(canFill | canStroke))
+    return ERR_OK;
+
+  // Same as SvgRenderContext::onShape() - the compositing operator is only
+  // used if the element is either filled or stroked.
+  uint32_t compOp = (canFill != canStroke) ? (uint32_t)_compOp : (uint32_t)COMPOSITE_SRC_OVER;
+  PathFlattenParamsF flattenParams(_flatness);
+
+  if (canFill)
+  {
+    SvgInstanceItem* item = fog_new SvgInstanceItem();
+    if (FOG_IS_NULL(item))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    if (SvgRecordContext_setupSource(this, obj, _fillSource, item->source) != ERR_OK ||
+        item->path.shape(shape, PATH_DIRECTION_CW, _transform) != ERR_OK ||
+        item->path.flatten(flattenParams) != ERR_OK ||
+        _record->_items.append(item) != ERR_OK)
+    {
+      fog_delete(item);
+    }
+    else
+    {
+      item->compOp = compOp;
+      item->fillRule = _fillRule;
+      item->opacity = _fillSource.opacity * _opacity;
+    }
+  }
+
+  if (canStroke)
+  {
+    // Stroke is expanded in the user space of the element, so the flattening
+    // tolerance must be scaled by the element transform.
+    float scale = Math::sqrt(Math::abs(_transform._00 * _transform._11 - _transform._01 * _transform._10));
+    PathStrokerF stroker(_strokeParams);
+
+    if (scale > MATH_EPSILON_F)
+      stroker.setFlatness(_flatness / scale);
+
+    _pathTmp.clear();
+    if (stroker.strokeShape(_pathTmp, shape) != ERR_OK)
+      return ERR_OK;
+
+    SvgInstanceItem* item = fog_new SvgInstanceItem();
+    if (FOG_IS_NULL(item))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    item->path = _pathTmp;
+
+    if (SvgRecordContext_setupSource(this, obj, _strokeSource, item->source) != ERR_OK ||
+        item->path.transform(_transform) != ERR_OK ||
+        item->path.flatten(flattenParams) != ERR_OK ||
+        _record->_items.append(item) != ERR_OK)
+    {
+      fog_delete(item);
+    }
+    else
+    {
+      item->compOp = compOp;
+      item->fillRule = FILL_RULE_NON_ZERO;
+      item->opacity = _strokeSource.opacity * _opacity;
+    }
+  }
+
+  return ERR_OK;
+}
+
+err_t SvgRecordContext::onImage(SvgElement* obj, const PointF& pt, const Image& image)
+{
+  if (image.isEmpty())
+    return ERR_OK;
+
+  SvgInstanceItem* item = fog_new SvgInstanceItem();
+  if (FOG_IS_NULL(item))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  item->type = SVG_INSTANCE_ITEM_IMAGE;
+  item->image = image;
+  item->point = pt;
+  item->transform = _transform;
+
+  if (_record->_items.append(item) != ERR_OK)
+  {
+    fog_delete(item);
+    return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgElement - Instance]
+// ============================================================================
+
+err_t SvgElement::_renderInstance(SvgRenderContext* context) const
+{
+  Painter* painter = context->_painter;
+
+  if (_instance == NULL)
+  {
+    _instance = fog_new SvgInstance();
+    if (FOG_IS_NULL(_instance))
+      return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  TransformF m(UNINITIALIZED);
+  painter->getTransform(m);
+  m.transform(context->getTransform(), MATRIX_ORDER_PREPEND);
+
+  SvgInstanceRecord* record = _instance->getRecord(this, context, SvgInstance_getScaleLog2(m));
+  if (record == NULL)
+    return ERR_RT_NOT_IMPLEMENTED;
+
+  return record->render(painter, context->getTransform());
+}
+
+void SvgElement::_resetInstance() const
+{
+  if (_instance != NULL)
+  {
+    fog_delete(_instance);
+    _instance = NULL;
+  }
+}
+
+} // Fog namespace
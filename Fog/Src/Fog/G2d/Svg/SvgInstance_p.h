@@ -0,0 +1,290 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_SVG_SVGINSTANCE_P_H
+#define _FOG_G2D_SVG_SVGINSTANCE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Tools/List.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Geometry/Path.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Source/Pattern.h>
+#include <Fog/G2d/Svg/SvgContext.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Svg
+//! @{
+
+// ============================================================================
+// [Fog::SVG_INSTANCE_ITEM]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Type of recorded item.
+enum SVG_INSTANCE_ITEM
+{
+  //! @brief Filled path (fills and pre-stroked strokes).
+  SVG_INSTANCE_ITEM_PATH = 0,
+  //! @brief Image.
+  SVG_INSTANCE_ITEM_IMAGE = 1
+};
+
+// ============================================================================
+// [Fog::SVG_INSTANCE_MISC]
+// ============================================================================
+
+//! @internal
+enum SVG_INSTANCE_MISC
+{
+  //! @brief Maximum count of records kept per element (different inherited
+  //! styles or scale of the referencing \<use\> elements).
+  SVG_INSTANCE_MAX_RECORDS = 4,
+
+  //! @brief Count of instances which must share the same transform before
+  //! the record is rendered into the blit cache.
+  SVG_INSTANCE_CACHE_THRESHOLD = 2,
+  //! @brief Maximum area of the blit cache (in pixels).
+  SVG_INSTANCE_CACHE_MAX_AREA = 256 * 256
+};
+
+// ============================================================================
+// [Fog::SvgInstanceItem]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Item of @ref SvgInstanceRecord, everything is in the user space of
+//! the \<use\> element.
+struct FOG_NO_EXPORT SvgInstanceItem
+{
+  FOG_INLINE SvgInstanceItem() :
+    type(SVG_INSTANCE_ITEM_PATH),
+    compOp(COMPOSITE_SRC_OVER),
+    fillRule(FILL_RULE_NON_ZERO),
+    opacity(1.0f),
+    point(0.0f, 0.0f)
+  {
+  }
+
+  //! @brief Item type, see @ref SVG_INSTANCE_ITEM.
+  uint32_t type;
+  //! @brief Compositing operator.
+  uint32_t compOp;
+  //! @brief Fill rule.
+  uint32_t fillRule;
+  //! @brief Opacity.
+  float opacity;
+
+  //! @brief Flattened path.
+  PathF path;
+  //! @brief Resolved source (color, gradient or texture).
+  Pattern source;
+
+  //! @brief Image.
+  Image image;
+  //! @brief Image position.
+  PointF point;
+  //! @brief Image transform.
+  TransformF transform;
+};
+
+// ============================================================================
+// [Fog::SvgInstanceState]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Inherited state the record was made with.
+struct FOG_NO_EXPORT SvgInstanceState
+{
+  FOG_INLINE SvgInstanceState() :
+    compOp(COMPOSITE_SRC_OVER),
+    fillRule(FILL_RULE_EVEN_ODD),
+    opacity(1.0f),
+    scaleLog2(0)
+  {
+  }
+
+  void init(const SvgContext* context, int scaleLog2);
+  bool eq(const SvgContext* context, int scaleLog2) const;
+
+  SvgContextSource fillSource;
+  SvgContextSource strokeSource;
+  PathStrokerParamsF strokeParams;
+  Font font;
+
+  uint32_t compOp;
+  uint32_t fillRule;
+  //! @brief Group opacity, multiplied into the opacity of recorded items.
+  float opacity;
+
+  //! @brief Flattening was done for a scale of 2^scaleLog2.
+  int scaleLog2;
+};
+
+// ============================================================================
+// [Fog::SvgInstanceRecord]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Retained representation of element referenced by \<use\>.
+//!
+//! The element is prepared once by @ref SvgRecordContext - styles are
+//! resolved, transforms applied, strokes expanded and curves flattened - and
+//! each instance only replays the items with its own transform. Records made
+//! of source-over items only (the common case of icons) are blit-cacheable:
+//! if more instances share the same scale/rotation and sub-pixel offset, the
+//! record is rendered once into an image which is then blitted at integral
+//! device positions.
+struct FOG_NO_EXPORT SvgInstanceRecord
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgInstanceRecord();
+  ~SvgInstanceRecord();
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Record @a element, using inherited state of @a context.
+  err_t record(const SvgElement* element, const SvgContext* context, int scaleLog2);
+
+  //! @brief Replay items using @a painter, @a tr is the transform from the
+  //! user space of the \<use\> element to the painter user space.
+  err_t replay(Painter* painter, const TransformF& tr);
+
+  //! @brief Render instance, blitting from the cache when possible.
+  err_t render(Painter* painter, const TransformF& tr);
+
+  //! @brief Render items into the blit cache using @c _cacheTransform.
+  err_t _createCache();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Recorded items.
+  List<SvgInstanceItem*> _items;
+  //! @brief Inherited state.
+  SvgInstanceState _state;
+  //! @brief Bounding box of all items.
+  BoxF _bbox;
+
+  //! @brief Whether all items are composited by src-over.
+  bool _cacheable;
+
+  //! @brief Cached image.
+  Image _cache;
+  //! @brief Device transform of cached image (translation is only sub-pixel).
+  TransformF _cacheTransform;
+  //! @brief Position of cached image relative to the integral translation.
+  PointI _cacheOffset;
+  //! @brief Count of instances having @c _cacheTransform.
+  uint32_t _cacheHits;
+  //! @brief Cache can't be created for @c _cacheTransform (too large).
+  bool _cacheFailed;
+
+private:
+  FOG_NO_COPY(SvgInstanceRecord)
+};
+
+// ============================================================================
+// [Fog::SvgInstance]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Records of element referenced by \<use\>, owned by the element.
+struct FOG_NO_EXPORT SvgInstance
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgInstance();
+  ~SvgInstance();
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get record matching the current state of @a context, recording
+  //! it if not found.
+  //!
+  //! Returns @c NULL if the element can't be instanced (i.e. it contains
+  //! element with a filter), in that case it must be rendered directly.
+  SvgInstanceRecord* getRecord(const SvgElement* element, const SvgContext* context, int scaleLog2);
+
+  void reset();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Records, the oldest is the first one.
+  List<SvgInstanceRecord*> _records;
+  //! @brief Document version the records were made at.
+  uint32_t _version;
+  //! @brief Element can't be instanced.
+  bool _unsupported;
+
+private:
+  FOG_NO_COPY(SvgInstance)
+};
+
+// ============================================================================
+// [Fog::SvgRecordContext]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief SVG context which records elements into @ref SvgInstanceRecord.
+struct FOG_NO_EXPORT SvgRecordContext : public SvgContext
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgRecordContext(SvgContextExtension* contextExtension, SvgInstanceRecord* record, float flatness);
+  virtual ~SvgRecordContext();
+
+  // --------------------------------------------------------------------------
+  // [Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onVisit(SvgElement* obj);
+  virtual err_t onShape(SvgElement* obj, const ShapeF& shape);
+  virtual err_t onImage(SvgElement* obj, const PointF& pt, const Image& image);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  SvgInstanceRecord* _record;
+  float _flatness;
+  bool _unsupported;
+
+  PathF _pathTmp;
+
+private:
+  FOG_NO_COPY(SvgRecordContext)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_SVG_SVGINSTANCE_P_H
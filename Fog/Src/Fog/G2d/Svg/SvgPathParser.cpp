@@ -0,0 +1,500 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Kernel/EventLoop.h>
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/Cpu.h>
+#include <Fog/G2d/Svg/SvgPathParser_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::SvgPathTokens]
+// ============================================================================
+
+err_t SvgPathTokens::_grow(void** data, size_t& capacity, size_t itemSize)
+{
+  size_t newCapacity = (capacity == 0) ? (size_t)SVG_PATH_TOKENS_CAPACITY : capacity * 2;
+
+  if (newCapacity > SIZE_MAX / itemSize)
+    return ERR_RT_OUT_OF_MEMORY;
+
+  void* newData = MemMgr::realloc(*data, newCapacity * itemSize);
+  if (FOG_IS_NULL(newData))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  *data = newData;
+  capacity = newCapacity;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgPathTokenizer - C]
+// ============================================================================
+
+struct FOG_NO_EXPORT SvgPathClassifier_C
+{
+  static FOG_INLINE size_t countDigits(const CharW* p, const CharW* end)
+  {
+    const CharW* start = p;
+
+    while (p != end && (uint32_t)(p->getValue() - '0') < 10)
+      p++;
+
+    return (size_t)(p - start);
+  }
+};
+
+// ============================================================================
+// [Fog::SvgPathJob]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT SvgPathTask : public Task
+{
+  FOG_INLINE SvgPathTask(SvgPathJob* job) : job(job) {}
+
+  virtual void run()
+  {
+    job->run();
+    job->release();
+  }
+
+  SvgPathJob* job;
+};
+
+void SvgPathJob::run()
+{
+  size_t count = length;
+
+  for (;;)
+  {
+    size_t i = next.addXchg(1);
+    if (i >= count)
+      break;
+
+    SvgPathPart& part = parts[i];
+    SvgPathParser::tokenize(part.tokens, part.start, part.end);
+
+    if (remaining.deref())
+      event.signal();
+  }
+}
+
+// ============================================================================
+// [Fog::SvgPathParser - Parse]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get whether @a c can start a part (command letter, but not the
+//! exponent of a number).
+static FOG_INLINE bool SvgPathParser_isPartStart(uint32_t c)
+{
+  return CharW::isAsciiLetter(c) && (c | 0x20) != 'e';
+}
+
+//! @internal
+//!
+//! @brief Tokenize @a data by worker threads together with the calling thread.
+//!
+//! Returns NULL if no worker thread is available.
+static SvgPathJob* SvgPathParser_tokenizeMT(const CharW* data, size_t length)
+{
+  size_t numParts = Math::min<size_t>(length / SVG_PATH_MT_PART_LENGTH, SVG_PATH_MT_MAX_PARTS);
+  size_t numThreads = Math::min<size_t>(
+    Cpu::get()->getNumberOfProcessors(), numParts, SVG_PATH_MT_MAX_THREADS) - 1;
+
+  if (numThreads == 0)
+    return NULL;
+
+  Thread* threads[SVG_PATH_MT_MAX_THREADS];
+  ThreadPool* pool = ThreadPool::get();
+
+  while (numThreads > 0 && pool->getThreads(threads, numThreads) != ERR_OK)
+    numThreads >>= 1;
+
+  if (numThreads == 0)
+    return NULL;
+
+  SvgPathJob* job = fog_new SvgPathJob(0);
+  if (FOG_IS_NULL(job))
+  {
+    pool->releaseThreads(threads, numThreads);
+    return NULL;
+  }
+
+  // Split the data at command letters, parts which would be empty are merged
+  // with the previous ones.
+  const CharW* end = data + length;
+  const CharW* p = data;
+  size_t count = 0;
+
+  for (size_t i = 1; i <= numParts; i++)
+  {
+    const CharW* partEnd = end;
+
+    if (i < numParts)
+    {
+      const CharW* mark = data + (length / numParts) * i;
+      if (mark <= p)
+        continue;
+
+      partEnd = mark;
+      while (partEnd != end && !SvgPathParser_isPartStart(partEnd->getValue()))
+        partEnd++;
+    }
+
+    if (partEnd == p)
+      continue;
+
+    job->parts[count].start = p;
+    job->parts[count].end = partEnd;
+    count++;
+
+    p = partEnd;
+    if (p == end)
+      break;
+  }
+
+  job->length = count;
+  job->remaining.init(count);
+  job->reference.init(1 + numThreads);
+
+  for (size_t i = 0; i < numThreads; i++)
+  {
+    SvgPathTask* task = fog_new SvgPathTask(job);
+    if (FOG_IS_NULL(task) || threads[i]->getEventLoop().postTask(task) != ERR_OK)
+    {
+      if (task != NULL)
+        fog_delete(task);
+      job->reference.dec();
+    }
+  }
+
+  // The calling thread tokenizes too, then waits for parts taken by workers.
+  job->run();
+  job->event.wait();
+
+  pool->releaseThreads(threads, numThreads);
+  return job;
+}
+
+err_t SvgPathParser::parse(PathF& dst, const CharW* data, size_t length)
+{
+  if (length >= SVG_PATH_MT_MIN_LENGTH && Cpu::get()->getNumberOfProcessors() > 1)
+  {
+    SvgPathJob* job = SvgPathParser_tokenizeMT(data, length);
+
+    if (job != NULL)
+    {
+      err_t err = build(dst, job->parts, job->length);
+      job->release();
+      return err;
+    }
+  }
+
+  SvgPathPart part;
+  part.start = data;
+  part.end = data + length;
+
+  tokenize(part.tokens, part.start, part.end);
+  return build(dst, &part, 1);
+}
+
+// ============================================================================
+// [Fog::SvgPathParser - Build]
+// ============================================================================
+
+err_t SvgPathParser::build(PathF& dst, const SvgPathPart* parts, size_t count)
+{
+  err_t err = ERR_OK;
+
+  // Clear the path.
+  dst.clear();
+
+  // Reserve space for the vertices, most commands produce one vertex per
+  // coordinate pair.
+  size_t vertexCount = 0;
+
+  for (size_t i = 0; i < count; i++)
+    vertexCount += parts[i].tokens.numberCount / 2 + parts[i].tokens.commandCount;
+
+  FOG_RETURN_ON_ERROR(dst.reserve(vertexCount));
+
+  // Current and initial point.
+  PointF last(0.0f, 0.0f);
+  PointF initial(0.0f, 0.0f);
+
+  for (size_t partIndex = 0; partIndex < count; partIndex++)
+  {
+    const SvgPathTokens& tokens = parts[partIndex].tokens;
+
+    for (size_t i = 0; i < tokens.commandCount; i++)
+    {
+      uint32_t command = tokens.commands[i].command;
+
+      const float* numbers = tokens.numbers + tokens.commands[i].index;
+      size_t numberCount = (i + 1 < tokens.commandCount ? tokens.commands[i + 1].index : tokens.numberCount) - tokens.commands[i].index;
+
+      uint32_t n;
+      float coords[8];
+
+      switch (command)
+      {
+        case 'a': case 'A': n = 7; break;
+        case 'c': case 'C': n = 6; break;
+        case 'h': case 'H': n = 1; break;
+        case 'l': case 'L': n = 2; break;
+        case 'm': case 'M': n = 2; break;
+        case 'q': case 'Q': n = 4; break;
+        case 's': case 'S': n = 4; break;
+        case 't': case 'T': n = 2; break;
+        case 'v': case 'V': n = 1; break;
+        case 'z': case 'Z': n = 0; break;
+
+        // Unknown command.
+        default: goto _Bail;
+      }
+
+      if (n == 0)
+      {
+        err = dst.close();
+
+        // Clear the error which is caused by adding the PATH_CMD_CLOSE to the
+        // path without vertex or more times.
+        if (err == ERR_PATH_NO_VERTEX) err = ERR_OK;
+        if (FOG_IS_ERROR(err)) goto _Bail;
+
+        last = initial;
+
+        // Numbers can't follow the close command.
+        if (numberCount != 0) goto _Bail;
+        continue;
+      }
+
+      // The command is repeated while there are numbers.
+      while (numberCount >= n)
+      {
+        for (uint32_t j = 0; j < n; j++)
+          coords[j] = numbers[j];
+
+        numbers += n;
+        numberCount -= n;
+
+        switch (command)
+        {
+          // ------------------------------------------------------------------
+          // [Arc-To]
+          // ------------------------------------------------------------------
+
+          case 'a':
+            coords[5] += last.x; coords[6] += last.y;
+            // ... Fall through ...
+
+          case 'A':
+            err = dst.svgArcTo(
+              PointF(coords[0], coords[1]),
+              Math::deg2rad(coords[2]),
+              (bool)(int)coords[3],
+              (bool)(int)coords[4],
+              PointF(coords[5], coords[6]));
+
+            last.x = coords[5];
+            last.y = coords[6];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Cubic-To]
+          // ------------------------------------------------------------------
+
+          case 'c':
+            coords[0] += last.x; coords[1] += last.y;
+            coords[2] += last.x; coords[3] += last.y;
+            coords[4] += last.x; coords[5] += last.y;
+            // ... Fall through ...
+
+          case 'C':
+            err = dst.cubicTo(
+              PointF(coords[0], coords[1]),
+              PointF(coords[2], coords[3]),
+              PointF(coords[4], coords[5]));
+
+            last.x = coords[4];
+            last.y = coords[5];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Horizontal-Line-To]
+          // ------------------------------------------------------------------
+
+          case 'h':
+            coords[0] += last.x;
+            // ... Fall through ...
+
+          case 'H':
+            err = dst.lineTo(PointF(coords[0], last.y));
+
+            last.x = coords[0];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Line-To]
+          // ------------------------------------------------------------------
+
+          case 'l':
+            coords[0] += last.x; coords[1] += last.y;
+            // ... Fall through ...
+
+          case 'L':
+            err = dst.lineTo(PointF(coords[0], coords[1]));
+
+            last.x = coords[0];
+            last.y = coords[1];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Move-To]
+          // ------------------------------------------------------------------
+
+          case 'm':
+            // Switch command to relative line-to 'l' to match the specification.
+            command = 'l';
+
+            coords[0] += last.x;
+            coords[1] += last.y;
+            goto _MoveTo;
+
+          case 'M':
+            // Switch command to absolute line-to 'L' to match the specification.
+            command = 'L';
+_MoveTo:
+            err = dst.moveTo(PointF(coords[0], coords[1]));
+
+            last.x = coords[0];
+            last.y = coords[1];
+
+            initial = last;
+            break;
+
+          // ------------------------------------------------------------------
+          // [Quad-To]
+          // ------------------------------------------------------------------
+
+          case 'q':
+            coords[0] += last.x; coords[1] += last.y;
+            coords[2] += last.x; coords[3] += last.y;
+            // ... Fall through ...
+
+          case 'Q':
+            err = dst.quadTo(PointF(coords[0], coords[1]), PointF(coords[2], coords[3]));
+
+            last.x = coords[2];
+            last.y = coords[3];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Smooth-Cubic-To]
+          // ------------------------------------------------------------------
+
+          case 's':
+            coords[0] += last.x; coords[1] += last.y;
+            coords[2] += last.x; coords[3] += last.y;
+            // ... Fall through ...
+
+          case 'S':
+            err = dst.smoothCubicTo(PointF(coords[0], coords[1]), PointF(coords[2], coords[3]));
+
+            last.x = coords[2];
+            last.y = coords[3];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Smooth-Quad-To]
+          // ------------------------------------------------------------------
+
+          case 't':
+            coords[0] += last.x; coords[1] += last.y;
+            // ... Fall through ...
+
+          case 'T':
+            err = dst.smoothQuadTo(PointF(coords[0], coords[1]));
+
+            last.x = coords[0];
+            last.y = coords[1];
+            break;
+
+          // ------------------------------------------------------------------
+          // [Vertical-Line-To]
+          // ------------------------------------------------------------------
+
+          case 'v':
+            coords[0] += last.y;
+            // ... Fall through ...
+
+          case 'V':
+            err = dst.lineTo(PointF(last.x, coords[0]));
+
+            last.y = coords[0];
+            break;
+        }
+
+        if (FOG_IS_ERROR(err)) goto _Bail;
+      }
+
+      // Incomplete segment ends the path, report the error which cut it.
+      if (numberCount != 0)
+      {
+        if (i + 1 == tokens.commandCount) err = tokens.error;
+        goto _Bail;
+      }
+    }
+
+    if (tokens.truncated)
+    {
+      err = tokens.error;
+      goto _Bail;
+    }
+  }
+
+_Bail:
+  dst.squeeze();
+  return err;
+}
+
+// ============================================================================
+// [Fog::SvgPathParser - Statics]
+// ============================================================================
+
+SvgPathParser::TokenizeFunc SvgPathParser::tokenize;
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_CPU_DECLARE_INITIALIZER_SSE2( SvgPathParser_init_SSE2(void) )
+
+FOG_NO_EXPORT void SvgPathParser_init(void)
+{
+  SvgPathParser::tokenize = SvgPathTokenizer<SvgPathClassifier_C>::tokenize;
+
+  // --------------------------------------------------------------------------
+  // [CPU Based Optimizations]
+  // --------------------------------------------------------------------------
+
+  FOG_CPU_USE_INITIALIZER_SSE2( SvgPathParser_init_SSE2() )
+}
+
+} // Fog namespace
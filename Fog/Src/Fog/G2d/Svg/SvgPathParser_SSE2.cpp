@@ -0,0 +1,76 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Acc/AccC.h>
+#include <Fog/Core/Acc/AccSse2.h>
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/G2d/Svg/SvgPathParser_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::SvgPathTokenizer - SSE2]
+// ============================================================================
+
+FOG_XMM_DECLARE_CONST_PI16_SET(SvgPath_0, '0');
+FOG_XMM_DECLARE_CONST_PI16_SET(SvgPath_9, 9);
+
+//! @internal
+//!
+//! @brief Classifies eight characters at a time, a character is a digit if
+//! it's not above 9 after subtracting '0' (characters below '0' wrap around).
+struct FOG_NO_EXPORT SvgPathClassifier_SSE2
+{
+  static FOG_INLINE size_t countDigits(const CharW* p, const CharW* end)
+  {
+    const CharW* start = p;
+
+    while ((size_t)(end - p) >= 8)
+    {
+      __m128i x0;
+      __m128i zero;
+      int mask;
+
+      Acc::m128iLoad16u(x0, p);
+      Acc::m128iZero(zero);
+
+      Acc::m128iSubPI16(x0, x0, FOG_XMM_GET_CONST_PI(SvgPath_0));
+      Acc::m128iSubusPU16(x0, x0, FOG_XMM_GET_CONST_PI(SvgPath_9));
+      Acc::m128iCmpEqPI16(x0, x0, zero);
+      Acc::m128iMoveMaskPI8(mask, x0);
+
+      if (mask != 0xFFFF)
+      {
+        uint32_t index;
+        Acc::p32CTZ(index, ~(uint32_t)mask);
+        return (size_t)(p - start) + (index >> 1);
+      }
+
+      p += 8;
+    }
+
+    while (p != end && (uint32_t)(p->getValue() - '0') < 10)
+      p++;
+
+    return (size_t)(p - start);
+  }
+};
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void SvgPathParser_init_SSE2(void)
+{
+  SvgPathParser::tokenize = SvgPathTokenizer<SvgPathClassifier_SSE2>::tokenize;
+}
+
+} // Fog namespace
@@ -0,0 +1,414 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_SVG_SVGPATHPARSER_P_H
+#define _FOG_G2D_SVG_SVGPATHPARSER_P_H
+
+// [Dependencies]
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Tools/Char.h>
+#include <Fog/Core/Tools/StringUtil.h>
+#include <Fog/G2d/Geometry/Path.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Svg
+//! @{
+
+// ============================================================================
+// [Fog::SVG_PATH_MISC]
+// ============================================================================
+
+//! @internal
+enum SVG_PATH_MISC
+{
+  //! @brief Initial capacity of @ref SvgPathTokens arrays.
+  SVG_PATH_TOKENS_CAPACITY = 64,
+
+  //! @brief Minimum count of characters of path data to tokenize it by more
+  //! threads.
+  SVG_PATH_MT_MIN_LENGTH = 262144,
+  //! @brief Minimum count of characters of one part.
+  SVG_PATH_MT_PART_LENGTH = 65536,
+  //! @brief Maximum count of parts.
+  SVG_PATH_MT_MAX_PARTS = 64,
+  //! @brief Maximum count of threads (including the calling one).
+  SVG_PATH_MT_MAX_THREADS = 16
+};
+
+// ============================================================================
+// [Fog::SvgPathCommand]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Path command token.
+struct FOG_NO_EXPORT SvgPathCommand
+{
+  //! @brief Command letter (not validated).
+  uint32_t command;
+  //! @brief Index of the first number which follows the command.
+  size_t index;
+};
+
+// ============================================================================
+// [Fog::SvgPathTokens]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Tokenized path data - command letters and numbers which follow them.
+//!
+//! Tokens don't depend on preceding data, so a path string can be split at
+//! any command letter and its parts tokenized independently.
+struct FOG_NO_EXPORT SvgPathTokens
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE SvgPathTokens() :
+    commands(NULL),
+    commandCount(0),
+    commandCapacity(0),
+    numbers(NULL),
+    numberCount(0),
+    numberCapacity(0),
+    error(ERR_OK),
+    truncated(false)
+  {
+  }
+
+  FOG_INLINE ~SvgPathTokens()
+  {
+    if (commands != NULL)
+      MemMgr::free(commands);
+
+    if (numbers != NULL)
+      MemMgr::free(numbers);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE err_t addCommand(uint32_t command)
+  {
+    if (FOG_UNLIKELY(commandCount == commandCapacity))
+      FOG_RETURN_ON_ERROR(_grow((void**)&commands, commandCapacity, sizeof(SvgPathCommand)));
+
+    SvgPathCommand& token = commands[commandCount++];
+    token.command = command;
+    token.index = numberCount;
+    return ERR_OK;
+  }
+
+  FOG_INLINE err_t addNumber(float number)
+  {
+    if (FOG_UNLIKELY(numberCount == numberCapacity))
+      FOG_RETURN_ON_ERROR(_grow((void**)&numbers, numberCapacity, sizeof(float)));
+
+    numbers[numberCount++] = number;
+    return ERR_OK;
+  }
+
+  //! @brief Stop tokenizing, the data which follows is invalid.
+  FOG_INLINE void stop(err_t err)
+  {
+    error = err;
+    truncated = true;
+  }
+
+  static err_t _grow(void** data, size_t& capacity, size_t itemSize);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Commands.
+  SvgPathCommand* commands;
+  //! @brief Count of commands.
+  size_t commandCount;
+  //! @brief Capacity of @c commands.
+  size_t commandCapacity;
+
+  //! @brief Numbers.
+  float* numbers;
+  //! @brief Count of numbers.
+  size_t numberCount;
+  //! @brief Capacity of @c numbers.
+  size_t numberCapacity;
+
+  //! @brief Error which stopped tokenizing.
+  err_t error;
+  //! @brief Whether tokenizing stopped before the end of data.
+  bool truncated;
+
+private:
+  FOG_NO_COPY(SvgPathTokens)
+};
+
+// ============================================================================
+// [Fog::SvgPathPart]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Part of path data, starts with a command letter (except the first).
+struct FOG_NO_EXPORT SvgPathPart
+{
+  //! @brief Start of the part.
+  const CharW* start;
+  //! @brief End of the part.
+  const CharW* end;
+  //! @brief Tokens.
+  SvgPathTokens tokens;
+};
+
+// ============================================================================
+// [Fog::SvgPathTokenizer]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Path data tokenizer.
+//!
+//! @c ClassifierT provides @c countDigits(p, end), which returns the count of
+//! ASCII digits starting at @a p. Numbers are split into digit runs by it
+//! and accumulated in 64-bit integer. Numbers which can be converted exactly
+//! (at most 2^53 and power of ten in [-22, 22]) are converted directly,
+//! others by @ref StringUtil::parseReal(), so the result is always the same.
+template<typename ClassifierT>
+struct SvgPathTokenizer
+{
+  static FOG_INLINE uint64_t accumulate(uint64_t m, const CharW* p, size_t count)
+  {
+    for (size_t i = 0; i < count; i++)
+      m = m * 10 + uint32_t(p[i].getValue() - '0');
+    return m;
+  }
+
+  static FOG_INLINE err_t parseNumber(float& dst, const CharW*& pRef, const CharW* end)
+  {
+    static const double pow10[] =
+    {
+      1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7 , 1e8 , 1e9 , 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const CharW* start = pRef;
+    const CharW* p = start;
+
+    bool negative = false;
+    uint32_t c = p->getValue();
+
+    if (c == '-' || c == '+')
+    {
+      negative = (c == '-');
+      if (++p == end)
+        return ERR_STRING_INVALID_INPUT;
+    }
+
+    const CharW* intStart = p;
+    size_t intCount = ClassifierT::countDigits(p, end);
+    p += intCount;
+
+    const CharW* fracStart = p;
+    size_t fracCount = 0;
+
+    if (p != end && p->getValue() == '.')
+    {
+      fracStart = ++p;
+      fracCount = ClassifierT::countDigits(p, end);
+      p += fracCount;
+    }
+
+    if (intCount + fracCount == 0)
+      return ERR_STRING_INVALID_INPUT;
+
+    // Exponent is consumed only if it's followed by digits.
+    int exponent = 0;
+    bool slow = (intCount + fracCount > 19);
+
+    if (p != end && (p->getValue() | 0x20) == 'e')
+    {
+      const CharW* e = p + 1;
+      bool expNegative = false;
+
+      if (e != end && (e->getValue() == '-' || e->getValue() == '+'))
+        expNegative = (e++)->getValue() == '-';
+
+      size_t expCount = ClassifierT::countDigits(e, end);
+      if (expCount != 0)
+      {
+        if (expCount > 4)
+          slow = true;
+        else
+          exponent = int(accumulate(0, e, expCount));
+
+        if (expNegative)
+          exponent = -exponent;
+        p = e + expCount;
+      }
+    }
+
+    if (!slow)
+    {
+      uint64_t m = accumulate(accumulate(0, intStart, intCount), fracStart, fracCount);
+      exponent -= int(fracCount);
+
+      if (m <= (FOG_UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22)
+      {
+        double d = double(int64_t(m));
+
+        if (exponent < 0)
+          d /= pow10[-exponent];
+        else
+          d *= pow10[exponent];
+
+        dst = float(negative ? -d : d);
+        pRef = p;
+        return ERR_OK;
+      }
+    }
+
+    size_t numEnd;
+    FOG_RETURN_ON_ERROR(StringUtil::parseReal(&dst, start, (size_t)(end - start), CharW('.'), &numEnd));
+
+    pRef = start + numEnd;
+    return ERR_OK;
+  }
+
+  static void FOG_FASTCALL tokenize(SvgPathTokens& tokens, const CharW* p, const CharW* end)
+  {
+    err_t err;
+
+    for (;;)
+    {
+      // Skip spaces.
+      while (p != end && CharW::isSpace(p->getValue()))
+        p++;
+
+      if (p == end)
+        return;
+
+      uint32_t c = p->getValue();
+
+      if (CharW::isAsciiLetter(c))
+      {
+        err = tokens.addCommand(c);
+        if (FOG_IS_ERROR(err))
+          goto _Stop;
+
+        p++;
+        continue;
+      }
+
+      // Data which doesn't start with a command are ignored.
+      if (tokens.commandCount == 0)
+      {
+        tokens.stop(ERR_OK);
+        return;
+      }
+
+      float number;
+      err = parseNumber(number, p, end);
+      if (FOG_IS_ERROR(err))
+        goto _Stop;
+
+      err = tokens.addNumber(number);
+      if (FOG_IS_ERROR(err))
+        goto _Stop;
+
+      // Comma can follow the number.
+      while (p != end && CharW::isSpace(p->getValue()))
+        p++;
+
+      if (p != end && p->getValue() == ',')
+        p++;
+    }
+
+_Stop:
+    tokens.stop(err);
+  }
+};
+
+// ============================================================================
+// [Fog::SvgPathParser]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief SVG path data parser.
+//!
+//! The data are tokenized first, then the path is built from the tokens. Long
+//! path data are split at command letters and tokenized by more threads.
+//!
+//! The tokenizer is a function pointer initialized by @c SvgPathParser_init(),
+//! it's replaced by SSE2 version when available.
+struct FOG_NO_EXPORT SvgPathParser
+{
+  typedef void (FOG_FASTCALL *TokenizeFunc)(SvgPathTokens& tokens, const CharW* p, const CharW* end);
+
+  //! @brief Parse path data into @a dst.
+  static err_t parse(PathF& dst, const CharW* data, size_t length);
+
+  //! @brief Build path from tokens of @a parts.
+  static err_t build(PathF& dst, const SvgPathPart* parts, size_t count);
+
+  //! @brief Tokenize path data.
+  static TokenizeFunc tokenize;
+};
+
+// ============================================================================
+// [Fog::SvgPathJob]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Context shared by threads which tokenize parts of path data.
+struct FOG_NO_EXPORT SvgPathJob
+{
+  FOG_INLINE SvgPathJob(size_t length) :
+    event(false, false),
+    length(length)
+  {
+    next.init(0);
+    remaining.init(length);
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      fog_delete(this);
+  }
+
+  //! @brief Tokenize parts until there is nothing left.
+  void run();
+
+  //! @brief Reference count (the calling thread and each task).
+  Atomic<size_t> reference;
+  //! @brief Index of the next part to tokenize.
+  Atomic<size_t> next;
+  //! @brief Count of parts not tokenized yet.
+  Atomic<size_t> remaining;
+  //! @brief Signaled when all parts are tokenized.
+  ThreadEvent event;
+
+  //! @brief Count of parts.
+  size_t length;
+  //! @brief Parts.
+  SvgPathPart parts[SVG_PATH_MT_MAX_PARTS];
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_SVG_SVGPATHPARSER_P_H
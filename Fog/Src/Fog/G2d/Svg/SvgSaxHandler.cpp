@@ -0,0 +1,316 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Kernel/EventLoop.h>
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/Cpu.h>
+#include <Fog/Core/Tools/InternedString.h>
+#include <Fog/G2d/Svg/SvgContext.h>
+#include <Fog/G2d/Svg/SvgDom.h>
+#include <Fog/G2d/Svg/SvgSaxHandler_p.h>
+#include <Fog/G2d/Svg/SvgUtil.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::SvgSaxChunk]
+// ============================================================================
+
+void SvgSaxChunk::parse()
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    const SvgSaxItem& item = items[i];
+
+    // Getters parse the pending attribute and cache the result.
+    switch (item.attribute)
+    {
+      case SVG_SAX_ATTRIBUTE_PATH:
+        static_cast<SvgPathElement*>(item.element)->getD();
+        break;
+
+      case SVG_SAX_ATTRIBUTE_POLYGON:
+        static_cast<SvgPolygonElement*>(item.element)->getPoints();
+        break;
+
+      case SVG_SAX_ATTRIBUTE_POLYLINE:
+        static_cast<SvgPolylineElement*>(item.element)->getPoints();
+        break;
+
+      case SVG_SAX_ATTRIBUTE_TRANSFORM:
+        static_cast<SvgTransformableElement*>(item.element)->getTransform();
+        break;
+
+      default:
+        FOG_ASSERT_NOT_REACHED();
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::SvgSaxJob]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT SvgSaxTask : public Task
+{
+  FOG_INLINE SvgSaxTask(SvgSaxJob* job) : job(job) {}
+
+  virtual void run()
+  {
+    job->run();
+    job->release();
+  }
+
+  SvgSaxJob* job;
+};
+
+void SvgSaxJob::run()
+{
+  // The job can be accessed after the last chunk has been parsed, but the
+  // chunks can't, they are released by the handler.
+  size_t count = length;
+
+  for (;;)
+  {
+    size_t i = next.addXchg(1);
+    if (i >= count)
+      break;
+
+    chunks[i]->parse();
+
+    if (remaining.deref())
+      event.signal();
+  }
+}
+
+// ============================================================================
+// [Fog::SvgSaxHandler - Helpers]
+// ============================================================================
+
+static FOG_INLINE bool SvgSaxHandler_isTransformable(uint32_t svgType)
+{
+  switch (svgType)
+  {
+    case SVG_ELEMENT_A:
+    case SVG_ELEMENT_CIRCLE:
+    case SVG_ELEMENT_ELLIPSE:
+    case SVG_ELEMENT_G:
+    case SVG_ELEMENT_IMAGE:
+    case SVG_ELEMENT_LINE:
+    case SVG_ELEMENT_PATH:
+    case SVG_ELEMENT_POLYGON:
+    case SVG_ELEMENT_POLYLINE:
+    case SVG_ELEMENT_RECT:
+    case SVG_ELEMENT_TEXT:
+    case SVG_ELEMENT_TSPAN:
+    case SVG_ELEMENT_USE:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// ============================================================================
+// [Fog::SvgSaxHandler - Construction / Destruction]
+// ============================================================================
+
+SvgSaxHandler::SvgSaxHandler(SvgDocument* document) :
+  DomSaxHandler(document),
+  _valueLength(0),
+  _defsDepth(0),
+  _parseAhead(Cpu::get()->getNumberOfProcessors() > 1)
+{
+}
+
+SvgSaxHandler::~SvgSaxHandler()
+{
+  _reset();
+}
+
+// ============================================================================
+// [Fog::SvgSaxHandler - SAX Interface]
+// ============================================================================
+
+err_t SvgSaxHandler::onEndDocument()
+{
+  // Called also if the parser failed, the DOM created so far is kept.
+  _parse();
+  _reset();
+
+  return DomSaxHandler::onEndDocument();
+}
+
+err_t SvgSaxHandler::onStartElement(const StubW& tagName)
+{
+  FOG_RETURN_ON_ERROR(DomSaxHandler::onStartElement(tagName));
+
+  if (_currentContainer->isSvgObject(SVG_ELEMENT_DEFS) ||
+      _currentContainer->isSvgObject(SVG_ELEMENT_SYMBOL))
+  {
+    _defsDepth++;
+  }
+
+  return ERR_OK;
+}
+
+err_t SvgSaxHandler::onEndElement(const StubW& tagName)
+{
+  if (_currentContainer != NULL &&
+      (_currentContainer->isSvgObject(SVG_ELEMENT_DEFS) ||
+       _currentContainer->isSvgObject(SVG_ELEMENT_SYMBOL)))
+  {
+    _defsDepth--;
+  }
+
+  return DomSaxHandler::onEndElement(tagName);
+}
+
+err_t SvgSaxHandler::onAttribute(const StubW& name, const StubW& value)
+{
+  FOG_RETURN_ON_ERROR(DomSaxHandler::onAttribute(name, value));
+
+  // The value is stored by the element as is, but elements which are going
+  // to be rendered have it parsed ahead by worker threads.
+  if (!_parseAhead || _defsDepth > 0 || _currentContainer == _document || !_currentContainer->isSvg())
+    return ERR_OK;
+
+  SvgElement* element = static_cast<SvgElement*>(_currentContainer);
+  uint32_t svgType = element->_objectType;
+
+  InternedStringW nameInterned(name);
+
+  if (nameInterned == FOG_S(d))
+  {
+    if (svgType == SVG_ELEMENT_PATH)
+      return _add(element, SVG_SAX_ATTRIBUTE_PATH, value.getLength());
+  }
+  else if (nameInterned == FOG_S(points))
+  {
+    if (svgType == SVG_ELEMENT_POLYGON)
+      return _add(element, SVG_SAX_ATTRIBUTE_POLYGON, value.getLength());
+    if (svgType == SVG_ELEMENT_POLYLINE)
+      return _add(element, SVG_SAX_ATTRIBUTE_POLYLINE, value.getLength());
+  }
+  else if (nameInterned == FOG_S(transform))
+  {
+    if (SvgSaxHandler_isTransformable(svgType))
+      return _add(element, SVG_SAX_ATTRIBUTE_TRANSFORM, value.getLength());
+  }
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::SvgSaxHandler - Parse-Ahead]
+// ============================================================================
+
+err_t SvgSaxHandler::_add(SvgElement* element, uint32_t attribute, size_t valueLength)
+{
+  SvgSaxChunk* chunk = NULL;
+
+  if (!_chunks.isEmpty())
+  {
+    chunk = _chunks.getLast();
+    if (chunk->length == SVG_SAX_CHUNK_ITEMS || chunk->valueLength >= SVG_SAX_CHUNK_LENGTH)
+      chunk = NULL;
+  }
+
+  if (chunk == NULL)
+  {
+    chunk = fog_new SvgSaxChunk();
+    if (FOG_IS_NULL(chunk))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    if (_chunks.append(chunk) != ERR_OK)
+    {
+      fog_delete(chunk);
+      return ERR_RT_OUT_OF_MEMORY;
+    }
+  }
+
+  SvgSaxItem& item = chunk->items[chunk->length++];
+  item.element = element;
+  item.attribute = attribute;
+
+  chunk->valueLength += valueLength;
+  _valueLength += valueLength;
+
+  return ERR_OK;
+}
+
+void SvgSaxHandler::_parse()
+{
+  size_t length = _chunks.getLength();
+
+  // Small documents are not worth the synchronization and without worker
+  // threads the attributes are better parsed on the first use.
+  if (length < 2 || _valueLength < SVG_SAX_MT_MIN_LENGTH)
+    return;
+
+  SvgSaxChunk** chunks = const_cast<SvgSaxChunk**>(_chunks.getData());
+
+  size_t numThreads = Math::min<size_t>(
+    Cpu::get()->getNumberOfProcessors(), length, SVG_SAX_MT_MAX_THREADS) - 1;
+
+  Thread* threads[SVG_SAX_MT_MAX_THREADS];
+  ThreadPool* pool = ThreadPool::get();
+
+  while (numThreads > 0 && pool->getThreads(threads, numThreads) != ERR_OK)
+    numThreads >>= 1;
+
+  if (numThreads == 0)
+    return;
+
+  SvgSaxJob* job = fog_new SvgSaxJob(chunks, length);
+  if (FOG_IS_NULL(job))
+  {
+    pool->releaseThreads(threads, numThreads);
+    return;
+  }
+
+  job->reference.init(1 + numThreads);
+
+  for (size_t i = 0; i < numThreads; i++)
+  {
+    SvgSaxTask* task = fog_new SvgSaxTask(job);
+    if (FOG_IS_NULL(task) || threads[i]->getEventLoop().postTask(task) != ERR_OK)
+    {
+      if (task != NULL)
+        fog_delete(task);
+      job->reference.dec();
+    }
+  }
+
+  // The calling thread parses too, then waits for chunks taken by workers.
+  job->run();
+  job->event.wait();
+
+  pool->releaseThreads(threads, numThreads);
+  job->release();
+}
+
+void SvgSaxHandler::_reset()
+{
+  size_t length = _chunks.getLength();
+
+  for (size_t i = 0; i < length; i++)
+    fog_delete(_chunks.getAt(i));
+
+  _chunks.reset();
+  _valueLength = 0;
+}
+
+} // Fog namespace
@@ -0,0 +1,213 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_SVG_SVGSAXHANDLER_P_H
+#define _FOG_G2D_SVG_SVGSAXHANDLER_P_H
+
+// [Dependencies]
+#include <Fog/Core/Dom/Dom.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Tools/List.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Svg
+//! @{
+
+// ============================================================================
+// [Fog::SVG_SAX_ATTRIBUTE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Type of attribute parsed ahead of use.
+enum SVG_SAX_ATTRIBUTE
+{
+  //! @brief Path data - "d" attribute of \<path\>.
+  SVG_SAX_ATTRIBUTE_PATH = 0,
+  //! @brief Points - "points" attribute of \<polygon\>.
+  SVG_SAX_ATTRIBUTE_POLYGON = 1,
+  //! @brief Points - "points" attribute of \<polyline\>.
+  SVG_SAX_ATTRIBUTE_POLYLINE = 2,
+  //! @brief Transform - "transform" attribute of transformable element.
+  SVG_SAX_ATTRIBUTE_TRANSFORM = 3
+};
+
+// ============================================================================
+// [Fog::SVG_SAX_MISC]
+// ============================================================================
+
+//! @internal
+enum SVG_SAX_MISC
+{
+  //! @brief Maximum count of items in one chunk.
+  SVG_SAX_CHUNK_ITEMS = 256,
+  //! @brief Chunk is closed when its values contain more characters.
+  SVG_SAX_CHUNK_LENGTH = 16384,
+
+  //! @brief Minimum count of characters of all attributes to parse them
+  //! ahead by worker threads.
+  SVG_SAX_MT_MIN_LENGTH = 65536,
+  //! @brief Maximum count of threads (including the calling one).
+  SVG_SAX_MT_MAX_THREADS = 16
+};
+
+// ============================================================================
+// [Fog::SvgSaxItem]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Attribute which is parsed when the document has been read.
+struct FOG_NO_EXPORT SvgSaxItem
+{
+  //! @brief Element which owns the attribute.
+  SvgElement* element;
+  //! @brief Attribute type, see @ref SVG_SAX_ATTRIBUTE.
+  uint32_t attribute;
+};
+
+// ============================================================================
+// [Fog::SvgSaxChunk]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Chunk of attributes, unit of work of @ref SvgSaxJob.
+struct FOG_NO_EXPORT SvgSaxChunk
+{
+  FOG_INLINE SvgSaxChunk() :
+    length(0),
+    valueLength(0)
+  {
+  }
+
+  //! @brief Parse all items (each element is touched by one thread only).
+  void parse();
+
+  //! @brief Count of used items.
+  size_t length;
+  //! @brief Count of characters of all values.
+  size_t valueLength;
+
+  //! @brief Items.
+  SvgSaxItem items[SVG_SAX_CHUNK_ITEMS];
+};
+
+// ============================================================================
+// [Fog::SvgSaxJob]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Context shared by threads which parse attributes.
+struct FOG_NO_EXPORT SvgSaxJob
+{
+  FOG_INLINE SvgSaxJob(SvgSaxChunk** chunks, size_t length) :
+    event(false, false),
+    chunks(chunks),
+    length(length)
+  {
+    next.init(0);
+    remaining.init(length);
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      fog_delete(this);
+  }
+
+  //! @brief Parse chunks until there is nothing left.
+  void run();
+
+  //! @brief Reference count (the calling thread and each task).
+  Atomic<size_t> reference;
+  //! @brief Index of the next chunk to parse.
+  Atomic<size_t> next;
+  //! @brief Count of chunks not parsed yet.
+  Atomic<size_t> remaining;
+  //! @brief Signaled when all chunks are parsed.
+  ThreadEvent event;
+
+  //! @brief Chunks (owned by @ref SvgSaxHandler).
+  SvgSaxChunk** chunks;
+  //! @brief Count of chunks.
+  size_t length;
+};
+
+// ============================================================================
+// [Fog::SvgSaxHandler]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Implements @ref XmlSaxHandler to create @ref SvgDocument.
+//!
+//! Nodes are created by the parsing thread in document order like in
+//! @ref DomSaxHandler. Heavy attribute payloads (path data, points and
+//! transforms) are kept as strings by the elements and parsed on the first
+//! use. If there are enough of them and worker threads are available, the
+//! attributes of elements which are going to be rendered (not in \<defs\>
+//! or \<symbol\>) are parsed in parallel when the whole document has been
+//! read.
+struct FOG_NO_EXPORT SvgSaxHandler : public DomSaxHandler
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  SvgSaxHandler(SvgDocument* document);
+  virtual ~SvgSaxHandler();
+
+  // --------------------------------------------------------------------------
+  // [SAX - Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onEndDocument() override;
+  virtual err_t onStartElement(const StubW& tagName) override;
+  virtual err_t onEndElement(const StubW& tagName) override;
+  virtual err_t onAttribute(const StubW& name, const StubW& value) override;
+
+  // --------------------------------------------------------------------------
+  // [Parse-Ahead]
+  // --------------------------------------------------------------------------
+
+  //! @brief Add attribute to be parsed when the document has been read.
+  err_t _add(SvgElement* element, uint32_t attribute, size_t valueLength);
+
+  //! @brief Parse all added attributes using worker threads (attributes are
+  //! left unparsed if no thread is available).
+  void _parse();
+  //! @brief Free all chunks.
+  void _reset();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Chunks of attributes to parse.
+  List<SvgSaxChunk*> _chunks;
+  //! @brief Count of characters of all attributes to parse.
+  size_t _valueLength;
+  //! @brief Depth of \<defs\> and \<symbol\> elements, their content is not
+  //! parsed ahead.
+  size_t _defsDepth;
+  //! @brief Whether there are more processors, otherwise nothing is parsed
+  //! ahead.
+  bool _parseAhead;
+
+private:
+  FOG_NO_COPY(SvgSaxHandler)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_SVG_SVGSAXHANDLER_P_H
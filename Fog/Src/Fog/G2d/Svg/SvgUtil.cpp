@@ -5,9 +5,11 @@
 
 // [Dependencies]
 #include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Tools/Algorithm.h>
 #include <Fog/Core/Tools/StringUtil.h>
 #include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Svg/SvgPathParser_p.h>
 #include <Fog/G2d/Svg/SvgUtil.h>
 
 namespace Fog {
@@ -199,7 +201,7 @@ _Start:
           goto _End;
         goto _Done;
       }
-      else if (srcCur[0].isAsciiDigit() || srcCur[0] == CharW('-') || srcCur[0] == CharW('+'))
+      else if (srcCur[0].isAsciiDigit() || srcCur[0] == CharW('-') || srcCur[0] == CharW('+') || srcCur[0] == CharW('.'))
       {
         break;
       }
@@ -486,269 +488,60 @@ _Bail:
 }
 
 // ============================================================================
-// [Fog::SvgUtil - Parse - Path]
+// [Fog::SvgUtil - Parse - NumberList]
 // ============================================================================
 
-err_t parsePath(PathF& dst, const StringW& src)
+err_t parseNumberList(List<float>& dst, const StringW& src)
 {
   err_t err = ERR_OK;
 
   const CharW* srcCur = src.getData();
   const CharW* srcEnd = srcCur + src.getLength();
 
-  uint32_t command = 0;
-  uint32_t position;
-  uint32_t count;
-  float coords[10];
-
-  // Clear the path.
+  // Clear the list.
   dst.clear();
 
-  // Is his a first coordinate.
-  PointF last(0.0f, 0.0f);
-  PointF initial(0.0f, 0.0f);
+  // Finished?
+  if (srcCur == srcEnd) goto _Bail;
 
+  // Parse numbers.
   for (;;)
   {
-    // Finished?
-    if (srcCur == srcEnd) goto _Bail;
-
     // Skip spaces.
     while (srcCur->isSpace())
     {
-      if (++srcCur == srcEnd) goto _Bail;
-    }
-
-    // Parse command.
-    if (!srcCur->isAsciiLetter())
-    {
-      if (command == 0) goto _Bail;
-    }
-    else
-    {
-      command = srcCur->getValue();
       if (++srcCur == srcEnd)
-      {
-        if (command == 'Z' || command == 'z') goto _Close;
         goto _Bail;
-      }
     }
 
-    switch (command)
-    {
-      case 'a': case 'A': count = 7; break;
-      case 'c': case 'C': count = 6; break;
-      case 'h': case 'H': count = 1; break;
-      case 'l': case 'L': count = 2; break;
-      case 'm': case 'M': count = 2; break;
-      case 'q': case 'Q': count = 4; break;
-      case 's': case 'S': count = 4; break;
-      case 't': case 'T': count = 2; break;
-      case 'v': case 'V': count = 1; break;
-      case 'z': case 'Z': count = 0; break;
-
-      // Unknown command.
-      default: goto _Bail;
-    }
-
-    // Parse coordinates.
-    for (position = 0; position < count; position++)
-    {
-      // Skip spaces.
-      while (srcCur->isSpace())
-      {
-        if (++srcCur == srcEnd) goto _Bail;
-      }
+    // Parse number.
+    float number;
+    size_t numEnd;
 
-      // Parse number.
-      size_t numEnd;
+    err = StringUtil::parseReal(&number, srcCur, (size_t)(srcEnd - srcCur), CharW('.'), &numEnd);
+    if (FOG_IS_ERROR(err))
+      goto _Bail;
 
-      err = StringUtil::parseReal(&coords[position], srcCur, (size_t)(srcEnd - srcCur), CharW('.'), &numEnd);
-      if (FOG_IS_ERROR(err)) goto _Bail;
+    err = dst.append(number);
+    if (FOG_IS_ERROR(err))
+      goto _Bail;
 
-      srcCur += numEnd;
-      if (srcCur == srcEnd) break;
+    srcCur += numEnd;
+    if (srcCur == srcEnd)
+      break;
 
-      if (*srcCur == CharW(','))
-      {
-        if (++srcCur == srcEnd) break;
-      }
+    // Skip spaces before the optional comma.
+    while (srcCur->isSpace())
+    {
+      if (++srcCur == srcEnd)
+        goto _Bail;
     }
 
-    switch (command)
+    if (*srcCur == CharW(','))
     {
-      // ----------------------------------------------------------------------
-      // [Arc-To]
-      // ----------------------------------------------------------------------
-
-      case 'a':
-        coords[5] += last.x; coords[6] += last.y;
-        // ... Fall through ...
-
-      case 'A':
-        err = dst.svgArcTo(
-          PointF(coords[0], coords[1]),
-          Math::deg2rad(coords[2]),
-          (bool)(int)coords[3],
-          (bool)(int)coords[4],
-          PointF(coords[5], coords[6]));
-
-        last.x = coords[5];
-        last.y = coords[6];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Cubic-To]
-      // ----------------------------------------------------------------------
-
-      case 'c':
-        coords[0] += last.x; coords[1] += last.y;
-        coords[2] += last.x; coords[3] += last.y;
-        coords[4] += last.x; coords[5] += last.y;
-        // ... Fall through ...
-
-      case 'C':
-        err = dst.cubicTo(
-          PointF(coords[0], coords[1]),
-          PointF(coords[2], coords[3]),
-          PointF(coords[4], coords[5]));
-
-        last.x = coords[4];
-        last.y = coords[5];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Horizontal-Line-To]
-      // ----------------------------------------------------------------------
-
-      case 'h':
-        coords[0] += last.x;
-        // ... Fall through ...
-
-      case 'H':
-        err = dst.lineTo(PointF(coords[0], last.y));
-
-        last.x = coords[0];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Line-To]
-      // ----------------------------------------------------------------------
-
-      case 'l':
-        coords[0] += last.x; coords[1] += last.y;
-        // ... Fall through ...
-
-      case 'L':
-        err = dst.lineTo(PointF(coords[0], coords[1]));
-
-        last.x = coords[0];
-        last.y = coords[1];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Move-To]
-      // ----------------------------------------------------------------------
-
-      case 'm':
-        // Switch command to relative line-to 'l' to match the specification.
-        command = 'l';
-
-        coords[0] += last.x;
-        coords[1] += last.y;
-        goto _MoveTo;
-
-      case 'M':
-        // Switch command to absolute line-to 'L' to match the specification.
-        command = 'L';
-_MoveTo:
-        err = dst.moveTo(PointF(coords[0], coords[1]));
-
-        last.x = coords[0];
-        last.y = coords[1];
-
-        initial = last;
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Quad-To]
-      // ----------------------------------------------------------------------
-
-      case 'q':
-        coords[0] += last.x; coords[1] += last.y;
-        coords[2] += last.x; coords[3] += last.y;
-        // ... Fall through ...
-
-      case 'Q':
-        err = dst.quadTo(PointF(coords[0], coords[1]), PointF(coords[2], coords[3]));
-
-        last.x = coords[2];
-        last.y = coords[3];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Smooth-Cubic-To]
-      // ----------------------------------------------------------------------
-
-      case 's':
-        coords[0] += last.x; coords[1] += last.y;
-        coords[2] += last.x; coords[3] += last.y;
-        // ... Fall through ...
-
-      case 'S':
-        err = dst.smoothCubicTo(PointF(coords[0], coords[1]), PointF(coords[2], coords[3]));
-
-        last.x = coords[2];
-        last.y = coords[3];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Smooth-Quad-To]
-      // ----------------------------------------------------------------------
-
-      case 't':
-        coords[0] += last.x; coords[1] += last.y;
-        // ... Fall through ...
-
-      case 'T':
-        err = dst.smoothQuadTo(PointF(coords[0], coords[1]));
-
-        last.x = coords[0];
-        last.y = coords[1];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Vertical-Line-To]
-      // ----------------------------------------------------------------------
-
-      case 'v':
-        coords[0] += last.y;
-        // ... Fall through ...
-
-      case 'V':
-        err = dst.lineTo(PointF(last.x, coords[0]));
-
-        last.y = coords[0];
-        break;
-
-      // ----------------------------------------------------------------------
-      // [Close]
-      // ----------------------------------------------------------------------
-
-      case 'Z':
-      case 'z':
-_Close:
-        err = dst.close();
-
-        // Clear the error which is caused by adding the PATH_CMD_CLOSE to the
-        // path without vertex or more times.
-        if (err == ERR_PATH_NO_VERTEX) err = ERR_OK;
-
-        last = initial;
+      if (++srcCur == srcEnd)
         break;
     }
-
-    if (FOG_IS_ERROR(err)) goto _Bail;
   }
 
 _Bail:
@@ -756,6 +549,15 @@ _Bail:
   return err;
 }
 
+// ============================================================================
+// [Fog::SvgUtil - Parse - Path]
+// ============================================================================
+
+err_t parsePath(PathF& dst, const StringW& src)
+{
+  return SvgPathParser::parse(dst, src.getData(), src.getLength());
+}
+
 // ============================================================================
 // [Fog::SvgUtil - Parse - CSSStyle]
 // ============================================================================
@@ -919,6 +721,7 @@ err_t serializeColor(StringW& dst, const Color& color)
 
 err_t serializeColor(StringW& dst, const Argb32& argb32)
 {
+  FOG_RETURN_ON_ERROR( dst.append(CharW('#')) );
   return dst.appendInt(argb32.getPacked32() & 0x00FFFFFF, FormatInt(16, NO_FLAGS, 6));
 }
 
@@ -975,33 +778,229 @@ err_t serializeViewBox(StringW& dst, const BoxF& src)
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::SvgUtil - Serialize - Number]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Maximum count of bytes written by @ref SvgUtil_writeNumber().
+#define SVG_UTIL_NUMBER_LENGTH 24
+
+static const double SvgUtil_pow10Table[] =
+{
+  1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7 , 1e8 , 1e9 , 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static FOG_INLINE double SvgUtil_pow10(int k)
+{
+  if (k >= 0 && k <= 22)
+    return SvgUtil_pow10Table[k];
+  else
+    return Math::pow(10.0, double(k));
+}
+
+static FOG_INLINE char* SvgUtil_writeDigits(char* p, uint32_t n, uint32_t& count)
+{
+  char tmp[10];
+  uint32_t i = 0;
+
+  do {
+    tmp[i++] = char('0' + uint32_t(n % 10));
+    n /= 10;
+  } while (n != 0);
+
+  count = i;
+  while (i)
+    *p++ = tmp[--i];
+  return p;
+}
+
+//! @internal
+//!
+//! @brief Write the shortest decimal representation of @a v which is parsed
+//! back to the same float (the leading zero is omitted, ".5").
+//!
+//! Returns the end of the written number, at most @c SVG_UTIL_NUMBER_LENGTH
+//! bytes are written.
+static char* SvgUtil_writeNumber(char* p, float v)
+{
+  if (v == 0.0f || !Math::isFinite(v))
+  {
+    *p++ = '0';
+    return p;
+  }
+
+  if (v < 0.0f)
+  {
+    *p++ = '-';
+    v = -v;
+  }
+
+  // Decimal exponent, d is in [10^e, 10^(e+1)).
+  double d = v;
+  int e = 0;
+
+  while (d >= SvgUtil_pow10(e + 1))
+    e++;
+  while (d < SvgUtil_pow10(e))
+    e--;
+
+  // Find the least count of significant digits the float can be restored
+  // from, 9 digits are always enough.
+  uint32_t n = 0;
+  int dec = 0;
+
+  for (int precision = 1; precision <= 9; precision++)
+  {
+    double back;
+    dec = precision - 1 - e;
+
+    if (dec >= 0)
+    {
+      double scale = SvgUtil_pow10(dec);
+      n = uint32_t(d * scale + 0.5);
+      back = double(n) / scale;
+    }
+    else
+    {
+      double scale = SvgUtil_pow10(-dec);
+      n = uint32_t(d / scale + 0.5);
+      back = double(n) * scale;
+    }
+
+    if (float(back) == v)
+      break;
+  }
+
+  char digits[10];
+  uint32_t count;
+  SvgUtil_writeDigits(digits, n, count);
+
+  // Trailing zeros (rounding can produce them) are not significant.
+  while (count > 1 && digits[count - 1] == '0')
+  {
+    count--;
+    dec--;
+  }
+
+  // Exponent of the first significant digit.
+  int exponent = int(count) - 1 - dec;
+
+  if (exponent >= -4 && exponent <= 8)
+  {
+    if (dec <= 0)
+    {
+      // Integer.
+      MemOps::copy(p, digits, count);
+      p += count;
+
+      while (dec++ < 0)
+        *p++ = '0';
+    }
+    else if (uint32_t(dec) >= count)
+    {
+      // Fraction only (".05").
+      *p++ = '.';
+      for (uint32_t i = count; i < uint32_t(dec); i++)
+        *p++ = '0';
+
+      MemOps::copy(p, digits, count);
+      p += count;
+    }
+    else
+    {
+      uint32_t intCount = count - uint32_t(dec);
+
+      MemOps::copy(p, digits, intCount);
+      p += intCount;
+      *p++ = '.';
+      MemOps::copy(p, digits + intCount, uint32_t(dec));
+      p += dec;
+    }
+  }
+  else
+  {
+    // Scientific notation for very small and very large numbers.
+    *p++ = digits[0];
+    if (count > 1)
+    {
+      *p++ = '.';
+      MemOps::copy(p, digits + 1, count - 1);
+      p += count - 1;
+    }
+
+    *p++ = 'e';
+    if (exponent < 0)
+    {
+      *p++ = '-';
+      exponent = -exponent;
+    }
+    p = SvgUtil_writeDigits(p, uint32_t(exponent), count);
+  }
+
+  return p;
+}
+
 // ============================================================================
 // [Fog::SvgUtil - Serialize - Points]
 // ============================================================================
 
-err_t serializePoints(StringW& dst, const PathF& src)
+err_t serializePoints(StringA& dst, const PathF& src)
 {
   size_t pathLength = src.getLength();
-  size_t i = 0;
-  
+
   const uint8_t* cmd = src.getCommands();
   const PointF* pts = src.getVertices();
 
-  bool isFirst = true;
+  char* dstStart = dst._add(pathLength * (SVG_UTIL_NUMBER_LENGTH * 2 + 2));
+  if (FOG_IS_NULL(dstStart))
+    return ERR_RT_OUT_OF_MEMORY;
 
-  while (i < pathLength)
+  char* p = dstStart;
+
+  for (size_t i = 0; i < pathLength; i++)
   {
-    if (cmd[0] != PATH_CMD_CLOSE)
-    {
-      if (!isFirst)
-        FOG_RETURN_ON_ERROR(dst.append(CharW(' ')));
-      else
-        isFirst = false;
+    if (cmd[i] == PATH_CMD_CLOSE)
+      continue;
 
-      FOG_RETURN_ON_ERROR(dst.appendFormat("%g,%g", pts[0].x, pts[0].y));
-    }
+    if (p != dstStart)
+      *p++ = ' ';
+
+    p = SvgUtil_writeNumber(p, pts[i].x);
+    *p++ = ',';
+    p = SvgUtil_writeNumber(p, pts[i].y);
   }
-  
+
+  dst._modified(p);
+  return ERR_OK;
+}
+
+err_t serializePoints(StringW& dst, const PathF& src)
+{
+  StringA tmp;
+  FOG_RETURN_ON_ERROR(serializePoints(tmp, src));
+
+  return dst.append(Ascii8(tmp.getData(), tmp.getLength()));
+}
+
+// ============================================================================
+// [Fog::SvgUtil - Serialize - NumberList]
+// ============================================================================
+
+err_t serializeNumberList(StringW& dst, const List<float>& src)
+{
+  size_t i, length = src.getLength();
+  const float* data = src.getData();
+
+  for (i = 0; i < length; i++)
+  {
+    if (i != 0)
+      FOG_RETURN_ON_ERROR(dst.append(CharW(' ')));
+    FOG_RETURN_ON_ERROR(dst.appendFormat("%g", data[i]));
+  }
+
   return ERR_OK;
 }
 
@@ -1009,118 +1008,367 @@ err_t serializePoints(StringW& dst, const PathF& src)
 // [Fog::SvgUtil - Serialize - Path]
 // ============================================================================
 
-err_t serializePath(StringW& dst, const PathF& src)
+//! @internal
+//!
+//! @brief Formatted number.
+struct FOG_NO_EXPORT SvgUtil_Number
+{
+  FOG_INLINE void set(float v)
+  {
+    length = (uint32_t)(SvgUtil_writeNumber(data, v) - data);
+    dot = false;
+
+    for (uint32_t i = 0; i < length; i++)
+      dot |= (data[i] == '.') | (data[i] == 'e');
+  }
+
+  //! @brief Characters.
+  char data[SVG_UTIL_NUMBER_LENGTH];
+  //! @brief Count of characters.
+  uint32_t length;
+  //! @brief Whether the number contains "." or exponent.
+  bool dot;
+};
+
+//! @internal
+//!
+//! @brief Path data writer, tracks what is needed to omit commands and
+//! separators.
+struct FOG_NO_EXPORT SvgUtil_PathWriter
+{
+  FOG_INLINE SvgUtil_PathWriter() :
+    command(0),
+    number(false),
+    dot(false)
+  {
+  }
+
+  //! @brief Whether a separator is needed before number @a n.
+  //!
+  //! Separator is needed only if the number would continue the previous one,
+  //! "-" always starts a new number and "." too if the previous contains it.
+  FOG_INLINE bool needsSeparator(bool number, bool dot, const SvgUtil_Number& n) const
+  {
+    return number && n.data[0] != '-' && (n.data[0] != '.' || !dot);
+  }
+
+  //! @brief Get length of a segment written by @ref writeSegment().
+  FOG_INLINE size_t getSegmentLength(char c, const SvgUtil_Number* numbers, uint32_t count) const
+  {
+    bool number = this->number;
+    bool dot = this->dot;
+    size_t length = 0;
+
+    // Repeated command can be omitted, "M" is repeated as "L".
+    if (command != c)
+    {
+      number = false;
+      length++;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+      length += numbers[i].length + needsSeparator(number, dot, numbers[i]);
+      number = true;
+      dot = numbers[i].dot;
+    }
+
+    return length;
+  }
+
+  FOG_INLINE char* writeSegment(char* p, char c, const SvgUtil_Number* numbers, uint32_t count)
+  {
+    if (command != c)
+    {
+      *p++ = c;
+      command = (c == 'M') ? 'L' : (c == 'm') ? 'l' : c;
+      number = false;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+      const SvgUtil_Number& n = numbers[i];
+
+      if (needsSeparator(number, dot, n))
+        *p++ = ' ';
+
+      MemOps::copy(p, n.data, n.length);
+      p += n.length;
+
+      number = true;
+      dot = n.dot;
+    }
+
+    return p;
+  }
+
+  //! @brief Current command (after omitting "M" it's "L").
+  char command;
+  //! @brief Whether the last written character belongs to a number.
+  bool number;
+  //! @brief Whether the last written number contains "." or exponent.
+  bool dot;
+};
+
+//! @internal
+//!
+//! @brief Maximum count of bytes written per path segment.
+#define SVG_UTIL_SEGMENT_LENGTH (1 + 6 * (SVG_UTIL_NUMBER_LENGTH + 1))
+
+//! @internal
+//!
+//! @brief Count of bytes reserved at once by @ref serializePath().
+#define SVG_UTIL_BLOCK_LENGTH 16384
+
+err_t serializePath(StringA& dst, const PathF& src)
 {
   size_t pathLength = src.getLength();
   size_t i = 0;
-  
+
   const uint8_t* cmd = src.getCommands();
   const PointF* pts = src.getVertices();
 
-  bool isFirst = true;
+  // The worst case is too pessimistic to be reserved for the whole path, the
+  // output is written in blocks instead.
+  size_t dstLength = dst.getLength();
+
+  char* p = NULL;
+  char* pEnd = NULL;
+
+  SvgUtil_PathWriter writer;
+
+  // Current and initial point as seen by the parser (relative coordinates are
+  // added to it). Coordinates are written exactly, so it's the last vertex.
+  PointF last(0.0f, 0.0f);
+  PointF initial(0.0f, 0.0f);
+
+  SvgUtil_Number absNumbers[6];
+  SvgUtil_Number relNumbers[6];
 
   while (i < pathLength)
   {
-    if (!isFirst)
-      dst.append(CharW(' '));
-    else
-      isFirst = false;
-      
+    uint32_t count;
+    char absCmd;
+
+    if ((size_t)(pEnd - p) < SVG_UTIL_SEGMENT_LENGTH)
+    {
+      if (p != NULL)
+        dst._modified(p);
+
+      p = dst._add(SVG_UTIL_BLOCK_LENGTH);
+      if (FOG_IS_NULL(p))
+        goto _OutOfMemory;
+      pEnd = p + SVG_UTIL_BLOCK_LENGTH;
+    }
+
     switch (cmd[0])
     {
       case PATH_CMD_MOVE_TO:
-        FOG_RETURN_ON_ERROR(dst.appendFormat("M%g,%g", 
-          pts[0].x, pts[0].y));
-
-        i++;
-        cmd++;
-        pts++;
+        absCmd = 'M';
+        count = 1;
         break;
-      
-      case PATH_CMD_LINE_TO:
-        FOG_RETURN_ON_ERROR(dst.appendFormat("L%g,%g",
-          pts[0].x, pts[0].y));
 
-        i++;
-        cmd++;
-        pts++;
+      case PATH_CMD_LINE_TO:
+        absCmd = 'L';
+        count = 1;
         break;
-      
-      case PATH_CMD_QUAD_TO:
-        if (i + 2 > pathLength)
-          return ERR_RT_INVALID_STATE;
-
-        FOG_RETURN_ON_ERROR(dst.appendFormat("Q%g,%g %g,%g",
-          pts[0].x, pts[0].y,
-          pts[1].x, pts[1].y));
 
-        i += 2;
-        cmd += 2;
-        pts += 2;
+      case PATH_CMD_QUAD_TO:
+        absCmd = 'Q';
+        count = 2;
         break;
-      
-      case PATH_CMD_CUBIC_TO:
-        if (i + 3 > pathLength)
-          return ERR_RT_INVALID_STATE;
-
-        FOG_RETURN_ON_ERROR(dst.appendFormat("C%g,%g %g,%g %g,%g",
-          pts[0].x, pts[0].y,
-          pts[1].x, pts[1].y,
-          pts[2].x, pts[2].y));
 
-        i += 3;
-        cmd += 3;
-        pts += 3;
+      case PATH_CMD_CUBIC_TO:
+        absCmd = 'C';
+        count = 3;
         break;
 
       case PATH_CMD_CLOSE:
-        FOG_RETURN_ON_ERROR(dst.append(CharW('Z')));
+        p = writer.writeSegment(p, 'Z', NULL, 0);
+
+        // Any command can follow, the next one must be always written.
+        writer.command = 0;
+
+        last = initial;
         i++;
         cmd++;
         pts++;
-        break;
+        continue;
 
       default:
-        return ERR_RT_INVALID_STATE;
+        goto _Invalid;
+    }
+
+    if (i + count > pathLength)
+      goto _Invalid;
+
+    {
+      uint32_t numCoords = count * 2;
+      const PointF& end = pts[count - 1];
+
+      // Relative coordinates are used only if they restore the vertices
+      // exactly.
+      bool relExact = true;
+
+      for (uint32_t j = 0; j < count; j++)
+      {
+        float rx = pts[j].x - last.x;
+        float ry = pts[j].y - last.y;
+
+        relExact &= (last.x + rx == pts[j].x) & (last.y + ry == pts[j].y);
+
+        absNumbers[j * 2 + 0].set(pts[j].x);
+        absNumbers[j * 2 + 1].set(pts[j].y);
+
+        relNumbers[j * 2 + 0].set(rx);
+        relNumbers[j * 2 + 1].set(ry);
+      }
+
+      // Absolute form is always valid, ties are resolved in its favor.
+      char bestCmd = absCmd;
+      const SvgUtil_Number* bestNumbers = absNumbers;
+      uint32_t bestCount = numCoords;
+      size_t bestLength = writer.getSegmentLength(absCmd, absNumbers, numCoords);
+
+#define SVG_UTIL_TRY_SEGMENT(_Cmd_, _Numbers_, _Count_) \
+      FOG_MACRO_BEGIN \
+        size_t _length = writer.getSegmentLength(_Cmd_, _Numbers_, _Count_); \
+        \
+        if (_length < bestLength) \
+        { \
+          bestCmd = _Cmd_; \
+          bestNumbers = _Numbers_; \
+          bestCount = _Count_; \
+          bestLength = _length; \
+        } \
+      FOG_MACRO_END
+
+      if (relExact)
+        SVG_UTIL_TRY_SEGMENT(char(absCmd + ('a' - 'A')), relNumbers, numCoords);
+
+      if (absCmd == 'L')
+      {
+        if (end.y == last.y)
+        {
+          SVG_UTIL_TRY_SEGMENT('H', &absNumbers[0], 1);
+          if (relExact)
+            SVG_UTIL_TRY_SEGMENT('h', &relNumbers[0], 1);
+        }
+        else if (end.x == last.x)
+        {
+          SVG_UTIL_TRY_SEGMENT('V', &absNumbers[1], 1);
+          if (relExact)
+            SVG_UTIL_TRY_SEGMENT('v', &relNumbers[1], 1);
+        }
+      }
+
+#undef SVG_UTIL_TRY_SEGMENT
+
+      p = writer.writeSegment(p, bestCmd, bestNumbers, bestCount);
+
+      last = end;
+      if (absCmd == 'M')
+        initial = end;
     }
+
+    i += count;
+    cmd += count;
+    pts += count;
   }
-  
+
+  if (p != NULL)
+    dst._modified(p);
   return ERR_OK;
+
+_Invalid:
+  dst.truncate(dstLength);
+  return ERR_RT_INVALID_STATE;
+
+_OutOfMemory:
+  dst.truncate(dstLength);
+  return ERR_RT_OUT_OF_MEMORY;
+}
+
+err_t serializePath(StringW& dst, const PathF& src)
+{
+  StringA tmp;
+  FOG_RETURN_ON_ERROR(serializePath(tmp, src));
+
+  return dst.append(Ascii8(tmp.getData(), tmp.getLength()));
 }
 
 // ============================================================================
 // [Fog::SvgUtil - Serialize - Transform]
 // ============================================================================
 
-err_t serializeTransform(StringW& dst, const TransformF& src)
+err_t serializeTransform(StringA& dst, const TransformF& src)
 {
+  char* dstStart = dst._add(16 + 6 * (SVG_UTIL_NUMBER_LENGTH + 1));
+  if (FOG_IS_NULL(dstStart))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  const char* name;
+  float values[6];
+  uint32_t count;
+
   switch (src.getType())
   {
     case TRANSFORM_TYPE_IDENTITY:
+      dst._modified(dstStart);
       return ERR_OK;
 
     case TRANSFORM_TYPE_TRANSLATION:
-      if (Math::isFuzzyZero(src._21))
-        return dst.appendFormat("translate(%g)", src._20);
-      else
-        return dst.appendFormat("translate(%g %g)", src._20, src._21);
+      name = "translate(";
+      values[0] = src._20;
+      values[1] = src._21;
+      count = (src._21 == 0.0f) ? 1 : 2;
+      break;
 
     case TRANSFORM_TYPE_SCALING:
-      if (Math::isFuzzyZero(src._20) && Math::isFuzzyZero(src._21))
+      if (src._20 == 0.0f && src._21 == 0.0f)
       {
-        if (Math::isFuzzyEq(src._00, src._11))
-          return dst.appendFormat("scale(%g)", src._00);
-        else
-          return dst.appendFormat("scale(%g %g)", src._00, src._11);
+        name = "scale(";
+        values[0] = src._00;
+        values[1] = src._11;
+        count = (src._00 == src._11) ? 1 : 2;
+        break;
       }
       // ... Fall through ...
 
     default:
-      return dst.appendFormat("matrix(%g %g %g %g %g %g)",
-        src._00, src._01,
-        src._10, src._11,
-        src._20, src._21);
+      name = "matrix(";
+      values[0] = src._00;
+      values[1] = src._01;
+      values[2] = src._10;
+      values[3] = src._11;
+      values[4] = src._20;
+      values[5] = src._21;
+      count = 6;
+      break;
   }
+
+  char* p = dstStart;
+  while (*name)
+    *p++ = *name++;
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (i != 0)
+      *p++ = ' ';
+    p = SvgUtil_writeNumber(p, values[i]);
+  }
+
+  *p++ = ')';
+  dst._modified(p);
+  return ERR_OK;
+}
+
+err_t serializeTransform(StringW& dst, const TransformF& src)
+{
+  StringA tmpA;
+
+  FOG_RETURN_ON_ERROR(serializeTransform(tmpA, src));
+  return dst.append(Ascii8(tmpA.getData(), tmpA.getLength()));
 }
 
 } // SvgUtil namespace
@@ -52,6 +52,9 @@ FOG_API err_t parseViewBox(BoxF& box, const StringW& src);
 FOG_API err_t parsePoints(PathF& dst, const StringW& src, bool closePath);
 FOG_API err_t parsePath(PathF& dst, const StringW& src);
 
+//! @brief Parse list of numbers separated by spaces and/or commas.
+FOG_API err_t parseNumberList(List<float>& dst, const StringW& src);
+
 FOG_API err_t parseCSSStyle(const StringW& src, CSSStyleHandlerFunc func, void* ctx);
 
 // ============================================================================
@@ -78,12 +81,26 @@ FOG_API err_t serializeViewBox(StringW& dst, const BoxF& src);
 //! @brief Serialize SVG points in path to string (used by SVG <polygon> and 
 //! <polyline> elements.
 FOG_API err_t serializePoints(StringW& dst, const PathF& src);
+//! @overload
+FOG_API err_t serializePoints(StringA& dst, const PathF& src);
+
+//! @brief Serialize list of numbers to string.
+FOG_API err_t serializeNumberList(StringW& dst, const List<float>& src);
 
 //! @brief Serialize SVG path to string.
+//!
+//! Numbers are written in their shortest form parsed back to the same float
+//! and for each segment the shortest of absolute, relative and horizontal or
+//! vertical line commands is used, repeated commands and unnecessary
+//! separators are omitted.
 FOG_API err_t serializePath(StringW& dst, const PathF& src);
+//! @overload
+FOG_API err_t serializePath(StringA& dst, const PathF& src);
 
 //! @brief Serialize SVG transform to string.
 FOG_API err_t serializeTransform(StringW& dst, const TransformF& src);
+//! @overload
+FOG_API err_t serializeTransform(StringA& dst, const TransformF& src);
 
 //! @}
 
@@ -9,12 +9,14 @@
 #endif // FOG_PRECOMP
 
 // [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Tools/Cpu.h>
 #include <Fog/G2d/Tools/ColorAnalyzer_p.h>
 
 namespace Fog {
 
 // ============================================================================
-// [Fog::ColorAnalyzer]
+// [Fog::ColorAnalyzer - Helpers]
 // ============================================================================
 
 static const uint32_t ColorAnalyzer_result[] =
@@ -25,14 +27,17 @@ static const uint32_t ColorAnalyzer_result[] =
   /* 0x03 -> */ ALPHA_DISTRIBUTION_ZERO_OR_FULL
 };
 
-uint32_t ColorAnalyzer::analyzeAlpha32(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc)
+// ============================================================================
+// [Fog::ColorAnalyzer - Analyze]
+// ============================================================================
+
+static uint32_t ColorAnalyzer_analyzeAlpha32(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc)
 {
   uint32_t mask = 0x00;
-
   if (w <= 0 || h <= 0) return ALPHA_DISTRIBUTION_ZERO;
 
   data += aPos;
-  stride += w * inc;
+  stride -= (ssize_t)w * inc;
 
   for (int y = 0; y < h; y++, data += stride)
   {
@@ -53,14 +58,13 @@ uint32_t ColorAnalyzer::analyzeAlpha32(const uint8_t* data, ssize_t stride, int
   return ColorAnalyzer_result[mask];
 }
 
-uint32_t ColorAnalyzer::analyzeAlpha64(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc)
+static uint32_t ColorAnalyzer_analyzeAlpha64(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc)
 {
   uint32_t mask = 0x00;
-
   if (w <= 0 || h <= 0) return ALPHA_DISTRIBUTION_ZERO;
 
   data += aPos;
-  stride += w * inc;
+  stride -= (ssize_t)w * inc;
 
   for (int y = 0; y < h; y++, data += stride)
   {
@@ -81,4 +85,29 @@ uint32_t ColorAnalyzer::analyzeAlpha64(const uint8_t* data, ssize_t stride, int
   return ColorAnalyzer_result[mask];
 }
 
+// ============================================================================
+// [Fog::ColorAnalyzer - Statics]
+// ============================================================================
+
+ColorAnalyzer::AnalyzerFunc ColorAnalyzer::analyzeAlpha32;
+ColorAnalyzer::AnalyzerFunc ColorAnalyzer::analyzeAlpha64;
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_CPU_DECLARE_INITIALIZER_SSE2( ColorAnalyzer_init_SSE2(void) )
+
+FOG_NO_EXPORT void ColorAnalyzer_init(void)
+{
+  ColorAnalyzer::analyzeAlpha32 = ColorAnalyzer_analyzeAlpha32;
+  ColorAnalyzer::analyzeAlpha64 = ColorAnalyzer_analyzeAlpha64;
+
+  // --------------------------------------------------------------------------
+  // [CPU Based Optimizations]
+  // --------------------------------------------------------------------------
+
+  FOG_CPU_USE_INITIALIZER_SSE2( ColorAnalyzer_init_SSE2() )
+}
+
 } // Fog namespace
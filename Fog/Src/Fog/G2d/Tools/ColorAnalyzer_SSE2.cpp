@@ -0,0 +1,145 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Acc/AccSse2.h>
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/G2d/Tools/ColorAnalyzer_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::ColorAnalyzer - Analyze (SSE2)]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Analyze alpha values of size @a A_SIZE (1 or 2 bytes).
+//!
+//! Sixteen bytes (16 A8, 4 PRGB32 or 2 PRGB64 pixels) are processed at a time.
+//! Everything except alpha is masked out so the pixel is fully-transparent if
+//! the masked value equals to zero and fully-opaque if it equals to the mask.
+template<int A_SIZE>
+static uint32_t ColorAnalyzer_analyzeAlpha_SSE2(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc)
+{
+  enum { A_FULL = A_SIZE == 1 ? 0xFF : 0xFFFF };
+
+  uint32_t mask = 0x00;
+  if (w <= 0 || h <= 0) return ALPHA_DISTRIBUTION_ZERO;
+
+  int vecWidth = 0;
+  int vecMask = 0;
+
+  __m128i amask;
+  Acc::m128iZero(amask);
+
+  if (inc == 1 || inc == 2 || inc == 4 || inc == 8)
+  {
+    FOG_ALIGNED_VAR(uint8_t, maskData[16], 16);
+
+    for (int i = 0; i < 16; i++)
+    {
+      int pos = i % inc;
+      maskData[i] = (pos >= aPos && pos < aPos + A_SIZE) ? 0xFF : 0x00;
+    }
+
+    Acc::m128iLoad16a(amask, maskData);
+    Acc::m128iMoveMaskPI8(vecMask, amask);
+
+    vecWidth = w & ~(16 / inc - 1);
+  }
+
+  data += aPos;
+
+  for (int y = 0; y < h; y++, data += stride)
+  {
+    const uint8_t* p = data;
+    int x = vecWidth;
+
+    // Vector loads start at the pixel boundary, the alpha is selected by mask.
+    const uint8_t* pVec = p - aPos;
+
+    while (x > 0)
+    {
+      __m128i pix, zero, full;
+      int zeroMask, fullMask;
+
+      Acc::m128iLoad16u(pix, pVec);
+      Acc::m128iAnd(pix, pix, amask);
+
+      if (A_SIZE == 1)
+      {
+        Acc::m128iCmpEqPI8(full, pix, amask);
+        Acc::m128iZero(zero);
+        Acc::m128iCmpEqPI8(zero, zero, pix);
+      }
+      else
+      {
+        Acc::m128iCmpEqPI16(full, pix, amask);
+        Acc::m128iZero(zero);
+        Acc::m128iCmpEqPI16(zero, zero, pix);
+      }
+
+      Acc::m128iMoveMaskPI8(zeroMask, zero);
+      Acc::m128iMoveMaskPI8(fullMask, full);
+
+      zeroMask &= vecMask;
+      fullMask &= vecMask;
+
+      if ((zeroMask | fullMask) != vecMask)
+        return ALPHA_DISTRIBUTION_VARIANT;
+
+      if (zeroMask) mask |= 0x01;
+      if (fullMask) mask |= 0x02;
+
+      pVec += 16;
+      x -= 16 / inc;
+    }
+
+    p += (size_t)vecWidth * (uint)inc;
+
+    for (x = vecWidth; x < w; x++)
+    {
+      uint32_t a = (A_SIZE == 1) ? (uint32_t)p[0] : (uint32_t)reinterpret_cast<const uint16_t*>(p)[0];
+      p += inc;
+
+      if (a == 0)
+        mask |= 0x01;
+      else if (a == (uint32_t)A_FULL)
+        mask |= 0x02;
+      else
+        return ALPHA_DISTRIBUTION_VARIANT;
+    }
+  }
+
+  FOG_ASSERT(mask != 0x00);
+
+  static const uint32_t result[] =
+  {
+    ALPHA_DISTRIBUTION_ZERO,
+    ALPHA_DISTRIBUTION_ZERO,
+    ALPHA_DISTRIBUTION_FULL,
+    ALPHA_DISTRIBUTION_ZERO_OR_FULL
+  };
+
+  return result[mask];
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void ColorAnalyzer_init_SSE2(void)
+{
+  ColorAnalyzer::analyzeAlpha32 = ColorAnalyzer_analyzeAlpha_SSE2<1>;
+  ColorAnalyzer::analyzeAlpha64 = ColorAnalyzer_analyzeAlpha_SSE2<2>;
+}
+
+} // Fog namespace
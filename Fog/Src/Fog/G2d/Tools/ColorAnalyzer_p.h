@@ -23,22 +23,25 @@ namespace Fog {
 
 //! @internal
 //!
-//! @brief Color analyzerbpp
+//! @brief Color analyzer.
 //!
 //! This static class is currently used to analyze alpha values (to determine
 //! if they are fully-opaque, fully-transparent or variant.
+//!
+//! The analyzers are function pointers initialized by @c ColorAnalyzer_init(),
+//! they are replaced by SSE2 versions when available.
 struct FOG_NO_EXPORT ColorAnalyzer
 {
   typedef uint32_t (*AnalyzerFunc)(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc);
 
-  static uint32_t analyzeAlpha32(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc);
-  static uint32_t analyzeAlpha64(const uint8_t* data, ssize_t stride, int w, int h, int aPos, int inc);
+  static AnalyzerFunc analyzeAlpha32;
+  static AnalyzerFunc analyzeAlpha64;
 
   static FOG_INLINE uint32_t analyzeAlphaArgb32(const uint8_t* data, ssize_t stride, int w, int h)
   { return analyzeAlpha32(data, stride, w, h, PIXEL_ARGB32_POS_A, 4); }
 
   static FOG_INLINE uint32_t analyzeAlphaArgb64(const uint8_t* data, ssize_t stride, int w, int h)
-  { return analyzeAlpha32(data, stride, w, h, PIXEL_ARGB64_WORD_A, 8); }
+  { return analyzeAlpha64(data, stride, w, h, PIXEL_ARGB64_WORD_A * 2, 8); }
 };
 
 //! @}
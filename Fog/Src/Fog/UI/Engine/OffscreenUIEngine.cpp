@@ -0,0 +1,162 @@
+// [Fog-UI]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Kernel/DefaultEventLoopImpl_p.h>
+#include <Fog/Core/Tools/Logger.h>
+#include <Fog/G2d/Painting/Painter.h>
+#include <Fog/UI/Engine/OffscreenUIEngine.h>
+#include <Fog/UI/Engine/OffscreenUIEngineWindow.h>
+
+// [Dependencies - C]
+#include <unistd.h>
+
+FOG_IMPLEMENT_OBJECT(Fog::OffscreenUIEngine)
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - Construction / Destruction]
+// ============================================================================
+
+OffscreenUIEngine::OffscreenUIEngine() :
+  _displaySize(1920, 1080),
+  _windowId(0)
+{
+  _shmPrefix.format("/fog-%u-", (uint)::getpid());
+
+  updateDisplayInfo();
+  updateKeyboardInfo();
+  updateMouseInfo();
+
+  // There is no native event source, the default event loop processes the
+  // tasks and timers posted to the UI thread.
+  _eventLoop.adopt(fog_new DefaultEventLoopImpl());
+  _isInitialized = true;
+}
+
+OffscreenUIEngine::~OffscreenUIEngine()
+{
+  _eventLoop.reset();
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - Shared Memory]
+// ============================================================================
+
+err_t OffscreenUIEngine::setShmPrefix(const StringA& prefix)
+{
+  if (prefix.getLength() < 2 || prefix.getAt(0) != '/' || prefix.indexOf(Range(1, prefix.getLength()), '/') != INVALID_INDEX)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  return _shmPrefix.set(prefix);
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - Display / Palette]
+// ============================================================================
+
+void OffscreenUIEngine::setDisplaySize(const SizeI& size)
+{
+  _displaySize = size;
+  updateDisplayInfo();
+}
+
+void OffscreenUIEngine::updateDisplayInfo()
+{
+  _displayInfo._size = _displaySize;
+  _displayInfo._depth = 32;
+
+  _displayInfo._aMask = FOG_UINT64_C(0xFF000000);
+  _displayInfo._rMask = FOG_UINT64_C(0x00FF0000);
+  _displayInfo._gMask = FOG_UINT64_C(0x0000FF00);
+  _displayInfo._bMask = FOG_UINT64_C(0x000000FF);
+
+  _displayInfo._is16BppSwapped = false;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - Keyboard / Mouse]
+// ============================================================================
+
+void OffscreenUIEngine::updateKeyboardInfo()
+{
+}
+
+void OffscreenUIEngine::updateMouseInfo()
+{
+  setMouseWheelLines(0);
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - DoUpdate]
+// ============================================================================
+
+void OffscreenUIEngine::doPaintWindow(UIEngineWindow* window, Painter* painter, const RectI& paintRect)
+{
+  UIEngineWindowImpl* d = window->_d;
+
+  // Only the paint region is exported as damage (and copied to the other
+  // buffer), so nothing outside of it can be touched. The meta region is used
+  // because the raster paint engine doesn't support user clip regions.
+  if (d->_paintRegion.getLength() > 1)
+    painter->setMetaParams(d->_paintRegion, PointI(0, 0));
+
+  Base::doPaintWindow(window, painter, paintRect);
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - DoBlit]
+// ============================================================================
+
+void OffscreenUIEngine::doBlitWindow(UIEngineWindow* window)
+{
+  OffscreenUIEngineWindowImpl* d = static_cast<OffscreenUIEngineWindowImpl*>(window->_d);
+
+  if (!d->_bufferData._size.isValid())
+    return;
+
+  if (d->_blitRegion.isEmpty())
+    return;
+
+  if (d->_bufferType != UI_ENGINE_BUFFER_OFFSCREEN_SHM)
+    return;
+
+  d->present();
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngine - Window Management]
+// ============================================================================
+
+err_t OffscreenUIEngine::createWindow(UIEngineWindow* window, uint32_t flags)
+{
+  OffscreenUIEngineWindowImpl* wImpl = fog_new OffscreenUIEngineWindowImpl(this, window);
+  if (FOG_IS_NULL(wImpl))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  err_t err = wImpl->create(flags);
+  if (FOG_IS_ERROR(err))
+    fog_delete(wImpl);
+
+  return err;
+}
+
+err_t OffscreenUIEngine::destroyWindow(UIEngineWindow* window)
+{
+  OffscreenUIEngineWindowImpl* wImpl = static_cast<OffscreenUIEngineWindowImpl*>(window->_d);
+  if (FOG_IS_NULL(wImpl))
+    return ERR_RT_INVALID_STATE;
+
+  fog_delete(wImpl);
+  return ERR_OK;
+}
+
+} // Fog namespace
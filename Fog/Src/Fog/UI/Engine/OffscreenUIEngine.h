@@ -0,0 +1,116 @@
+// [Fog-UI]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_UI_ENGINE_OFFSCREENUIENGINE_H
+#define _FOG_UI_ENGINE_OFFSCREENUIENGINE_H
+
+// [Dependencies]
+#include <Fog/Core/Tools/String.h>
+#include <Fog/UI/Engine/UIEngine.h>
+#include <Fog/UI/Engine/UIEngineWindow.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_UI_Engine
+//! @{
+
+// ============================================================================
+// [Fog::OffscreenUIEngine]
+// ============================================================================
+
+//! @brief Headless @ref UIEngine implementation.
+//!
+//! The offscreen engine doesn't connect to any windowing system. Each window
+//! keeps its double-buffer in a POSIX shared memory object, which can be
+//! mapped by a consumer process to read the rendered frames without copying
+//! them. The layout of the shared memory is described by
+//! @ref OffscreenUIEngineShmHeader.
+//!
+//! The name of the shared memory object is the engine prefix followed by the
+//! window id (see @ref OffscreenUIEngineWindowImpl::getShmName()).
+struct FOG_API OffscreenUIEngine : public UIEngine
+{
+  FOG_DECLARE_OBJECT(OffscreenUIEngine, UIEngine)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  OffscreenUIEngine();
+  virtual ~OffscreenUIEngine();
+
+  // --------------------------------------------------------------------------
+  // [Shared Memory]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the prefix of shared memory object names.
+  FOG_INLINE const StringA& getShmPrefix() const { return _shmPrefix; }
+
+  //! @brief Set the prefix of shared memory object names (affects only windows
+  //! created after the call).
+  //!
+  //! The prefix must start with '/' and can't contain any other slash, see
+  //! shm_open() documentation.
+  err_t setShmPrefix(const StringA& prefix);
+
+  // --------------------------------------------------------------------------
+  // [Display / Palette]
+  // --------------------------------------------------------------------------
+
+  //! @brief Set the size of the virtual display.
+  void setDisplaySize(const SizeI& size);
+
+  virtual void updateDisplayInfo() override;
+
+  // --------------------------------------------------------------------------
+  // [Keyboard / Mouse]
+  // --------------------------------------------------------------------------
+
+  virtual void updateKeyboardInfo() override;
+  virtual void updateMouseInfo() override;
+
+  // --------------------------------------------------------------------------
+  // [DoUpdate]
+  // --------------------------------------------------------------------------
+
+  //! @brief Paint the window clipped to its paint region.
+  //!
+  //! Only the paint region is exported as damage and synchronized between
+  //! buffers, so painting outside of it is not allowed.
+  virtual void doPaintWindow(UIEngineWindow* window, Painter* painter, const RectI& paintRect) override;
+
+  //! @brief Publish the painted buffer and its damage to the shared memory
+  //! header and switch to the other buffer.
+  virtual void doBlitWindow(UIEngineWindow* window) override;
+
+  // --------------------------------------------------------------------------
+  // [Window Management]
+  // --------------------------------------------------------------------------
+
+  virtual err_t createWindow(UIEngineWindow* window, uint32_t flags) override;
+  virtual err_t destroyWindow(UIEngineWindow* window) override;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Prefix of shared memory object names, "/fog-<pid>-" by default.
+  StringA _shmPrefix;
+
+  //! @brief Size of the virtual display (1920x1080 by default).
+  SizeI _displaySize;
+
+  //! @brief Last window id, used as a window handle and to create unique
+  //! shared memory object names.
+  uint32_t _windowId;
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_UI_ENGINE_OFFSCREENUIENGINE_H
@@ -0,0 +1,567 @@
+// [Fog-UI]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Tools/Logger.h>
+#include <Fog/Core/Tools/Time.h>
+#include <Fog/UI/Engine/OffscreenUIEngine.h>
+#include <Fog/UI/Engine/OffscreenUIEngineWindow.h>
+
+// [Dependencies - C - Shared memory]
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Helpers]
+// ============================================================================
+
+static FOG_INLINE void OffscreenUIEngineWindowImpl_beginUpdate(OffscreenUIEngineShmHeader* header)
+{
+  AtomicCore<uint32_t>::inc(const_cast<uint32_t*>(&header->sequence));
+}
+
+static FOG_INLINE void OffscreenUIEngineWindowImpl_endUpdate(OffscreenUIEngineShmHeader* header)
+{
+  AtomicCore<uint32_t>::inc(const_cast<uint32_t*>(&header->sequence));
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Construction / Destruction]
+// ============================================================================
+
+OffscreenUIEngineWindowImpl::OffscreenUIEngineWindowImpl(UIEngine* engine, UIEngineWindow* window) :
+  UIEngineWindowImpl(engine, window),
+  _shmFd(-1),
+  _shmHeader(NULL),
+  _shmSize(0),
+  _backIndex(0)
+{
+}
+
+OffscreenUIEngineWindowImpl::~OffscreenUIEngineWindowImpl()
+{
+  if (_handle != NULL)
+    destroy();
+  else
+    freeDoubleBuffer();
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Create / Destroy]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::create(uint32_t hints)
+{
+  OffscreenUIEngine* oEngine = static_cast<OffscreenUIEngine*>(_engine);
+
+  if (_handle != NULL)
+    return ERR_OK;
+
+  uint32_t id = ++oEngine->_windowId;
+  FOG_RETURN_ON_ERROR(_shmName.format("%s%u", oEngine->_shmPrefix.getData(), id));
+
+  _shmFd = ::shm_open(_shmName.getData(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+  // The object can exist if a process with the same pid crashed before it
+  // unlinked its windows, it's safe to replace it.
+  if (_shmFd == -1 && errno == EEXIST)
+  {
+    ::shm_unlink(_shmName.getData());
+    _shmFd = ::shm_open(_shmName.getData(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  }
+
+  if (_shmFd == -1)
+  {
+    Logger::error("Fog::OffscreenUIEngineWindowImpl", "create",
+      "Failed to call shm_open(), errno=%d.", errno);
+
+    _shmName.reset();
+    return ERR_UI_OFFSCREEN_ENGINE_CANT_CREATE_SHM;
+  }
+
+  _handle = (void*)(size_t)id;
+  _windowHints = hints;
+  _windowDepth = 32;
+
+  int w = _windowGeometry.w;
+  int h = _windowGeometry.h;
+
+  w += (w == 0);
+  h += (h == 0);
+
+  _windowGeometry.setRect(_windowGeometry.x, _windowGeometry.y, w, h);
+  _clientGeometry.setRect(0, 0, w, h);
+
+  oEngine->addHandle(_handle, this);
+
+  // Windows are enabled by default.
+  _isEnabled = true;
+
+  // Windows are not visible by default.
+  _isVisible = false;
+  _isVisibleToParent = false;
+
+  // There is no input, the window gets focus only by calling focus().
+  _hasFocus = false;
+
+  // Will be set by show.
+  _shouldBlit = false;
+
+  return ERR_OK;
+}
+
+err_t OffscreenUIEngineWindowImpl::destroy()
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  _windowBeingDestroyed = true;
+  freeDoubleBuffer();
+
+  if (_shmFd != -1)
+  {
+    ::close(_shmFd);
+    ::shm_unlink(_shmName.getData());
+  }
+
+  destroyed();
+  return ERR_OK;
+}
+
+void OffscreenUIEngineWindowImpl::destroyed()
+{
+  Base::destroyed();
+
+  _shmName.reset();
+  _shmFd = -1;
+  _shmHeader = NULL;
+  _shmSize = 0;
+  _backIndex = 0;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Enabled / Disabled]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::setEnabled(bool enabled)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  if (_isEnabled == (uint32_t)enabled)
+    return ERR_OK;
+
+  _isEnabled = enabled;
+  _engine->doEnableAction(_window, enabled ? UI_ENGINE_EVENT_ENABLE : UI_ENGINE_EVENT_DISABLE);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Focus]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::focus()
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  if (!_hasFocus)
+    _engine->doFocusAction(_window, UI_ENGINE_EVENT_FOCUS_IN);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window State]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::setState(uint32_t state)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  switch (state)
+  {
+    case WINDOW_STATE_HIDDEN:
+      if (_isVisible)
+        _engine->doStateAction(_window, UI_ENGINE_EVENT_HIDE, WINDOW_STATE_HIDDEN);
+      return ERR_OK;
+
+    case WINDOW_STATE_MAXIMIZED:
+    case WINDOW_STATE_FULLSCREEN:
+    {
+      const SizeI& displaySize = _engine->_displayInfo._size;
+
+      _engine->doGeometryAction(_window, UI_ENGINE_EVENT_GEOMETRY, _orientation,
+        RectI(0, 0, displaySize.w, displaySize.h),
+        RectI(0, 0, displaySize.w, displaySize.h));
+    }
+    // ... Fall through ...
+
+    case WINDOW_STATE_NORMAL:
+      _engine->doStateAction(_window, UI_ENGINE_EVENT_SHOW, state);
+      return ERR_OK;
+
+    default:
+      return ERR_RT_INVALID_STATE;
+  }
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window Geometry]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::setWindowPosition(const PointI& pos)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  RectI wr(pos.x, pos.y, _windowGeometry.w, _windowGeometry.h);
+  _engine->doGeometryAction(_window, UI_ENGINE_EVENT_GEOMETRY, _orientation, wr, _clientGeometry);
+
+  return ERR_OK;
+}
+
+err_t OffscreenUIEngineWindowImpl::setWindowSize(const SizeI& size)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  if (!size.isValid())
+    return ERR_RT_INVALID_ARGUMENT;
+
+  RectI wr(_windowGeometry.x, _windowGeometry.y, size.w, size.h);
+  RectI cr(0, 0, size.w, size.h);
+  _engine->doGeometryAction(_window, UI_ENGINE_EVENT_GEOMETRY, _orientation, wr, cr);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window Stack]
+// ============================================================================
+
+// Offscreen windows are never composited together, the stack is irrelevant.
+
+err_t OffscreenUIEngineWindowImpl::moveToTop(void* targetHandle)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  return ERR_OK;
+}
+
+err_t OffscreenUIEngineWindowImpl::moveToBottom(void* targetHandle)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window Coordinates]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::worldToClient(PointI& pt) const
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  pt.x -= _windowGeometry.x + _clientGeometry.x;
+  pt.y -= _windowGeometry.y + _clientGeometry.y;
+  return ERR_OK;
+}
+
+err_t OffscreenUIEngineWindowImpl::clientToWorld(PointI& pt) const
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_STATE;
+
+  pt.x += _windowGeometry.x + _clientGeometry.x;
+  pt.y += _windowGeometry.y + _clientGeometry.y;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window Opacity]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::setWindowOpacity(float opacity)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_HANDLE;
+
+  _windowOpacity = opacity;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window Title]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::setWindowTitle(const StringW& title)
+{
+  if (FOG_IS_NULL(_handle))
+    return ERR_RT_INVALID_HANDLE;
+
+  _windowTitle = title;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Window Double-Buffer]
+// ============================================================================
+
+err_t OffscreenUIEngineWindowImpl::allocDoubleBuffer(const SizeI& size)
+{
+  if (_shmFd == -1)
+    return ERR_RT_INVALID_STATE;
+
+  uint32_t format = (_windowHints & WINDOW_HINT_COMPOSITE)
+    ? IMAGE_FORMAT_PRGB32
+    : IMAGE_FORMAT_XRGB32;
+
+  size_t stride = (size_t)Image::getStrideFromWidth(size.w, 32);
+  size_t pageSize = (size_t)::sysconf(_SC_PAGESIZE);
+
+  size_t bufferSize = (stride * (size_t)size.h + pageSize - 1) & ~(pageSize - 1);
+  size_t mappingSize = (size_t)UI_ENGINE_OFFSCREEN_SHM_HEADER_SIZE + bufferSize * UI_ENGINE_OFFSCREEN_SHM_BUFFER_COUNT;
+
+  // --------------------------------------------------------------------------
+  // [Object]
+  // --------------------------------------------------------------------------
+
+  // The object never shrinks while the window exists, a consumer which didn't
+  // remap yet has always a valid mapping.
+  struct stat st;
+  if (::fstat(_shmFd, &st) != 0)
+  {
+    Logger::error("Fog::OffscreenUIEngineWindowImpl", "allocDoubleBuffer",
+      "Failed to call fstat(), errno=%d.", errno);
+    return ERR_UI_OFFSCREEN_ENGINE_CANT_CREATE_SHM;
+  }
+
+  if ((size_t)st.st_size < mappingSize)
+  {
+    if (::ftruncate(_shmFd, (off_t)mappingSize) != 0)
+    {
+      Logger::error("Fog::OffscreenUIEngineWindowImpl", "allocDoubleBuffer",
+        "Failed to call ftruncate(), errno=%d, requested size=%llu.", errno, (unsigned long long)mappingSize);
+      return ERR_UI_OFFSCREEN_ENGINE_CANT_CREATE_SHM;
+    }
+  }
+  else
+  {
+    mappingSize = (size_t)st.st_size;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Mapping]
+  // --------------------------------------------------------------------------
+
+  void* p = ::mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, _shmFd, 0);
+  if (p == MAP_FAILED)
+  {
+    Logger::error("Fog::OffscreenUIEngineWindowImpl", "allocDoubleBuffer",
+      "Failed to call mmap(), errno=%d.", errno);
+    return ERR_UI_OFFSCREEN_ENGINE_CANT_MAP_SHM;
+  }
+
+  OffscreenUIEngineShmHeader* header = static_cast<OffscreenUIEngineShmHeader*>(p);
+
+  // --------------------------------------------------------------------------
+  // [Header]
+  // --------------------------------------------------------------------------
+
+  // The header is kept between reallocations so the sequence and frame id
+  // always increase. Width and height are zero until the first frame with
+  // the new layout is presented.
+  if (header->magic != UI_ENGINE_OFFSCREEN_SHM_MAGIC)
+  {
+    MemOps::zero(header, UI_ENGINE_OFFSCREEN_SHM_HEADER_SIZE);
+    header->magic = UI_ENGINE_OFFSCREEN_SHM_MAGIC;
+    header->version = UI_ENGINE_OFFSCREEN_SHM_VERSION;
+  }
+
+  OffscreenUIEngineWindowImpl_beginUpdate(header);
+
+  header->frontIndex = 0;
+  header->mappingSize = mappingSize;
+  header->bufferOffset[0] = UI_ENGINE_OFFSCREEN_SHM_HEADER_SIZE;
+  header->bufferOffset[1] = UI_ENGINE_OFFSCREEN_SHM_HEADER_SIZE + bufferSize;
+  header->format = format;
+  header->width = 0;
+  header->height = 0;
+  header->stride = (int32_t)stride;
+  header->damageCount = 0;
+
+  OffscreenUIEngineWindowImpl_endUpdate(header);
+
+  _shmHeader = header;
+  _shmSize = mappingSize;
+  _backIndex = 1;
+
+  _bufferData._data = reinterpret_cast<uint8_t*>(header) + header->bufferOffset[_backIndex];
+  _bufferData._size = size;
+  _bufferData._format = format;
+  _bufferData._stride = (ssize_t)stride;
+
+  _bufferType = UI_ENGINE_BUFFER_OFFSCREEN_SHM;
+  return ERR_OK;
+}
+
+err_t OffscreenUIEngineWindowImpl::freeDoubleBuffer()
+{
+  switch (_bufferType)
+  {
+    case UI_ENGINE_BUFFER_NONE:
+    {
+      return ERR_OK;
+    }
+
+    case UI_ENGINE_BUFFER_OFFSCREEN_SHM:
+    {
+      if (::munmap(_shmHeader, _shmSize) != 0)
+      {
+        Logger::error("Fog::OffscreenUIEngineWindowImpl", "freeDoubleBuffer",
+          "Failed to call munmap(), errno=%d.", errno);
+      }
+      break;
+    }
+
+    default:
+      return ERR_RT_INVALID_STATE;
+  }
+
+  _bufferData.reset();
+  _bufferType = UI_ENGINE_BUFFER_NONE;
+
+  _bufferCacheSize.reset();
+  _bufferCacheCreated.reset();
+  _bufferCacheExpire.reset();
+
+  _shmHeader = NULL;
+  _shmSize = 0;
+  _backIndex = 0;
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl - Shared Memory]
+// ============================================================================
+
+void OffscreenUIEngineWindowImpl::present()
+{
+  OffscreenUIEngineShmHeader* header = _shmHeader;
+  uint8_t* base = reinterpret_cast<uint8_t*>(header);
+
+  uint32_t frontIndex = _backIndex;
+  uint32_t backIndex = frontIndex ^ 1;
+
+  BoxI bounds(0, 0, _bufferData._size.w, _bufferData._size.h);
+  const BoxI* boxes = _blitRegion.getData();
+  size_t length = _blitRegion.getLength();
+
+  // --------------------------------------------------------------------------
+  // [Publish]
+  // --------------------------------------------------------------------------
+
+  OffscreenUIEngineWindowImpl_beginUpdate(header);
+
+  header->frontIndex = frontIndex;
+  header->frameId++;
+  header->frameTime = TimeTicks::now().getTicks();
+  header->format = _bufferData._format;
+  header->width = _bufferData._size.w;
+  header->height = _bufferData._size.h;
+  header->stride = (int32_t)_bufferData._stride;
+
+  if (length <= UI_ENGINE_OFFSCREEN_SHM_DAMAGE_MAX)
+  {
+    uint32_t count = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+      BoxI box;
+      if (!BoxI::intersect(box, boxes[i], bounds))
+        continue;
+
+      OffscreenUIEngineShmBox& dst = header->damage[count++];
+      dst.x0 = box.x0;
+      dst.y0 = box.y0;
+      dst.x1 = box.x1;
+      dst.y1 = box.y1;
+    }
+
+    header->damageCount = count;
+  }
+  else
+  {
+    // Too complex region, export only its bounding box.
+    BoxI box;
+    BoxI::intersect(box, _blitRegion.getBoundingBox(), bounds);
+
+    OffscreenUIEngineShmBox& dst = header->damage[0];
+    dst.x0 = box.x0;
+    dst.y0 = box.y0;
+    dst.x1 = box.x1;
+    dst.y1 = box.y1;
+
+    header->damageCount = box.isValid();
+  }
+
+  OffscreenUIEngineWindowImpl_endUpdate(header);
+
+  // --------------------------------------------------------------------------
+  // [Swap]
+  // --------------------------------------------------------------------------
+
+  // The new back-buffer contains the previous frame, only the damaged area is
+  // copied to make it equal to the presented one (the rest is painted only if
+  // it gets damaged later).
+  const uint8_t* srcPixels = base + header->bufferOffset[frontIndex];
+  uint8_t* dstPixels = base + header->bufferOffset[backIndex];
+  ssize_t stride = _bufferData._stride;
+
+  for (size_t i = 0; i < length; i++)
+  {
+    BoxI box;
+    if (!BoxI::intersect(box, boxes[i], bounds))
+      continue;
+
+    size_t offset = (size_t)box.y0 * stride + (size_t)box.x0 * 4;
+    size_t bytes = (size_t)box.getWidth() * 4;
+
+    const uint8_t* s = srcPixels + offset;
+    uint8_t* d = dstPixels + offset;
+
+    for (int y = box.y0; y < box.y1; y++, s += stride, d += stride)
+      MemOps::copy(d, s, bytes);
+
+    _frameStats.blitPixels += uint64_t(uint(box.getWidth())) * uint(box.getHeight());
+  }
+
+  _frameStats.blitRequests++;
+
+  _backIndex = backIndex;
+  _bufferData._data = dstPixels;
+}
+
+} // Fog namespace
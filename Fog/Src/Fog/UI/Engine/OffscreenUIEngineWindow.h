@@ -0,0 +1,214 @@
+// [Fog-UI]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_UI_ENGINE_OFFSCREENUIENGINEWINDOW_H
+#define _FOG_UI_ENGINE_OFFSCREENUIENGINEWINDOW_H
+
+// [Dependencies]
+#include <Fog/Core/Tools/String.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/UI/Engine/UIEngineWindow.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_UI_Engine
+//! @{
+
+// ============================================================================
+// [Fog::OffscreenUIEngineShmBox]
+// ============================================================================
+
+//! @brief Damage box stored in @ref OffscreenUIEngineShmHeader.
+struct FOG_NO_EXPORT OffscreenUIEngineShmBox
+{
+  int32_t x0;
+  int32_t y0;
+  int32_t x1;
+  int32_t y1;
+};
+
+// ============================================================================
+// [Fog::OffscreenUIEngineShmHeader]
+// ============================================================================
+
+//! @brief Header of the shared memory object used by @ref OffscreenUIEngine.
+//!
+//! The object starts with this header (padded to
+//! @ref UI_ENGINE_OFFSCREEN_SHM_HEADER_SIZE bytes) followed by two buffers.
+//! The producer paints into the back buffer and when the frame is finished
+//! it publishes it by changing @c frontIndex. Consumer should:
+//!
+//!   1. Read @c sequence, retry if it's odd (the producer updates the header).
+//!   2. Remap the object if @c mappingSize changed (window was resized).
+//!   3. Read the front buffer at @c bufferOffset[frontIndex] and the damage.
+//!   4. Read @c sequence again, the frame is consistent if it didn't change.
+//!
+//! The mapping only grows while the window exists, so an old mapping is
+//! always valid to read.
+struct FOG_NO_EXPORT OffscreenUIEngineShmHeader
+{
+  //! @brief Magic number, see @ref UI_ENGINE_OFFSCREEN_SHM_MAGIC.
+  uint32_t magic;
+  //! @brief Layout version, see @ref UI_ENGINE_OFFSCREEN_SHM_VERSION.
+  uint32_t version;
+
+  //! @brief Sequence lock, odd while the header is being updated.
+  volatile uint32_t sequence;
+  //! @brief Index of the front buffer (0 or 1).
+  volatile uint32_t frontIndex;
+
+  //! @brief Size of the whole object (header and buffers) in bytes.
+  uint64_t mappingSize;
+  //! @brief Offsets of buffers relative to the start of the object.
+  uint64_t bufferOffset[UI_ENGINE_OFFSCREEN_SHM_BUFFER_COUNT];
+
+  //! @brief Frame counter, incremented by each published frame.
+  uint64_t frameId;
+  //! @brief Time when the frame was published (@ref TimeTicks in microseconds).
+  int64_t frameTime;
+
+  //! @brief Pixel format of buffers, see @ref IMAGE_FORMAT.
+  uint32_t format;
+  //! @brief Width of the frame.
+  int32_t width;
+  //! @brief Height of the frame.
+  int32_t height;
+  //! @brief Stride (bytes per scanline) of buffers.
+  int32_t stride;
+
+  //! @brief Count of damage boxes of the frame.
+  uint32_t damageCount;
+  //! @brief Reserved for future use, always zero.
+  uint32_t reserved;
+
+  //! @brief Damaged area of the frame (YX sorted, non-overlapping boxes).
+  OffscreenUIEngineShmBox damage[UI_ENGINE_OFFSCREEN_SHM_DAMAGE_MAX];
+};
+
+// ============================================================================
+// [Fog::OffscreenUIEngineWindowImpl]
+// ============================================================================
+
+//! @brief Offscreen @ref UIEngineWindow implementation.
+struct FOG_API OffscreenUIEngineWindowImpl : public UIEngineWindowImpl
+{
+  typedef UIEngineWindowImpl Base;
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  OffscreenUIEngineWindowImpl(UIEngine* engine, UIEngineWindow* window);
+  virtual ~OffscreenUIEngineWindowImpl();
+
+  // --------------------------------------------------------------------------
+  // [Create / Destroy]
+  // --------------------------------------------------------------------------
+
+  virtual err_t create(uint32_t hints);
+  virtual err_t destroy();
+
+  virtual void destroyed();
+
+  // --------------------------------------------------------------------------
+  // [Enabled / Disabled]
+  // --------------------------------------------------------------------------
+
+  virtual err_t setEnabled(bool enabled);
+
+  // --------------------------------------------------------------------------
+  // [Focus]
+  // --------------------------------------------------------------------------
+
+  virtual err_t focus();
+
+  // --------------------------------------------------------------------------
+  // [Window State]
+  // --------------------------------------------------------------------------
+
+  virtual err_t setState(uint32_t state);
+
+  // --------------------------------------------------------------------------
+  // [Window Geometry]
+  // --------------------------------------------------------------------------
+
+  virtual err_t setWindowPosition(const PointI& pos);
+  virtual err_t setWindowSize(const SizeI& size);
+
+  // --------------------------------------------------------------------------
+  // [Window Stack]
+  // --------------------------------------------------------------------------
+
+  virtual err_t moveToTop(void* targetHandle);
+  virtual err_t moveToBottom(void* targetHandle);
+
+  // --------------------------------------------------------------------------
+  // [Window Coordinates]
+  // --------------------------------------------------------------------------
+
+  virtual err_t worldToClient(PointI& pt) const;
+  virtual err_t clientToWorld(PointI& pt) const;
+
+  // --------------------------------------------------------------------------
+  // [Window Opacity]
+  // --------------------------------------------------------------------------
+
+  virtual err_t setWindowOpacity(float opacity);
+
+  // --------------------------------------------------------------------------
+  // [Window Title]
+  // --------------------------------------------------------------------------
+
+  virtual err_t setWindowTitle(const StringW& title);
+
+  // --------------------------------------------------------------------------
+  // [Window Double-Buffer]
+  // --------------------------------------------------------------------------
+
+  virtual err_t allocDoubleBuffer(const SizeI& size);
+  virtual err_t freeDoubleBuffer();
+
+  // --------------------------------------------------------------------------
+  // [Shared Memory]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the name of the shared memory object (for shm_open()).
+  FOG_INLINE const StringA& getShmName() const { return _shmName; }
+
+  //! @brief Get the shared memory header (or @c NULL if not mapped).
+  FOG_INLINE OffscreenUIEngineShmHeader* getShmHeader() const { return _shmHeader; }
+
+  //! @brief Publish the back buffer as a new frame with the damage stored in
+  //! @c _blitRegion and make the other buffer the back buffer.
+  void present();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Name of the shared memory object.
+  StringA _shmName;
+  //! @brief File descriptor of the shared memory object (or -1).
+  int _shmFd;
+
+  //! @brief Mapped shared memory (or @c NULL).
+  OffscreenUIEngineShmHeader* _shmHeader;
+  //! @brief Size of the mapped shared memory.
+  size_t _shmSize;
+
+  //! @brief Index of the back buffer (the buffer painted by Fog).
+  uint32_t _backIndex;
+
+private:
+  FOG_NO_COPY(OffscreenUIEngineWindowImpl)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_UI_ENGINE_OFFSCREENUIENGINEWINDOW_H
@@ -390,6 +390,18 @@ void UIEngine::scheduleWindowUpdate(UIEngineWindow* window, const Region& region
 // [Fog::UIEngine - DoUpdate]
 // ============================================================================
 
+static uint64_t UIEngine_getRegionArea(const Region& region)
+{
+  size_t length = region.getLength();
+  const BoxI* data = region.getData();
+
+  uint64_t area = 0;
+  for (size_t i = 0; i < length; i++)
+    area += uint64_t(uint(data[i].getWidth())) * uint(data[i].getHeight());
+
+  return area;
+}
+
 void UIEngine::doUpdateAll()
 {
   if (_dirtyList.isEmpty())
@@ -496,8 +508,15 @@ void UIEngine::doUpdateAll()
 
     if (err == ERR_OK)
     {
+      TimeTicks paintStart = TimeTicks::now();
+
       doPaintWindow(window, &painter, boundingBox);
       isPainterUsed++;
+
+      // Multithreaded painter can still render when the paint event returns,
+      // the time includes only the paint event itself.
+      d->_frameStats.lastPaintTime = TimeTicks::now() - paintStart;
+      d->_frameStats.totalPaintTime += d->_frameStats.lastPaintTime;
     }
 
     d->_blitRegion.union_(d->_paintRegion);
@@ -524,8 +543,18 @@ void UIEngine::doUpdateAll()
       continue;
 
     d->_shouldBlit = false;
+
+    UIEngineFrameStats& stats = d->_frameStats;
+    TimeTicks blitStart = TimeTicks::now();
+
+    stats.frameCount++;
+    stats.damagePixels += UIEngine_getRegionArea(d->_blitRegion);
+
     doBlitWindow(window);
     d->_blitRegion.clear();
+
+    stats.lastBlitTime = TimeTicks::now() - blitStart;
+    stats.totalBlitTime += stats.lastBlitTime;
   }
 
   // --------------------------------------------------------------------------
@@ -53,6 +53,7 @@ UIEngineWindowImpl::UIEngineWindowImpl(UIEngine* engine, UIEngineWindow* window)
   _bufferCacheExpire()
 {
   _bufferData.reset();
+  _frameStats.reset();
 
   if (_window)
     _window->_d = this;
@@ -444,6 +445,30 @@ bool UIEngineWindow::isBufferCacheEnabled() const
   return _d->_isBufferCacheEnabled != 0;
 }
 
+// ============================================================================
+// [Fog::UIEngineWindow - Frame Statistics]
+// ============================================================================
+
+UIEngineFrameStats UIEngineWindow::getFrameStats() const
+{
+  UIEngineFrameStats stats;
+
+  if (FOG_IS_NULL(_d))
+    stats.reset();
+  else
+    stats = _d->_frameStats;
+
+  return stats;
+}
+
+void UIEngineWindow::resetFrameStats()
+{
+  if (FOG_IS_NULL(_d))
+    return;
+
+  _d->_frameStats.reset();
+}
+
 // ============================================================================
 // [Fog::UIEngineWindow - Events]
 // ============================================================================
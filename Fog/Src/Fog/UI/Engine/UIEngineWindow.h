@@ -30,6 +30,68 @@ namespace Fog {
 //! @addtogroup Fog_UI_Engine
 //! @{
 
+// ============================================================================
+// [Fog::UIEngineFrameStats]
+// ============================================================================
+
+//! @brief Frame statistics of @ref UIEngineWindow.
+//!
+//! Updated by @ref UIEngine::doUpdateAll() for each painted and blitted frame.
+//! The blit counters (@c blitPixels and @c blitRequests) are updated by the
+//! engine's @c doBlitWindow() implementation, so they can be compared with
+//! @c damagePixels to see how many pixels were transferred to the windowing
+//! system.
+struct FOG_NO_EXPORT UIEngineFrameStats
+{
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    frameCount = 0;
+    damagePixels = 0;
+    blitPixels = 0;
+    blitRequests = 0;
+
+    lastPaintTime = TimeDelta();
+    lastBlitTime = TimeDelta();
+    totalPaintTime = TimeDelta();
+    totalBlitTime = TimeDelta();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the time spent by the last frame (paint and blit).
+  FOG_INLINE TimeDelta getLastFrameTime() const { return lastPaintTime + lastBlitTime; }
+  //! @brief Get the time spent by all frames (paint and blit).
+  FOG_INLINE TimeDelta getTotalFrameTime() const { return totalPaintTime + totalBlitTime; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Count of blitted frames.
+  uint64_t frameCount;
+  //! @brief Count of pixels in blit regions (the damaged area).
+  uint64_t damagePixels;
+  //! @brief Count of pixels sent to the windowing system.
+  uint64_t blitPixels;
+  //! @brief Count of blit requests sent to the windowing system.
+  uint64_t blitRequests;
+
+  //! @brief Time spent by painting of the last frame.
+  TimeDelta lastPaintTime;
+  //! @brief Time spent by blitting of the last frame.
+  TimeDelta lastBlitTime;
+  //! @brief Time spent by painting of all frames.
+  TimeDelta totalPaintTime;
+  //! @brief Time spent by blitting of all frames.
+  TimeDelta totalBlitTime;
+};
+
 // ============================================================================
 // [Fog::UIEngineWindowImpl]
 // ============================================================================
@@ -266,6 +328,9 @@ struct FOG_API UIEngineWindowImpl
   //! @brief Blit region (used to blit window content to the screen).
   Region _blitRegion;
 
+  //! @brief Frame statistics.
+  UIEngineFrameStats _frameStats;
+
 private:
   FOG_NO_COPY(UIEngineWindowImpl)
 };
@@ -425,6 +490,16 @@ struct FOG_API UIEngineWindow
   //! @note Takes effect only when window is resized.
   bool isBufferCacheEnabled() const;
 
+  // --------------------------------------------------------------------------
+  // [Frame Statistics]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get frame statistics of the UIEngineWindow.
+  UIEngineFrameStats getFrameStats() const;
+
+  //! @brief Reset frame statistics of the UIEngineWindow.
+  void resetFrameStats();
+
   // --------------------------------------------------------------------------
   // [Events]
   // --------------------------------------------------------------------------
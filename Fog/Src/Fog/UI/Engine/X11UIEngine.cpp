@@ -981,6 +981,105 @@ static void X11UIEngine_setGCRegion(X11UIEngine* self, GC gc, int xOrigin, int y
   self->_XLib._XSetClipRectangles(self->_display, gc, xOrigin, yOrigin, xRectList, (uint)regionLength, YXBanded);
 }
 
+static FOG_INLINE uint64_t X11UIEngine_getBoxArea(const BoxI& box)
+{
+  return uint64_t(uint(box.getWidth())) * uint(box.getHeight());
+}
+
+//! @internal
+//!
+//! @brief Merge the pair of @a boxes whose union adds the least area, returns
+//! the new count of boxes (@a count - 1).
+static size_t X11UIEngine_mergeBlitBoxes(BoxI* boxes, size_t count)
+{
+  FOG_ASSERT(count >= 2);
+
+  size_t bestA = 0;
+  size_t bestB = 1;
+  int64_t bestCost = 0;
+  BoxI bestBox;
+
+  for (size_t a = 0; a < count - 1; a++)
+  {
+    int64_t areaA = (int64_t)X11UIEngine_getBoxArea(boxes[a]);
+
+    for (size_t b = a + 1; b < count; b++)
+    {
+      BoxI merged(Math::min(boxes[a].x0, boxes[b].x0), Math::min(boxes[a].y0, boxes[b].y0),
+                  Math::max(boxes[a].x1, boxes[b].x1), Math::max(boxes[a].y1, boxes[b].y1));
+
+      // Boxes merged before can overlap, so the cost can be negative.
+      int64_t cost = (int64_t)X11UIEngine_getBoxArea(merged) - areaA - (int64_t)X11UIEngine_getBoxArea(boxes[b]);
+
+      if (b == 1 || cost < bestCost)
+      {
+        bestA = a;
+        bestB = b;
+        bestCost = cost;
+        bestBox = merged;
+      }
+    }
+  }
+
+  boxes[bestA] = bestBox;
+  boxes[bestB] = boxes[--count];
+  return count;
+}
+
+//! @internal
+//!
+//! @brief Coalesce boxes of the blit @a region into at most
+//! @c X11_BLIT_MAX_BOXES boxes, returns the count of boxes stored in @a dst.
+//!
+//! Region boxes are YX sorted, so neighbors in the same band or in adjacent
+//! bands are merged when the union wastes at most 25% of the damaged area
+//! (plus @c X11_BLIT_MERGE_SLACK pixels). If there are still too many boxes
+//! the pair whose union adds the least area is merged until they fit.
+static size_t X11UIEngine_coalesceBlitBoxes(BoxI* dst, const Region& region)
+{
+  const BoxI* src = region.getData();
+  size_t length = region.getLength();
+
+  if (length == 0)
+    return 0;
+
+  BoxI boxes[X11_BLIT_MAX_BOXES + 1];
+  size_t count = 0;
+
+  BoxI current(src[0]);
+  uint64_t currentDamage = X11UIEngine_getBoxArea(current);
+
+  for (size_t i = 1; i < length; i++)
+  {
+    BoxI merged(Math::min(current.x0, src[i].x0), Math::min(current.y0, src[i].y0),
+                Math::max(current.x1, src[i].x1), Math::max(current.y1, src[i].y1));
+
+    uint64_t damage = currentDamage + X11UIEngine_getBoxArea(src[i]);
+
+    if (X11UIEngine_getBoxArea(merged) <= damage + damage / 4 + X11_BLIT_MERGE_SLACK)
+    {
+      current = merged;
+      currentDamage = damage;
+      continue;
+    }
+
+    boxes[count++] = current;
+    if (count > X11_BLIT_MAX_BOXES)
+      count = X11UIEngine_mergeBlitBoxes(boxes, count);
+
+    current = src[i];
+    currentDamage = X11UIEngine_getBoxArea(current);
+  }
+
+  boxes[count++] = current;
+  if (count > X11_BLIT_MAX_BOXES)
+    count = X11UIEngine_mergeBlitBoxes(boxes, count);
+
+  for (size_t i = 0; i < count; i++)
+    dst[i] = boxes[i];
+  return count;
+}
+
 void X11UIEngine::doBlitWindow(UIEngineWindow* window)
 {
   X11UIEngineWindowImpl* d = reinterpret_cast<X11UIEngineWindowImpl*>(window->_d);
@@ -996,9 +1095,12 @@ void X11UIEngine::doBlitWindow(UIEngineWindow* window)
   // --------------------------------------------------------------------------
 
   XID wnd = (XID)d->_handle;
-  uint cw = uint(d->_clientGeometry.w);
-  uint ch = uint(d->_clientGeometry.h);
+  BoxI clientBox(0, 0,
+    Math::min(d->_clientGeometry.w, d->_bufferData._size.w),
+    Math::min(d->_clientGeometry.h, d->_bufferData._size.h));
 
+  // Coalesced boxes can be larger than the blit region, the GC clip makes sure
+  // that only the blit region is changed on the screen.
   GC gc = d->_gc;
   X11UIEngine_setGCRegion(this, gc, 0, 0, d->_blitRegion);
 
@@ -1006,22 +1108,44 @@ void X11UIEngine::doBlitWindow(UIEngineWindow* window)
   // [GC Blit]
   // --------------------------------------------------------------------------
 
-  switch (d->_bufferType)
+  // Only boxes of the blit region are sent to the X server, putting the whole
+  // client area would transfer the full frame even if a single pixel changed.
+  BoxI boxes[X11_BLIT_MAX_BOXES];
+  size_t count = X11UIEngine_coalesceBlitBoxes(boxes, d->_blitRegion);
+
+  UIEngineFrameStats& stats = d->_frameStats;
+
+  for (size_t i = 0; i < count; i++)
   {
-    case UI_ENGINE_BUFFER_X11_XIMAGE:
-    {
-      _XLib._XPutImage(_display, wnd, gc, d->_ximage, 0, 0, 0, 0, cw, ch);
-      break;
-    }
+    BoxI box;
+    if (!BoxI::intersect(box, boxes[i], clientBox))
+      continue;
+
+    int x = box.x0;
+    int y = box.y0;
+    uint w = uint(box.getWidth());
+    uint h = uint(box.getHeight());
 
-    case UI_ENGINE_BUFFER_X11_XSHMIMAGE:
+    switch (d->_bufferType)
     {
-      _XExt._XShmPutImage(_display, wnd, gc, d->_ximage, 0, 0, 0, 0, cw, ch, false);
-      break;
+      case UI_ENGINE_BUFFER_X11_XIMAGE:
+      {
+        _XLib._XPutImage(_display, wnd, gc, d->_ximage, x, y, x, y, w, h);
+        break;
+      }
+
+      case UI_ENGINE_BUFFER_X11_XSHMIMAGE:
+      {
+        _XExt._XShmPutImage(_display, wnd, gc, d->_ximage, x, y, x, y, w, h, false);
+        break;
+      }
+
+      default:
+        return;
     }
 
-    default:
-      break;
+    stats.blitPixels += uint64_t(w) * h;
+    stats.blitRequests++;
   }
 }
 
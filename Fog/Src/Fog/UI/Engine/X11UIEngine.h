@@ -124,6 +124,21 @@ enum X11_ATOM
   X11_ATOM_COUNT
 };
 
+// ============================================================================
+// [Fog::X11_BLIT]
+// ============================================================================
+
+enum X11_BLIT
+{
+  //! @brief Maximum count of put-image requests per blit. Boxes of a more
+  //! complex blit region are merged until they fit.
+  X11_BLIT_MAX_BOXES = 16,
+
+  //! @brief Count of pixels that can be wasted to merge two boxes into one
+  //! put-image request (covers the request overhead of small boxes).
+  X11_BLIT_MERGE_SLACK = 256
+};
+
 // ============================================================================
 // [Fog:X11UIEngineKeyMap]
 // ============================================================================